@@ -0,0 +1,650 @@
+#include "asset_build.hpp"
+
+#include "batleth/shader_compiler.hpp"
+#include "federation/storage/cook_manifest.hpp"
+#include "federation/storage/virtual_file_system.hpp"
+#include "klingon/model/asset_loader.hpp"
+#include "klingon/model/kmesh.hpp"
+#include "replicator/texture_cooker.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <map>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+namespace cooker {
+    namespace {
+        constexpr uint32_t SHADER_COOK_VERSION = 1;     // Bump when include expansion or compile options change
+        constexpr uint32_t TEXTURE_COOK_VERSION = 1;    // Bump when the texture cooker's output changes
+        constexpr uint32_t MAX_INCLUDE_DEPTH = 32;
+
+        using Clock = std::chrono::steady_clock;
+
+        struct Node {
+            AssetKind kind = AssetKind::Texture;
+            std::string source;                         // Normalized VFS path
+            std::string output;
+            batleth::TextureType texture_type = batleth::TextureType::Unknown;   // Unknown until a model uses it
+            batleth::ShaderCompiler::Stage stage = batleth::ShaderCompiler::Stage::Vertex;
+            uint64_t settings_hash = 0;
+            std::vector<federation::CookInput> inputs;  // Stamped while cooking: source first, then dependencies
+            std::vector<federation::CookReference> references;
+            std::string reason;
+            std::string error;
+            double cook_ms = 0.0;
+        };
+
+        struct Freshness {
+            std::string reason;                         // Empty when the record is current
+            std::vector<federation::CookInput> inputs;  // The record's inputs with refreshed stamps
+            uint32_t rehashed = 0;
+        };
+
+        auto elapsed_ms(Clock::time_point start) -> double {
+            return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        }
+
+        auto get_extension(std::string_view path) -> std::string {
+            std::string ext = std::filesystem::path(path).extension().string();
+            std::ranges::transform(ext, ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            return ext;
+        }
+
+        auto classify(std::string_view ext) -> std::optional<AssetKind> {
+            if (ext == ".obj" || ext == ".fbx" || ext == ".gltf" || ext == ".glb" || ext == ".dae") {
+                return AssetKind::Mesh;
+            }
+            if (ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".tga" || ext == ".bmp") {
+                return AssetKind::Texture;
+            }
+            // .glsl files are include-only and get cooked as part of the shaders that use them
+            if (ext == ".vert" || ext == ".frag" || ext == ".comp" || ext == ".geom" || ext == ".tesc" || ext == ".tese") {
+                return AssetKind::Shader;
+            }
+            return std::nullopt;
+        }
+
+        auto get_shader_stage(std::string_view ext) -> batleth::ShaderCompiler::Stage {
+            using Stage = batleth::ShaderCompiler::Stage;
+            if (ext == ".frag") return Stage::Fragment;
+            if (ext == ".comp") return Stage::Compute;
+            if (ext == ".geom") return Stage::Geometry;
+            if (ext == ".tesc") return Stage::TessellationControl;
+            if (ext == ".tese") return Stage::TessellationEvaluation;
+            return Stage::Vertex;
+        }
+
+        auto get_output_path(AssetKind kind, const std::string& source) -> std::string {
+            switch (kind) {
+                case AssetKind::Mesh:
+                    // Where AssetLoader looks for it, so cooked meshes load even without the manifest
+                    return klingon::AssetLoader::get_cooked_path(source).generic_string();
+                case AssetKind::Texture:
+                    return std::filesystem::path(source).replace_extension(".ktx2").generic_string();
+                case AssetKind::Shader:
+                    return source + ".spv";
+            }
+            return source;
+        }
+
+        auto get_usage_name(batleth::TextureType type) -> std::string_view {
+            switch (type) {
+                case batleth::TextureType::Normal: return "normal";
+                case batleth::TextureType::MetallicRoughness: return "pbr";
+                case batleth::TextureType::Opacity: return "opacity";
+                default: return "albedo";
+            }
+        }
+
+        auto parse_usage(std::string_view usage) -> batleth::TextureType {
+            if (usage == "normal") return batleth::TextureType::Normal;
+            if (usage == "pbr") return batleth::TextureType::MetallicRoughness;
+            if (usage == "opacity") return batleth::TextureType::Opacity;
+            return batleth::TextureType::Albedo;
+        }
+
+        auto hash_text(std::string_view text) -> uint64_t {
+            return federation::hash_content(std::as_bytes(std::span(text.data(), text.size())));
+        }
+
+        auto get_settings_hash(const Node& node, const BuildSettings& settings) -> uint64_t {
+            switch (node.kind) {
+                case AssetKind::Mesh:
+                    return hash_text(std::format("mesh:{}:{}:{}:{}", klingon::KMESH_VERSION, klingon::KMESH_IMPORT_VERSION,
+                                                 settings.weld.position_epsilon, settings.weld.attribute_epsilon));
+                case AssetKind::Texture: {
+                    const auto& texture = settings.texture;
+                    return hash_text(std::format("texture:{}:{}:{}:{}:{}:{}:{}:{}", TEXTURE_COOK_VERSION,
+                                                 static_cast<int>(node.texture_type), static_cast<int>(texture.filter),
+                                                 texture.generate_mips, texture.wrap, texture.prefer_bc1,
+                                                 texture.bc7_uber_level, texture.bc1_level));
+                }
+                case AssetKind::Shader:
+                    return hash_text(std::format("shader:{}:{}", SHADER_COOK_VERSION, static_cast<int>(node.stage)));
+            }
+            return 0;
+        }
+
+        /**
+         * Run fn(i) for i in [0, count) on up to `threads` threads (the caller is one of them)
+         */
+        template<typename Fn>
+        auto parallel_for(size_t count, uint32_t threads, Fn&& fn) -> void {
+            threads = static_cast<uint32_t>(std::min<size_t>(threads, count));
+            if (threads <= 1) {
+                for (size_t i = 0; i < count; ++i) {
+                    fn(i);
+                }
+                return;
+            }
+
+            std::atomic<size_t> next{0};
+            auto worker = [&] {
+                for (size_t i = next++; i < count; i = next++) {
+                    fn(i);
+                }
+            };
+
+            std::vector<std::jthread> pool;
+            pool.reserve(threads - 1);
+            for (uint32_t i = 0; i + 1 < threads; ++i) {
+                pool.emplace_back(worker);
+            }
+            worker();
+        }
+
+        auto stamp_input(const std::string& path) -> std::expected<federation::CookInput, std::string> {
+            auto& vfs = federation::VirtualFileSystem::get();
+            auto info = vfs.stat(path);
+            auto data = vfs.read(path);
+            if (!info || !data) {
+                return std::unexpected(std::format("could not read {}", path));
+            }
+            return federation::CookInput{path, federation::hash_content(data->get_data()), info->size, info->mtime};
+        }
+
+        /**
+         * Decide whether a node's recorded cook is still valid
+         * Stamps are compared first; an input is only read and hashed when its stamp moved.
+         */
+        auto check_freshness(const Node& node, const federation::CookRecord* record, bool force) -> Freshness {
+            Freshness freshness;
+            if (force) {
+                freshness.reason = "forced";
+                return freshness;
+            }
+            if (!record) {
+                freshness.reason = "new";
+                return freshness;
+            }
+            if (record->settings_hash != node.settings_hash) {
+                freshness.reason = "settings changed";
+                return freshness;
+            }
+            auto& vfs = federation::VirtualFileSystem::get();
+            if (!vfs.exists(record->output)) {
+                freshness.reason = "output missing";
+                return freshness;
+            }
+
+            freshness.inputs = record->inputs;
+            for (auto& input : freshness.inputs) {
+                auto info = vfs.stat(input.path);
+                if (!info) {
+                    freshness.reason = std::format("{} removed", input.path);
+                    return freshness;
+                }
+                if (info->size == input.size && info->mtime == input.mtime) {
+                    continue;
+                }
+
+                auto stamped = stamp_input(input.path);
+                if (!stamped || stamped->hash != input.hash) {
+                    freshness.reason = input.path == node.source ? "source changed" : std::format("{} changed", input.path);
+                    return freshness;
+                }
+                // Touched but identical (checkout, copy): keep the cook, remember the new stamp
+                input = std::move(*stamped);
+                ++freshness.rehashed;
+            }
+            return freshness;
+        }
+
+        auto write_file(const std::filesystem::path& path, std::span<const std::byte> data)
+            -> std::expected<void, std::string> {
+            auto temp = path;
+            temp += ".tmp";
+            {
+                std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+                file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+                if (!file) {
+                    return std::unexpected(std::format("failed writing {}", temp.string()));
+                }
+            }
+            std::error_code ec;
+            std::filesystem::rename(temp, path, ec);
+            if (ec) {
+                return std::unexpected(std::format("could not replace {}: {}", path.string(), ec.message()));
+            }
+            return {};
+        }
+
+        /**
+         * Inline `#include "file"` directives (resolved relative to the including file)
+         * The engine's runtime compiler has no include support, so cooked shaders are the only
+         * ones that may use them. #line directives keep error line numbers meaningful.
+         */
+        auto expand_includes(const std::string& path, std::vector<std::string>& dependencies,
+                             std::vector<std::string>& stack) -> std::expected<std::string, std::string> {
+            if (stack.size() >= MAX_INCLUDE_DEPTH) {
+                return std::unexpected(std::format("includes nested deeper than {} at {}", MAX_INCLUDE_DEPTH, path));
+            }
+            if (std::ranges::find(stack, path) != stack.end()) {
+                return std::unexpected(std::format("{} includes itself", path));
+            }
+
+            auto file = federation::VirtualFileSystem::get().read(path);
+            if (!file) {
+                return std::unexpected(file.error());
+            }
+            if (!stack.empty() && std::ranges::find(dependencies, path) == dependencies.end()) {
+                dependencies.push_back(path);
+            }
+            stack.push_back(path);
+
+            const auto text = file->as_string_view();
+            const auto directory = std::filesystem::path(path).parent_path();
+            std::string expanded;
+            expanded.reserve(text.size());
+
+            uint32_t line_number = 0;
+            for (size_t start = 0; start < text.size();) {
+                size_t end = text.find('\n', start);
+                if (end == std::string_view::npos) {
+                    end = text.size();
+                }
+                const auto line = text.substr(start, end - start);
+                start = end + 1;
+                ++line_number;
+
+                const auto first = line.find_first_not_of(" \t");
+                if (first == std::string_view::npos || !line.substr(first).starts_with("#include")) {
+                    expanded.append(line);
+                    expanded += '\n';
+                    continue;
+                }
+
+                const auto open = line.find('"', first);
+                const auto close = open == std::string_view::npos ? open : line.find('"', open + 1);
+                if (close == std::string_view::npos) {
+                    return std::unexpected(std::format("{}:{}: malformed #include", path, line_number));
+                }
+                const auto target = federation::VirtualFileSystem::normalize_path(
+                    (directory / line.substr(open + 1, close - open - 1)).generic_string());
+
+                auto included = expand_includes(target, dependencies, stack);
+                if (!included) {
+                    return std::unexpected(std::format("{}:{}: {}", path, line_number, included.error()));
+                }
+                expanded += "#line 1\n";
+                expanded += *included;
+                expanded += std::format("#line {}\n", line_number + 1);
+            }
+
+            stack.pop_back();
+            return expanded;
+        }
+
+        auto cook_mesh(Node& node, const klingon::VertexWelder::Config& weld) -> void {
+            const auto start = Clock::now();
+            auto source_stamp = stamp_input(node.source);
+            if (!source_stamp) {
+                node.error = source_stamp.error();
+                return;
+            }
+
+            std::vector<std::string> dependencies;
+            auto model = klingon::AssetLoader::import_model(node.source, &dependencies, weld);
+            if (!model) {
+                node.error = "import failed";
+                return;
+            }
+
+            auto kmesh_stamp = klingon::KmeshSourceStamp::from_file(node.source);
+            if (!kmesh_stamp) {
+                node.error = std::format("could not stat {}", node.source);
+                return;
+            }
+            if (auto written = klingon::write_kmesh(node.output, *model, *kmesh_stamp); !written) {
+                node.error = written.error();
+                return;
+            }
+
+            node.inputs = {std::move(*source_stamp)};
+            for (const auto& dependency : dependencies) {
+                if (auto stamped = stamp_input(dependency)) {
+                    node.inputs.push_back(std::move(*stamped));
+                }
+            }
+
+            node.references.clear();
+            auto add_reference = [&](const std::string& path, batleth::TextureType type) {
+                if (path.empty()) {
+                    return;
+                }
+                federation::CookReference reference{path, std::string(get_usage_name(type))};
+                auto same = [&](const federation::CookReference& other) {
+                    return other.path == reference.path && other.usage == reference.usage;
+                };
+                if (std::ranges::none_of(node.references, same)) {
+                    node.references.push_back(std::move(reference));
+                }
+            };
+            for (const auto& material : model->materials) {
+                add_reference(material.albedo_texture_path, batleth::TextureType::Albedo);
+                add_reference(material.normal_texture_path, batleth::TextureType::Normal);
+                add_reference(material.pbr_texture_path, batleth::TextureType::MetallicRoughness);
+                add_reference(material.opacity_texture_path, batleth::TextureType::Opacity);
+            }
+            node.cook_ms = elapsed_ms(start);
+        }
+
+        auto cook_shader(Node& node) -> void {
+            const auto start = Clock::now();
+            auto source_stamp = stamp_input(node.source);
+            if (!source_stamp) {
+                node.error = source_stamp.error();
+                return;
+            }
+
+            std::vector<std::string> includes;
+            std::vector<std::string> stack;
+            auto source = expand_includes(node.source, includes, stack);
+            if (!source) {
+                node.error = source.error();
+                return;
+            }
+
+            batleth::ShaderCompiler compiler;
+            batleth::ShaderCompiler::CompileOptions options;
+            options.stage = node.stage;
+            options.optimization = batleth::ShaderCompiler::OptimizationLevel::Performance;
+            options.use_cache = false;
+            auto result = compiler.compile(*source, node.source, options);
+            if (!result.success) {
+                node.error = result.error_message;
+                return;
+            }
+
+            if (auto written = write_file(node.output, std::as_bytes(std::span(result.spirv))); !written) {
+                node.error = written.error();
+                return;
+            }
+
+            node.inputs = {std::move(*source_stamp)};
+            for (const auto& include : includes) {
+                if (auto stamped = stamp_input(include)) {
+                    node.inputs.push_back(std::move(*stamped));
+                }
+            }
+            node.cook_ms = elapsed_ms(start);
+        }
+
+        auto cook_textures(std::span<Node*> nodes, const BuildSettings& settings, uint32_t threads) -> void {
+            std::vector<replicator::CookJob> jobs;
+            jobs.reserve(nodes.size());
+            for (Node* node : nodes) {
+                auto source_stamp = stamp_input(node->source);
+                if (!source_stamp) {
+                    node->error = source_stamp.error();
+                    continue;
+                }
+                node->inputs = {std::move(*source_stamp)};
+
+                auto texture_settings = settings.texture;
+                texture_settings.type = node->texture_type;
+                jobs.push_back({.input = node->source, .output = node->output, .settings = texture_settings});
+            }
+
+            replicator::BatchSettings batch{};
+            batch.threads = threads;
+            const auto results = replicator::cook_textures(jobs, batch);
+
+            size_t job = 0;
+            for (Node* node : nodes) {
+                if (!node->error.empty()) {
+                    continue;
+                }
+                const auto& result = results[job++];
+                if (!result.success) {
+                    node->error = result.error;
+                    continue;
+                }
+                node->cook_ms = result.load_ms + result.mip_ms + result.compress_ms + result.write_ms;
+            }
+        }
+
+        auto scan_roots(const BuildSettings& settings, std::map<std::string, Node>& nodes, BuildReport& report) -> void {
+            for (const auto& root : settings.roots) {
+                std::error_code ec;
+                if (!std::filesystem::is_directory(root, ec)) {
+                    report.warnings.push_back(std::format("{} is not a directory", root.string()));
+                    continue;
+                }
+
+                for (const auto& entry : std::filesystem::recursive_directory_iterator(root, ec)) {
+                    if (!entry.is_regular_file()) {
+                        continue;
+                    }
+                    auto source = federation::VirtualFileSystem::normalize_path(entry.path().generic_string());
+                    const auto ext = get_extension(source);
+                    auto kind = classify(ext);
+                    if (!kind) {
+                        continue;
+                    }
+
+                    Node node;
+                    node.kind = *kind;
+                    node.output = get_output_path(*kind, source);
+                    node.stage = get_shader_stage(ext);
+                    node.source = source;
+                    nodes.try_emplace(std::move(source), std::move(node));
+                }
+            }
+        }
+
+        /**
+         * Add the textures models use, or give scanned ones the usage a model assigns them
+         */
+        auto resolve_references(const BuildSettings& settings, std::map<std::string, Node>& nodes, BuildReport& report)
+            -> void {
+            auto& vfs = federation::VirtualFileSystem::get();
+            std::vector<std::pair<std::string, federation::CookReference>> references;
+            for (const auto& node : nodes | std::views::values) {
+                for (const auto& reference : node.references) {
+                    references.emplace_back(node.source, reference);
+                }
+            }
+
+            for (const auto& [model, reference] : references) {
+                auto source = federation::VirtualFileSystem::normalize_path(settings.textures_dir + "/" + reference.path);
+                if (!classify(get_extension(source)).has_value()) {
+                    continue;  // Already cooked (.ktx2, .dds) or not an image the cooker reads
+                }
+                if (!vfs.exists(source)) {
+                    report.warnings.push_back(std::format("{} uses missing texture {}", model, source));
+                    continue;
+                }
+
+                const auto type = parse_usage(reference.usage);
+                auto [it, inserted] = nodes.try_emplace(source);
+                Node& texture = it->second;
+                if (inserted) {
+                    texture.kind = AssetKind::Texture;
+                    texture.source = source;
+                    texture.output = get_output_path(AssetKind::Texture, source);
+                }
+                if (texture.texture_type == batleth::TextureType::Unknown) {
+                    texture.texture_type = type;
+                } else if (texture.texture_type != type) {
+                    report.warnings.push_back(std::format("{} is used as both {} and {}; cooking as {}", source,
+                                                          get_usage_name(texture.texture_type), reference.usage,
+                                                          get_usage_name(texture.texture_type)));
+                }
+            }
+
+            for (auto& node : nodes | std::views::values) {
+                if (node.kind == AssetKind::Texture && node.texture_type == batleth::TextureType::Unknown) {
+                    node.texture_type = settings.texture.type;
+                }
+            }
+        }
+
+        /**
+         * Check every node of `kind`, leaving the stale ones in `dirty`
+         */
+        auto diff_against_manifest(AssetKind kind, const BuildSettings& settings, uint32_t threads,
+                                   const federation::CookManifest& manifest, std::map<std::string, Node>& nodes,
+                                   std::vector<Node*>& dirty, BuildReport& report) -> void {
+            std::vector<Node*> candidates;
+            for (auto& node : nodes | std::views::values) {
+                if (node.kind == kind) {
+                    node.settings_hash = get_settings_hash(node, settings);
+                    candidates.push_back(&node);
+                }
+            }
+
+            std::vector<Freshness> results(candidates.size());
+            parallel_for(candidates.size(), threads, [&](size_t i) {
+                results[i] = check_freshness(*candidates[i], manifest.find(candidates[i]->output), settings.force);
+            });
+
+            for (size_t i = 0; i < candidates.size(); ++i) {
+                Node& node = *candidates[i];
+                report.rehashed += results[i].rehashed;
+                // Kept if the node is not re-cooked (up to date or a dry run); a cook replaces them
+                if (const auto* record = manifest.find(node.output)) {
+                    node.references = record->references;
+                }
+                if (!results[i].reason.empty()) {
+                    node.reason = std::move(results[i].reason);
+                    dirty.push_back(&node);
+                    continue;
+                }
+                node.inputs = std::move(results[i].inputs);
+            }
+        }
+    } // anonymous namespace
+
+    auto get_kind_name(AssetKind kind) -> std::string_view {
+        switch (kind) {
+            case AssetKind::Mesh: return "mesh";
+            case AssetKind::Texture: return "texture";
+            case AssetKind::Shader: return "shader";
+        }
+        return "unknown";
+    }
+
+    auto run_build(const BuildSettings& settings) -> std::expected<BuildReport, std::string> {
+        const auto start = Clock::now();
+        const uint32_t threads = settings.threads != 0 ? settings.threads : std::max(std::thread::hardware_concurrency(), 1u);
+        const auto manifest_path = settings.manifest.generic_string();
+        BuildReport report;
+
+        federation::CookManifest manifest;
+        if (federation::VirtualFileSystem::get().exists(manifest_path)) {
+            auto loaded = federation::CookManifest::load(settings.manifest);
+            if (loaded) {
+                manifest = std::move(*loaded);
+            } else {
+                report.warnings.push_back(std::format("ignoring manifest: {}", loaded.error()));
+            }
+        }
+
+        std::map<std::string, Node> nodes;
+        scan_roots(settings, nodes, report);
+
+        // Meshes first: cooking them is what tells us which textures they use and how
+        std::vector<Node*> dirty_meshes;
+        diff_against_manifest(AssetKind::Mesh, settings, threads, manifest, nodes, dirty_meshes, report);
+        if (!settings.dry_run) {
+            parallel_for(dirty_meshes.size(), threads, [&](size_t i) { cook_mesh(*dirty_meshes[i], settings.weld); });
+        }
+        resolve_references(settings, nodes, report);
+
+        std::vector<Node*> dirty_textures;
+        std::vector<Node*> dirty_shaders;
+        diff_against_manifest(AssetKind::Texture, settings, threads, manifest, nodes, dirty_textures, report);
+        diff_against_manifest(AssetKind::Shader, settings, threads, manifest, nodes, dirty_shaders, report);
+        if (!settings.dry_run) {
+            // Shaders are cheap next to block compression; let them share the cores
+            std::jthread shader_thread([&] {
+                parallel_for(dirty_shaders.size(), std::max(threads / 4, 1u), [&](size_t i) { cook_shader(*dirty_shaders[i]); });
+            });
+            if (!dirty_textures.empty()) {
+                cook_textures(dirty_textures, settings, threads);
+            }
+        }
+
+        // Records for sources that no longer exist are dropped; ones merely outside these roots are kept
+        std::vector<std::string> orphaned;
+        for (const auto& [output, record] : manifest.get_records()) {
+            if (!nodes.contains(std::string(record.get_source())) &&
+                !federation::VirtualFileSystem::get().exists(record.get_source())) {
+                orphaned.push_back(output);
+            }
+        }
+        for (const auto& output : orphaned) {
+            manifest.erase(output);
+        }
+
+        for (auto& node : nodes | std::views::values) {
+            if (node.reason.empty()) {
+                ++report.up_to_date;
+            } else if (!node.error.empty()) {
+                ++report.failed;
+                manifest.erase(node.output);
+            } else if (!settings.dry_run) {
+                ++report.cooked;
+            }
+
+            if (node.error.empty() && !node.inputs.empty()) {
+                manifest.set(federation::CookRecord{
+                    .output = node.output,
+                    .kind = std::string(get_kind_name(node.kind)),
+                    .settings_hash = node.settings_hash,
+                    .inputs = node.inputs,
+                    .references = node.references
+                });
+            }
+
+            report.items.push_back(BuildItem{
+                .kind = node.kind,
+                .source = node.source,
+                .output = node.output,
+                .reason = std::move(node.reason),
+                .error = std::move(node.error),
+                .cook_ms = node.cook_ms
+            });
+        }
+        std::ranges::stable_sort(report.items, {}, [](const BuildItem& item) { return static_cast<int>(item.kind); });
+
+        if (!settings.dry_run) {
+            if (auto saved = manifest.save(settings.manifest); !saved) {
+                return std::unexpected(saved.error());
+            }
+        }
+
+        report.total_ms = elapsed_ms(start);
+        return report;
+    }
+} // namespace cooker
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "klingon/model/vertex_welder.hpp"
+#include "replicator/cooked_texture.hpp"
+
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cooker {
+    struct BuildSettings {
+        std::vector<std::filesystem::path> roots;                       // Scanned recursively for sources
+        std::filesystem::path manifest = "assets/cook_manifest.json";
+        std::string textures_dir = "assets/textures";                   // Model texture references resolve here, as in TextureManager
+        replicator::TextureCookSettings texture{};                      // Type is overridden by how models use each texture
+        klingon::VertexWelder::Config weld{};                           // Vertex merge tolerances for meshes
+        uint32_t threads = 0;                                           // 0 = all cores
+        bool force = false;                                             // Cook everything regardless of the manifest
+        bool dry_run = false;                                           // Report what would be cooked, write nothing
+    };
+
+    enum class AssetKind {
+        Mesh,       // Assimp source -> .kmesh
+        Texture,    // stb_image source -> .ktx2
+        Shader      // GLSL -> .spv
+    };
+
+    struct BuildItem {
+        AssetKind kind = AssetKind::Texture;
+        std::string source;
+        std::string output;
+        std::string reason;             // Why it was (or would be) cooked; empty when up to date
+        std::string error;              // Set when cooking failed
+        double cook_ms = 0.0;
+    };
+
+    struct BuildReport {
+        std::vector<BuildItem> items;   // Meshes, then textures, then shaders; sorted by source
+        std::vector<std::string> warnings;
+        uint32_t up_to_date = 0;
+        uint32_t cooked = 0;
+        uint32_t failed = 0;
+        uint32_t rehashed = 0;          // Inputs whose stamp changed but whose contents didn't
+        double total_ms = 0.0;
+    };
+
+    [[nodiscard]] auto get_kind_name(AssetKind kind) -> std::string_view;
+
+    /**
+     * Incremental cook of every asset under the roots
+     *
+     * Each source becomes a node in a dependency graph: meshes depend on the side files their
+     * importer reads and reference the textures their materials use (which are cooked as
+     * textures of that usage even outside the roots); shaders depend on their #include files.
+     * A node is re-cooked when its cook settings changed or one of its inputs' contents did.
+     * Inputs are compared by size and modification time first and only hashed when those
+     * differ, so an untouched tree costs one stat per input. Cooking runs in parallel, meshes
+     * first (they discover texture usages), then textures and shaders together.
+     */
+    auto run_build(const BuildSettings& settings) -> std::expected<BuildReport, std::string>;
+} // namespace cooker
@@ -0,0 +1,388 @@
+#include "asset_build.hpp"
+#include "federation/storage/pack_file.hpp"
+#include "replicator/block_compressor.hpp"
+#include "replicator/texture_cooker.hpp"
+
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace {
+    auto print_usage(std::string_view program) -> void {
+        std::cerr << "Usage: " << program << " texture [options] <input>...\n"
+                  << "  -o <file>                          Output path (single input only)\n"
+                  << "  --out-dir <dir>                    Output directory (default: next to each input)\n"
+                  << "  --type albedo|normal|pbr|opacity   Texture usage (default: albedo)\n"
+                  << "  --filter kaiser|lanczos|box        Mip filter (default: kaiser)\n"
+                  << "  --no-mips                          Only compress mip 0\n"
+                  << "  --clamp                            Clamp instead of wrap at edges when filtering\n"
+                  << "  --bc1                              Use BC1 for opaque colour textures\n"
+                  << "  --quality <0-4>                    BC7 encoder effort (default: 1)\n"
+                  << "  --threads <n>                      Worker threads (default: all cores)\n"
+                  << "  --psnr                             Decode the output and report PSNR per mip\n"
+                  << "\n"
+                  << "       " << program << " pack -o <file> [options] <directory>...\n"
+                  << "  --prefix <path>                    Virtual directory the files are packed under\n"
+                  << "  --align <n>                        Entry data alignment in bytes (default: 64)\n"
+                  << "  --level <0-12>                     LZ4 HC level, 0 for fast LZ4 (default: 9)\n"
+                  << "\n"
+                  << "       " << program << " build [options] <root>...\n"
+                  << "  --manifest <file>                  Cook manifest (default: assets/cook_manifest.json)\n"
+                  << "  --textures-dir <dir>               Where model texture references resolve (default: assets/textures)\n"
+                  << "  --threads <n>                      Worker threads (default: all cores)\n"
+                  << "  --force                            Cook everything, ignoring the manifest\n"
+                  << "  --dry-run                          Only report what would be cooked\n"
+                  << "  --weld <eps> [<attribute eps>]     Merge mesh vertices closer than eps (default: exact)\n"
+                  << "  --filter, --no-mips, --clamp, --bc1, --quality as for texture\n";
+    }
+
+    auto parse_uint(std::string_view text) -> std::optional<uint32_t> {
+        uint32_t value = 0;
+        auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+        if (ec != std::errc{} || ptr != text.data() + text.size()) {
+            return std::nullopt;
+        }
+        return value;
+    }
+
+    auto parse_float(std::string_view text) -> std::optional<float> {
+        float value = 0.0f;
+        auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+        if (ec != std::errc{} || ptr != text.data() + text.size()) {
+            return std::nullopt;
+        }
+        return value;
+    }
+
+    auto parse_type(std::string_view text) -> std::optional<batleth::TextureType> {
+        if (text == "albedo") return batleth::TextureType::Albedo;
+        if (text == "normal") return batleth::TextureType::Normal;
+        if (text == "pbr") return batleth::TextureType::MetallicRoughness;
+        if (text == "opacity") return batleth::TextureType::Opacity;
+        return std::nullopt;
+    }
+
+    auto parse_filter(std::string_view text) -> std::optional<replicator::MipFilter> {
+        if (text == "kaiser") return replicator::MipFilter::Kaiser;
+        if (text == "lanczos") return replicator::MipFilter::Lanczos;
+        if (text == "box") return replicator::MipFilter::Box;
+        return std::nullopt;
+    }
+
+    auto cook_texture_command(std::string_view program, int argc, char** argv) -> int {
+        replicator::TextureCookSettings settings{};
+        replicator::BatchSettings batch{};
+        std::optional<std::filesystem::path> output;
+        std::optional<std::filesystem::path> out_dir;
+        std::vector<std::filesystem::path> inputs;
+
+        for (int i = 0; i < argc; ++i) {
+            std::string_view arg = argv[i];
+            const bool has_value = i + 1 < argc;
+
+            if (arg == "-o" && has_value) {
+                output = argv[++i];
+            } else if (arg == "--out-dir" && has_value) {
+                out_dir = argv[++i];
+            } else if (arg == "--type" && has_value) {
+                auto type = parse_type(argv[++i]);
+                if (!type) {
+                    std::cerr << "Unknown texture type: " << argv[i] << '\n';
+                    return EXIT_FAILURE;
+                }
+                settings.type = *type;
+            } else if (arg == "--filter" && has_value) {
+                auto filter = parse_filter(argv[++i]);
+                if (!filter) {
+                    std::cerr << "Unknown mip filter: " << argv[i] << '\n';
+                    return EXIT_FAILURE;
+                }
+                settings.filter = *filter;
+            } else if (arg == "--no-mips") {
+                settings.generate_mips = false;
+            } else if (arg == "--clamp") {
+                settings.wrap = false;
+            } else if (arg == "--bc1") {
+                settings.prefer_bc1 = true;
+            } else if (arg == "--quality" && has_value) {
+                auto quality = parse_uint(argv[++i]);
+                if (!quality || *quality > 4) {
+                    std::cerr << "Quality must be 0-4\n";
+                    return EXIT_FAILURE;
+                }
+                settings.bc7_uber_level = *quality;
+            } else if (arg == "--threads" && has_value) {
+                auto threads = parse_uint(argv[++i]);
+                if (!threads) {
+                    std::cerr << "Invalid thread count: " << argv[i] << '\n';
+                    return EXIT_FAILURE;
+                }
+                batch.threads = *threads;
+            } else if (arg == "--psnr") {
+                batch.measure_psnr = true;
+            } else if (arg.starts_with("-")) {
+                std::cerr << "Unknown argument: " << arg << '\n';
+                print_usage(program);
+                return EXIT_FAILURE;
+            } else {
+                inputs.emplace_back(arg);
+            }
+        }
+
+        if (inputs.empty() || (output && inputs.size() != 1)) {
+            print_usage(program);
+            return EXIT_FAILURE;
+        }
+
+        std::vector<replicator::CookJob> jobs;
+        jobs.reserve(inputs.size());
+        for (const auto& input : inputs) {
+            auto target = output.value_or(std::filesystem::path(input).replace_extension(".ktx2"));
+            if (out_dir) {
+                target = *out_dir / target.filename();
+            }
+            jobs.push_back({.input = input, .output = target, .settings = settings});
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto results = replicator::cook_textures(jobs, batch);
+        const double total_ms =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        uint64_t total_pixels = 0;
+        uint32_t failures = 0;
+        for (size_t i = 0; i < results.size(); ++i) {
+            const auto& result = results[i];
+            if (!result.success) {
+                std::cerr << std::format("FAILED {}: {}\n", jobs[i].input.string(), result.error);
+                ++failures;
+                continue;
+            }
+
+            total_pixels += static_cast<uint64_t>(result.width) * result.height;
+            std::cout << std::format("{} -> {} ({}x{}, {} mips, {}, {} KiB)\n", jobs[i].input.string(),
+                                     jobs[i].output.string(), result.width, result.height, result.mip_levels,
+                                     replicator::get_block_format_name(result.format), result.output_bytes / 1024);
+            std::cout << std::format("  load {:.1f} ms, mips {:.1f} ms, compress {:.1f} ms, write {:.1f} ms\n",
+                                     result.load_ms, result.mip_ms, result.compress_ms, result.write_ms);
+
+            for (size_t mip = 0; mip < result.psnr.size(); ++mip) {
+                if (std::isinf(result.psnr[mip])) {
+                    std::cout << std::format("  mip {:2}: lossless\n", mip);
+                } else {
+                    std::cout << std::format("  mip {:2}: {:.2f} dB\n", mip, result.psnr[mip]);
+                }
+            }
+        }
+
+        const double megapixels = static_cast<double>(total_pixels) / 1e6;
+        std::cout << std::format("Cooked {}/{} textures in {:.1f} ms ({:.2f} MPix/s)\n",
+                                 results.size() - failures, results.size(), total_ms,
+                                 total_ms > 0.0 ? megapixels / (total_ms / 1000.0) : 0.0);
+
+        return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    auto pack_command(std::string_view program, int argc, char** argv) -> int {
+        federation::PackWriterSettings settings{};
+        std::optional<std::filesystem::path> output;
+        std::string prefix;
+        std::vector<std::filesystem::path> inputs;
+
+        for (int i = 0; i < argc; ++i) {
+            std::string_view arg = argv[i];
+            const bool has_value = i + 1 < argc;
+
+            if (arg == "-o" && has_value) {
+                output = argv[++i];
+            } else if (arg == "--prefix" && has_value) {
+                prefix = argv[++i];
+            } else if (arg == "--align" && has_value) {
+                auto alignment = parse_uint(argv[++i]);
+                if (!alignment || !std::has_single_bit(*alignment)) {
+                    std::cerr << "Alignment must be a power of two\n";
+                    return EXIT_FAILURE;
+                }
+                settings.alignment = *alignment;
+            } else if (arg == "--level" && has_value) {
+                auto level = parse_uint(argv[++i]);
+                if (!level || *level > 12) {
+                    std::cerr << "Level must be 0-12\n";
+                    return EXIT_FAILURE;
+                }
+                settings.compression_level = static_cast<int>(*level);
+            } else if (arg.starts_with("-")) {
+                std::cerr << "Unknown argument: " << arg << '\n';
+                print_usage(program);
+                return EXIT_FAILURE;
+            } else {
+                inputs.emplace_back(arg);
+            }
+        }
+
+        if (!output || inputs.empty()) {
+            print_usage(program);
+            return EXIT_FAILURE;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        federation::PackWriter writer(settings);
+        for (const auto& input : inputs) {
+            auto added = writer.add_directory(input, prefix);
+            if (!added) {
+                std::cerr << std::format("FAILED {}: {}\n", input.string(), added.error());
+                return EXIT_FAILURE;
+            }
+            std::cout << std::format("{}: {} files\n", input.string(), *added);
+        }
+
+        auto stats = writer.write(*output);
+        if (!stats) {
+            std::cerr << std::format("FAILED {}: {}\n", output->string(), stats.error());
+            return EXIT_FAILURE;
+        }
+
+        const double total_ms =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        const double ratio = stats->raw_bytes > 0
+                                 ? static_cast<double>(stats->stored_bytes) / static_cast<double>(stats->raw_bytes)
+                                 : 1.0;
+        std::cout << std::format("Packed {} files ({} compressed) into {}: {} KiB -> {} KiB ({:.1f}%) in {:.1f} ms\n",
+                                 stats->file_count, stats->compressed_count, output->string(),
+                                 stats->raw_bytes / 1024, stats->stored_bytes / 1024, ratio * 100.0, total_ms);
+        return EXIT_SUCCESS;
+    }
+
+    auto build_command(std::string_view program, int argc, char** argv) -> int {
+        cooker::BuildSettings settings{};
+
+        for (int i = 0; i < argc; ++i) {
+            std::string_view arg = argv[i];
+            const bool has_value = i + 1 < argc;
+
+            if (arg == "--manifest" && has_value) {
+                settings.manifest = argv[++i];
+            } else if (arg == "--textures-dir" && has_value) {
+                settings.textures_dir = argv[++i];
+            } else if (arg == "--threads" && has_value) {
+                auto threads = parse_uint(argv[++i]);
+                if (!threads) {
+                    std::cerr << "Invalid thread count: " << argv[i] << '\n';
+                    return EXIT_FAILURE;
+                }
+                settings.threads = *threads;
+            } else if (arg == "--force") {
+                settings.force = true;
+            } else if (arg == "--dry-run") {
+                settings.dry_run = true;
+            } else if (arg == "--weld" && has_value) {
+                auto position = parse_float(argv[++i]);
+                if (!position || *position < 0.0f) {
+                    std::cerr << "Invalid weld epsilon: " << argv[i] << '\n';
+                    return EXIT_FAILURE;
+                }
+                settings.weld.position_epsilon = *position;
+                settings.weld.attribute_epsilon = *position;
+                if (i + 1 < argc) {
+                    if (auto attribute = parse_float(argv[i + 1]); attribute && *attribute >= 0.0f) {
+                        settings.weld.attribute_epsilon = *attribute;
+                        ++i;
+                    }
+                }
+            } else if (arg == "--filter" && has_value) {
+                auto filter = parse_filter(argv[++i]);
+                if (!filter) {
+                    std::cerr << "Unknown mip filter: " << argv[i] << '\n';
+                    return EXIT_FAILURE;
+                }
+                settings.texture.filter = *filter;
+            } else if (arg == "--no-mips") {
+                settings.texture.generate_mips = false;
+            } else if (arg == "--clamp") {
+                settings.texture.wrap = false;
+            } else if (arg == "--bc1") {
+                settings.texture.prefer_bc1 = true;
+            } else if (arg == "--quality" && has_value) {
+                auto quality = parse_uint(argv[++i]);
+                if (!quality || *quality > 4) {
+                    std::cerr << "Quality must be 0-4\n";
+                    return EXIT_FAILURE;
+                }
+                settings.texture.bc7_uber_level = *quality;
+            } else if (arg.starts_with("-")) {
+                std::cerr << "Unknown argument: " << arg << '\n';
+                print_usage(program);
+                return EXIT_FAILURE;
+            } else {
+                settings.roots.emplace_back(arg);
+            }
+        }
+
+        if (settings.roots.empty()) {
+            print_usage(program);
+            return EXIT_FAILURE;
+        }
+
+        auto report = cooker::run_build(settings);
+        if (!report) {
+            std::cerr << std::format("FAILED: {}\n", report.error());
+            return EXIT_FAILURE;
+        }
+
+        for (const auto& item : report->items) {
+            if (!item.error.empty()) {
+                std::cerr << std::format("FAILED {} {}: {}\n", cooker::get_kind_name(item.kind), item.source, item.error);
+            } else if (!item.reason.empty()) {
+                std::cout << std::format("{:<8} {} -> {} ({}", cooker::get_kind_name(item.kind), item.source,
+                                         item.output, item.reason);
+                std::cout << (settings.dry_run ? ")\n" : std::format(", {:.1f} ms)\n", item.cook_ms));
+            }
+        }
+        for (const auto& warning : report->warnings) {
+            std::cerr << "warning: " << warning << '\n';
+        }
+
+        std::cout << std::format("{} {}, {} up to date, {} failed ({} inputs touched but unchanged) in {:.1f} ms\n",
+                                 settings.dry_run ? "Would cook" : "Cooked",
+                                 settings.dry_run ? report->items.size() - report->up_to_date - report->failed
+                                                  : report->cooked,
+                                 report->up_to_date, report->failed, report->rehashed, report->total_ms);
+        return report->failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+} // anonymous namespace
+
+auto main(int argc, char** argv) -> int {
+    if (argc < 2) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    try {
+        std::string_view command = argv[1];
+        if (command == "texture") {
+            return cook_texture_command(argv[0], argc - 2, argv + 2);
+        }
+        if (command == "pack") {
+            return pack_command(argv[0], argc - 2, argv + 2);
+        }
+        if (command == "build") {
+            return build_command(argv[0], argc - 2, argv + 2);
+        }
+
+        std::cerr << "Unknown command: " << command << '\n';
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    } catch (const std::exception& e) {
+        std::cerr << "Fatal error: " << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+}
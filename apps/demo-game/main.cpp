@@ -13,12 +13,42 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <cstdlib>
 #include <exception>
+#include <filesystem>
 #include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
 
 #include "imgui.h"
 #include "klingon/renderer.hpp"
 
-auto main() -> int {
+namespace {
+    // Frames to render past the frames in flight before dumping, so every slot has GPU timestamps
+    constexpr std::uint32_t RENDER_GRAPH_DUMP_EXTRA_FRAMES = 2;
+}
+
+auto main(int argc, char **argv) -> int {
+    // --dump-render-graph <path>: write <path>.dot/.json after a few frames and exit
+    // --record-input <path> / --play-input <path>: record the input stream, or replay one and exit
+    std::optional<std::filesystem::path> render_graph_dump_path;
+    std::string record_input_path;
+    std::string play_input_path;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg == "--dump-render-graph" && i + 1 < argc) {
+            render_graph_dump_path = argv[++i];
+        } else if (arg == "--record-input" && i + 1 < argc) {
+            record_input_path = argv[++i];
+        } else if (arg == "--play-input" && i + 1 < argc) {
+            play_input_path = argv[++i];
+        } else {
+            std::cerr << "Unknown argument: " << arg << '\n'
+                    << "Usage: " << argv[0]
+                    << " [--dump-render-graph <path>] [--record-input <path> | --play-input <path>]\n";
+            return EXIT_FAILURE;
+        }
+    }
+
     try {
         federation::Logger::set_level(federation::LogLevel::Trace);
 
@@ -31,6 +61,8 @@ auto main() -> int {
         game_config.engine.window.height = 1080;
         game_config.engine.vulkan.instance.enable_validation = true;
         game_config.engine.renderer.debug.enable_imgui = true;
+        if (!record_input_path.empty()) game_config.engine.input.record_path = record_input_path;
+        if (!play_input_path.empty()) game_config.engine.input.playback_path = play_input_path;
 
         // Create engine from game's engine config
         auto engine = klingon::Engine{game_config.engine};
@@ -60,6 +92,7 @@ auto main() -> int {
         klingon::AssetLoader::Config asset_config{
             .device = device,
             .texture_manager = texture_manager,
+            .resources = engine.get_renderer().get_resources(),
             .base_texture_path = "assets/textures/"
         };
         klingon::AssetLoader asset_loader(asset_config);
@@ -70,6 +103,7 @@ auto main() -> int {
         smooth_vase.model_data = asset_loader.load_model(smooth_vase.model_filepath);
         smooth_vase.transform.translation = {-0.5f, 0.5f, 0.0f};
         smooth_vase.transform.scale = glm::vec3{3.f};
+        smooth_vase.is_static = true;
         scene.add_game_object(std::move(smooth_vase));
 
         // auto human = klingon::GameObject::create_game_object();
@@ -85,6 +119,7 @@ auto main() -> int {
         flat_vase.model_data = asset_loader.load_model(flat_vase.model_filepath);
         flat_vase.transform.translation = {0.5f, 0.5f, 0.0f};
         flat_vase.transform.scale = glm::vec3{3.f};
+        flat_vase.is_static = true;
         scene.add_game_object(std::move(flat_vase));
 
         // Load floor (quad)
@@ -93,6 +128,7 @@ auto main() -> int {
         floor.model_data = asset_loader.load_model(floor.model_filepath);
         floor.transform.translation = {0.f, 0.5f, 0.f};
         floor.transform.scale = glm::vec3{3.f, 1.f, 3.f};
+        floor.is_static = true;
         scene.add_game_object(std::move(floor));
 
         // Create point lights
@@ -116,13 +152,26 @@ auto main() -> int {
             scene.add_game_object(std::move(point_light));
         }
 
+        // The vases and floor never move: draw them as merged world-space batches
+        scene.build_static_geometry(device, engine.get_renderer().get_resources());
+
         // Set active scene (engine handles all rendering automatically)
         engine.set_active_scene(&scene);
 
         // Update callback only for game logic
+        std::uint32_t frame_count = 0;
         engine.set_update_callback([&](float dt) {
             // Movement controller updates camera transform
-            controller.update(window, dt, scene.get_camera_transform());
+            controller.update(engine.get_input(), dt, scene.get_camera_transform());
+
+            // Scripted runs: dump the graph once timings have settled, then let the loop exit
+            if (render_graph_dump_path &&
+                ++frame_count == engine.get_renderer().get_frames_in_flight() + RENDER_GRAPH_DUMP_EXTRA_FRAMES) {
+                // The graph may be recording on the render thread
+                auto rendering = engine.get_renderer().lock_rendering();
+                engine.get_renderer().dump_render_graph(*render_graph_dump_path);
+                ::glfwSetWindowShouldClose(window, GLFW_TRUE);
+            }
         });
 
         // ImGui callback for debug UI
@@ -131,6 +180,14 @@ auto main() -> int {
                 ::ImGui::Begin("Editor Stats");
                 ::ImGui::Text("FPS: %.1f", ::ImGui::GetIO().Framerate);
                 ::ImGui::Text("Frame time: %.3f ms", 1000.0f / ::ImGui::GetIO().Framerate);
+                ::ImGui::Text("Snapshot: %.3f ms%s", engine.get_renderer().get_snapshot_time_ms(),
+                              engine.get_config().renderer.performance.threaded_rendering ? " (threaded)" : "");
+                ::ImGui::Text("Input to submit: %.3f ms%s", engine.get_renderer().get_input_latency_ms(),
+                              engine.get_config().renderer.latency.late_latch_camera ? " (late latched)" : "");
+                const auto &pacing = engine.get_renderer().get_frame_pacing();
+                ::ImGui::Text("Frames in flight: %u", engine.get_renderer().get_frames_in_flight());
+                ::ImGui::Text("CPU wait: %.3f ms, GPU idle: %.3f ms, GPU frame: %.3f ms",
+                              pacing.cpu_wait_ms, pacing.gpu_idle_ms, pacing.gpu_frame_ms);
                 ::ImGui::Separator();
                 ::ImGui::Text("Camera Position: (%.2f, %.2f, %.2f)",
                               scene.get_camera_transform().translation.x,
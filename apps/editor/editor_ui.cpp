@@ -16,7 +16,11 @@ namespace klingon_editor {
 
         auto &device = engine.get_renderer().get_device_ref();
         auto &texture_manager = engine.get_renderer().get_texture_manager();
-        klingon::AssetLoader asset_loader{{.device = device, .texture_manager = texture_manager}};
+        klingon::AssetLoader asset_loader{{
+            .device = device,
+            .texture_manager = texture_manager,
+            .resources = engine.get_renderer().get_resources()
+        }};
 
         // Load smooth vase
         auto smooth_vase = klingon::GameObject::create_game_object();
@@ -52,7 +52,6 @@ auto main() -> int {
         engine.get_input().add_subscriber(&scene_camera_controller);
 
         // Enable raw mouse motion if available
-        auto *window = engine.get_window().get_native_handle();
         if (::glfwRawMouseMotionSupported()) {
             engine.get_window().set_input_mode(GLFW_RAW_MOUSE_MOTION, GLFW_TRUE);
         }
@@ -65,7 +64,7 @@ auto main() -> int {
         // Set up update callback (editor logic)
         engine.set_update_callback([&](float delta_time) {
             // Update scene camera
-            scene_camera_controller.update(window, delta_time, scene.get_camera_transform());
+            scene_camera_controller.update(engine.get_input(), delta_time, scene.get_camera_transform());
         });
 
         std::optional<klingon::GameObject::id_t> selected_object_id;
@@ -113,6 +112,12 @@ auto main() -> int {
                     // View options will go here
                     ::ImGui::EndMenu();
                 }
+                if (::ImGui::BeginMenu("Debug")) {
+                    if (::ImGui::MenuItem("Export Render Graph")) {
+                        engine.get_renderer().dump_render_graph("render_graph");
+                    }
+                    ::ImGui::EndMenu();
+                }
                 ::ImGui::EndMainMenuBar();
             }
 
@@ -0,0 +1,207 @@
+#include "klingon/render_graph.hpp"
+#include "federation/log.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <format>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    struct BenchConfig {
+        std::vector<uint32_t> pass_counts = {10, 100, 1000};
+        uint32_t iterations = 50;
+    };
+
+    struct BenchResult {
+        double analysis_ms = 0.0;   // Sort, cull, attachment ops and barrier analysis
+        double total_ms = 0.0;      // Including moving the graph out of the builder
+        std::size_t passes = 0;
+        std::size_t culled = 0;
+        uint32_t barriers = 0;
+        uint32_t eliminated = 0;
+    };
+
+    auto print_usage(std::string_view program) -> void {
+        std::cerr << "Usage: " << program << " [options]\n"
+                  << "  --passes <n>         Add a graph size to measure (default: 10, 100 and 1000)\n"
+                  << "  --iterations <n>     Compiles per graph size (default: 50)\n";
+    }
+
+    auto parse_uint(std::string_view text) -> std::optional<uint32_t> {
+        uint32_t value = 0;
+        auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+        if (ec != std::errc{} || ptr != text.data() + text.size()) {
+            return std::nullopt;
+        }
+        return value;
+    }
+
+    /**
+     * Synthetic frame: every pass reads the previous pass's output and one from eight passes back,
+     * every fourth pass is a compute pass writing a storage buffer, and every sixteenth render
+     * target is never read so culling has work to do.
+     */
+    auto build_graph(klingon::RenderGraphBuilder& builder, uint32_t pass_count) -> void {
+        builder.clear();
+
+        klingon::ExternalResource backbuffer{};
+        backbuffer.handle = 0;
+        backbuffer.type = batleth::ResourceType::Image;
+        backbuffer.format = VK_FORMAT_B8G8R8A8_SRGB;
+        backbuffer.extent = {1920, 1080};
+        backbuffer.final_state = {
+            .stage_mask = VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT,
+            .access_mask = VK_ACCESS_2_NONE,
+            .layout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+            .queue_family = VK_QUEUE_FAMILY_IGNORED
+        };
+        const auto backbuffer_handle = builder.import_external("backbuffer", backbuffer);
+
+        const auto depth = builder.create_image("depth", batleth::ImageResourceDesc::create_2d(
+            VK_FORMAT_D32_SFLOAT, 1920, 1080,
+            VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT));
+
+        struct Output {
+            batleth::ResourceHandle handle;
+            batleth::ResourceUsage read_usage;
+        };
+        std::vector<Output> outputs;
+        outputs.reserve(pass_count);
+
+        auto read_inputs = [&]() {
+            if (!outputs.empty()) {
+                builder.read(outputs.back().handle, outputs.back().read_usage);
+            }
+            if (outputs.size() > 8) {
+                const auto& earlier = outputs[outputs.size() - 8];
+                builder.read(earlier.handle, earlier.read_usage);
+            }
+        };
+
+        for (uint32_t i = 0; i + 1 < pass_count; ++i) {
+            const auto name = std::format("pass_{}", i);
+
+            if (i % 4 == 3) {
+                const auto buffer = builder.create_buffer(std::format("buffer_{}", i), batleth::BufferResourceDesc{
+                    .size = 64 * 1024,
+                    .usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+                });
+                builder.add_compute_pass(name, [](const batleth::PassExecutionContext&) {})
+                       .write(buffer, batleth::ResourceUsage::StorageBufferWrite);
+                read_inputs();
+                outputs.push_back({buffer, batleth::ResourceUsage::StorageBufferRead});
+                continue;
+            }
+
+            const auto target = builder.create_image(std::format("target_{}", i),
+                batleth::ImageResourceDesc::create_2d(VK_FORMAT_R16G16B16A16_SFLOAT, 1920, 1080,
+                    VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT));
+
+            builder.add_graphics_pass(name, [](const batleth::PassExecutionContext&) {})
+                   .set_color_attachment(0, target)
+                   .write(target, batleth::ResourceUsage::ColorAttachment);
+            if (i == 0) {
+                builder.set_depth_attachment(depth)
+                       .write(depth, batleth::ResourceUsage::DepthStencilWrite);
+            } else {
+                builder.read(depth, batleth::ResourceUsage::SampledImage);
+            }
+            read_inputs();
+
+            // Every 16th target is a dead end that nothing downstream reads
+            if (i % 16 != 15) {
+                outputs.push_back({target, batleth::ResourceUsage::SampledImage});
+            }
+        }
+
+        builder.add_graphics_pass("present", [](const batleth::PassExecutionContext&) {})
+               .set_color_attachment(0, backbuffer_handle, VK_ATTACHMENT_LOAD_OP_DONT_CARE)
+               .write(backbuffer_handle, batleth::ResourceUsage::ColorAttachment);
+        read_inputs();
+    }
+
+    auto run(uint32_t pass_count, uint32_t iterations) -> BenchResult {
+        BenchResult result{};
+        std::vector<double> analysis_ms;
+        std::vector<double> total_ms;
+        analysis_ms.reserve(iterations);
+        total_ms.reserve(iterations);
+
+        klingon::RenderGraphBuilder builder;
+        for (uint32_t i = 0; i < iterations; ++i) {
+            build_graph(builder, pass_count);
+
+            const auto start = std::chrono::steady_clock::now();
+            const auto graph = klingon::CompiledRenderGraph::analyze(builder);
+            total_ms.push_back(std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start).count());
+            analysis_ms.push_back(graph->get_compile_time_ms());
+
+            result.passes = graph->get_pass_count();
+            result.culled = graph->get_culled_passes().size();
+            result.barriers = graph->get_barrier_stats().emitted;
+            result.eliminated = graph->get_barrier_stats().eliminated;
+        }
+
+        // Median, so the first iteration's cold caches and allocator growth don't skew it
+        auto median = [](std::vector<double>& values) {
+            std::ranges::nth_element(values, values.begin() + static_cast<std::ptrdiff_t>(values.size() / 2));
+            return values[values.size() / 2];
+        };
+        result.analysis_ms = median(analysis_ms);
+        result.total_ms = median(total_ms);
+        return result;
+    }
+}
+
+auto main(int argc, char* argv[]) -> int {
+    BenchConfig config{};
+    bool custom_sizes = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        auto next_uint = [&]() -> std::optional<uint32_t> {
+            return i + 1 < argc ? parse_uint(argv[++i]) : std::nullopt;
+        };
+
+        std::optional<uint32_t> value;
+        if (arg == "--passes" && (value = next_uint()) && *value > 0) {
+            if (!custom_sizes) {
+                config.pass_counts.clear();
+                custom_sizes = true;
+            }
+            config.pass_counts.push_back(*value);
+        } else if (arg == "--iterations" && (value = next_uint()) && *value > 0) {
+            config.iterations = *value;
+        } else {
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Per-resource debug logging would dominate the timings
+    federation::Logger::set_level(federation::LogLevel::Warn);
+
+    try {
+        std::cout << std::format("Render graph compile, median of {} runs (no device, no allocation)\n",
+                                 config.iterations);
+        for (const uint32_t pass_count : config.pass_counts) {
+            const auto result = run(pass_count, config.iterations);
+            std::cout << std::format("  {:>5} passes: {:>8.3f} ms analysis, {:>8.3f} ms total, "
+                                     "{} kept, {} culled, {} barriers ({} eliminated)\n",
+                                     pass_count, result.analysis_ms, result.total_ms, result.passes,
+                                     result.culled, result.barriers, result.eliminated);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "graph-bench: " << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,261 @@
+#include "federation/storage/async_file_reader.hpp"
+#include "federation/storage/virtual_file_system.hpp"
+
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef __linux__
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+    volatile uint64_t g_checksum_sink = 0;  // Keeps the page-touching loop from being optimized out
+
+    struct BenchConfig {
+        std::filesystem::path directory = std::filesystem::temp_directory_path() / "io-bench";
+        uint32_t small_count = 2000;
+        uint32_t small_size = 16 * 1024;
+        uint32_t large_count = 16;
+        uint32_t large_size = 32 * 1024 * 1024;
+        uint32_t queue_depth = 64;
+        uint32_t workers = 0;
+        bool drop_cache = true;
+        bool keep = false;
+    };
+
+    struct BenchResult {
+        double seconds = 0.0;
+        uint64_t bytes = 0;
+        uint32_t files = 0;
+        uint32_t failures = 0;
+    };
+
+    auto print_usage(std::string_view program) -> void {
+        std::cerr << "Usage: " << program << " [options]\n"
+                  << "  --dir <dir>          Where the test files are generated (default: <tmp>/io-bench)\n"
+                  << "  --small <n>          Number of small files (default: 2000)\n"
+                  << "  --small-size <kib>   Small file size (default: 16)\n"
+                  << "  --large <n>          Number of large files (default: 16)\n"
+                  << "  --large-size <mib>   Large file size (default: 32)\n"
+                  << "  --depth <n>          Async queue depth (default: 64)\n"
+                  << "  --workers <n>        Async worker threads (default: from core count)\n"
+                  << "  --warm               Keep files in the page cache between runs\n"
+                  << "  --keep               Don't delete the generated files\n";
+    }
+
+    auto parse_uint(std::string_view text) -> std::optional<uint32_t> {
+        uint32_t value = 0;
+        auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+        if (ec != std::errc{} || ptr != text.data() + text.size()) {
+            return std::nullopt;
+        }
+        return value;
+    }
+
+    auto generate(const std::filesystem::path& directory, std::string_view prefix, uint32_t count, uint32_t size)
+        -> std::vector<std::string> {
+        std::vector<std::string> paths;
+        paths.reserve(count);
+
+        // Random bytes so nothing below us can cheat with zero pages or compression
+        std::mt19937_64 rng(size);
+        std::vector<uint64_t> block((size + 7) / 8);
+        for (auto& word : block) {
+            word = rng();
+        }
+
+        for (uint32_t i = 0; i < count; ++i) {
+            auto path = directory / std::format("{}_{:05}.bin", prefix, i);
+            if (!std::filesystem::exists(path) || std::filesystem::file_size(path) != size) {
+                block[0] = i;
+                std::ofstream file(path, std::ios::binary);
+                file.write(reinterpret_cast<const char*>(block.data()), size);
+            }
+            paths.push_back(path.generic_string());
+        }
+        return paths;
+    }
+
+    /**
+     * Best effort: ask the kernel to forget the files so each run reads from the device
+     */
+    auto drop_page_cache(const std::vector<std::string>& paths) -> void {
+#ifdef __linux__
+        for (const auto& path : paths) {
+            const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd >= 0) {
+                ::fdatasync(fd);
+                ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+                ::close(fd);
+            }
+        }
+#endif
+    }
+
+    auto run_blocking(const std::vector<std::string>& paths) -> BenchResult {
+        auto& vfs = federation::VirtualFileSystem::get();
+        BenchResult result{};
+        const auto start = std::chrono::steady_clock::now();
+        for (const auto& path : paths) {
+            if (auto file = vfs.read(path)) {
+                // Mapped reads are lazy; touch every page so the I/O actually happens
+                uint64_t checksum = 0;
+                const auto data = file->get_data();
+                for (size_t offset = 0; offset < data.size(); offset += 4096) {
+                    checksum += static_cast<uint8_t>(data[offset]);
+                }
+                g_checksum_sink = g_checksum_sink + checksum;
+                result.bytes += data.size();
+                ++result.files;
+            } else {
+                ++result.failures;
+            }
+        }
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+    auto run_async(const std::vector<std::string>& paths, const federation::AsyncFileReader::Config& config,
+                   std::string& backend) -> BenchResult {
+        federation::AsyncFileReader reader(config);
+        backend = reader.get_backend_name();
+
+        std::atomic<uint64_t> bytes{0};
+        std::atomic<uint32_t> files{0};
+        std::atomic<uint32_t> failures{0};
+
+        const auto start = std::chrono::steady_clock::now();
+        for (const auto& path : paths) {
+            reader.read(path, [&](std::expected<federation::FileData, std::string> file) {
+                if (file) {
+                    bytes.fetch_add(file->get_size(), std::memory_order_relaxed);
+                    files.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    failures.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+        reader.wait_idle();
+
+        BenchResult result{};
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        result.bytes = bytes.load();
+        result.files = files.load();
+        result.failures = failures.load();
+        return result;
+    }
+
+    auto report(std::string_view set, std::string_view method, const BenchResult& result) -> void {
+        const double mib = static_cast<double>(result.bytes) / (1024.0 * 1024.0);
+        std::cout << std::format("  {:<6} {:<22} {:>8.1f} ms {:>10.1f} MiB/s {:>10.0f} files/s",
+                                 set, method, result.seconds * 1000.0, mib / result.seconds,
+                                 result.files / result.seconds);
+        if (result.failures > 0) {
+            std::cout << std::format("  ({} failed)", result.failures);
+        }
+        std::cout << '\n';
+    }
+
+    auto run_set(std::string_view set, const std::vector<std::string>& paths, const BenchConfig& config) -> void {
+        auto prepare = [&] {
+            if (config.drop_cache) {
+                drop_page_cache(paths);
+            }
+        };
+
+        prepare();
+        report(set, "blocking (mapped)", run_blocking(paths));
+
+        federation::AsyncFileReader::Config async_config{};
+        async_config.queue_depth = config.queue_depth;
+        async_config.worker_threads = config.workers;
+
+        std::string backend;
+        async_config.use_io_uring = false;
+        prepare();
+        auto result = run_async(paths, async_config, backend);
+        report(set, std::format("async ({})", backend), result);
+
+        async_config.use_io_uring = true;
+        prepare();
+        result = run_async(paths, async_config, backend);
+        if (backend != "thread pool") {
+            report(set, std::format("async ({})", backend), result);
+        } else {
+            std::cout << std::format("  {:<6} io_uring unavailable on this system\n", set);
+        }
+    }
+}
+
+auto main(int argc, char* argv[]) -> int {
+    BenchConfig config{};
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        auto next_uint = [&]() -> std::optional<uint32_t> {
+            return i + 1 < argc ? parse_uint(argv[++i]) : std::nullopt;
+        };
+
+        std::optional<uint32_t> value;
+        if (arg == "--dir" && i + 1 < argc) {
+            config.directory = argv[++i];
+            continue;
+        } else if (arg == "--warm") {
+            config.drop_cache = false;
+            continue;
+        } else if (arg == "--keep") {
+            config.keep = true;
+            continue;
+        } else if (arg == "--small" && (value = next_uint())) {
+            config.small_count = *value;
+        } else if (arg == "--small-size" && (value = next_uint())) {
+            config.small_size = *value * 1024;
+        } else if (arg == "--large" && (value = next_uint())) {
+            config.large_count = *value;
+        } else if (arg == "--large-size" && (value = next_uint())) {
+            config.large_size = *value * 1024 * 1024;
+        } else if (arg == "--depth" && (value = next_uint()) && *value > 0) {
+            config.queue_depth = *value;
+        } else if (arg == "--workers" && (value = next_uint())) {
+            config.workers = *value;
+        } else {
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    try {
+        std::filesystem::create_directories(config.directory);
+        std::cout << std::format("Generating test files in {}\n", config.directory.string());
+        const auto small = generate(config.directory, "small", config.small_count, config.small_size);
+        const auto large = generate(config.directory, "large", config.large_count, config.large_size);
+
+        std::cout << std::format("small: {} x {} KiB, large: {} x {} MiB, queue depth {}, {} cache\n",
+                                 config.small_count, config.small_size / 1024,
+                                 config.large_count, config.large_size / (1024 * 1024),
+                                 config.queue_depth, config.drop_cache ? "cold" : "warm");
+        run_set("small", small, config);
+        run_set("large", large, config);
+
+        if (!config.keep) {
+            std::filesystem::remove_all(config.directory);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "io-bench: " << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -25,10 +25,7 @@ layout(set = 0, binding = 0) uniform GlobalUbo {
 } ubo;
 
 // Set 2: Bindless textures and materials
-layout(set = 2, binding = 0) uniform sampler2D albedoTextures[];
-layout(set = 2, binding = 1) uniform sampler2D normalTextures[];
-layout(set = 2, binding = 2) uniform sampler2D pbrTextures[];
-layout(set = 2, binding = 3) uniform sampler2D opacityTextures[];
+layout(set = 2, binding = 0) uniform sampler2D textures[];  // Every texture type shares one bindless array
 
 // Material buffer (std430 packing)
 struct MaterialData {
@@ -44,7 +41,7 @@ struct MaterialData {
     uint _padding[3];  // Pad to 64 bytes for array alignment
 };
 
-layout(set = 2, binding = 4) readonly buffer MaterialBuffer {
+layout(set = 2, binding = 1) readonly buffer MaterialBuffer {
     MaterialData materials[];
 } materialBuffer;
 
@@ -62,8 +59,10 @@ vec3 getNormalFromMap() {
         return normalize(fragNormalWorldSpace);
     }
 
-    // Sample normal map
-    vec3 tangentNormal = texture(normalTextures[nonuniformEXT(mat.normalTextureIndex)], fragUV).xyz * 2.0 - 1.0;
+    // Sample normal map; Z is rebuilt from XY so two-channel (BC5) normal maps work too
+    vec3 tangentNormal;
+    tangentNormal.xy = texture(textures[nonuniformEXT(mat.normalTextureIndex)], fragUV).xy * 2.0 - 1.0;
+    tangentNormal.z = sqrt(max(1.0 - dot(tangentNormal.xy, tangentNormal.xy), 0.0));
     tangentNormal.xy *= mat.normalScale;
 
     // Derive TBN matrix from derivatives (no tangent attribute needed)
@@ -86,14 +85,14 @@ void main() {
     // Sample albedo with alpha
     vec4 albedoSample = vec4(1.0);
     if ((mat.materialFlags & 1u) != 0u) {
-        albedoSample = texture(albedoTextures[nonuniformEXT(mat.albedoTextureIndex)], fragUV);
+        albedoSample = texture(textures[nonuniformEXT(mat.albedoTextureIndex)], fragUV);
     }
     vec3 albedo = inColour * mat.baseColorFactor.rgb * albedoSample.rgb;
     float alpha = mat.baseColorFactor.a * albedoSample.a;
 
     // Sample opacity texture if present (multiplies with existing alpha)
     if ((mat.materialFlags & 8u) != 0u) {  // bit 3 = has_opacity
-        float opacitySample = texture(opacityTextures[nonuniformEXT(mat.opacityTextureIndex)], fragUV).r;
+        float opacitySample = texture(textures[nonuniformEXT(mat.opacityTextureIndex)], fragUV).r;
         alpha *= opacitySample;  // Use opacity directly: white=opaque, black=transparent
     }
 
@@ -107,7 +106,7 @@ void main() {
     float metallic = mat.metallicFactor;
     float roughness = mat.roughnessFactor;
     if ((mat.materialFlags & 4u) != 0u) {
-        vec2 pbr = texture(pbrTextures[nonuniformEXT(mat.pbrTextureIndex)], fragUV).rg;
+        vec2 pbr = texture(textures[nonuniformEXT(mat.pbrTextureIndex)], fragUV).rg;
         metallic *= pbr.r;
         roughness *= pbr.g;
     }
@@ -152,6 +152,33 @@ FetchContent_Declare(
     GIT_SHALLOW TRUE
 )
 
+# Basis Universal - KTX2 transcoder (only the transcoder is built, see basisu_transcoder below)
+FetchContent_Declare(
+    basisu
+    GIT_REPOSITORY https://github.com/BinomialLLC/basis_universal.git
+    GIT_TAG v1_50_0_2
+    GIT_SHALLOW TRUE
+    SOURCE_SUBDIR do-not-add-encoder
+)
+
+# bc7enc_rdo - BC1/4/5/7 block encoders for the offline texture cooker (see bc7enc below)
+FetchContent_Declare(
+    bc7enc
+    GIT_REPOSITORY https://github.com/richgel999/bc7enc_rdo.git
+    GIT_TAG master
+    GIT_SHALLOW TRUE
+    SOURCE_SUBDIR do-not-add-cli
+)
+
+# LZ4 - block compression for pack files (see lz4 below)
+FetchContent_Declare(
+    lz4
+    GIT_REPOSITORY https://github.com/lz4/lz4.git
+    GIT_TAG v1.10.0
+    GIT_SHALLOW TRUE
+    SOURCE_SUBDIR do-not-add-cli
+)
+
 # PhysicFS
 FetchContent_Declare(
     physicfs
@@ -161,7 +188,7 @@ FetchContent_Declare(
 )
 
 # Make dependencies available
-FetchContent_MakeAvailable(glfw glm vma imgui imguizmo tinyobjloader assimp ser20 stb physicfs)
+FetchContent_MakeAvailable(glfw glm vma imgui imguizmo tinyobjloader assimp ser20 stb basisu bc7enc lz4 physicfs)
 
 # Disable warnings for third-party libraries
 if(TARGET glfw)
@@ -182,6 +209,63 @@ target_include_directories(stb INTERFACE
 )
 
 
+# Basis Universal transcoder + single-file zstd decoder (KTX2 supercompression)
+enable_language(C)
+
+add_library(basisu_transcoder STATIC
+    ${basisu_SOURCE_DIR}/transcoder/basisu_transcoder.cpp
+    ${basisu_SOURCE_DIR}/zstd/zstddeclib.c
+)
+
+target_include_directories(basisu_transcoder PUBLIC
+    ${basisu_SOURCE_DIR}/transcoder
+    ${basisu_SOURCE_DIR}/zstd
+)
+
+target_compile_definitions(basisu_transcoder PUBLIC
+    BASISD_SUPPORT_KTX2=1
+    BASISD_SUPPORT_KTX2_ZSTD=1
+)
+
+if(MSVC)
+    target_compile_options(basisu_transcoder PRIVATE /W0)
+else()
+    target_compile_options(basisu_transcoder PRIVATE -w)
+endif()
+
+# bc7enc_rdo encoders/decoder, without its command-line tool
+add_library(bc7enc STATIC
+    ${bc7enc_SOURCE_DIR}/bc7enc.cpp
+    ${bc7enc_SOURCE_DIR}/bc7decomp.cpp
+    ${bc7enc_SOURCE_DIR}/rgbcx.cpp
+)
+
+target_include_directories(bc7enc PUBLIC
+    ${bc7enc_SOURCE_DIR}
+)
+
+if(MSVC)
+    target_compile_options(bc7enc PRIVATE /W0)
+else()
+    target_compile_options(bc7enc PRIVATE -w)
+endif()
+
+# LZ4 block and HC compressors, without the command-line tool
+add_library(lz4 STATIC
+    ${lz4_SOURCE_DIR}/lib/lz4.c
+    ${lz4_SOURCE_DIR}/lib/lz4hc.c
+)
+
+target_include_directories(lz4 PUBLIC
+    ${lz4_SOURCE_DIR}/lib
+)
+
+if(MSVC)
+    target_compile_options(lz4 PRIVATE /W0)
+else()
+    target_compile_options(lz4 PRIVATE -w)
+endif()
+
 # ImGui needs special handling as it doesn't have CMakeLists.txt
 # Create ImGui library target as SHARED (DLL) to avoid context issues across modules
 add_library(imgui SHARED
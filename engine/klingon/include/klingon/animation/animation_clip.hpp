@@ -0,0 +1,138 @@
+#pragma once
+
+#include "pose.hpp"
+#include "skeleton.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef _WIN32
+#ifdef KLINGON_EXPORTS
+#define KLINGON_API __declspec(dllexport)
+#else
+#define KLINGON_API __declspec(dllimport)
+#endif
+#else
+#define KLINGON_API
+#endif
+
+namespace klingon {
+    /**
+     * One joint's curves as imported; key times in seconds
+     * An empty curve leaves that component at the skeleton's rest pose.
+     */
+    struct RawJointTrack {
+        std::vector<float> translation_times;
+        std::vector<glm::vec3> translations;
+        std::vector<float> rotation_times;
+        std::vector<glm::quat> rotations;
+        std::vector<float> scale_times;
+        std::vector<glm::vec3> scales;
+    };
+
+    struct RawAnimationClip {
+        std::string name;
+        float duration = 0.0f;                  // Seconds
+        std::vector<RawJointTrack> tracks;      // One per skeleton joint
+    };
+
+    struct ClipCompression {
+        float sample_rate = 30.0f;              // Curves are resampled to this many frames per second
+        float rotation_tolerance = 0.001f;      // Radians a dropped key may put a joint off by
+        float translation_tolerance = 0.0005f;  // Model units
+        float scale_tolerance = 0.0005f;
+    };
+
+    /**
+     * Channel order within a joint; channel j * CHANNELS_PER_JOINT + kind drives joint j
+     */
+    enum class ChannelKind : uint32_t {
+        Translation = 0,
+        Rotation = 1,
+        Scale = 2
+    };
+    constexpr uint32_t CHANNELS_PER_JOINT = 3;
+
+    struct ClipChannel {
+        uint32_t first_key = 0;                 // Into the clip's key frames and values
+        uint32_t key_count = 0;                 // 1 = constant for the whole clip
+        float range_min[3] = {0.0f, 0.0f, 0.0f};    // Translation and scale dequantization; unused for rotations
+        float range_extent[3] = {0.0f, 0.0f, 0.0f};
+    };
+    static_assert(sizeof(ClipChannel) == 32);
+
+    /**
+     * A quantized key, 16 bits per component
+     * Rotations use smallest-three: the largest quaternion component is dropped (made positive
+     * and rebuilt from unit length), the other three are stored in 15 bits each and the index
+     * of the dropped one goes in the top bits of the first two words. Translations and scales
+     * are normalized to their channel's range.
+     */
+    struct PackedKey {
+        uint16_t v[3] = {0, 0, 0};
+    };
+    static_assert(sizeof(PackedKey) == 6);
+
+    /**
+     * Compressed skeletal animation
+     *
+     * Curves are resampled at a fixed rate, then every key that interpolating its neighbours
+     * reproduces within tolerance is dropped, so still joints cost one key and smooth motion
+     * a handful. Keys are 6 bytes plus a 2-byte frame number.
+     */
+    class KLINGON_API AnimationClip {
+    public:
+        AnimationClip() = default;
+
+        /**
+         * Rebuild from stored tables; `channels` holds CHANNELS_PER_JOINT entries per joint
+         * with key ranges inside the key tables (checked by the caller)
+         */
+        AnimationClip(std::string name, float duration, float sample_rate, std::vector<ClipChannel> channels,
+                      std::vector<uint16_t> key_frames, std::vector<PackedKey> key_values);
+
+        static auto compress(const RawAnimationClip& raw, const Skeleton& skeleton,
+                             const ClipCompression& settings = {}) -> AnimationClip;
+
+        /**
+         * Evaluate every joint at `time` (clamped to the clip) into `pose`
+         * The pose must already have this clip's joint count.
+         */
+        auto sample(float time, Pose& pose) const -> void;
+
+        [[nodiscard]] auto get_name() const -> const std::string& { return m_name; }
+        [[nodiscard]] auto get_duration() const -> float { return m_duration; }
+        [[nodiscard]] auto get_sample_rate() const -> float { return m_sample_rate; }
+        [[nodiscard]] auto get_joint_count() const -> uint32_t {
+            return static_cast<uint32_t>(m_channels.size() / CHANNELS_PER_JOINT);
+        }
+        [[nodiscard]] auto get_channels() const -> std::span<const ClipChannel> { return m_channels; }
+        [[nodiscard]] auto get_key_frames() const -> std::span<const uint16_t> { return m_key_frames; }
+        [[nodiscard]] auto get_key_values() const -> std::span<const PackedKey> { return m_key_values; }
+        [[nodiscard]] auto get_size_bytes() const -> size_t;
+
+    private:
+        std::string m_name;
+        float m_duration = 0.0f;
+        float m_sample_rate = 30.0f;
+        uint32_t m_last_frame = 0;
+        std::vector<ClipChannel> m_channels;
+        std::vector<uint16_t> m_key_frames;
+        std::vector<PackedKey> m_key_values;
+    };
+
+    /**
+     * A model's skeleton and the clips authored for it, shared by every instance of the model
+     */
+    struct KLINGON_API AnimationSet {
+        Skeleton skeleton;
+        std::vector<AnimationClip> clips;
+
+        [[nodiscard]] auto find_clip(std::string_view name) const -> std::optional<uint32_t>;
+    };
+} // namespace klingon
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "klingon/game_object.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#ifdef KLINGON_EXPORTS
+#define KLINGON_API __declspec(dllexport)
+#else
+#define KLINGON_API __declspec(dllimport)
+#endif
+#else
+#define KLINGON_API
+#endif
+
+namespace klingon {
+    class Animator;
+
+    /**
+     * Updates every animated object in a scene once per frame
+     *
+     * Animators are independent, so they are spread over a persistent pool of worker threads
+     * (started once, parked between frames) that pull characters off a shared counter; the
+     * calling thread works too and returns when the last palette is built.
+     */
+    class KLINGON_API AnimationSystem {
+    public:
+        struct Config {
+            uint32_t threads = 0;               // Including the caller; 0 = all cores
+            uint32_t min_batch = 8;             // Fewer animators than this update on the caller alone
+        };
+
+        AnimationSystem();
+        explicit AnimationSystem(const Config& config);
+        ~AnimationSystem();
+
+        AnimationSystem(const AnimationSystem&) = delete;
+        auto operator=(const AnimationSystem&) -> AnimationSystem& = delete;
+
+        auto update(GameObject::Map& game_objects, float delta_time) -> void;
+
+        [[nodiscard]] auto get_animated_count() const -> uint32_t { return static_cast<uint32_t>(m_batch.size()); }
+
+    private:
+        auto worker_loop(std::stop_token stop) -> void;
+        auto run_batch() -> void;
+
+        Config m_config;
+        std::vector<Animator*> m_batch;
+        float m_delta_time = 0.0f;
+        std::atomic<uint32_t> m_next{0};
+
+        std::mutex m_mutex;
+        std::condition_variable_any m_wake;
+        std::condition_variable m_finished;
+        uint64_t m_generation = 0;
+        uint32_t m_busy = 0;
+        std::vector<std::jthread> m_workers;    // Last, so they stop before the state they use goes away
+    };
+} // namespace klingon
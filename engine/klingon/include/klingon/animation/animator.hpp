@@ -0,0 +1,67 @@
+#pragma once
+
+#include "animation_clip.hpp"
+#include "pose.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#ifdef _WIN32
+#ifdef KLINGON_EXPORTS
+#define KLINGON_API __declspec(dllexport)
+#else
+#define KLINGON_API __declspec(dllimport)
+#endif
+#else
+#define KLINGON_API
+#endif
+
+namespace klingon {
+    struct AnimationLayer {
+        uint32_t clip = 0;          // Into AnimationSet::clips
+        float time = 0.0f;          // Seconds into the clip
+        float speed = 1.0f;
+        float weight = 1.0f;        // Blend over the layers below; the first layer always applies fully
+        bool loop = true;
+    };
+
+    /**
+     * Per-instance animation state: a stack of clip layers and the skinning palette they produce
+     * Runtime only; the clips themselves are shared through the model's AnimationSet.
+     */
+    class KLINGON_API Animator {
+    public:
+        explicit Animator(std::shared_ptr<const AnimationSet> animation);
+
+        /**
+         * Add a layer on top of the stack
+         * @return Index of the new layer in get_layers()
+         */
+        auto play(uint32_t clip, float weight = 1.0f, bool loop = true) -> uint32_t;
+
+        auto clear_layers() -> void { m_layers.clear(); }
+
+        /**
+         * Advance every layer, sample and blend them, and rebuild the palette
+         * Touches only this animator and the shared (read-only) clips, so animators can
+         * update on different threads.
+         */
+        auto update(float delta_time) -> void;
+
+        [[nodiscard]] auto get_layers() -> std::vector<AnimationLayer>& { return m_layers; }
+        [[nodiscard]] auto get_animation() const -> const std::shared_ptr<const AnimationSet>& { return m_animation; }
+        [[nodiscard]] auto get_pose() const -> const Pose& { return m_pose; }
+        [[nodiscard]] auto get_model_transforms() const -> std::span<const SkinMatrix> { return m_model; }
+        [[nodiscard]] auto get_palette() const -> std::span<const SkinMatrix> { return m_palette; }
+
+    private:
+        std::shared_ptr<const AnimationSet> m_animation;
+        std::vector<AnimationLayer> m_layers;
+        Pose m_pose;
+        Pose m_layer_pose;
+        std::vector<SkinMatrix> m_model;
+        std::vector<SkinMatrix> m_palette;
+    };
+} // namespace klingon
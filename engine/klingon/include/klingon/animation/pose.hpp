@@ -0,0 +1,80 @@
+#pragma once
+
+#include "skeleton.hpp"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#ifdef _WIN32
+#ifdef KLINGON_EXPORTS
+#define KLINGON_API __declspec(dllexport)
+#else
+#define KLINGON_API __declspec(dllimport)
+#endif
+#else
+#define KLINGON_API
+#endif
+
+namespace klingon {
+    /**
+     * Local joint transforms of a skeleton, stored structure-of-arrays
+     *
+     * Each component (translation x, rotation w, ...) is its own contiguous stream padded to a
+     * multiple of four joints, so sampling and blending process four joints per SIMD
+     * instruction with no shuffles. Padding joints hold the identity transform.
+     */
+    class KLINGON_API Pose {
+    public:
+        enum Stream : uint32_t {
+            TRANSLATION_X, TRANSLATION_Y, TRANSLATION_Z,
+            ROTATION_X, ROTATION_Y, ROTATION_Z, ROTATION_W,
+            SCALE_X, SCALE_Y, SCALE_Z,
+            STREAM_COUNT
+        };
+
+        Pose() = default;
+        explicit Pose(uint32_t joint_count);
+
+        /**
+         * Resize, resetting every joint to identity
+         */
+        auto resize(uint32_t joint_count) -> void;
+
+        auto set_rest_pose(const Skeleton& skeleton) -> void;
+
+        [[nodiscard]] auto get_joint_count() const -> uint32_t { return m_joint_count; }
+        [[nodiscard]] auto get_padded_count() const -> uint32_t { return m_padded_count; }
+
+        [[nodiscard]] auto get_stream(Stream stream) -> float* { return m_data.data() + stream * m_padded_count; }
+        [[nodiscard]] auto get_stream(Stream stream) const -> const float* {
+            return m_data.data() + stream * m_padded_count;
+        }
+
+        [[nodiscard]] auto get_joint(uint32_t joint) const -> JointTransform;
+        auto set_joint(uint32_t joint, const JointTransform& transform) -> void;
+
+    private:
+        uint32_t m_joint_count = 0;
+        uint32_t m_padded_count = 0;
+        std::vector<float> m_data;      // STREAM_COUNT streams of m_padded_count floats
+    };
+
+    /**
+     * out = a blended towards b by weight; rotations are normalized-lerped along the shorter arc
+     * out may alias a or b. All three poses must have the same joint count.
+     */
+    KLINGON_API auto blend_poses(const Pose& a, const Pose& b, float weight, Pose& out) -> void;
+
+    /**
+     * Model-space transform of every joint: one pass down the parents-first hierarchy
+     */
+    KLINGON_API auto compute_model_transforms(const Skeleton& skeleton, const Pose& pose,
+                                              std::span<SkinMatrix> model) -> void;
+
+    /**
+     * Skinning palette: each joint's model transform times its inverse bind matrix
+     */
+    KLINGON_API auto compute_skin_palette(const Skeleton& skeleton, std::span<const SkinMatrix> model,
+                                          std::span<SkinMatrix> palette) -> void;
+} // namespace klingon
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#ifdef _WIN32
+#ifdef KLINGON_EXPORTS
+#define KLINGON_API __declspec(dllexport)
+#else
+#define KLINGON_API __declspec(dllimport)
+#endif
+#else
+#define KLINGON_API
+#endif
+
+namespace klingon {
+    constexpr uint16_t NO_PARENT_JOINT = UINT16_MAX;
+    constexpr uint32_t MAX_JOINTS = UINT16_MAX;     // Joint indices are 16-bit everywhere
+
+    /**
+     * Parent-relative transform of one joint
+     */
+    struct JointTransform {
+        glm::vec3 translation{0.0f};
+        glm::quat rotation{1.0f, 0.0f, 0.0f, 0.0f};
+        glm::vec3 scale{1.0f};
+    };
+
+    /**
+     * Affine transform as three rows of a 4x4 matrix (the fourth row is always 0 0 0 1)
+     * The layout skinning palettes are uploaded in, 48 bytes per joint instead of 64.
+     */
+    struct SkinMatrix {
+        glm::vec4 rows[3] = {{1.0f, 0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f, 0.0f}};
+    };
+    static_assert(sizeof(SkinMatrix) == 48);
+
+    /**
+     * @return a * b, both affine
+     */
+    KLINGON_API auto multiply(const SkinMatrix& a, const SkinMatrix& b) -> SkinMatrix;
+    KLINGON_API auto to_mat4(const SkinMatrix& matrix) -> glm::mat4;
+    KLINGON_API auto to_skin_matrix(const glm::mat4& matrix) -> SkinMatrix;
+
+    /**
+     * Joint hierarchy that a model's skinned vertices are bound to
+     *
+     * Joints are ordered parents-first (a parent's index is always lower than its children's),
+     * so model-space transforms are a single forward pass with no recursion or sorting.
+     */
+    struct KLINGON_API Skeleton {
+        std::vector<std::string> joint_names;
+        std::vector<uint16_t> parents;              // NO_PARENT_JOINT for roots
+        std::vector<SkinMatrix> inverse_bind;       // Model space -> joint space in the bind pose
+        std::vector<JointTransform> rest_pose;      // Used for joints a clip does not animate
+
+        [[nodiscard]] auto get_joint_count() const -> uint32_t { return static_cast<uint32_t>(parents.size()); }
+        [[nodiscard]] auto find_joint(std::string_view name) const -> std::optional<uint16_t>;
+
+        /**
+         * Every array has one entry per joint and every parent precedes its child
+         */
+        [[nodiscard]] auto is_valid() const -> bool;
+    };
+} // namespace klingon
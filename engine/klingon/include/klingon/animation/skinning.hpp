@@ -0,0 +1,29 @@
+#pragma once
+
+#include "skeleton.hpp"
+#include "klingon/model/mesh.h"
+
+#include <span>
+
+#ifdef _WIN32
+#ifdef KLINGON_EXPORTS
+#define KLINGON_API __declspec(dllexport)
+#else
+#define KLINGON_API __declspec(dllimport)
+#endif
+#else
+#define KLINGON_API
+#endif
+
+namespace klingon {
+    /**
+     * Linear blend skinning on the CPU, four weighted palette rows per SIMD multiply-add
+     *
+     * Produces what skinning.comp writes: positions and normals transformed by the weighted
+     * sum of their joints' palette matrices, every other attribute copied. Meant for tests,
+     * tools and validating the GPU path rather than for per-frame use.
+     * @param output Same size as vertices
+     */
+    KLINGON_API auto skin_vertices(std::span<const Vertex> vertices, std::span<const VertexSkin> skins,
+                                   std::span<const SkinMatrix> palette, std::span<Vertex> output) -> void;
+} // namespace klingon
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include <ser20/ser20.hpp>
+#include <ser20/types/string.hpp>
+
+#include "federation/name_registry.hpp"
+
+#ifdef _WIN32
+#ifdef KLINGON_EXPORTS
+#define KLINGON_API __declspec(dllexport)
+#else
+#define KLINGON_API __declspec(dllimport)
+#endif
+#else
+#define KLINGON_API
+#endif
+
+namespace klingon {
+    /**
+     * Asset file path interned through federation::NameRegistry
+     *
+     * Thousands of objects sharing a model carry a 32-bit ID each instead of a string, and copies and
+     * comparisons are integer operations. IDs are only valid within one run: archives store the path.
+     */
+    class KLINGON_API AssetPath {
+    public:
+        using id_t = federation::NameId;
+
+        AssetPath() = default;
+
+        AssetPath(std::string_view path) : m_id(federation::NameRegistry::intern(path)) {}
+
+        AssetPath(const std::string& path) : AssetPath(std::string_view{path}) {}
+
+        AssetPath(const char* path) : AssetPath(std::string_view{path}) {}
+
+        /**
+         * @return The interned path (stays valid for the lifetime of the process)
+         */
+        [[nodiscard]] auto str() const -> std::string_view { return federation::NameRegistry::lookup(m_id); }
+
+        operator std::string() const { return std::string{str()}; }
+
+        [[nodiscard]] auto empty() const -> bool { return m_id == federation::INVALID_NAME_ID; }
+        [[nodiscard]] auto get_id() const -> id_t { return m_id; }
+
+        auto operator==(const AssetPath&) const -> bool = default;
+
+        template <class Archive>
+        void save(Archive& ar) const {
+            ar(std::string{str()});
+        }
+
+        template <class Archive>
+        void load(Archive& ar) {
+            std::string path;
+            ar(path);
+            *this = AssetPath{path};
+        }
+
+    private:
+        id_t m_id = federation::INVALID_NAME_ID;
+    };
+} // namespace klingon
+
+template <>
+struct std::hash<klingon::AssetPath> {
+    auto operator()(const klingon::AssetPath& path) const noexcept -> size_t {
+        return std::hash<klingon::AssetPath::id_t>{}(path.get_id());
+    }
+};
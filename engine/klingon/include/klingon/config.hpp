@@ -43,6 +43,20 @@ struct KLINGON_API KlingonConfig {
         }
     } application;
 
+    // ========== Asset Storage ==========
+    struct Assets {
+        std::vector<std::string> packs;     // .kpak files mounted at the root, later ones overriding earlier
+        bool native_fallback = true;        // Also read loose files relative to the working directory
+        std::string cook_manifest = "assets/cook_manifest.json";  // Written by `cooker build`; empty to ignore
+
+        template<class Archive>
+        void serialize(Archive& ar) {
+            ar(SER20_NVP(packs),
+               SER20_NVP(native_fallback),
+               SER20_NVP(cook_manifest));
+        }
+    } assets;
+
     // ========== Window Configuration ==========
     struct Window {
         uint32_t width = 1920;
@@ -170,11 +184,13 @@ struct KLINGON_API KlingonConfig {
 
         // Performance settings
         struct Performance {
-            uint32_t max_frames_in_flight = 2;
+            uint32_t max_frames_in_flight = 2;      // 1-4; fewer cuts latency, more absorbs CPU/GPU spikes
+            bool threaded_rendering = false;  // Record frame N on a render thread while frame N+1 updates
 
             template<class Archive>
             void serialize(Archive& ar) {
-                ar(SER20_NVP(max_frames_in_flight));
+                ar(SER20_NVP(max_frames_in_flight),
+                   SER20_NVP(threaded_rendering));
             }
         } performance;
 
@@ -190,22 +206,87 @@ struct KLINGON_API KlingonConfig {
             }
         } offscreen;
 
+        // Texture streaming settings
+        struct TextureStreaming {
+            bool enabled = true;
+            uint32_t budget_mb = 512;             // VRAM allowed for streamed textures
+            uint32_t tail_size = 64;              // Mips up to this size stay resident permanently
+            uint32_t upload_mb_per_frame = 16;    // Cap on streamed texel uploads per frame
+            uint32_t eviction_delay_frames = 60;  // Textures used this recently are never evicted
+
+            template<class Archive>
+            void serialize(Archive& ar) {
+                ar(SER20_NVP(enabled),
+                   SER20_NVP(budget_mb),
+                   SER20_NVP(tail_size),
+                   SER20_NVP(upload_mb_per_frame),
+                   SER20_NVP(eviction_delay_frames));
+            }
+        } texture_streaming;
+
+        // Input-to-photon latency settings (ignored with threaded_rendering: input is polled on the main thread)
+        struct Latency {
+            bool late_latch_camera = false;     // Re-poll input and rewrite the camera right before submit
+            bool limit_frame_latency = false;   // Wait for the previous frame's GPU work before polling input
+
+            template<class Archive>
+            void serialize(Archive& ar) {
+                ar(SER20_NVP(late_latch_camera),
+                   SER20_NVP(limit_frame_latency));
+            }
+        } latency;
+
         template<class Archive>
         void serialize(Archive& ar) {
             ar(SER20_NVP(forward_plus),
                SER20_NVP(debug),
                SER20_NVP(performance),
-               SER20_NVP(offscreen));
+               SER20_NVP(offscreen),
+               SER20_NVP(texture_streaming),
+               SER20_NVP(latency));
         }
     } renderer;
 
+    // ========== Animation Configuration ==========
+    struct Animation {
+        uint32_t threads = 0;                   // Animator update threads; 0 = one per hardware thread
+        bool gpu_skinning = true;               // Off: skinned meshes draw in their bind pose
+        uint32_t max_palette_joints = 65536;    // Joints across every animated object in one frame
+        uint32_t max_skinned_meshes = 1024;     // Skinned mesh instances in one frame
+        uint32_t max_skinned_vertices = 524288; // Vertices across every skinned instance in one frame
+
+        template<class Archive>
+        void serialize(Archive& ar) {
+            ar(SER20_NVP(threads),
+               SER20_NVP(gpu_skinning),
+               SER20_NVP(max_palette_joints),
+               SER20_NVP(max_skinned_meshes),
+               SER20_NVP(max_skinned_vertices));
+        }
+    } animation;
+
+    // ========== Input Configuration ==========
+    struct Input {
+        std::string record_path;                // Record the dispatched input stream to this file
+        std::string playback_path;              // Drive input from this recording instead of GLFW; exits when it ends
+
+        template<class Archive>
+        void serialize(Archive& ar) {
+            ar(SER20_NVP(record_path),
+               SER20_NVP(playback_path));
+        }
+    } input;
+
     // ========== Root Serialization ==========
     template<class Archive>
     void serialize(Archive& ar) {
         ar(SER20_NVP(application),
+           SER20_NVP(assets),
            SER20_NVP(window),
            SER20_NVP(vulkan),
-           SER20_NVP(renderer));
+           SER20_NVP(renderer),
+           SER20_NVP(animation),
+           SER20_NVP(input));
     }
 };
 
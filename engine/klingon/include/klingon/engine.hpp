@@ -1,11 +1,15 @@
 #pragma once
 
+#include <array>
 #include <memory>
 #include <functional>
 #include <filesystem>
 
 #include "renderer.hpp"
+#include "render_snapshot.hpp"
+#include "render_thread.hpp"
 #include "scene.hpp"
+#include "animation/animation_system.hpp"
 #include "borg/input.hpp"
 #include "borg/window.hpp"
 #include "federation/core.hpp"
@@ -31,6 +35,11 @@ namespace klingon {
  * - on_update: Called every frame for game logic (receives delta time)
  * - on_render: Called during rendering phase (optional, for custom rendering)
  * - on_imgui: Called during ImGui phase (if ImGui is enabled)
+ *
+ * With renderer.performance.threaded_rendering, frames are recorded on a render thread from a
+ * snapshot of the scene while the main thread runs the next frame's update. The ImGui callback
+ * still runs on the main thread, at the sync point where the render thread is idle; game logic
+ * that loads assets or creates GPU resources must hold Renderer::lock_rendering.
  */
     class KLINGON_API Engine {
     public:
@@ -133,6 +142,12 @@ namespace klingon {
         std::unique_ptr<borg::Window> m_window;
         std::unique_ptr<borg::Input> m_input;
         std::unique_ptr<Renderer> m_renderer;
+        std::unique_ptr<AnimationSystem> m_animation_system;
+
+        // Threaded rendering: the render thread records one snapshot while the other is filled
+        std::unique_ptr<RenderThread> m_render_thread;
+        std::array<RenderSnapshot, 2> m_snapshots;
+        uint32_t m_back_snapshot = 0;
 
         // Application callbacks
         UpdateCallback m_update_callback;
@@ -1,14 +1,13 @@
 #pragma once
 
 #include <vulkan/vulkan_core.h>
-#include <unordered_map>
 
 #define GLM_FORCE_RADIANS
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
 #include <glm/glm.hpp>
 
 #include "camera.hpp"
-#include "game_object.hpp"
+#include "render_snapshot.hpp"
 
 #ifdef _WIN32
 #ifdef KLINGON_EXPORTS
@@ -50,7 +49,7 @@ namespace klingon {
 
     /**
  * Frame information passed to render systems
- * Contains all data needed to render a frame
+ * Contains all data needed to render a frame; scene state comes from the snapshot, never the live scene
  */
     struct KLINGON_API FrameInfo {
         int frame_index;
@@ -59,6 +58,6 @@ namespace klingon {
         Camera &camera;
         VkDescriptorSet global_descriptor_set;
         VkDescriptorSet texture_descriptor_set;  // Bindless texture descriptor set (Set 2)
-        std::unordered_map<unsigned int, GameObject> &game_objects;
+        const RenderSnapshot &snapshot;          // Objects, lights and static geometry of this frame
     };
 } // namespace klingon
\ No newline at end of file
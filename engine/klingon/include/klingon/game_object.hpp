@@ -1,7 +1,9 @@
 #pragma once
 
+#include "klingon/asset_path.hpp"
 #include "klingon/transform.hpp"
 #include "klingon/model_data.hpp"
+#include "klingon/animation/animator.hpp"
 #include <memory>
 #include <unordered_map>
 #include <string>
@@ -47,6 +49,12 @@ namespace klingon {
      */
         static auto create_game_object() -> GameObject;
 
+        /**
+         * Reserve a contiguous block of IDs for bulk creation (see Scene::instantiate)
+         * @return The first ID of the block
+         */
+        static auto reserve_ids(uint32_t count) -> id_t;
+
         /**
      * Create a point light game object
      * @param intensity Light intensity
@@ -76,12 +84,18 @@ namespace klingon {
         // Model data - runtime only (NOT serialized, loaded from model_filepath)
         std::shared_ptr<ModelData> model_data{};
 
-        // Model file path - serialized for scene persistence
-        std::string model_filepath;
+        // Model file path - serialized for scene persistence (interned, so instances share one string)
+        AssetPath model_filepath;
+
+        // Skeletal animation state - runtime only, created when an animated model is assigned
+        std::unique_ptr<Animator> animator = nullptr;
 
         // TODO: Replace with ECS
         std::unique_ptr<PointLightComponent> point_light = nullptr;
 
+        // Never moves after load: merged into the scene's static geometry batches (see StaticGeometry)
+        bool is_static = false;
+
         template <class Archive>
         void serialize(Archive& ar) {
             ar(
@@ -89,11 +103,14 @@ namespace klingon {
                 color,
                 transform,
                 model_filepath,  // Serialize the path, not the model_data
-                point_light
+                point_light,
+                is_static
             );
         }
 
     private:
+        friend class Scene;  // Constructs objects from reserved IDs
+
         GameObject(id_t obj_id) : m_id(obj_id) {
         }
 
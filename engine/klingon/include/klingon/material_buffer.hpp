@@ -0,0 +1,118 @@
+#pragma once
+
+#include "batleth/buffer.hpp"
+#include "batleth/device.hpp"
+#include "material.hpp"
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#ifdef KLINGON_EXPORTS
+#define KLINGON_API __declspec(dllexport)
+#else
+#define KLINGON_API __declspec(dllimport)
+#endif
+#else
+#define KLINGON_API
+#endif
+
+namespace klingon {
+    /**
+     * Global material SSBO with deduplication and slot reuse
+     *
+     * Records live in a CPU-side array; acquiring, editing and releasing only touch that copy
+     * and mark the record dirty. Once per frame flush() packs the dirty records into that
+     * frame's slice of a persistently mapped staging ring and records one copy per contiguous
+     * dirty range into the device-local buffer, so nothing ever waits on the GPU.
+     *
+     * Identical MaterialGPU records (same bytes) share one slot and are reference counted;
+     * released slots go on a free list and are reused by later acquires.
+     */
+    class KLINGON_API MaterialBuffer {
+    public:
+        struct Config {
+            batleth::Device& device;
+            uint32_t max_materials = 1024;
+            uint32_t frames_in_flight = 2;
+        };
+
+        struct Stats {
+            uint32_t live_materials = 0;   // Distinct records in use
+            uint32_t capacity = 0;
+            uint32_t references = 0;       // Acquires minus releases (>= live_materials when deduplicated)
+            uint32_t dirty_materials = 0;  // Waiting for the next flush
+            uint64_t flushed_bytes = 0;    // Since startup
+        };
+
+        explicit MaterialBuffer(const Config& config);
+        ~MaterialBuffer() = default;
+
+        MaterialBuffer(const MaterialBuffer&) = delete;
+        auto operator=(const MaterialBuffer&) -> MaterialBuffer& = delete;
+
+        /**
+         * Reference a record with this content, reusing an identical one if it exists
+         * @return Material index, or nullopt if the buffer is full
+         */
+        auto acquire(const MaterialGPU& material) -> std::optional<uint32_t>;
+
+        /**
+         * Drop a reference; the slot is recycled when the last one goes
+         */
+        auto release(uint32_t index) -> void;
+
+        /**
+         * Change a record's content
+         * A record shared with other owners is split off first (copy-on-write), so the caller
+         * must keep the returned index. Repeated edits of an unshared record stay in place and
+         * just re-mark it dirty.
+         * @return Index now holding `material` (may differ from `index`)
+         */
+        auto update(uint32_t index, const MaterialGPU& material) -> uint32_t;
+
+        /**
+         * Record queued uploads for everything dirtied since the last flush
+         * @param cmd Command buffer recorded before any draw that reads materials
+         * @param frame_index Frame in flight (selects the staging slice; its fence must have signalled)
+         */
+        auto flush(VkCommandBuffer cmd, uint32_t frame_index) -> void;
+
+        [[nodiscard]] auto is_live(uint32_t index) const -> bool {
+            return index < m_records.size() && m_records[index].ref_count > 0;
+        }
+        [[nodiscard]] auto get(uint32_t index) const -> const MaterialGPU& { return m_materials[index]; }
+        [[nodiscard]] auto get_buffer() const -> VkBuffer { return m_gpu_buffer->get_buffer(); }
+        [[nodiscard]] auto get_stats() const -> Stats;
+
+    private:
+        struct Record {
+            uint64_t hash = 0;
+            uint32_t ref_count = 0;
+            bool indexed = false;   // Listed in m_lookup (first record with its content)
+        };
+
+        auto allocate() -> std::optional<uint32_t>;
+        auto unindex(uint32_t index) -> void;
+        auto mark_dirty(uint32_t index) -> void;
+
+        batleth::Device& m_device;
+        uint32_t m_max_materials;
+        uint32_t m_frames_in_flight;
+
+        std::unique_ptr<batleth::Buffer> m_gpu_buffer;      // Device-local SSBO
+        std::unique_ptr<batleth::Buffer> m_staging_ring;    // Persistently mapped, one max-size slice per frame
+
+        std::vector<MaterialGPU> m_materials;               // CPU copy, indexed like the SSBO
+        std::vector<Record> m_records;
+        std::vector<uint32_t> m_free_slots;
+        std::unordered_map<uint64_t, uint32_t> m_lookup;    // Content hash -> index
+        std::vector<uint32_t> m_dirty;
+        std::vector<bool> m_is_dirty;
+
+        uint32_t m_live_count = 0;
+        uint32_t m_reference_count = 0;
+        uint64_t m_flushed_bytes = 0;
+    };
+} // namespace klingon
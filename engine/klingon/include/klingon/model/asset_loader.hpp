@@ -1,10 +1,16 @@
 #pragma once
 #include "mesh.h"
+#include "kmesh.hpp"
+#include "vertex_welder.hpp"
 #include "klingon/model_data.hpp"
 #include "klingon/texture_manager.hpp"
 #include "batleth/device.hpp"
+#include <filesystem>
 #include <string>
 #include <memory>
+#include <optional>
+#include <span>
+#include <vector>
 
 #include "assimp/LogStream.hpp"
 #include "assimp/Importer.hpp"
@@ -12,6 +18,7 @@
 #include "assimp/postprocess.h"
 #include "assimp/scene.h"
 #include "federation/log.hpp"
+#include "federation/storage/virtual_file_system.hpp"
 
 #ifdef _WIN32
 #ifdef KLINGON_EXPORTS
@@ -29,7 +36,9 @@ namespace klingon {
         struct Config {
             batleth::Device& device;
             TextureManager& texture_manager;
+            ResourceRegistry& resources;  // Owns the meshes of loaded models
             std::string base_texture_path = "assets/textures/";
+            bool cook_models = true;  // Cache imports as <model>.kmesh and reuse them while the source is unchanged
         };
 
         explicit AssetLoader(const Config& config);
@@ -47,21 +56,81 @@ namespace klingon {
 
         /**
          * Load complete ModelData with materials, textures, and hierarchy
-         * Supports OBJ, FBX, glTF via Assimp
+         * Supports OBJ, FBX, glTF via Assimp, and cooked .kmesh files directly.
+         * With cook_models set, a source model is only imported through Assimp when its
+         * <model>.kmesh is missing or stale; otherwise the cooked file is mapped and its
+         * streams copied straight to staging memory.
          * @param filepath Path to model file
          * @return Complete ModelData with uploaded materials
          */
         auto load_model(const std::string& filepath) -> std::shared_ptr<ModelData>;
 
+        /**
+         * Load several models, reading every cooked file concurrently through the VFS async
+         * reader before creating the models in order; models without a usable cook fall back
+         * to load_model()
+         * @return One entry per path, nullptr where loading failed
+         */
+        auto load_models(std::span<const std::string> filepaths) -> std::vector<std::shared_ptr<ModelData>>;
+
+        /**
+         * Import a model through Assimp without creating any GPU resources
+         * @param dependencies When set, receives every other file the import read (.mtl, .bin, ...)
+         * @param weld Vertex merge tolerances; exact by default
+         * @return The model in its cooked form, or nullptr if the import failed
+         */
+        static auto import_model(const std::filesystem::path& path, std::vector<std::string>* dependencies = nullptr,
+                                 const VertexWelder::Config& weld = {}) -> std::unique_ptr<CookedModel>;
+
+        /**
+         * Where the cooked copy of a source model lives
+         */
+        [[nodiscard]] static auto get_cooked_path(const std::filesystem::path& source) -> std::filesystem::path;
+
     private:
-        auto process_assimp_scene(const aiScene* scene, const std::string& model_dir) -> std::shared_ptr<ModelData>;
-        auto process_mesh(const aiMesh* assimp_mesh) -> MeshData;
-        auto process_material(const aiMaterial* assimp_material, const std::string& model_dir) -> Material;
-        auto process_node(const aiScene* scene, const aiNode* node, ModelData& model_data, uint32_t parent_index) -> uint32_t;
+        /**
+         * @param source When set, the cooked file is rejected if it is stale relative to this source
+         */
+        auto load_cooked_model(const std::filesystem::path& path, const std::optional<std::filesystem::path>& source)
+            -> std::shared_ptr<ModelData>;
+        auto create_cooked_model(const std::filesystem::path& path, const federation::FileData& file,
+                                 const std::optional<std::filesystem::path>& source) -> std::shared_ptr<ModelData>;
+        auto import_and_cook(const std::filesystem::path& path) -> std::shared_ptr<ModelData>;
+        auto create_model(
+            std::span<const Vertex> vertices,
+            std::span<const uint32_t> indices,
+            std::span<const KmeshMesh> meshes,
+            std::vector<Material> materials,
+            std::vector<ModelNode> nodes,
+            uint32_t root_node_index,
+            std::span<const VertexSkin> skins,
+            std::shared_ptr<const AnimationSet> animation
+        ) -> std::shared_ptr<ModelData>;
+        auto load_material_textures(Material& material) -> void;
+
+        static auto process_assimp_scene(const aiScene* scene, const VertexWelder::Config& weld)
+            -> std::unique_ptr<CookedModel>;
+        /**
+         * Weld one mesh into its own streams; the returned mesh has zero offsets
+         * @param skins Receives one entry per welded vertex when the mesh has bones, else left empty
+         */
+        static auto process_mesh(const aiMesh* assimp_mesh, uint32_t material_count, const VertexWelder::Config& weld,
+                                 const Skeleton& skeleton, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices,
+                                 std::vector<VertexSkin>& skins) -> KmeshMesh;
+        /**
+         * Joints for every bone and animated node plus their ancestors, parents first
+         * @return An empty skeleton when no mesh has bones
+         */
+        static auto process_skeleton(const aiScene* scene) -> Skeleton;
+        static auto process_animation(const aiAnimation* animation, const Skeleton& skeleton) -> RawAnimationClip;
+        static auto process_material(const aiMaterial* assimp_material) -> Material;
+        static auto process_node(const aiScene* scene, const aiNode* node, CookedModel& model, uint32_t parent_index) -> uint32_t;
 
         batleth::Device& m_device;
         TextureManager& m_texture_manager;
+        ResourceRegistry& m_resources;
         std::string m_base_texture_path;
+        bool m_cook_models;
     };
 
     class KLINGON_API AssetLoaderLogStream : public Assimp::LogStream {
@@ -0,0 +1,263 @@
+#pragma once
+
+#include "mesh.h"
+#include "klingon/animation/animation_clip.hpp"
+#include "klingon/material.hpp"
+#include "klingon/model_data.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef _WIN32
+#ifdef KLINGON_EXPORTS
+#define KLINGON_API __declspec(dllexport)
+#else
+#define KLINGON_API __declspec(dllimport)
+#endif
+#else
+#define KLINGON_API
+#endif
+
+namespace klingon {
+    /**
+     * Cooked model format (.kmesh)
+     *
+     * Everything AssetLoader would otherwise derive through Assimp, stored little-endian in the
+     * layout the GPU consumes: one shared vertex stream of Vertex structs (the bound vertex
+     * layout, byte for byte), one index stream of mesh-relative uint32 indices, and small
+     * fixed-size tables for meshes, materials and nodes. Variable-length data (names, texture
+     * paths, child lists) lives in side tables referenced by offset.
+     *
+     * Every section starts 16-byte aligned, so a page-aligned mapping of the file can be viewed
+     * as typed spans and the streams copied straight into staging memory.
+     *
+     * Skinned models add a VertexSkin stream parallel to the vertices, a joint table and their
+     * compressed clips, stored as the AnimationClip tables themselves.
+     */
+    constexpr uint32_t KMESH_MAGIC = 0x48534D4B;  // "KMSH"
+    constexpr uint32_t KMESH_VERSION = 2;
+    constexpr uint32_t KMESH_NO_STRING = UINT32_MAX;
+
+    constexpr uint32_t KMESH_FLAG_SKINNED = 1u << 0;  // The skin stream is present
+
+    /**
+     * Bump whenever the import pipeline changes what it produces (post-process flags, vertex
+     * layout, material rules) so existing cooked files are treated as stale
+     */
+    constexpr uint32_t KMESH_IMPORT_VERSION = 2;
+
+    static_assert(std::endian::native == std::endian::little, "kmesh files are read in place as little-endian");
+    static_assert(sizeof(Vertex) == 44, "Vertex layout changed; bump KMESH_VERSION");
+
+    struct KmeshSection {
+        uint64_t offset = 0;
+        uint64_t count = 0;     // Elements (bytes for the string table)
+    };
+
+    struct KmeshHeader {
+        uint32_t magic = KMESH_MAGIC;
+        uint32_t version = KMESH_VERSION;
+        uint32_t import_version = KMESH_IMPORT_VERSION;
+        uint32_t flags = 0;             // KMESH_FLAG_*
+        uint64_t source_size = 0;       // Source file the cook came from, for staleness checks
+        int64_t source_mtime = 0;       // std::filesystem::file_time_type ticks
+        uint32_t root_node = 0;
+        uint32_t _padding = 0;
+        KmeshSection vertices;          // Vertex
+        KmeshSection indices;           // uint32_t, relative to the owning mesh's first vertex
+        KmeshSection meshes;            // KmeshMesh
+        KmeshSection materials;         // KmeshMaterial
+        KmeshSection nodes;             // KmeshNode
+        KmeshSection children;          // uint32_t node indices, referenced by KmeshNode
+        KmeshSection strings;           // NUL-terminated UTF-8, referenced by byte offset
+        KmeshSection skins;             // VertexSkin, one per vertex when skinned, else empty
+        KmeshSection joints;            // KmeshJoint, parents first
+        KmeshSection clips;             // KmeshClip
+        KmeshSection clip_channels;     // ClipChannel, CHANNELS_PER_JOINT per joint per clip
+        KmeshSection key_frames;        // uint16_t, referenced by KmeshClip
+        KmeshSection key_values;        // PackedKey, parallel to key_frames
+    };
+    static_assert(sizeof(KmeshHeader) == 248);
+
+    struct KmeshMesh {
+        uint32_t vertex_offset = 0;     // First element in the vertex stream
+        uint32_t vertex_count = 0;
+        uint32_t index_offset = 0;      // First element in the index stream
+        uint32_t index_count = 0;
+        uint32_t material_index = 0;    // Into the material table
+        uint32_t _padding = 0;
+        AABB bounds{};
+    };
+    static_assert(sizeof(KmeshMesh) == 48);
+
+    struct KmeshMaterial {
+        float base_color_factor[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+        float metallic_factor = 1.0f;
+        float roughness_factor = 1.0f;
+        float normal_scale = 1.0f;
+        uint32_t material_flags = 0;
+        uint32_t albedo_path = KMESH_NO_STRING;
+        uint32_t normal_path = KMESH_NO_STRING;
+        uint32_t pbr_path = KMESH_NO_STRING;
+        uint32_t opacity_path = KMESH_NO_STRING;
+    };
+    static_assert(sizeof(KmeshMaterial) == 48);
+
+    struct KmeshNode {
+        uint32_t name = KMESH_NO_STRING;
+        float translation[3] = {0.0f, 0.0f, 0.0f};
+        float rotation[3] = {0.0f, 0.0f, 0.0f};
+        float scale[3] = {1.0f, 1.0f, 1.0f};
+        uint32_t mesh_index = UINT32_MAX;
+        uint32_t material_index = 0;
+        uint32_t first_child = 0;       // Into the children table
+        uint32_t child_count = 0;
+    };
+    static_assert(sizeof(KmeshNode) == 56);
+
+    struct KmeshJoint {
+        uint32_t name = KMESH_NO_STRING;
+        uint16_t parent = NO_PARENT_JOINT;
+        uint16_t _padding = 0;
+        float inverse_bind[12] = {};    // SkinMatrix rows
+        float translation[3] = {0.0f, 0.0f, 0.0f};  // Rest pose
+        float rotation[4] = {0.0f, 0.0f, 0.0f, 1.0f};   // x, y, z, w
+        float scale[3] = {1.0f, 1.0f, 1.0f};
+    };
+    static_assert(sizeof(KmeshJoint) == 96);
+
+    struct KmeshClip {
+        uint32_t name = KMESH_NO_STRING;
+        float duration = 0.0f;
+        float sample_rate = 0.0f;
+        uint32_t first_channel = 0;     // Into the channel table; joint count * CHANNELS_PER_JOINT entries
+        uint32_t first_key = 0;         // Into the key tables; channel key ranges are relative to this
+        uint32_t key_count = 0;
+    };
+    static_assert(sizeof(KmeshClip) == 24);
+
+    /**
+     * Fully imported model before any GPU or texture work, as produced by the Assimp path
+     * Materials carry texture paths only; texture indices are assigned when the model is created.
+     */
+    struct KLINGON_API CookedModel {
+        std::vector<Vertex> vertices;       // Every mesh's vertices, back to back
+        std::vector<uint32_t> indices;      // Mesh-relative
+        std::vector<KmeshMesh> meshes;
+        std::vector<Material> materials;
+        std::vector<ModelNode> nodes;
+        uint32_t root_node_index = 0;
+        std::vector<VertexSkin> skins;      // Parallel to vertices; empty when no mesh is skinned
+        Skeleton skeleton;
+        std::vector<AnimationClip> clips;
+    };
+
+    /**
+     * Validated view over the bytes of a .kmesh file (typically a federation::MappedFile)
+     * Holds no copies: every accessor points into the viewed bytes, which must outlive the view.
+     */
+    class KLINGON_API KmeshView {
+    public:
+        /**
+         * Check the header and that every section and cross-reference lies inside the file
+         * Cost is proportional to the table sizes, not the vertex/index data.
+         */
+        static auto parse(std::span<const std::byte> bytes) -> std::expected<KmeshView, std::string>;
+
+        [[nodiscard]] auto get_header() const -> const KmeshHeader& { return *m_header; }
+        [[nodiscard]] auto get_vertices() const -> std::span<const Vertex> { return m_vertices; }
+        [[nodiscard]] auto get_indices() const -> std::span<const uint32_t> { return m_indices; }
+        [[nodiscard]] auto get_meshes() const -> std::span<const KmeshMesh> { return m_meshes; }
+        [[nodiscard]] auto get_materials() const -> std::span<const KmeshMaterial> { return m_materials; }
+        [[nodiscard]] auto get_nodes() const -> std::span<const KmeshNode> { return m_nodes; }
+        [[nodiscard]] auto get_skins() const -> std::span<const VertexSkin> { return m_skins; }
+        [[nodiscard]] auto get_joints() const -> std::span<const KmeshJoint> { return m_joints; }
+        [[nodiscard]] auto get_clips() const -> std::span<const KmeshClip> { return m_clips; }
+
+        [[nodiscard]] auto get_vertices(const KmeshMesh& mesh) const -> std::span<const Vertex> {
+            return m_vertices.subspan(mesh.vertex_offset, mesh.vertex_count);
+        }
+        [[nodiscard]] auto get_indices(const KmeshMesh& mesh) const -> std::span<const uint32_t> {
+            return m_indices.subspan(mesh.index_offset, mesh.index_count);
+        }
+        [[nodiscard]] auto get_children(const KmeshNode& node) const -> std::span<const uint32_t> {
+            return m_children.subspan(node.first_child, node.child_count);
+        }
+
+        /**
+         * @return The mesh's influences, or empty if the model is not skinned
+         */
+        [[nodiscard]] auto get_skins(const KmeshMesh& mesh) const -> std::span<const VertexSkin> {
+            return m_skins.empty() ? m_skins : m_skins.subspan(mesh.vertex_offset, mesh.vertex_count);
+        }
+
+        /**
+         * @return The string at `offset`, or empty for KMESH_NO_STRING
+         */
+        [[nodiscard]] auto get_string(uint32_t offset) const -> std::string_view;
+
+        /**
+         * Materials and nodes in their runtime form (texture indices left at defaults)
+         */
+        [[nodiscard]] auto decode_materials() const -> std::vector<Material>;
+        [[nodiscard]] auto decode_nodes() const -> std::vector<ModelNode>;
+
+        /**
+         * Skeleton and clips, copied out of the file; null when the model has no joints
+         */
+        [[nodiscard]] auto decode_animation() const -> std::shared_ptr<AnimationSet>;
+
+    private:
+        KmeshView() = default;
+
+        const KmeshHeader* m_header = nullptr;
+        std::span<const Vertex> m_vertices;
+        std::span<const uint32_t> m_indices;
+        std::span<const KmeshMesh> m_meshes;
+        std::span<const KmeshMaterial> m_materials;
+        std::span<const KmeshNode> m_nodes;
+        std::span<const uint32_t> m_children;
+        std::span<const char> m_strings;
+        std::span<const VertexSkin> m_skins;
+        std::span<const KmeshJoint> m_joints;
+        std::span<const KmeshClip> m_clips;
+        std::span<const ClipChannel> m_clip_channels;
+        std::span<const uint16_t> m_key_frames;
+        std::span<const PackedKey> m_key_values;
+    };
+
+    /**
+     * Size and modification time of a source asset, as recorded in a cooked file's header
+     */
+    struct KLINGON_API KmeshSourceStamp {
+        uint64_t size = 0;
+        int64_t mtime = 0;
+
+        static auto from_file(const std::filesystem::path& source) -> std::optional<KmeshSourceStamp>;
+    };
+
+    /**
+     * Serialize a model; written to a temporary file and renamed so readers never see a partial file
+     */
+    KLINGON_API auto write_kmesh(
+        const std::filesystem::path& path,
+        const CookedModel& model,
+        const KmeshSourceStamp& source
+    ) -> std::expected<void, std::string>;
+
+    /**
+     * Whether a cooked file has the current import version and was cooked from the source as it is now
+     * @param source Stamp of the source asset, or nullopt when it isn't available as a loose file
+     *        (shipped without sources, or packed); the cooked file is then all there is
+     */
+    KLINGON_API auto is_kmesh_current(const KmeshHeader& header, const std::optional<KmeshSourceStamp>& source) -> bool;
+} // namespace klingon
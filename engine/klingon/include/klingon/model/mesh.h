@@ -1,8 +1,10 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <memory>
+#include <span>
 #include <vulkan/vulkan_core.h>
 
 #define GLM_FORCE_RADIANS
@@ -55,6 +57,17 @@ namespace klingon {
         }
     };
 
+    /**
+     * Skinning influences of one vertex, kept as a stream parallel to the vertices
+     * Joints index the model's Skeleton; weights are unorm16 summing to 65535, strongest first with
+     * unused slots zero. A vertex whose weights are all zero is not skinned.
+     */
+    struct VertexSkin {
+        uint16_t joints[4] = {0, 0, 0, 0};
+        uint16_t weights[4] = {0, 0, 0, 0};
+    };
+    static_assert(sizeof(VertexSkin) == 16);
+
     /**
      * Mesh data container
      */
@@ -69,6 +82,11 @@ namespace klingon {
         auto load_from_file(const std::string &filepath) -> void;
     };
 
+    /**
+     * Bounds of a set of vertices (zero-sized at the origin when empty)
+     */
+    KLINGON_API auto compute_aabb(std::span<const Vertex> vertices) -> AABB;
+
     /**
      * GPU mesh representation with vertex and index buffers
      */
@@ -76,21 +94,38 @@ namespace klingon {
     public:
         Mesh(batleth::Device &device, const MeshData &mesh_data);
 
+        /**
+         * Upload ready-made streams with precomputed bounds
+         * The spans are only read during construction (each is copied once, into staging memory),
+         * so they can point straight into a mapped cooked file.
+         * @param skins Per-vertex joint influences, or empty for a static mesh. A skinned mesh keeps
+         *        its bind-pose vertices and influences in storage buffers for skinning.comp to read.
+         */
+        Mesh(batleth::Device &device, std::span<const Vertex> vertices, std::span<const uint32_t> indices,
+             const AABB &bounds, std::span<const VertexSkin> skins = {});
+
         ~Mesh();
 
         Mesh(const Mesh &) = delete;
 
         Mesh &operator=(const Mesh &) = delete;
 
-        Mesh(Mesh &&) = default;
+        // Moves take the buffers, leaving the source empty (mesh pools relocate meshes as they grow)
+        Mesh(Mesh &&other) noexcept;
 
-        Mesh &operator=(Mesh &&) = default;
+        Mesh &operator=(Mesh &&) = delete;
 
         /**
          * Bind the mesh buffers to a command buffer
          */
         auto bind(VkCommandBuffer command_buffer) -> void;
 
+        /**
+         * Bind another vertex stream of the same layout and count (a skinned copy), starting `offset`
+         * bytes into `vertex_buffer`, with this mesh's indices
+         */
+        auto bind(VkCommandBuffer command_buffer, VkBuffer vertex_buffer, VkDeviceSize offset = 0) -> void;
+
         /**
          * Draw the mesh
          */
@@ -106,11 +141,35 @@ namespace klingon {
             -> std::unique_ptr<Mesh>;
 
         [[nodiscard]] auto get_aabb() const -> const AABB & { return m_aabb; }
+        [[nodiscard]] auto get_vertex_count() const -> uint32_t { return m_vertex_count; }
+        [[nodiscard]] auto get_vertex_buffer() const -> VkBuffer { return m_vertex_buffer; }
+        [[nodiscard]] auto is_skinned() const -> bool { return m_skin_buffer != VK_NULL_HANDLE; }
+        [[nodiscard]] auto get_skin_buffer() const -> VkBuffer { return m_skin_buffer; }
+
+        /**
+         * Copy the vertex and index streams back from the GPU
+         * Waits for the copy to finish, so this is for load-time processing such as static batching.
+         * @param indices Left empty for a mesh drawn without an index buffer
+         */
+        auto read_back(std::vector<Vertex> &vertices, std::vector<uint32_t> &indices) const -> void;
 
     private:
-        auto create_vertex_buffer(const std::vector<Vertex> &vertices) -> void;
+        auto create_vertex_buffer(std::span<const Vertex> vertices, bool skinned) -> void;
+
+        auto create_index_buffer(std::span<const uint32_t> indices) -> void;
+
+        auto create_skin_buffer(std::span<const VertexSkin> skins) -> void;
 
-        auto create_index_buffer(const std::vector<uint32_t> &indices) -> void;
+        /**
+         * Device-local buffer filled through a temporary staging buffer
+         */
+        auto upload_buffer(const void *data, VkDeviceSize size, VkBufferUsageFlags usage, VkBuffer &buffer,
+                           VkDeviceMemory &memory) -> void;
+
+        /**
+         * Copy the start of a device-local buffer into host memory through a temporary staging buffer
+         */
+        auto download_buffer(VkBuffer buffer, VkDeviceSize size, void *data) const -> void;
 
         batleth::Device &m_device;
 
@@ -123,6 +182,9 @@ namespace klingon {
         VkDeviceMemory m_index_buffer_memory = VK_NULL_HANDLE;
         uint32_t m_index_count = 0;
 
+        VkBuffer m_skin_buffer = VK_NULL_HANDLE;
+        VkDeviceMemory m_skin_buffer_memory = VK_NULL_HANDLE;
+
         AABB m_aabb{};
     };
 } // namespace klingon
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "mesh.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#ifdef _WIN32
+#ifdef KLINGON_EXPORTS
+#define KLINGON_API __declspec(dllexport)
+#else
+#define KLINGON_API __declspec(dllimport)
+#endif
+#else
+#define KLINGON_API
+#endif
+
+namespace klingon {
+    /**
+     * Builds an indexed vertex stream from unindexed corners, merging identical vertices
+     *
+     * A flat open-addressing table (linear probing, load factor <= 1/2) of indices into the
+     * vertex stream, keyed by a 64-bit hash over the vertex's packed components. insert() is a
+     * single probe sequence whether or not the vertex is new; each slot keeps the upper hash
+     * bits so mismatches are rejected without touching the vertex.
+     *
+     * With the epsilons at zero vertices merge when bit-identical (after folding -0 into +0).
+     * Otherwise each component is snapped to a grid of that size before hashing, so vertices
+     * within the same cell merge and the first one seen is kept. Near-equal vertices that
+     * straddle a cell boundary stay separate.
+     */
+    class KLINGON_API VertexWelder {
+    public:
+        struct Config {
+            float position_epsilon = 0.0f;  // 0 = exact
+            float attribute_epsilon = 0.0f; // Colour, normal and UV; 0 = exact
+        };
+
+        VertexWelder();
+        explicit VertexWelder(const Config& config);
+
+        /**
+         * Size the table for this many unique vertices so insert() never rehashes
+         */
+        auto reserve(size_t vertex_count) -> void;
+
+        /**
+         * @return Index of the vertex (or the one it was merged with) in get_vertices()
+         */
+        auto insert(const Vertex& vertex) -> uint32_t;
+
+        [[nodiscard]] auto get_vertices() const -> const std::vector<Vertex>& { return m_vertices; }
+        [[nodiscard]] auto take_vertices() -> std::vector<Vertex>;
+
+        auto clear() -> void;
+
+    private:
+        static constexpr uint32_t EMPTY_SLOT = UINT32_MAX;
+
+        using Key = std::array<uint32_t, sizeof(Vertex) / sizeof(float)>;
+
+        struct Slot {
+            uint32_t index = EMPTY_SLOT;
+            uint32_t tag = 0;               // Upper 32 bits of the key hash
+        };
+
+        [[nodiscard]] auto make_key(const Vertex& vertex) const -> Key;
+        auto grow(size_t capacity) -> void;
+
+        Config m_config;
+        std::vector<Vertex> m_vertices;
+        std::vector<Slot> m_slots;          // Power-of-two sized
+    };
+} // namespace klingon
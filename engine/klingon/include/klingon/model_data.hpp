@@ -1,6 +1,8 @@
 #pragma once
 
 #include "klingon/model/mesh.h"
+#include "klingon/resource_registry.hpp"
+#include "klingon/animation/animation_clip.hpp"
 #include "klingon/material.hpp"
 #include "klingon/transform.hpp"
 #include <vector>
@@ -19,6 +21,8 @@
 #endif
 
 namespace klingon {
+    class TextureManager;
+
     /**
      * Scene graph node for hierarchical transforms
      */
@@ -35,16 +39,44 @@ namespace klingon {
     /**
      * Complete model with meshes, materials, and hierarchy
      * Replaces single Mesh in GameObject
+     * Meshes live in the ResourceRegistry and materials (with the textures they reference) in the
+     * TextureManager; both are released through their owners when the model is destroyed (the
+     * texture side is queued until the next frame records, so any thread may drop a model), and the
+     * last reference to a model must go before the Renderer does.
      */
     struct KLINGON_API ModelData {
-        std::vector<std::shared_ptr<Mesh>> meshes;
+        ModelData() = default;
+        ~ModelData();
+
+        ModelData(const ModelData&) = delete;
+        auto operator=(const ModelData&) -> ModelData& = delete;
+
+        std::vector<MeshHandle> meshes;
+        ResourceRegistry* resources = nullptr;         // Owner of meshes
+        TextureManager* textures = nullptr;            // Owner of material_buffer_indices and material textures
         std::vector<Material> materials;
         std::vector<ModelNode> nodes;
         std::vector<uint32_t> mesh_material_indices;  // Maps mesh index to material index
         uint32_t root_node_index = 0;
 
+        // Skeleton and clips for skinned meshes (Mesh::is_skinned); null for static models
+        std::shared_ptr<const AnimationSet> animation;
+
         // Material buffer indices (set when uploaded to GPU)
-        uint32_t material_buffer_offset = 0;  // Starting index in global material buffer
+        std::vector<uint32_t> material_buffer_indices;  // Global material buffer index per material (shared when identical)
+
+        /**
+         * Resolve a mesh (the model keeps it alive, so the handle is always live)
+         */
+        [[nodiscard]] auto get_mesh(size_t mesh_index) const -> Mesh& { return resources->get_mesh(meshes[mesh_index]); }
+
+        /**
+         * Global material buffer index for a mesh (default material if it has none)
+         */
+        [[nodiscard]] auto get_mesh_material_index(size_t mesh_index) const -> uint32_t {
+            const uint32_t material = mesh_material_indices[mesh_index];
+            return material < material_buffer_indices.size() ? material_buffer_indices[material] : 0;
+        }
 
         /**
          * Get accumulated world transform matrix for a node (traverses hierarchy)
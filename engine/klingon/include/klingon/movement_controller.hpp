@@ -50,11 +50,11 @@ namespace klingon {
 
         /**
      * Update movement for the target transform
-     * @param window GLFW window for polling key states
+     * @param input Input whose key state (as of this frame's dispatch) drives movement
      * @param delta_time Time since last frame in seconds
      * @param transform Transform to update
      */
-        auto update(GLFWwindow *window, float delta_time, Transform &transform) -> void;
+        auto update(const borg::Input &input, float delta_time, Transform &transform) -> void;
 
         /**
      * Set the target transform for this controller
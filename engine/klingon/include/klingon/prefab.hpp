@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include "klingon/asset_path.hpp"
+#include "klingon/game_object.hpp"
+#include "klingon/model_data.hpp"
+#include "klingon/transform.hpp"
+
+#ifdef _WIN32
+#ifdef KLINGON_EXPORTS
+#define KLINGON_API __declspec(dllexport)
+#else
+#define KLINGON_API __declspec(dllimport)
+#endif
+#else
+#define KLINGON_API
+#endif
+
+namespace klingon {
+    class AssetLoader;
+
+    /**
+     * Template for spawning many identical game objects (see Scene::instantiate)
+     *
+     * A prefab is a small hierarchy of nodes, each becoming one game object per instance. Model data
+     * is loaded once and shared by every instance; node transforms are relative to their parent, or
+     * to the instance transform for root nodes. Game objects have no hierarchy of their own, so child
+     * transforms are baked into world space when spawned.
+     */
+    struct KLINGON_API Prefab {
+        static constexpr uint32_t NO_PARENT = UINT32_MAX;
+
+        struct Node {
+            std::string name;
+            uint32_t parent = NO_PARENT;                  // Index of an earlier node, or NO_PARENT for a root
+            Transform transform{};                        // Relative to the parent
+            glm::vec3 color{1.f, 1.f, 1.f};
+            AssetPath model_filepath;
+            std::shared_ptr<ModelData> model_data;        // Shared by every instance
+            std::optional<PointLightComponent> point_light;
+            bool is_static = false;
+        };
+
+        std::string name;
+        std::vector<Node> nodes;  // Parents come before their children
+
+        /**
+         * Append a node
+         * @return Index of the node, for use as a later node's parent
+         */
+        auto add_node(Node node) -> uint32_t;
+
+        /**
+         * Single-node prefab of one model
+         * @return Prefab whose node has no model data if loading failed
+         */
+        static auto from_model(AssetLoader& asset_loader, const AssetPath& model_filepath) -> Prefab;
+    };
+} // namespace klingon
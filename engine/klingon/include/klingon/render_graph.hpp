@@ -3,13 +3,16 @@
 #include "batleth/render_graph_resource.hpp"
 #include "batleth/render_graph_pass.hpp"
 #include "batleth/barrier_batcher.hpp"
+#include "batleth/barrier_optimizer.hpp"
 #include "batleth/transient_allocator.hpp"
 
+#include "federation/name_registry.hpp"
+
+#include <filesystem>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
-#include <unordered_map>
-#include <functional>
 
 #ifdef _WIN32
 #ifdef KLINGON_EXPORTS
@@ -55,6 +58,14 @@ namespace klingon {
         batleth::ResourceState final_state;
     };
 
+    /**
+ * Per-pass timing from the most recent execution.
+ */
+    struct KLINGON_API PassTiming {
+        double cpu_ms = 0.0; // Time spent recording the pass (barriers + callback)
+        double gpu_ms = -1.0; // Timestamp delta on the GPU, negative when unavailable
+    };
+
     /**
  * High-level render graph API.
  *
@@ -122,12 +133,62 @@ namespace klingon {
      */
         [[nodiscard]] auto get_pass_count() const -> std::size_t;
 
+        /**
+     * Get the number of passes culled during compilation.
+     */
+        [[nodiscard]] auto get_culled_pass_count() const -> std::size_t;
+
+        /**
+     * Get the CPU time spent in the last compile's graph analysis, in milliseconds.
+     */
+        [[nodiscard]] auto get_compile_time_ms() const -> double;
+
+        /**
+     * Export the compiled graph as Graphviz DOT (passes, resource edges, culled passes).
+     * @return DOT source, or an empty string if the graph isn't compiled
+     */
+        [[nodiscard]] auto export_dot() const -> std::string;
+
+        /**
+     * Export the compiled graph as JSON: passes with queue, timings and barriers,
+     * resources with lifetimes and aliasing groups, culled passes and barrier stats.
+     * @return JSON document, or an empty string if the graph isn't compiled
+     */
+        [[nodiscard]] auto export_json() const -> std::string;
+
+        /**
+     * Write export_dot() and export_json() next to each other as <path>.dot and <path>.json.
+     * @return true if both files were written
+     */
+        auto dump(const std::filesystem::path &path) const -> bool;
+
         /**
      * Mark the graph as needing recompilation.
      * Call this when swapchain is recreated.
      */
         auto invalidate() -> void;
 
+        /**
+     * Reallocate a graph-owned image at a new 2D extent, keeping passes and barriers.
+     * Use for screen-sized targets on resize instead of rebuilding the graph. The old image
+     * stays alive until collect_retired() sees `retire_after` complete, since frames in flight
+     * may still use it.
+     * @return false if the graph isn't compiled or the handle isn't a graph-owned image
+     */
+        auto resize_image(batleth::ResourceHandle handle, VkExtent2D extent, std::uint64_t retire_after) -> bool;
+
+        /**
+     * Reallocate a graph-owned buffer at a new size. The old buffer is retired like in resize_image().
+     * @return false if the graph isn't compiled or the handle isn't a graph-owned buffer
+     */
+        auto resize_buffer(batleth::ResourceHandle handle, VkDeviceSize size, std::uint64_t retire_after) -> bool;
+
+        /**
+     * Free allocations replaced by resize_image()/resize_buffer() once their frames have completed.
+     * @param completed_frame Last frame known to have finished on the GPU
+     */
+        auto collect_retired(std::uint64_t completed_frame) -> void;
+
         /**
      * Get the render extent (from backbuffer).
      */
@@ -146,7 +207,6 @@ namespace klingon {
         std::unique_ptr<CompiledRenderGraph> m_compiled;
 
         // External resources
-        std::unordered_map<std::string, ExternalResource> m_external_resources;
         batleth::ResourceHandle m_backbuffer_handle = batleth::INVALID_RESOURCE;
         ExternalResource m_backbuffer;
 
@@ -161,6 +221,11 @@ namespace klingon {
     public:
         explicit RenderGraphBuilder(batleth::Device &device);
 
+        /**
+     * Builder without a device, for graphs that are only analyzed (see CompiledRenderGraph::analyze()).
+     */
+        RenderGraphBuilder();
+
         ~RenderGraphBuilder();
 
         RenderGraphBuilder(const RenderGraphBuilder &) = delete;
@@ -171,7 +236,7 @@ namespace klingon {
      * Create a transient image resource.
      */
         auto create_image(
-            const std::string &name,
+            std::string_view name,
             const batleth::ImageResourceDesc &desc
         ) -> batleth::ResourceHandle;
 
@@ -179,7 +244,7 @@ namespace klingon {
      * Create a transient buffer resource.
      */
         auto create_buffer(
-            const std::string &name,
+            std::string_view name,
             const batleth::BufferResourceDesc &desc
         ) -> batleth::ResourceHandle;
 
@@ -187,7 +252,7 @@ namespace klingon {
      * Import an external resource (e.g., swapchain, persistent texture).
      */
         auto import_external(
-            const std::string &name,
+            std::string_view name,
             const ExternalResource &external
         ) -> batleth::ResourceHandle;
 
@@ -195,7 +260,7 @@ namespace klingon {
      * Add a graphics pass.
      */
         auto add_graphics_pass(
-            const std::string &name,
+            std::string_view name,
             batleth::PassExecuteCallback execute
         ) -> RenderGraphBuilder &;
 
@@ -203,7 +268,7 @@ namespace klingon {
      * Add a compute pass.
      */
         auto add_compute_pass(
-            const std::string &name,
+            std::string_view name,
             batleth::PassExecuteCallback execute
         ) -> RenderGraphBuilder &;
 
@@ -211,7 +276,7 @@ namespace klingon {
      * Add a transfer pass.
      */
         auto add_transfer_pass(
-            const std::string &name,
+            std::string_view name,
             batleth::PassExecuteCallback execute
         ) -> RenderGraphBuilder &;
 
@@ -219,18 +284,22 @@ namespace klingon {
 
         /**
      * Declare a read dependency on a resource.
+     * @param range Mips/layers accessed; barriers only cover this sub-range
      */
         auto read(
             batleth::ResourceHandle handle,
-            batleth::ResourceUsage usage
+            batleth::ResourceUsage usage,
+            const batleth::SubresourceRange &range = {}
         ) -> RenderGraphBuilder &;
 
         /**
      * Declare a write dependency on a resource.
+     * @param range Mips/layers accessed; barriers only cover this sub-range
      */
         auto write(
             batleth::ResourceHandle handle,
-            batleth::ResourceUsage usage
+            batleth::ResourceUsage usage,
+            const batleth::SubresourceRange &range = {}
         ) -> RenderGraphBuilder &;
 
         /**
@@ -261,6 +330,14 @@ namespace klingon {
      */
         auto set_queue(batleth::QueueType queue) -> RenderGraphBuilder &;
 
+        /**
+     * Keep a resource's final contents alive past the end of the graph.
+     * Passes only survive culling if their writes reach an external or retained
+     * resource, so use this for graph-owned targets sampled outside the graph
+     * (e.g. the editor viewport texture).
+     */
+        auto retain(batleth::ResourceHandle handle) -> RenderGraphBuilder &;
+
         /**
      * Clear the builder for reuse.
      */
@@ -269,16 +346,26 @@ namespace klingon {
         // Internal access for compilation
         [[nodiscard]] auto get_resources() const -> const std::vector<batleth::ResourceDesc> &;
 
-        [[nodiscard]] auto get_passes() -> std::vector<batleth::PassDefinition> &;
+        /**
+     * Move the declared passes out of the builder. Compilation consumes them,
+     * so the graph must be rebuilt via begin_build() before compiling again.
+     */
+        [[nodiscard]] auto take_passes() -> std::vector<batleth::PassDefinition>;
 
-        [[nodiscard]] auto
-        get_external_resources() const -> const std::unordered_map<batleth::ResourceHandle, ExternalResource> &;
+        /**
+     * External resources indexed by handle. Slots that aren't externals have
+     * handle == INVALID_RESOURCE; the vector may be shorter than the resource list.
+     */
+        [[nodiscard]] auto get_external_resources() const -> const std::vector<ExternalResource> &;
+
+        [[nodiscard]] auto get_retained_resources() const -> const std::vector<batleth::ResourceHandle> &;
 
     private:
-        batleth::Device &m_device;
+        batleth::Device *m_device = nullptr;
         std::vector<batleth::ResourceDesc> m_resources;
         std::vector<batleth::PassDefinition> m_passes;
-        std::unordered_map<batleth::ResourceHandle, ExternalResource> m_externals;
+        std::vector<ExternalResource> m_externals;
+        std::vector<batleth::ResourceHandle> m_retained;
         batleth::PassDefinition *m_current_pass = nullptr;
         batleth::ResourceHandle m_next_handle = 0;
     };
@@ -302,6 +389,13 @@ namespace klingon {
 
         CompiledRenderGraph &operator=(const CompiledRenderGraph &) = delete;
 
+        /**
+     * Run only the device-independent compile phases: sort, cull, attachment ops and barrier analysis.
+     * The result reports pass counts, barrier stats and compile time and can be exported, but it owns
+     * no GPU resources and can't be executed. Used by tools and the compile benchmark.
+     */
+        static auto analyze(RenderGraphBuilder &builder) -> std::unique_ptr<CompiledRenderGraph>;
+
         /**
      * Execute the compiled graph.
      */
@@ -320,11 +414,59 @@ namespace klingon {
             const ExternalResource &external
         ) -> void;
 
+        /**
+     * Reallocate a graph-owned image at a new 2D extent. See RenderGraph::resize_image().
+     */
+        auto resize_image(batleth::ResourceHandle handle, VkExtent2D extent, std::uint64_t retire_after) -> bool;
+
+        /**
+     * Reallocate a graph-owned buffer at a new size. See RenderGraph::resize_buffer().
+     */
+        auto resize_buffer(batleth::ResourceHandle handle, VkDeviceSize size, std::uint64_t retire_after) -> bool;
+
+        /**
+     * Free replaced allocations whose retire frame has completed.
+     */
+        auto collect_retired(std::uint64_t completed_frame) -> void;
+
         /**
      * Get number of passes.
      */
         [[nodiscard]] auto get_pass_count() const -> std::size_t;
 
+        /**
+     * Get names of passes removed during compilation because none of their
+     * writes reach an external or retained resource.
+     */
+        [[nodiscard]] auto get_culled_passes() const -> const std::vector<federation::NameId> &;
+
+        /**
+     * Get the CPU time spent sorting, culling and analyzing the graph, in milliseconds.
+     * Excludes GPU memory allocation, which doesn't scale with pass count.
+     */
+        [[nodiscard]] auto get_compile_time_ms() const -> double;
+
+        /**
+     * Get barrier optimizer statistics (emitted vs. eliminated, split, batches).
+     */
+        [[nodiscard]] auto get_barrier_stats() const -> const batleth::BarrierStats &;
+
+        /**
+     * Get per-pass timings, indexed like the compiled pass list. GPU times lag by
+     * the number of frames in flight since they're read back when a frame slot is reused.
+     */
+        [[nodiscard]] auto get_pass_timings() const -> const std::vector<PassTiming> &;
+
+        /**
+     * Export the compiled graph as Graphviz DOT.
+     */
+        [[nodiscard]] auto export_dot() const -> std::string;
+
+        /**
+     * Export the compiled graph as JSON.
+     */
+        [[nodiscard]] auto export_json() const -> std::string;
+
         // Resource access for pass callbacks
         [[nodiscard]] auto get_image(batleth::ResourceHandle handle) const -> VkImage;
 
@@ -337,39 +479,89 @@ namespace klingon {
         [[nodiscard]] auto get_image_extent(batleth::ResourceHandle handle) const -> VkExtent3D;
 
     private:
+        explicit CompiledRenderGraph(RenderGraphBuilder &builder);
+
         auto topological_sort() -> void;
 
-        auto compute_lifetimes() -> void;
+        auto cull_passes() -> void;
+
+        auto infer_attachment_ops() -> void;
+
+        auto analyze_accesses() -> void;
 
         auto allocate_resources() -> void;
 
-        auto compute_barriers() -> void;
+        auto allocate_resource(batleth::ResourceHandle handle) -> void;
+
+        // Queue the current allocation for freeing after `retire_after` and allocate from m_resources again
+        auto reallocate_resource(batleth::ResourceHandle handle, std::uint64_t retire_after) -> void;
+
+        [[nodiscard]] auto is_external(batleth::ResourceHandle handle) const -> bool;
+
+        auto add_barrier(const batleth::PassBarrier &barrier) -> void;
+
+        auto get_split_events(std::uint32_t frame_index) -> const std::vector<VkEvent> &;
+
+        auto get_timestamp_pool(std::uint32_t frame_index) -> VkQueryPool;
+
+        auto read_gpu_timings(std::uint32_t frame_index) -> void;
+
+        // Transient resources grouped by non-overlapping lifetimes; each group could share one allocation
+        [[nodiscard]] auto compute_alias_groups() const -> std::vector<std::uint32_t>;
 
         auto begin_graphics_pass(VkCommandBuffer cmd, const batleth::PassDefinition &pass, VkExtent2D extent) -> void;
 
         auto end_graphics_pass(VkCommandBuffer cmd) -> void;
 
-        batleth::Device &m_device;
+        batleth::Device *m_device = nullptr;  // Null for analysis-only graphs
         std::unique_ptr<batleth::TransientAllocator> m_allocator;
         std::unique_ptr<batleth::BarrierBatcher> m_barrier_batcher;
 
         // Resource data
         std::vector<batleth::ResourceDesc> m_resources;
         std::vector<batleth::PhysicalResource> m_physical_resources;
-        std::unordered_map<batleth::ResourceHandle, batleth::ResourceLifetime> m_lifetimes;
 
-        // Pass data (in topological order)
+        // Allocations replaced by a resize, freed once frame `retire_after` has completed
+        struct RetiredResource {
+            std::uint64_t retire_after = 0;
+            batleth::PhysicalResource resource;
+        };
+
+        std::vector<RetiredResource> m_retired;
+
+        // Per-resource lifetime, indexed by handle. first_pass == ~0u means unused.
+        std::vector<batleth::ResourceLifetime> m_lifetimes;
+
+        // Resources whose contents must survive the graph (externals + retained)
+        std::vector<bool> m_retained;
+
+        // Resources only ever used as attachments that are never loaded or stored.
+        // These can live entirely in tile memory (TRANSIENT_ATTACHMENT + lazy allocation).
+        std::vector<bool> m_tile_local;
+
+        // Pass data (in topological order, culled passes removed)
         std::vector<batleth::PassDefinition> m_passes;
+        std::vector<federation::NameId> m_culled_passes;
+
+        // Pre-computed barriers (immediate, split and final) from the barrier optimizer
+        batleth::OptimizedBarriers m_barriers;
+
+        // One event per split barrier group, per frame in flight (indexed by frame_index)
+        std::vector<std::vector<VkEvent> > m_split_events;
+
+        // External resources indexed by handle (handle == INVALID_RESOURCE for non-externals)
+        std::vector<ExternalResource> m_externals;
 
-        // Pre-computed barriers per pass
-        std::vector<std::vector<batleth::PassBarrier> > m_pre_pass_barriers;
-        std::vector<batleth::PassBarrier> m_final_barriers;
+        double m_compile_time_ms = 0.0;
 
-        // External resource mapping
-        std::unordered_map<batleth::ResourceHandle, ExternalResource> m_externals;
+        // Timing of the last execution, indexed like m_passes
+        std::vector<PassTiming> m_pass_timings;
 
-        // Resource state tracking
-        std::unordered_map<batleth::ResourceHandle, batleth::ResourceState> m_resource_states;
+        // Two timestamps per pass, one pool per frame in flight. Empty when the graphics
+        // queue doesn't support timestamps.
+        std::vector<VkQueryPool> m_timestamp_pools;
+        std::vector<bool> m_timestamps_written;
+        float m_timestamp_period = 0.0f; // Nanoseconds per tick, 0 = unsupported
     };
 } // namespace klingon
 
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include "klingon/camera.hpp"
+#include "klingon/game_object.hpp"
+#include "klingon/model_data.hpp"
+#include "klingon/static_geometry.hpp"
+#include "klingon/animation/skeleton.hpp"
+
+#ifdef _WIN32
+#ifdef KLINGON_EXPORTS
+#define KLINGON_API __declspec(dllexport)
+#else
+#define KLINGON_API __declspec(dllimport)
+#endif
+#else
+#define KLINGON_API
+#endif
+
+namespace klingon {
+    class Scene;
+
+    /**
+     * Everything the renderer reads from a scene for one frame, copied out at a sync point
+     *
+     * Render systems draw from a snapshot instead of the scene, so game logic can mutate the scene
+     * for the next frame while this one is recorded on the render thread. Objects and lights are
+     * stored as parallel arrays (structure of arrays) that keep their capacity between frames, so
+     * extraction is a linear pass of appends and memcpys with no allocation in the steady state.
+     *
+     * The snapshot keeps every model it references (and the static geometry) alive until it is
+     * refilled, so objects removed from the scene meanwhile are still safe to draw; their GPU meshes
+     * then retire through the ResourceRegistry. Refilling only sets the old references aside:
+     * destroying a model calls into the renderer, so they are dropped by release_retired() at a
+     * point where no frame is recording.
+     */
+    struct KLINGON_API RenderSnapshot {
+        struct SkinRange {
+            uint32_t object = 0;          // Index into the object arrays
+            uint32_t palette_offset = 0;  // First joint in palettes
+            uint32_t joint_count = 0;
+        };
+
+        Camera camera{};
+        glm::vec4 ambient_light{1.f, 1.f, 1.f, 0.02f};
+        float frame_time = 0.0f;
+        std::chrono::steady_clock::time_point input_time{};  // When the input the camera reflects was polled
+
+        // Objects with a model, indexed together
+        std::vector<GameObject::id_t> object_ids;
+        std::vector<glm::mat4> model_matrices;
+        std::vector<glm::mat4> normal_matrices;
+        std::vector<float> extents;               // Largest scale axis, for texture residency
+        std::vector<const ModelData*> models;
+
+        // Skinning palettes of animated objects, flattened
+        std::vector<SkinRange> skins;
+        std::vector<SkinMatrix> palettes;
+
+        // Point lights, indexed together
+        std::vector<glm::vec3> light_positions;
+        std::vector<glm::vec4> light_colors;      // w is intensity
+        std::vector<float> light_radii;
+
+        std::shared_ptr<const StaticGeometry> static_geometry;
+
+        /**
+         * Replace the contents with the current state of `scene`
+         * The scene's camera and lights must already be updated for this frame. References to the
+         * previous contents are kept until release_retired().
+         */
+        auto extract(const Scene& scene, float delta_time) -> void;
+
+        /**
+         * Drop the references extract() set aside (only while no frame is recording)
+         */
+        auto release_retired() -> void;
+
+        /**
+         * Drop every object and the references keeping models alive (capacity is kept)
+         * Like release_retired(), only while no frame is recording.
+         */
+        auto clear() -> void;
+
+        [[nodiscard]] auto get_object_count() const -> size_t { return object_ids.size(); }
+        [[nodiscard]] auto get_light_count() const -> size_t { return light_positions.size(); }
+
+        [[nodiscard]] auto get_position(size_t object) const -> glm::vec3 {
+            return glm::vec3(model_matrices[object][3]);
+        }
+
+    private:
+        // Objects, skins and lights, keeping their capacity
+        auto clear_arrays() -> void;
+
+        std::vector<std::shared_ptr<const ModelData>> m_models_alive;   // One reference per distinct model
+        std::unordered_set<const ModelData*> m_models_seen;
+
+        // Previous contents' references, waiting for release_retired()
+        std::vector<std::shared_ptr<const ModelData>> m_models_retired;
+        std::vector<std::shared_ptr<const StaticGeometry>> m_static_geometry_retired;
+    };
+} // namespace klingon
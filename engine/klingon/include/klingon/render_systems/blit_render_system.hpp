@@ -24,7 +24,7 @@ namespace klingon {
      */
     class KLINGON_API BlitRenderSystem {
     public:
-        BlitRenderSystem(batleth::Device &device, VkFormat swapchain_format);
+        BlitRenderSystem(batleth::Device &device, VkFormat swapchain_format, uint32_t frames_in_flight);
 
         ~BlitRenderSystem();
 
@@ -52,6 +52,7 @@ namespace klingon {
 
         batleth::Device &m_device;
         VkFormat m_swapchain_format = VK_FORMAT_UNDEFINED;
+        uint32_t m_frames_in_flight;
         std::vector<std::unique_ptr<batleth::Shader> > m_shaders;
         std::unique_ptr<batleth::Pipeline> m_pipeline;
         VkDescriptorSetLayout m_descriptor_set_layout = VK_NULL_HANDLE;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 #include <vulkan/vulkan.h>
 #include <glm/glm.hpp>
 
@@ -21,6 +22,7 @@
 namespace klingon {
     // Forward declaration of RenderMode from simple_render_system.hpp
     enum class RenderMode;
+    class SkinningSystem;
 
     /**
      * Render system for depth pre-pass.
@@ -56,6 +58,9 @@ namespace klingon {
 
         auto on_swapchain_recreate(VkFormat depth_format) -> void;
 
+        // Skinned meshes draw this system's per-frame copies instead of their bind pose
+        auto set_skinning_system(const SkinningSystem* skinning_system) -> void { m_skinning_system = skinning_system; }
+
     private:
         struct PushConstantData {
             glm::mat4 model_matrix{1.f};
@@ -69,5 +74,9 @@ namespace klingon {
         VkDescriptorSetLayout m_global_set_layout = VK_NULL_HANDLE;
         std::unique_ptr<batleth::Pipeline> m_pipeline;
         VkPipelineLayout m_pipeline_layout = VK_NULL_HANDLE;
+        const SkinningSystem* m_skinning_system = nullptr;
+
+        // Scratch list of static batches surviving the frustum test, reused every frame
+        std::vector<const StaticGeometry::Batch*> m_visible_batches;
     };
 } // namespace klingon
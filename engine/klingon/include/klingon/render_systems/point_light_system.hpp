@@ -33,6 +33,12 @@ namespace klingon {
 
         PointLightSystem &operator=(const PointLightSystem &) = delete;
 
+        /**
+         * Orbit every point light around the scene's Y axis
+         * Mutates the scene, so it runs with game logic before the frame's snapshot is taken.
+         */
+        static auto animate(GameObject::Map &game_objects, float frame_time) -> void;
+
         // IRenderSystem interface
         auto update(FrameInfo &frame_info, GlobalUbo &ubo) -> void override;
 
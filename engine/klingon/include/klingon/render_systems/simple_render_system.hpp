@@ -19,6 +19,8 @@
 #endif
 
 namespace klingon {
+    class SkinningSystem;
+
     /**
      * Render mode for filtering opaque vs transparent geometry
      */
@@ -62,6 +64,9 @@ namespace klingon {
                                         uint32_t tile_count_x, uint32_t tile_count_y,
                                         uint32_t tile_size, uint32_t max_lights_per_tile) -> void;
 
+        // Skinned meshes draw this system's per-frame copies instead of their bind pose
+        auto set_skinning_system(const SkinningSystem* skinning_system) -> void { m_skinning_system = skinning_system; }
+
     private:
         struct PushConstantData {
             glm::mat4 model_matrix{1.f};
@@ -78,7 +83,8 @@ namespace klingon {
 
         // Helper methods for transparency rendering
         auto is_material_transparent(const Material& material) const -> bool;
-        auto render_mesh(GameObject& obj, size_t mesh_idx, FrameInfo& frame_info) -> void;
+        auto render_mesh(size_t object, size_t mesh_idx, FrameInfo& frame_info) -> void;
+        auto render_batch(const StaticGeometry::Batch& batch, FrameInfo& frame_info) -> void;
 
         batleth::Device &m_device;
         VkDescriptorSetLayout m_global_set_layout = VK_NULL_HANDLE;
@@ -95,5 +101,10 @@ namespace klingon {
         uint32_t m_tile_count_y = 0;
         uint32_t m_tile_size = 0;
         uint32_t m_max_lights_per_tile = 0;
+
+        const SkinningSystem* m_skinning_system = nullptr;
+
+        // Scratch list of static batches surviving the frustum test, reused every frame
+        std::vector<const StaticGeometry::Batch*> m_visible_batches;
     };
 } // namespace klingon
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "batleth/buffer.hpp"
+#include "batleth/descriptors.hpp"
+#include "batleth/device.hpp"
+#include "klingon/game_object.hpp"
+#include "klingon/render_snapshot.hpp"
+
+#ifdef _WIN32
+#ifdef KLINGON_EXPORTS
+#define KLINGON_API __declspec(dllexport)
+#else
+#define KLINGON_API __declspec(dllimport)
+#endif
+#else
+#define KLINGON_API
+#endif
+
+namespace klingon {
+    /**
+     * GPU skinning for every game object with an Animator
+     *
+     * Once per frame, before any pass that draws geometry, each palette captured in the frame's
+     * RenderSnapshot is copied into that frame's persistently mapped palette buffer and skinning.comp writes every
+     * skinned mesh of the object into a range of that frame's output buffer. Render systems then bind
+     * that range (get_skinned_vertices) in place of the mesh's bind pose, so skinned meshes go
+     * through the normal pipelines unchanged.
+     *
+     * Palette and output buffers are allocated once per frame in flight, sized from Config, and
+     * suballocated front to back every frame; nothing is allocated while recording. Instances past
+     * either limit draw in their bind pose. Bind-pose descriptor sets are shared by every instance of
+     * a mesh and keyed by handle, so a mesh unloaded and replaced in the same registry slot never
+     * picks up a stale set.
+     */
+    class KLINGON_API SkinningSystem {
+    public:
+        struct Config {
+            batleth::Device& device;
+            uint32_t max_palette_joints = 65536;    // Joints across every animated object in one frame
+            uint32_t max_skinned_meshes = 1024;     // Skinned mesh instances in one frame
+            uint32_t max_skinned_vertices = 524288; // Vertices across every skinned instance in one frame
+            uint32_t frames_in_flight = 2;
+        };
+
+        // Where an instance's skinned vertices live for one frame
+        struct SkinnedVertices {
+            VkBuffer buffer = VK_NULL_HANDLE;
+            VkDeviceSize offset = 0;
+        };
+
+        explicit SkinningSystem(const Config& config);
+        ~SkinningSystem();
+
+        SkinningSystem(const SkinningSystem&) = delete;
+        auto operator=(const SkinningSystem&) -> SkinningSystem& = delete;
+
+        /**
+         * Skin every animated object's meshes for this frame
+         * Ends with a compute-to-vertex-input barrier, so draws recorded afterwards read the result.
+         * @param frame_index Frame in flight (its fence must have signalled)
+         */
+        auto record(VkCommandBuffer cmd, uint32_t frame_index, const RenderSnapshot& snapshot) -> void;
+
+        /**
+         * @return The skinned copy of `mesh` on object `id` for this frame; a null buffer means draw the bind pose
+         */
+        [[nodiscard]] auto get_skinned_vertices(GameObject::id_t id, MeshHandle mesh, uint32_t frame_index) const
+            -> SkinnedVertices;
+
+    private:
+        struct PushConstantData {
+            uint32_t vertex_count = 0;
+            uint32_t palette_offset = 0;
+            uint32_t joint_count = 0;
+            uint32_t output_offset = 0;  // First vertex of the instance's range in the output buffer
+        };
+
+        struct OutputKey {
+            GameObject::id_t object = 0;
+            MeshHandle mesh;
+
+            auto operator==(const OutputKey&) const -> bool = default;
+        };
+
+        struct OutputKeyHash {
+            auto operator()(const OutputKey& key) const -> size_t {
+                return std::hash<uint32_t>{}(key.mesh.value()) ^ (static_cast<size_t>(key.object) * 0x9e3779b97f4a7c15ull);
+            }
+        };
+
+        struct MeshSet {
+            VkDescriptorSet descriptor_set = VK_NULL_HANDLE;
+            uint64_t last_used = 0;  // record() call that last dispatched with it
+        };
+
+        // Instance -> first vertex of its range in that frame's output buffer
+        using OutputMap = std::unordered_map<OutputKey, uint32_t, OutputKeyHash>;
+
+        auto create_pipeline() -> void;
+
+        /**
+         * @return The descriptor set reading `mesh`'s bind pose, created on first use; VK_NULL_HANDLE when out of sets
+         */
+        auto get_mesh_set(MeshHandle handle, const Mesh& mesh, uint64_t record_id) -> VkDescriptorSet;
+
+        /**
+         * Free bind-pose sets no frame in flight can still be using
+         */
+        auto release_unused_mesh_sets(uint64_t record_id) -> void;
+
+        // Warns the first time any limit is hit
+        auto report_overflow(std::string_view what, uint32_t limit) -> void;
+
+        batleth::Device& m_device;
+        uint32_t m_max_palette_joints;
+        uint32_t m_max_skinned_meshes;
+        uint32_t m_max_skinned_vertices;
+        uint32_t m_frames_in_flight;
+
+        std::unique_ptr<batleth::DescriptorSetLayout> m_frame_set_layout;  // Set 0: palette, skinned output
+        std::unique_ptr<batleth::DescriptorSetLayout> m_mesh_set_layout;   // Set 1: bind pose, influences
+        std::unique_ptr<batleth::DescriptorPool> m_descriptor_pool;
+        VkPipelineLayout m_pipeline_layout = VK_NULL_HANDLE;
+        VkPipeline m_pipeline = VK_NULL_HANDLE;
+
+        // One of each per frame in flight
+        std::vector<std::unique_ptr<batleth::Buffer>> m_palettes;  // Persistently mapped
+        std::vector<std::unique_ptr<batleth::Buffer>> m_vertex_outputs;
+        std::vector<VkDescriptorSet> m_frame_sets;
+        std::vector<OutputMap> m_outputs;
+
+        std::unordered_map<uint32_t, MeshSet> m_mesh_sets;  // Keyed by MeshHandle::value()
+        uint64_t m_record_count = 0;
+        bool m_reported_overflow = false;
+    };
+} // namespace klingon
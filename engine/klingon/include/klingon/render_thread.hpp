@@ -0,0 +1,68 @@
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+
+#ifdef _WIN32
+#ifdef KLINGON_EXPORTS
+#define KLINGON_API __declspec(dllexport)
+#else
+#define KLINGON_API __declspec(dllimport)
+#endif
+#else
+#define KLINGON_API
+#endif
+
+namespace klingon {
+    class Renderer;
+    struct RenderSnapshot;
+
+    /**
+     * Dedicated thread that records and submits frames from render snapshots
+     *
+     * The main thread hands over one snapshot per frame and carries on with the next frame's game
+     * logic while this thread records it (Renderer::render_snapshot). wait_idle() is the sync point:
+     * once it returns the render thread touches nothing until the next submit, so the main thread may
+     * use ImGui, recreate the swapchain and upload resources. Exceptions thrown while rendering are
+     * rethrown from wait_idle().
+     */
+    class KLINGON_API RenderThread {
+    public:
+        explicit RenderThread(Renderer& renderer);
+
+        /**
+         * Finishes the frame in progress, then stops the thread
+         */
+        ~RenderThread();
+
+        RenderThread(const RenderThread&) = delete;
+        auto operator=(const RenderThread&) -> RenderThread& = delete;
+
+        /**
+         * Start rendering `snapshot`; it must stay untouched until the next wait_idle()
+         * Call only while idle.
+         */
+        auto submit(RenderSnapshot& snapshot) -> void;
+
+        /**
+         * Block until the last submitted snapshot has been submitted to the GPU
+         */
+        auto wait_idle() -> void;
+
+    private:
+        auto thread_loop(std::stop_token stop) -> void;
+
+        Renderer& m_renderer;
+
+        std::mutex m_mutex;
+        std::condition_variable_any m_wake;
+        std::condition_variable m_idle;
+        RenderSnapshot* m_pending = nullptr;
+        bool m_busy = false;
+        std::exception_ptr m_error;
+        std::jthread m_thread;  // Last, so it stops before the state it uses goes away
+    };
+} // namespace klingon
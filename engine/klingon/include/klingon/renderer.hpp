@@ -1,6 +1,11 @@
 #pragma once
 
+#include <chrono>
+#include <deque>
+#include <filesystem>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <vector>
 #include <functional>
 
@@ -21,6 +26,7 @@
 #include "render_systems/simple_render_system.hpp"
 #include "render_systems/blit_render_system.hpp"
 #include "render_systems/depth_prepass_system.hpp"
+#include "render_systems/skinning_system.hpp"
 #include "texture_manager.hpp"
 
 #ifdef _WIN32
@@ -98,7 +104,24 @@ namespace klingon {
         auto get_depth_format() const -> VkFormat { return m_depth_format; }
 
         // Frame info
-        static constexpr auto get_max_frames_in_flight() -> std::uint32_t { return MAX_FRAMES_IN_FLIGHT; }
+        static constexpr std::uint32_t MAX_FRAMES_IN_FLIGHT = 4;  // Upper bound for Performance::max_frames_in_flight
+
+        auto get_frames_in_flight() const -> std::uint32_t { return m_frames_in_flight; }
+
+        /**
+         * CPU/GPU pacing of the most recently started frame
+         */
+        struct FramePacing {
+            float cpu_wait_ms = 0.0f;       // CPU blocked on the frame timeline for a free frame slot
+            float gpu_frame_ms = -1.0f;     // GPU time of the frame that last retired; -1 = unknown
+            float gpu_idle_ms = -1.0f;      // GPU gap between the two frames that last retired; -1 = unknown
+            std::uint64_t retired_frame = 0; // Frame timeline value the GPU has completed
+        };
+
+        /**
+         * Pacing of the last begun frame (written by render_snapshot, read at the sync point)
+         */
+        auto get_frame_pacing() const -> const FramePacing & { return m_pacing; }
 
         // Device access for render systems
         auto get_device_ref() -> batleth::Device & { return *m_device; }
@@ -106,9 +129,83 @@ namespace klingon {
         // Texture manager access
         auto get_texture_manager() -> TextureManager& { return *m_texture_manager; }
 
+        // Mesh ownership for asset loading
+        auto get_resources() -> ResourceRegistry& { return *m_resources; }
+
         // Scene rendering (new Scene API)
+        /**
+         * Render one frame of `scene` on the calling thread
+         * Equivalent to build_imgui_frame, prepare_snapshot and render_snapshot in sequence.
+         */
         auto render_scene(Scene *scene, float delta_time) -> void;
 
+        /**
+         * Main-thread half of a frame: animate lights, update the scene camera, then copy what the
+         * frame draws into `snapshot` (timed, see get_snapshot_time_ms)
+         * Only reads the swapchain, so it may overlap render_snapshot of the previous frame; the
+         * snapshot's previous model references stay alive until its release_retired(), which must not.
+         */
+        auto prepare_snapshot(Scene &scene, float delta_time, RenderSnapshot &snapshot) -> void;
+
+        /**
+         * Record, submit and present a frame of `snapshot` without touching any scene
+         * May run on a render thread; `snapshot` must not change until it returns.
+         */
+        auto render_snapshot(RenderSnapshot &snapshot) -> void;
+
+        /**
+         * Run the ImGui callback and finalize the frame's draw data
+         * Main thread only, while no render_snapshot is running.
+         */
+        auto build_imgui_frame() -> void;
+
+        /**
+         * Recreate the swapchain if the last frame found it out of date or the window was resized
+         * Main thread only (it waits while the window is minimized), while no render_snapshot is running.
+         */
+        auto recreate_swapchain_if_needed() -> void;
+
+        /**
+         * Keep render_snapshot from running while the returned lock is held
+         * With a render thread, hold it to load assets or create GPU resources from game logic.
+         */
+        [[nodiscard]] auto lock_rendering() -> std::unique_lock<std::mutex> { return std::unique_lock{m_render_mutex}; }
+
+        /**
+         * @return CPU time of the last snapshot extraction in milliseconds
+         */
+        auto get_snapshot_time_ms() const -> float { return m_snapshot_time_ms; }
+
+        // Input latency
+        using LateLatchCallback = std::function<std::optional<Transform>()>;
+
+        /**
+         * Set the hook that re-samples input as the last step before vkQueueSubmit (late latching)
+         * It returns the newest camera transform, which replaces the view in the frame's UBO, or
+         * nullopt to keep the recorded one. Runs on the thread calling render_snapshot.
+         */
+        auto set_late_latch_callback(LateLatchCallback callback) -> void { m_late_latch_callback = std::move(callback); }
+
+        /**
+         * Record when the input of the next prepared frame was polled
+         */
+        auto set_input_time(std::chrono::steady_clock::time_point time) -> void { m_input_time = time; }
+
+        /**
+         * Block until the GPU has finished the last submitted frame (frame-latency limiter)
+         */
+        auto wait_for_previous_frame() -> void;
+
+        /**
+         * Block until the frame timeline reaches `frame` (each submit signals the next value)
+         */
+        auto wait_for_frame(std::uint64_t frame) -> void;
+
+        /**
+         * @return Time from the last submitted frame's input poll to its vkQueueSubmit in milliseconds
+         */
+        auto get_input_latency_ms() const -> float { return m_input_latency_ms; }
+
         // ImGui callback
         using ImGuiCallback = std::function<void()>;
 
@@ -127,6 +224,13 @@ namespace klingon {
         // Manual invalidation
         auto invalidate_render_graph() -> void;
 
+        /**
+         * Write the compiled render graph to <path>.dot and <path>.json (passes, resources,
+         * barriers, culled passes, per-pass CPU/GPU timings).
+         * @return false if no graph is compiled yet or a file couldn't be written
+         */
+        auto dump_render_graph(const std::filesystem::path &path) const -> bool;
+
         // Debug settings
         auto set_debug_rendering_enabled(bool enabled) -> void;
 
@@ -151,7 +255,7 @@ namespace klingon {
 
         auto create_device() -> void;
 
-        auto create_swapchain() -> void;
+        auto create_swapchain(VkSwapchainKHR old_swapchain = VK_NULL_HANDLE) -> void;
 
         auto create_depth_resources() -> void;
 
@@ -161,10 +265,27 @@ namespace klingon {
 
         auto create_sync_objects() -> void;
 
+        auto create_pacing_queries() -> void;
+
+        auto read_pacing_queries(std::uint32_t frame_index) -> void;
+
         auto recreate_swapchain() -> void;
 
         auto cleanup_depth_resources() -> void;
 
+        // Swapchain and its depth buffer replaced by a resize, destroyed once frame `retire_after` completes
+        struct RetiredSwapchain {
+            std::uint64_t retire_after = 0;
+            std::unique_ptr<batleth::Swapchain> swapchain;
+            VkImage depth_image = VK_NULL_HANDLE;
+            VkDeviceMemory depth_image_memory = VK_NULL_HANDLE;
+            VkImageView depth_image_view = VK_NULL_HANDLE;
+        };
+
+        auto collect_retired_resources() -> void;
+
+        auto destroy_retired_swapchain(RetiredSwapchain &retired) -> void;
+
         auto find_depth_format() -> VkFormat;
 
         // Render graph and scene management
@@ -172,10 +293,16 @@ namespace klingon {
 
         auto should_rebuild_render_graph() const -> bool;
 
-        auto update_global_ubo(Scene *scene, float delta_time) -> void;
+        auto resize_render_graph() -> void;
+
+        auto update_global_ubo(RenderSnapshot &snapshot) -> void;
 
         auto update_camera_from_scene(Scene *scene, float delta_time) -> void;
 
+        auto request_texture_residency(const RenderSnapshot &snapshot) -> void;
+
+        auto late_latch_camera() -> void;
+
         auto create_global_descriptors() -> void;
 
         auto create_forward_plus_compute_pipeline() -> void;
@@ -195,10 +322,20 @@ namespace klingon {
         std::unique_ptr<batleth::Device> m_device;
 
         // Synchronization objects (destroyed before device)
-        static constexpr std::uint32_t MAX_FRAMES_IN_FLIGHT = 2;
+        // CPU waits all key off the frame timeline; the binary pairs are only for acquire/present
+        std::uint32_t m_frames_in_flight = 2;
         std::vector<VkSemaphore> m_image_available_semaphores;
         std::vector<VkSemaphore> m_render_finished_semaphores;
-        std::vector<VkFence> m_in_flight_fences;
+        VkSemaphore m_frame_timeline = VK_NULL_HANDLE;
+        std::uint64_t m_submitted_frame = 0;        // Timeline value of the last submit
+        std::vector<std::uint64_t> m_slot_frames;   // Timeline value each frame slot last submitted
+
+        // Frame pacing: a begin/end timestamp pair per frame slot
+        VkQueryPool m_pacing_queries = VK_NULL_HANDLE;
+        std::vector<bool> m_pacing_written;
+        float m_timestamp_period = 0.0f;            // Nanoseconds per tick, 0 = unsupported
+        std::uint64_t m_last_gpu_end = 0;
+        FramePacing m_pacing;
 
         // Command buffers (destroyed before device)
         VkCommandPool m_command_pool = VK_NULL_HANDLE;
@@ -213,6 +350,8 @@ namespace klingon {
         VkImageView m_depth_image_view = VK_NULL_HANDLE;
         VkFormat m_depth_format = VK_FORMAT_D32_SFLOAT;
 
+        std::deque<RetiredSwapchain> m_retired_swapchains;
+
         // ImGui must be destroyed before device (contains Vulkan resources)
         std::unique_ptr<ImGuiContext> m_imgui_context;
 
@@ -220,12 +359,27 @@ namespace klingon {
         std::uint32_t m_current_frame = 0;
         std::uint32_t m_current_image_index = 0;
         bool m_framebuffer_resized = false;
+        bool m_swapchain_out_of_date = false;   // Set while rendering, handled by recreate_swapchain_if_needed
+        std::mutex m_render_mutex;              // Held by render_snapshot
+        float m_snapshot_time_ms = 0.0f;
 
-        // Render graph and scene (Stage 2 additions)
+        // Input latency tracking
+        LateLatchCallback m_late_latch_callback;
+        std::chrono::steady_clock::time_point m_input_time{};
+        float m_input_latency_ms = 0.0f;
+
+        // Render graph and the snapshot being recorded (Stage 2 additions)
         std::unique_ptr<RenderGraph> m_render_graph;
-        Scene *m_active_scene = nullptr;
+        RenderSnapshot *m_frame_snapshot = nullptr;
         VkExtent2D m_last_render_extent = {0, 0};
 
+        // Screen-sized graph resources, reallocated in place on resize
+        batleth::ResourceHandle m_depth_handle = batleth::INVALID_RESOURCE;
+        batleth::ResourceHandle m_light_grid_handle = batleth::INVALID_RESOURCE;
+        batleth::ResourceHandle m_light_count_handle = batleth::INVALID_RESOURCE;
+        std::uint32_t m_tile_count_x = 0;
+        std::uint32_t m_tile_count_y = 0;
+
         // UBO and descriptors
         std::unique_ptr<batleth::DescriptorSetLayout> m_global_set_layout;
         std::unique_ptr<batleth::DescriptorPool> m_global_descriptor_pool;
@@ -243,12 +397,17 @@ namespace klingon {
 
         // Texture management
         std::unique_ptr<TextureManager> m_texture_manager;
+        std::unique_ptr<ResourceRegistry> m_resources;
+
+        // Snapshot of render_scene; it holds models, so it goes before the registry
+        RenderSnapshot m_snapshot;
 
         // Render systems
         std::unique_ptr<SimpleRenderSystem> m_simple_render_system;
         std::unique_ptr<PointLightSystem> m_point_light_system;
         std::unique_ptr<BlitRenderSystem> m_blit_render_system;
         std::unique_ptr<DepthPrepassSystem> m_depth_prepass_system;
+        std::unique_ptr<SkinningSystem> m_skinning_system;
         std::vector<std::unique_ptr<IRenderSystem> > m_custom_render_systems;
         bool m_debug_rendering_enabled = true;
 
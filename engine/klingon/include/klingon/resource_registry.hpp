@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+#include "federation/handle_pool.hpp"
+#include "klingon/model/mesh.h"
+
+#ifdef _WIN32
+#ifdef KLINGON_EXPORTS
+#define KLINGON_API __declspec(dllexport)
+#else
+#define KLINGON_API __declspec(dllimport)
+#endif
+#else
+#define KLINGON_API
+#endif
+
+namespace klingon {
+    using MeshHandle = federation::Handle<Mesh>;
+
+    /**
+     * Owner of the GPU meshes of every loaded model, addressed by generational handles
+     *
+     * Models hold 32-bit MeshHandles instead of shared pointers, so drawing touches no reference
+     * counts and a handle to an unloaded mesh fails validation instead of dangling. Releasing a mesh
+     * invalidates its handle immediately; its buffers are destroyed once every frame in flight that
+     * may still draw it has completed. Owned by the Renderer.
+     *
+     * Releasing is safe from any thread, so models can be dropped by game logic while the render
+     * thread draws. Creating a mesh may move the pool, so with threaded rendering it must happen while
+     * the render thread is idle (Renderer::lock_rendering), like any other GPU upload.
+     *
+     * Models themselves stay shared_ptr-owned on purpose. A ModelData holds no GPU objects of its
+     * own, only handles and indices into owners that already defer destruction (this registry for
+     * meshes, the TextureManager for materials and textures), so pooling it would buy no safety. It
+     * is shared by game objects and the prefabs that spawn them, with no single owner to release it,
+     * so a pool would need its own reference count anyway. And the hot path never touches
+     * those counts: RenderSnapshot takes one reference per distinct model at extraction and render
+     * systems draw through plain `const ModelData*`.
+     */
+    class KLINGON_API ResourceRegistry {
+    public:
+        struct Config {
+            uint32_t frames_in_flight = 2;
+        };
+
+        struct Stats {
+            uint32_t meshes = 0;            // Live meshes
+            size_t retired_meshes = 0;      // Released, waiting for their frames to complete
+        };
+
+        explicit ResourceRegistry(const Config& config);
+
+        /**
+         * Destroys every mesh, including released ones (the device must be idle)
+         */
+        ~ResourceRegistry();
+
+        ResourceRegistry(const ResourceRegistry&) = delete;
+        auto operator=(const ResourceRegistry&) -> ResourceRegistry& = delete;
+
+        /**
+         * Construct a mesh in the pool (Mesh constructor arguments)
+         */
+        template <class... Args>
+        auto create_mesh(Args&&... args) -> MeshHandle {
+            std::lock_guard lock(m_mutex);
+            return m_meshes.create(std::forward<Args>(args)...);
+        }
+
+        /**
+         * Resolve a live handle; stale handles assert in debug builds
+         */
+        [[nodiscard]] auto get_mesh(MeshHandle handle) -> Mesh& { return m_meshes.get(handle); }
+        [[nodiscard]] auto get_mesh(MeshHandle handle) const -> const Mesh& { return m_meshes.get(handle); }
+
+        /**
+         * @return The mesh, or nullptr when the handle is null or stale
+         */
+        [[nodiscard]] auto find_mesh(MeshHandle handle) const -> const Mesh* { return m_meshes.try_get(handle); }
+
+        /**
+         * Unload a mesh: the handle stops resolving now, the buffers go once in-flight frames retire
+         */
+        auto release_mesh(MeshHandle handle) -> void;
+
+        /**
+         * Advance to the next frame and destroy what was released frames_in_flight frames ago
+         * Call after the new frame's fence has been waited on.
+         */
+        auto begin_frame() -> void;
+
+        [[nodiscard]] auto get_stats() const -> Stats;
+
+    private:
+        mutable std::mutex m_mutex;     // Guards the free and retired lists, not lookups
+        federation::HandlePool<Mesh> m_meshes;
+        uint64_t m_frame = 0;
+    };
+} // namespace klingon
@@ -3,6 +3,7 @@
 #include <filesystem>
 #include <string>
 #include <memory>
+#include <span>
 #include <unordered_map>
 
 #include <glm/glm.hpp>
@@ -10,6 +11,8 @@
 #include "game_object.hpp"
 #include "camera.hpp"
 #include "transform.hpp"
+#include "static_geometry.hpp"
+#include "prefab.hpp"
 #include "model/asset_loader.hpp"
 
 #ifdef _WIN32
@@ -54,6 +57,15 @@ namespace klingon {
         // GameObject management (Scene owns game objects)
         auto add_game_object(GameObject &&obj) -> GameObject::id_t;
 
+        /**
+         * Spawn one instance of a prefab per transform
+         * Game objects get consecutive IDs: node n of instance i is `first + i * prefab.nodes.size() + n`.
+         * The object map is reserved once and nothing is logged per object. Static instances are not
+         * batched until build_static_geometry is called again.
+         * @return ID of the first object created
+         */
+        auto instantiate(const Prefab& prefab, std::span<const Transform> transforms) -> GameObject::id_t;
+
         auto remove_game_object(GameObject::id_t id) -> bool;
 
         auto get_game_object(GameObject::id_t id) -> GameObject *;
@@ -79,6 +91,22 @@ namespace klingon {
          */
         auto reload_all_resources(AssetLoader& asset_loader) -> void;
 
+        /**
+         * Merge every static game object into world-space batches (see StaticGeometry)
+         * Call after models are loaded; moving a static object or changing its model needs a rebuild.
+         * With threaded rendering, call it while the render thread is idle (Renderer::lock_rendering).
+         */
+        auto build_static_geometry(batleth::Device& device, ResourceRegistry& resources,
+                                   const StaticGeometry::Config& config = {}) -> void;
+
+        auto clear_static_geometry() -> void;
+
+        /**
+         * @return The batches drawn in place of static objects, or null if none were built
+         * Shared so render snapshots keep the batches alive until the frames drawing them are recorded.
+         */
+        auto get_static_geometry() const -> const std::shared_ptr<const StaticGeometry> & { return m_static_geometry; }
+
         template <class Archive>
         void serialize(Archive& ar) {
             ar(
@@ -96,5 +124,8 @@ namespace klingon {
         std::unique_ptr<Camera> m_camera;
         Transform m_camera_transform;
         glm::vec4 m_ambient_light = {1.f, 1.f, 1.f, 0.02f};
+
+        // Runtime only, rebuilt from the static game objects
+        std::shared_ptr<const StaticGeometry> m_static_geometry;
     };
 } // namespace klingon
\ No newline at end of file
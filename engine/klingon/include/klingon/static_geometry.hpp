@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <unordered_set>
+#include <vector>
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include "batleth/device.hpp"
+#include "klingon/game_object.hpp"
+#include "klingon/model/mesh.h"
+#include "klingon/resource_registry.hpp"
+
+#ifdef _WIN32
+#ifdef KLINGON_EXPORTS
+#define KLINGON_API __declspec(dllexport)
+#else
+#define KLINGON_API __declspec(dllimport)
+#endif
+#else
+#define KLINGON_API
+#endif
+
+namespace klingon {
+    /**
+     * Static scene geometry merged into a few large world-space meshes
+     *
+     * Every mesh of every game object flagged is_static is pre-transformed to world space and
+     * appended to the batch for its material and grid cell, so a level of hundreds of props draws
+     * in one call per material per cell. Cells keep batches small enough to frustum cull.
+     *
+     * The game objects stay in the scene untouched for picking and editing; render systems skip the
+     * ones listed here and draw the batches instead. Built once at load time: moving a static object
+     * or changing its model needs a rebuild (Scene::build_static_geometry).
+     */
+    class KLINGON_API StaticGeometry {
+    public:
+        struct Config {
+            float cell_size = 32.0f;  // World-space edge of the grid cells batches are split into
+        };
+
+        struct Batch {
+            MeshHandle mesh;                  // World-space vertices, drawn with an identity model matrix
+            uint32_t material_index = 0;      // Global material buffer index
+            bool transparent = false;
+            AABB bounds{};
+            glm::vec3 center{0.f};            // Of bounds, for back-to-front sorting
+        };
+
+        struct Stats {
+            uint32_t objects = 0;         // Game objects batched
+            uint32_t source_meshes = 0;   // Mesh instances merged (the draws saved)
+            uint32_t batches = 0;
+        };
+
+        /**
+         * Batch every static object in `game_objects`
+         * Animated or skinned objects are left out. Reads mesh data back from the GPU, so call it
+         * at load time, not per frame. Batch meshes live in `resources` and retire through it.
+         */
+        static auto build(batleth::Device& device, ResourceRegistry& resources, const GameObject::Map& game_objects,
+                          const Config& config) -> std::unique_ptr<StaticGeometry>;
+
+        ~StaticGeometry();
+
+        StaticGeometry(const StaticGeometry&) = delete;
+        auto operator=(const StaticGeometry&) -> StaticGeometry& = delete;
+
+        [[nodiscard]] auto get_batches() const -> std::span<const Batch> { return m_batches; }
+        [[nodiscard]] auto get_mesh(const Batch& batch) const -> Mesh& { return m_resources->get_mesh(batch.mesh); }
+        [[nodiscard]] auto get_stats() const -> const Stats& { return m_stats; }
+
+        /**
+         * @return True when the object is drawn through a batch and must not be drawn on its own
+         */
+        [[nodiscard]] auto is_batched(GameObject::id_t id) const -> bool { return m_batched_objects.contains(id); }
+
+        /**
+         * Collect the batches whose bounds intersect the view frustum
+         * @param view_projection Projection * view with Vulkan's 0..1 depth range
+         */
+        auto cull(const glm::mat4& view_projection, std::vector<const Batch*>& visible) const -> void;
+
+    private:
+        explicit StaticGeometry(ResourceRegistry& resources) : m_resources(&resources) {}
+
+        ResourceRegistry* m_resources;
+        std::vector<Batch> m_batches;
+        std::unordered_set<GameObject::id_t> m_batched_objects;
+        Stats m_stats{};
+    };
+} // namespace klingon
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "batleth/texture.hpp"
+
+#ifdef _WIN32
+#ifdef KLINGON_EXPORTS
+#define KLINGON_API __declspec(dllexport)
+#else
+#define KLINGON_API __declspec(dllimport)
+#endif
+#else
+#define KLINGON_API
+#endif
+
+namespace klingon {
+    /**
+     * Block-compressed formats the device can sample; drives Basis Universal transcode targets
+     */
+    struct BlockFormatSupport {
+        bool bc1 = false;
+        bool bc3 = false;
+        bool bc5 = false;
+        bool bc7 = false;
+    };
+
+    /**
+     * One mip level, tightly packed in its texture's format (RGBA8 pixels or 4x4 blocks)
+     */
+    struct TextureLevel {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<uint8_t> data;
+    };
+
+    /**
+     * Decoded texture ready to be copied to the GPU as-is, one entry per mip
+     */
+    struct TextureData {
+        VkFormat format = VK_FORMAT_UNDEFINED;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<TextureLevel> levels;
+    };
+
+    /**
+     * Bytes per 4x4 block for block-compressed formats, per pixel otherwise
+     * @return 0 if the format isn't one the texture loaders understand
+     */
+    KLINGON_API auto get_format_block_size(VkFormat format) -> uint32_t;
+
+    KLINGON_API auto is_block_compressed(VkFormat format) -> bool;
+
+    /**
+     * Size in bytes of a tightly packed width x height level
+     */
+    KLINGON_API auto get_level_size(VkFormat format, uint32_t width, uint32_t height) -> uint64_t;
+
+    /**
+     * Parse a DDS file (BC1-BC7, legacy FourCC or DX10 header, or uncompressed RGBA8)
+     * Only the first surface of arrays is kept; cube maps and volumes are rejected.
+     * @param data Whole file contents
+     * @param srgb Use the sRGB variant when the header doesn't specify a colour space
+     * @return All mips stored in the file, or a description of why it couldn't be read
+     */
+    KLINGON_API auto parse_dds(std::span<const uint8_t> data, bool srgb) -> std::expected<TextureData, std::string>;
+
+    /**
+     * Parse a KTX2 file
+     * Files with a concrete vkFormat (optionally Zstandard supercompressed) are returned as stored;
+     * Basis Universal files (ETC1S/BasisLZ or UASTC) are transcoded to the best target in `support`
+     * for the texture's type, falling back to RGBA8.
+     * @param data Whole file contents
+     * @param type Texture usage; normal maps prefer BC5
+     * @param support Block formats the device can sample
+     * @return All mips stored in the file, or a description of why it couldn't be read
+     */
+    KLINGON_API auto parse_ktx2(
+        std::span<const uint8_t> data,
+        batleth::TextureType type,
+        const BlockFormatSupport &support
+    ) -> std::expected<TextureData, std::string>;
+} // namespace klingon
@@ -6,6 +6,18 @@
 #include "batleth/buffer.hpp"
 #include "batleth/descriptors.hpp"
 #include "material.hpp"
+#include "material_buffer.hpp"
+#include "texture_formats.hpp"
+#include "federation/storage/virtual_file_system.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <expected>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stop_token>
+#include <thread>
 #include <unordered_map>
 #include <memory>
 #include <string>
@@ -25,18 +37,57 @@ namespace klingon {
     /**
      * Manages bindless texture array and material buffer (SSBO)
      * Handles texture loading (stb_image, KTX2, DDS) and GPU material uploads
+     *
+     * Every texture type shares one bindless array. Slots come from a free list and are
+     * reference counted; released slots are recycled once the frames that could still sample
+     * them have retired. Only slots that changed are written: fresh slots go straight into
+     * every frame's set (UPDATE_UNUSED_WHILE_PENDING makes that legal while frames are in
+     * flight), in-place patches into each frame's set when that frame comes round again.
+     *
+     * Mipmapped textures are streamed: only the tail mips are uploaded at load time, finer
+     * mips are decoded on a worker thread once requested, and the least recently used
+     * textures drop their finest mips again when the VRAM budget is exceeded. Residency
+     * changes swap the texture's image and patch its bindless slot in place; the bindless
+     * set is duplicated per frame in flight so a slot is never rewritten while in use.
+     *
+     * KTX2 and DDS files upload their pre-baked mips as stored (Basis Universal payloads are
+     * transcoded to a BC format the device supports first) and are always fully resident.
      */
     class KLINGON_API TextureManager {
     public:
+        struct Streaming {
+            bool enabled = true;
+            uint64_t budget_bytes = 512ull * 1024 * 1024;
+            uint32_t tail_size = 64;                                // Largest mip side kept resident permanently
+            uint64_t upload_bytes_per_frame = 16ull * 1024 * 1024;  // Streamed texel upload cap per frame
+            uint32_t eviction_delay_frames = 60;                    // Recently requested textures are never evicted
+        };
+
+        struct StreamingStats {
+            uint64_t resident_bytes = 0;
+            uint64_t budget_bytes = 0;
+            uint32_t streamed_textures = 0;
+            uint32_t fully_resident_textures = 0;
+            uint32_t pending_loads = 0;
+            uint64_t uploaded_bytes = 0;  // Since startup
+            uint32_t evictions = 0;       // Since startup
+        };
+
         struct Config {
             batleth::Device& device;
             VmaAllocator allocator{};
             uint32_t max_textures = 4096;
             uint32_t max_materials = 1024;
+            uint32_t frames_in_flight = 2;
+            uint32_t decode_threads = 0;  // 0 = pick from hardware concurrency
+            Streaming streaming{};
         };
 
         explicit TextureManager(const Config& config);
-        ~TextureManager() = default;
+        /**
+         * Waits for file reads still in flight; their completions reference this manager
+         */
+        ~TextureManager();
 
         // Delete copy operations
         TextureManager(const TextureManager&) = delete;
@@ -44,11 +95,12 @@ namespace klingon {
 
         /**
          * Load texture from file (auto-detects format)
-         * Returns texture index in bindless array
+         * Returns texture index in bindless array; loading an already loaded file returns the
+         * same index and adds a reference
          * @param filepath Path to texture file
          * @param type Texture type (albedo/normal/pbr)
-         * @param generate_mipmaps Auto-generate mipmaps (ignored for pre-compressed)
-         * @return Texture index (handle for bindless access)
+         * @param generate_mipmaps Auto-generate mipmaps (ignored for KTX2/DDS, which carry their own)
+         * @return Texture index (handle for bindless access), the type's default texture on failure
          */
         auto load_texture(
             const std::string& filepath,
@@ -56,6 +108,31 @@ namespace klingon {
             bool generate_mipmaps = true
         ) -> uint32_t;
 
+        /**
+         * Load texture from file without blocking on decode
+         * The returned index is valid immediately and samples the default texture for `type`
+         * until a decode worker finishes; update_streaming() then uploads it with the frame's
+         * other texture transfers and patches the slot. KTX2/DDS parsing and transcoding also
+         * happen on the worker.
+         * @param filepath Path to texture file
+         * @param type Texture type (albedo/normal/pbr)
+         * @param generate_mipmaps Build a mip chain (on the worker, on the CPU)
+         * @return Texture index (handle for bindless access)
+         */
+        auto load_texture_async(
+            const std::string& filepath,
+            batleth::TextureType type,
+            bool generate_mipmaps = true
+        ) -> uint32_t;
+
+        /**
+         * Drop one reference to a loaded texture
+         * The slot is unbound and handed back to the allocator once every frame in flight that
+         * might still sample it has retired. Default textures are never released.
+         * @param index Texture index returned by load_texture()/load_texture_async()
+         */
+        auto release_texture(uint32_t index) -> void;
+
         /**
          * Get default texture indices
          */
@@ -63,18 +140,52 @@ namespace klingon {
         [[nodiscard]] auto get_default_normal_index() const -> uint32_t { return 1; }
         [[nodiscard]] auto get_default_pbr_index() const -> uint32_t { return 2; }
         [[nodiscard]] auto get_default_opacity_index() const -> uint32_t { return 3; }
+        [[nodiscard]] auto get_default_index(batleth::TextureType type) const -> uint32_t;
+
+        /**
+         * Slots currently holding a texture (defaults included)
+         */
+        [[nodiscard]] auto get_texture_count() const -> uint32_t;
+
+        /**
+         * Material buffer management (see MaterialBuffer)
+         * Identical materials share an index; nothing reaches the GPU until flush_materials().
+         * update_material() may move a shared material to a new index, so keep the returned one.
+         * Index 0 is the default material and is returned when the buffer is full.
+         */
+        auto upload_material(const MaterialGPU& material) -> uint32_t;  // Returns material index
+        auto update_material(uint32_t index, const MaterialGPU& material) -> uint32_t;
+        auto upload_materials(const std::vector<MaterialGPU>& materials) -> std::vector<uint32_t>;  // One index per material
+        auto release_material(uint32_t index) -> void;
 
         /**
-         * Material buffer management
+         * Queue release_material()/release_texture() from any thread
+         * Models can be destroyed by game logic while the render thread streams and flushes, so their
+         * references are dropped later by apply_queued_releases() instead of touching the slots now.
          */
-        auto upload_material(MaterialGPU& material) -> uint32_t;  // Returns material index
-        auto update_material(uint32_t index, MaterialGPU& material) -> void;
-        auto upload_materials(std::vector<MaterialGPU>& materials) -> uint32_t;  // Batch upload, returns starting index
+        auto queue_release_material(uint32_t index) -> void;
+        auto queue_release_texture(uint32_t index) -> void;
+
+        /**
+         * Apply every queued release (the thread that records frames, before update_streaming())
+         */
+        auto apply_queued_releases() -> void;
+
+        /**
+         * Record uploads for materials added or edited since the last call
+         * Call once per frame after the frame's fence has been waited on, before anything reads materials
+         */
+        auto flush_materials(VkCommandBuffer cmd, uint32_t frame_index) -> void;
+
+        [[nodiscard]] auto get_material_stats() const -> MaterialBuffer::Stats { return m_materials->get_stats(); }
 
         /**
          * Get descriptor set for bindless resources (Set 2)
+         * @param frame_index Frame in flight the set will be bound in
          */
-        [[nodiscard]] auto get_descriptor_set() const -> VkDescriptorSet { return m_descriptor_set; }
+        [[nodiscard]] auto get_descriptor_set(uint32_t frame_index) const -> VkDescriptorSet {
+            return m_descriptor_sets[frame_index % m_descriptor_sets.size()];
+        }
 
         /**
          * Get descriptor set layout for pipeline creation
@@ -82,14 +193,156 @@ namespace klingon {
         [[nodiscard]] auto get_descriptor_layout() const -> VkDescriptorSetLayout;
 
         /**
-         * Update descriptors (call after loading textures)
+         * Write slots allocated since the last call into every frame's set (call after loading textures)
+         * Costs one descriptor write per new slot (contiguous slots share one write) no matter
+         * how many textures are already loaded. update_streaming() also calls this.
          */
         auto update_descriptors() -> void;
 
+        /**
+         * Ask for a streamed texture to be resident at (at least) a given on-screen size
+         * Requests are sticky until the texture falls out of use and gets evicted
+         * @param index Bindless index returned by load_texture()
+         * @param pixels Approximate screen-space footprint of the texture along its largest side
+         */
+        auto request_texture_resolution(uint32_t index, uint32_t pixels) -> void;
+
+        /**
+         * Request every texture referenced by a material (see request_texture_resolution)
+         * @param material_index Index into the material buffer
+         * @param pixels Approximate screen-space footprint
+         */
+        auto request_material_resolution(uint32_t material_index, uint32_t pixels) -> void;
+
+        /**
+         * Per-frame streaming work: retire old images and released slots, record uploads for
+         * finished decodes (async loads and mip refinements), evict over budget, queue new
+         * decodes and write this frame's dirty descriptor slots.
+         * Call after the frame's fence has been waited on and its command buffer begun.
+         * @param cmd The frame's command buffer (uploads are recorded here)
+         * @param frame_index Frame in flight index
+         */
+        auto update_streaming(VkCommandBuffer cmd, uint32_t frame_index) -> void;
+
+        [[nodiscard]] auto get_streaming_stats() const -> StreamingStats;
+
     private:
+        struct TextureSlot {
+            std::unique_ptr<batleth::Texture> texture;  // Null while an async load is pending
+            batleth::TextureType type = batleth::TextureType::Unknown;  // Picks the stand-in default
+            std::string cache_key;          // Entry in the type's path cache
+            uint32_t ref_count = 0;
+            uint32_t generation = 0;        // Bumped on release so stale decode results are dropped
+        };
+
+        struct RetiredSlot {
+            uint64_t frame = 0;             // Streaming frame the slot was released in
+            uint32_t index = 0;
+        };
+
+        struct StreamedTexture {
+            std::string filepath;
+            batleth::TextureType type = batleth::TextureType::Unknown;
+            uint32_t index = 0;
+            uint32_t width = 0;             // Mip 0 extent
+            uint32_t height = 0;
+            uint32_t mip_levels = 1;        // Full chain
+            uint32_t tail_mip = 0;          // Coarsest mip streaming ever evicts down to
+            uint32_t resident_mip = 0;      // Finest mip currently on the GPU
+            uint32_t requested_mip = 0;     // Finest mip asked for
+            uint64_t last_requested_frame = 0;
+            uint64_t resident_bytes = 0;
+            bool loading = false;
+        };
+
+        // Worker input: either the first load of an async texture or a streaming refinement
+        struct DecodeJob {
+            batleth::TextureType type = batleth::TextureType::Unknown;
+            uint32_t index = 0;             // Bindless slot
+            uint32_t generation = 0;        // Slot generation the job was queued for
+            std::string filepath;
+            uint32_t first_mip = 0;         // Refinement target (initial loads pick their own)
+            bool initial = false;
+            bool generate_mipmaps = true;
+            std::optional<federation::FileData> file{};  // Read ahead by the VFS async reader
+        };
+
+        struct DecodeResult {
+            batleth::TextureType type = batleth::TextureType::Unknown;
+            uint32_t index = 0;
+            uint32_t generation = 0;
+            std::string filepath;
+            uint32_t width = 0;             // Mip 0 extent
+            uint32_t height = 0;
+            uint32_t mip_levels = 1;        // Full chain
+            uint32_t first_mip = 0;
+            VkFormat format = VK_FORMAT_R8G8B8A8_SRGB;
+            std::vector<TextureLevel> mips; // first_mip .. end of chain; empty if decoding failed
+            bool initial = false;
+        };
+
+        struct UploadItem {
+            batleth::Image* image = nullptr;
+            const std::vector<TextureLevel>* mips = nullptr;  // One entry per image mip
+        };
+
+        struct RetiredResources {
+            uint64_t frame = 0;              // Streaming frame the resources were last used in
+            std::unique_ptr<batleth::Image> image;
+            std::unique_ptr<batleth::Buffer> staging;
+        };
+
         auto load_stb_image(const std::string& filepath, batleth::TextureType type, bool gen_mips) -> uint32_t;
-        auto load_ktx2(const std::string& filepath, batleth::TextureType type) -> uint32_t;
-        auto load_dds(const std::string& filepath, batleth::TextureType type) -> uint32_t;
+        /**
+         * Read an image through the VFS and decode it to RGBA8
+         * @return stb_image pixels (release with stbi_image_free), or nullptr on failure
+         */
+        static auto decode_rgba8(const std::string& filepath, int& width, int& height) -> uint8_t*;
+        static auto decode_rgba8(std::span<const std::byte> data, int& width, int& height) -> uint8_t*;
+        auto load_compressed_image(const std::string& filepath, batleth::TextureType type) -> uint32_t;
+        auto read_compressed_image(const std::string& filepath, batleth::TextureType type) const
+            -> std::expected<TextureData, std::string>;
+        auto parse_compressed_image(const std::string& filepath, std::span<const std::byte> data,
+                                    batleth::TextureType type) const -> std::expected<TextureData, std::string>;
+        auto query_block_format_support() const -> BlockFormatSupport;
+
+        auto load_streamed_image(const std::string& filepath, batleth::TextureType type) -> uint32_t;
+        auto add_texture(std::unique_ptr<batleth::Texture> texture, batleth::TextureType type)
+            -> std::optional<uint32_t>;
+        auto allocate_slot() -> std::optional<uint32_t>;
+        auto recycle_retired_slots() -> void;
+        auto is_current(uint32_t index, uint32_t generation) const -> bool;
+        auto get_cache(batleth::TextureType type) -> std::unordered_map<std::string, uint32_t>*;
+
+        // Streaming internals (texture_streaming.cpp)
+        static auto build_mip_chain(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t first_mip)
+            -> std::vector<TextureLevel>;
+        auto get_tail_mip(uint32_t width, uint32_t height, uint32_t mip_levels) const -> uint32_t;
+        /**
+         * Read the job's file asynchronously, then hand it to the decode workers
+         * Dozens of reads stay in flight without tying up a decode thread each.
+         */
+        auto queue_decode(DecodeJob job) -> void;
+        auto decode_worker(std::stop_token stop) -> void;
+        auto decode(const DecodeJob& job) const -> DecodeResult;
+        auto prepare_upload(DecodeResult& result) -> std::unique_ptr<batleth::Image>;
+        auto finish_upload(DecodeResult& result, std::unique_ptr<batleth::Image> image) -> void;
+        auto register_streamed(batleth::TextureType type, uint32_t index, const std::string& filepath,
+                               uint32_t width, uint32_t height, uint32_t mip_levels, uint32_t first_mip,
+                               uint64_t resident_bytes) -> void;
+        auto evict_over_budget(VkCommandBuffer cmd) -> void;
+        auto queue_refinements() -> void;
+        auto evict_mips(VkCommandBuffer cmd, StreamedTexture& streamed, uint32_t new_resident_mip) -> void;
+        auto create_texture_image(uint32_t width, uint32_t height, uint32_t mip_levels, uint32_t first_mip,
+                                  VkFormat format = VK_FORMAT_R8G8B8A8_SRGB) const
+            -> std::unique_ptr<batleth::Image>;
+        auto record_uploads(VkCommandBuffer cmd, const std::vector<UploadItem>& uploads)
+            -> std::unique_ptr<batleth::Buffer>;
+        auto unregister_streamed(uint32_t index) -> void;
+        auto patch_descriptor(uint32_t index) -> void;
+        auto write_descriptors(std::span<const VkDescriptorSet> sets, std::vector<uint32_t>& slots) -> void;
+        auto get_effective_budget() const -> uint64_t;
+        auto get_allocation_size(const batleth::Image& image) const -> uint64_t;
 
         auto create_default_textures() -> void;
         auto create_material_buffer() -> void;
@@ -100,11 +353,12 @@ namespace klingon {
         batleth::Device& m_device;
         VmaAllocator m_allocator;
 
-        // Bindless texture storage (separate arrays per type)
-        std::vector<std::unique_ptr<batleth::Texture>> m_albedo_textures;
-        std::vector<std::unique_ptr<batleth::Texture>> m_normal_textures;
-        std::vector<std::unique_ptr<batleth::Texture>> m_pbr_textures;
-        std::vector<std::unique_ptr<batleth::Texture>> m_opacity_textures;
+        // Bindless texture storage (one array for every type, indexed by slot)
+        std::vector<TextureSlot> m_slots;            // Grows up to m_max_textures
+        std::vector<uint32_t> m_free_slots;          // Released slots ready for reuse
+        std::deque<RetiredSlot> m_retired_slots;     // Released slots frames in flight may still sample
+        std::vector<uint32_t> m_new_slots;           // Allocated since the last update_descriptors()
+        uint32_t m_texture_count = 0;
 
         // Texture path -> index cache (prevent duplicate loads)
         std::unordered_map<std::string, uint32_t> m_albedo_cache;
@@ -113,9 +367,7 @@ namespace klingon {
         std::unordered_map<std::string, uint32_t> m_opacity_cache;
 
         // Material buffer (SSBO)
-        std::unique_ptr<batleth::Buffer> m_material_buffer;  // GPU buffer
-        std::vector<MaterialGPU> m_material_data;            // CPU-side copy
-        uint32_t m_material_count = 0;
+        std::unique_ptr<MaterialBuffer> m_materials;
         uint32_t m_max_materials;
 
         // Shared sampler
@@ -124,10 +376,37 @@ namespace klingon {
         // Descriptor resources
         std::unique_ptr<batleth::DescriptorSetLayout> m_descriptor_layout;
         std::unique_ptr<batleth::DescriptorPool> m_descriptor_pool;
-        VkDescriptorSet m_descriptor_set = VK_NULL_HANDLE;
+        std::vector<VkDescriptorSet> m_descriptor_sets;  // One per frame in flight
 
         uint32_t m_max_textures;
-        bool m_descriptors_dirty = true;
+        uint32_t m_frames_in_flight;
         std::string m_textures_dir = "assets/textures";
+        BlockFormatSupport m_block_support;  // Transcode targets for Basis Universal KTX2
+
+        // Streaming/async load state (render thread only, except the job/result queues)
+        Streaming m_streaming;
+        std::vector<StreamedTexture> m_streamed;
+        std::unordered_map<uint32_t, uint32_t> m_streamed_lookup;  // Slot -> m_streamed
+        std::vector<std::vector<uint32_t>> m_dirty_slots;  // Patched slots not yet written, per frame in flight
+        std::deque<RetiredResources> m_retired;
+        uint64_t m_stream_frame = 0;
+        uint32_t m_stream_frame_index = 0;
+        uint64_t m_resident_bytes = 0;
+        uint64_t m_uploaded_bytes = 0;
+        uint32_t m_eviction_count = 0;
+        uint32_t m_pending_loads = 0;
+
+        std::atomic<uint32_t> m_pending_reads{0};  // Decode jobs waiting on their file read
+
+        std::mutex m_release_mutex;                  // Guards the two queues below
+        std::vector<uint32_t> m_queued_material_releases;
+        std::vector<uint32_t> m_queued_texture_releases;
+        std::vector<uint32_t> m_applying_releases;   // Swapped with a queue so releases run unlocked
+
+        std::mutex m_decode_mutex;
+        std::condition_variable_any m_decode_cv;
+        std::deque<DecodeJob> m_decode_jobs;
+        std::deque<DecodeResult> m_decode_results;
+        std::vector<std::jthread> m_decode_threads;  // Declared last so they stop before the queues go away
     };
 } // namespace klingon
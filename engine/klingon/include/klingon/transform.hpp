@@ -40,6 +40,12 @@ namespace klingon {
      */
         auto normal_matrix() const -> glm::mat3;
 
+        /**
+     * Decompose an affine matrix built from translation, Y-X-Z rotation and scale (the inverse of mat4())
+     * Shear, such as from a non-uniformly scaled parent of a rotated child, is dropped.
+     */
+        static auto from_mat4(const glm::mat4& matrix) -> Transform;
+
         template <class Archive>
         void serialize(Archive& ar) {
             ar(translation, scale, rotation);
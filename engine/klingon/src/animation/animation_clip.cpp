@@ -0,0 +1,404 @@
+#include "klingon/animation/animation_clip.hpp"
+#include "pose_simd.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numbers>
+#include <utility>
+
+namespace klingon {
+    namespace {
+        constexpr float UNORM16_MAX = 65535.0f;
+        constexpr float SMALLEST_THREE_MAX = 32767.0f;
+        constexpr uint32_t MAX_FRAME = UINT16_MAX;
+
+        auto get_last_frame(float duration, float sample_rate) -> uint32_t {
+            const float frames = std::ceil(std::max(duration, 0.0f) * sample_rate - 1e-3f);
+            return static_cast<uint32_t>(std::clamp(frames, 0.0f, static_cast<float>(MAX_FRAME)));
+        }
+
+        auto get_component(const glm::quat& q, size_t index) -> float {
+            switch (index) {
+                case 0: return q.x;
+                case 1: return q.y;
+                case 2: return q.z;
+                default: return q.w;
+            }
+        }
+
+        auto make_quat(float x, float y, float z, float w) -> glm::quat {
+            glm::quat q;
+            q.x = x;
+            q.y = y;
+            q.z = z;
+            q.w = w;
+            return q;
+        }
+
+        auto quat_dot(const glm::quat& a, const glm::quat& b) -> float {
+            return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+        }
+
+        auto negate(const glm::quat& q) -> glm::quat {
+            return make_quat(-q.x, -q.y, -q.z, -q.w);
+        }
+
+        auto normalized(const glm::quat& q) -> glm::quat {
+            const float length = std::sqrt(quat_dot(q, q));
+            if (length < 1e-12f) {
+                return make_quat(0.0f, 0.0f, 0.0f, 1.0f);
+            }
+            return make_quat(q.x / length, q.y / length, q.z / length, q.w / length);
+        }
+
+        /**
+         * Normalized lerp along the shorter arc, as Pose blending does at runtime
+         */
+        auto nlerp(const glm::quat& a, glm::quat b, float t) -> glm::quat {
+            if (quat_dot(a, b) < 0.0f) {
+                b = negate(b);
+            }
+            return normalized(make_quat(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t,
+                                       a.z + (b.z - a.z) * t, a.w + (b.w - a.w) * t));
+        }
+
+        auto lerp(const glm::vec3& a, const glm::vec3& b, float t) -> glm::vec3 {
+            return a + (b - a) * t;
+        }
+
+        auto angle_between(const glm::quat& a, const glm::quat& b) -> float {
+            return 2.0f * std::acos(std::min(std::abs(quat_dot(a, b)), 1.0f));
+        }
+
+        auto distance(const glm::vec3& a, const glm::vec3& b) -> float {
+            const glm::vec3 d = a - b;
+            return std::sqrt(d.x * d.x + d.y * d.y + d.z * d.z);
+        }
+
+        /**
+         * Value of an imported curve at `time`, or `fallback` when the curve has no keys
+         */
+        template<typename T, typename Interpolate>
+        auto evaluate_curve(std::span<const float> times, std::span<const T> values, float time, const T& fallback,
+                            Interpolate interpolate) -> T {
+            const size_t count = std::min(times.size(), values.size());
+            if (count == 0) {
+                return fallback;
+            }
+            if (count == 1 || time <= times[0]) {
+                return values[0];
+            }
+            if (time >= times[count - 1]) {
+                return values[count - 1];
+            }
+            const auto next = static_cast<size_t>(std::upper_bound(times.begin(), times.begin() + count, time) - times.begin());
+            const float span = times[next] - times[next - 1];
+            const float t = span > 0.0f ? (time - times[next - 1]) / span : 0.0f;
+            return interpolate(values[next - 1], values[next], t);
+        }
+
+        /**
+         * Frames to keep so that interpolating between consecutive kept frames reproduces every
+         * sample within `tolerance`; a single frame when the whole curve is within tolerance of
+         * its first sample
+         *
+         * Greedy: from each kept frame, extend the segment as far as it stays within tolerance.
+         */
+        template<typename T, typename Interpolate, typename Error>
+        auto reduce_keys(std::span<const T> samples, float tolerance, Interpolate interpolate, Error error)
+            -> std::vector<uint32_t> {
+            const auto last = static_cast<uint32_t>(samples.size() - 1);
+            const bool constant = std::ranges::all_of(samples, [&](const T& sample) {
+                return error(samples[0], sample) <= tolerance;
+            });
+            if (constant || last == 0) {
+                return {0};
+            }
+
+            std::vector<uint32_t> keys{0};
+            uint32_t anchor = 0;
+            while (anchor < last) {
+                uint32_t end = anchor + 1;
+                while (end < last) {
+                    const uint32_t candidate = end + 1;
+                    bool fits = true;
+                    for (uint32_t frame = anchor + 1; frame < candidate && fits; ++frame) {
+                        const float t = static_cast<float>(frame - anchor) / static_cast<float>(candidate - anchor);
+                        fits = error(interpolate(samples[anchor], samples[candidate], t), samples[frame]) <= tolerance;
+                    }
+                    if (!fits) {
+                        break;
+                    }
+                    end = candidate;
+                }
+                keys.push_back(end);
+                anchor = end;
+            }
+            return keys;
+        }
+
+        auto encode_rotation(const glm::quat& rotation) -> PackedKey {
+            glm::quat q = normalized(rotation);
+            size_t largest = 0;
+            for (size_t i = 1; i < 4; ++i) {
+                if (std::abs(get_component(q, i)) > std::abs(get_component(q, largest))) {
+                    largest = i;
+                }
+            }
+            if (get_component(q, largest) < 0.0f) {
+                q = negate(q);
+            }
+
+            // The three smaller components lie in [-1/sqrt(2), 1/sqrt(2)]
+            PackedKey key;
+            size_t word = 0;
+            for (size_t i = 0; i < 4; ++i) {
+                if (i == largest) {
+                    continue;
+                }
+                const float unit = get_component(q, i) * std::numbers::sqrt2_v<float> * 0.5f + 0.5f;
+                key.v[word++] = static_cast<uint16_t>(std::lround(std::clamp(unit, 0.0f, 1.0f) * SMALLEST_THREE_MAX));
+            }
+            key.v[0] |= static_cast<uint16_t>((largest & 1) << 15);
+            key.v[1] |= static_cast<uint16_t>((largest >> 1) << 15);
+            return key;
+        }
+
+        auto decode_rotation(const PackedKey& key) -> std::array<float, 4> {
+            const size_t largest = (key.v[0] >> 15) | ((key.v[1] >> 15) << 1);
+            std::array<float, 4> q{};
+            float sum = 0.0f;
+            size_t word = 0;
+            for (size_t i = 0; i < 4; ++i) {
+                if (i == largest) {
+                    continue;
+                }
+                const float unit = static_cast<float>(key.v[word++] & 0x7fff) / SMALLEST_THREE_MAX;
+                q[i] = (unit * 2.0f - 1.0f) * (1.0f / std::numbers::sqrt2_v<float>);
+                sum += q[i] * q[i];
+            }
+            q[largest] = std::sqrt(std::max(1.0f - sum, 0.0f));
+            return q;
+        }
+
+        auto encode_vector(const glm::vec3& value, const ClipChannel& channel) -> PackedKey {
+            PackedKey key;
+            for (int i = 0; i < 3; ++i) {
+                const float extent = channel.range_extent[i];
+                const float unit = extent > 0.0f ? (value[i] - channel.range_min[i]) / extent : 0.0f;
+                key.v[i] = static_cast<uint16_t>(std::lround(std::clamp(unit, 0.0f, 1.0f) * UNORM16_MAX));
+            }
+            return key;
+        }
+
+        auto decode_vector(const PackedKey& key, const ClipChannel& channel, int component) -> float {
+            return channel.range_min[component] +
+                   static_cast<float>(key.v[component]) / UNORM16_MAX * channel.range_extent[component];
+        }
+
+        /**
+         * Per-thread decode buffers for sample(): the two keys around the sample time for every
+         * joint, and each channel's interpolation weight, all in Pose stream layout
+         */
+        struct SampleScratch {
+            Pose from;
+            Pose to;
+            std::vector<float> weights;     // CHANNELS_PER_JOINT streams of padded joint count
+
+            auto prepare(uint32_t joint_count) -> void {
+                if (from.get_joint_count() != joint_count) {
+                    from.resize(joint_count);
+                    to.resize(joint_count);
+                    weights.assign(static_cast<size_t>(CHANNELS_PER_JOINT) * from.get_padded_count(), 0.0f);
+                }
+            }
+
+            auto get_weights(ChannelKind kind) -> float* {
+                return weights.data() + static_cast<size_t>(kind) * from.get_padded_count();
+            }
+        };
+
+        auto get_scratch() -> SampleScratch& {
+            thread_local SampleScratch scratch;
+            return scratch;
+        }
+
+        constexpr Pose::Stream TRANSLATION_STREAMS[] = {Pose::TRANSLATION_X, Pose::TRANSLATION_Y, Pose::TRANSLATION_Z};
+        constexpr Pose::Stream ROTATION_STREAMS[] = {Pose::ROTATION_X, Pose::ROTATION_Y, Pose::ROTATION_Z, Pose::ROTATION_W};
+        constexpr Pose::Stream SCALE_STREAMS[] = {Pose::SCALE_X, Pose::SCALE_Y, Pose::SCALE_Z};
+    }
+
+    AnimationClip::AnimationClip(std::string name, float duration, float sample_rate, std::vector<ClipChannel> channels,
+                                 std::vector<uint16_t> key_frames, std::vector<PackedKey> key_values)
+        : m_name(std::move(name))
+        , m_duration(std::max(duration, 0.0f))
+        , m_sample_rate(std::max(sample_rate, 1.0f))
+        , m_last_frame(get_last_frame(m_duration, m_sample_rate))
+        , m_channels(std::move(channels))
+        , m_key_frames(std::move(key_frames))
+        , m_key_values(std::move(key_values)) {
+    }
+
+    auto AnimationClip::compress(const RawAnimationClip& raw, const Skeleton& skeleton, const ClipCompression& settings)
+        -> AnimationClip {
+        const float sample_rate = std::max(settings.sample_rate, 1.0f);
+        const uint32_t last_frame = get_last_frame(raw.duration, sample_rate);
+        const uint32_t joint_count = skeleton.get_joint_count();
+
+        std::vector<ClipChannel> channels(static_cast<size_t>(joint_count) * CHANNELS_PER_JOINT);
+        std::vector<uint16_t> key_frames;
+        std::vector<PackedKey> key_values;
+
+        std::vector<glm::vec3> vectors(last_frame + 1);
+        std::vector<glm::quat> rotations(last_frame + 1);
+        const auto frame_time = [&](uint32_t frame) {
+            return std::min(static_cast<float>(frame) / sample_rate, raw.duration);
+        };
+
+        const auto add_vector_channel = [&](ClipChannel& channel, std::span<const float> times,
+                                            std::span<const glm::vec3> values, const glm::vec3& rest, float tolerance) {
+            for (uint32_t frame = 0; frame <= last_frame; ++frame) {
+                vectors[frame] = evaluate_curve(times, values, frame_time(frame), rest, lerp);
+            }
+            const auto keys = reduce_keys(std::span<const glm::vec3>(vectors), tolerance, lerp, distance);
+
+            glm::vec3 low = vectors[keys[0]];
+            glm::vec3 high = low;
+            for (uint32_t key : keys) {
+                low = glm::min(low, vectors[key]);
+                high = glm::max(high, vectors[key]);
+            }
+            for (int i = 0; i < 3; ++i) {
+                channel.range_min[i] = low[i];
+                channel.range_extent[i] = high[i] - low[i];
+            }
+
+            channel.first_key = static_cast<uint32_t>(key_frames.size());
+            channel.key_count = static_cast<uint32_t>(keys.size());
+            for (uint32_t key : keys) {
+                key_frames.push_back(static_cast<uint16_t>(key));
+                key_values.push_back(encode_vector(vectors[key], channel));
+            }
+        };
+
+        for (uint32_t joint = 0; joint < joint_count; ++joint) {
+            static const RawJointTrack empty_track{};
+            const RawJointTrack& track = joint < raw.tracks.size() ? raw.tracks[joint] : empty_track;
+            const JointTransform& rest = skeleton.rest_pose[joint];
+            ClipChannel* joint_channels = &channels[static_cast<size_t>(joint) * CHANNELS_PER_JOINT];
+
+            add_vector_channel(joint_channels[static_cast<size_t>(ChannelKind::Translation)], track.translation_times,
+                               track.translations, rest.translation, settings.translation_tolerance);
+            add_vector_channel(joint_channels[static_cast<size_t>(ChannelKind::Scale)], track.scale_times,
+                               track.scales, rest.scale, settings.scale_tolerance);
+
+            // Keep consecutive samples in one hemisphere so dropped keys interpolate the short way
+            for (uint32_t frame = 0; frame <= last_frame; ++frame) {
+                rotations[frame] = normalized(evaluate_curve(std::span<const float>(track.rotation_times),
+                                                            std::span<const glm::quat>(track.rotations),
+                                                            frame_time(frame), rest.rotation, nlerp));
+                if (frame > 0 && quat_dot(rotations[frame - 1], rotations[frame]) < 0.0f) {
+                    rotations[frame] = negate(rotations[frame]);
+                }
+            }
+            const auto keys = reduce_keys(std::span<const glm::quat>(rotations), settings.rotation_tolerance,
+                                          nlerp, angle_between);
+            ClipChannel& rotation = joint_channels[static_cast<size_t>(ChannelKind::Rotation)];
+            rotation.first_key = static_cast<uint32_t>(key_frames.size());
+            rotation.key_count = static_cast<uint32_t>(keys.size());
+            for (uint32_t key : keys) {
+                key_frames.push_back(static_cast<uint16_t>(key));
+                key_values.push_back(encode_rotation(rotations[key]));
+            }
+        }
+
+        return AnimationClip(raw.name, raw.duration, sample_rate, std::move(channels), std::move(key_frames),
+                             std::move(key_values));
+    }
+
+    auto AnimationClip::sample(float time, Pose& pose) const -> void {
+        const uint32_t joint_count = get_joint_count();
+        assert(pose.get_joint_count() == joint_count);
+
+        auto& scratch = get_scratch();
+        scratch.prepare(joint_count);
+        const float frame = std::clamp(time * m_sample_rate, 0.0f, static_cast<float>(m_last_frame));
+
+        // Decode the keys on either side of the frame (scalar), then interpolate four joints at a time
+        for (uint32_t joint = 0; joint < joint_count; ++joint) {
+            for (uint32_t kind = 0; kind < CHANNELS_PER_JOINT; ++kind) {
+                const ClipChannel& channel = m_channels[joint * CHANNELS_PER_JOINT + kind];
+                uint32_t from = channel.first_key;
+                uint32_t to = channel.first_key;
+                float weight = 0.0f;
+                if (channel.key_count > 1) {
+                    const uint16_t* frames = m_key_frames.data() + channel.first_key;
+                    const uint16_t* next = std::upper_bound(frames, frames + channel.key_count, frame,
+                                                            [](float value, uint16_t key) { return value < key; });
+                    const auto index = static_cast<uint32_t>(
+                        std::clamp<ptrdiff_t>(next - frames, 1, static_cast<ptrdiff_t>(channel.key_count) - 1));
+                    from = channel.first_key + index - 1;
+                    to = channel.first_key + index;
+                    const float span = static_cast<float>(m_key_frames[to] - m_key_frames[from]);
+                    weight = std::clamp((frame - m_key_frames[from]) / span, 0.0f, 1.0f);
+                }
+
+                const auto channel_kind = static_cast<ChannelKind>(kind);
+                scratch.get_weights(channel_kind)[joint] = weight;
+                if (channel_kind == ChannelKind::Rotation) {
+                    const auto a = decode_rotation(m_key_values[from]);
+                    const auto b = decode_rotation(m_key_values[to]);
+                    for (size_t c = 0; c < 4; ++c) {
+                        scratch.from.get_stream(ROTATION_STREAMS[c])[joint] = a[c];
+                        scratch.to.get_stream(ROTATION_STREAMS[c])[joint] = b[c];
+                    }
+                } else {
+                    const auto& streams = channel_kind == ChannelKind::Translation ? TRANSLATION_STREAMS : SCALE_STREAMS;
+                    for (int c = 0; c < 3; ++c) {
+                        scratch.from.get_stream(streams[c])[joint] = decode_vector(m_key_values[from], channel, c);
+                        scratch.to.get_stream(streams[c])[joint] = decode_vector(m_key_values[to], channel, c);
+                    }
+                }
+            }
+        }
+
+        const uint32_t count = pose.get_padded_count();
+        const auto weights_of = [&](ChannelKind kind) {
+            return [weights = scratch.get_weights(kind)](uint32_t i) { return simd::Float4::load(weights + i); };
+        };
+        for (auto stream : TRANSLATION_STREAMS) {
+            simd::lerp_stream(scratch.from.get_stream(stream), scratch.to.get_stream(stream),
+                              weights_of(ChannelKind::Translation), pose.get_stream(stream), count);
+        }
+        for (auto stream : SCALE_STREAMS) {
+            simd::lerp_stream(scratch.from.get_stream(stream), scratch.to.get_stream(stream),
+                              weights_of(ChannelKind::Scale), pose.get_stream(stream), count);
+        }
+        const Pose& from = scratch.from;
+        const Pose& to = scratch.to;
+        simd::nlerp_streams(
+            {from.get_stream(Pose::ROTATION_X), from.get_stream(Pose::ROTATION_Y),
+             from.get_stream(Pose::ROTATION_Z), from.get_stream(Pose::ROTATION_W)},
+            {to.get_stream(Pose::ROTATION_X), to.get_stream(Pose::ROTATION_Y),
+             to.get_stream(Pose::ROTATION_Z), to.get_stream(Pose::ROTATION_W)},
+            weights_of(ChannelKind::Rotation),
+            {pose.get_stream(Pose::ROTATION_X), pose.get_stream(Pose::ROTATION_Y),
+             pose.get_stream(Pose::ROTATION_Z), pose.get_stream(Pose::ROTATION_W)},
+            count);
+    }
+
+    auto AnimationClip::get_size_bytes() const -> size_t {
+        return m_name.size() + m_channels.size() * sizeof(ClipChannel) + m_key_frames.size() * sizeof(uint16_t) +
+               m_key_values.size() * sizeof(PackedKey);
+    }
+
+    auto AnimationSet::find_clip(std::string_view name) const -> std::optional<uint32_t> {
+        for (size_t i = 0; i < clips.size(); ++i) {
+            if (clips[i].get_name() == name) {
+                return static_cast<uint32_t>(i);
+            }
+        }
+        return std::nullopt;
+    }
+} // namespace klingon
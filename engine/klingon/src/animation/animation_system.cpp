@@ -0,0 +1,87 @@
+#include "klingon/animation/animation_system.hpp"
+#include "klingon/animation/animator.hpp"
+#include "federation/log.hpp"
+
+#include <algorithm>
+#include <ranges>
+
+namespace klingon {
+    AnimationSystem::AnimationSystem()
+        : AnimationSystem(Config{}) {
+    }
+
+    AnimationSystem::AnimationSystem(const Config& config)
+        : m_config(config) {
+        const uint32_t threads = config.threads > 0 ? config.threads : std::max(std::thread::hardware_concurrency(), 1u);
+        m_workers.reserve(threads - 1);
+        for (uint32_t i = 0; i + 1 < threads; ++i) {
+            m_workers.emplace_back([this](std::stop_token stop) { worker_loop(stop); });
+        }
+        FED_DEBUG("AnimationSystem started with {} threads", threads);
+    }
+
+    AnimationSystem::~AnimationSystem() {
+        for (auto& worker : m_workers) {
+            worker.request_stop();
+        }
+        m_wake.notify_all();
+        m_workers.clear();
+    }
+
+    auto AnimationSystem::update(GameObject::Map& game_objects, float delta_time) -> void {
+        m_batch.clear();
+        for (auto& object : game_objects | std::views::values) {
+            if (object.animator) {
+                m_batch.push_back(object.animator.get());
+            }
+        }
+        if (m_batch.empty()) {
+            return;
+        }
+
+        m_delta_time = delta_time;
+        m_next = 0;
+        if (m_workers.empty() || m_batch.size() < m_config.min_batch) {
+            run_batch();
+            return;
+        }
+
+        {
+            std::lock_guard lock(m_mutex);
+            m_busy = static_cast<uint32_t>(m_workers.size());
+            ++m_generation;
+        }
+        m_wake.notify_all();
+        run_batch();
+
+        std::unique_lock lock(m_mutex);
+        m_finished.wait(lock, [this] { return m_busy == 0; });
+    }
+
+    auto AnimationSystem::worker_loop(std::stop_token stop) -> void {
+        uint64_t seen = 0;
+        while (true) {
+            {
+                std::unique_lock lock(m_mutex);
+                if (!m_wake.wait(lock, stop, [&] { return m_generation != seen; })) {
+                    return;
+                }
+                seen = m_generation;
+            }
+
+            run_batch();
+
+            std::lock_guard lock(m_mutex);
+            if (--m_busy == 0) {
+                m_finished.notify_one();
+            }
+        }
+    }
+
+    auto AnimationSystem::run_batch() -> void {
+        const auto count = static_cast<uint32_t>(m_batch.size());
+        for (uint32_t i = m_next++; i < count; i = m_next++) {
+            m_batch[i]->update(m_delta_time);
+        }
+    }
+} // namespace klingon
@@ -0,0 +1,63 @@
+#include "klingon/animation/animator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace klingon {
+    Animator::Animator(std::shared_ptr<const AnimationSet> animation)
+        : m_animation(std::move(animation)) {
+        const uint32_t joint_count = m_animation ? m_animation->skeleton.get_joint_count() : 0;
+        m_pose.resize(joint_count);
+        m_layer_pose.resize(joint_count);
+        m_model.resize(joint_count);
+        m_palette.resize(joint_count);
+        if (m_animation) {
+            m_pose.set_rest_pose(m_animation->skeleton);
+        }
+    }
+
+    auto Animator::play(uint32_t clip, float weight, bool loop) -> uint32_t {
+        m_layers.push_back({.clip = clip, .time = 0.0f, .speed = 1.0f, .weight = weight, .loop = loop});
+        return static_cast<uint32_t>(m_layers.size() - 1);
+    }
+
+    auto Animator::update(float delta_time) -> void {
+        if (!m_animation) {
+            return;
+        }
+        const auto& skeleton = m_animation->skeleton;
+        const auto& clips = m_animation->clips;
+
+        bool sampled = false;
+        for (auto& layer : m_layers) {
+            if (layer.clip >= clips.size()) {
+                continue;
+            }
+            const AnimationClip& clip = clips[layer.clip];
+            const float duration = clip.get_duration();
+            layer.time += delta_time * layer.speed;
+            if (layer.loop && duration > 0.0f) {
+                layer.time = std::fmod(layer.time, duration);
+                if (layer.time < 0.0f) {
+                    layer.time += duration;
+                }
+            }
+
+            // The first contributing layer is the base pose; later ones blend over it
+            if (!sampled) {
+                clip.sample(layer.time, m_pose);
+                sampled = true;
+            } else if (layer.weight > 0.0f) {
+                clip.sample(layer.time, m_layer_pose);
+                blend_poses(m_pose, m_layer_pose, std::min(layer.weight, 1.0f), m_pose);
+            }
+        }
+        if (!sampled) {
+            m_pose.set_rest_pose(skeleton);
+        }
+
+        compute_model_transforms(skeleton, m_pose, m_model);
+        compute_skin_palette(skeleton, m_model, m_palette);
+    }
+} // namespace klingon
@@ -0,0 +1,141 @@
+#include "klingon/animation/pose.hpp"
+#include "pose_simd.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace klingon {
+    namespace {
+        constexpr float IDENTITY[Pose::STREAM_COUNT] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f};
+
+        auto get_rotations(const Pose& pose) -> simd::ConstStreams4 {
+            return {pose.get_stream(Pose::ROTATION_X), pose.get_stream(Pose::ROTATION_Y),
+                    pose.get_stream(Pose::ROTATION_Z), pose.get_stream(Pose::ROTATION_W)};
+        }
+
+        auto get_rotations(Pose& pose) -> simd::Streams4 {
+            return {pose.get_stream(Pose::ROTATION_X), pose.get_stream(Pose::ROTATION_Y),
+                    pose.get_stream(Pose::ROTATION_Z), pose.get_stream(Pose::ROTATION_W)};
+        }
+    }
+
+    Pose::Pose(uint32_t joint_count) {
+        resize(joint_count);
+    }
+
+    auto Pose::resize(uint32_t joint_count) -> void {
+        m_joint_count = joint_count;
+        m_padded_count = (joint_count + 3) & ~3u;
+        m_data.resize(static_cast<size_t>(STREAM_COUNT) * m_padded_count);
+        for (uint32_t stream = 0; stream < STREAM_COUNT; ++stream) {
+            std::fill_n(m_data.begin() + stream * m_padded_count, m_padded_count, IDENTITY[stream]);
+        }
+    }
+
+    auto Pose::set_rest_pose(const Skeleton& skeleton) -> void {
+        if (skeleton.get_joint_count() != m_joint_count) {
+            resize(skeleton.get_joint_count());
+        }
+        for (uint32_t joint = 0; joint < m_joint_count; ++joint) {
+            set_joint(joint, skeleton.rest_pose[joint]);
+        }
+    }
+
+    auto Pose::get_joint(uint32_t joint) const -> JointTransform {
+        JointTransform transform;
+        transform.translation = {get_stream(TRANSLATION_X)[joint], get_stream(TRANSLATION_Y)[joint],
+                                 get_stream(TRANSLATION_Z)[joint]};
+        transform.rotation.x = get_stream(ROTATION_X)[joint];
+        transform.rotation.y = get_stream(ROTATION_Y)[joint];
+        transform.rotation.z = get_stream(ROTATION_Z)[joint];
+        transform.rotation.w = get_stream(ROTATION_W)[joint];
+        transform.scale = {get_stream(SCALE_X)[joint], get_stream(SCALE_Y)[joint], get_stream(SCALE_Z)[joint]};
+        return transform;
+    }
+
+    auto Pose::set_joint(uint32_t joint, const JointTransform& transform) -> void {
+        get_stream(TRANSLATION_X)[joint] = transform.translation.x;
+        get_stream(TRANSLATION_Y)[joint] = transform.translation.y;
+        get_stream(TRANSLATION_Z)[joint] = transform.translation.z;
+        get_stream(ROTATION_X)[joint] = transform.rotation.x;
+        get_stream(ROTATION_Y)[joint] = transform.rotation.y;
+        get_stream(ROTATION_Z)[joint] = transform.rotation.z;
+        get_stream(ROTATION_W)[joint] = transform.rotation.w;
+        get_stream(SCALE_X)[joint] = transform.scale.x;
+        get_stream(SCALE_Y)[joint] = transform.scale.y;
+        get_stream(SCALE_Z)[joint] = transform.scale.z;
+    }
+
+    auto blend_poses(const Pose& a, const Pose& b, float weight, Pose& out) -> void {
+        assert(a.get_joint_count() == b.get_joint_count() && a.get_joint_count() == out.get_joint_count());
+        const uint32_t count = out.get_padded_count();
+        const auto uniform = [w = simd::Float4::set1(weight)](uint32_t) { return w; };
+
+        for (auto stream : {Pose::TRANSLATION_X, Pose::TRANSLATION_Y, Pose::TRANSLATION_Z,
+                            Pose::SCALE_X, Pose::SCALE_Y, Pose::SCALE_Z}) {
+            simd::lerp_stream(a.get_stream(stream), b.get_stream(stream), uniform, out.get_stream(stream), count);
+        }
+        simd::nlerp_streams(get_rotations(a), get_rotations(b), uniform, get_rotations(out), count);
+    }
+
+    auto compute_model_transforms(const Skeleton& skeleton, const Pose& pose, std::span<SkinMatrix> model) -> void {
+        using simd::Float4;
+        assert(pose.get_joint_count() == skeleton.get_joint_count() && model.size() >= pose.get_joint_count());
+
+        // Local TRS -> affine matrix, four joints at a time
+        const uint32_t joint_count = pose.get_joint_count();
+        for (uint32_t first = 0; first < joint_count; first += 4) {
+            const auto load = [&](Pose::Stream stream) { return Float4::load(pose.get_stream(stream) + first); };
+            const Float4 x = load(Pose::ROTATION_X);
+            const Float4 y = load(Pose::ROTATION_Y);
+            const Float4 z = load(Pose::ROTATION_Z);
+            const Float4 w = load(Pose::ROTATION_W);
+            const Float4 sx = load(Pose::SCALE_X);
+            const Float4 sy = load(Pose::SCALE_Y);
+            const Float4 sz = load(Pose::SCALE_Z);
+
+            const Float4 one = Float4::set1(1.0f);
+            const Float4 two = Float4::set1(2.0f);
+            const Float4 xx = x * x, yy = y * y, zz = z * z;
+            const Float4 xy = x * y, xz = x * z, yz = y * z;
+            const Float4 wx = w * x, wy = w * y, wz = w * z;
+
+            // Rows of T * R * S
+            std::array<Float4, 12> rows = {
+                (one - two * (yy + zz)) * sx, two * (xy - wz) * sy, two * (xz + wy) * sz, load(Pose::TRANSLATION_X),
+                two * (xy + wz) * sx, (one - two * (xx + zz)) * sy, two * (yz - wx) * sz, load(Pose::TRANSLATION_Y),
+                two * (xz - wy) * sx, two * (yz + wx) * sy, (one - two * (xx + yy)) * sz, load(Pose::TRANSLATION_Z),
+            };
+
+            float lanes[12][4];
+            for (size_t i = 0; i < rows.size(); ++i) {
+                rows[i].store(lanes[i]);
+            }
+            const uint32_t lane_count = std::min(4u, joint_count - first);
+            for (uint32_t lane = 0; lane < lane_count; ++lane) {
+                auto& matrix = model[first + lane];
+                for (int row = 0; row < 3; ++row) {
+                    matrix.rows[row] = {lanes[row * 4][lane], lanes[row * 4 + 1][lane],
+                                        lanes[row * 4 + 2][lane], lanes[row * 4 + 3][lane]};
+                }
+            }
+        }
+
+        // Parents precede children, so each parent is already in model space
+        for (uint32_t joint = 0; joint < joint_count; ++joint) {
+            const uint16_t parent = skeleton.parents[joint];
+            if (parent != NO_PARENT_JOINT) {
+                model[joint] = multiply(model[parent], model[joint]);
+            }
+        }
+    }
+
+    auto compute_skin_palette(const Skeleton& skeleton, std::span<const SkinMatrix> model,
+                              std::span<SkinMatrix> palette) -> void {
+        const uint32_t joint_count = skeleton.get_joint_count();
+        assert(model.size() >= joint_count && palette.size() >= joint_count);
+        for (uint32_t joint = 0; joint < joint_count; ++joint) {
+            palette[joint] = multiply(model[joint], skeleton.inverse_bind[joint]);
+        }
+    }
+} // namespace klingon
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64)
+#include <xmmintrin.h>
+#define KLINGON_SIMD_SSE 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define KLINGON_SIMD_NEON 1
+#endif
+
+namespace klingon::simd {
+    /**
+     * Four lanes of float; one lane per joint when working on Pose streams
+     */
+    struct Float4 {
+#if defined(KLINGON_SIMD_SSE)
+        __m128 v;
+
+        static auto set1(float x) -> Float4 { return {_mm_set1_ps(x)}; }
+        static auto load(const float* p) -> Float4 { return {_mm_loadu_ps(p)}; }
+        auto store(float* p) const -> void { _mm_storeu_ps(p, v); }
+
+        friend auto operator+(Float4 a, Float4 b) -> Float4 { return {_mm_add_ps(a.v, b.v)}; }
+        friend auto operator-(Float4 a, Float4 b) -> Float4 { return {_mm_sub_ps(a.v, b.v)}; }
+        friend auto operator*(Float4 a, Float4 b) -> Float4 { return {_mm_mul_ps(a.v, b.v)}; }
+
+        /**
+         * x with its sign flipped in every lane where `sign` is negative
+         */
+        static auto flip_sign(Float4 x, Float4 sign) -> Float4 {
+            return {_mm_xor_ps(x.v, _mm_and_ps(sign.v, _mm_set1_ps(-0.0f)))};
+        }
+        static auto inverse_sqrt(Float4 x) -> Float4 { return {_mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(x.v))}; }
+#elif defined(KLINGON_SIMD_NEON)
+        float32x4_t v;
+
+        static auto set1(float x) -> Float4 { return {vdupq_n_f32(x)}; }
+        static auto load(const float* p) -> Float4 { return {vld1q_f32(p)}; }
+        auto store(float* p) const -> void { vst1q_f32(p, v); }
+
+        friend auto operator+(Float4 a, Float4 b) -> Float4 { return {vaddq_f32(a.v, b.v)}; }
+        friend auto operator-(Float4 a, Float4 b) -> Float4 { return {vsubq_f32(a.v, b.v)}; }
+        friend auto operator*(Float4 a, Float4 b) -> Float4 { return {vmulq_f32(a.v, b.v)}; }
+
+        static auto flip_sign(Float4 x, Float4 sign) -> Float4 {
+            const uint32x4_t mask = vandq_u32(vreinterpretq_u32_f32(sign.v), vdupq_n_u32(0x80000000u));
+            return {vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(x.v), mask))};
+        }
+        static auto inverse_sqrt(Float4 x) -> Float4 { return {vdivq_f32(vdupq_n_f32(1.0f), vsqrtq_f32(x.v))}; }
+#else
+        std::array<float, 4> v;
+
+        static auto set1(float x) -> Float4 { return {{x, x, x, x}}; }
+        static auto load(const float* p) -> Float4 { return {{p[0], p[1], p[2], p[3]}}; }
+        auto store(float* p) const -> void { std::copy(v.begin(), v.end(), p); }
+
+        template<typename Op>
+        static auto apply(Float4 a, Float4 b, Op op) -> Float4 {
+            return {{op(a.v[0], b.v[0]), op(a.v[1], b.v[1]), op(a.v[2], b.v[2]), op(a.v[3], b.v[3])}};
+        }
+        friend auto operator+(Float4 a, Float4 b) -> Float4 { return apply(a, b, [](float x, float y) { return x + y; }); }
+        friend auto operator-(Float4 a, Float4 b) -> Float4 { return apply(a, b, [](float x, float y) { return x - y; }); }
+        friend auto operator*(Float4 a, Float4 b) -> Float4 { return apply(a, b, [](float x, float y) { return x * y; }); }
+
+        static auto flip_sign(Float4 x, Float4 sign) -> Float4 {
+            return apply(x, sign, [](float value, float s) { return std::signbit(s) ? -value : value; });
+        }
+        static auto inverse_sqrt(Float4 x) -> Float4 {
+            return {{1.0f / std::sqrt(x.v[0]), 1.0f / std::sqrt(x.v[1]), 1.0f / std::sqrt(x.v[2]), 1.0f / std::sqrt(x.v[3])}};
+        }
+#endif
+
+        static auto lerp(Float4 a, Float4 b, Float4 t) -> Float4 { return a + (b - a) * t; }
+    };
+
+    using ConstStreams4 = std::array<const float*, 4>;
+    using Streams4 = std::array<float*, 4>;
+
+    /**
+     * out[i] = lerp(a[i], b[i], weight(i)) for i in [0, count), count a multiple of four
+     * `weight` maps a lane offset to the four lanes' weights. out may alias a or b.
+     */
+    template<typename Weight>
+    auto lerp_stream(const float* a, const float* b, Weight&& weight, float* out, uint32_t count) -> void {
+        for (uint32_t i = 0; i < count; i += 4) {
+            Float4::lerp(Float4::load(a + i), Float4::load(b + i), weight(i)).store(out + i);
+        }
+    }
+
+    /**
+     * Normalized lerp of quaternion streams (x, y, z, w) along the shorter arc
+     */
+    template<typename Weight>
+    auto nlerp_streams(const ConstStreams4& a, const ConstStreams4& b, Weight&& weight, const Streams4& out,
+                       uint32_t count) -> void {
+        for (uint32_t i = 0; i < count; i += 4) {
+            std::array<Float4, 4> qa;
+            std::array<Float4, 4> qb;
+            for (size_t c = 0; c < 4; ++c) {
+                qa[c] = Float4::load(a[c] + i);
+                qb[c] = Float4::load(b[c] + i);
+            }
+            const Float4 dot = qa[0] * qb[0] + qa[1] * qb[1] + qa[2] * qb[2] + qa[3] * qb[3];
+            const Float4 t = weight(i);
+
+            std::array<Float4, 4> q;
+            for (size_t c = 0; c < 4; ++c) {
+                q[c] = Float4::lerp(qa[c], Float4::flip_sign(qb[c], dot), t);
+            }
+            const Float4 scale = Float4::inverse_sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+            for (size_t c = 0; c < 4; ++c) {
+                (q[c] * scale).store(out[c] + i);
+            }
+        }
+    }
+} // namespace klingon::simd
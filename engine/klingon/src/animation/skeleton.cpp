@@ -0,0 +1,63 @@
+#include "klingon/animation/skeleton.hpp"
+#include "pose_simd.hpp"
+
+namespace klingon {
+    auto multiply(const SkinMatrix& a, const SkinMatrix& b) -> SkinMatrix {
+        using simd::Float4;
+        const Float4 b0 = Float4::load(&b.rows[0].x);
+        const Float4 b1 = Float4::load(&b.rows[1].x);
+        const Float4 b2 = Float4::load(&b.rows[2].x);
+
+        SkinMatrix result;
+        for (size_t r = 0; r < 3; ++r) {
+            const glm::vec4& row = a.rows[r];
+            const Float4 sum = b0 * Float4::set1(row.x) + b1 * Float4::set1(row.y) + b2 * Float4::set1(row.z);
+            sum.store(&result.rows[r].x);
+            result.rows[r].w += row.w;
+        }
+        return result;
+    }
+
+    auto to_mat4(const SkinMatrix& matrix) -> glm::mat4 {
+        glm::mat4 result(1.0f);
+        for (int row = 0; row < 3; ++row) {
+            for (int column = 0; column < 4; ++column) {
+                result[column][row] = matrix.rows[row][column];
+            }
+        }
+        return result;
+    }
+
+    auto to_skin_matrix(const glm::mat4& matrix) -> SkinMatrix {
+        SkinMatrix result;
+        for (int row = 0; row < 3; ++row) {
+            for (int column = 0; column < 4; ++column) {
+                result.rows[row][column] = matrix[column][row];
+            }
+        }
+        return result;
+    }
+
+    auto Skeleton::find_joint(std::string_view name) const -> std::optional<uint16_t> {
+        for (size_t i = 0; i < joint_names.size(); ++i) {
+            if (joint_names[i] == name) {
+                return static_cast<uint16_t>(i);
+            }
+        }
+        return std::nullopt;
+    }
+
+    auto Skeleton::is_valid() const -> bool {
+        const size_t count = parents.size();
+        if (count > MAX_JOINTS || joint_names.size() != count || inverse_bind.size() != count ||
+            rest_pose.size() != count) {
+            return false;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            if (parents[i] != NO_PARENT_JOINT && parents[i] >= i) {
+                return false;
+            }
+        }
+        return true;
+    }
+} // namespace klingon
@@ -0,0 +1,59 @@
+#include "klingon/animation/skinning.hpp"
+#include "pose_simd.hpp"
+
+#include <cassert>
+#include <cmath>
+
+namespace klingon {
+    auto skin_vertices(std::span<const Vertex> vertices, std::span<const VertexSkin> skins,
+                       std::span<const SkinMatrix> palette, std::span<Vertex> output) -> void {
+        using simd::Float4;
+        assert(skins.size() == vertices.size() && output.size() == vertices.size());
+
+        constexpr float WEIGHT_SCALE = 1.0f / 65535.0f;
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            const Vertex& vertex = vertices[i];
+            const VertexSkin& skin = skins[i];
+            if (skin.weights[0] == 0) {
+                // No influences (the strongest weight comes first): the vertex stays in its bind pose
+                output[i] = vertex;
+                continue;
+            }
+
+            // Weighted sum of the influencing palette matrices, one row per Float4
+            Float4 rows[3] = {Float4::set1(0.0f), Float4::set1(0.0f), Float4::set1(0.0f)};
+            for (size_t influence = 0; influence < 4; ++influence) {
+                const uint16_t weight = skin.weights[influence];
+                if (weight == 0 || skin.joints[influence] >= palette.size()) {
+                    continue;
+                }
+                const SkinMatrix& joint = palette[skin.joints[influence]];
+                const Float4 scale = Float4::set1(static_cast<float>(weight) * WEIGHT_SCALE);
+                for (size_t row = 0; row < 3; ++row) {
+                    rows[row] = rows[row] + Float4::load(&joint.rows[row].x) * scale;
+                }
+            }
+
+            float matrix[3][4];
+            for (size_t row = 0; row < 3; ++row) {
+                rows[row].store(matrix[row]);
+            }
+
+            Vertex& skinned = output[i];
+            skinned = vertex;
+            const glm::vec3& p = vertex.position;
+            const glm::vec3& n = vertex.normal;
+            for (int row = 0; row < 3; ++row) {
+                const float* m = matrix[row];
+                skinned.position[row] = m[0] * p.x + m[1] * p.y + m[2] * p.z + m[3];
+                skinned.normal[row] = m[0] * n.x + m[1] * n.y + m[2] * n.z;
+            }
+
+            // Matches the shader: non-uniform scale is rare in rigs, so no inverse transpose
+            const float length = std::sqrt(glm::dot(skinned.normal, skinned.normal));
+            if (length > 0.0f) {
+                skinned.normal = skinned.normal / length;
+            }
+        }
+    }
+} // namespace klingon
@@ -4,12 +4,18 @@
 #include "federation/core.hpp"
 #include "federation/log.hpp"
 #include "federation/config_manager.hpp"
+#include "federation/storage/cook_manifest.hpp"
+#include "federation/storage/virtual_file_system.hpp"
 #include "borg/window.hpp"
 #include "borg/input.hpp"
 
 #include <GLFW/glfw3.h>
 #include <imgui_impl_glfw.h>
 
+#include <chrono>
+#include <optional>
+#include <ranges>
+
 namespace klingon {
     // KlingonConfig constructor
     Engine::Engine(const KlingonConfig& config)
@@ -20,6 +26,35 @@ namespace klingon {
         m_core = std::make_unique<federation::Core>();
         m_core->initialize();
 
+        // Mount packs before anything loads shaders or textures
+        auto& vfs = federation::VirtualFileSystem::get();
+        for (const auto& pack : config.assets.packs) {
+            if (auto mounted = vfs.mount_pack(pack); !mounted) {
+                FED_ERROR("Failed to mount pack: {}", mounted.error());
+            }
+        }
+        vfs.set_native_fallback(config.assets.native_fallback);
+
+        // Cooked assets replace their sources only while the manifest says they're fresh
+        if (!config.assets.cook_manifest.empty() && vfs.exists(config.assets.cook_manifest)) {
+            if (auto manifest = federation::CookManifest::load(config.assets.cook_manifest)) {
+                uint32_t stale = 0;
+                for (const auto& record : manifest->get_records() | std::views::values) {
+                    if (!manifest->is_fresh(record)) {
+                        ++stale;
+                        FED_DEBUG("Cooked asset is stale: {}", record.output);
+                    }
+                }
+                FED_INFO("Cook manifest: {} assets, {} stale", manifest->get_records().size(), stale);
+                if (stale > 0) {
+                    FED_WARN("{} cooked assets are out of date and load from source; run `cooker build`", stale);
+                }
+                vfs.set_cook_manifest(std::make_shared<const federation::CookManifest>(std::move(*manifest)));
+            } else {
+                FED_WARN("Ignoring cook manifest: {}", manifest.error());
+            }
+        }
+
         // Create window from config
         borg::Window::Config window_config{};
         window_config.title = config.application.name;
@@ -31,10 +66,28 @@ namespace klingon {
 
         // Create input handler (must be after window)
         m_input = std::make_unique<borg::Input>(*m_window);
+        if (!config.input.playback_path.empty()) {
+            if (!m_input->start_playback(config.input.playback_path)) {
+                throw std::runtime_error("Failed to load input recording: " + config.input.playback_path);
+            }
+        } else if (!config.input.record_path.empty()) {
+            if (!m_input->start_recording(config.input.record_path)) {
+                throw std::runtime_error("Failed to create input recording: " + config.input.record_path);
+            }
+        }
 
         // Create renderer from config
         m_renderer = std::make_unique<Renderer>(config, *m_window);
 
+        // Animators update on their own worker pool between game logic and rendering
+        AnimationSystem::Config animation_config{};
+        animation_config.threads = config.animation.threads;
+        m_animation_system = std::make_unique<AnimationSystem>(animation_config);
+
+        if (config.renderer.performance.threaded_rendering) {
+            m_render_thread = std::make_unique<RenderThread>(*m_renderer);
+        }
+
         // Wire up ImGui input callbacks if enabled
         if (config.renderer.debug.enable_imgui) {
             m_input->set_pre_key_callback(ImGui_ImplGlfw_KeyCallback);
@@ -79,14 +132,41 @@ namespace klingon {
         m_running = true;
         m_last_frame_time = static_cast<float>(::glfwGetTime());
 
+        // Latency modes poll input from the rendering thread, so they need rendering on this one
+        const auto &latency = m_config.renderer.latency;
+        const bool low_latency = !m_render_thread;
+        if (!low_latency && (latency.late_latch_camera || latency.limit_frame_latency)) {
+            FED_WARN("Late latching and the frame latency limiter are ignored with threaded rendering");
+        }
+        if (low_latency && latency.late_latch_camera) {
+            m_renderer->set_late_latch_callback([this]() -> std::optional<Transform> {
+                // Mouse look is applied to the camera transform by the subscribers the events dispatch to
+                m_window->poll_events();
+                m_input->dispatch_events();
+                if (!m_active_scene) return std::nullopt;
+                return m_active_scene->get_camera_transform();
+            });
+        }
+
         while (m_running && !m_window->should_close()) {
+            // Sample input only once the GPU has caught up, so it isn't queued behind a frame
+            if (low_latency && latency.limit_frame_latency) {
+                m_renderer->wait_for_previous_frame();
+            }
+
             // Calculate delta time
             float current_time = static_cast<float>(::glfwGetTime());
             float delta_time = current_time - m_last_frame_time;
             m_last_frame_time = current_time;
 
-            // Poll window events
+            // Poll window events, then hand this frame's input to subscribers in one batch
             m_window->poll_events();
+            m_renderer->set_input_time(std::chrono::steady_clock::now());
+            delta_time = m_input->begin_frame(delta_time);
+            if (m_input->is_playback_finished()) {
+                FED_INFO("Input playback finished after {} frames", m_input->get_frame());
+                break;
+            }
 
             // Update callback (game logic)
             if (m_update_callback) {
@@ -95,11 +175,33 @@ namespace klingon {
 
             // Render scene (handles everything: camera updates, UBO, render graph execution, ImGui)
             if (m_active_scene) {
-                m_renderer->render_scene(m_active_scene, delta_time);
+                // Poses follow game logic so this frame's palettes reflect it
+                m_animation_system->update(m_active_scene->get_game_objects(), delta_time);
+
+                if (m_render_thread) {
+                    // The previous frame may still be recording: extraction only reads the scene and
+                    // sets the back snapshot's old model references aside instead of dropping them
+                    auto &snapshot = m_snapshots[m_back_snapshot];
+                    m_renderer->prepare_snapshot(*m_active_scene, delta_time, snapshot);
+
+                    // Sync point: nothing renders until the next submit, so destroying models is safe
+                    m_render_thread->wait_idle();
+                    snapshot.release_retired();
+                    m_renderer->recreate_swapchain_if_needed();
+                    m_renderer->build_imgui_frame();
+                    m_render_thread->submit(snapshot);
+                    m_back_snapshot ^= 1;
+                } else {
+                    m_renderer->render_scene(m_active_scene, delta_time);
+                }
             }
         }
 
         // Wait for all rendering to complete before cleanup
+        if (m_render_thread) {
+            m_render_thread->wait_idle();
+        }
+        m_renderer->set_late_latch_callback(nullptr);
         m_renderer->wait_idle();
         FED_INFO("Main loop ended");
     }
@@ -111,10 +213,15 @@ namespace klingon {
         }
 
         // Cleanup in reverse order of initialization
+        m_render_thread.reset();
         if (m_renderer) {
             m_renderer->wait_idle();
         }
+        for (auto &snapshot: m_snapshots) {
+            snapshot.clear();
+        }
 
+        m_animation_system.reset();
         m_renderer.reset();
         m_input.reset();
         m_window.reset();
@@ -1,9 +1,18 @@
 #include "klingon/game_object.hpp"
 
+#include <atomic>
+
 namespace klingon {
+    namespace {
+        std::atomic<GameObject::id_t> next_id{0};
+    }
+
     auto GameObject::create_game_object() -> GameObject {
-        static id_t current_id = 0;
-        return GameObject{current_id++};
+        return GameObject{next_id.fetch_add(1, std::memory_order_relaxed)};
+    }
+
+    auto GameObject::reserve_ids(uint32_t count) -> id_t {
+        return next_id.fetch_add(count, std::memory_order_relaxed);
     }
 
     auto GameObject::create_point_light(float intensity, float radius, glm::vec3 color) -> GameObject {
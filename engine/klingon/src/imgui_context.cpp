@@ -124,19 +124,20 @@ namespace klingon {
     auto ImGuiContext::end_frame() -> void {
         // Finalize ImGui frame and generate draw data
         ::ImGui::Render();
-    }
-
-    auto ImGuiContext::render(VkCommandBuffer command_buffer) -> void {
-        // Draw data should already be ready from end_frame()
-        ImGui_ImplVulkan_RenderDrawData(::ImGui::GetDrawData(), command_buffer);
 
         // Update and render additional platform windows (if multi-viewport is enabled)
+        // They are GLFW windows with their own submits, so this stays on the main thread
         if (::ImGui::GetIO().ConfigFlags & ImGuiConfigFlags_ViewportsEnable) {
             ::ImGui::UpdatePlatformWindows();
             ::ImGui::RenderPlatformWindowsDefault();
         }
     }
 
+    auto ImGuiContext::render(VkCommandBuffer command_buffer) -> void {
+        // Draw data should already be ready from end_frame()
+        ImGui_ImplVulkan_RenderDrawData(::ImGui::GetDrawData(), command_buffer);
+    }
+
     auto ImGuiContext::on_resize(std::uint32_t width, std::uint32_t height) -> void {
         (void) width;
         (void) height;
@@ -0,0 +1,233 @@
+#include "klingon/material_buffer.hpp"
+#include "batleth/barrier_batcher.hpp"
+#include "federation/log.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace klingon {
+
+namespace {
+    auto hash_material(const MaterialGPU& material) -> uint64_t {
+        uint64_t hash = 0xcbf29ce484222325ULL; // FNV-1a offset basis
+        const uint64_t prime = 0x100000001b3ULL; // FNV-1a prime
+        const auto* bytes = reinterpret_cast<const uint8_t*>(&material);
+        for (size_t i = 0; i < sizeof(MaterialGPU); ++i) {
+            hash ^= bytes[i];
+            hash *= prime;
+        }
+        return hash;
+    }
+
+    auto same_material(const MaterialGPU& a, const MaterialGPU& b) -> bool {
+        return std::memcmp(&a, &b, sizeof(MaterialGPU)) == 0;
+    }
+} // anonymous namespace
+
+MaterialBuffer::MaterialBuffer(const Config& config)
+    : m_device(config.device)
+    , m_max_materials(config.max_materials)
+    , m_frames_in_flight(std::max(config.frames_in_flight, 1u)) {
+
+    FED_TRACE("Creating material buffer ({} materials, {} bytes)",
+              m_max_materials, m_max_materials * sizeof(MaterialGPU));
+
+    m_gpu_buffer = std::make_unique<batleth::Buffer>(
+        m_device,
+        sizeof(MaterialGPU),
+        m_max_materials,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+    );
+
+    // A frame can dirty every record at most once, so one max-size slice per frame never overflows
+    m_staging_ring = std::make_unique<batleth::Buffer>(
+        m_device,
+        sizeof(MaterialGPU),
+        m_max_materials * m_frames_in_flight,
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+    );
+    if (m_staging_ring->map() != VK_SUCCESS) {
+        FED_FATAL("Failed to map material staging ring");
+        throw std::runtime_error("Failed to map material staging ring");
+    }
+
+    m_materials.reserve(m_max_materials);
+    m_records.reserve(m_max_materials);
+    m_is_dirty.resize(m_max_materials, false);
+}
+
+auto MaterialBuffer::acquire(const MaterialGPU& material) -> std::optional<uint32_t> {
+    const uint64_t hash = hash_material(material);
+
+    auto it = m_lookup.find(hash);
+    if (it != m_lookup.end() && same_material(m_materials[it->second], material)) {
+        ++m_records[it->second].ref_count;
+        ++m_reference_count;
+        return it->second;
+    }
+
+    auto index = allocate();
+    if (!index) {
+        FED_ERROR("Material buffer full (max: {})", m_max_materials);
+        return std::nullopt;
+    }
+
+    m_materials[*index] = material;
+    auto& record = m_records[*index];
+    record.hash = hash;
+    record.ref_count = 1;
+    // On a hash collision the newcomer just isn't shareable
+    record.indexed = m_lookup.emplace(hash, *index).second;
+
+    ++m_live_count;
+    ++m_reference_count;
+    mark_dirty(*index);
+    return index;
+}
+
+auto MaterialBuffer::release(uint32_t index) -> void {
+    if (!is_live(index)) {
+        FED_WARN("Releasing material {} that isn't in use", index);
+        return;
+    }
+
+    --m_reference_count;
+    auto& record = m_records[index];
+    if (--record.ref_count > 0) {
+        return;
+    }
+
+    // In-flight frames may still read the old bytes, but the next writer's copy is ordered
+    // after them by the barrier in flush(), so the slot can be handed out straight away
+    unindex(index);
+    m_free_slots.push_back(index);
+    --m_live_count;
+}
+
+auto MaterialBuffer::update(uint32_t index, const MaterialGPU& material) -> uint32_t {
+    if (!is_live(index)) {
+        FED_ERROR("Invalid material index: {}", index);
+        return index;
+    }
+
+    if (same_material(m_materials[index], material)) {
+        return index;
+    }
+
+    auto& record = m_records[index];
+    if (record.ref_count > 1) {
+        // Shared with other owners: leave theirs alone
+        auto split = acquire(material);
+        if (!split) {
+            return index;
+        }
+        release(index);
+        return *split;
+    }
+
+    unindex(index);
+    m_materials[index] = material;
+    record.hash = hash_material(material);
+    record.indexed = m_lookup.emplace(record.hash, index).second;
+    mark_dirty(index);
+    return index;
+}
+
+auto MaterialBuffer::flush(VkCommandBuffer cmd, uint32_t frame_index) -> void {
+    if (m_dirty.empty()) {
+        return;
+    }
+
+    std::sort(m_dirty.begin(), m_dirty.end());
+
+    const VkDeviceSize slice_offset =
+        static_cast<VkDeviceSize>(frame_index % m_frames_in_flight) * m_max_materials * sizeof(MaterialGPU);
+    auto* staging = static_cast<uint8_t*>(m_staging_ring->get_mapped_memory()) + slice_offset;
+
+    // Dirty records are packed back to back; each contiguous run of indices becomes one copy
+    std::vector<VkBufferCopy> regions;
+    for (size_t i = 0; i < m_dirty.size(); ++i) {
+        const uint32_t index = m_dirty[i];
+        std::memcpy(staging + i * sizeof(MaterialGPU), &m_materials[index], sizeof(MaterialGPU));
+        m_is_dirty[index] = false;
+
+        if (i > 0 && index == m_dirty[i - 1] + 1) {
+            regions.back().size += sizeof(MaterialGPU);
+        } else {
+            VkBufferCopy region{};
+            region.srcOffset = slice_offset + i * sizeof(MaterialGPU);
+            region.dstOffset = static_cast<VkDeviceSize>(index) * sizeof(MaterialGPU);
+            region.size = sizeof(MaterialGPU);
+            regions.push_back(region);
+        }
+    }
+
+    const batleth::ResourceState shader_read{
+        .stage_mask = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+        .access_mask = VK_ACCESS_2_SHADER_READ_BIT
+    };
+    const batleth::ResourceState transfer_write{
+        .stage_mask = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+        .access_mask = VK_ACCESS_2_TRANSFER_WRITE_BIT
+    };
+
+    // Earlier frames may still be reading the buffer
+    batleth::BarrierBatcher to_transfer;
+    to_transfer.add_buffer_barrier(m_gpu_buffer->get_buffer(), shader_read, transfer_write);
+    to_transfer.flush(cmd);
+
+    ::vkCmdCopyBuffer(cmd, m_staging_ring->get_buffer(), m_gpu_buffer->get_buffer(),
+                      static_cast<uint32_t>(regions.size()), regions.data());
+
+    batleth::BarrierBatcher to_shader;
+    to_shader.add_buffer_barrier(m_gpu_buffer->get_buffer(), transfer_write, shader_read);
+    to_shader.flush(cmd);
+
+    m_flushed_bytes += m_dirty.size() * sizeof(MaterialGPU);
+    FED_TRACE("Flushed {} materials in {} copies", m_dirty.size(), regions.size());
+    m_dirty.clear();
+}
+
+auto MaterialBuffer::get_stats() const -> Stats {
+    Stats stats{};
+    stats.live_materials = m_live_count;
+    stats.capacity = m_max_materials;
+    stats.references = m_reference_count;
+    stats.dirty_materials = static_cast<uint32_t>(m_dirty.size());
+    stats.flushed_bytes = m_flushed_bytes;
+    return stats;
+}
+
+auto MaterialBuffer::allocate() -> std::optional<uint32_t> {
+    if (!m_free_slots.empty()) {
+        const uint32_t index = m_free_slots.back();
+        m_free_slots.pop_back();
+        return index;
+    }
+    if (m_materials.size() >= m_max_materials) {
+        return std::nullopt;
+    }
+    m_materials.emplace_back();
+    m_records.emplace_back();
+    return static_cast<uint32_t>(m_materials.size() - 1);
+}
+
+auto MaterialBuffer::unindex(uint32_t index) -> void {
+    auto& record = m_records[index];
+    if (record.indexed) {
+        m_lookup.erase(record.hash);
+        record.indexed = false;
+    }
+}
+
+auto MaterialBuffer::mark_dirty(uint32_t index) -> void {
+    if (!m_is_dirty[index]) {
+        m_is_dirty[index] = true;
+        m_dirty.push_back(index);
+    }
+}
+
+} // namespace klingon
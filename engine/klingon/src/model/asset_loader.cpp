@@ -3,45 +3,281 @@
 //
 
 
-#define GLM_ENABLE_EXPERIMENTAL
 #include "klingon/model/asset_loader.hpp"
 
-#include <glm/gtx/hash.hpp>
-
 #include "assimp/Importer.hpp"
+#include "assimp/IOStream.hpp"
+#include "assimp/IOSystem.hpp"
 #include "assimp/postprocess.h"
 #include "assimp/scene.h"
 #include "federation/log.hpp"
+#include "federation/storage/virtual_file_system.hpp"
 #include "klingon/model/mesh.h"
+#include "klingon/model/vertex_welder.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
 #include <filesystem>
+#include <latch>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "assimp/DefaultLogger.hpp"
 
-namespace std {
-    template<>
-    struct hash<klingon::Vertex> {
-        size_t operator()(const klingon::Vertex &vertex) const noexcept {
-            size_t h1 = hash<glm::vec3>()(vertex.position);
-            size_t h2 = hash<glm::vec3>()(vertex.color);
-            size_t h3 = hash<glm::vec3>()(vertex.normal);
-            size_t h4 = hash<glm::vec2>()(vertex.uv);
-
-            // Combine hashes
-            size_t seed = 0;
-            seed ^= h1 + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-            seed ^= h2 + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-            seed ^= h3 + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-            seed ^= h4 + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-            return seed;
-        }
-    };
-}
-
 namespace klingon {
+    namespace {
+        /**
+         * Read-only Assimp stream over a file read through the VFS
+         */
+        class VfsIOStream final : public Assimp::IOStream {
+        public:
+            explicit VfsIOStream(federation::FileData data)
+                : m_data(std::move(data)) {
+            }
+
+            auto Read(void* buffer, size_t size, size_t count) -> size_t override {
+                if (size == 0) {
+                    return 0;
+                }
+                const size_t available = (m_data.get_size() - m_position) / size;
+                const size_t items = std::min(count, available);
+                std::memcpy(buffer, m_data.get_data().data() + m_position, items * size);
+                m_position += items * size;
+                return items;
+            }
+
+            auto Write(const void*, size_t, size_t) -> size_t override { return 0; }
+
+            auto Seek(size_t offset, aiOrigin origin) -> aiReturn override {
+                size_t target = offset;
+                if (origin == aiOrigin_CUR) {
+                    target = m_position + offset;
+                } else if (origin == aiOrigin_END) {
+                    target = m_data.get_size() - offset;
+                }
+                if (target > m_data.get_size()) {
+                    return aiReturn_FAILURE;
+                }
+                m_position = target;
+                return aiReturn_SUCCESS;
+            }
+
+            [[nodiscard]] auto Tell() const -> size_t override { return m_position; }
+            [[nodiscard]] auto FileSize() const -> size_t override { return m_data.get_size(); }
+            auto Flush() -> void override {}
+
+        private:
+            federation::FileData m_data;
+            size_t m_position = 0;
+        };
+
+        /**
+         * Lets Assimp open models and their side files (.mtl, .bin) from mounted packs
+         */
+        class VfsIOSystem final : public Assimp::IOSystem {
+        public:
+            /**
+             * @param opened When set, receives the path of every file the importer reads
+             */
+            explicit VfsIOSystem(std::vector<std::string>* opened = nullptr)
+                : m_opened(opened) {
+            }
+
+            auto Exists(const char* path) const -> bool override {
+                return federation::VirtualFileSystem::get().exists(path);
+            }
+
+            auto getOsSeparator() const -> char override { return '/'; }
+
+            auto Open(const char* path, const char* mode) -> Assimp::IOStream* override {
+                if (std::strpbrk(mode, "wa+")) {
+                    return nullptr;
+                }
+                auto data = federation::VirtualFileSystem::get().read(path);
+                if (!data) {
+                    return nullptr;
+                }
+                if (m_opened) {
+                    m_opened->push_back(federation::VirtualFileSystem::normalize_path(path));
+                }
+                return new VfsIOStream(std::move(*data));
+            }
+
+            auto Close(Assimp::IOStream* stream) -> void override {
+                delete stream;
+            }
+
+        private:
+            std::vector<std::string>* m_opened;
+        };
+
+        /**
+         * Run fn(i) for i in [0, count) across the hardware threads (the caller is one of them)
+         */
+        template<typename Fn>
+        auto parallel_for(uint32_t count, Fn&& fn) -> void {
+            const uint32_t threads = std::min(std::max(std::thread::hardware_concurrency(), 1u), count);
+            if (threads <= 1) {
+                for (uint32_t i = 0; i < count; ++i) {
+                    fn(i);
+                }
+                return;
+            }
+
+            std::atomic<uint32_t> next{0};
+            auto worker = [&] {
+                for (uint32_t i = next++; i < count; i = next++) {
+                    fn(i);
+                }
+            };
+
+            std::vector<std::jthread> pool;
+            pool.reserve(threads - 1);
+            for (uint32_t i = 0; i + 1 < threads; ++i) {
+                pool.emplace_back(worker);
+            }
+            worker();
+        }
+
+        auto from_assimp(const aiMatrix4x4& m) -> SkinMatrix {
+            SkinMatrix matrix;
+            matrix.rows[0] = {m.a1, m.a2, m.a3, m.a4};
+            matrix.rows[1] = {m.b1, m.b2, m.b3, m.b4};
+            matrix.rows[2] = {m.c1, m.c2, m.c3, m.c4};
+            return matrix;
+        }
+
+        auto from_assimp(const aiQuaternion& q) -> glm::quat {
+            glm::quat rotation;
+            rotation.w = q.w;
+            rotation.x = q.x;
+            rotation.y = q.y;
+            rotation.z = q.z;
+            return rotation;
+        }
+
+        struct JointSources {
+            std::unordered_map<std::string, const aiBone*> bones;      // Any one mesh's bone of that name
+            std::unordered_set<const aiNode*> used;                     // Nodes that become joints
+        };
+
+        /**
+         * Mark the nodes that are, or are ancestors of, a bone or an animated node
+         */
+        auto mark_joints(const aiNode* node, const std::unordered_set<std::string>& wanted, JointSources& sources) -> bool {
+            bool used = wanted.contains(node->mName.C_Str());
+            for (uint32_t i = 0; i < node->mNumChildren; ++i) {
+                used |= mark_joints(node->mChildren[i], wanted, sources);
+            }
+            if (used) {
+                sources.used.insert(node);
+            }
+            return used;
+        }
+
+        /**
+         * Append marked nodes in pre-order, which puts every parent before its children
+         */
+        auto add_joints(const aiNode* node, uint16_t parent, const aiMatrix4x4& parent_global,
+                        const JointSources& sources, Skeleton& skeleton) -> void {
+            if (!sources.used.contains(node)) {
+                return;
+            }
+            if (skeleton.get_joint_count() >= MAX_JOINTS) {
+                FED_WARN("Skeleton exceeds {} joints, dropping {}", MAX_JOINTS, node->mName.C_Str());
+                return;
+            }
+
+            const auto index = static_cast<uint16_t>(skeleton.get_joint_count());
+            const aiMatrix4x4 global = parent_global * node->mTransformation;
+
+            aiVector3D position, scaling;
+            aiQuaternion rotation;
+            node->mTransformation.Decompose(scaling, rotation, position);
+            skeleton.joint_names.emplace_back(node->mName.C_Str());
+            skeleton.parents.push_back(parent);
+            skeleton.rest_pose.push_back({
+                .translation = {position.x, position.y, position.z},
+                .rotation = from_assimp(rotation),
+                .scale = {scaling.x, scaling.y, scaling.z}
+            });
+
+            // Joints no vertex is bound to get the inverse of their rest transform, so they skin to identity at rest
+            if (auto bone = sources.bones.find(node->mName.C_Str()); bone != sources.bones.end()) {
+                skeleton.inverse_bind.push_back(from_assimp(bone->second->mOffsetMatrix));
+            } else {
+                aiMatrix4x4 inverse = global;
+                skeleton.inverse_bind.push_back(from_assimp(inverse.Inverse()));
+            }
+
+            for (uint32_t i = 0; i < node->mNumChildren; ++i) {
+                add_joints(node->mChildren[i], index, global, sources, skeleton);
+            }
+        }
+
+        /**
+         * The four strongest influences on each source vertex, quantized to sum to 65535
+         */
+        auto gather_influences(const aiMesh* mesh, const Skeleton& skeleton) -> std::vector<VertexSkin> {
+            struct Influence {
+                uint16_t joint = 0;
+                float weight = 0.0f;
+            };
+            std::vector<std::array<Influence, 4>> strongest(mesh->mNumVertices);
+            for (uint32_t bone_idx = 0; bone_idx < mesh->mNumBones; ++bone_idx) {
+                const aiBone* bone = mesh->mBones[bone_idx];
+                const auto joint = skeleton.find_joint(bone->mName.C_Str());
+                if (!joint) {
+                    continue;
+                }
+                for (uint32_t i = 0; i < bone->mNumWeights; ++i) {
+                    const aiVertexWeight& weight = bone->mWeights[i];
+                    if (weight.mVertexId >= mesh->mNumVertices) {
+                        continue;
+                    }
+                    auto weakest = std::ranges::min_element(strongest[weight.mVertexId], {}, &Influence::weight);
+                    if (weight.mWeight > weakest->weight) {
+                        *weakest = {*joint, weight.mWeight};
+                    }
+                }
+            }
+
+            std::vector<VertexSkin> skins(mesh->mNumVertices);
+            for (uint32_t vertex = 0; vertex < mesh->mNumVertices; ++vertex) {
+                auto& influences = strongest[vertex];
+                float total = 0.0f;
+                for (const auto& influence : influences) {
+                    total += influence.weight;
+                }
+                if (total <= 0.0f) {
+                    continue;
+                }
+
+                // Rounding error goes to the strongest influence so the weights always sum to one
+                std::ranges::sort(influences, std::ranges::greater{}, &Influence::weight);
+                VertexSkin& skin = skins[vertex];
+                uint32_t remaining = 65535;
+                for (size_t i = 1; i < influences.size(); ++i) {
+                    const auto quantized = static_cast<uint32_t>(std::lround(influences[i].weight / total * 65535.0f));
+                    skin.joints[i] = influences[i].joint;
+                    skin.weights[i] = static_cast<uint16_t>(std::min(quantized, remaining));
+                    remaining -= skin.weights[i];
+                }
+                skin.joints[0] = influences[0].joint;
+                skin.weights[0] = static_cast<uint16_t>(remaining);
+            }
+            return skins;
+        }
+    } // anonymous namespace
+
     auto AssetLoader::load_mesh_from_obj(const std::string &filepath) -> MeshData {
         MeshData data{};
 
         Assimp::Importer importer;
+        importer.SetIOHandler(new VfsIOSystem());
         const auto scene = importer.ReadFile(filepath,
                                              ::aiProcess_Triangulate |
                                              ::aiProcess_JoinIdenticalVertices |
@@ -61,7 +297,16 @@ namespace klingon {
             return data;
         }
 
-        std::unordered_map<Vertex, uint32_t> unique_verts{};
+        // Assimp's own vertex count bounds the unique vertices, so the table never rehashes
+        VertexWelder welder;
+        size_t vertex_bound = 0;
+        size_t index_count = 0;
+        for (uint32_t meshIndex = 0; meshIndex < scene->mNumMeshes; ++meshIndex) {
+            vertex_bound += scene->mMeshes[meshIndex]->mNumVertices;
+            index_count += static_cast<size_t>(scene->mMeshes[meshIndex]->mNumFaces) * 3;
+        }
+        welder.reserve(vertex_bound);
+        data.indices.reserve(index_count);
 
         for (uint32_t meshIndex = 0; meshIndex < scene->mNumMeshes; ++meshIndex) {
             const auto mesh = scene->mMeshes[meshIndex];
@@ -101,15 +346,11 @@ namespace klingon {
                         };
                     }
 
-                    if (!unique_verts.contains(vertex)) {
-                        unique_verts[vertex] =
-                                static_cast<uint32_t>(data.vertices.size());
-                        data.vertices.push_back(vertex);
-                    }
-                    data.indices.push_back(unique_verts[vertex]);
+                    data.indices.push_back(welder.insert(vertex));
                 }
             }
         }
+        data.vertices = welder.take_vertices();
 
         FED_DEBUG("Loaded mesh from {}: {} vertices, {} indices", filepath, data.vertices.size(), data.indices.size());
 
@@ -121,8 +362,10 @@ namespace klingon {
     AssetLoader::AssetLoader(const Config& config)
         : m_device(config.device)
         , m_texture_manager(config.texture_manager)
-        , m_base_texture_path(config.base_texture_path) {
-        FED_INFO("AssetLoader initialized (base_texture_path: {})", m_base_texture_path);
+        , m_resources(config.resources)
+        , m_base_texture_path(config.base_texture_path)
+        , m_cook_models(config.cook_models) {
+        FED_INFO("AssetLoader initialized (base_texture_path: {}, cook_models: {})", m_base_texture_path, m_cook_models);
         Assimp::DefaultLogger::create("", Assimp::Logger::VERBOSE);
         auto* logger = Assimp::DefaultLogger::get();
         logger->attachStream(new AssetLoaderLogStream(Assimp::Logger::ErrorSeverity::Err), ::Assimp::Logger::Err);
@@ -133,9 +376,101 @@ namespace klingon {
 
     auto AssetLoader::load_model(const std::string& filepath) -> std::shared_ptr<ModelData> {
         FED_INFO("Loading model: {}", filepath);
+        const auto start = std::chrono::steady_clock::now();
+
+        const std::filesystem::path path(filepath);
+        std::shared_ptr<ModelData> model_data;
+        const char* source = "cooked";
+        if (path.extension() == ".kmesh") {
+            model_data = load_cooked_model(path, std::nullopt);
+        } else {
+            if (m_cook_models && federation::VirtualFileSystem::get().exists(get_cooked_path(path).generic_string())) {
+                model_data = load_cooked_model(get_cooked_path(path), path);
+            }
+            if (!model_data) {
+                model_data = import_and_cook(path);
+                source = "imported";
+            }
+        }
 
+        if (model_data) {
+            const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            FED_INFO("Successfully loaded model: {} ({} meshes, {} materials, {} nodes, {} in {:.1f} ms)",
+                     filepath, model_data->meshes.size(), model_data->materials.size(), model_data->nodes.size(),
+                     source, ms);
+        }
+
+        return model_data;
+    }
+
+    auto AssetLoader::load_models(std::span<const std::string> filepaths) -> std::vector<std::shared_ptr<ModelData>> {
+        FED_INFO("Loading {} models", filepaths.size());
+        const auto start = std::chrono::steady_clock::now();
+        auto& vfs = federation::VirtualFileSystem::get();
+
+        struct PendingModel {
+            std::filesystem::path cooked;                   // Empty when there is nothing cooked to read
+            std::optional<std::filesystem::path> source;
+            std::expected<federation::FileData, std::string> file = std::unexpected(std::string());
+        };
+
+        std::vector<PendingModel> pending(filepaths.size());
+        for (size_t i = 0; i < filepaths.size(); ++i) {
+            const std::filesystem::path path(filepaths[i]);
+            if (path.extension() == ".kmesh") {
+                pending[i].cooked = path;
+            } else if (m_cook_models && vfs.exists(get_cooked_path(path).generic_string())) {
+                pending[i].cooked = get_cooked_path(path);
+                pending[i].source = path;
+            }
+        }
+
+        // Every read is in flight at once; the queue depth, not this loop, bounds the I/O
+        const auto reads = std::ranges::count_if(pending, [](const PendingModel& model) { return !model.cooked.empty(); });
+        std::latch done(reads);
+        for (auto& model : pending) {
+            if (model.cooked.empty()) {
+                continue;
+            }
+            vfs.read_async(model.cooked.generic_string(), [&model, &done](auto file) {
+                model.file = std::move(file);
+                done.count_down();
+            });
+        }
+        done.wait();
+
+        // GPU resources are created here, on the calling thread, in request order
+        std::vector<std::shared_ptr<ModelData>> models(filepaths.size());
+        uint32_t cooked_count = 0;
+        for (size_t i = 0; i < filepaths.size(); ++i) {
+            auto& model = pending[i];
+            if (model.file) {
+                models[i] = create_cooked_model(model.cooked, *model.file, model.source);
+            }
+            if (models[i]) {
+                ++cooked_count;
+            } else {
+                models[i] = load_model(filepaths[i]);
+            }
+        }
+
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        FED_INFO("Loaded {} models ({} from cooked files) in {:.1f} ms", filepaths.size(), cooked_count, ms);
+        return models;
+    }
+
+    auto AssetLoader::get_cooked_path(const std::filesystem::path& source) -> std::filesystem::path {
+        auto cooked = source;
+        cooked += ".kmesh";
+        return cooked;
+    }
+
+    auto AssetLoader::import_model(const std::filesystem::path& path, std::vector<std::string>* dependencies,
+                                   const VertexWelder::Config& weld) -> std::unique_ptr<CookedModel> {
+        std::vector<std::string> opened;
         Assimp::Importer importer;
-        const aiScene* scene = importer.ReadFile(filepath,
+        importer.SetIOHandler(new VfsIOSystem(dependencies ? &opened : nullptr));
+        const aiScene* scene = importer.ReadFile(path.generic_string(),
             aiProcess_Triangulate |
             aiProcess_JoinIdenticalVertices |
             aiProcess_FlipUVs |
@@ -145,52 +480,130 @@ namespace klingon {
         );
 
         if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
-            FED_ERROR("Failed to load model: {} - {}", filepath, importer.GetErrorString());
+            FED_ERROR("Failed to load model: {} - {}", path.string(), importer.GetErrorString());
             return nullptr;
         }
 
-        std::filesystem::path path(filepath);
-        std::string model_dir = path.parent_path().string();
+        if (dependencies) {
+            const auto source = federation::VirtualFileSystem::normalize_path(path.generic_string());
+            for (auto& file : opened) {
+                if (file != source && std::ranges::find(*dependencies, file) == dependencies->end()) {
+                    dependencies->push_back(std::move(file));
+                }
+            }
+        }
+        return process_assimp_scene(scene, weld);
+    }
 
-        auto model_data = process_assimp_scene(scene, model_dir);
+    auto AssetLoader::import_and_cook(const std::filesystem::path& path) -> std::shared_ptr<ModelData> {
+        auto cooked = import_model(path);
+        if (!cooked) {
+            return nullptr;
+        }
 
-        if (model_data) {
-            FED_INFO("Successfully loaded model: {} ({} meshes, {} materials, {} nodes)",
-                     filepath, model_data->meshes.size(), model_data->materials.size(), model_data->nodes.size());
+        // Only loose sources get a cache next to them; packed sources are expected to ship cooked
+        const auto native_path = federation::VirtualFileSystem::get().get_native_path(path.generic_string());
+        if (m_cook_models && !native_path.empty()) {
+            const auto cooked_path = get_cooked_path(native_path);
+            if (auto stamp = KmeshSourceStamp::from_file(native_path)) {
+                if (auto written = write_kmesh(cooked_path, *cooked, *stamp); written) {
+                    FED_DEBUG("Cooked {} -> {}", path.string(), cooked_path.string());
+                } else {
+                    FED_WARN("Could not cache cooked model: {}", written.error());
+                }
+            }
         }
 
-        return model_data;
+        std::shared_ptr<AnimationSet> animation;
+        if (cooked->skeleton.get_joint_count() > 0) {
+            animation = std::make_shared<AnimationSet>();
+            animation->skeleton = std::move(cooked->skeleton);
+            animation->clips = std::move(cooked->clips);
+        }
+        return create_model(cooked->vertices, cooked->indices, cooked->meshes,
+                            std::move(cooked->materials), std::move(cooked->nodes), cooked->root_node_index,
+                            cooked->skins, std::move(animation));
     }
 
-    auto AssetLoader::process_assimp_scene(const aiScene* scene, const std::string& model_dir) -> std::shared_ptr<ModelData> {
-        auto model_data = std::make_shared<ModelData>();
+    auto AssetLoader::load_cooked_model(const std::filesystem::path& path, const std::optional<std::filesystem::path>& source)
+        -> std::shared_ptr<ModelData> {
+        auto file = federation::VirtualFileSystem::get().read(path.generic_string());
+        if (!file) {
+            FED_WARN("Failed to open cooked model: {}", file.error());
+            return nullptr;
+        }
+        return create_cooked_model(path, *file, source);
+    }
 
-        // Process materials first
-        FED_TRACE("Processing {} materials", scene->mNumMaterials);
-        for (uint32_t i = 0; i < scene->mNumMaterials; ++i) {
-            model_data->materials.push_back(process_material(scene->mMaterials[i], model_dir));
+    auto AssetLoader::create_cooked_model(const std::filesystem::path& path, const federation::FileData& file,
+                                          const std::optional<std::filesystem::path>& source)
+        -> std::shared_ptr<ModelData> {
+        auto& vfs = federation::VirtualFileSystem::get();
+        auto view = KmeshView::parse(file.get_data());
+        if (!view) {
+            FED_WARN("Ignoring cooked model {}: {}", path.string(), view.error());
+            return nullptr;
         }
 
-        // Add default material if none exist
-        if (model_data->materials.empty()) {
-            FED_WARN("No materials found, adding default material");
-            model_data->materials.emplace_back();
+        if (source) {
+            // Packed sources carry no timestamp; the cook shipped alongside them is taken as current
+            std::optional<KmeshSourceStamp> stamp;
+            if (auto info = vfs.stat(source->generic_string()); info && !info->packed) {
+                stamp = KmeshSourceStamp{info->size, info->mtime};
+            }
+            if (!is_kmesh_current(view->get_header(), stamp)) {
+                FED_DEBUG("Cooked model {} is stale", path.string());
+                return nullptr;
+            }
         }
 
-        // Process meshes and capture material indices
-        FED_TRACE("Processing {} meshes", scene->mNumMeshes);
-        for (uint32_t i = 0; i < scene->mNumMeshes; ++i) {
-            const aiMesh* assimp_mesh = scene->mMeshes[i];
-            MeshData mesh_data = process_mesh(assimp_mesh);
-            auto mesh = std::make_shared<Mesh>(m_device, mesh_data);
-            model_data->meshes.push_back(mesh);
-            // Store material index for this mesh
-            model_data->mesh_material_indices.push_back(assimp_mesh->mMaterialIndex);
+        // Vertex and index spans point into the file data, which stays alive until the meshes are uploaded
+        return create_model(view->get_vertices(), view->get_indices(), view->get_meshes(),
+                            view->decode_materials(), view->decode_nodes(), view->get_header().root_node,
+                            view->get_skins(), view->decode_animation());
+    }
+
+    auto AssetLoader::create_model(
+        std::span<const Vertex> vertices,
+        std::span<const uint32_t> indices,
+        std::span<const KmeshMesh> meshes,
+        std::vector<Material> materials,
+        std::vector<ModelNode> nodes,
+        uint32_t root_node_index,
+        std::span<const VertexSkin> skins,
+        std::shared_ptr<const AnimationSet> animation
+    ) -> std::shared_ptr<ModelData> {
+        auto model_data = std::make_shared<ModelData>();
+        model_data->resources = &m_resources;
+        model_data->textures = &m_texture_manager;
+
+        model_data->materials = std::move(materials);
+        for (auto& material : model_data->materials) {
+            load_material_textures(material);
         }
 
-        // Process node hierarchy
-        FED_TRACE("Processing node hierarchy");
-        model_data->root_node_index = process_node(scene, scene->mRootNode, *model_data, UINT32_MAX);
+        FED_TRACE("Creating {} meshes", meshes.size());
+        model_data->meshes.reserve(meshes.size());
+        model_data->mesh_material_indices.reserve(meshes.size());
+        for (const auto& mesh : meshes) {
+            // Meshes without bones in a skinned model carry all-zero influences and stay static
+            auto mesh_skins = skins.empty() ? skins : skins.subspan(mesh.vertex_offset, mesh.vertex_count);
+            if (!std::ranges::any_of(mesh_skins, [](const VertexSkin& skin) { return skin.weights[0] != 0; })) {
+                mesh_skins = {};
+            }
+            model_data->meshes.push_back(m_resources.create_mesh(
+                m_device,
+                vertices.subspan(mesh.vertex_offset, mesh.vertex_count),
+                indices.subspan(mesh.index_offset, mesh.index_count),
+                mesh.bounds,
+                mesh_skins
+            ));
+            model_data->mesh_material_indices.push_back(mesh.material_index);
+        }
+
+        model_data->nodes = std::move(nodes);
+        model_data->root_node_index = root_node_index;
+        model_data->animation = std::move(animation);
 
         // Upload materials to GPU
         FED_TRACE("Uploading {} materials to GPU", model_data->materials.size());
@@ -198,9 +611,7 @@ namespace klingon {
         for (const auto& mat : model_data->materials) {
             gpu_materials.push_back(mat.gpu_data);
         }
-        model_data->material_buffer_offset = m_texture_manager.upload_materials(gpu_materials);
-
-        FED_TRACE("Materials uploaded starting at index {}", model_data->material_buffer_offset);
+        model_data->material_buffer_indices = m_texture_manager.upload_materials(gpu_materials);
 
         // Update descriptor sets after loading textures and materials
         m_texture_manager.update_descriptors();
@@ -208,9 +619,141 @@ namespace klingon {
         return model_data;
     }
 
-    auto AssetLoader::process_mesh(const aiMesh* assimp_mesh) -> MeshData {
-        MeshData mesh_data;
-        std::unordered_map<Vertex, uint32_t> unique_verts;
+    auto AssetLoader::load_material_textures(Material& material) -> void {
+        if (!material.albedo_texture_path.empty()) {
+            material.gpu_data.albedo_texture_index = m_texture_manager.load_texture_async(
+                material.albedo_texture_path,
+                batleth::TextureType::Albedo,
+                true  // generate mipmaps
+            );
+            FED_TRACE("Loaded albedo texture: {} (index {})", material.albedo_texture_path,
+                      material.gpu_data.albedo_texture_index);
+        }
+
+        if (!material.normal_texture_path.empty()) {
+            material.gpu_data.normal_texture_index = m_texture_manager.load_texture_async(
+                material.normal_texture_path,
+                batleth::TextureType::Normal,
+                true
+            );
+            FED_TRACE("Loaded normal texture: {} (index {})", material.normal_texture_path,
+                      material.gpu_data.normal_texture_index);
+        }
+
+        if (!material.pbr_texture_path.empty()) {
+            material.gpu_data.pbr_texture_index = m_texture_manager.load_texture_async(
+                material.pbr_texture_path,
+                batleth::TextureType::MetallicRoughness,
+                true
+            );
+            FED_TRACE("Loaded PBR texture: {} (index {})", material.pbr_texture_path,
+                      material.gpu_data.pbr_texture_index);
+        }
+
+        if (!material.opacity_texture_path.empty()) {
+            material.gpu_data.opacity_texture_index = m_texture_manager.load_texture_async(
+                material.opacity_texture_path,
+                batleth::TextureType::Opacity,
+                true  // generate mipmaps
+            );
+            FED_TRACE("Loaded opacity texture: {} (index {})", material.opacity_texture_path,
+                      material.gpu_data.opacity_texture_index);
+        }
+    }
+
+    auto AssetLoader::process_assimp_scene(const aiScene* scene, const VertexWelder::Config& weld)
+        -> std::unique_ptr<CookedModel> {
+        auto model = std::make_unique<CookedModel>();
+
+        // Process materials first
+        FED_TRACE("Processing {} materials", scene->mNumMaterials);
+        for (uint32_t i = 0; i < scene->mNumMaterials; ++i) {
+            model->materials.push_back(process_material(scene->mMaterials[i]));
+        }
+
+        // Add default material if none exist
+        if (model->materials.empty()) {
+            FED_WARN("No materials found, adding default material");
+            model->materials.emplace_back();
+        }
+
+        // Bones are resolved to joint indices while welding, so the skeleton comes first
+        model->skeleton = process_skeleton(scene);
+
+        // Meshes are welded independently (indices are mesh-relative), so each gets its own
+        // thread; the streams are concatenated afterwards in scene order
+        FED_TRACE("Processing {} meshes", scene->mNumMeshes);
+        struct MeshStreams {
+            KmeshMesh mesh{};
+            std::vector<Vertex> vertices;
+            std::vector<uint32_t> indices;
+            std::vector<VertexSkin> skins;
+        };
+        std::vector<MeshStreams> streams(scene->mNumMeshes);
+        const auto material_count = static_cast<uint32_t>(model->materials.size());
+        parallel_for(scene->mNumMeshes, [&](uint32_t i) {
+            auto& mesh = streams[i];
+            mesh.mesh = process_mesh(scene->mMeshes[i], material_count, weld, model->skeleton,
+                                     mesh.vertices, mesh.indices, mesh.skins);
+        });
+        const bool skinned = model->skeleton.get_joint_count() > 0;
+
+        size_t vertex_count = 0;
+        size_t index_count = 0;
+        for (const auto& mesh : streams) {
+            vertex_count += mesh.vertices.size();
+            index_count += mesh.indices.size();
+        }
+        model->vertices.reserve(vertex_count);
+        model->indices.reserve(index_count);
+        model->meshes.reserve(streams.size());
+        for (auto& mesh : streams) {
+            mesh.mesh.vertex_offset = static_cast<uint32_t>(model->vertices.size());
+            mesh.mesh.index_offset = static_cast<uint32_t>(model->indices.size());
+            model->vertices.insert(model->vertices.end(), mesh.vertices.begin(), mesh.vertices.end());
+            model->indices.insert(model->indices.end(), mesh.indices.begin(), mesh.indices.end());
+            if (skinned) {
+                mesh.skins.resize(mesh.vertices.size());
+                model->skins.insert(model->skins.end(), mesh.skins.begin(), mesh.skins.end());
+            }
+            model->meshes.push_back(mesh.mesh);
+            mesh = {};
+        }
+
+        // Process node hierarchy
+        FED_TRACE("Processing node hierarchy");
+        model->root_node_index = process_node(scene, scene->mRootNode, *model, UINT32_MAX);
+
+        if (skinned) {
+            FED_TRACE("Compressing {} animations over {} joints", scene->mNumAnimations, model->skeleton.get_joint_count());
+            model->clips.reserve(scene->mNumAnimations);
+            for (uint32_t i = 0; i < scene->mNumAnimations; ++i) {
+                const auto raw = process_animation(scene->mAnimations[i], model->skeleton);
+                model->clips.push_back(AnimationClip::compress(raw, model->skeleton));
+            }
+        }
+
+        return model;
+    }
+
+    auto AssetLoader::process_mesh(const aiMesh* assimp_mesh, uint32_t material_count, const VertexWelder::Config& weld,
+                                   const Skeleton& skeleton, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices,
+                                   std::vector<VertexSkin>& skins) -> KmeshMesh {
+        KmeshMesh mesh{};
+        mesh.material_index = std::min(assimp_mesh->mMaterialIndex, material_count - 1);
+
+        // Assimp has already joined identical vertices, so its count bounds ours
+        VertexWelder welder(weld);
+        welder.reserve(assimp_mesh->mNumVertices);
+        indices.reserve(static_cast<size_t>(assimp_mesh->mNumFaces) * 3);
+
+        // Influences follow the first source vertex of each welded one; Assimp only joins
+        // vertices with equal weights, so a merge here loses nothing but exact duplicates
+        std::vector<VertexSkin> source_skins;
+        if (assimp_mesh->HasBones() && skeleton.get_joint_count() > 0) {
+            source_skins = gather_influences(assimp_mesh, skeleton);
+            skins.reserve(assimp_mesh->mNumVertices);
+        }
 
         for (uint32_t face_idx = 0; face_idx < assimp_mesh->mNumFaces; ++face_idx) {
             const aiFace& face = assimp_mesh->mFaces[face_idx];
@@ -254,20 +797,92 @@ namespace klingon {
                     };
                 }
 
-                // Deduplicate vertices
-                if (!unique_verts.contains(vertex)) {
-                    unique_verts[vertex] = static_cast<uint32_t>(mesh_data.vertices.size());
-                    mesh_data.vertices.push_back(vertex);
+                const size_t welded_count = welder.get_vertices().size();
+                const uint32_t welded = welder.insert(vertex);
+                if (!source_skins.empty() && welded == welded_count) {
+                    skins.push_back(source_skins[index]);
                 }
-                mesh_data.indices.push_back(unique_verts[vertex]);
+                indices.push_back(welded);
             }
         }
 
-        FED_TRACE("Processed mesh: {} vertices, {} indices", mesh_data.vertices.size(), mesh_data.indices.size());
-        return mesh_data;
+        vertices = welder.take_vertices();
+        mesh.vertex_count = static_cast<uint32_t>(vertices.size());
+        mesh.index_count = static_cast<uint32_t>(indices.size());
+        mesh.bounds = compute_aabb(vertices);
+
+        FED_TRACE("Processed mesh: {} vertices, {} indices", mesh.vertex_count, mesh.index_count);
+        return mesh;
     }
 
-    auto AssetLoader::process_material(const aiMaterial* assimp_material, const std::string& model_dir) -> Material {
+    auto AssetLoader::process_skeleton(const aiScene* scene) -> Skeleton {
+        JointSources sources;
+        std::unordered_set<std::string> wanted;
+        for (uint32_t mesh_idx = 0; mesh_idx < scene->mNumMeshes; ++mesh_idx) {
+            const aiMesh* mesh = scene->mMeshes[mesh_idx];
+            for (uint32_t bone_idx = 0; bone_idx < mesh->mNumBones; ++bone_idx) {
+                const aiBone* bone = mesh->mBones[bone_idx];
+                sources.bones.try_emplace(bone->mName.C_Str(), bone);
+                wanted.insert(bone->mName.C_Str());
+            }
+        }
+
+        // Node animation without skinned meshes is not supported; there would be nothing to deform
+        Skeleton skeleton;
+        if (sources.bones.empty()) {
+            return skeleton;
+        }
+        for (uint32_t anim_idx = 0; anim_idx < scene->mNumAnimations; ++anim_idx) {
+            const aiAnimation* animation = scene->mAnimations[anim_idx];
+            for (uint32_t i = 0; i < animation->mNumChannels; ++i) {
+                wanted.insert(animation->mChannels[i]->mNodeName.C_Str());
+            }
+        }
+
+        mark_joints(scene->mRootNode, wanted, sources);
+        add_joints(scene->mRootNode, NO_PARENT_JOINT, aiMatrix4x4(), sources, skeleton);
+        FED_TRACE("Built skeleton: {} joints from {} bones", skeleton.get_joint_count(), sources.bones.size());
+        return skeleton;
+    }
+
+    auto AssetLoader::process_animation(const aiAnimation* animation, const Skeleton& skeleton) -> RawAnimationClip {
+        RawAnimationClip clip;
+        clip.name = animation->mName.C_Str();
+        clip.tracks.resize(skeleton.get_joint_count());
+
+        // Assimp leaves the tick rate at zero when the format doesn't store one
+        const double ticks_per_second = animation->mTicksPerSecond > 0.0 ? animation->mTicksPerSecond : 25.0;
+        const auto seconds = [ticks_per_second](double ticks) { return static_cast<float>(ticks / ticks_per_second); };
+        clip.duration = seconds(animation->mDuration);
+
+        for (uint32_t channel_idx = 0; channel_idx < animation->mNumChannels; ++channel_idx) {
+            const aiNodeAnim* channel = animation->mChannels[channel_idx];
+            const auto joint = skeleton.find_joint(channel->mNodeName.C_Str());
+            if (!joint) {
+                continue;
+            }
+
+            RawJointTrack& track = clip.tracks[*joint];
+            for (uint32_t i = 0; i < channel->mNumPositionKeys; ++i) {
+                const aiVectorKey& key = channel->mPositionKeys[i];
+                track.translation_times.push_back(seconds(key.mTime));
+                track.translations.emplace_back(key.mValue.x, key.mValue.y, key.mValue.z);
+            }
+            for (uint32_t i = 0; i < channel->mNumRotationKeys; ++i) {
+                const aiQuatKey& key = channel->mRotationKeys[i];
+                track.rotation_times.push_back(seconds(key.mTime));
+                track.rotations.push_back(from_assimp(key.mValue));
+            }
+            for (uint32_t i = 0; i < channel->mNumScalingKeys; ++i) {
+                const aiVectorKey& key = channel->mScalingKeys[i];
+                track.scale_times.push_back(seconds(key.mTime));
+                track.scales.emplace_back(key.mValue.x, key.mValue.y, key.mValue.z);
+            }
+        }
+        return clip;
+    }
+
+    auto AssetLoader::process_material(const aiMaterial* assimp_material) -> Material {
         Material material;
 
         // Base color - default to white
@@ -297,19 +912,10 @@ namespace klingon {
         material.gpu_data.metallic_factor = metallic;
         material.gpu_data.roughness_factor = roughness;
 
-        // Load albedo/diffuse texture
+        // Texture paths only; textures are loaded when the model is created (load_material_textures)
         aiString texture_path;
         if (assimp_material->GetTexture(aiTextureType_DIFFUSE, 0, &texture_path) == AI_SUCCESS) {
-            // std::filesystem::path full_path = std::filesystem::path(model_dir) / texture_path.C_Str();
             material.albedo_texture_path = texture_path.C_Str();
-
-            uint32_t tex_index = m_texture_manager.load_texture(
-                material.albedo_texture_path,
-                batleth::TextureType::Albedo,
-                true  // generate mipmaps
-            );
-
-            material.gpu_data.albedo_texture_index = tex_index;
             material.set_has_albedo(true);
 
             // Override RGB to white when texture is present (common for FBX models)
@@ -317,63 +923,31 @@ namespace klingon {
             // IMPORTANT: Preserve alpha channel for transparency
             float original_alpha = material.gpu_data.base_color_factor.a;
             material.gpu_data.base_color_factor = glm::vec4(1.0f, 1.0f, 1.0f, original_alpha);
-
-            FED_TRACE("Loaded albedo texture: {} (index {}), overriding base_color_factor to white", material.albedo_texture_path, tex_index);
         }
 
-        // Load normal map
+        // Normal map
         if (assimp_material->GetTexture(aiTextureType_NORMALS, 0, &texture_path) == AI_SUCCESS) {
-            // std::filesystem::path full_path = std::filesystem::path(model_dir) / texture_path.C_Str();
             material.normal_texture_path = texture_path.C_Str();
-
-            uint32_t tex_index = m_texture_manager.load_texture(
-                material.normal_texture_path,
-                batleth::TextureType::Normal,
-                true
-            );
-
-            material.gpu_data.normal_texture_index = tex_index;
             material.set_has_normal(true);
-            FED_TRACE("Loaded normal texture: {} (index {})", material.normal_texture_path, tex_index);
         }
 
-        // Load metallic/roughness texture (typically combined in one texture)
+        // Metallic/roughness texture (typically combined in one texture)
         if (assimp_material->GetTexture(aiTextureType_UNKNOWN, 0, &texture_path) == AI_SUCCESS ||
             assimp_material->GetTexture(aiTextureType_METALNESS, 0, &texture_path) == AI_SUCCESS) {
-            // std::filesystem::path full_path = std::filesystem::path(model_dir) / texture_path.C_Str();
             material.pbr_texture_path = texture_path.C_Str();
-
-            uint32_t tex_index = m_texture_manager.load_texture(
-                material.pbr_texture_path,
-                batleth::TextureType::MetallicRoughness,
-                true
-            );
-
-            material.gpu_data.pbr_texture_index = tex_index;
             material.set_has_pbr(true);
-            FED_TRACE("Loaded PBR texture: {} (index {})", material.pbr_texture_path, tex_index);
         }
 
-        // Load opacity/alpha texture
+        // Opacity/alpha texture
         if (assimp_material->GetTexture(aiTextureType_OPACITY, 0, &texture_path) == AI_SUCCESS) {
-            // Extract just the filename from the path (handles absolute paths from exporters)
             material.opacity_texture_path = texture_path.C_Str();
-
-            uint32_t tex_index = m_texture_manager.load_texture(
-                material.opacity_texture_path,
-                batleth::TextureType::Opacity,
-                true  // generate mipmaps
-            );
-
-            material.gpu_data.opacity_texture_index = tex_index;
             material.set_has_opacity(true);
-            FED_TRACE("Loaded opacity texture: {} (index {})", material.opacity_texture_path, tex_index);
         }
 
         return material;
     }
 
-    auto AssetLoader::process_node(const aiScene* scene, const aiNode* node, ModelData& model_data, uint32_t parent_index) -> uint32_t {
+    auto AssetLoader::process_node(const aiScene* scene, const aiNode* node, CookedModel& model, uint32_t parent_index) -> uint32_t {
         ModelNode model_node;
         model_node.name = node->mName.C_Str();
 
@@ -408,13 +982,13 @@ namespace klingon {
         }
 
         // Add node to model data
-        uint32_t node_index = static_cast<uint32_t>(model_data.nodes.size());
-        model_data.nodes.push_back(model_node);
+        uint32_t node_index = static_cast<uint32_t>(model.nodes.size());
+        model.nodes.push_back(model_node);
 
         // Process children recursively
         for (uint32_t i = 0; i < node->mNumChildren; ++i) {
-            uint32_t child_index = process_node(scene, node->mChildren[i], model_data, node_index);
-            model_data.nodes[node_index].children.push_back(child_index);
+            uint32_t child_index = process_node(scene, node->mChildren[i], model, node_index);
+            model.nodes[node_index].children.push_back(child_index);
         }
 
         return node_index;
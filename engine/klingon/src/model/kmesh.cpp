@@ -0,0 +1,412 @@
+#include "klingon/model/kmesh.hpp"
+
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <unordered_map>
+
+namespace klingon {
+
+namespace {
+    constexpr size_t SECTION_ALIGNMENT = 16;
+
+    auto align_to(std::vector<std::byte>& out, size_t alignment) -> void {
+        out.resize((out.size() + alignment - 1) / alignment * alignment, std::byte{0});
+    }
+
+    template<typename T>
+    auto append_section(std::vector<std::byte>& out, std::span<const T> items) -> KmeshSection {
+        align_to(out, SECTION_ALIGNMENT);
+        KmeshSection section{out.size(), items.size()};
+        const auto* bytes = reinterpret_cast<const std::byte*>(items.data());
+        out.insert(out.end(), bytes, bytes + items.size_bytes());
+        return section;
+    }
+
+    /**
+     * Deduplicating string table builder
+     */
+    class StringTable {
+    public:
+        auto add(std::string_view text) -> uint32_t {
+            if (text.empty()) {
+                return KMESH_NO_STRING;
+            }
+            auto [it, inserted] = m_offsets.emplace(std::string(text), static_cast<uint32_t>(m_bytes.size()));
+            if (inserted) {
+                m_bytes.insert(m_bytes.end(), text.begin(), text.end());
+                m_bytes.push_back('\0');
+            }
+            return it->second;
+        }
+
+        [[nodiscard]] auto get_bytes() const -> std::span<const char> { return m_bytes; }
+
+    private:
+        std::vector<char> m_bytes;
+        std::unordered_map<std::string, uint32_t> m_offsets;
+    };
+
+    template<typename T>
+    auto view_section(std::span<const std::byte> bytes, const KmeshSection& section, std::string_view name)
+        -> std::expected<std::span<const T>, std::string> {
+        if (section.offset % alignof(T) != 0 || section.offset > bytes.size() ||
+            section.count > (bytes.size() - section.offset) / sizeof(T)) {
+            return std::unexpected(std::format("{} section out of bounds", name));
+        }
+        const auto* first = reinterpret_cast<const T*>(bytes.data() + section.offset);
+        return std::span<const T>(first, static_cast<size_t>(section.count));
+    }
+
+    auto file_time_ticks(std::filesystem::file_time_type time) -> int64_t {
+        return static_cast<int64_t>(time.time_since_epoch().count());
+    }
+} // anonymous namespace
+
+auto KmeshView::parse(std::span<const std::byte> bytes) -> std::expected<KmeshView, std::string> {
+    if (bytes.size() < sizeof(KmeshHeader)) {
+        return std::unexpected("file too small for a kmesh header");
+    }
+
+    KmeshView view;
+    view.m_header = reinterpret_cast<const KmeshHeader*>(bytes.data());
+    const auto& header = *view.m_header;
+    if (header.magic != KMESH_MAGIC) {
+        return std::unexpected("not a kmesh file");
+    }
+    if (header.version != KMESH_VERSION) {
+        return std::unexpected(std::format("unsupported kmesh version {} (expected {})", header.version, KMESH_VERSION));
+    }
+
+    std::string error;
+    auto bind = [&]<typename T>(std::span<const T>& out, const KmeshSection& section, std::string_view name) {
+        if (!error.empty()) {
+            return;
+        }
+        auto viewed = view_section<T>(bytes, section, name);
+        if (viewed) {
+            out = *viewed;
+        } else {
+            error = viewed.error();
+        }
+    };
+    bind(view.m_vertices, header.vertices, "vertex");
+    bind(view.m_indices, header.indices, "index");
+    bind(view.m_meshes, header.meshes, "mesh");
+    bind(view.m_materials, header.materials, "material");
+    bind(view.m_nodes, header.nodes, "node");
+    bind(view.m_children, header.children, "children");
+    bind(view.m_strings, header.strings, "string");
+    bind(view.m_skins, header.skins, "skin");
+    bind(view.m_joints, header.joints, "joint");
+    bind(view.m_clips, header.clips, "clip");
+    bind(view.m_clip_channels, header.clip_channels, "clip channel");
+    bind(view.m_key_frames, header.key_frames, "key frame");
+    bind(view.m_key_values, header.key_values, "key value");
+    if (!error.empty()) {
+        return std::unexpected(error);
+    }
+
+    if (!view.m_strings.empty() && view.m_strings.back() != '\0') {
+        return std::unexpected("string table is not terminated");
+    }
+
+    // Cross-references only; index values themselves are trusted (the cooker wrote them in range)
+    for (const auto& mesh : view.m_meshes) {
+        if (static_cast<uint64_t>(mesh.vertex_offset) + mesh.vertex_count > view.m_vertices.size() ||
+            static_cast<uint64_t>(mesh.index_offset) + mesh.index_count > view.m_indices.size()) {
+            return std::unexpected("mesh range out of bounds");
+        }
+        if (mesh.material_index >= view.m_materials.size()) {
+            return std::unexpected("mesh material out of range");
+        }
+    }
+    for (const auto& node : view.m_nodes) {
+        if (static_cast<uint64_t>(node.first_child) + node.child_count > view.m_children.size() ||
+            (node.mesh_index != UINT32_MAX && node.mesh_index >= view.m_meshes.size()) ||
+            (node.name != KMESH_NO_STRING && node.name >= view.m_strings.size())) {
+            return std::unexpected("node reference out of range");
+        }
+    }
+    for (uint32_t child : view.m_children) {
+        if (child >= view.m_nodes.size()) {
+            return std::unexpected("child node out of range");
+        }
+    }
+    for (const auto& material : view.m_materials) {
+        for (uint32_t path : {material.albedo_path, material.normal_path, material.pbr_path, material.opacity_path}) {
+            if (path != KMESH_NO_STRING && path >= view.m_strings.size()) {
+                return std::unexpected("material texture path out of range");
+            }
+        }
+    }
+    if (!view.m_nodes.empty() && header.root_node >= view.m_nodes.size()) {
+        return std::unexpected("root node out of range");
+    }
+
+    // Skin joint indices, like vertex indices, are trusted; the tables they index are checked
+    if (!view.m_skins.empty() && view.m_skins.size() != view.m_vertices.size()) {
+        return std::unexpected("skin stream does not match the vertex stream");
+    }
+    if (view.m_joints.size() > MAX_JOINTS) {
+        return std::unexpected("too many joints");
+    }
+    for (size_t i = 0; i < view.m_joints.size(); ++i) {
+        const auto& joint = view.m_joints[i];
+        if ((joint.parent != NO_PARENT_JOINT && joint.parent >= i) ||
+            (joint.name != KMESH_NO_STRING && joint.name >= view.m_strings.size())) {
+            return std::unexpected("joint reference out of range");
+        }
+    }
+    if (view.m_key_values.size() != view.m_key_frames.size()) {
+        return std::unexpected("key tables differ in size");
+    }
+    const uint64_t channels_per_clip = view.m_joints.size() * CHANNELS_PER_JOINT;
+    for (const auto& clip : view.m_clips) {
+        if (clip.first_channel + channels_per_clip > view.m_clip_channels.size() ||
+            static_cast<uint64_t>(clip.first_key) + clip.key_count > view.m_key_frames.size() ||
+            (clip.name != KMESH_NO_STRING && clip.name >= view.m_strings.size())) {
+            return std::unexpected("clip reference out of range");
+        }
+        for (const auto& channel : view.m_clip_channels.subspan(clip.first_channel, channels_per_clip)) {
+            if (channel.key_count == 0 || static_cast<uint64_t>(channel.first_key) + channel.key_count > clip.key_count) {
+                return std::unexpected("clip channel out of range");
+            }
+        }
+    }
+
+    return view;
+}
+
+auto KmeshView::get_string(uint32_t offset) const -> std::string_view {
+    if (offset == KMESH_NO_STRING || offset >= m_strings.size()) {
+        return {};
+    }
+    // parse() guaranteed the table ends in a terminator
+    return std::string_view(m_strings.data() + offset);
+}
+
+auto KmeshView::decode_materials() const -> std::vector<Material> {
+    std::vector<Material> materials;
+    materials.reserve(m_materials.size());
+    for (const auto& cooked : m_materials) {
+        Material& material = materials.emplace_back();
+        auto& gpu = material.gpu_data;
+        gpu.base_color_factor = {cooked.base_color_factor[0], cooked.base_color_factor[1],
+                                 cooked.base_color_factor[2], cooked.base_color_factor[3]};
+        gpu.metallic_factor = cooked.metallic_factor;
+        gpu.roughness_factor = cooked.roughness_factor;
+        gpu.normal_scale = cooked.normal_scale;
+        gpu.material_flags = cooked.material_flags;
+        material.albedo_texture_path = get_string(cooked.albedo_path);
+        material.normal_texture_path = get_string(cooked.normal_path);
+        material.pbr_texture_path = get_string(cooked.pbr_path);
+        material.opacity_texture_path = get_string(cooked.opacity_path);
+    }
+    return materials;
+}
+
+auto KmeshView::decode_nodes() const -> std::vector<ModelNode> {
+    std::vector<ModelNode> nodes;
+    nodes.reserve(m_nodes.size());
+    for (const auto& cooked : m_nodes) {
+        ModelNode& node = nodes.emplace_back();
+        node.name = get_string(cooked.name);
+        node.transform.translation = {cooked.translation[0], cooked.translation[1], cooked.translation[2]};
+        node.transform.rotation = {cooked.rotation[0], cooked.rotation[1], cooked.rotation[2]};
+        node.transform.scale = {cooked.scale[0], cooked.scale[1], cooked.scale[2]};
+        node.mesh_index = cooked.mesh_index;
+        node.material_index = cooked.material_index;
+        const auto children = get_children(cooked);
+        node.children.assign(children.begin(), children.end());
+    }
+    return nodes;
+}
+
+auto KmeshView::decode_animation() const -> std::shared_ptr<AnimationSet> {
+    if (m_joints.empty()) {
+        return nullptr;
+    }
+
+    auto animation = std::make_shared<AnimationSet>();
+    auto& skeleton = animation->skeleton;
+    skeleton.joint_names.reserve(m_joints.size());
+    skeleton.parents.reserve(m_joints.size());
+    skeleton.inverse_bind.reserve(m_joints.size());
+    skeleton.rest_pose.reserve(m_joints.size());
+    for (const auto& joint : m_joints) {
+        skeleton.joint_names.emplace_back(get_string(joint.name));
+        skeleton.parents.push_back(joint.parent);
+        SkinMatrix& inverse_bind = skeleton.inverse_bind.emplace_back();
+        std::memcpy(inverse_bind.rows, joint.inverse_bind, sizeof(joint.inverse_bind));
+        JointTransform& rest = skeleton.rest_pose.emplace_back();
+        rest.translation = {joint.translation[0], joint.translation[1], joint.translation[2]};
+        rest.rotation.x = joint.rotation[0];
+        rest.rotation.y = joint.rotation[1];
+        rest.rotation.z = joint.rotation[2];
+        rest.rotation.w = joint.rotation[3];
+        rest.scale = {joint.scale[0], joint.scale[1], joint.scale[2]};
+    }
+
+    const size_t channels_per_clip = m_joints.size() * CHANNELS_PER_JOINT;
+    animation->clips.reserve(m_clips.size());
+    for (const auto& clip : m_clips) {
+        const auto channels = m_clip_channels.subspan(clip.first_channel, channels_per_clip);
+        const auto frames = m_key_frames.subspan(clip.first_key, clip.key_count);
+        const auto values = m_key_values.subspan(clip.first_key, clip.key_count);
+        animation->clips.emplace_back(std::string(get_string(clip.name)), clip.duration, clip.sample_rate,
+                                      std::vector<ClipChannel>(channels.begin(), channels.end()),
+                                      std::vector<uint16_t>(frames.begin(), frames.end()),
+                                      std::vector<PackedKey>(values.begin(), values.end()));
+    }
+    return animation;
+}
+
+auto KmeshSourceStamp::from_file(const std::filesystem::path& source) -> std::optional<KmeshSourceStamp> {
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(source, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    const auto mtime = std::filesystem::last_write_time(source, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    return KmeshSourceStamp{size, file_time_ticks(mtime)};
+}
+
+auto write_kmesh(const std::filesystem::path& path, const CookedModel& model, const KmeshSourceStamp& source)
+    -> std::expected<void, std::string> {
+    StringTable strings;
+
+    std::vector<KmeshMaterial> materials;
+    materials.reserve(model.materials.size());
+    for (const auto& material : model.materials) {
+        const auto& gpu = material.gpu_data;
+        KmeshMaterial& cooked = materials.emplace_back();
+        cooked.base_color_factor[0] = gpu.base_color_factor.r;
+        cooked.base_color_factor[1] = gpu.base_color_factor.g;
+        cooked.base_color_factor[2] = gpu.base_color_factor.b;
+        cooked.base_color_factor[3] = gpu.base_color_factor.a;
+        cooked.metallic_factor = gpu.metallic_factor;
+        cooked.roughness_factor = gpu.roughness_factor;
+        cooked.normal_scale = gpu.normal_scale;
+        cooked.material_flags = gpu.material_flags;
+        cooked.albedo_path = strings.add(material.albedo_texture_path);
+        cooked.normal_path = strings.add(material.normal_texture_path);
+        cooked.pbr_path = strings.add(material.pbr_texture_path);
+        cooked.opacity_path = strings.add(material.opacity_texture_path);
+    }
+
+    std::vector<KmeshNode> nodes;
+    std::vector<uint32_t> children;
+    nodes.reserve(model.nodes.size());
+    for (const auto& node : model.nodes) {
+        KmeshNode& cooked = nodes.emplace_back();
+        cooked.name = strings.add(node.name);
+        const auto& transform = node.transform;
+        std::memcpy(cooked.translation, &transform.translation, sizeof(cooked.translation));
+        std::memcpy(cooked.rotation, &transform.rotation, sizeof(cooked.rotation));
+        std::memcpy(cooked.scale, &transform.scale, sizeof(cooked.scale));
+        cooked.mesh_index = node.mesh_index;
+        cooked.material_index = node.material_index;
+        cooked.first_child = static_cast<uint32_t>(children.size());
+        cooked.child_count = static_cast<uint32_t>(node.children.size());
+        children.insert(children.end(), node.children.begin(), node.children.end());
+    }
+
+    std::vector<KmeshJoint> joints;
+    const auto& skeleton = model.skeleton;
+    joints.reserve(skeleton.get_joint_count());
+    for (uint32_t i = 0; i < skeleton.get_joint_count(); ++i) {
+        KmeshJoint& cooked = joints.emplace_back();
+        cooked.name = strings.add(skeleton.joint_names[i]);
+        cooked.parent = skeleton.parents[i];
+        std::memcpy(cooked.inverse_bind, skeleton.inverse_bind[i].rows, sizeof(cooked.inverse_bind));
+        const auto& rest = skeleton.rest_pose[i];
+        std::memcpy(cooked.translation, &rest.translation, sizeof(cooked.translation));
+        cooked.rotation[0] = rest.rotation.x;
+        cooked.rotation[1] = rest.rotation.y;
+        cooked.rotation[2] = rest.rotation.z;
+        cooked.rotation[3] = rest.rotation.w;
+        std::memcpy(cooked.scale, &rest.scale, sizeof(cooked.scale));
+    }
+
+    std::vector<KmeshClip> clips;
+    std::vector<ClipChannel> clip_channels;
+    std::vector<uint16_t> key_frames;
+    std::vector<PackedKey> key_values;
+    for (const auto& clip : model.clips) {
+        KmeshClip& cooked = clips.emplace_back();
+        cooked.name = strings.add(clip.get_name());
+        cooked.duration = clip.get_duration();
+        cooked.sample_rate = clip.get_sample_rate();
+        cooked.first_channel = static_cast<uint32_t>(clip_channels.size());
+        cooked.first_key = static_cast<uint32_t>(key_frames.size());
+        cooked.key_count = static_cast<uint32_t>(clip.get_key_frames().size());
+        clip_channels.insert(clip_channels.end(), clip.get_channels().begin(), clip.get_channels().end());
+        key_frames.insert(key_frames.end(), clip.get_key_frames().begin(), clip.get_key_frames().end());
+        key_values.insert(key_values.end(), clip.get_key_values().begin(), clip.get_key_values().end());
+    }
+
+    KmeshHeader header{};
+    header.flags = model.skins.empty() ? 0 : KMESH_FLAG_SKINNED;
+    header.source_size = source.size;
+    header.source_mtime = source.mtime;
+    header.root_node = model.root_node_index;
+
+    std::vector<std::byte> out(sizeof(KmeshHeader));
+    header.vertices = append_section(out, std::span<const Vertex>(model.vertices));
+    header.indices = append_section(out, std::span<const uint32_t>(model.indices));
+    header.meshes = append_section(out, std::span<const KmeshMesh>(model.meshes));
+    header.materials = append_section(out, std::span<const KmeshMaterial>(materials));
+    header.nodes = append_section(out, std::span<const KmeshNode>(nodes));
+    header.children = append_section(out, std::span<const uint32_t>(children));
+    header.skins = append_section(out, std::span<const VertexSkin>(model.skins));
+    header.joints = append_section(out, std::span<const KmeshJoint>(joints));
+    header.clips = append_section(out, std::span<const KmeshClip>(clips));
+    header.clip_channels = append_section(out, std::span<const ClipChannel>(clip_channels));
+    header.key_frames = append_section(out, std::span<const uint16_t>(key_frames));
+    header.key_values = append_section(out, std::span<const PackedKey>(key_values));
+    header.strings = append_section(out, strings.get_bytes());
+    std::memcpy(out.data(), &header, sizeof(header));
+
+    if (path.has_parent_path()) {
+        std::error_code ec;
+        std::filesystem::create_directories(path.parent_path(), ec);
+    }
+
+    auto temp_path = path;
+    temp_path += ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return std::unexpected("could not open " + temp_path.string() + " for writing");
+        }
+        file.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()));
+        if (!file) {
+            return std::unexpected("failed writing " + temp_path.string());
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+        std::filesystem::remove(temp_path, ec);
+        return std::unexpected("could not replace " + path.string());
+    }
+    return {};
+}
+
+auto is_kmesh_current(const KmeshHeader& header, const std::optional<KmeshSourceStamp>& source) -> bool {
+    if (header.magic != KMESH_MAGIC || header.version != KMESH_VERSION ||
+        header.import_version != KMESH_IMPORT_VERSION) {
+        return false;
+    }
+    if (!source) {
+        return true;
+    }
+    return source->size == header.source_size && source->mtime == header.source_mtime;
+}
+
+} // namespace klingon
@@ -5,35 +5,12 @@
 #define TINYOBJLOADER_IMPLEMENTATION
 #include <tiny_obj_loader.h>
 
-#define GLM_ENABLE_EXPERIMENTAL
-#include <glm/gtx/hash.hpp>
-
 #include <cassert>
 #include <cstring>
-#include <unordered_map>
+#include <utility>
 
 #include "klingon/model/asset_loader.hpp"
-
-// Hash function for Vertex
-namespace std {
-    template<>
-    struct hash<klingon::Vertex> {
-        size_t operator()(const klingon::Vertex &vertex) const noexcept {
-            size_t h1 = hash<glm::vec3>()(vertex.position);
-            size_t h2 = hash<glm::vec3>()(vertex.color);
-            size_t h3 = hash<glm::vec3>()(vertex.normal);
-            size_t h4 = hash<glm::vec2>()(vertex.uv);
-
-            // Combine hashes
-            size_t seed = 0;
-            seed ^= h1 + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-            seed ^= h2 + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-            seed ^= h3 + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-            seed ^= h4 + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-            return seed;
-        }
-    };
-}
+#include "klingon/model/vertex_welder.hpp"
 
 namespace klingon {
     // Vertex binding and attribute descriptions
@@ -90,7 +67,9 @@ namespace klingon {
         vertices.clear();
         indices.clear();
 
-        std::unordered_map<Vertex, uint32_t> unique_vertices{};
+        // The OBJ's position count is a lower bound on the unique vertices; a good first size
+        VertexWelder welder;
+        welder.reserve(attrib.vertices.size() / 3);
 
         for (const auto &shape: shapes) {
             for (const auto &index: shape.mesh.indices) {
@@ -128,39 +107,60 @@ namespace klingon {
                     };
                 }
 
-                // Deduplicate vertices
-                if (!unique_vertices.contains(vertex)) {
-                    unique_vertices[vertex] = static_cast<uint32_t>(vertices.size());
-                    vertices.push_back(vertex);
-                }
-
-                indices.push_back(unique_vertices[vertex]);
+                indices.push_back(welder.insert(vertex));
             }
         }
+        vertices = welder.take_vertices();
 
         FED_INFO("Loaded mesh from {}: {} vertices, {} indices", filepath, vertices.size(), indices.size());
     }
 
-    // Mesh implementation
-    Mesh::Mesh(batleth::Device &device, const MeshData &mesh_data)
-        : m_device(device) {
-        create_vertex_buffer(mesh_data.vertices);
-        create_index_buffer(mesh_data.indices);
+    auto compute_aabb(std::span<const Vertex> vertices) -> AABB {
+        AABB aabb{};
+        if (vertices.empty()) {
+            return aabb;
+        }
 
-        // Calculate AABB
-        if (mesh_data.vertices.empty()) {
-            return;
+        aabb.min = vertices[0].position;
+        aabb.max = vertices[0].position;
+        for (const auto& vertex : vertices) {
+            aabb.min = glm::min(aabb.min, vertex.position);
+            aabb.max = glm::max(aabb.max, vertex.position);
         }
+        return aabb;
+    }
 
-        m_aabb.min = mesh_data.vertices[0].position;
-        m_aabb.max = mesh_data.vertices[0].position;
+    // Mesh implementation
+    Mesh::Mesh(batleth::Device &device, const MeshData &mesh_data)
+        : Mesh(device, mesh_data.vertices, mesh_data.indices, compute_aabb(mesh_data.vertices)) {
+    }
 
-        for (const auto& vertex : mesh_data.vertices) {
-            m_aabb.min = glm::min(m_aabb.min, vertex.position);
-            m_aabb.max = glm::max(m_aabb.max, vertex.position);
+    Mesh::Mesh(batleth::Device &device, std::span<const Vertex> vertices, std::span<const uint32_t> indices,
+               const AABB &bounds, std::span<const VertexSkin> skins)
+        : m_device(device)
+        , m_aabb(bounds) {
+        assert((skins.empty() || skins.size() == vertices.size()) && "Skin stream must match the vertex stream");
+        create_vertex_buffer(vertices, !skins.empty());
+        create_index_buffer(indices);
+        if (!skins.empty()) {
+            create_skin_buffer(skins);
         }
     }
 
+    Mesh::Mesh(Mesh &&other) noexcept
+        : m_device{other.m_device}
+          , m_vertex_buffer{std::exchange(other.m_vertex_buffer, VK_NULL_HANDLE)}
+          , m_vertex_buffer_memory{std::exchange(other.m_vertex_buffer_memory, VK_NULL_HANDLE)}
+          , m_vertex_count{std::exchange(other.m_vertex_count, 0)}
+          , m_has_index_buffer{std::exchange(other.m_has_index_buffer, false)}
+          , m_index_buffer{std::exchange(other.m_index_buffer, VK_NULL_HANDLE)}
+          , m_index_buffer_memory{std::exchange(other.m_index_buffer_memory, VK_NULL_HANDLE)}
+          , m_index_count{std::exchange(other.m_index_count, 0)}
+          , m_skin_buffer{std::exchange(other.m_skin_buffer, VK_NULL_HANDLE)}
+          , m_skin_buffer_memory{std::exchange(other.m_skin_buffer_memory, VK_NULL_HANDLE)}
+          , m_aabb{other.m_aabb} {
+    }
+
     Mesh::~Mesh() {
         if (m_vertex_buffer != VK_NULL_HANDLE) {
             ::vkDestroyBuffer(m_device.get_logical_device(), m_vertex_buffer, nullptr);
@@ -174,11 +174,21 @@ namespace klingon {
         if (m_index_buffer_memory != VK_NULL_HANDLE) {
             ::vkFreeMemory(m_device.get_logical_device(), m_index_buffer_memory, nullptr);
         }
+        if (m_skin_buffer != VK_NULL_HANDLE) {
+            ::vkDestroyBuffer(m_device.get_logical_device(), m_skin_buffer, nullptr);
+        }
+        if (m_skin_buffer_memory != VK_NULL_HANDLE) {
+            ::vkFreeMemory(m_device.get_logical_device(), m_skin_buffer_memory, nullptr);
+        }
     }
 
     auto Mesh::bind(VkCommandBuffer command_buffer) -> void {
-        VkBuffer buffers[] = {m_vertex_buffer};
-        VkDeviceSize offsets[] = {0};
+        bind(command_buffer, m_vertex_buffer);
+    }
+
+    auto Mesh::bind(VkCommandBuffer command_buffer, VkBuffer vertex_buffer, VkDeviceSize offset) -> void {
+        VkBuffer buffers[] = {vertex_buffer};
+        VkDeviceSize offsets[] = {offset};
         ::vkCmdBindVertexBuffers(command_buffer, 0, 1, buffers, offsets);
 
         if (m_has_index_buffer) {
@@ -202,86 +212,106 @@ namespace klingon {
         return std::make_unique<Mesh>(device, data);
     }
 
-    auto Mesh::create_vertex_buffer(const std::vector<Vertex> &vertices) -> void {
+    auto Mesh::create_vertex_buffer(std::span<const Vertex> vertices, bool skinned) -> void {
         m_vertex_count = static_cast<uint32_t>(vertices.size());
         assert(m_vertex_count >= 3 && "Vertex count must be at least 3");
 
-        VkDeviceSize buffer_size = sizeof(vertices[0]) * m_vertex_count;
+        // Skinned meshes are also read by the skinning compute shader
+        // Transfer source for read_back
+        VkBufferUsageFlags usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                                   VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        if (skinned) {
+            usage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+        }
+        upload_buffer(vertices.data(), vertices.size_bytes(), usage, m_vertex_buffer, m_vertex_buffer_memory);
+    }
+
+    auto Mesh::create_index_buffer(std::span<const uint32_t> indices) -> void {
+        m_index_count = static_cast<uint32_t>(indices.size());
+        m_has_index_buffer = m_index_count > 0;
+
+        if (!m_has_index_buffer) {
+            return;
+        }
+
+        upload_buffer(indices.data(), indices.size_bytes(),
+                      VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                      VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                      m_index_buffer, m_index_buffer_memory);
+    }
+
+    auto Mesh::create_skin_buffer(std::span<const VertexSkin> skins) -> void {
+        upload_buffer(skins.data(), skins.size_bytes(),
+                      VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                      m_skin_buffer, m_skin_buffer_memory);
+    }
 
+    auto Mesh::upload_buffer(const void *data, VkDeviceSize size, VkBufferUsageFlags usage, VkBuffer &buffer,
+                             VkDeviceMemory &memory) -> void {
         // Create staging buffer
         VkBuffer staging_buffer;
         VkDeviceMemory staging_buffer_memory;
         m_device.create_buffer(
-            buffer_size,
+            size,
             VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
             staging_buffer,
             staging_buffer_memory
         );
 
-        // Copy vertex data to staging buffer
-        void *data;
-        ::vkMapMemory(m_device.get_logical_device(), staging_buffer_memory, 0, buffer_size, 0, &data);
-        std::memcpy(data, vertices.data(), static_cast<size_t>(buffer_size));
+        // Copy data to staging buffer
+        void *mapped;
+        ::vkMapMemory(m_device.get_logical_device(), staging_buffer_memory, 0, size, 0, &mapped);
+        std::memcpy(mapped, data, static_cast<size_t>(size));
         ::vkUnmapMemory(m_device.get_logical_device(), staging_buffer_memory);
 
-        // Create device local vertex buffer
+        // Create device local buffer
         m_device.create_buffer(
-            buffer_size,
-            VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            size,
+            usage,
             VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-            m_vertex_buffer,
-            m_vertex_buffer_memory
+            buffer,
+            memory
         );
 
         // Copy from staging to device local buffer
-        m_device.copy_buffer(staging_buffer, m_vertex_buffer, buffer_size);
+        m_device.copy_buffer(staging_buffer, buffer, size);
 
         // Cleanup staging buffer
         ::vkDestroyBuffer(m_device.get_logical_device(), staging_buffer, nullptr);
         ::vkFreeMemory(m_device.get_logical_device(), staging_buffer_memory, nullptr);
     }
 
-    auto Mesh::create_index_buffer(const std::vector<uint32_t> &indices) -> void {
-        m_index_count = static_cast<uint32_t>(indices.size());
-        m_has_index_buffer = m_index_count > 0;
+    auto Mesh::read_back(std::vector<Vertex> &vertices, std::vector<uint32_t> &indices) const -> void {
+        vertices.resize(m_vertex_count);
+        download_buffer(m_vertex_buffer, sizeof(Vertex) * m_vertex_count, vertices.data());
 
-        if (!m_has_index_buffer) {
-            return;
+        indices.clear();
+        if (m_has_index_buffer) {
+            indices.resize(m_index_count);
+            download_buffer(m_index_buffer, sizeof(uint32_t) * m_index_count, indices.data());
         }
+    }
 
-        VkDeviceSize buffer_size = sizeof(indices[0]) * m_index_count;
-
-        // Create staging buffer
+    auto Mesh::download_buffer(VkBuffer buffer, VkDeviceSize size, void *data) const -> void {
         VkBuffer staging_buffer;
         VkDeviceMemory staging_buffer_memory;
         m_device.create_buffer(
-            buffer_size,
-            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            size,
+            VK_BUFFER_USAGE_TRANSFER_DST_BIT,
             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
             staging_buffer,
             staging_buffer_memory
         );
 
-        // Copy index data to staging buffer
-        void *data;
-        ::vkMapMemory(m_device.get_logical_device(), staging_buffer_memory, 0, buffer_size, 0, &data);
-        std::memcpy(data, indices.data(), static_cast<size_t>(buffer_size));
-        ::vkUnmapMemory(m_device.get_logical_device(), staging_buffer_memory);
-
-        // Create device local index buffer
-        m_device.create_buffer(
-            buffer_size,
-            VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-            m_index_buffer,
-            m_index_buffer_memory
-        );
+        // Blocks until the copy has completed
+        m_device.copy_buffer(buffer, staging_buffer, size);
 
-        // Copy from staging to device local buffer
-        m_device.copy_buffer(staging_buffer, m_index_buffer, buffer_size);
+        void *mapped;
+        ::vkMapMemory(m_device.get_logical_device(), staging_buffer_memory, 0, size, 0, &mapped);
+        std::memcpy(data, mapped, static_cast<size_t>(size));
+        ::vkUnmapMemory(m_device.get_logical_device(), staging_buffer_memory);
 
-        // Cleanup staging buffer
         ::vkDestroyBuffer(m_device.get_logical_device(), staging_buffer, nullptr);
         ::vkFreeMemory(m_device.get_logical_device(), staging_buffer_memory, nullptr);
     }
@@ -0,0 +1,135 @@
+#include "klingon/model/vertex_welder.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace klingon {
+    namespace {
+        static_assert(sizeof(Vertex) % sizeof(float) == 0 && std::is_trivially_copyable_v<Vertex>,
+                      "VertexWelder keys Vertex as packed floats");
+
+        constexpr size_t MIN_CAPACITY = 64;
+
+        /**
+         * Bit pattern of a component; adding +0 folds -0 into +0 so they compare equal, as with ==
+         */
+        auto exact_bits(float value) -> uint32_t {
+            return std::bit_cast<uint32_t>(value + 0.0f);
+        }
+
+        auto snapped_bits(float value, float inverse_epsilon) -> uint32_t {
+            constexpr double limit = std::numeric_limits<int32_t>::max();
+            const double cell = std::clamp(std::floor(static_cast<double>(value) * inverse_epsilon + 0.5), -limit, limit);
+            return static_cast<uint32_t>(static_cast<int32_t>(cell));
+        }
+
+        auto mix(uint64_t value) -> uint64_t {
+            // splitmix64 finalizer
+            value ^= value >> 30;
+            value *= 0xbf58476d1ce4e5b9ull;
+            value ^= value >> 27;
+            value *= 0x94d049bb133111ebull;
+            value ^= value >> 31;
+            return value;
+        }
+
+        template<size_t N>
+        auto hash_key(const std::array<uint32_t, N>& key) -> uint64_t {
+            uint64_t hash = 0x9e3779b97f4a7c15ull;
+            size_t i = 0;
+            for (; i + 1 < N; i += 2) {
+                const uint64_t word = key[i] | (static_cast<uint64_t>(key[i + 1]) << 32);
+                hash = std::rotl(hash ^ word, 29) * 0xff51afd7ed558ccdull;
+            }
+            if constexpr (N % 2 != 0) {
+                hash = std::rotl(hash ^ key[N - 1], 29) * 0xff51afd7ed558ccdull;
+            }
+            return mix(hash);
+        }
+    }
+
+    VertexWelder::VertexWelder()
+        : VertexWelder(Config{}) {
+    }
+
+    VertexWelder::VertexWelder(const Config& config)
+        : m_config(config) {
+    }
+
+    auto VertexWelder::reserve(size_t vertex_count) -> void {
+        m_vertices.reserve(vertex_count);
+        const size_t capacity = std::bit_ceil(std::max(vertex_count * 2, MIN_CAPACITY));
+        if (capacity > m_slots.size()) {
+            grow(capacity);
+        }
+    }
+
+    auto VertexWelder::insert(const Vertex& vertex) -> uint32_t {
+        if ((m_vertices.size() + 1) * 2 > m_slots.size()) {
+            grow(std::max(m_slots.size() * 2, MIN_CAPACITY));
+        }
+
+        const Key key = make_key(vertex);
+        const uint64_t hash = hash_key(key);
+        const uint32_t tag = static_cast<uint32_t>(hash >> 32);
+        const size_t mask = m_slots.size() - 1;
+
+        for (size_t i = hash & mask;; i = (i + 1) & mask) {
+            Slot& slot = m_slots[i];
+            if (slot.index == EMPTY_SLOT) {
+                slot.index = static_cast<uint32_t>(m_vertices.size());
+                slot.tag = tag;
+                m_vertices.push_back(vertex);
+                return slot.index;
+            }
+            if (slot.tag == tag && make_key(m_vertices[slot.index]) == key) {
+                return slot.index;
+            }
+        }
+    }
+
+    auto VertexWelder::take_vertices() -> std::vector<Vertex> {
+        m_slots.clear();
+        return std::exchange(m_vertices, {});
+    }
+
+    auto VertexWelder::clear() -> void {
+        m_vertices.clear();
+        std::ranges::fill(m_slots, Slot{});
+    }
+
+    auto VertexWelder::make_key(const Vertex& vertex) const -> Key {
+        const auto components = std::bit_cast<std::array<float, std::tuple_size_v<Key>>>(vertex);
+        Key key;
+        if (m_config.position_epsilon <= 0.0f && m_config.attribute_epsilon <= 0.0f) {
+            std::ranges::transform(components, key.begin(), exact_bits);
+            return key;
+        }
+
+        static_assert(offsetof(Vertex, position) == 0, "Position must lead the vertex");
+        constexpr size_t position_end = sizeof(Vertex::position) / sizeof(float);
+        for (size_t i = 0; i < components.size(); ++i) {
+            const float epsilon = i < position_end ? m_config.position_epsilon : m_config.attribute_epsilon;
+            key[i] = epsilon > 0.0f ? snapped_bits(components[i], 1.0f / epsilon) : exact_bits(components[i]);
+        }
+        return key;
+    }
+
+    auto VertexWelder::grow(size_t capacity) -> void {
+        m_slots.assign(capacity, Slot{});
+        const size_t mask = capacity - 1;
+        for (uint32_t index = 0; index < m_vertices.size(); ++index) {
+            const uint64_t hash = hash_key(make_key(m_vertices[index]));
+            size_t i = hash & mask;
+            while (m_slots[i].index != EMPTY_SLOT) {
+                i = (i + 1) & mask;
+            }
+            m_slots[i] = {index, static_cast<uint32_t>(hash >> 32)};
+        }
+    }
+} // namespace klingon
@@ -1,9 +1,33 @@
 #include "klingon/model_data.hpp"
+#include "klingon/texture_manager.hpp"
 #include <algorithm>
 #include <functional>
 
 namespace klingon {
 
+ModelData::~ModelData() {
+    // Deferred: frames still in flight may draw these meshes
+    if (resources) {
+        for (MeshHandle mesh : meshes) {
+            resources->release_mesh(mesh);
+        }
+    }
+
+    // One reference per uploaded material and per texture it loaded; defaults are ignored by both.
+    // Queued: the last reference may go on any thread while the render thread streams textures
+    if (textures) {
+        for (uint32_t index : material_buffer_indices) {
+            textures->queue_release_material(index);
+        }
+        for (const auto& material : materials) {
+            textures->queue_release_texture(material.gpu_data.albedo_texture_index);
+            textures->queue_release_texture(material.gpu_data.normal_texture_index);
+            textures->queue_release_texture(material.gpu_data.pbr_texture_index);
+            textures->queue_release_texture(material.gpu_data.opacity_texture_index);
+        }
+    }
+}
+
 auto ModelData::get_node_world_matrix(uint32_t node_index, const glm::mat4& model_root_matrix) const -> glm::mat4 {
     if (node_index >= nodes.size()) {
         return model_root_matrix;
@@ -3,8 +3,7 @@
 #include <limits>
 
 namespace klingon {
-    // TODO: Remove references to GLFWwindow and use our Window wrapper
-    auto MovementController::update(GLFWwindow *window, float delta_time, Transform &transform) -> void {
+    auto MovementController::update(const borg::Input &input, float delta_time, Transform &transform) -> void {
         // Don't move if in UI mode
         if (m_ui_mode) {
             return;
@@ -17,22 +16,22 @@ namespace klingon {
 
         glm::vec3 move_dir{0.f};
 
-        if (::glfwGetKey(window, keys.move_forward) == GLFW_PRESS) {
+        if (input.is_key_pressed(keys.move_forward)) {
             move_dir += forward_dir;
         }
-        if (::glfwGetKey(window, keys.move_backward) == GLFW_PRESS) {
+        if (input.is_key_pressed(keys.move_backward)) {
             move_dir -= forward_dir;
         }
-        if (::glfwGetKey(window, keys.move_left) == GLFW_PRESS) {
+        if (input.is_key_pressed(keys.move_left)) {
             move_dir -= right_dir;
         }
-        if (::glfwGetKey(window, keys.move_right) == GLFW_PRESS) {
+        if (input.is_key_pressed(keys.move_right)) {
             move_dir += right_dir;
         }
-        if (::glfwGetKey(window, keys.move_up) == GLFW_PRESS) {
+        if (input.is_key_pressed(keys.move_up)) {
             move_dir -= up_dir;
         }
-        if (::glfwGetKey(window, keys.move_down) == GLFW_PRESS) {
+        if (input.is_key_pressed(keys.move_down)) {
             move_dir += up_dir;
         }
 
@@ -20,7 +20,7 @@ namespace klingon {
             float t = 0.0f;
 
             if (obj.model_data) {
-                for (const auto& mesh : obj.model_data->meshes) {
+                for (size_t mesh_idx = 0; mesh_idx < obj.model_data->meshes.size(); ++mesh_idx) {
                     // AABB intersection for models
                     glm::mat4 model_matrix = obj.transform.mat4();
                     glm::mat4 inv_model_matrix = glm::inverse(model_matrix);
@@ -28,7 +28,7 @@ namespace klingon {
                     glm::vec3 local_ray_origin = glm::vec3(inv_model_matrix * glm::vec4(ray_origin, 1.0f));
                     glm::vec3 local_ray_dir = glm::normalize(glm::vec3(inv_model_matrix * glm::vec4(ray_dir, 0.0f)));
 
-                    const auto& aabb = mesh->get_aabb();
+                    const auto& aabb = obj.model_data->get_mesh(mesh_idx).get_aabb();
                     if (ray_aabb_intersect(local_ray_origin, local_ray_dir, aabb.min, aabb.max, t)) {
                         glm::vec3 local_hit_point = local_ray_origin + local_ray_dir * t;
                         glm::vec3 world_hit_point = glm::vec3(model_matrix * glm::vec4(local_hit_point, 1.0f));
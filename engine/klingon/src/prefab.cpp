@@ -0,0 +1,29 @@
+#include "klingon/prefab.hpp"
+#include "klingon/model/asset_loader.hpp"
+#include "federation/log.hpp"
+
+#include <cassert>
+
+namespace klingon {
+    auto Prefab::add_node(Node node) -> uint32_t {
+        const auto index = static_cast<uint32_t>(nodes.size());
+        assert((node.parent == NO_PARENT || node.parent < index) && "Prefab parents must come before their children");
+        nodes.push_back(std::move(node));
+        return index;
+    }
+
+    auto Prefab::from_model(AssetLoader& asset_loader, const AssetPath& model_filepath) -> Prefab {
+        Prefab prefab;
+        prefab.name = model_filepath;
+
+        Node node;
+        node.name = model_filepath;
+        node.model_filepath = model_filepath;
+        node.model_data = asset_loader.load_model(prefab.name);
+        if (!node.model_data) {
+            FED_ERROR("Failed to load model '{}' for prefab", model_filepath.str());
+        }
+        prefab.add_node(std::move(node));
+        return prefab;
+    }
+} // namespace klingon
@@ -4,6 +4,8 @@
 #include "federation/log.hpp"
 
 #include <algorithm>
+#include <chrono>
+#include <fstream>
 #include <queue>
 #include <stdexcept>
 
@@ -66,7 +68,9 @@ namespace klingon {
             );
 
             m_needs_recompile = false;
-            FED_INFO("RenderGraph compiled successfully with {} passes", m_compiled->get_pass_count());
+            FED_INFO("RenderGraph compiled successfully with {} passes ({} culled) in {:.3f} ms",
+                     m_compiled->get_pass_count(), m_compiled->get_culled_passes().size(),
+                     m_compiled->get_compile_time_ms());
             return true;
         } catch (const std::exception &e) {
             FED_ERROR("Failed to compile render graph: {}", e.what());
@@ -128,10 +132,83 @@ namespace klingon {
         return m_compiled ? m_compiled->get_pass_count() : 0;
     }
 
+    auto RenderGraph::get_culled_pass_count() const -> std::size_t {
+        return m_compiled ? m_compiled->get_culled_passes().size() : 0;
+    }
+
+    auto RenderGraph::get_compile_time_ms() const -> double {
+        return m_compiled ? m_compiled->get_compile_time_ms() : 0.0;
+    }
+
+    auto RenderGraph::export_dot() const -> std::string {
+        return m_compiled ? m_compiled->export_dot() : std::string{};
+    }
+
+    auto RenderGraph::export_json() const -> std::string {
+        return m_compiled ? m_compiled->export_json() : std::string{};
+    }
+
+    auto RenderGraph::dump(const std::filesystem::path &path) const -> bool {
+        if (!m_compiled) {
+            FED_ERROR("Cannot dump render graph: graph not compiled");
+            return false;
+        }
+
+        auto write_file = [](const std::filesystem::path &file, const std::string &contents) {
+            std::ofstream out(file, std::ios::binary | std::ios::trunc);
+            if (!out) {
+                FED_ERROR("Failed to open '{}' for writing", file.string());
+                return false;
+            }
+            out << contents;
+            return static_cast<bool>(out);
+        };
+
+        auto dot_path = path;
+        dot_path.replace_extension(".dot");
+        auto json_path = path;
+        json_path.replace_extension(".json");
+
+        if (!write_file(dot_path, m_compiled->export_dot()) || !write_file(json_path, m_compiled->export_json())) {
+            return false;
+        }
+
+        FED_INFO("Render graph written to '{}' and '{}'", dot_path.string(), json_path.string());
+        return true;
+    }
+
     auto RenderGraph::invalidate() -> void {
         m_needs_recompile = true;
     }
 
+    auto RenderGraph::resize_image(
+        batleth::ResourceHandle handle,
+        VkExtent2D extent,
+        std::uint64_t retire_after
+    ) -> bool {
+        if (!m_compiled) {
+            return false;
+        }
+        return m_compiled->resize_image(handle, extent, retire_after);
+    }
+
+    auto RenderGraph::resize_buffer(
+        batleth::ResourceHandle handle,
+        VkDeviceSize size,
+        std::uint64_t retire_after
+    ) -> bool {
+        if (!m_compiled) {
+            return false;
+        }
+        return m_compiled->resize_buffer(handle, size, retire_after);
+    }
+
+    auto RenderGraph::collect_retired(std::uint64_t completed_frame) -> void {
+        if (m_compiled) {
+            m_compiled->collect_retired(completed_frame);
+        }
+    }
+
     auto RenderGraph::get_render_extent() const -> VkExtent2D {
         return m_backbuffer.extent;
     }
@@ -148,19 +225,21 @@ namespace klingon {
     // ============================================================================
 
     RenderGraphBuilder::RenderGraphBuilder(batleth::Device &device)
-        : m_device(device) {
+        : m_device(&device) {
     }
 
+    RenderGraphBuilder::RenderGraphBuilder() = default;
+
     RenderGraphBuilder::~RenderGraphBuilder() = default;
 
     auto RenderGraphBuilder::create_image(
-        const std::string &name,
+        std::string_view name,
         const batleth::ImageResourceDesc &desc
     ) -> batleth::ResourceHandle {
         batleth::ResourceHandle handle = m_next_handle++;
 
         batleth::ResourceDesc resource{};
-        resource.name = name;
+        resource.name = federation::NameRegistry::intern(name);
         resource.type = batleth::ResourceType::Image;
         resource.desc = desc;
 
@@ -171,13 +250,13 @@ namespace klingon {
     }
 
     auto RenderGraphBuilder::create_buffer(
-        const std::string &name,
+        std::string_view name,
         const batleth::BufferResourceDesc &desc
     ) -> batleth::ResourceHandle {
         batleth::ResourceHandle handle = m_next_handle++;
 
         batleth::ResourceDesc resource{};
-        resource.name = name;
+        resource.name = federation::NameRegistry::intern(name);
         resource.type = batleth::ResourceType::Buffer;
         resource.desc = desc;
 
@@ -188,7 +267,7 @@ namespace klingon {
     }
 
     auto RenderGraphBuilder::import_external(
-        const std::string &name,
+        std::string_view name,
         const ExternalResource &external
     ) -> batleth::ResourceHandle {
         batleth::ResourceHandle handle = external.handle;
@@ -198,15 +277,16 @@ namespace klingon {
             m_next_handle = handle + 1;
         }
 
-        // Add placeholder resource desc
-        while (m_resources.size() <= handle) {
-            batleth::ResourceDesc placeholder{};
-            placeholder.name = "placeholder";
-            m_resources.push_back(placeholder);
+        // Pad with unnamed placeholder descs up to the imported handle
+        if (m_resources.size() <= handle) {
+            m_resources.resize(handle + 1);
+        }
+        if (m_externals.size() <= handle) {
+            m_externals.resize(handle + 1);
         }
 
         batleth::ResourceDesc resource{};
-        resource.name = name;
+        resource.name = federation::NameRegistry::intern(name);
         resource.type = external.type;
 
         if (external.type == batleth::ResourceType::Image) {
@@ -230,11 +310,11 @@ namespace klingon {
     }
 
     auto RenderGraphBuilder::add_graphics_pass(
-        const std::string &name,
+        std::string_view name,
         batleth::PassExecuteCallback execute
     ) -> RenderGraphBuilder & {
         batleth::PassDefinition pass{};
-        pass.config.name = name;
+        pass.config.name = federation::NameRegistry::intern(name);
         pass.config.type = batleth::PassType::Graphics;
         pass.config.queue = batleth::QueueType::Graphics;
         pass.execute = std::move(execute);
@@ -248,11 +328,11 @@ namespace klingon {
     }
 
     auto RenderGraphBuilder::add_compute_pass(
-        const std::string &name,
+        std::string_view name,
         batleth::PassExecuteCallback execute
     ) -> RenderGraphBuilder & {
         batleth::PassDefinition pass{};
-        pass.config.name = name;
+        pass.config.name = federation::NameRegistry::intern(name);
         pass.config.type = batleth::PassType::Compute;
         pass.config.queue = batleth::QueueType::Compute;
         pass.execute = std::move(execute);
@@ -266,11 +346,11 @@ namespace klingon {
     }
 
     auto RenderGraphBuilder::add_transfer_pass(
-        const std::string &name,
+        std::string_view name,
         batleth::PassExecuteCallback execute
     ) -> RenderGraphBuilder & {
         batleth::PassDefinition pass{};
-        pass.config.name = name;
+        pass.config.name = federation::NameRegistry::intern(name);
         pass.config.type = batleth::PassType::Transfer;
         pass.config.queue = batleth::QueueType::Transfer;
         pass.execute = std::move(execute);
@@ -285,7 +365,8 @@ namespace klingon {
 
     auto RenderGraphBuilder::read(
         batleth::ResourceHandle handle,
-        batleth::ResourceUsage usage
+        batleth::ResourceUsage usage,
+        const batleth::SubresourceRange &range
     ) -> RenderGraphBuilder & {
         if (!m_current_pass) {
             FED_ERROR("No current pass - call add_*_pass() first");
@@ -295,6 +376,7 @@ namespace klingon {
         batleth::ResourceAccess access{};
         access.handle = handle;
         access.usage = usage;
+        access.range = range;
 
         m_current_pass->config.reads.push_back(access);
         return *this;
@@ -302,7 +384,8 @@ namespace klingon {
 
     auto RenderGraphBuilder::write(
         batleth::ResourceHandle handle,
-        batleth::ResourceUsage usage
+        batleth::ResourceUsage usage,
+        const batleth::SubresourceRange &range
     ) -> RenderGraphBuilder & {
         if (!m_current_pass) {
             FED_ERROR("No current pass - call add_*_pass() first");
@@ -312,6 +395,7 @@ namespace klingon {
         batleth::ResourceAccess access{};
         access.handle = handle;
         access.usage = usage;
+        access.range = range;
 
         m_current_pass->config.writes.push_back(access);
         return *this;
@@ -375,10 +459,16 @@ namespace klingon {
         return *this;
     }
 
+    auto RenderGraphBuilder::retain(batleth::ResourceHandle handle) -> RenderGraphBuilder & {
+        m_retained.push_back(handle);
+        return *this;
+    }
+
     auto RenderGraphBuilder::clear() -> void {
         m_resources.clear();
         m_passes.clear();
         m_externals.clear();
+        m_retained.clear();
         m_current_pass = nullptr;
         m_next_handle = 0;
     }
@@ -387,15 +477,19 @@ namespace klingon {
         return m_resources;
     }
 
-    auto RenderGraphBuilder::get_passes() -> std::vector<batleth::PassDefinition> & {
-        return m_passes;
+    auto RenderGraphBuilder::take_passes() -> std::vector<batleth::PassDefinition> {
+        m_current_pass = nullptr;
+        return std::move(m_passes);
     }
 
-    auto RenderGraphBuilder::get_external_resources() const -> const std::unordered_map<batleth::ResourceHandle,
-        ExternalResource> & {
+    auto RenderGraphBuilder::get_external_resources() const -> const std::vector<ExternalResource> & {
         return m_externals;
     }
 
+    auto RenderGraphBuilder::get_retained_resources() const -> const std::vector<batleth::ResourceHandle> & {
+        return m_retained;
+    }
+
     // ============================================================================
     // CompiledRenderGraph Implementation
     // ============================================================================
@@ -406,14 +500,8 @@ namespace klingon {
         VkInstance instance,
         VkPhysicalDevice physical_device
     )
-        : m_device(device) {
-        // Copy resources and passes from builder
-        m_resources = builder.get_resources();
-        m_passes = builder.get_passes();
-        m_externals = builder.get_external_resources();
-
-        // Initialize physical resources vector
-        m_physical_resources.resize(m_resources.size());
+        : CompiledRenderGraph(builder) {
+        m_device = &device;
 
         // Create transient allocator
         batleth::TransientAllocator::Config alloc_config{};
@@ -424,63 +512,121 @@ namespace klingon {
         m_allocator = std::make_unique<batleth::TransientAllocator>(alloc_config);
         m_barrier_batcher = std::make_unique<batleth::BarrierBatcher>();
 
+        allocate_resources();
+
+        // GPU pass timing needs timestamp support on the queue the graph is recorded for
+        VkPhysicalDeviceProperties properties{};
+        ::vkGetPhysicalDeviceProperties(physical_device, &properties);
+
+        std::uint32_t family_count = 0;
+        ::vkGetPhysicalDeviceQueueFamilyProperties(physical_device, &family_count, nullptr);
+        std::vector<VkQueueFamilyProperties> families(family_count);
+        ::vkGetPhysicalDeviceQueueFamilyProperties(physical_device, &family_count, families.data());
+
+        const std::uint32_t graphics_family = device.get_graphics_queue_family();
+        if (graphics_family < family_count && families[graphics_family].timestampValidBits != 0) {
+            m_timestamp_period = properties.limits.timestampPeriod;
+        }
+
+        FED_INFO("CompiledRenderGraph created with {} passes ({:.3f} ms graph analysis, {} barriers, {} eliminated)",
+                 m_passes.size(), m_compile_time_ms, m_barriers.stats.emitted, m_barriers.stats.eliminated);
+    }
+
+    CompiledRenderGraph::CompiledRenderGraph(RenderGraphBuilder &builder) {
+        // Take resources and passes from builder
+        m_resources = builder.get_resources();
+        m_passes = builder.take_passes();
+        m_externals = builder.get_external_resources();
+        m_externals.resize(m_resources.size());
+
+        // Initialize physical resources vector
+        m_physical_resources.resize(m_resources.size());
+
+        // Externals and explicitly retained resources are the roots for culling
+        m_retained.assign(m_resources.size(), false);
+        for (batleth::ResourceHandle handle = 0; handle < m_resources.size(); ++handle) {
+            m_retained[handle] = is_external(handle);
+        }
+        for (auto handle: builder.get_retained_resources()) {
+            if (handle < m_retained.size()) {
+                m_retained[handle] = true;
+            }
+        }
+
         // Compile the graph
+        auto compile_start = std::chrono::steady_clock::now();
         topological_sort();
-        compute_lifetimes();
-        allocate_resources();
-        compute_barriers();
+        cull_passes();
+        infer_attachment_ops();
+        analyze_accesses();
+        m_compile_time_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - compile_start).count();
 
-        FED_INFO("CompiledRenderGraph created with {} passes", m_passes.size());
+        m_pass_timings.assign(m_passes.size(), {});
     }
 
-    CompiledRenderGraph::~CompiledRenderGraph() = default;
+    auto CompiledRenderGraph::analyze(RenderGraphBuilder &builder) -> std::unique_ptr<CompiledRenderGraph> {
+        return std::unique_ptr<CompiledRenderGraph>(new CompiledRenderGraph(builder));
+    }
+
+    CompiledRenderGraph::~CompiledRenderGraph() {
+        if (!m_device) {
+            return;  // Analysis only, nothing was created on the device
+        }
+        for (VkQueryPool pool: m_timestamp_pools) {
+            if (pool != VK_NULL_HANDLE) {
+                ::vkDestroyQueryPool(m_device->get_logical_device(), pool, nullptr);
+            }
+        }
+        for (const auto &events: m_split_events) {
+            for (VkEvent event: events) {
+                ::vkDestroyEvent(m_device->get_logical_device(), event, nullptr);
+            }
+        }
+    }
 
     auto CompiledRenderGraph::topological_sort() -> void {
         const std::size_t n = m_passes.size();
         if (n == 0) return;
 
-        // Build adjacency list based on resource dependencies
-        std::vector<std::vector<std::uint32_t> > adj(n);
+        // Edges are stored on the producing pass (dependents) and counted on the consumer
         std::vector<std::uint32_t> in_degree(n, 0);
 
-        // Map resources to the last pass that wrote them
-        std::unordered_map<batleth::ResourceHandle, std::uint32_t> last_writer;
+        // Last pass that wrote each resource, indexed by handle
+        constexpr std::uint32_t no_writer = ~0u;
+        std::vector<std::uint32_t> last_writer(m_resources.size(), no_writer);
+
+        auto add_edge = [&](batleth::ResourceHandle handle, std::uint32_t consumer) {
+            if (handle >= last_writer.size()) return;
+            std::uint32_t producer = last_writer[handle];
+            if (producer != no_writer && producer != consumer) {
+                m_passes[producer].dependents.push_back(consumer);
+                m_passes[consumer].dependencies.push_back(producer);
+                in_degree[consumer]++;
+            }
+        };
 
         for (std::uint32_t i = 0; i < n; ++i) {
-            auto &pass = m_passes[i];
+            const auto &config = m_passes[i].config;
 
             // Check reads - depend on last writer
-            for (const auto &access: pass.config.reads) {
-                auto it = last_writer.find(access.handle);
-                if (it != last_writer.end() && it->second != i) {
-                    adj[it->second].push_back(i);
-                    in_degree[i]++;
-                    pass.dependencies.push_back(it->second);
-                }
+            for (const auto &access: config.reads) {
+                add_edge(access.handle, i);
             }
 
             // Check color attachments as reads if load_op is LOAD
-            for (const auto &attachment: pass.config.color_attachments) {
+            for (const auto &attachment: config.color_attachments) {
                 if (attachment.load_op == VK_ATTACHMENT_LOAD_OP_LOAD) {
-                    auto it = last_writer.find(attachment.handle);
-                    if (it != last_writer.end() && it->second != i) {
-                        adj[it->second].push_back(i);
-                        in_degree[i]++;
-                        pass.dependencies.push_back(it->second);
-                    }
+                    add_edge(attachment.handle, i);
                 }
             }
 
-            // Update last writer for writes
-            for (const auto &access: pass.config.writes) {
-                // Check for WAW dependency
-                auto it = last_writer.find(access.handle);
-                if (it != last_writer.end() && it->second != i) {
-                    adj[it->second].push_back(i);
-                    in_degree[i]++;
-                    pass.dependencies.push_back(it->second);
+            // Update last writer for writes, checking for WAW dependency
+            for (const auto &access: config.writes) {
+                add_edge(access.handle, i);
+                if (access.handle < last_writer.size()) {
+                    last_writer[access.handle] = i;
                 }
-                last_writer[access.handle] = i;
             }
         }
 
@@ -500,7 +646,7 @@ namespace klingon {
             queue.pop();
             order.push_back(u);
 
-            for (std::uint32_t v: adj[u]) {
+            for (std::uint32_t v: m_passes[u].dependents) {
                 if (--in_degree[v] == 0) {
                     queue.push(v);
                 }
@@ -513,212 +659,427 @@ namespace klingon {
         }
 
         // Reorder passes
-        std::vector<batleth::PassDefinition> sorted_passes(n);
+        std::vector<batleth::PassDefinition> sorted_passes;
+        sorted_passes.reserve(n);
         for (std::uint32_t i = 0; i < n; ++i) {
-            sorted_passes[i] = std::move(m_passes[order[i]]);
-            sorted_passes[i].topological_order = i;
+            sorted_passes.push_back(std::move(m_passes[order[i]]));
+            sorted_passes.back().topological_order = i;
         }
         m_passes = std::move(sorted_passes);
 
         FED_DEBUG("Topological sort complete");
     }
 
-    auto CompiledRenderGraph::compute_lifetimes() -> void {
-        for (const auto &pass: m_passes) {
-            std::uint32_t pass_idx = pass.topological_order;
+    auto CompiledRenderGraph::cull_passes() -> void {
+        // Walk passes back to front. A pass is live if any of its writes reach a resource
+        // that is needed downstream; a live pass makes everything it reads needed in turn.
+        std::vector<bool> needed = m_retained;
+        std::vector<bool> alive(m_passes.size(), false);
 
-            // Update lifetimes for read resources
-            for (const auto &access: pass.config.reads) {
-                auto &lifetime = m_lifetimes[access.handle];
-                if (lifetime.first_pass > pass_idx || m_lifetimes.find(access.handle) == m_lifetimes.end()) {
-                    lifetime.first_pass = pass_idx;
-                }
-                lifetime.last_pass = std::max(lifetime.last_pass, pass_idx);
+        auto is_needed = [&needed](batleth::ResourceHandle handle) {
+            return handle < needed.size() && needed[handle];
+        };
+        auto mark_needed = [&needed](batleth::ResourceHandle handle) {
+            if (handle < needed.size()) {
+                needed[handle] = true;
             }
+        };
 
-            // Update lifetimes for write resources
-            for (const auto &access: pass.config.writes) {
-                auto &lifetime = m_lifetimes[access.handle];
-                if (lifetime.first_pass > pass_idx || m_lifetimes.find(access.handle) == m_lifetimes.end()) {
-                    lifetime.first_pass = pass_idx;
-                }
-                lifetime.last_pass = std::max(lifetime.last_pass, pass_idx);
+        for (std::size_t i = m_passes.size(); i-- > 0;) {
+            const auto &config = m_passes[i].config;
+
+            bool writes_needed = false;
+            for (const auto &access: config.writes) {
+                writes_needed = writes_needed || is_needed(access.handle);
+            }
+            for (const auto &attachment: config.color_attachments) {
+                writes_needed = writes_needed || is_needed(attachment.handle);
+            }
+            if (config.has_depth_attachment) {
+                writes_needed = writes_needed || is_needed(config.depth_attachment.handle);
             }
 
-            // Update for attachments
-            for (const auto &attachment: pass.config.color_attachments) {
-                if (attachment.handle != batleth::INVALID_RESOURCE) {
-                    auto &lifetime = m_lifetimes[attachment.handle];
-                    if (lifetime.first_pass > pass_idx || m_lifetimes.find(attachment.handle) == m_lifetimes.end()) {
-                        lifetime.first_pass = pass_idx;
-                    }
-                    lifetime.last_pass = std::max(lifetime.last_pass, pass_idx);
-                }
+            if (!writes_needed) {
+                continue;
             }
 
-            if (pass.config.has_depth_attachment) {
-                auto &lifetime = m_lifetimes[pass.config.depth_attachment.handle];
-                if (lifetime.first_pass > pass_idx || m_lifetimes.find(pass.config.depth_attachment.handle) ==
-                    m_lifetimes.end()) {
-                    lifetime.first_pass = pass_idx;
+            alive[i] = true;
+
+            for (const auto &access: config.reads) {
+                mark_needed(access.handle);
+            }
+
+            // Read-modify-write accesses depend on the previous contents. Attachment
+            // usages are decided by their load op instead of the usage flags.
+            for (const auto &access: config.writes) {
+                bool is_attachment_usage = access.usage == batleth::ResourceUsage::ColorAttachment ||
+                                           access.usage == batleth::ResourceUsage::DepthStencilWrite ||
+                                           access.usage == batleth::ResourceUsage::DepthStencilReadWrite;
+                if (!is_attachment_usage && batleth::is_read_usage(access.usage)) {
+                    mark_needed(access.handle);
                 }
-                lifetime.last_pass = std::max(lifetime.last_pass, pass_idx);
+            }
+            for (const auto &attachment: config.color_attachments) {
+                if (attachment.load_op == VK_ATTACHMENT_LOAD_OP_LOAD) {
+                    mark_needed(attachment.handle);
+                }
+            }
+            if (config.has_depth_attachment && config.depth_attachment.load_op == VK_ATTACHMENT_LOAD_OP_LOAD) {
+                mark_needed(config.depth_attachment.handle);
             }
         }
 
-        FED_DEBUG("Computed lifetimes for {} resources", m_lifetimes.size());
+        std::vector<batleth::PassDefinition> live_passes;
+        live_passes.reserve(m_passes.size());
+        for (std::size_t i = 0; i < m_passes.size(); ++i) {
+            if (!alive[i]) {
+                FED_DEBUG("Culled pass '{}' - no writes reach an external or retained resource",
+                          federation::NameRegistry::lookup(m_passes[i].config.name));
+                m_culled_passes.push_back(m_passes[i].config.name);
+                continue;
+            }
+            m_passes[i].topological_order = static_cast<std::uint32_t>(live_passes.size());
+            live_passes.push_back(std::move(m_passes[i]));
+        }
+        m_passes = std::move(live_passes);
     }
 
-    auto CompiledRenderGraph::allocate_resources() -> void {
-        for (batleth::ResourceHandle handle = 0; handle < m_resources.size(); ++handle) {
-            const auto &resource = m_resources[handle];
+    auto CompiledRenderGraph::infer_attachment_ops() -> void {
+        const std::size_t resource_count = m_resources.size();
 
-            // Skip external resources
-            if (m_externals.find(handle) != m_externals.end()) {
-                continue;
-            }
+        // Load ops: a LOAD with no earlier producer in this graph would read undefined
+        // contents. Externals with an undefined initial layout get a deterministic clear,
+        // graph-owned resources skip the load entirely.
+        std::vector<bool> produced(resource_count, false);
 
-            // Skip placeholder resources
-            if (resource.name == "placeholder") {
-                continue;
+        auto infer_load = [&](batleth::ResourceHandle handle, VkAttachmentLoadOp &load_op) {
+            if (handle >= resource_count || load_op != VK_ATTACHMENT_LOAD_OP_LOAD || produced[handle]) {
+                return;
             }
-
-            auto lifetime_it = m_lifetimes.find(handle);
-            if (lifetime_it == m_lifetimes.end()) {
-                FED_WARN("Resource '{}' has no lifetime - may be unused", resource.name);
-                continue;
+            if (!is_external(handle)) {
+                load_op = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+            } else if (m_externals[handle].initial_state.layout == VK_IMAGE_LAYOUT_UNDEFINED) {
+                load_op = VK_ATTACHMENT_LOAD_OP_CLEAR;
             }
+        };
 
-            const auto &lifetime = lifetime_it->second;
+        for (auto &pass: m_passes) {
+            auto &config = pass.config;
+            for (auto &attachment: config.color_attachments) {
+                infer_load(attachment.handle, attachment.load_op);
+            }
+            if (config.has_depth_attachment) {
+                infer_load(config.depth_attachment.handle, config.depth_attachment.load_op);
+            }
 
-            if (resource.type == batleth::ResourceType::Image) {
-                const auto &desc = resource.get_image_desc();
-                auto physical = m_allocator->allocate_image(desc, lifetime);
+            for (const auto &access: config.writes) {
+                if (access.handle < resource_count) {
+                    produced[access.handle] = true;
+                }
+            }
+            for (const auto &attachment: config.color_attachments) {
+                if (attachment.handle < resource_count) {
+                    produced[attachment.handle] = true;
+                }
+            }
+            if (config.has_depth_attachment && config.depth_attachment.handle < resource_count) {
+                produced[config.depth_attachment.handle] = true;
+            }
+        }
 
-                m_physical_resources[handle].type = batleth::ResourceType::Image;
-                m_physical_resources[handle].resource = physical;
+        // Store ops: walk back to front tracking whether the current contents of each
+        // resource are consumed later. Only a later read or LOAD keeps a store; a later
+        // CLEAR/DONT_CARE attachment overwrites everything.
+        std::vector<bool> contents_consumed = m_retained;
+        m_tile_local.assign(resource_count, true);
+
+        std::uint32_t discarded_stores = 0;
+        for (std::size_t i = m_passes.size(); i-- > 0;) {
+            auto &config = m_passes[i].config;
+
+            for (auto &attachment: config.color_attachments) {
+                if (attachment.handle >= resource_count) continue;
+                attachment.store_op = contents_consumed[attachment.handle]
+                                          ? VK_ATTACHMENT_STORE_OP_STORE
+                                          : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            }
+            if (config.has_depth_attachment && config.depth_attachment.handle < resource_count) {
+                config.depth_attachment.store_op = contents_consumed[config.depth_attachment.handle]
+                                                       ? VK_ATTACHMENT_STORE_OP_STORE
+                                                       : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            }
 
-                FED_DEBUG("Allocated image '{}' (handle {})", resource.name, handle);
-            } else {
-                const auto &desc = resource.get_buffer_desc();
-                auto physical = m_allocator->allocate_buffer(desc, lifetime);
+            // Overwriting attachments end the previous contents' live range
+            auto overwrite = [&](batleth::ResourceHandle handle, VkAttachmentLoadOp load_op,
+                                 VkAttachmentStoreOp store_op) {
+                if (handle >= resource_count) return;
+                if (store_op == VK_ATTACHMENT_STORE_OP_STORE) {
+                    m_tile_local[handle] = false;
+                } else {
+                    ++discarded_stores;
+                }
+                if (load_op == VK_ATTACHMENT_LOAD_OP_LOAD) {
+                    m_tile_local[handle] = false;
+                } else {
+                    contents_consumed[handle] = false;
+                }
+            };
 
-                m_physical_resources[handle].type = batleth::ResourceType::Buffer;
-                m_physical_resources[handle].resource = physical;
+            for (const auto &attachment: config.color_attachments) {
+                overwrite(attachment.handle, attachment.load_op, attachment.store_op);
+            }
+            if (config.has_depth_attachment) {
+                overwrite(config.depth_attachment.handle, config.depth_attachment.load_op,
+                          config.depth_attachment.store_op);
+            }
 
-                FED_DEBUG("Allocated buffer '{}' (handle {})", resource.name, handle);
+            // Non-attachment accesses need real memory; reads also keep earlier contents alive
+            for (const auto &access: config.writes) {
+                if (access.handle >= resource_count) continue;
+                bool is_attachment_usage = access.usage == batleth::ResourceUsage::ColorAttachment ||
+                                           access.usage == batleth::ResourceUsage::DepthStencilWrite ||
+                                           access.usage == batleth::ResourceUsage::DepthStencilReadWrite;
+                if (!is_attachment_usage) {
+                    m_tile_local[access.handle] = false;
+                    if (batleth::is_read_usage(access.usage)) {
+                        contents_consumed[access.handle] = true;
+                    }
+                }
+            }
+            for (const auto &access: config.reads) {
+                if (access.handle >= resource_count) continue;
+                contents_consumed[access.handle] = true;
+                if (access.usage != batleth::ResourceUsage::ColorAttachment) {
+                    m_tile_local[access.handle] = false;
+                }
+            }
+            for (const auto &attachment: config.color_attachments) {
+                if (attachment.handle < resource_count && attachment.load_op == VK_ATTACHMENT_LOAD_OP_LOAD) {
+                    contents_consumed[attachment.handle] = true;
+                }
+            }
+            if (config.has_depth_attachment && config.depth_attachment.handle < resource_count &&
+                config.depth_attachment.load_op == VK_ATTACHMENT_LOAD_OP_LOAD) {
+                contents_consumed[config.depth_attachment.handle] = true;
             }
         }
-    }
 
-    auto CompiledRenderGraph::compute_barriers() -> void {
-        m_pre_pass_barriers.resize(m_passes.size());
+        FED_DEBUG("Inferred attachment ops: {} stores discarded", discarded_stores);
+    }
 
-        // Initialize resource states
-        for (const auto &[handle, external]: m_externals) {
-            m_resource_states[handle] = external.initial_state;
-        }
+    auto CompiledRenderGraph::analyze_accesses() -> void {
+        const std::size_t resource_count = m_resources.size();
+
+        m_lifetimes.assign(resource_count, {.first_pass = ~0u, .last_pass = 0});
+
+        // Externals start in their declared state, transient resources start undefined
+        std::vector<batleth::ResourceState> initial_states(resource_count, {
+                                                               .stage_mask = VK_PIPELINE_STAGE_2_NONE,
+                                                               .access_mask = VK_ACCESS_2_NONE,
+                                                               .layout = VK_IMAGE_LAYOUT_UNDEFINED,
+                                                               .queue_family = VK_QUEUE_FAMILY_IGNORED
+                                                           });
+        std::vector<batleth::SubresourceRange> extents(resource_count, {.mip_count = 1, .layer_count = 1});
+        std::vector<batleth::StateRequirement> final_requirements;
+        for (batleth::ResourceHandle handle = 0; handle < resource_count; ++handle) {
+            if (m_resources[handle].is_image()) {
+                const auto &image = m_resources[handle].get_image_desc();
+                extents[handle].mip_count = image.mip_levels;
+                extents[handle].layer_count = image.array_layers;
+            }
 
-        // For transient resources, start undefined
-        for (batleth::ResourceHandle handle = 0; handle < m_resources.size(); ++handle) {
-            if (m_externals.find(handle) == m_externals.end()) {
-                m_resource_states[handle] = {
-                    .stage_mask = VK_PIPELINE_STAGE_2_NONE,
-                    .access_mask = VK_ACCESS_2_NONE,
-                    .layout = VK_IMAGE_LAYOUT_UNDEFINED,
-                    .queue_family = VK_QUEUE_FAMILY_IGNORED
-                };
+            if (is_external(handle)) {
+                initial_states[handle] = m_externals[handle].initial_state;
+                final_requirements.push_back({.resource = handle, .state = m_externals[handle].final_state});
             }
         }
 
-        // Compute barriers for each pass
+        std::vector<batleth::StateRequirement> requirements;
+        std::vector<std::uint32_t> requirement_offsets(m_passes.size() + 1, 0);
+
+        // Lifetimes and state requirements are gathered in a single walk over each pass's accesses.
+        // Attachments and writes come after reads so their layout wins when a pass uses a
+        // resource more than once (e.g. depth read for testing and bound as the depth attachment).
         for (std::size_t i = 0; i < m_passes.size(); ++i) {
             const auto &pass = m_passes[i];
-            auto &barriers = m_pre_pass_barriers[i];
+            const std::uint32_t pass_idx = pass.topological_order;
+            requirement_offsets[i] = static_cast<std::uint32_t>(requirements.size());
+
+            auto require = [&](batleth::ResourceHandle handle, const batleth::ResourceState &state,
+                               const batleth::SubresourceRange &range = {}) {
+                auto &lifetime = m_lifetimes[handle];
+                lifetime.first_pass = std::min(lifetime.first_pass, pass_idx);
+                lifetime.last_pass = std::max(lifetime.last_pass, pass_idx);
+                requirements.push_back({.resource = handle, .state = state, .range = range});
+            };
 
-            // Process reads
             for (const auto &access: pass.config.reads) {
-                auto required_state = batleth::compute_resource_state(access);
-                auto &current_state = m_resource_states[access.handle];
-
-                if (batleth::needs_barrier(current_state, required_state)) {
-                    barriers.push_back({
-                        .resource = access.handle,
-                        .before = current_state,
-                        .after = required_state
-                    });
-                    current_state = required_state;
-                }
+                if (access.handle >= resource_count) continue;
+                require(access.handle, batleth::compute_resource_state(access), access.range);
             }
 
-            // Process attachments
             for (const auto &attachment: pass.config.color_attachments) {
-                if (attachment.handle == batleth::INVALID_RESOURCE) continue;
-
-                batleth::ResourceState required_state{
-                    .stage_mask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
-                    .access_mask = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT |
-                                   (attachment.load_op == VK_ATTACHMENT_LOAD_OP_LOAD
-                                        ? VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT
-                                        : 0),
-                    .layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-                    .queue_family = VK_QUEUE_FAMILY_IGNORED
-                };
-
-                auto &current_state = m_resource_states[attachment.handle];
-                if (batleth::needs_barrier(current_state, required_state)) {
-                    barriers.push_back({
-                        .resource = attachment.handle,
-                        .before = current_state,
-                        .after = required_state
-                    });
-                }
-                current_state = required_state;
-            }
-
-            if (pass.config.has_depth_attachment) {
-                auto handle = pass.config.depth_attachment.handle;
-                batleth::ResourceState required_state{
-                    .stage_mask = VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT |
-                                  VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
-                    .access_mask = VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
-                                   VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT,
-                    .layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
-                    .queue_family = VK_QUEUE_FAMILY_IGNORED
-                };
-
-                auto &current_state = m_resource_states[handle];
-                if (batleth::needs_barrier(current_state, required_state)) {
-                    barriers.push_back({
-                        .resource = handle,
-                        .before = current_state,
-                        .after = required_state
-                    });
-                }
-                current_state = required_state;
+                if (attachment.handle >= resource_count) continue;
+                require(attachment.handle, {
+                            .stage_mask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+                            .access_mask = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT |
+                                           (attachment.load_op == VK_ATTACHMENT_LOAD_OP_LOAD
+                                                ? VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT
+                                                : 0),
+                            .layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                            .queue_family = VK_QUEUE_FAMILY_IGNORED
+                        });
+            }
+
+            if (pass.config.has_depth_attachment && pass.config.depth_attachment.handle < resource_count) {
+                require(pass.config.depth_attachment.handle, {
+                            .stage_mask = VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT |
+                                          VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+                            .access_mask = VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+                                           VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT,
+                            .layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                            .queue_family = VK_QUEUE_FAMILY_IGNORED
+                        });
             }
 
-            // Process writes (update state after pass)
             for (const auto &access: pass.config.writes) {
-                auto new_state = batleth::compute_resource_state(access);
-                m_resource_states[access.handle] = new_state;
+                if (access.handle >= resource_count) continue;
+                require(access.handle, batleth::compute_resource_state(access), access.range);
+            }
+        }
+        requirement_offsets[m_passes.size()] = static_cast<std::uint32_t>(requirements.size());
+
+        m_barriers = batleth::optimize_barriers({
+            .initial_states = initial_states,
+            .subresource_extents = extents,
+            .requirements = requirements,
+            .requirement_offsets = requirement_offsets,
+            .final_requirements = final_requirements
+        });
+
+        const auto &stats = m_barriers.stats;
+        FED_DEBUG("Barriers: {} emitted ({} split), {} eliminated, {} merged, {} batches",
+                  stats.emitted, stats.split, stats.eliminated, stats.merged, stats.batches);
+    }
+
+    auto CompiledRenderGraph::allocate_resources() -> void {
+        for (batleth::ResourceHandle handle = 0; handle < m_resources.size(); ++handle) {
+            // Skip external and placeholder resources
+            if (is_external(handle) || m_resources[handle].is_placeholder()) {
+                continue;
             }
+            allocate_resource(handle);
+        }
+    }
+
+    auto CompiledRenderGraph::allocate_resource(batleth::ResourceHandle handle) -> void {
+        const auto &resource = m_resources[handle];
+
+        auto name = federation::NameRegistry::lookup(resource.name);
+        const auto &lifetime = m_lifetimes[handle];
+        if (lifetime.first_pass == ~0u) {
+            FED_DEBUG("Resource '{}' has no lifetime - unused or only touched by culled passes", name);
+            return;
         }
 
-        // Compute final barriers for external resources
-        for (const auto &[handle, external]: m_externals) {
-            auto &current_state = m_resource_states[handle];
-            if (batleth::needs_barrier(current_state, external.final_state)) {
-                m_final_barriers.push_back({
-                    .resource = handle,
-                    .before = current_state,
-                    .after = external.final_state
-                });
+        if (resource.type == batleth::ResourceType::Image) {
+            auto desc = resource.get_image_desc();
+
+            // Attachments that never leave tile memory don't need backing storage.
+            // TRANSIENT_ATTACHMENT is only valid alongside attachment usages.
+            constexpr VkImageUsageFlags attachment_usages = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
+                                                            VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT |
+                                                            VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+            if (desc.is_transient && m_tile_local[handle] &&
+                (desc.usage & attachment_usages) != 0 && (desc.usage & ~attachment_usages) == 0) {
+                desc.usage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+                FED_DEBUG("Image '{}' is tile-local - using transient attachment memory", name);
             }
+
+            auto physical = m_allocator->allocate_image(desc, lifetime);
+
+            m_physical_resources[handle].type = batleth::ResourceType::Image;
+            m_physical_resources[handle].resource = physical;
+
+            FED_DEBUG("Allocated image '{}' (handle {})", name, handle);
+        } else {
+            const auto &desc = resource.get_buffer_desc();
+            auto physical = m_allocator->allocate_buffer(desc, lifetime);
+
+            m_physical_resources[handle].type = batleth::ResourceType::Buffer;
+            m_physical_resources[handle].resource = physical;
+
+            FED_DEBUG("Allocated buffer '{}' (handle {})", name, handle);
         }
+    }
 
-        FED_DEBUG("Computed barriers: {} passes, {} final barriers",
-                  m_pre_pass_barriers.size(), m_final_barriers.size());
+    auto CompiledRenderGraph::reallocate_resource(batleth::ResourceHandle handle, std::uint64_t retire_after) -> void {
+        auto &physical = m_physical_resources[handle];
+        const bool allocated = physical.is_image()
+                                   ? physical.get_image().image != VK_NULL_HANDLE
+                                   : physical.get_buffer().buffer != VK_NULL_HANDLE;
+        if (allocated) {
+            m_retired.push_back({retire_after, physical});
+            physical = {};
+        }
+        allocate_resource(handle);
+    }
+
+    auto CompiledRenderGraph::resize_image(
+        batleth::ResourceHandle handle,
+        VkExtent2D extent,
+        std::uint64_t retire_after
+    ) -> bool {
+        if (handle >= m_resources.size() || is_external(handle) || !m_resources[handle].is_image()) {
+            FED_ERROR("Cannot resize resource {}: not a graph-owned image", handle);
+            return false;
+        }
+
+        auto desc = m_resources[handle].get_image_desc();
+        if (desc.extent.width == extent.width && desc.extent.height == extent.height) {
+            return true;
+        }
+        desc.extent.width = extent.width;
+        desc.extent.height = extent.height;
+        m_resources[handle].desc = desc;
+
+        reallocate_resource(handle, retire_after);
+        return true;
+    }
+
+    auto CompiledRenderGraph::resize_buffer(
+        batleth::ResourceHandle handle,
+        VkDeviceSize size,
+        std::uint64_t retire_after
+    ) -> bool {
+        if (handle >= m_resources.size() || is_external(handle) || !m_resources[handle].is_buffer()) {
+            FED_ERROR("Cannot resize resource {}: not a graph-owned buffer", handle);
+            return false;
+        }
+
+        auto desc = m_resources[handle].get_buffer_desc();
+        if (desc.size == size) {
+            return true;
+        }
+        desc.size = size;
+        m_resources[handle].desc = desc;
+
+        reallocate_resource(handle, retire_after);
+        return true;
+    }
+
+    auto CompiledRenderGraph::collect_retired(std::uint64_t completed_frame) -> void {
+        std::erase_if(m_retired, [&](RetiredResource &retired) {
+            if (retired.retire_after > completed_frame) {
+                return false;
+            }
+            if (retired.resource.is_image()) {
+                m_allocator->free_image(retired.resource.get_image());
+            } else {
+                m_allocator->free_buffer(retired.resource.get_buffer());
+            }
+            return true;
+        });
     }
 
     auto CompiledRenderGraph::execute(
@@ -727,53 +1088,45 @@ namespace klingon {
         float delta_time,
         VkExtent2D extent
     ) -> void {
+        const auto &events = get_split_events(frame_index);
+
+        // This frame's previous submission has completed, so its events can be reset from the host
+        for (VkEvent event: events) {
+            ::vkResetEvent(m_device->get_logical_device(), event);
+        }
+
+        // The same slot's previous timestamps are complete for the same reason
+        VkQueryPool timestamps = get_timestamp_pool(frame_index);
+        if (timestamps != VK_NULL_HANDLE) {
+            read_gpu_timings(frame_index);
+            ::vkCmdResetQueryPool(cmd, timestamps, 0, static_cast<std::uint32_t>(m_passes.size() * 2));
+            m_timestamps_written[frame_index] = true;
+        }
+
         for (std::size_t i = 0; i < m_passes.size(); ++i) {
             const auto &pass = m_passes[i];
-            const auto &barriers = m_pre_pass_barriers[i];
+            const auto cpu_start = std::chrono::steady_clock::now();
+            const auto query = static_cast<std::uint32_t>(i * 2);
 
-            // Insert pre-pass barriers
-            if (!barriers.empty()) {
+            if (timestamps != VK_NULL_HANDLE) {
+                ::vkCmdWriteTimestamp2(cmd, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT, timestamps, query);
+            }
+
+            // Wait on split barriers signalled by earlier producers
+            for (std::uint32_t g = m_barriers.split_wait_offsets[i]; g < m_barriers.split_wait_offsets[i + 1]; ++g) {
+                const auto &group = m_barriers.split_groups[g];
                 m_barrier_batcher->clear();
-                for (const auto &barrier: barriers) {
-                    auto &resource = m_physical_resources[barrier.resource];
-
-                    // Check if this is an external resource
-                    auto ext_it = m_externals.find(barrier.resource);
-
-                    if (resource.is_image() || (ext_it != m_externals.end() && ext_it->second.type ==
-                                                batleth::ResourceType::Image)) {
-                        VkImage image = VK_NULL_HANDLE;
-                        VkFormat format = VK_FORMAT_UNDEFINED;
-
-                        if (ext_it != m_externals.end()) {
-                            image = ext_it->second.image;
-                            format = ext_it->second.format;
-                        } else {
-                            const auto &physical = resource.get_image();
-                            image = physical.image;
-                            format = physical.format;
-                        }
-
-                        m_barrier_batcher->add_image_barrier(
-                            image,
-                            barrier.before,
-                            barrier.after,
-                            batleth::format_to_aspect_mask(format)
-                        );
-                    } else {
-                        VkBuffer buffer = VK_NULL_HANDLE;
-                        if (ext_it != m_externals.end()) {
-                            buffer = ext_it->second.buffer;
-                        } else {
-                            buffer = resource.get_buffer().buffer;
-                        }
-
-                        m_barrier_batcher->add_buffer_barrier(
-                            buffer,
-                            barrier.before,
-                            barrier.after
-                        );
-                    }
+                for (std::uint32_t b = 0; b < group.barrier_count; ++b) {
+                    add_barrier(m_barriers.split_barriers[group.first_barrier + b]);
+                }
+                m_barrier_batcher->wait_event(cmd, events[g]);
+            }
+
+            // Insert pre-pass barriers as a single batch
+            if (m_barriers.pass_offsets[i] != m_barriers.pass_offsets[i + 1]) {
+                m_barrier_batcher->clear();
+                for (std::uint32_t b = m_barriers.pass_offsets[i]; b < m_barriers.pass_offsets[i + 1]; ++b) {
+                    add_barrier(m_barriers.barriers[b]);
                 }
                 m_barrier_batcher->flush(cmd);
             }
@@ -796,30 +1149,151 @@ namespace klingon {
             if (pass.config.type == batleth::PassType::Graphics) {
                 end_graphics_pass(cmd);
             }
+
+            // Signal split barriers for consumers further down the graph
+            for (std::uint32_t s = m_barriers.split_signal_offsets[i]; s < m_barriers.split_signal_offsets[i + 1]; ++s) {
+                const std::uint32_t g = m_barriers.split_signal_order[s];
+                const auto &group = m_barriers.split_groups[g];
+                m_barrier_batcher->clear();
+                for (std::uint32_t b = 0; b < group.barrier_count; ++b) {
+                    add_barrier(m_barriers.split_barriers[group.first_barrier + b]);
+                }
+                m_barrier_batcher->signal_event(cmd, events[g]);
+            }
+
+            if (timestamps != VK_NULL_HANDLE) {
+                ::vkCmdWriteTimestamp2(cmd, VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT, timestamps, query + 1);
+            }
+
+            m_pass_timings[i].cpu_ms = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - cpu_start).count();
         }
 
         // Insert final barriers
-        if (!m_final_barriers.empty()) {
+        if (!m_barriers.final_barriers.empty()) {
             m_barrier_batcher->clear();
-            for (const auto &barrier: m_final_barriers) {
-                auto ext_it = m_externals.find(barrier.resource);
-                if (ext_it != m_externals.end() && ext_it->second.type == batleth::ResourceType::Image) {
-                    m_barrier_batcher->add_image_barrier(
-                        ext_it->second.image,
-                        barrier.before,
-                        barrier.after,
-                        batleth::format_to_aspect_mask(ext_it->second.format)
-                    );
-                }
+            for (const auto &barrier: m_barriers.final_barriers) {
+                add_barrier(barrier);
             }
             m_barrier_batcher->flush(cmd);
         }
     }
 
+    auto CompiledRenderGraph::add_barrier(const batleth::PassBarrier &barrier) -> void {
+        const bool external = is_external(barrier.resource);
+        const auto &resource = m_physical_resources[barrier.resource];
+        const auto &ext = m_externals[barrier.resource];
+
+        if (resource.is_image() || (external && ext.type == batleth::ResourceType::Image)) {
+            VkImage image = external ? ext.image : resource.get_image().image;
+            VkFormat format = external ? ext.format : resource.get_image().format;
+
+            m_barrier_batcher->add_image_barrier(
+                image,
+                barrier.before,
+                barrier.after,
+                batleth::format_to_aspect_mask(format),
+                barrier.range.base_mip,
+                barrier.range.mip_count,
+                barrier.range.base_layer,
+                barrier.range.layer_count
+            );
+        } else {
+            VkBuffer buffer = external ? ext.buffer : resource.get_buffer().buffer;
+
+            m_barrier_batcher->add_buffer_barrier(
+                buffer,
+                barrier.before,
+                barrier.after
+            );
+        }
+    }
+
+    auto CompiledRenderGraph::get_split_events(std::uint32_t frame_index) -> const std::vector<VkEvent> & {
+        if (frame_index >= m_split_events.size()) {
+            m_split_events.resize(frame_index + 1);
+        }
+
+        auto &events = m_split_events[frame_index];
+        while (events.size() < m_barriers.split_groups.size()) {
+            VkEventCreateInfo event_info{};
+            event_info.sType = VK_STRUCTURE_TYPE_EVENT_CREATE_INFO;
+
+            VkEvent event = VK_NULL_HANDLE;
+            if (::vkCreateEvent(m_device->get_logical_device(), &event_info, nullptr, &event) != VK_SUCCESS) {
+                FED_ERROR("Failed to create split barrier event");
+                throw std::runtime_error("Failed to create split barrier event");
+            }
+            events.push_back(event);
+        }
+
+        return events;
+    }
+
+    auto CompiledRenderGraph::get_timestamp_pool(std::uint32_t frame_index) -> VkQueryPool {
+        if (m_timestamp_period <= 0.0f || m_passes.empty()) {
+            return VK_NULL_HANDLE;
+        }
+
+        if (frame_index >= m_timestamp_pools.size()) {
+            m_timestamp_pools.resize(frame_index + 1, VK_NULL_HANDLE);
+            m_timestamps_written.resize(frame_index + 1, false);
+        }
+
+        if (m_timestamp_pools[frame_index] == VK_NULL_HANDLE) {
+            VkQueryPoolCreateInfo pool_info{};
+            pool_info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+            pool_info.queryType = VK_QUERY_TYPE_TIMESTAMP;
+            pool_info.queryCount = static_cast<std::uint32_t>(m_passes.size() * 2);
+
+            if (::vkCreateQueryPool(m_device->get_logical_device(), &pool_info, nullptr,
+                                    &m_timestamp_pools[frame_index]) != VK_SUCCESS) {
+                // Timing is diagnostic only - keep rendering without it
+                FED_WARN("Failed to create render graph timestamp pool, GPU pass timing disabled");
+                m_timestamp_period = 0.0f;
+                return VK_NULL_HANDLE;
+            }
+        }
+
+        return m_timestamp_pools[frame_index];
+    }
+
+    auto CompiledRenderGraph::read_gpu_timings(std::uint32_t frame_index) -> void {
+        if (!m_timestamps_written[frame_index]) {
+            return;
+        }
+
+        std::vector<std::uint64_t> ticks(m_passes.size() * 2);
+        VkResult result = ::vkGetQueryPoolResults(
+            m_device->get_logical_device(),
+            m_timestamp_pools[frame_index],
+            0,
+            static_cast<std::uint32_t>(ticks.size()),
+            ticks.size() * sizeof(std::uint64_t),
+            ticks.data(),
+            sizeof(std::uint64_t),
+            VK_QUERY_RESULT_64_BIT
+        );
+        if (result != VK_SUCCESS) {
+            return;
+        }
+
+        for (std::size_t i = 0; i < m_passes.size(); ++i) {
+            const std::uint64_t begin = ticks[i * 2];
+            const std::uint64_t end = ticks[i * 2 + 1];
+            m_pass_timings[i].gpu_ms = end >= begin
+                                           ? static_cast<double>(end - begin) * m_timestamp_period / 1.0e6
+                                           : -1.0;
+        }
+    }
+
     auto CompiledRenderGraph::update_external(
         batleth::ResourceHandle handle,
         const ExternalResource &external
     ) -> void {
+        if (handle >= m_externals.size()) {
+            m_externals.resize(handle + 1);
+        }
         m_externals[handle] = external;
     }
 
@@ -827,10 +1301,29 @@ namespace klingon {
         return m_passes.size();
     }
 
+    auto CompiledRenderGraph::get_culled_passes() const -> const std::vector<federation::NameId> & {
+        return m_culled_passes;
+    }
+
+    auto CompiledRenderGraph::get_compile_time_ms() const -> double {
+        return m_compile_time_ms;
+    }
+
+    auto CompiledRenderGraph::get_barrier_stats() const -> const batleth::BarrierStats & {
+        return m_barriers.stats;
+    }
+
+    auto CompiledRenderGraph::get_pass_timings() const -> const std::vector<PassTiming> & {
+        return m_pass_timings;
+    }
+
+    auto CompiledRenderGraph::is_external(batleth::ResourceHandle handle) const -> bool {
+        return handle < m_externals.size() && m_externals[handle].handle != batleth::INVALID_RESOURCE;
+    }
+
     auto CompiledRenderGraph::get_image(batleth::ResourceHandle handle) const -> VkImage {
-        auto ext_it = m_externals.find(handle);
-        if (ext_it != m_externals.end()) {
-            return ext_it->second.image;
+        if (is_external(handle)) {
+            return m_externals[handle].image;
         }
 
         if (handle < m_physical_resources.size() && m_physical_resources[handle].is_image()) {
@@ -841,9 +1334,8 @@ namespace klingon {
     }
 
     auto CompiledRenderGraph::get_image_view(batleth::ResourceHandle handle) const -> VkImageView {
-        auto ext_it = m_externals.find(handle);
-        if (ext_it != m_externals.end()) {
-            return ext_it->second.view;
+        if (is_external(handle)) {
+            return m_externals[handle].view;
         }
 
         if (handle < m_physical_resources.size() && m_physical_resources[handle].is_image()) {
@@ -854,9 +1346,8 @@ namespace klingon {
     }
 
     auto CompiledRenderGraph::get_buffer(batleth::ResourceHandle handle) const -> VkBuffer {
-        auto ext_it = m_externals.find(handle);
-        if (ext_it != m_externals.end()) {
-            return ext_it->second.buffer;
+        if (is_external(handle)) {
+            return m_externals[handle].buffer;
         }
 
         if (handle < m_physical_resources.size() && m_physical_resources[handle].is_buffer()) {
@@ -867,9 +1358,8 @@ namespace klingon {
     }
 
     auto CompiledRenderGraph::get_image_format(batleth::ResourceHandle handle) const -> VkFormat {
-        auto ext_it = m_externals.find(handle);
-        if (ext_it != m_externals.end()) {
-            return ext_it->second.format;
+        if (is_external(handle)) {
+            return m_externals[handle].format;
         }
 
         if (handle < m_physical_resources.size() && m_physical_resources[handle].is_image()) {
@@ -880,9 +1370,8 @@ namespace klingon {
     }
 
     auto CompiledRenderGraph::get_image_extent(batleth::ResourceHandle handle) const -> VkExtent3D {
-        auto ext_it = m_externals.find(handle);
-        if (ext_it != m_externals.end()) {
-            return {ext_it->second.extent.width, ext_it->second.extent.height, 1};
+        if (is_external(handle)) {
+            return {m_externals[handle].extent.width, m_externals[handle].extent.height, 1};
         }
 
         if (handle < m_physical_resources.size() && m_physical_resources[handle].is_image()) {
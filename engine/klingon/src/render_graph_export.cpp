@@ -0,0 +1,438 @@
+#include "klingon/render_graph.hpp"
+#include "federation/log.hpp"
+
+#include <algorithm>
+#include <format>
+#include <iterator>
+
+namespace klingon {
+    namespace {
+        constexpr std::uint32_t NO_ALIAS_GROUP = ~0u;
+
+        auto pass_type_name(batleth::PassType type) -> std::string_view {
+            switch (type) {
+                case batleth::PassType::Graphics: return "graphics";
+                case batleth::PassType::Compute: return "compute";
+                case batleth::PassType::Transfer: return "transfer";
+            }
+            return "unknown";
+        }
+
+        auto queue_name(batleth::QueueType queue) -> std::string_view {
+            switch (queue) {
+                case batleth::QueueType::Graphics: return "graphics";
+                case batleth::QueueType::Compute: return "compute";
+                case batleth::QueueType::Transfer: return "transfer";
+            }
+            return "unknown";
+        }
+
+        auto queue_color(batleth::QueueType queue) -> std::string_view {
+            switch (queue) {
+                case batleth::QueueType::Graphics: return "#9ecae1";
+                case batleth::QueueType::Compute: return "#fdae6b";
+                case batleth::QueueType::Transfer: return "#a1d99b";
+            }
+            return "#d9d9d9";
+        }
+
+        auto usage_name(batleth::ResourceUsage usage) -> std::string_view {
+            switch (usage) {
+                case batleth::ResourceUsage::SampledImage: return "SampledImage";
+                case batleth::ResourceUsage::StorageImageRead: return "StorageImageRead";
+                case batleth::ResourceUsage::UniformBuffer: return "UniformBuffer";
+                case batleth::ResourceUsage::StorageBufferRead: return "StorageBufferRead";
+                case batleth::ResourceUsage::VertexBuffer: return "VertexBuffer";
+                case batleth::ResourceUsage::IndexBuffer: return "IndexBuffer";
+                case batleth::ResourceUsage::IndirectBuffer: return "IndirectBuffer";
+                case batleth::ResourceUsage::TransferSource: return "TransferSource";
+                case batleth::ResourceUsage::DepthStencilRead: return "DepthStencilRead";
+                case batleth::ResourceUsage::InputAttachment: return "InputAttachment";
+                case batleth::ResourceUsage::ColorAttachment: return "ColorAttachment";
+                case batleth::ResourceUsage::DepthStencilWrite: return "DepthStencilWrite";
+                case batleth::ResourceUsage::StorageImageWrite: return "StorageImageWrite";
+                case batleth::ResourceUsage::StorageBufferWrite: return "StorageBufferWrite";
+                case batleth::ResourceUsage::TransferDestination: return "TransferDestination";
+                case batleth::ResourceUsage::StorageImageReadWrite: return "StorageImageReadWrite";
+                case batleth::ResourceUsage::StorageBufferReadWrite: return "StorageBufferReadWrite";
+                case batleth::ResourceUsage::DepthStencilReadWrite: return "DepthStencilReadWrite";
+            }
+            return "Unknown";
+        }
+
+        auto layout_name(VkImageLayout layout) -> std::string {
+            switch (layout) {
+                case VK_IMAGE_LAYOUT_UNDEFINED: return "UNDEFINED";
+                case VK_IMAGE_LAYOUT_GENERAL: return "GENERAL";
+                case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL: return "COLOR_ATTACHMENT_OPTIMAL";
+                case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL: return "DEPTH_STENCIL_ATTACHMENT_OPTIMAL";
+                case VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL: return "DEPTH_STENCIL_READ_ONLY_OPTIMAL";
+                case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL: return "SHADER_READ_ONLY_OPTIMAL";
+                case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL: return "TRANSFER_SRC_OPTIMAL";
+                case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL: return "TRANSFER_DST_OPTIMAL";
+                case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR: return "PRESENT_SRC_KHR";
+                default: return std::format("{}", static_cast<int>(layout));
+            }
+        }
+
+        auto load_op_name(VkAttachmentLoadOp op) -> std::string_view {
+            switch (op) {
+                case VK_ATTACHMENT_LOAD_OP_LOAD: return "load";
+                case VK_ATTACHMENT_LOAD_OP_CLEAR: return "clear";
+                case VK_ATTACHMENT_LOAD_OP_DONT_CARE: return "dont_care";
+                default: return "none";
+            }
+        }
+
+        auto store_op_name(VkAttachmentStoreOp op) -> std::string_view {
+            switch (op) {
+                case VK_ATTACHMENT_STORE_OP_STORE: return "store";
+                case VK_ATTACHMENT_STORE_OP_DONT_CARE: return "dont_care";
+                default: return "none";
+            }
+        }
+
+        // Escape for both JSON strings and DOT quoted labels
+        auto append_escaped(std::string &out, std::string_view text) -> void {
+            for (char c: text) {
+                switch (c) {
+                    case '"': out += "\\\"";
+                        break;
+                    case '\\': out += "\\\\";
+                        break;
+                    case '\n': out += "\\n";
+                        break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20) {
+                            std::format_to(std::back_inserter(out), "\\u{:04x}", static_cast<unsigned>(c));
+                        } else {
+                            out += c;
+                        }
+                }
+            }
+        }
+
+        auto append_quoted(std::string &out, std::string_view text) -> void {
+            out += '"';
+            append_escaped(out, text);
+            out += '"';
+        }
+
+        auto append_ms(std::string &out, double ms) -> void {
+            if (ms < 0.0) {
+                out += "null";
+            } else {
+                std::format_to(std::back_inserter(out), "{:.4f}", ms);
+            }
+        }
+    }
+
+    auto CompiledRenderGraph::compute_alias_groups() const -> std::vector<std::uint32_t> {
+        std::vector<std::uint32_t> groups(m_resources.size(), NO_ALIAS_GROUP);
+
+        // Only transients whose contents die inside the graph can share memory
+        std::vector<batleth::ResourceHandle> candidates;
+        for (batleth::ResourceHandle handle = 0; handle < m_resources.size(); ++handle) {
+            if (is_external(handle) || m_retained[handle] || m_resources[handle].is_placeholder() ||
+                m_lifetimes[handle].first_pass == ~0u) {
+                continue;
+            }
+            candidates.push_back(handle);
+        }
+        std::sort(candidates.begin(), candidates.end(), [this](batleth::ResourceHandle a, batleth::ResourceHandle b) {
+            return m_lifetimes[a].first_pass < m_lifetimes[b].first_pass;
+        });
+
+        // Greedy interval partitioning: reuse the first group of the same kind that is already dead
+        struct Group {
+            batleth::ResourceType type;
+            std::uint32_t last_pass;
+        };
+        std::vector<Group> open_groups;
+
+        for (auto handle: candidates) {
+            const auto &lifetime = m_lifetimes[handle];
+            const auto type = m_resources[handle].type;
+
+            auto it = std::find_if(open_groups.begin(), open_groups.end(), [&](const Group &group) {
+                return group.type == type && group.last_pass < lifetime.first_pass;
+            });
+            if (it == open_groups.end()) {
+                open_groups.push_back({type, lifetime.last_pass});
+                groups[handle] = static_cast<std::uint32_t>(open_groups.size() - 1);
+            } else {
+                it->last_pass = lifetime.last_pass;
+                groups[handle] = static_cast<std::uint32_t>(it - open_groups.begin());
+            }
+        }
+
+        return groups;
+    }
+
+    auto CompiledRenderGraph::export_dot() const -> std::string {
+        std::string out;
+        auto emit = [&out]<typename... Args>(std::format_string<Args...> fmt, Args &&... args) {
+            std::format_to(std::back_inserter(out), fmt, std::forward<Args>(args)...);
+        };
+        auto resource_name = [this](batleth::ResourceHandle handle) -> std::string {
+            if (handle < m_resources.size() && !m_resources[handle].is_placeholder()) {
+                return std::string(federation::NameRegistry::lookup(m_resources[handle].name));
+            }
+            return std::format("#{}", handle);
+        };
+
+        const auto alias_groups = compute_alias_groups();
+
+        emit("digraph render_graph {{\n");
+        emit("    rankdir=LR;\n");
+        emit("    node [fontname=\"Helvetica\", fontsize=10];\n");
+        emit("    edge [fontname=\"Helvetica\", fontsize=8];\n");
+        emit("    label=\"compile {:.3f} ms, {} barriers ({} split, {} eliminated), {} batches\";\n",
+             m_compile_time_ms, m_barriers.stats.emitted, m_barriers.stats.split, m_barriers.stats.eliminated,
+             m_barriers.stats.batches);
+
+        // Passes, coloured by queue
+        for (std::size_t i = 0; i < m_passes.size(); ++i) {
+            const auto &config = m_passes[i].config;
+            const auto &timing = m_pass_timings[i];
+            const std::uint32_t barrier_count = m_barriers.pass_offsets[i + 1] - m_barriers.pass_offsets[i];
+            const std::uint32_t wait_count = m_barriers.split_wait_offsets[i + 1] - m_barriers.split_wait_offsets[i];
+
+            std::string label;
+            append_escaped(label, federation::NameRegistry::lookup(config.name));
+            std::format_to(std::back_inserter(label), "\\n{} / {} queue\\ncpu {:.3f} ms", pass_type_name(config.type),
+                           queue_name(config.queue), timing.cpu_ms);
+            if (timing.gpu_ms >= 0.0) {
+                std::format_to(std::back_inserter(label), ", gpu {:.3f} ms", timing.gpu_ms);
+            }
+            std::format_to(std::back_inserter(label), "\\n{} barriers, {} split waits", barrier_count, wait_count);
+
+            emit("    p{} [shape=box, style=filled, fillcolor=\"{}\", label=\"{}\"];\n", i, queue_color(config.queue),
+                 label);
+        }
+
+        // Culled passes are shown detached so it's obvious what was dropped
+        for (std::size_t i = 0; i < m_culled_passes.size(); ++i) {
+            std::string label;
+            append_escaped(label, federation::NameRegistry::lookup(m_culled_passes[i]));
+            emit("    c{} [shape=box, style=dashed, fontcolor=gray50, label=\"{}\\n(culled)\"];\n", i, label);
+        }
+
+        // Resources touched by live passes
+        for (batleth::ResourceHandle handle = 0; handle < m_resources.size(); ++handle) {
+            const auto &lifetime = m_lifetimes[handle];
+            if (lifetime.first_pass == ~0u) continue;
+
+            std::string label;
+            append_escaped(label, resource_name(handle));
+            std::format_to(std::back_inserter(label), "\\npasses {}-{}", lifetime.first_pass, lifetime.last_pass);
+            if (alias_groups[handle] != NO_ALIAS_GROUP) {
+                std::format_to(std::back_inserter(label), ", alias group {}", alias_groups[handle]);
+            }
+
+            const bool external = is_external(handle);
+            emit("    r{} [shape={}, style={}, label=\"{}\"];\n", handle,
+                 m_resources[handle].is_buffer() ? "cylinder" : "ellipse",
+                 external ? "bold" : (m_tile_local[handle] ? "dotted" : "solid"), label);
+        }
+
+        // Data flow: resource -> reading pass, writing pass -> resource
+        for (std::size_t i = 0; i < m_passes.size(); ++i) {
+            const auto &config = m_passes[i].config;
+            for (const auto &access: config.reads) {
+                if (access.handle >= m_resources.size()) continue;
+                emit("    r{} -> p{} [label=\"{}\"];\n", access.handle, i, usage_name(access.usage));
+            }
+            for (const auto &attachment: config.color_attachments) {
+                if (attachment.handle >= m_resources.size()) continue;
+                if (attachment.load_op == VK_ATTACHMENT_LOAD_OP_LOAD) {
+                    emit("    r{} -> p{} [label=\"load\", style=dashed];\n", attachment.handle, i);
+                }
+                emit("    p{} -> r{} [label=\"color {}\"];\n", i, attachment.handle,
+                     store_op_name(attachment.store_op));
+            }
+            if (config.has_depth_attachment && config.depth_attachment.handle < m_resources.size()) {
+                if (config.depth_attachment.load_op == VK_ATTACHMENT_LOAD_OP_LOAD) {
+                    emit("    r{} -> p{} [label=\"load\", style=dashed];\n", config.depth_attachment.handle, i);
+                }
+                emit("    p{} -> r{} [label=\"depth {}\"];\n", i, config.depth_attachment.handle,
+                     store_op_name(config.depth_attachment.store_op));
+            }
+            for (const auto &access: config.writes) {
+                if (access.handle >= m_resources.size()) continue;
+                emit("    p{} -> r{} [label=\"{}\"];\n", i, access.handle, usage_name(access.usage));
+            }
+        }
+
+        // Split barriers: event signalled after the producer, waited on before the consumer
+        for (const auto &group: m_barriers.split_groups) {
+            emit("    p{} -> p{} [style=dotted, color=red, constraint=false, label=\"event ({} barriers)\"];\n",
+                 group.signal_pass, group.wait_pass, group.barrier_count);
+        }
+
+        emit("}}\n");
+        return out;
+    }
+
+    auto CompiledRenderGraph::export_json() const -> std::string {
+        std::string out;
+        auto emit = [&out]<typename... Args>(std::format_string<Args...> fmt, Args &&... args) {
+            std::format_to(std::back_inserter(out), fmt, std::forward<Args>(args)...);
+        };
+        auto emit_name = [&out](federation::NameId name) {
+            append_quoted(out, federation::NameRegistry::lookup(name));
+        };
+        auto emit_state = [&](const batleth::ResourceState &state) {
+            emit("{{\"layout\": \"{}\", \"stages\": \"0x{:x}\", \"access\": \"0x{:x}\"}}",
+                 layout_name(state.layout), state.stage_mask, state.access_mask);
+        };
+        auto emit_barrier = [&](const batleth::PassBarrier &barrier) {
+            emit("{{\"resource\": {}, \"before\": ", barrier.resource);
+            emit_state(barrier.before);
+            out += ", \"after\": ";
+            emit_state(barrier.after);
+            if (barrier.resource < m_resources.size() && m_resources[barrier.resource].is_image()) {
+                // Counts of VK_REMAINING_* are reported as -1
+                auto count = [](std::uint32_t value) -> long long {
+                    return value == ~0u ? -1 : static_cast<long long>(value);
+                };
+                emit(", \"mips\": [{}, {}], \"layers\": [{}, {}]", barrier.range.base_mip,
+                     count(barrier.range.mip_count), barrier.range.base_layer, count(barrier.range.layer_count));
+            }
+            out += '}';
+        };
+        auto emit_barrier_list = [&](const batleth::PassBarrier *first, std::size_t count) {
+            out += '[';
+            for (std::size_t b = 0; b < count; ++b) {
+                out += b == 0 ? "" : ", ";
+                emit_barrier(first[b]);
+            }
+            out += ']';
+        };
+        auto emit_access_list = [&](const batleth::ResourceAccessList &accesses) {
+            out += '[';
+            for (std::size_t a = 0; a < accesses.size(); ++a) {
+                emit("{}{{\"resource\": {}, \"usage\": \"{}\"}}", a == 0 ? "" : ", ", accesses[a].handle,
+                     usage_name(accesses[a].usage));
+            }
+            out += ']';
+        };
+
+        const auto &stats = m_barriers.stats;
+        emit("{{\n  \"compile_time_ms\": {:.4f},\n", m_compile_time_ms);
+        emit("  \"gpu_timing\": {},\n", m_timestamp_period > 0.0f ? "true" : "false");
+        emit("  \"barrier_stats\": {{\"requested\": {}, \"eliminated\": {}, \"merged\": {}, \"emitted\": {}, "
+             "\"split\": {}, \"batches\": {}}},\n",
+             stats.requested, stats.eliminated, stats.merged, stats.emitted, stats.split, stats.batches);
+
+        // Passes in execution order
+        out += "  \"passes\": [";
+        for (std::size_t i = 0; i < m_passes.size(); ++i) {
+            const auto &config = m_passes[i].config;
+            const auto &timing = m_pass_timings[i];
+
+            emit("{}\n    {{\"index\": {}, \"name\": ", i == 0 ? "" : ",", i);
+            emit_name(config.name);
+            emit(", \"type\": \"{}\", \"queue\": \"{}\", \"cpu_ms\": ", pass_type_name(config.type),
+                 queue_name(config.queue));
+            append_ms(out, timing.cpu_ms);
+            out += ", \"gpu_ms\": ";
+            append_ms(out, timing.gpu_ms);
+
+            out += ",\n     \"reads\": ";
+            emit_access_list(config.reads);
+            out += ", \"writes\": ";
+            emit_access_list(config.writes);
+
+            out += ",\n     \"color_attachments\": [";
+            for (std::size_t a = 0; a < config.color_attachments.size(); ++a) {
+                const auto &attachment = config.color_attachments[a];
+                emit("{}{{\"resource\": {}, \"load\": \"{}\", \"store\": \"{}\"}}", a == 0 ? "" : ", ",
+                     attachment.handle, load_op_name(attachment.load_op), store_op_name(attachment.store_op));
+            }
+            out += "], \"depth_attachment\": ";
+            if (config.has_depth_attachment) {
+                emit("{{\"resource\": {}, \"load\": \"{}\", \"store\": \"{}\"}}", config.depth_attachment.handle,
+                     load_op_name(config.depth_attachment.load_op), store_op_name(config.depth_attachment.store_op));
+            } else {
+                out += "null";
+            }
+
+            out += ",\n     \"barriers\": ";
+            const std::uint32_t first = m_barriers.pass_offsets[i];
+            emit_barrier_list(m_barriers.barriers.data() + first, m_barriers.pass_offsets[i + 1] - first);
+
+            out += ",\n     \"split_waits\": [";
+            for (std::uint32_t g = m_barriers.split_wait_offsets[i]; g < m_barriers.split_wait_offsets[i + 1]; ++g) {
+                const auto &group = m_barriers.split_groups[g];
+                emit("{}{{\"signal_pass\": {}, \"barriers\": ", g == m_barriers.split_wait_offsets[i] ? "" : ", ",
+                     group.signal_pass);
+                emit_barrier_list(m_barriers.split_barriers.data() + group.first_barrier, group.barrier_count);
+                out += '}';
+            }
+            out += "]}";
+        }
+        out += "\n  ],\n";
+
+        out += "  \"final_barriers\": ";
+        emit_barrier_list(m_barriers.final_barriers.data(), m_barriers.final_barriers.size());
+        out += ",\n";
+
+        // Resources with lifetimes and aliasing candidates
+        const auto alias_groups = compute_alias_groups();
+        out += "  \"resources\": [";
+        bool first_resource = true;
+        for (batleth::ResourceHandle handle = 0; handle < m_resources.size(); ++handle) {
+            const auto &resource = m_resources[handle];
+            if (resource.is_placeholder()) continue;
+
+            const bool external = is_external(handle);
+            emit("{}\n    {{\"handle\": {}, \"name\": ", first_resource ? "" : ",", handle);
+            first_resource = false;
+            emit_name(resource.name);
+            emit(", \"kind\": \"{}\", \"external\": {}, \"retained\": {}, \"tile_local\": {}",
+                 resource.is_image() ? "image" : "buffer", external ? "true" : "false",
+                 m_retained[handle] ? "true" : "false",
+                 !external && m_tile_local[handle] ? "true" : "false");
+
+            if (external) {
+                const auto &ext = m_externals[handle];
+                if (ext.type == batleth::ResourceType::Image) {
+                    emit(", \"format\": {}, \"extent\": [{}, {}, 1]", static_cast<int>(ext.format), ext.extent.width,
+                         ext.extent.height);
+                } else {
+                    emit(", \"size\": {}", ext.size);
+                }
+            } else if (resource.is_image()) {
+                const auto &desc = resource.get_image_desc();
+                emit(", \"format\": {}, \"extent\": [{}, {}, {}], \"mip_levels\": {}, \"array_layers\": {}",
+                     static_cast<int>(desc.format), desc.extent.width, desc.extent.height, desc.extent.depth,
+                     desc.mip_levels, desc.array_layers);
+            } else {
+                emit(", \"size\": {}", resource.get_buffer_desc().size);
+            }
+
+            const auto &lifetime = m_lifetimes[handle];
+            if (lifetime.first_pass == ~0u) {
+                out += ", \"lifetime\": null";
+            } else {
+                emit(", \"lifetime\": [{}, {}]", lifetime.first_pass, lifetime.last_pass);
+            }
+            if (alias_groups[handle] == NO_ALIAS_GROUP) {
+                out += ", \"alias_group\": null}";
+            } else {
+                emit(", \"alias_group\": {}}}", alias_groups[handle]);
+            }
+        }
+        out += "\n  ],\n";
+
+        out += "  \"culled_passes\": [";
+        for (std::size_t i = 0; i < m_culled_passes.size(); ++i) {
+            out += i == 0 ? "" : ", ";
+            emit_name(m_culled_passes[i]);
+        }
+        out += "]\n}\n";
+
+        return out;
+    }
+} // namespace klingon
@@ -0,0 +1,94 @@
+#include "klingon/render_snapshot.hpp"
+#include "klingon/scene.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace klingon {
+    auto RenderSnapshot::extract(const Scene& scene, float delta_time) -> void {
+        // Set the previous references aside: the last reference to a model may be among them
+        m_models_retired.insert(m_models_retired.end(), std::make_move_iterator(m_models_alive.begin()),
+                                std::make_move_iterator(m_models_alive.end()));
+        if (static_geometry) {
+            m_static_geometry_retired.push_back(std::move(static_geometry));
+        }
+        m_models_alive.clear();
+        m_models_seen.clear();
+        clear_arrays();
+
+        camera = scene.get_camera();
+        ambient_light = scene.get_ambient_light();
+        frame_time = delta_time;
+        static_geometry = scene.get_static_geometry();
+
+        const auto& game_objects = scene.get_game_objects();
+        object_ids.reserve(game_objects.size());
+        model_matrices.reserve(game_objects.size());
+        normal_matrices.reserve(game_objects.size());
+        extents.reserve(game_objects.size());
+        models.reserve(game_objects.size());
+
+        for (const auto& [id, obj] : game_objects) {
+            if (obj.point_light) {
+                light_positions.push_back(obj.transform.translation);
+                light_colors.emplace_back(obj.color, obj.point_light->light_intensity);
+                light_radii.push_back(obj.transform.scale.x);
+            }
+
+            if (!obj.model_data) {
+                continue;
+            }
+
+            const auto object = static_cast<uint32_t>(object_ids.size());
+            const glm::vec3& scale = obj.transform.scale;
+            object_ids.push_back(id);
+            model_matrices.push_back(obj.transform.mat4());
+            normal_matrices.emplace_back(obj.transform.normal_matrix());
+            extents.push_back(std::max({std::abs(scale.x), std::abs(scale.y), std::abs(scale.z)}));
+            models.push_back(obj.model_data.get());
+
+            if (m_models_seen.insert(obj.model_data.get()).second) {
+                m_models_alive.push_back(obj.model_data);
+            }
+
+            if (obj.animator) {
+                const auto joints = obj.animator->get_palette();
+                if (!joints.empty()) {
+                    skins.push_back({
+                        .object = object,
+                        .palette_offset = static_cast<uint32_t>(palettes.size()),
+                        .joint_count = static_cast<uint32_t>(joints.size())
+                    });
+                    palettes.insert(palettes.end(), joints.begin(), joints.end());
+                }
+            }
+        }
+    }
+
+    auto RenderSnapshot::release_retired() -> void {
+        m_models_retired.clear();
+        m_static_geometry_retired.clear();
+    }
+
+    auto RenderSnapshot::clear() -> void {
+        clear_arrays();
+        static_geometry.reset();
+        m_models_alive.clear();
+        m_models_seen.clear();
+        release_retired();
+    }
+
+    auto RenderSnapshot::clear_arrays() -> void {
+        object_ids.clear();
+        model_matrices.clear();
+        normal_matrices.clear();
+        extents.clear();
+        models.clear();
+        skins.clear();
+        palettes.clear();
+        light_positions.clear();
+        light_colors.clear();
+        light_radii.clear();
+    }
+} // namespace klingon
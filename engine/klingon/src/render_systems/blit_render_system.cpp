@@ -2,13 +2,15 @@
 #include "federation/log.hpp"
 #include "batleth/shader.hpp"
 
+#include <algorithm>
 #include <stdexcept>
 #include <array>
 
 namespace klingon {
-    BlitRenderSystem::BlitRenderSystem(batleth::Device &device, VkFormat swapchain_format)
+    BlitRenderSystem::BlitRenderSystem(batleth::Device &device, VkFormat swapchain_format, uint32_t frames_in_flight)
         : m_device{device}
-          , m_swapchain_format{swapchain_format} {
+          , m_swapchain_format{swapchain_format}
+          , m_frames_in_flight{std::max(frames_in_flight, 1u)} {
         create_descriptor_set_layout();
         create_descriptor_pool();
         allocate_descriptor_set();
@@ -46,17 +48,15 @@ namespace klingon {
 
     auto BlitRenderSystem::create_descriptor_pool() -> void {
         // Pool size for combined image samplers (one per frame in flight)
-        constexpr uint32_t MAX_FRAMES = 2;  // Must match Renderer::MAX_FRAMES_IN_FLIGHT
-
         VkDescriptorPoolSize pool_size{};
         pool_size.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        pool_size.descriptorCount = MAX_FRAMES;
+        pool_size.descriptorCount = m_frames_in_flight;
 
         VkDescriptorPoolCreateInfo pool_info{};
         pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
         pool_info.poolSizeCount = 1;
         pool_info.pPoolSizes = &pool_size;
-        pool_info.maxSets = MAX_FRAMES;
+        pool_info.maxSets = m_frames_in_flight;
         pool_info.flags = 0;  // No flags - we don't free individual sets
 
         if (::vkCreateDescriptorPool(m_device.get_logical_device(), &pool_info, nullptr,
@@ -66,16 +66,15 @@ namespace klingon {
     }
 
     auto BlitRenderSystem::allocate_descriptor_set() -> void {
-        constexpr uint32_t MAX_FRAMES = 2;  // Must match Renderer::MAX_FRAMES_IN_FLIGHT
-        m_descriptor_sets.resize(MAX_FRAMES);
+        m_descriptor_sets.resize(m_frames_in_flight);
 
         // Allocate all descriptor sets at once
-        std::vector<VkDescriptorSetLayout> layouts(MAX_FRAMES, m_descriptor_set_layout);
+        std::vector<VkDescriptorSetLayout> layouts(m_frames_in_flight, m_descriptor_set_layout);
 
         VkDescriptorSetAllocateInfo alloc_info{};
         alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
         alloc_info.descriptorPool = m_descriptor_pool;
-        alloc_info.descriptorSetCount = MAX_FRAMES;
+        alloc_info.descriptorSetCount = m_frames_in_flight;
         alloc_info.pSetLayouts = layouts.data();
 
         if (::vkAllocateDescriptorSets(m_device.get_logical_device(), &alloc_info, m_descriptor_sets.data()) != VK_SUCCESS) {
@@ -1,12 +1,12 @@
 #include "klingon/render_systems/depth_prepass_system.hpp"
 #include "klingon/render_systems/simple_render_system.hpp"  // For RenderMode enum
+#include "klingon/render_systems/skinning_system.hpp"
 #include "klingon/model/mesh.h"
 #include "klingon/material.hpp"  // For Material access
 #include "federation/log.hpp"
 #include "batleth/shader.hpp"
 
 #include <stdexcept>
-#include <ranges>
 
 namespace klingon {
     DepthPrepassSystem::DepthPrepassSystem(
@@ -96,18 +96,46 @@ namespace klingon {
             nullptr
         );
 
+        // Static geometry batches that survive the frustum test, already in world space
+        const RenderSnapshot& snapshot = frame_info.snapshot;
+        const StaticGeometry* static_geometry = snapshot.static_geometry.get();
+        if (static_geometry) {
+            m_visible_batches.clear();
+            static_geometry->cull(frame_info.camera.get_projection() * frame_info.camera.get_view(),
+                                  m_visible_batches);
+            const PushConstantData identity{};
+            for (const auto* batch : m_visible_batches) {
+                if (mode == RenderMode::OpaqueOnly && batch->transparent) continue;
+                if (mode == RenderMode::TransparentOnly && !batch->transparent) continue;
+
+                ::vkCmdPushConstants(
+                    frame_info.command_buffer,
+                    m_pipeline->get_layout(),
+                    VK_SHADER_STAGE_VERTEX_BIT,
+                    0,
+                    sizeof(PushConstantData),
+                    &identity
+                );
+                auto& mesh = static_geometry->get_mesh(*batch);
+                mesh.bind(frame_info.command_buffer);
+                mesh.draw(frame_info.command_buffer);
+            }
+        }
+
         // Render each game object (depth only)
-        for (auto &obj: frame_info.game_objects | std::views::values) {
-            if (obj.model_data == nullptr) continue;
+        for (size_t object = 0; object < snapshot.get_object_count(); ++object) {
+            const GameObject::id_t id = snapshot.object_ids[object];
+            if (static_geometry && static_geometry->is_batched(id)) continue;
+            const ModelData& model = *snapshot.models[object];
 
             // Render each mesh with filtering
-            for (size_t mesh_idx = 0; mesh_idx < obj.model_data->meshes.size(); ++mesh_idx) {
-                auto& mesh = obj.model_data->meshes[mesh_idx];
+            for (size_t mesh_idx = 0; mesh_idx < model.meshes.size(); ++mesh_idx) {
+                auto& mesh = model.get_mesh(mesh_idx);
 
                 // Check transparency if filtering is enabled
                 if (mode != RenderMode::All) {
-                    uint32_t material_idx = obj.model_data->mesh_material_indices[mesh_idx];
-                    auto& material = obj.model_data->materials[material_idx];
+                    uint32_t material_idx = model.mesh_material_indices[mesh_idx];
+                    auto& material = model.materials[material_idx];
 
                     bool is_transparent =
                         ((material.gpu_data.material_flags & 8u) != 0u) ||  // Has opacity texture
@@ -120,8 +148,8 @@ namespace klingon {
 
                 // Setup push constants
                 PushConstantData push{};
-                push.model_matrix = obj.transform.mat4();
-                push.normal_matrix = obj.transform.normal_matrix();
+                push.model_matrix = snapshot.model_matrices[object];
+                push.normal_matrix = snapshot.normal_matrices[object];
 
                 ::vkCmdPushConstants(
                     frame_info.command_buffer,
@@ -132,8 +160,16 @@ namespace klingon {
                     &push
                 );
 
-                mesh->bind(frame_info.command_buffer);
-                mesh->draw(frame_info.command_buffer);
+                const auto skinned = m_skinning_system
+                    ? m_skinning_system->get_skinned_vertices(id, model.meshes[mesh_idx],
+                                                              frame_info.frame_index)
+                    : SkinningSystem::SkinnedVertices{};
+                if (skinned.buffer != VK_NULL_HANDLE) {
+                    mesh.bind(frame_info.command_buffer, skinned.buffer, skinned.offset);
+                } else {
+                    mesh.bind(frame_info.command_buffer);
+                }
+                mesh.draw(frame_info.command_buffer);
             }
         }
     }
@@ -1,5 +1,6 @@
 #include "klingon/render_systems/point_light_system.hpp"
 
+#include <algorithm>
 #include <map>
 #include <ranges>
 
@@ -78,34 +79,35 @@ namespace klingon {
         FED_INFO("PointLightSystem created successfully");
     }
 
-    auto PointLightSystem::update(FrameInfo &frame_info, GlobalUbo &ubo) -> void {
+    auto PointLightSystem::animate(GameObject::Map &game_objects, float frame_time) -> void {
         // Rotate lights around the scene
-        auto rotate = glm::rotate(glm::mat4(1.f), frame_info.frame_time, glm::vec3(0.f, 1.f, 0.f));
+        auto rotate = glm::rotate(glm::mat4(1.f), frame_time, glm::vec3(0.f, 1.f, 0.f));
 
-        int light_index = 0;
-        for (auto &obj: frame_info.game_objects | std::views::values) {
+        for (auto &obj: game_objects | std::views::values) {
             if (obj.point_light == nullptr) continue;
-
-            // Update light translation
             obj.transform.translation = glm::vec3(rotate * glm::vec4(obj.transform.translation, 1.f));
+        }
+    }
+
+    auto PointLightSystem::update(FrameInfo &frame_info, GlobalUbo &ubo) -> void {
+        const RenderSnapshot &snapshot = frame_info.snapshot;
+        const auto light_count = std::min<size_t>(snapshot.get_light_count(), MAX_LIGHTS);
 
-            // Update UBO
-            ubo.point_lights[light_index].position = glm::vec4(obj.transform.translation, 1.f);
-            ubo.point_lights[light_index].color = glm::vec4(obj.color, obj.point_light->light_intensity);
-            light_index++;
+        for (size_t light_index = 0; light_index < light_count; ++light_index) {
+            ubo.point_lights[light_index].position = glm::vec4(snapshot.light_positions[light_index], 1.f);
+            ubo.point_lights[light_index].color = snapshot.light_colors[light_index];
         }
-        ubo.num_lights = light_index;
+        ubo.num_lights = static_cast<int>(light_count);
     }
 
     auto PointLightSystem::render(FrameInfo &frame_info) -> void {
+        const RenderSnapshot &snapshot = frame_info.snapshot;
 
-        std::map<float, GameObject::id_t> sorted_objs;
-        for (auto &[id, obj]: frame_info.game_objects) {
-            if (obj.point_light == nullptr) continue;
-
-            auto offset = frame_info.camera.get_position() - obj.transform.translation;
+        std::map<float, size_t> sorted_lights;
+        for (size_t light = 0; light < snapshot.get_light_count(); ++light) {
+            auto offset = frame_info.camera.get_position() - snapshot.light_positions[light];
             float disSquared = glm::dot(offset, offset);
-            sorted_objs[disSquared] = id;
+            sorted_lights[disSquared] = light;
         }
 
             // Bind pipeline
@@ -124,14 +126,11 @@ namespace klingon {
         );
 
         // Render each point light
-        for (auto &[_, obj_index]: sorted_objs | std::views::reverse) {
-            auto& obj = frame_info.game_objects.at(obj_index);
-            if (obj.point_light == nullptr) continue;
-
+        for (auto &[_, light]: sorted_lights | std::views::reverse) {
             PointLightPushConstants push{};
-            push.position = glm::vec4(obj.transform.translation, 1.f);
-            push.color = glm::vec4(obj.color, obj.point_light->light_intensity);
-            push.radius = obj.transform.scale.x;
+            push.position = glm::vec4(snapshot.light_positions[light], 1.f);
+            push.color = snapshot.light_colors[light];
+            push.radius = snapshot.light_radii[light];
 
             ::vkCmdPushConstants(
                 frame_info.command_buffer,
@@ -2,6 +2,7 @@
 #include "klingon/model/mesh.h"
 #include "klingon/material.hpp"
 #include "klingon/game_object.hpp"
+#include "klingon/render_systems/skinning_system.hpp"
 #include "federation/log.hpp"
 
 #include <stdexcept>
@@ -157,25 +158,46 @@ namespace klingon {
             );
         }
 
-        // Collect transparent meshes for sorting
+        // Collect transparent meshes for sorting (batch set for static geometry, object otherwise)
         struct TransparentMesh {
             float distance;
-            GameObject* obj;
+            size_t object;
             size_t mesh_idx;
+            const StaticGeometry::Batch* batch;
         };
         std::vector<TransparentMesh> transparent_meshes;
 
         // Get camera position for distance calculations
         glm::vec3 cam_pos = glm::vec3(frame_info.camera.get_inverse_view()[3]);
 
+        // Static geometry: whole batches are culled against the frustum, then drawn like meshes
+        const RenderSnapshot& snapshot = frame_info.snapshot;
+        const StaticGeometry* static_geometry = snapshot.static_geometry.get();
+        if (static_geometry) {
+            m_visible_batches.clear();
+            static_geometry->cull(frame_info.camera.get_projection() * frame_info.camera.get_view(),
+                                  m_visible_batches);
+            for (const auto* batch : m_visible_batches) {
+                if (mode == RenderMode::OpaqueOnly && batch->transparent) continue;
+                if (mode == RenderMode::TransparentOnly && !batch->transparent) continue;
+
+                if (mode == RenderMode::TransparentOnly) {
+                    transparent_meshes.push_back({glm::length(cam_pos - batch->center), 0, 0, batch});
+                } else {
+                    render_batch(*batch, frame_info);
+                }
+            }
+        }
+
         // Render each game object
-        for (auto &obj: frame_info.game_objects | std::views::values) {
-            if (obj.model_data == nullptr) continue;
+        for (size_t object = 0; object < snapshot.get_object_count(); ++object) {
+            if (static_geometry && static_geometry->is_batched(snapshot.object_ids[object])) continue;
+            const ModelData& model = *snapshot.models[object];
 
             // Check each mesh individually (per-mesh transparency)
-            for (size_t mesh_idx = 0; mesh_idx < obj.model_data->meshes.size(); ++mesh_idx) {
-                uint32_t material_idx = obj.model_data->mesh_material_indices[mesh_idx];
-                auto& material = obj.model_data->materials[material_idx];
+            for (size_t mesh_idx = 0; mesh_idx < model.meshes.size(); ++mesh_idx) {
+                uint32_t material_idx = model.mesh_material_indices[mesh_idx];
+                auto& material = model.materials[material_idx];
 
                 bool is_transparent = is_material_transparent(material);
 
@@ -189,12 +211,11 @@ namespace klingon {
 
                 // For transparent pass, collect and sort back-to-front
                 if (mode == RenderMode::TransparentOnly) {
-                    glm::vec3 obj_pos = obj.transform.translation;
-                    float distance = glm::length(cam_pos - obj_pos);
-                    transparent_meshes.push_back({distance, &obj, mesh_idx});
+                    float distance = glm::length(cam_pos - snapshot.get_position(object));
+                    transparent_meshes.push_back({distance, object, mesh_idx, nullptr});
                 } else {
                     // Opaque pass: render immediately (no sorting needed)
-                    render_mesh(obj, mesh_idx, frame_info);
+                    render_mesh(object, mesh_idx, frame_info);
                 }
             }
         }
@@ -205,7 +226,11 @@ namespace klingon {
                       [](const auto& a, const auto& b) { return a.distance > b.distance; });
 
             for (auto& tm : transparent_meshes) {
-                render_mesh(*tm.obj, tm.mesh_idx, frame_info);
+                if (tm.batch) {
+                    render_batch(*tm.batch, frame_info);
+                } else {
+                    render_mesh(tm.object, tm.mesh_idx, frame_info);
+                }
             }
         }
     }
@@ -247,17 +272,18 @@ namespace klingon {
         return false;
     }
 
-    auto SimpleRenderSystem::render_mesh(GameObject& obj, size_t mesh_idx, FrameInfo& frame_info) -> void {
-        auto& mesh = obj.model_data->meshes[mesh_idx];
+    auto SimpleRenderSystem::render_mesh(size_t object, size_t mesh_idx, FrameInfo& frame_info) -> void {
+        const RenderSnapshot& snapshot = frame_info.snapshot;
+        const ModelData& model = *snapshot.models[object];
+        auto& mesh = model.get_mesh(mesh_idx);
 
         // Setup push constants
         PushConstantData push{};
-        push.model_matrix = obj.transform.mat4();
-        push.normal_matrix = obj.transform.normal_matrix();
+        push.model_matrix = snapshot.model_matrices[object];
+        push.normal_matrix = snapshot.normal_matrices[object];
 
         // Get the correct material index for this mesh
-        uint32_t mesh_material_idx = obj.model_data->mesh_material_indices[mesh_idx];
-        push.material_index = obj.model_data->material_buffer_offset + mesh_material_idx;
+        push.material_index = model.get_mesh_material_index(mesh_idx);
 
         // Add Forward+ tile information if enabled
         if (m_use_forward_plus) {
@@ -275,7 +301,40 @@ namespace klingon {
             &push
         );
 
-        mesh->bind(frame_info.command_buffer);
-        mesh->draw(frame_info.command_buffer);
+        const auto skinned = m_skinning_system
+            ? m_skinning_system->get_skinned_vertices(snapshot.object_ids[object], model.meshes[mesh_idx],
+                                                      frame_info.frame_index)
+            : SkinningSystem::SkinnedVertices{};
+        if (skinned.buffer != VK_NULL_HANDLE) {
+            mesh.bind(frame_info.command_buffer, skinned.buffer, skinned.offset);
+        } else {
+            mesh.bind(frame_info.command_buffer);
+        }
+        mesh.draw(frame_info.command_buffer);
+    }
+
+    auto SimpleRenderSystem::render_batch(const StaticGeometry::Batch& batch, FrameInfo& frame_info) -> void {
+        // Vertices are already in world space, so the default identity matrices apply
+        PushConstantData push{};
+        push.material_index = batch.material_index;
+
+        if (m_use_forward_plus) {
+            push.tile_count = glm::uvec2(m_tile_count_x, m_tile_count_y);
+            push.tile_size = m_tile_size;
+            push.max_lights_per_tile = m_max_lights_per_tile;
+        }
+
+        ::vkCmdPushConstants(
+            frame_info.command_buffer,
+            m_pipeline->get_layout(),
+            VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+            0,
+            sizeof(PushConstantData),
+            &push
+        );
+
+        auto& mesh = frame_info.snapshot.static_geometry->get_mesh(batch);
+        mesh.bind(frame_info.command_buffer);
+        mesh.draw(frame_info.command_buffer);
     }
 } // namespace klingon
\ No newline at end of file
@@ -0,0 +1,290 @@
+#include "klingon/render_systems/skinning_system.hpp"
+#include "klingon/animation/animator.hpp"
+#include "klingon/model/mesh.h"
+#include "batleth/barrier_batcher.hpp"
+#include "batleth/shader.hpp"
+#include "federation/log.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+
+namespace klingon {
+    namespace {
+        constexpr uint32_t WORKGROUP_SIZE = 64;  // local_size_x in skinning.comp
+    }
+
+    SkinningSystem::SkinningSystem(const Config& config)
+        : m_device(config.device)
+        , m_max_palette_joints(std::max(config.max_palette_joints, 1u))
+        , m_max_skinned_meshes(std::max(config.max_skinned_meshes, 1u))
+        , m_max_skinned_vertices(std::max(config.max_skinned_vertices, 1u))
+        , m_frames_in_flight(std::max(config.frames_in_flight, 1u)) {
+        const VkDevice device = m_device.get_logical_device();
+
+        // Set 0 binding 0: palettes, 1: skinned output
+        m_frame_set_layout = batleth::DescriptorSetLayout::Builder(device)
+                .add_binding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT)
+                .add_binding(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT)
+                .build();
+        // Set 1 binding 0: bind-pose vertices, 1: influences
+        m_mesh_set_layout = batleth::DescriptorSetLayout::Builder(device)
+                .add_binding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT)
+                .add_binding(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT)
+                .build();
+
+        // Meshes come and go with models, so their sets are freed individually
+        const uint32_t max_sets = m_frames_in_flight + m_max_skinned_meshes;
+        m_descriptor_pool = batleth::DescriptorPool::Builder(device)
+                .set_max_sets(max_sets)
+                .set_pool_flags(VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT)
+                .add_pool_size(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, max_sets * 2)
+                .build();
+
+        m_palettes.reserve(m_frames_in_flight);
+        m_vertex_outputs.reserve(m_frames_in_flight);
+        m_frame_sets.resize(m_frames_in_flight, VK_NULL_HANDLE);
+        for (uint32_t frame = 0; frame < m_frames_in_flight; ++frame) {
+            auto& palette = m_palettes.emplace_back(std::make_unique<batleth::Buffer>(
+                m_device,
+                sizeof(SkinMatrix),
+                m_max_palette_joints,
+                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+            ));
+            if (palette->map() != VK_SUCCESS) {
+                FED_FATAL("Failed to map skinning palette buffer");
+                throw std::runtime_error("Failed to map skinning palette buffer");
+            }
+
+            // Every instance skinned this frame gets a range of this buffer, rewritten each frame
+            auto& output = m_vertex_outputs.emplace_back(std::make_unique<batleth::Buffer>(
+                m_device,
+                sizeof(Vertex),
+                m_max_skinned_vertices,
+                VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+            ));
+
+            VkDescriptorBufferInfo palette_info = palette->descriptor_info();
+            VkDescriptorBufferInfo output_info = output->descriptor_info();
+            if (!batleth::DescriptorWriter(*m_frame_set_layout, *m_descriptor_pool)
+                    .write_buffer(0, &palette_info)
+                    .write_buffer(1, &output_info)
+                    .build(m_frame_sets[frame])) {
+                FED_FATAL("Failed to allocate skinning frame descriptor set");
+                throw std::runtime_error("Failed to allocate skinning frame descriptor set");
+            }
+        }
+
+        m_outputs.resize(m_frames_in_flight);
+        for (auto& outputs : m_outputs) {
+            outputs.reserve(m_max_skinned_meshes);
+        }
+        m_mesh_sets.reserve(m_max_skinned_meshes);
+
+        create_pipeline();
+        FED_INFO("SkinningSystem created ({} palette joints, {} meshes and {} vertices per frame)",
+                 m_max_palette_joints, m_max_skinned_meshes, m_max_skinned_vertices);
+    }
+
+    SkinningSystem::~SkinningSystem() {
+        const VkDevice device = m_device.get_logical_device();
+        if (m_pipeline != VK_NULL_HANDLE) {
+            ::vkDestroyPipeline(device, m_pipeline, nullptr);
+        }
+        if (m_pipeline_layout != VK_NULL_HANDLE) {
+            ::vkDestroyPipelineLayout(device, m_pipeline_layout, nullptr);
+        }
+    }
+
+    auto SkinningSystem::create_pipeline() -> void {
+        VkPushConstantRange push_constant_range{};
+        push_constant_range.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        push_constant_range.offset = 0;
+        push_constant_range.size = sizeof(PushConstantData);
+
+        const std::array set_layouts{m_frame_set_layout->get_layout(), m_mesh_set_layout->get_layout()};
+        VkPipelineLayoutCreateInfo pipeline_layout_info{};
+        pipeline_layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipeline_layout_info.setLayoutCount = static_cast<uint32_t>(set_layouts.size());
+        pipeline_layout_info.pSetLayouts = set_layouts.data();
+        pipeline_layout_info.pushConstantRangeCount = 1;
+        pipeline_layout_info.pPushConstantRanges = &push_constant_range;
+
+        if (::vkCreatePipelineLayout(m_device.get_logical_device(), &pipeline_layout_info, nullptr,
+                                     &m_pipeline_layout) != VK_SUCCESS) {
+            FED_FATAL("Failed to create skinning pipeline layout");
+            throw std::runtime_error("Failed to create skinning pipeline layout");
+        }
+
+        auto compute_shader_config = batleth::Shader::Config{};
+        compute_shader_config.device = m_device.get_logical_device();
+        compute_shader_config.filepath = "assets/shaders/skinning.comp";
+        compute_shader_config.stage = batleth::Shader::Stage::Compute;
+        compute_shader_config.enable_hot_reload = false;
+        compute_shader_config.optimize = true;
+        auto compute_shader = batleth::Shader{compute_shader_config};
+
+        VkComputePipelineCreateInfo pipeline_info{};
+        pipeline_info.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipeline_info.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        pipeline_info.stage.stage = compute_shader.get_stage();
+        pipeline_info.stage.module = compute_shader.get_module();
+        pipeline_info.stage.pName = "main";
+        pipeline_info.layout = m_pipeline_layout;
+
+        if (::vkCreateComputePipelines(m_device.get_logical_device(), VK_NULL_HANDLE, 1, &pipeline_info, nullptr,
+                                       &m_pipeline) != VK_SUCCESS) {
+            FED_FATAL("Failed to create skinning compute pipeline");
+            throw std::runtime_error("Failed to create skinning compute pipeline");
+        }
+    }
+
+    auto SkinningSystem::record(VkCommandBuffer cmd, uint32_t frame_index, const RenderSnapshot& snapshot) -> void {
+        const uint32_t frame = frame_index % m_frames_in_flight;
+        const uint64_t record_id = ++m_record_count;
+        auto* palette = static_cast<SkinMatrix*>(m_palettes[frame]->get_mapped_memory());
+        uint32_t palette_used = 0;
+        uint32_t vertices_used = 0;
+        uint32_t dispatches = 0;
+
+        // This frame's previous draws have completed, so its output buffer is free to rewrite
+        auto& outputs = m_outputs[frame];
+        outputs.clear();
+
+        for (const auto& skin : snapshot.skins) {
+            const std::span<const SkinMatrix> joints{snapshot.palettes.data() + skin.palette_offset, skin.joint_count};
+            if (palette_used + joints.size() > m_max_palette_joints) {
+                report_overflow("palette joint", m_max_palette_joints);
+                break;
+            }
+
+            const uint32_t palette_offset = palette_used;
+            std::memcpy(palette + palette_offset, joints.data(), joints.size_bytes());
+            palette_used += static_cast<uint32_t>(joints.size());
+
+            const ModelData& model = *snapshot.models[skin.object];
+            for (size_t mesh_idx = 0; mesh_idx < model.meshes.size(); ++mesh_idx) {
+                const Mesh& mesh = model.get_mesh(mesh_idx);
+                if (!mesh.is_skinned()) {
+                    continue;
+                }
+                const uint32_t vertex_count = mesh.get_vertex_count();
+                if (outputs.size() >= m_max_skinned_meshes) {
+                    report_overflow("mesh", m_max_skinned_meshes);
+                    continue;
+                }
+                if (vertex_count > m_max_skinned_vertices - vertices_used) {
+                    report_overflow("vertex", m_max_skinned_vertices);
+                    continue;
+                }
+                const VkDescriptorSet mesh_set = get_mesh_set(model.meshes[mesh_idx], mesh, record_id);
+                if (mesh_set == VK_NULL_HANDLE) {
+                    continue;
+                }
+
+                if (dispatches++ == 0) {
+                    ::vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline);
+                    ::vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline_layout, 0, 1,
+                                              &m_frame_sets[frame], 0, nullptr);
+                }
+                ::vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipeline_layout, 1, 1,
+                                          &mesh_set, 0, nullptr);
+
+                const PushConstantData push{
+                    .vertex_count = vertex_count,
+                    .palette_offset = palette_offset,
+                    .joint_count = static_cast<uint32_t>(joints.size()),
+                    .output_offset = vertices_used
+                };
+                ::vkCmdPushConstants(cmd, m_pipeline_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push), &push);
+                ::vkCmdDispatch(cmd, (vertex_count + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1, 1);
+
+                outputs.emplace(OutputKey{snapshot.object_ids[skin.object], model.meshes[mesh_idx]}, vertices_used);
+                vertices_used += vertex_count;
+            }
+        }
+
+        release_unused_mesh_sets(record_id);
+
+        if (dispatches == 0) {
+            return;
+        }
+
+        const batleth::ResourceState compute_write{
+            .stage_mask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+            .access_mask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT
+        };
+        const batleth::ResourceState vertex_read{
+            .stage_mask = VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT,
+            .access_mask = VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT
+        };
+
+        // One global barrier covers every range written above
+        batleth::BarrierBatcher to_vertex_input;
+        to_vertex_input.add_memory_barrier(compute_write, vertex_read);
+        to_vertex_input.flush(cmd);
+        FED_TRACE("Skinned {} meshes ({} vertices) with {} palette joints", dispatches, vertices_used, palette_used);
+    }
+
+    auto SkinningSystem::get_skinned_vertices(GameObject::id_t id, MeshHandle mesh, uint32_t frame_index) const
+        -> SkinnedVertices {
+        const uint32_t frame = frame_index % m_frames_in_flight;
+        const auto& outputs = m_outputs[frame];
+        const auto it = outputs.find({id, mesh});
+        if (it == outputs.end()) {
+            return {};
+        }
+        return {
+            .buffer = m_vertex_outputs[frame]->get_buffer(),
+            .offset = static_cast<VkDeviceSize>(it->second) * sizeof(Vertex)
+        };
+    }
+
+    auto SkinningSystem::get_mesh_set(MeshHandle handle, const Mesh& mesh, uint64_t record_id) -> VkDescriptorSet {
+        if (auto it = m_mesh_sets.find(handle.value()); it != m_mesh_sets.end()) {
+            it->second.last_used = record_id;
+            return it->second.descriptor_set;
+        }
+
+        MeshSet mesh_set{.last_used = record_id};
+        VkDescriptorBufferInfo bind_vertices{mesh.get_vertex_buffer(), 0, VK_WHOLE_SIZE};
+        VkDescriptorBufferInfo skins{mesh.get_skin_buffer(), 0, VK_WHOLE_SIZE};
+        if (!batleth::DescriptorWriter(*m_mesh_set_layout, *m_descriptor_pool)
+                .write_buffer(0, &bind_vertices)
+                .write_buffer(1, &skins)
+                .build(mesh_set.descriptor_set)) {
+            report_overflow("descriptor set", m_max_skinned_meshes);
+            return VK_NULL_HANDLE;
+        }
+
+        m_mesh_sets.emplace(handle.value(), mesh_set);
+        return mesh_set.descriptor_set;
+    }
+
+    auto SkinningSystem::release_unused_mesh_sets(uint64_t record_id) -> void {
+        // A set last used frames_in_flight records ago belongs to a frame that has completed
+        std::vector<VkDescriptorSet> released;
+        std::erase_if(m_mesh_sets, [&](const auto& entry) {
+            if (entry.second.last_used + m_frames_in_flight > record_id) {
+                return false;
+            }
+            released.push_back(entry.second.descriptor_set);
+            return true;
+        });
+        if (!released.empty()) {
+            m_descriptor_pool->free_descriptors(released);
+        }
+    }
+
+    auto SkinningSystem::report_overflow(std::string_view what, uint32_t limit) -> void {
+        if (m_reported_overflow) {
+            return;
+        }
+        FED_WARN("Skinning {} limit reached ({}); remaining meshes draw in their bind pose", what, limit);
+        m_reported_overflow = true;
+    }
+} // namespace klingon
@@ -0,0 +1,70 @@
+#include "klingon/render_thread.hpp"
+#include "klingon/renderer.hpp"
+#include "federation/log.hpp"
+
+#include <cassert>
+#include <utility>
+
+namespace klingon {
+    RenderThread::RenderThread(Renderer& renderer)
+        : m_renderer(renderer)
+        , m_thread([this](std::stop_token stop) { thread_loop(stop); }) {
+        FED_DEBUG("Render thread started");
+    }
+
+    RenderThread::~RenderThread() {
+        {
+            std::unique_lock lock(m_mutex);
+            m_idle.wait(lock, [this] { return !m_busy; });
+        }
+        m_thread.request_stop();
+        m_wake.notify_all();
+        m_thread.join();
+        FED_DEBUG("Render thread stopped");
+    }
+
+    auto RenderThread::submit(RenderSnapshot& snapshot) -> void {
+        {
+            std::lock_guard lock(m_mutex);
+            assert(!m_busy && "RenderThread::submit while a frame is still rendering");
+            m_pending = &snapshot;
+            m_busy = true;
+        }
+        m_wake.notify_one();
+    }
+
+    auto RenderThread::wait_idle() -> void {
+        std::unique_lock lock(m_mutex);
+        m_idle.wait(lock, [this] { return !m_busy; });
+        if (m_error) {
+            std::rethrow_exception(std::exchange(m_error, nullptr));
+        }
+    }
+
+    auto RenderThread::thread_loop(std::stop_token stop) -> void {
+        while (true) {
+            RenderSnapshot* snapshot = nullptr;
+            {
+                std::unique_lock lock(m_mutex);
+                if (!m_wake.wait(lock, stop, [this] { return m_pending != nullptr; })) {
+                    return;
+                }
+                snapshot = std::exchange(m_pending, nullptr);
+            }
+
+            std::exception_ptr error;
+            try {
+                m_renderer.render_snapshot(*snapshot);
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            {
+                std::lock_guard lock(m_mutex);
+                m_error = error;
+                m_busy = false;
+            }
+            m_idle.notify_all();
+        }
+    }
+} // namespace klingon
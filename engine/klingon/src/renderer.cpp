@@ -20,8 +20,13 @@
 #include <GLFW/glfw3.h>
 #include <imgui_impl_vulkan.h>
 #include <glm/gtc/constants.hpp>
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include <vk_mem_alloc.h>
@@ -32,6 +37,13 @@ namespace klingon {
         : m_window(window), m_config(config) {
         FED_INFO("Initializing renderer");
 
+        m_frames_in_flight = std::clamp(config.renderer.performance.max_frames_in_flight, 1u, MAX_FRAMES_IN_FLIGHT);
+        if (m_frames_in_flight != config.renderer.performance.max_frames_in_flight) {
+            FED_WARN("max_frames_in_flight {} is out of range, using {}",
+                     config.renderer.performance.max_frames_in_flight, m_frames_in_flight);
+        }
+        FED_INFO("Rendering with {} frames in flight", m_frames_in_flight);
+
         create_instance();
         create_device();
 
@@ -42,14 +54,27 @@ namespace klingon {
         .allocator = get_allocator(),  // Use getter to ensure allocator is initialized
         .max_textures = 4096,
         .max_materials = 1024,
+        .frames_in_flight = m_frames_in_flight,
+        .streaming = {
+            .enabled = m_config.renderer.texture_streaming.enabled,
+            .budget_bytes = static_cast<uint64_t>(m_config.renderer.texture_streaming.budget_mb) * 1024 * 1024,
+            .tail_size = m_config.renderer.texture_streaming.tail_size,
+            .upload_bytes_per_frame =
+                static_cast<uint64_t>(m_config.renderer.texture_streaming.upload_mb_per_frame) * 1024 * 1024,
+            .eviction_delay_frames = m_config.renderer.texture_streaming.eviction_delay_frames,
+        },
         };
         m_texture_manager = std::make_unique<TextureManager>(tex_config);
+        m_resources = std::make_unique<ResourceRegistry>(ResourceRegistry::Config{
+            .frames_in_flight = m_frames_in_flight
+        });
 
         create_swapchain();
         create_depth_resources();
         create_command_pool();
         create_command_buffers();
         create_sync_objects();
+        create_pacing_queries();
 
         // Create offscreen sampler (if offscreen rendering enabled)
         if (m_config.renderer.offscreen.enabled) {
@@ -107,8 +132,11 @@ namespace klingon {
         for (auto semaphore: m_render_finished_semaphores) {
             ::vkDestroySemaphore(m_device->get_logical_device(), semaphore, nullptr);
         }
-        for (auto fence: m_in_flight_fences) {
-            ::vkDestroyFence(m_device->get_logical_device(), fence, nullptr);
+        if (m_frame_timeline != VK_NULL_HANDLE) {
+            ::vkDestroySemaphore(m_device->get_logical_device(), m_frame_timeline, nullptr);
+        }
+        if (m_pacing_queries != VK_NULL_HANDLE) {
+            ::vkDestroyQueryPool(m_device->get_logical_device(), m_pacing_queries, nullptr);
         }
 
         if (m_command_pool != VK_NULL_HANDLE) {
@@ -123,8 +151,12 @@ namespace klingon {
         // Cleanup Forward+ resources
         cleanup_forward_plus_resources();
 
-        // Cleanup depth resources
+        // Cleanup depth resources, including those of swapchains still retiring
         cleanup_depth_resources();
+        for (auto &retired: m_retired_swapchains) {
+            destroy_retired_swapchain(retired);
+        }
+        m_retired_swapchains.clear();
 
         // All RAII-wrapped resources (swapchain, surface, imgui_context, pipeline,
         // shaders, device, instance) are automatically destroyed in correct order
@@ -134,8 +166,14 @@ namespace klingon {
     }
 
     auto Renderer::begin_frame() -> bool {
-        // Wait for the previous frame to finish
-        ::vkWaitForFences(m_device->get_logical_device(), 1, &m_in_flight_fences[m_current_frame], VK_TRUE, UINT64_MAX);
+        // Wait until the GPU has retired the frame that last used this slot
+        const auto wait_start = std::chrono::steady_clock::now();
+        wait_for_frame(m_slot_frames[m_current_frame]);
+        m_pacing.cpu_wait_ms = std::chrono::duration<float, std::milli>(
+            std::chrono::steady_clock::now() - wait_start).count();
+        m_pacing.retired_frame = m_slot_frames[m_current_frame];
+        read_pacing_queries(m_current_frame);
+        collect_retired_resources();
 
         // Acquire next image from swapchain
         VkResult result = ::vkAcquireNextImageKHR(
@@ -148,25 +186,16 @@ namespace klingon {
         );
 
         if (result == VK_ERROR_OUT_OF_DATE_KHR) {
-            // Swapchain is out of date (window resized), recreate and skip this frame
-            recreate_swapchain();
+            // Swapchain is out of date (window resized), skip this frame; it's recreated before the next
+            m_swapchain_out_of_date = true;
             return false;
         } else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
             throw std::runtime_error("Failed to acquire swapchain image");
         }
 
-        // Reset fence only if we're submitting work
-        ::vkResetFences(m_device->get_logical_device(), 1, &m_in_flight_fences[m_current_frame]);
-
         // Reset command buffer
         ::vkResetCommandBuffer(m_command_buffers[m_current_frame], 0);
 
-        // Begin ImGui frame if enabled
-        // User code can now call ImGui functions
-        if (m_imgui_context) {
-            m_imgui_context->begin_frame();
-        }
-
         return true;
     }
 
@@ -314,10 +343,8 @@ namespace klingon {
     }
 
     auto Renderer::end_frame() -> void {
-        // End ImGui frame (prepares draw data)
-        if (m_imgui_context) {
-            m_imgui_context->end_frame();
-        }
+        // Last CPU work before the submit: re-sample input and patch the camera into this frame's UBO
+        late_latch_camera();
 
         // Submit command buffer
         VkSubmitInfo submit_info{};
@@ -331,14 +358,30 @@ namespace klingon {
         submit_info.commandBufferCount = 1;
         submit_info.pCommandBuffers = &m_command_buffers[m_current_frame];
 
-        VkSemaphore signal_semaphores[] = {m_render_finished_semaphores[m_current_frame]};
-        submit_info.signalSemaphoreCount = 1;
+        // Present waits on the binary semaphore; the CPU waits on the timeline value
+        const std::uint64_t frame = m_submitted_frame + 1;
+        VkSemaphore signal_semaphores[] = {m_render_finished_semaphores[m_current_frame], m_frame_timeline};
+        std::uint64_t signal_values[] = {0, frame};  // Binary semaphores ignore their value
+
+        VkTimelineSemaphoreSubmitInfo timeline_info{};
+        timeline_info.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        timeline_info.signalSemaphoreValueCount = 2;
+        timeline_info.pSignalSemaphoreValues = signal_values;
+        submit_info.pNext = &timeline_info;
+        submit_info.signalSemaphoreCount = 2;
         submit_info.pSignalSemaphores = signal_semaphores;
 
-        if (::vkQueueSubmit(m_device->get_graphics_queue(), 1, &submit_info, m_in_flight_fences[m_current_frame]) !=
-            VK_SUCCESS) {
+        if (::vkQueueSubmit(m_device->get_graphics_queue(), 1, &submit_info, VK_NULL_HANDLE) != VK_SUCCESS) {
             throw std::runtime_error("Failed to submit draw command buffer");
         }
+        m_submitted_frame = frame;
+        m_slot_frames[m_current_frame] = frame;
+
+        if (m_frame_snapshot) {
+            m_input_latency_ms = std::chrono::duration<float, std::milli>(
+                std::chrono::steady_clock::now() - m_frame_snapshot->input_time).count();
+            FED_TRACE("Input to submit: {:.3f} ms", m_input_latency_ms);
+        }
 
         // Present the image
         VkPresentInfoKHR present_info{};
@@ -354,16 +397,52 @@ namespace klingon {
 
         VkResult result = ::vkQueuePresentKHR(m_device->get_present_queue(), &present_info);
 
-        if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || m_framebuffer_resized) {
-            // Swapchain needs to be recreated
-            m_framebuffer_resized = false;
-            recreate_swapchain();
+        if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
+            // Swapchain needs to be recreated before the next frame
+            m_swapchain_out_of_date = true;
         } else if (result != VK_SUCCESS) {
             throw std::runtime_error("Failed to present swapchain image");
         }
 
         // Advance to next frame
-        m_current_frame = (m_current_frame + 1) % MAX_FRAMES_IN_FLIGHT;
+        m_current_frame = (m_current_frame + 1) % m_frames_in_flight;
+    }
+
+    auto Renderer::late_latch_camera() -> void {
+        if (!m_late_latch_callback || !m_frame_snapshot) return;
+
+        const auto camera_transform = m_late_latch_callback();
+        if (!camera_transform) return;
+
+        auto &camera = m_frame_snapshot->camera;
+        camera.set_view_yxz(camera_transform->translation, camera_transform->rotation);
+        m_frame_snapshot->input_time = std::chrono::steady_clock::now();
+
+        // Only what shaders read from the UBO moves; culling and light tiles keep the recorded view,
+        // which is at most one frame of camera motion off
+        m_current_ubo.view = camera.get_view();
+        m_current_ubo.inverseView = camera.get_inverse_view();
+        m_ubo_buffers[m_current_frame]->write_to_buffer(&m_current_ubo.view, 2 * sizeof(glm::mat4),
+                                                        offsetof(GlobalUbo, view));
+        m_ubo_buffers[m_current_frame]->flush();
+    }
+
+    auto Renderer::wait_for_previous_frame() -> void {
+        wait_for_frame(m_submitted_frame);
+    }
+
+    auto Renderer::wait_for_frame(std::uint64_t frame) -> void {
+        if (frame == 0) return;  // Nothing submitted yet
+
+        VkSemaphoreWaitInfo wait_info{};
+        wait_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        wait_info.semaphoreCount = 1;
+        wait_info.pSemaphores = &m_frame_timeline;
+        wait_info.pValues = &frame;
+
+        if (::vkWaitSemaphores(m_device->get_logical_device(), &wait_info, UINT64_MAX) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to wait for frame timeline");
+        }
     }
 
     auto Renderer::wait_idle() -> void {
@@ -383,21 +462,33 @@ namespace klingon {
         m_framebuffer_resized = true;
     }
 
+    auto Renderer::recreate_swapchain_if_needed() -> void {
+        if (m_swapchain_out_of_date || m_framebuffer_resized) {
+            m_swapchain_out_of_date = false;
+            m_framebuffer_resized = false;
+            recreate_swapchain();
+        }
+    }
+
     auto Renderer::recreate_swapchain() -> void {
         FED_INFO("Recreating swapchain");
 
-        // Wait for device to be idle
-        m_device->wait_idle();
-
-        // Cleanup old swapchain-dependent resources
-        cleanup_depth_resources();
-        m_swapchain.reset();
-
-        // Recreate swapchain and dependent resources
-        create_swapchain();
+        // Frames in flight may still render to or present the old images, so instead of waiting for
+        // the device to go idle they're retired on the frame timeline. One extra frame gives the
+        // presents queued for them time to complete, since the timeline only tracks rendering.
+        RetiredSwapchain retired{};
+        retired.retire_after = m_submitted_frame + 1;
+        retired.swapchain = std::move(m_swapchain);
+        retired.depth_image = std::exchange(m_depth_image, VK_NULL_HANDLE);
+        retired.depth_image_memory = std::exchange(m_depth_image_memory, VK_NULL_HANDLE);
+        retired.depth_image_view = std::exchange(m_depth_image_view, VK_NULL_HANDLE);
+
+        // Recreate swapchain and dependent resources, handing the old swapchain over to the new one
+        create_swapchain(retired.swapchain->get_handle());
         create_depth_resources();
+        m_retired_swapchains.push_back(std::move(retired));
 
-        FED_INFO("Swapchain recreated successfully");
+        FED_INFO("Swapchain recreated successfully ({} retiring)", m_retired_swapchains.size());
     }
 
     auto Renderer::create_instance() -> void {
@@ -480,7 +571,7 @@ namespace klingon {
         m_device = std::make_unique<batleth::Device>(device_config);
     }
 
-    auto Renderer::create_swapchain() -> void {
+    auto Renderer::create_swapchain(VkSwapchainKHR old_swapchain) -> void {
         FED_DEBUG("Creating Vulkan swapchain");
 
         auto [width, height] = m_window.get_framebuffer_size();
@@ -497,6 +588,7 @@ namespace klingon {
         swapchain_config.surface = m_device->get_surface();
         swapchain_config.width = width;
         swapchain_config.height = height;
+        swapchain_config.old_swapchain = old_swapchain;
 
         m_swapchain = std::make_unique<batleth::Swapchain>(swapchain_config);
     }
@@ -524,7 +616,7 @@ namespace klingon {
     auto Renderer::create_command_buffers() -> void {
         FED_DEBUG("Creating command buffers");
 
-        m_command_buffers.resize(MAX_FRAMES_IN_FLIGHT);
+        m_command_buffers.resize(m_frames_in_flight);
 
         VkCommandBufferAllocateInfo alloc_info{};
         alloc_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
@@ -543,31 +635,104 @@ namespace klingon {
     auto Renderer::create_sync_objects() -> void {
         FED_DEBUG("Creating synchronization objects");
 
-        m_image_available_semaphores.resize(MAX_FRAMES_IN_FLIGHT);
-        m_render_finished_semaphores.resize(MAX_FRAMES_IN_FLIGHT);
-        m_in_flight_fences.resize(MAX_FRAMES_IN_FLIGHT);
+        m_image_available_semaphores.resize(m_frames_in_flight);
+        m_render_finished_semaphores.resize(m_frames_in_flight);
+        m_slot_frames.assign(m_frames_in_flight, 0);  // 0 = slot never submitted, so the first frames don't wait
 
         VkSemaphoreCreateInfo semaphore_info{};
         semaphore_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 
-        VkFenceCreateInfo fence_info{};
-        fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-        fence_info.flags = VK_FENCE_CREATE_SIGNALED_BIT; // Start signaled so first frame doesn't wait
-
-        for (std::uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
+        for (std::uint32_t i = 0; i < m_frames_in_flight; ++i) {
             if (::vkCreateSemaphore(m_device->get_logical_device(), &semaphore_info, nullptr,
                                     &m_image_available_semaphores[i]) != VK_SUCCESS ||
                 ::vkCreateSemaphore(m_device->get_logical_device(), &semaphore_info, nullptr,
-                                    &m_render_finished_semaphores[i]) != VK_SUCCESS ||
-                ::vkCreateFence(m_device->get_logical_device(), &fence_info, nullptr, &m_in_flight_fences[i]) !=
-                VK_SUCCESS) {
+                                    &m_render_finished_semaphores[i]) != VK_SUCCESS) {
                 throw std::runtime_error("Failed to create synchronization objects");
             }
         }
 
+        // One timeline for the whole frame ring: frame N signals value N when its GPU work completes
+        VkSemaphoreTypeCreateInfo timeline_type{};
+        timeline_type.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        timeline_type.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        timeline_type.initialValue = 0;
+
+        VkSemaphoreCreateInfo timeline_info{};
+        timeline_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        timeline_info.pNext = &timeline_type;
+
+        if (::vkCreateSemaphore(m_device->get_logical_device(), &timeline_info, nullptr,
+                                &m_frame_timeline) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create frame timeline semaphore");
+        }
+
         FED_DEBUG("Synchronization objects created successfully");
     }
 
+    auto Renderer::create_pacing_queries() -> void {
+        // GPU pacing needs timestamp support on the graphics queue; without it only CPU wait is measured
+        VkPhysicalDeviceProperties properties{};
+        ::vkGetPhysicalDeviceProperties(m_device->get_physical_device(), &properties);
+
+        std::uint32_t family_count = 0;
+        ::vkGetPhysicalDeviceQueueFamilyProperties(m_device->get_physical_device(), &family_count, nullptr);
+        std::vector<VkQueueFamilyProperties> families(family_count);
+        ::vkGetPhysicalDeviceQueueFamilyProperties(m_device->get_physical_device(), &family_count, families.data());
+
+        const std::uint32_t graphics_family = get_graphics_queue_family();
+        if (graphics_family >= family_count || families[graphics_family].timestampValidBits == 0) {
+            FED_WARN("Graphics queue has no timestamps, GPU frame pacing is not measured");
+            return;
+        }
+
+        VkQueryPoolCreateInfo pool_info{};
+        pool_info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        pool_info.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        pool_info.queryCount = m_frames_in_flight * 2;
+
+        if (::vkCreateQueryPool(m_device->get_logical_device(), &pool_info, nullptr,
+                                &m_pacing_queries) != VK_SUCCESS) {
+            // Pacing is diagnostic only - keep rendering without it
+            FED_WARN("Failed to create frame pacing query pool, GPU frame pacing is not measured");
+            m_pacing_queries = VK_NULL_HANDLE;
+            return;
+        }
+        m_timestamp_period = properties.limits.timestampPeriod;
+        m_pacing_written.assign(m_frames_in_flight, false);
+    }
+
+    auto Renderer::read_pacing_queries(std::uint32_t frame_index) -> void {
+        if (m_pacing_queries == VK_NULL_HANDLE || !m_pacing_written[frame_index]) {
+            return;
+        }
+        m_pacing_written[frame_index] = false;
+
+        // The slot's frame has retired, so its results are available without waiting
+        std::array<std::uint64_t, 2> ticks{};
+        VkResult result = ::vkGetQueryPoolResults(
+            m_device->get_logical_device(),
+            m_pacing_queries,
+            frame_index * 2,
+            2,
+            sizeof(ticks),
+            ticks.data(),
+            sizeof(std::uint64_t),
+            VK_QUERY_RESULT_64_BIT
+        );
+        if (result != VK_SUCCESS || ticks[1] < ticks[0]) {
+            return;
+        }
+
+        // Slots retire in submission order, so the previous end belongs to the previous frame
+        const auto to_ms = [this](std::uint64_t delta) {
+            return static_cast<float>(static_cast<double>(delta) * m_timestamp_period / 1.0e6);
+        };
+        m_pacing.gpu_frame_ms = to_ms(ticks[1] - ticks[0]);
+        m_pacing.gpu_idle_ms = m_last_gpu_end == 0 ? -1.0f
+                               : ticks[0] >= m_last_gpu_end ? to_ms(ticks[0] - m_last_gpu_end) : 0.0f;
+        m_last_gpu_end = ticks[1];
+    }
+
 
     auto Renderer::create_depth_resources() -> void {
         FED_DEBUG("Creating depth resources");
@@ -682,7 +847,7 @@ namespace klingon {
 
         // Create UBO buffers (one per frame in flight)
         m_ubo_buffers.clear();
-        for (std::uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
+        for (std::uint32_t i = 0; i < m_frames_in_flight; ++i) {
             auto buffer = std::make_unique<batleth::Buffer>(
                 *m_device,
                 sizeof(GlobalUbo),
@@ -696,13 +861,13 @@ namespace klingon {
 
         // Create descriptor pool
         m_global_descriptor_pool = batleth::DescriptorPool::Builder(m_device->get_logical_device())
-                .set_max_sets(MAX_FRAMES_IN_FLIGHT)
-                .add_pool_size(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_FRAMES_IN_FLIGHT)
+                .set_max_sets(m_frames_in_flight)
+                .add_pool_size(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, m_frames_in_flight)
                 .build();
 
         // Allocate and write descriptor sets
-        m_global_descriptor_sets.resize(MAX_FRAMES_IN_FLIGHT);
-        for (std::uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
+        m_global_descriptor_sets.resize(m_frames_in_flight);
+        for (std::uint32_t i = 0; i < m_frames_in_flight; ++i) {
             auto buffer_info = m_ubo_buffers[i]->descriptor_info();
             batleth::DescriptorWriter(*m_global_set_layout, *m_global_descriptor_pool)
                     .write_buffer(0, &buffer_info)
@@ -757,9 +922,9 @@ namespace klingon {
 
         // Create descriptor pool for Forward+ descriptors
         m_forward_plus_descriptor_pool = batleth::DescriptorPool::Builder(m_device->get_logical_device())
-                .set_max_sets(MAX_FRAMES_IN_FLIGHT)
-                .add_pool_size(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_FRAMES_IN_FLIGHT)
-                .add_pool_size(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, MAX_FRAMES_IN_FLIGHT * 2) // 2 buffers per frame
+                .set_max_sets(m_frames_in_flight)
+                .add_pool_size(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, m_frames_in_flight)
+                .add_pool_size(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, m_frames_in_flight * 2) // 2 buffers per frame
                 .build();
 
         FED_INFO("Created Forward+ descriptor set layout and pool");
@@ -873,27 +1038,25 @@ namespace klingon {
         );
     }
 
-    auto Renderer::update_global_ubo(Scene *scene, float delta_time) -> void {
-        if (!scene) return;
-
-        auto &camera = scene->get_camera();
+    auto Renderer::update_global_ubo(RenderSnapshot &snapshot) -> void {
+        auto &camera = snapshot.camera;
 
         // Update camera matrices
         m_current_ubo.projection = camera.get_projection();
         m_current_ubo.view = camera.get_view();
         m_current_ubo.inverseView = camera.get_inverse_view();
-        m_current_ubo.ambient_light_color = scene->get_ambient_light();
+        m_current_ubo.ambient_light_color = snapshot.ambient_light;
 
         // Update lights via PointLightSystem
         if (m_point_light_system) {
             FrameInfo temp_info{
                 static_cast<int>(m_current_frame),
-                delta_time, // delta_time not needed for update
+                snapshot.frame_time,
                 VK_NULL_HANDLE, // command buffer not needed for update
                 camera,
                 VK_NULL_HANDLE, // descriptor set not needed for update
                 VK_NULL_HANDLE, // texture descriptor set not needed for update
-                scene->get_game_objects()
+                snapshot
             };
             m_point_light_system->update(temp_info, m_current_ubo);
         }
@@ -903,6 +1066,28 @@ namespace klingon {
         m_ubo_buffers[m_current_frame]->flush();
     }
 
+    auto Renderer::request_texture_residency(const RenderSnapshot &snapshot) -> void {
+        if (!m_texture_manager) return;
+
+        const auto &camera = snapshot.camera;
+        const glm::vec3 eye = camera.get_position();
+
+        // Pixels covered by one world unit at distance 1 (vertical)
+        const float pixels_per_unit = std::abs(camera.get_projection()[1][1]) * 0.5f *
+                                      static_cast<float>(m_swapchain->get_extent().height);
+
+        // No per-mesh bounds yet; approximate each object's footprint from its largest scale axis and
+        // assume its textures span it once
+        for (size_t object = 0; object < snapshot.get_object_count(); ++object) {
+            const float distance = std::max(glm::length(snapshot.get_position(object) - eye), 0.1f);
+            const auto pixels = static_cast<uint32_t>(snapshot.extents[object] * pixels_per_unit / distance);
+
+            for (uint32_t material_index : snapshot.models[object]->material_buffer_indices) {
+                m_texture_manager->request_material_resolution(material_index, pixels);
+            }
+        }
+    }
+
     auto Renderer::build_default_render_graph() -> void {
         FED_INFO("Building Forward+ render graph");
 
@@ -956,7 +1141,8 @@ namespace klingon {
         if (!m_blit_render_system && m_config.renderer.offscreen.enabled) {
             m_blit_render_system = std::make_unique<BlitRenderSystem>(
                 *m_device,
-                m_swapchain->get_format()
+                m_swapchain->get_format(),
+                m_frames_in_flight
             );
         }
 
@@ -968,19 +1154,34 @@ namespace klingon {
             );
         }
 
+        if (!m_skinning_system && m_config.animation.gpu_skinning) {
+            m_skinning_system = std::make_unique<SkinningSystem>(SkinningSystem::Config{
+                .device = *m_device,
+                .max_palette_joints = m_config.animation.max_palette_joints,
+                .max_skinned_meshes = m_config.animation.max_skinned_meshes,
+                .max_skinned_vertices = m_config.animation.max_skinned_vertices,
+                .frames_in_flight = m_frames_in_flight
+            });
+        }
+        m_simple_render_system->set_skinning_system(m_skinning_system.get());
+        if (m_depth_prepass_system) {
+            m_depth_prepass_system->set_skinning_system(m_skinning_system.get());
+        }
+
         // Create render graph
         m_render_graph = std::make_unique<RenderGraph>(*this);
 
         auto &builder = m_render_graph->begin_build();
 
         // Compute Forward+ tile dimensions
+        // Passes read the tile grid from the renderer so a resize doesn't have to rebuild them
         uint32_t tile_size = m_config.renderer.forward_plus.tile_size;
-        uint32_t tile_count_x = (extent.width + tile_size - 1) / tile_size;
-        uint32_t tile_count_y = (extent.height + tile_size - 1) / tile_size;
+        m_tile_count_x = (extent.width + tile_size - 1) / tile_size;
+        m_tile_count_y = (extent.height + tile_size - 1) / tile_size;
         uint32_t max_lights_per_tile = m_config.renderer.forward_plus.max_lights_per_tile;
 
         FED_DEBUG("Forward+ configuration: tiles={}x{}, tile_size={}, max_lights_per_tile={}",
-                  tile_count_x, tile_count_y, tile_size, max_lights_per_tile);
+                  m_tile_count_x, m_tile_count_y, tile_size, max_lights_per_tile);
 
         // Create resources
 
@@ -995,6 +1196,7 @@ namespace klingon {
         );
         depth_desc.is_transient = false;  // Cannot be transient with SAMPLED_BIT
         auto depth_buffer = builder.create_image("depth", depth_desc);
+        m_depth_handle = depth_buffer;
 
         // Light grid storage buffers (for Forward+ light culling)
         batleth::ResourceHandle light_grid;
@@ -1003,7 +1205,7 @@ namespace klingon {
         if (m_config.renderer.forward_plus.enabled) {
             // Light grid: stores light indices for each tile
             // Size: tile_count_x * tile_count_y * max_lights_per_tile * sizeof(uint32_t)
-            uint32_t light_grid_size = tile_count_x * tile_count_y * max_lights_per_tile * sizeof(uint32_t);
+            uint32_t light_grid_size = m_tile_count_x * m_tile_count_y * max_lights_per_tile * sizeof(uint32_t);
             light_grid = builder.create_buffer(
                 "light_grid",
                 batleth::BufferResourceDesc{
@@ -1015,7 +1217,7 @@ namespace klingon {
 
             // Light count: stores number of lights per tile
             // Size: tile_count_x * tile_count_y * sizeof(uint32_t)
-            uint32_t light_count_size = tile_count_x * tile_count_y * sizeof(uint32_t);
+            uint32_t light_count_size = m_tile_count_x * m_tile_count_y * sizeof(uint32_t);
             light_count = builder.create_buffer(
                 "light_count",
                 batleth::BufferResourceDesc{
@@ -1025,6 +1227,9 @@ namespace klingon {
                 }
             );
 
+            m_light_grid_handle = light_grid;
+            m_light_count_handle = light_count;
+
             FED_DEBUG("Created Forward+ light buffers: grid={} bytes, count={} bytes",
                       light_grid_size, light_count_size);
         }
@@ -1051,6 +1256,9 @@ namespace klingon {
             color_target = builder.create_image("offscreen_color", offscreen_desc);
             m_offscreen_color_handle = color_target;  // Store for viewport access
 
+            // The editor viewport samples this outside the graph, so keep its contents
+            builder.retain(color_target);
+
             FED_DEBUG("Created offscreen color buffer: format={}",
                       m_config.renderer.offscreen.color_format.c_str());
         } else {
@@ -1067,17 +1275,17 @@ namespace klingon {
             builder.add_graphics_pass(
                         "depth_prepass",
                         [this](const batleth::PassExecutionContext &ctx) {
-                            if (!m_active_scene) return;
+                            if (!m_frame_snapshot) return;
 
                             // Create frame info
                             FrameInfo frame_info{
                                 static_cast<int>(ctx.frame_index),
                                 ctx.delta_time,
                                 ctx.command_buffer,
-                                m_active_scene->get_camera(),
+                                m_frame_snapshot->camera,
                                 m_global_descriptor_sets[ctx.frame_index],
-                                m_texture_manager->get_descriptor_set(),
-                                m_active_scene->get_game_objects()
+                                m_texture_manager->get_descriptor_set(ctx.frame_index),
+                                *m_frame_snapshot
                             };
 
                             // Render depth only for opaque geometry
@@ -1092,10 +1300,10 @@ namespace klingon {
         if (m_config.renderer.forward_plus.enabled && m_config.renderer.forward_plus.enable_depth_prepass) {
             builder.add_compute_pass(
                         "light_culling",
-                        [this, depth_buffer, light_grid, light_count, tile_count_x, tile_count_y, tile_size, max_lights_per_tile, extent](
+                        [this, depth_buffer, light_grid, light_count, tile_size, max_lights_per_tile](
                             const batleth::PassExecutionContext &ctx
                         ) {
-                            if (!m_active_scene) return;
+                            if (!m_frame_snapshot) return;
                             if (m_light_culling_pipeline == VK_NULL_HANDLE) return;
 
                             // Get render graph resources
@@ -1105,10 +1313,10 @@ namespace klingon {
 
                             // Allocate/update descriptor set for this frame if needed
                             // For now, we'll allocate descriptor sets lazily
-                            if (m_forward_plus_descriptor_sets.size() < MAX_FRAMES_IN_FLIGHT) {
-                                m_forward_plus_descriptor_sets.resize(MAX_FRAMES_IN_FLIGHT);
+                            if (m_forward_plus_descriptor_sets.size() < m_frames_in_flight) {
+                                m_forward_plus_descriptor_sets.resize(m_frames_in_flight);
 
-                                for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
+                                for (uint32_t i = 0; i < m_frames_in_flight; ++i) {
                                     if (!batleth::DescriptorWriter(*m_forward_plus_set_layout, *m_forward_plus_descriptor_pool)
                                             .build(m_forward_plus_descriptor_sets[i])) {
                                         FED_ERROR("Failed to allocate Forward+ descriptor set for frame {}", i);
@@ -1160,14 +1368,14 @@ namespace klingon {
                             );
 
                             // Calculate push constants
-                            auto &camera = m_active_scene->get_camera();
+                            auto &camera = m_frame_snapshot->camera;
                             auto view_projection = camera.get_projection() * camera.get_view();
                             auto view_projection_inverse = glm::inverse(view_projection);
 
                             LightCullingPushConstants push_constants{};
                             push_constants.view_projection_inverse = view_projection_inverse;
-                            push_constants.screen_size = glm::uvec2(extent.width, extent.height);
-                            push_constants.tile_count = glm::uvec2(tile_count_x, tile_count_y);
+                            push_constants.screen_size = glm::uvec2(m_last_render_extent.width, m_last_render_extent.height);
+                            push_constants.tile_count = glm::uvec2(m_tile_count_x, m_tile_count_y);
                             push_constants.num_lights = static_cast<uint32_t>(m_current_ubo.num_lights);
                             push_constants.tile_size = tile_size;
                             push_constants.z_near = 0.1f;  // TODO: Get from camera
@@ -1184,7 +1392,7 @@ namespace klingon {
 
                             // Dispatch compute shader
                             // Workgroup size is 16x16, so we need (tile_count_x, tile_count_y, 1) workgroups
-                            ::vkCmdDispatch(ctx.command_buffer, tile_count_x, tile_count_y, 1);
+                            ::vkCmdDispatch(ctx.command_buffer, m_tile_count_x, m_tile_count_y, 1);
 
                             // FED_TRACE("Light culling compute dispatched: {}x{} tiles, {} lights",
                             //           tile_count_x, tile_count_y, push_constants.num_lights);
@@ -1198,18 +1406,18 @@ namespace klingon {
         // Main geometry/shading pass
         builder.add_graphics_pass(
                     "forward_shading",
-                    [this, tile_count_x, tile_count_y, tile_size, max_lights_per_tile](
+                    [this, tile_size, max_lights_per_tile](
                         const batleth::PassExecutionContext &ctx
                     ) {
-                        if (!m_active_scene) return;
+                        if (!m_frame_snapshot) return;
 
                         // Set Forward+ resources if enabled
                         if (m_config.renderer.forward_plus.enabled &&
                             !m_forward_plus_descriptor_sets.empty()) {
                             m_simple_render_system->set_forward_plus_resources(
                                 m_forward_plus_descriptor_sets[ctx.frame_index],
-                                tile_count_x,
-                                tile_count_y,
+                                m_tile_count_x,
+                                m_tile_count_y,
                                 tile_size,
                                 max_lights_per_tile
                             );
@@ -1220,10 +1428,10 @@ namespace klingon {
                             static_cast<int>(ctx.frame_index),
                             ctx.delta_time,
                             ctx.command_buffer,
-                            m_active_scene->get_camera(),
+                            m_frame_snapshot->camera,
                             m_global_descriptor_sets[ctx.frame_index],
-                            m_texture_manager->get_descriptor_set(),
-                            m_active_scene->get_game_objects()
+                            m_texture_manager->get_descriptor_set(ctx.frame_index),
+                            *m_frame_snapshot
                         };
 
                         // Render opaque game objects only
@@ -1263,15 +1471,15 @@ namespace klingon {
         // NEW: Transparency pass - render transparent objects after opaque
         builder.add_graphics_pass(
                     "transparency_pass",
-                    [this, tile_count_x, tile_count_y, tile_size, max_lights_per_tile](const batleth::PassExecutionContext& ctx) {
-                        if (!m_active_scene) return;
+                    [this, tile_size, max_lights_per_tile](const batleth::PassExecutionContext& ctx) {
+                        if (!m_frame_snapshot) return;
 
                         // Set Forward+ resources if enabled
                         if (m_config.renderer.forward_plus.enabled) {
                             m_simple_render_system->set_forward_plus_resources(
                                 m_forward_plus_descriptor_sets[ctx.frame_index],
-                                tile_count_x,
-                                tile_count_y,
+                                m_tile_count_x,
+                                m_tile_count_y,
                                 tile_size,
                                 max_lights_per_tile
                             );
@@ -1282,10 +1490,10 @@ namespace klingon {
                             static_cast<int>(ctx.frame_index),
                             ctx.delta_time,
                             ctx.command_buffer,
-                            m_active_scene->get_camera(),
+                            m_frame_snapshot->camera,
                             m_global_descriptor_sets[ctx.frame_index],
-                            m_texture_manager->get_descriptor_set(),
-                            m_active_scene->get_game_objects()
+                            m_texture_manager->get_descriptor_set(ctx.frame_index),
+                            *m_frame_snapshot
                         };
 
                         // Render ONLY transparent objects, sorted back-to-front
@@ -1359,15 +1567,70 @@ namespace klingon {
     }
 
     auto Renderer::should_rebuild_render_graph() const -> bool {
-        if (!m_render_graph) return true;
+        return !m_render_graph;
+    }
+
+    auto Renderer::resize_render_graph() -> void {
+        const auto extent = m_swapchain->get_extent();
+        if (extent.width == m_last_render_extent.width && extent.height == m_last_render_extent.height) {
+            return;
+        }
+
+        // Frames already submitted keep the old allocations until they retire on the timeline
+        const std::uint64_t retire_after = m_submitted_frame;
 
-        auto current_extent = m_swapchain->get_extent();
-        if (current_extent.width != m_last_render_extent.width ||
-            current_extent.height != m_last_render_extent.height) {
-            return true;
+        m_render_graph->resize_image(m_depth_handle, extent, retire_after);
+
+        if (m_config.renderer.forward_plus.enabled) {
+            const uint32_t tile_size = m_config.renderer.forward_plus.tile_size;
+            m_tile_count_x = (extent.width + tile_size - 1) / tile_size;
+            m_tile_count_y = (extent.height + tile_size - 1) / tile_size;
+
+            const VkDeviceSize tile_count = static_cast<VkDeviceSize>(m_tile_count_x) * m_tile_count_y;
+            m_render_graph->resize_buffer(
+                m_light_grid_handle,
+                tile_count * m_config.renderer.forward_plus.max_lights_per_tile * sizeof(uint32_t),
+                retire_after
+            );
+            m_render_graph->resize_buffer(m_light_count_handle, tile_count * sizeof(uint32_t), retire_after);
         }
 
-        return false;
+        if (m_config.renderer.offscreen.enabled && m_offscreen_color_handle != batleth::INVALID_RESOURCE) {
+            m_render_graph->resize_image(m_offscreen_color_handle, extent, retire_after);
+            m_offscreen_image_view = m_render_graph->get_image_view(m_offscreen_color_handle);
+        }
+
+        FED_INFO("Render graph resized from {}x{} to {}x{}", m_last_render_extent.width,
+                 m_last_render_extent.height, extent.width, extent.height);
+        m_last_render_extent = extent;
+    }
+
+    auto Renderer::collect_retired_resources() -> void {
+        std::uint64_t completed = 0;
+        ::vkGetSemaphoreCounterValue(m_device->get_logical_device(), m_frame_timeline, &completed);
+
+        while (!m_retired_swapchains.empty() && m_retired_swapchains.front().retire_after <= completed) {
+            destroy_retired_swapchain(m_retired_swapchains.front());
+            m_retired_swapchains.pop_front();
+        }
+
+        if (m_render_graph) {
+            m_render_graph->collect_retired(completed);
+        }
+    }
+
+    auto Renderer::destroy_retired_swapchain(RetiredSwapchain &retired) -> void {
+        const VkDevice device = m_device->get_logical_device();
+        if (retired.depth_image_view != VK_NULL_HANDLE) {
+            ::vkDestroyImageView(device, retired.depth_image_view, nullptr);
+        }
+        if (retired.depth_image != VK_NULL_HANDLE) {
+            ::vkDestroyImage(device, retired.depth_image, nullptr);
+        }
+        if (retired.depth_image_memory != VK_NULL_HANDLE) {
+            ::vkFreeMemory(device, retired.depth_image_memory, nullptr);
+        }
+        retired.swapchain.reset();
     }
 
     auto Renderer::invalidate_render_graph() -> void {
@@ -1375,6 +1638,14 @@ namespace klingon {
         m_render_graph.reset();
     }
 
+    auto Renderer::dump_render_graph(const std::filesystem::path &path) const -> bool {
+        if (!m_render_graph) {
+            FED_WARN("No render graph to dump - it is built on the first rendered frame");
+            return false;
+        }
+        return m_render_graph->dump(path);
+    }
+
     auto Renderer::set_debug_rendering_enabled(bool enabled) -> void {
         m_debug_rendering_enabled = enabled;
     }
@@ -1419,6 +1690,7 @@ namespace klingon {
         alloc_config.instance = get_instance();
         alloc_config.physical_device = get_physical_device();
         alloc_config.device = get_device();
+        alloc_config.memory_budget = m_device->has_memory_budget();
 
         m_allocator = std::make_unique<batleth::TransientAllocator>(alloc_config);
 
@@ -1431,30 +1703,62 @@ namespace klingon {
             return;
         }
 
-        m_active_scene = scene;
+        recreate_swapchain_if_needed();
+
+        // ImGui first, so edits made in the callback show up in this frame
+        build_imgui_frame();
+        prepare_snapshot(*scene, delta_time, m_snapshot);
+        m_snapshot.release_retired();  // Nothing is recording on this thread between frames
+        render_snapshot(m_snapshot);
+    }
+
+    auto Renderer::build_imgui_frame() -> void {
+        if (!m_imgui_context) return;
+
+        m_imgui_context->begin_frame();
+        if (m_imgui_callback) {
+            m_imgui_callback();
+        }
+        m_imgui_context->end_frame();
+    }
+
+    auto Renderer::prepare_snapshot(Scene &scene, float delta_time, RenderSnapshot &snapshot) -> void {
+        // Scene-side per-frame updates stay with game logic: lights orbit, camera follows its transform
+        PointLightSystem::animate(scene.get_game_objects(), delta_time);
+        update_camera_from_scene(&scene, delta_time);
 
-        // Rebuild render graph if needed
+        const auto start = std::chrono::steady_clock::now();
+        snapshot.extract(scene, delta_time);
+        snapshot.input_time = m_input_time;
+        m_snapshot_time_ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        FED_TRACE("Snapshot: {} objects, {} lights, {} joints in {:.3f} ms", snapshot.get_object_count(),
+                  snapshot.get_light_count(), snapshot.palettes.size(), m_snapshot_time_ms);
+    }
+
+    auto Renderer::render_snapshot(RenderSnapshot &snapshot) -> void {
+        std::lock_guard lock(m_render_mutex);
+
+        // Rebuild the render graph after invalidation; a resize only reallocates its screen-sized resources
         if (should_rebuild_render_graph()) {
-            FED_INFO("Rebuilding render graph due to resize or invalidation");
+            FED_INFO("Rebuilding render graph");
             build_default_render_graph();
+        } else {
+            resize_render_graph();
         }
 
-        // Begin frame (acquires swapchain image and begins ImGui frame)
+        // Begin frame (waits for this slot's frame on the timeline and acquires a swapchain image)
         if (!begin_frame()) {
             return; // Frame not ready (e.g., window minimized)
         }
 
-        // Call ImGui callback if enabled (after begin_frame() has started ImGui frame)
-        if (m_imgui_context && m_imgui_callback) {
-            m_imgui_callback();
-            m_imgui_context->end_frame();
-        }
+        m_frame_snapshot = &snapshot;
 
-        // Update camera matrices from scene
-        update_camera_from_scene(scene, delta_time);
+        // Update global UBO from the snapshot
+        update_global_ubo(snapshot);
 
-        // Update global UBO from scene
-        update_global_ubo(scene, delta_time);
+        // Feed on-screen sizes to texture streaming
+        request_texture_residency(snapshot);
 
         // Begin command buffer
         auto cmd = get_current_command_buffer();
@@ -1463,6 +1767,26 @@ namespace klingon {
         begin_info.flags = 0;
         ::vkBeginCommandBuffer(cmd, &begin_info);
 
+        if (m_pacing_queries != VK_NULL_HANDLE) {
+            ::vkCmdResetQueryPool(cmd, m_pacing_queries, m_current_frame * 2, 2);
+            ::vkCmdWriteTimestamp2(cmd, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT, m_pacing_queries, m_current_frame * 2);
+        }
+
+        // This slot's frame has retired on the timeline: meshes released a full ring ago are idle
+        m_resources->begin_frame();
+
+        // Materials and textures of models destroyed since the last frame, before streaming reads the slots
+        m_texture_manager->apply_queued_releases();
+
+        // Record streamed texture uploads/evictions ahead of the graph and patch this frame's bindless set
+        m_texture_manager->update_streaming(cmd, m_current_frame);
+        m_texture_manager->flush_materials(cmd, m_current_frame);
+
+        // Skinned copies are written before any pass draws them
+        if (m_skinning_system) {
+            m_skinning_system->record(cmd, m_current_frame, snapshot);
+        }
+
         // Set backbuffer with current swapchain image
         m_render_graph->set_backbuffer(
             m_swapchain->get_images()[m_current_image_index],
@@ -1472,12 +1796,19 @@ namespace klingon {
         );
 
         // Execute render graph
-        m_render_graph->execute(cmd, m_current_frame, delta_time);
+        m_render_graph->execute(cmd, m_current_frame, snapshot.frame_time);
+
+        if (m_pacing_queries != VK_NULL_HANDLE) {
+            ::vkCmdWriteTimestamp2(cmd, VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT, m_pacing_queries,
+                                   m_current_frame * 2 + 1);
+            m_pacing_written[m_current_frame] = true;
+        }
 
         // End command buffer
         ::vkEndCommandBuffer(cmd);
 
         // End frame (submits command buffer, presents image)
         end_frame();
+        m_frame_snapshot = nullptr;
     }
 } // namespace klingon
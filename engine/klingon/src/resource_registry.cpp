@@ -0,0 +1,36 @@
+#include "klingon/resource_registry.hpp"
+#include "federation/log.hpp"
+
+namespace klingon {
+    ResourceRegistry::ResourceRegistry(const Config& config)
+        : m_meshes(config.frames_in_flight) {
+        FED_DEBUG("ResourceRegistry created ({} frames in flight)", config.frames_in_flight);
+    }
+
+    ResourceRegistry::~ResourceRegistry() {
+        const Stats stats = get_stats();
+        if (stats.meshes > 0) {
+            FED_WARN("ResourceRegistry destroyed with {} meshes still loaded", stats.meshes);
+        }
+        m_meshes.collect_all();
+    }
+
+    auto ResourceRegistry::release_mesh(MeshHandle handle) -> void {
+        std::lock_guard lock(m_mutex);
+        m_meshes.release(handle, m_frame);
+    }
+
+    auto ResourceRegistry::begin_frame() -> void {
+        std::lock_guard lock(m_mutex);
+        ++m_frame;
+        m_meshes.collect(m_frame);
+    }
+
+    auto ResourceRegistry::get_stats() const -> Stats {
+        std::lock_guard lock(m_mutex);
+        return Stats{
+            .meshes = m_meshes.size(),
+            .retired_meshes = m_meshes.retired_count()
+        };
+    }
+} // namespace klingon
@@ -1,7 +1,27 @@
 #include "klingon/scene.hpp"
 #include "federation/log.hpp"
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace klingon {
+    namespace {
+        /**
+         * Animated models start on their first clip; game code takes over through obj.animator
+         */
+        auto create_animator(const ModelData& model_data) -> std::unique_ptr<Animator> {
+            if (!model_data.animation) {
+                return nullptr;
+            }
+            auto animator = std::make_unique<Animator>(model_data.animation);
+            if (!model_data.animation->clips.empty()) {
+                animator->play(0);
+            }
+            return animator;
+        }
+    }
+
     Scene::Scene() {
         // Create camera automatically
         m_camera = std::make_unique<Camera>();
@@ -41,6 +61,54 @@ namespace klingon {
         return id;
     }
 
+    auto Scene::instantiate(const Prefab& prefab, std::span<const Transform> transforms) -> GameObject::id_t {
+        const auto node_count = static_cast<uint32_t>(prefab.nodes.size());
+        const auto object_count = static_cast<uint32_t>(node_count * transforms.size());
+        const GameObject::id_t first_id = GameObject::reserve_ids(object_count);
+        if (object_count == 0) {
+            return first_id;
+        }
+
+        // Node transforms relative to the instance root, resolved once for every instance.
+        // Roots with an identity transform (the usual single-node prefab) take the instance transform as is.
+        std::vector<glm::mat4> root_relative(node_count);
+        std::vector<bool> passthrough(node_count);
+        for (uint32_t n = 0; n < node_count; ++n) {
+            const auto& node = prefab.nodes[n];
+            const glm::mat4 local = node.transform.mat4();
+            root_relative[n] = node.parent == Prefab::NO_PARENT ? local : root_relative[node.parent] * local;
+            passthrough[n] = node.parent == Prefab::NO_PARENT && local == glm::mat4{1.f};
+        }
+
+        m_game_objects.reserve(m_game_objects.size() + object_count);
+
+        GameObject::id_t id = first_id;
+        for (const Transform& instance : transforms) {
+            const glm::mat4 instance_matrix = instance.mat4();
+            for (uint32_t n = 0; n < node_count; ++n) {
+                const auto& node = prefab.nodes[n];
+                GameObject obj{id};
+                obj.transform = passthrough[n] ? instance : Transform::from_mat4(instance_matrix * root_relative[n]);
+                obj.color = node.color;
+                obj.model_filepath = node.model_filepath;
+                obj.model_data = node.model_data;
+                obj.is_static = node.is_static;
+                if (node.model_data) {
+                    obj.animator = create_animator(*node.model_data);
+                }
+                if (node.point_light) {
+                    obj.point_light = std::make_unique<PointLightComponent>(*node.point_light);
+                }
+                m_game_objects.emplace(id, std::move(obj));
+                ++id;
+            }
+        }
+
+        FED_DEBUG("Instantiated prefab '{}' {} times ({} game objects) in scene '{}'",
+                  prefab.name, transforms.size(), object_count, m_name);
+        return first_id;
+    }
+
     auto Scene::remove_game_object(GameObject::id_t id) -> bool {
         auto it = m_game_objects.find(id);
         if (it != m_game_objects.end()) {
@@ -91,22 +159,45 @@ namespace klingon {
         uint32_t loaded_count = 0;
         uint32_t failed_count = 0;
 
+        // Load each distinct model once, with all the cooked files read concurrently
+        std::vector<std::string> filepaths;
+        std::unordered_map<AssetPath, size_t> model_slots;
+        for (const auto& [id, obj] : m_game_objects) {
+            if (!obj.model_filepath.empty() && model_slots.try_emplace(obj.model_filepath, filepaths.size()).second) {
+                filepaths.emplace_back(obj.model_filepath.str());
+            }
+        }
+        const auto models = asset_loader.load_models(filepaths);
+
         for (auto& [id, obj] : m_game_objects) {
             if (!obj.model_filepath.empty()) {
-                FED_TRACE("Loading model '{}' for game object {}", obj.model_filepath, id);
+                FED_TRACE("Assigning model '{}' to game object {}", obj.model_filepath.str(), id);
 
-                auto model_data = asset_loader.load_model(obj.model_filepath);
+                auto model_data = models[model_slots.at(obj.model_filepath)];
                 if (model_data) {
                     obj.model_data = model_data;
+                    obj.animator = create_animator(*model_data);
                     loaded_count++;
                 } else {
-                    FED_ERROR("Failed to load model '{}' for game object {}", obj.model_filepath, id);
+                    FED_ERROR("Failed to load model '{}' for game object {}", obj.model_filepath.str(), id);
                     failed_count++;
                 }
             }
         }
 
+        // Batches were built from the previous models
+        clear_static_geometry();
+
         FED_INFO("Resource reload complete for scene '{}': {} loaded, {} failed",
                  m_name, loaded_count, failed_count);
     }
+
+    auto Scene::build_static_geometry(batleth::Device& device, ResourceRegistry& resources,
+                                      const StaticGeometry::Config& config) -> void {
+        m_static_geometry = StaticGeometry::build(device, resources, m_game_objects, config);
+    }
+
+    auto Scene::clear_static_geometry() -> void {
+        m_static_geometry.reset();
+    }
 } // namespace klingon
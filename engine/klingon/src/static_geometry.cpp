@@ -0,0 +1,153 @@
+#include "klingon/static_geometry.hpp"
+#include "federation/log.hpp"
+
+#include <array>
+#include <cmath>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+
+namespace klingon {
+    namespace {
+        // Material, transparency, then cell, so batches come out grouped by material
+        using BatchKey = std::tuple<uint32_t, bool, int32_t, int32_t, int32_t>;
+
+        // Matches the transparency test of the render systems
+        auto is_transparent(const Material& material) -> bool {
+            return (material.gpu_data.material_flags & 8u) != 0u || material.gpu_data.base_color_factor.a < 0.99f;
+        }
+
+        auto transform_aabb(const AABB& bounds, const glm::mat4& matrix) -> AABB {
+            AABB result{glm::vec3(INFINITY), glm::vec3(-INFINITY)};
+            for (int corner = 0; corner < 8; ++corner) {
+                const glm::vec3 local{
+                    (corner & 1) ? bounds.max.x : bounds.min.x,
+                    (corner & 2) ? bounds.max.y : bounds.min.y,
+                    (corner & 4) ? bounds.max.z : bounds.min.z
+                };
+                const glm::vec3 world = glm::vec3(matrix * glm::vec4(local, 1.f));
+                result.min = glm::min(result.min, world);
+                result.max = glm::max(result.max, world);
+            }
+            return result;
+        }
+
+        /**
+         * Frustum planes (xyz normal pointing inside, w distance) of a 0..1 depth view-projection
+         */
+        auto extract_frustum_planes(const glm::mat4& m) -> std::array<glm::vec4, 6> {
+            const glm::vec4 row0{m[0][0], m[1][0], m[2][0], m[3][0]};
+            const glm::vec4 row1{m[0][1], m[1][1], m[2][1], m[3][1]};
+            const glm::vec4 row2{m[0][2], m[1][2], m[2][2], m[3][2]};
+            const glm::vec4 row3{m[0][3], m[1][3], m[2][3], m[3][3]};
+            return {row3 + row0, row3 - row0, row3 + row1, row3 - row1, row2, row3 - row2};
+        }
+    }
+
+    auto StaticGeometry::build(batleth::Device& device, ResourceRegistry& resources, const GameObject::Map& game_objects,
+                               const Config& config) -> std::unique_ptr<StaticGeometry> {
+        auto geometry = std::unique_ptr<StaticGeometry>(new StaticGeometry(resources));
+        const float cell_size = config.cell_size > 0.f ? config.cell_size : 32.f;
+
+        std::unordered_map<const Mesh*, MeshData> mesh_data;  // Each shared mesh is read back once
+        std::map<BatchKey, MeshData> pending;
+
+        for (const auto& [id, obj] : game_objects) {
+            if (!obj.is_static || !obj.model_data || obj.animator) {
+                continue;
+            }
+            const auto& model = *obj.model_data;
+            bool skinned = false;
+            for (size_t mesh_idx = 0; mesh_idx < model.meshes.size(); ++mesh_idx) {
+                skinned = skinned || model.get_mesh(mesh_idx).is_skinned();
+            }
+            if (skinned) {
+                FED_WARN("Static game object {} has skinned meshes; drawing it unbatched", id);
+                continue;
+            }
+
+            const glm::mat4 model_matrix = obj.transform.mat4();
+            const glm::mat3 normal_matrix = obj.transform.normal_matrix();
+
+            for (size_t mesh_idx = 0; mesh_idx < model.meshes.size(); ++mesh_idx) {
+                const Mesh* mesh = &model.get_mesh(mesh_idx);
+                auto [data, inserted] = mesh_data.try_emplace(mesh);
+                if (inserted) {
+                    mesh->read_back(data->second.vertices, data->second.indices);
+                }
+
+                const AABB world_bounds = transform_aabb(mesh->get_aabb(), model_matrix);
+                const glm::ivec3 cell = glm::ivec3(glm::floor((world_bounds.min + world_bounds.max) * 0.5f / cell_size));
+                const Material& material = model.materials[model.mesh_material_indices[mesh_idx]];
+                auto& batch = pending[{model.get_mesh_material_index(mesh_idx), is_transparent(material),
+                                       cell.x, cell.y, cell.z}];
+
+                const auto base = static_cast<uint32_t>(batch.vertices.size());
+                for (const Vertex& vertex : data->second.vertices) {
+                    Vertex& world = batch.vertices.emplace_back(vertex);
+                    world.position = glm::vec3(model_matrix * glm::vec4(vertex.position, 1.f));
+                    const glm::vec3 normal = normal_matrix * vertex.normal;
+                    const float length = glm::length(normal);
+                    world.normal = length > 0.f ? normal / length : normal;
+                }
+
+                // Meshes drawn without indices become sequential indices so batches can mix both
+                if (data->second.indices.empty()) {
+                    for (uint32_t i = 0; i < mesh->get_vertex_count(); ++i) {
+                        batch.indices.push_back(base + i);
+                    }
+                } else {
+                    for (uint32_t index : data->second.indices) {
+                        batch.indices.push_back(base + index);
+                    }
+                }
+                geometry->m_stats.source_meshes++;
+            }
+
+            geometry->m_batched_objects.insert(id);
+        }
+
+        geometry->m_batches.reserve(pending.size());
+        for (auto& [key, batch] : pending) {
+            const AABB bounds = compute_aabb(batch.vertices);
+            geometry->m_batches.push_back(Batch{
+                .mesh = resources.create_mesh(device, batch.vertices, batch.indices, bounds),
+                .material_index = std::get<0>(key),
+                .transparent = std::get<1>(key),
+                .bounds = bounds,
+                .center = (bounds.min + bounds.max) * 0.5f
+            });
+        }
+
+        geometry->m_stats.objects = static_cast<uint32_t>(geometry->m_batched_objects.size());
+        geometry->m_stats.batches = static_cast<uint32_t>(geometry->m_batches.size());
+        FED_INFO("Static geometry: {} objects, {} meshes merged into {} batches",
+                 geometry->m_stats.objects, geometry->m_stats.source_meshes, geometry->m_stats.batches);
+        return geometry;
+    }
+
+    StaticGeometry::~StaticGeometry() {
+        for (const Batch& batch : m_batches) {
+            m_resources->release_mesh(batch.mesh);
+        }
+    }
+
+    auto StaticGeometry::cull(const glm::mat4& view_projection, std::vector<const Batch*>& visible) const -> void {
+        const auto planes = extract_frustum_planes(view_projection);
+        for (const Batch& batch : m_batches) {
+            bool inside = true;
+            for (const glm::vec4& plane : planes) {
+                // Corner furthest along the plane normal; the box is outside if even that is behind it
+                const glm::vec3 corner = glm::mix(batch.bounds.min, batch.bounds.max,
+                                                  glm::greaterThanEqual(glm::vec3(plane), glm::vec3(0.f)));
+                if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.f) {
+                    inside = false;
+                    break;
+                }
+            }
+            if (inside) {
+                visible.push_back(&batch);
+            }
+        }
+    }
+} // namespace klingon
@@ -0,0 +1,471 @@
+#include "klingon/texture_formats.hpp"
+
+#include <basisu_transcoder.h>
+#include <zstd.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <format>
+#include <mutex>
+
+namespace klingon {
+
+namespace {
+    constexpr uint32_t DDS_MAGIC = 0x20534444;  // "DDS "
+    constexpr size_t DDS_HEADER_SIZE = 124;
+    constexpr size_t DDS_DX10_HEADER_SIZE = 20;
+    constexpr uint32_t DDSD_MIPMAPCOUNT = 0x20000;
+    constexpr uint32_t DDPF_FOURCC = 0x4;
+    constexpr uint32_t DDPF_RGB = 0x40;
+    constexpr uint32_t DDSCAPS2_CUBEMAP = 0x200;
+    constexpr uint32_t DDSCAPS2_VOLUME = 0x200000;
+    constexpr uint32_t DDS_DIMENSION_TEXTURE2D = 3;
+    constexpr uint32_t DDS_RESOURCE_MISC_TEXTURECUBE = 0x4;
+
+    constexpr std::array<uint8_t, 12> KTX2_IDENTIFIER = {
+        0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A
+    };
+    constexpr size_t KTX2_HEADER_SIZE = 80;         // Identifier + header + index
+    constexpr size_t KTX2_LEVEL_INDEX_ENTRY_SIZE = 24;
+    constexpr uint32_t KTX2_SUPERCOMPRESSION_NONE = 0;
+    constexpr uint32_t KTX2_SUPERCOMPRESSION_ZSTD = 2;
+
+    // Header fields are untrusted; these keep size arithmetic in 64 bits and allocations sane
+    constexpr uint32_t MAX_TEXTURE_DIMENSION = 16384;
+    constexpr uint32_t MAX_ARRAY_LAYERS = 2048;
+
+    constexpr auto make_fourcc(char a, char b, char c, char d) -> uint32_t {
+        return static_cast<uint32_t>(static_cast<uint8_t>(a)) |
+               static_cast<uint32_t>(static_cast<uint8_t>(b)) << 8 |
+               static_cast<uint32_t>(static_cast<uint8_t>(c)) << 16 |
+               static_cast<uint32_t>(static_cast<uint8_t>(d)) << 24;
+    }
+
+    // Both containers are little-endian regardless of host
+    auto read_u32(std::span<const uint8_t> data, size_t offset) -> uint32_t {
+        return static_cast<uint32_t>(data[offset]) |
+               static_cast<uint32_t>(data[offset + 1]) << 8 |
+               static_cast<uint32_t>(data[offset + 2]) << 16 |
+               static_cast<uint32_t>(data[offset + 3]) << 24;
+    }
+
+    auto read_u64(std::span<const uint8_t> data, size_t offset) -> uint64_t {
+        return static_cast<uint64_t>(read_u32(data, offset)) |
+               static_cast<uint64_t>(read_u32(data, offset + 4)) << 32;
+    }
+
+    auto mip_extent(uint32_t size, uint32_t mip) -> uint32_t {
+        return std::max(size >> mip, 1u);
+    }
+
+    /**
+     * Reject dimensions and mip counts that no valid file has, before they reach any size arithmetic
+     */
+    auto validate_extent(uint32_t width, uint32_t height, uint32_t mip_count) -> std::expected<void, std::string> {
+        if (width == 0 || height == 0) {
+            return std::unexpected("zero-sized texture");
+        }
+        if (width > MAX_TEXTURE_DIMENSION || height > MAX_TEXTURE_DIMENSION) {
+            return std::unexpected(std::format("{}x{} exceeds the {} texel limit", width, height,
+                                               MAX_TEXTURE_DIMENSION));
+        }
+        const auto full_chain = static_cast<uint32_t>(std::bit_width(std::max(width, height)));
+        if (mip_count > full_chain) {
+            return std::unexpected(std::format("{} mips for a {}x{} texture, at most {} possible",
+                                               mip_count, width, height, full_chain));
+        }
+        return {};
+    }
+
+    auto to_srgb(VkFormat format) -> VkFormat {
+        switch (format) {
+            case VK_FORMAT_BC1_RGB_UNORM_BLOCK: return VK_FORMAT_BC1_RGB_SRGB_BLOCK;
+            case VK_FORMAT_BC1_RGBA_UNORM_BLOCK: return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+            case VK_FORMAT_BC2_UNORM_BLOCK: return VK_FORMAT_BC2_SRGB_BLOCK;
+            case VK_FORMAT_BC3_UNORM_BLOCK: return VK_FORMAT_BC3_SRGB_BLOCK;
+            case VK_FORMAT_BC7_UNORM_BLOCK: return VK_FORMAT_BC7_SRGB_BLOCK;
+            case VK_FORMAT_R8G8B8A8_UNORM: return VK_FORMAT_R8G8B8A8_SRGB;
+            case VK_FORMAT_B8G8R8A8_UNORM: return VK_FORMAT_B8G8R8A8_SRGB;
+            default: return format;
+        }
+    }
+
+    auto dds_fourcc_format(uint32_t fourcc) -> VkFormat {
+        switch (fourcc) {
+            case make_fourcc('D', 'X', 'T', '1'): return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+            case make_fourcc('D', 'X', 'T', '2'):
+            case make_fourcc('D', 'X', 'T', '3'): return VK_FORMAT_BC2_UNORM_BLOCK;
+            case make_fourcc('D', 'X', 'T', '4'):
+            case make_fourcc('D', 'X', 'T', '5'): return VK_FORMAT_BC3_UNORM_BLOCK;
+            case make_fourcc('A', 'T', 'I', '1'):
+            case make_fourcc('B', 'C', '4', 'U'): return VK_FORMAT_BC4_UNORM_BLOCK;
+            case make_fourcc('B', 'C', '4', 'S'): return VK_FORMAT_BC4_SNORM_BLOCK;
+            case make_fourcc('A', 'T', 'I', '2'):
+            case make_fourcc('B', 'C', '5', 'U'): return VK_FORMAT_BC5_UNORM_BLOCK;
+            case make_fourcc('B', 'C', '5', 'S'): return VK_FORMAT_BC5_SNORM_BLOCK;
+            default: return VK_FORMAT_UNDEFINED;
+        }
+    }
+
+    auto dxgi_format(uint32_t dxgi) -> VkFormat {
+        switch (dxgi) {
+            case 28: return VK_FORMAT_R8G8B8A8_UNORM;            // DXGI_FORMAT_R8G8B8A8_UNORM
+            case 29: return VK_FORMAT_R8G8B8A8_SRGB;
+            case 87: return VK_FORMAT_B8G8R8A8_UNORM;            // DXGI_FORMAT_B8G8R8A8_UNORM
+            case 91: return VK_FORMAT_B8G8R8A8_SRGB;
+            case 70:                                            // DXGI_FORMAT_BC1_TYPELESS
+            case 71: return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+            case 72: return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+            case 73:
+            case 74: return VK_FORMAT_BC2_UNORM_BLOCK;
+            case 75: return VK_FORMAT_BC2_SRGB_BLOCK;
+            case 76:
+            case 77: return VK_FORMAT_BC3_UNORM_BLOCK;
+            case 78: return VK_FORMAT_BC3_SRGB_BLOCK;
+            case 79:
+            case 80: return VK_FORMAT_BC4_UNORM_BLOCK;
+            case 81: return VK_FORMAT_BC4_SNORM_BLOCK;
+            case 82:
+            case 83: return VK_FORMAT_BC5_UNORM_BLOCK;
+            case 84: return VK_FORMAT_BC5_SNORM_BLOCK;
+            case 94:
+            case 95: return VK_FORMAT_BC6H_UFLOAT_BLOCK;
+            case 96: return VK_FORMAT_BC6H_SFLOAT_BLOCK;
+            case 97:
+            case 98: return VK_FORMAT_BC7_UNORM_BLOCK;
+            case 99: return VK_FORMAT_BC7_SRGB_BLOCK;
+            default: return VK_FORMAT_UNDEFINED;
+        }
+    }
+
+    /**
+     * Copy `levels` tightly packed mips, stored back to back from `offset`
+     */
+    auto read_packed_levels(
+        std::span<const uint8_t> data,
+        size_t offset,
+        TextureData& texture,
+        uint32_t levels
+    ) -> std::expected<void, std::string> {
+        for (uint32_t mip = 0; mip < levels; ++mip) {
+            const uint32_t width = mip_extent(texture.width, mip);
+            const uint32_t height = mip_extent(texture.height, mip);
+            const uint64_t size = get_level_size(texture.format, width, height);
+
+            if (offset > data.size() || size > data.size() - offset) {
+                return std::unexpected(std::format("truncated at mip {} ({} bytes needed, {} available)",
+                                                   mip, offset + size, data.size()));
+            }
+
+            texture.levels.push_back({
+                .width = width,
+                .height = height,
+                .data = std::vector<uint8_t>(data.begin() + offset, data.begin() + offset + size)
+            });
+            offset += size;
+        }
+        return {};
+    }
+
+    struct TranscodeTarget {
+        basist::transcoder_texture_format basis_format;
+        VkFormat format;
+    };
+
+    auto select_transcode_target(
+        batleth::TextureType type,
+        bool uastc,
+        bool has_alpha,
+        bool srgb,
+        const BlockFormatSupport& support
+    ) -> TranscodeTarget {
+        using basist::transcoder_texture_format;
+
+        // ETC1S only fills BC5's second channel from an alpha slice; UASTC uses R and G directly
+        if (type == batleth::TextureType::Normal && support.bc5 && (uastc || has_alpha)) {
+            return {transcoder_texture_format::cTFBC5_RG, VK_FORMAT_BC5_UNORM_BLOCK};
+        }
+        if (support.bc7) {
+            return {transcoder_texture_format::cTFBC7_RGBA,
+                    srgb ? VK_FORMAT_BC7_SRGB_BLOCK : VK_FORMAT_BC7_UNORM_BLOCK};
+        }
+        if (has_alpha && support.bc3) {
+            return {transcoder_texture_format::cTFBC3_RGBA,
+                    srgb ? VK_FORMAT_BC3_SRGB_BLOCK : VK_FORMAT_BC3_UNORM_BLOCK};
+        }
+        if (!has_alpha && support.bc1) {
+            return {transcoder_texture_format::cTFBC1_RGB,
+                    srgb ? VK_FORMAT_BC1_RGB_SRGB_BLOCK : VK_FORMAT_BC1_RGB_UNORM_BLOCK};
+        }
+        return {transcoder_texture_format::cTFRGBA32,
+                srgb ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM};
+    }
+
+    auto transcode_basis_ktx2(
+        std::span<const uint8_t> data,
+        batleth::TextureType type,
+        const BlockFormatSupport& support
+    ) -> std::expected<TextureData, std::string> {
+        static std::once_flag init_flag;
+        std::call_once(init_flag, [] { basist::basisu_transcoder_init(); });
+
+        basist::ktx2_transcoder transcoder;
+        if (!transcoder.init(data.data(), static_cast<uint32_t>(data.size()))) {
+            return std::unexpected("not a valid Basis Universal KTX2 file");
+        }
+        if (transcoder.get_faces() != 1) {
+            return std::unexpected("cube maps are not supported");
+        }
+        if (!transcoder.start_transcoding()) {
+            return std::unexpected("failed to read Basis Universal global data");
+        }
+
+        const bool srgb = transcoder.get_dfd_transfer_func() == basist::KTX2_KHR_DF_TRANSFER_SRGB;
+        const auto target = select_transcode_target(type, transcoder.is_uastc(), transcoder.get_has_alpha(),
+                                                    srgb, support);
+        const uint32_t unit_size = basist::basis_get_bytes_per_block_or_pixel(target.basis_format);
+        const bool uncompressed = basist::basis_transcoder_format_is_uncompressed(target.basis_format);
+
+        TextureData texture{};
+        texture.format = target.format;
+        texture.width = transcoder.get_width();
+        texture.height = transcoder.get_height();
+
+        for (uint32_t mip = 0; mip < transcoder.get_levels(); ++mip) {
+            basist::ktx2_image_level_info info{};
+            if (!transcoder.get_image_level_info(info, mip, 0, 0)) {
+                return std::unexpected(std::format("missing level info for mip {}", mip));
+            }
+
+            const uint32_t units = uncompressed ? info.m_orig_width * info.m_orig_height : info.m_total_blocks;
+            TextureLevel level{
+                .width = info.m_orig_width,
+                .height = info.m_orig_height,
+                .data = std::vector<uint8_t>(static_cast<size_t>(units) * unit_size)
+            };
+
+            if (!transcoder.transcode_image_level(mip, 0, 0, level.data.data(), units, target.basis_format)) {
+                return std::unexpected(std::format("failed to transcode mip {}", mip));
+            }
+            texture.levels.push_back(std::move(level));
+        }
+
+        return texture;
+    }
+} // anonymous namespace
+
+auto get_format_block_size(VkFormat format) -> uint32_t {
+    switch (format) {
+        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+        case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+        case VK_FORMAT_BC4_UNORM_BLOCK:
+        case VK_FORMAT_BC4_SNORM_BLOCK:
+            return 8;
+        case VK_FORMAT_BC2_UNORM_BLOCK:
+        case VK_FORMAT_BC2_SRGB_BLOCK:
+        case VK_FORMAT_BC3_UNORM_BLOCK:
+        case VK_FORMAT_BC3_SRGB_BLOCK:
+        case VK_FORMAT_BC5_UNORM_BLOCK:
+        case VK_FORMAT_BC5_SNORM_BLOCK:
+        case VK_FORMAT_BC6H_UFLOAT_BLOCK:
+        case VK_FORMAT_BC6H_SFLOAT_BLOCK:
+        case VK_FORMAT_BC7_UNORM_BLOCK:
+        case VK_FORMAT_BC7_SRGB_BLOCK:
+            return 16;
+        case VK_FORMAT_R8G8B8A8_UNORM:
+        case VK_FORMAT_R8G8B8A8_SRGB:
+        case VK_FORMAT_B8G8R8A8_UNORM:
+        case VK_FORMAT_B8G8R8A8_SRGB:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+auto is_block_compressed(VkFormat format) -> bool {
+    return format >= VK_FORMAT_BC1_RGB_UNORM_BLOCK && format <= VK_FORMAT_BC7_SRGB_BLOCK;
+}
+
+auto get_level_size(VkFormat format, uint32_t width, uint32_t height) -> uint64_t {
+    if (is_block_compressed(format)) {
+        const uint64_t blocks_x = (static_cast<uint64_t>(width) + 3) / 4;
+        const uint64_t blocks_y = (static_cast<uint64_t>(height) + 3) / 4;
+        return blocks_x * blocks_y * get_format_block_size(format);
+    }
+    return static_cast<uint64_t>(width) * height * get_format_block_size(format);
+}
+
+auto parse_dds(std::span<const uint8_t> data, bool srgb) -> std::expected<TextureData, std::string> {
+    if (data.size() < 4 + DDS_HEADER_SIZE || read_u32(data, 0) != DDS_MAGIC) {
+        return std::unexpected("not a DDS file");
+    }
+
+    const auto header = data.subspan(4, DDS_HEADER_SIZE);
+    if (read_u32(header, 0) != DDS_HEADER_SIZE) {
+        return std::unexpected("invalid DDS header size");
+    }
+
+    const uint32_t flags = read_u32(header, 4);
+    const uint32_t height = read_u32(header, 8);
+    const uint32_t width = read_u32(header, 12);
+    const uint32_t mip_count = (flags & DDSD_MIPMAPCOUNT) ? std::max(read_u32(header, 24), 1u) : 1;
+    const uint32_t pf_flags = read_u32(header, 76);
+    const uint32_t fourcc = read_u32(header, 80);
+    const uint32_t caps2 = read_u32(header, 108);
+
+    if (auto valid = validate_extent(width, height, mip_count); !valid) {
+        return std::unexpected(valid.error());
+    }
+    if (caps2 & (DDSCAPS2_CUBEMAP | DDSCAPS2_VOLUME)) {
+        return std::unexpected("cube maps and volume textures are not supported");
+    }
+
+    size_t offset = 4 + DDS_HEADER_SIZE;
+    VkFormat format = VK_FORMAT_UNDEFINED;
+
+    if ((pf_flags & DDPF_FOURCC) && fourcc == make_fourcc('D', 'X', '1', '0')) {
+        if (data.size() < offset + DDS_DX10_HEADER_SIZE) {
+            return std::unexpected("truncated DX10 header");
+        }
+        const auto dx10 = data.subspan(offset, DDS_DX10_HEADER_SIZE);
+        const uint32_t dxgi = read_u32(dx10, 0);
+        if (read_u32(dx10, 4) != DDS_DIMENSION_TEXTURE2D || (read_u32(dx10, 8) & DDS_RESOURCE_MISC_TEXTURECUBE)) {
+            return std::unexpected("only 2D textures are supported");
+        }
+
+        // The DX10 header states the colour space explicitly
+        format = dxgi_format(dxgi);
+        if (format == VK_FORMAT_UNDEFINED) {
+            return std::unexpected(std::format("unsupported DXGI format {}", dxgi));
+        }
+        offset += DDS_DX10_HEADER_SIZE;
+    } else if (pf_flags & DDPF_FOURCC) {
+        format = dds_fourcc_format(fourcc);
+        if (format == VK_FORMAT_UNDEFINED) {
+            return std::unexpected(std::format("unsupported FourCC 0x{:08x}", fourcc));
+        }
+        format = srgb ? to_srgb(format) : format;
+    } else if ((pf_flags & DDPF_RGB) && read_u32(header, 84) == 32) {
+        const uint32_t r_mask = read_u32(header, 88);
+        const uint32_t b_mask = read_u32(header, 96);
+        if (r_mask == 0x000000FF && b_mask == 0x00FF0000) {
+            format = VK_FORMAT_R8G8B8A8_UNORM;
+        } else if (r_mask == 0x00FF0000 && b_mask == 0x000000FF) {
+            format = VK_FORMAT_B8G8R8A8_UNORM;
+        } else {
+            return std::unexpected("unsupported 32-bit RGB channel layout");
+        }
+        format = srgb ? to_srgb(format) : format;
+    } else {
+        return std::unexpected("unsupported pixel format");
+    }
+
+    TextureData texture{};
+    texture.format = format;
+    texture.width = width;
+    texture.height = height;
+
+    if (auto result = read_packed_levels(data, offset, texture, mip_count); !result) {
+        return std::unexpected(result.error());
+    }
+    return texture;
+}
+
+auto parse_ktx2(
+    std::span<const uint8_t> data,
+    batleth::TextureType type,
+    const BlockFormatSupport& support
+) -> std::expected<TextureData, std::string> {
+    if (data.size() < KTX2_HEADER_SIZE ||
+        !std::equal(KTX2_IDENTIFIER.begin(), KTX2_IDENTIFIER.end(), data.begin())) {
+        return std::unexpected("not a KTX2 file");
+    }
+
+    const auto vk_format = static_cast<VkFormat>(read_u32(data, 12));
+    const uint32_t width = read_u32(data, 20);
+    const uint32_t height = read_u32(data, 24);
+    const uint32_t depth = read_u32(data, 28);
+    const uint32_t layers = std::max(read_u32(data, 32), 1u);
+    const uint32_t faces = read_u32(data, 36);
+    const uint32_t level_count = std::max(read_u32(data, 40), 1u);
+    const uint32_t supercompression = read_u32(data, 44);
+
+    if (auto valid = validate_extent(width, height, level_count); !valid) {
+        return std::unexpected(valid.error());
+    }
+    if (depth > 1 || faces != 1) {
+        return std::unexpected("cube maps and volume textures are not supported");
+    }
+    if (layers > MAX_ARRAY_LAYERS) {
+        return std::unexpected(std::format("{} array layers exceeds the limit of {}", layers, MAX_ARRAY_LAYERS));
+    }
+
+    // Basis Universal payloads are stored with an undefined vkFormat and need transcoding
+    if (vk_format == VK_FORMAT_UNDEFINED) {
+        return transcode_basis_ktx2(data, type, support);
+    }
+
+    if (get_format_block_size(vk_format) == 0) {
+        return std::unexpected(std::format("unsupported vkFormat {}", static_cast<uint32_t>(vk_format)));
+    }
+    if (supercompression != KTX2_SUPERCOMPRESSION_NONE && supercompression != KTX2_SUPERCOMPRESSION_ZSTD) {
+        return std::unexpected(std::format("unsupported supercompression scheme {}", supercompression));
+    }
+    if (data.size() < KTX2_HEADER_SIZE + static_cast<size_t>(level_count) * KTX2_LEVEL_INDEX_ENTRY_SIZE) {
+        return std::unexpected("truncated level index");
+    }
+
+    TextureData texture{};
+    texture.format = vk_format;
+    texture.width = width;
+    texture.height = height;
+
+    std::vector<uint8_t> decompressed;
+    for (uint32_t mip = 0; mip < level_count; ++mip) {
+        const size_t entry = KTX2_HEADER_SIZE + static_cast<size_t>(mip) * KTX2_LEVEL_INDEX_ENTRY_SIZE;
+        const uint64_t byte_offset = read_u64(data, entry);
+        const uint64_t byte_length = read_u64(data, entry + 8);
+        const uint64_t uncompressed_length = read_u64(data, entry + 16);
+
+        if (byte_offset > data.size() || byte_length > data.size() - byte_offset) {
+            return std::unexpected(std::format("truncated at mip {}", mip));
+        }
+
+        // A level holds every layer back to back; layer 0 comes first
+        const uint32_t mip_width = mip_extent(width, mip);
+        const uint32_t mip_height = mip_extent(height, mip);
+        const uint64_t size = get_level_size(vk_format, mip_width, mip_height);
+
+        auto level_data = data.subspan(byte_offset, byte_length);
+        if (supercompression == KTX2_SUPERCOMPRESSION_ZSTD) {
+            if (uncompressed_length > size * layers) {
+                return std::unexpected(std::format("mip {} claims {} uncompressed bytes, expected at most {}",
+                                                   mip, uncompressed_length, size * layers));
+            }
+            decompressed.resize(uncompressed_length);
+            const size_t written = ZSTD_decompress(decompressed.data(), decompressed.size(),
+                                                   level_data.data(), level_data.size());
+            if (ZSTD_isError(written)) {
+                return std::unexpected(std::format("zstd error at mip {}: {}", mip, ZSTD_getErrorName(written)));
+            }
+            level_data = std::span<const uint8_t>(decompressed.data(), written);
+        }
+
+        if (level_data.size() < size) {
+            return std::unexpected(std::format("mip {} is {} bytes, expected {}", mip, level_data.size(), size));
+        }
+
+        texture.levels.push_back({
+            .width = mip_width,
+            .height = mip_height,
+            .data = std::vector<uint8_t>(level_data.begin(), level_data.begin() + size)
+        });
+    }
+
+    return texture;
+}
+
+} // namespace klingon
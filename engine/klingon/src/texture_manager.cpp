@@ -1,23 +1,32 @@
 #include "klingon/texture_manager.hpp"
 #include "batleth/image_utils.hpp"
 #include "federation/log.hpp"
+#include "federation/storage/virtual_file_system.hpp"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 
+#include <algorithm>
 #include <filesystem>
+#include <format>
 #include <stdexcept>
 
 namespace klingon {
 
+namespace {
+    constexpr uint32_t DEFAULT_TEXTURE_COUNT = 4;  // Albedo, normal, pbr, opacity; never released
+} // anonymous namespace
+
 TextureManager::TextureManager(const Config& config)
     : m_device(config.device)
     , m_allocator(config.allocator)
     , m_max_materials(config.max_materials)
-    , m_max_textures(config.max_textures) {
+    , m_max_textures(config.max_textures)
+    , m_frames_in_flight(std::max(config.frames_in_flight, 1u))
+    , m_streaming(config.streaming) {
 
-    FED_INFO("Initializing TextureManager (max_textures: {}, max_materials: {})",
-             m_max_textures, m_max_materials);
+    FED_INFO("Initializing TextureManager (max_textures: {}, max_materials: {}, streaming: {})",
+             m_max_textures, m_max_materials, m_streaming.enabled);
 
     // Create default sampler
     batleth::Sampler::Config sampler_config{};
@@ -35,15 +44,10 @@ TextureManager::TextureManager(const Config& config)
     m_default_sampler = std::make_unique<batleth::Sampler>(sampler_config);
 
     // Reserve space for textures
-    m_albedo_textures.reserve(m_max_textures);
-    m_normal_textures.reserve(m_max_textures);
-    m_pbr_textures.reserve(m_max_textures);
-    m_opacity_textures.reserve(m_max_textures);
-
-    // Reserve space for materials
-    m_material_data.reserve(m_max_materials);
+    m_slots.reserve(m_max_textures);
+    m_dirty_slots.resize(m_frames_in_flight);
 
-    // Create default textures (indices 0, 1, 2)
+    // Create default textures (indices 0, 1, 2, 3)
     create_default_textures();
 
     // Create material buffer
@@ -55,9 +59,30 @@ TextureManager::TextureManager(const Config& config)
     create_descriptor_set();
     update_descriptors();
 
+    m_block_support = query_block_format_support();
+    FED_INFO("BC texture support: BC1 {}, BC3 {}, BC5 {}, BC7 {}",
+             m_block_support.bc1, m_block_support.bc3, m_block_support.bc5, m_block_support.bc7);
+
+    // Decode workers serve async loads and streaming refinements
+    uint32_t decode_threads = config.decode_threads;
+    if (decode_threads == 0) {
+        decode_threads = std::clamp(std::thread::hardware_concurrency(), 2u, 5u) - 1;
+    }
+    for (uint32_t i = 0; i < decode_threads; ++i) {
+        m_decode_threads.emplace_back([this](std::stop_token stop) { decode_worker(stop); });
+    }
+
     FED_INFO("TextureManager initialized successfully");
 }
 
+TextureManager::~TextureManager() {
+    for (uint32_t pending = m_pending_reads.load(); pending != 0; pending = m_pending_reads.load()) {
+        m_pending_reads.wait(pending);
+    }
+    // The last completion may still hold the lock while notifying
+    std::scoped_lock lock(m_decode_mutex);
+}
+
 auto TextureManager::create_default_textures() -> void {
     FED_TRACE("Creating default textures");
 
@@ -128,42 +153,38 @@ auto TextureManager::create_default_textures() -> void {
         return std::make_unique<batleth::Texture>(std::move(image), type, name);
     };
 
+    // Slots 0-3 in get_default_*_index() order
     // Create default albedo (white)
-    m_albedo_textures.push_back(create_1x1_texture(255, 255, 255, 255,
-                                                   batleth::TextureType::Albedo,
-                                                   "default_albedo"));
+    add_texture(create_1x1_texture(255, 255, 255, 255,
+                                   batleth::TextureType::Albedo,
+                                   "default_albedo"), batleth::TextureType::Albedo);
 
     // Create default normal (flat normal: 128, 128, 255 = (0, 0, 1) in tangent space)
-    m_normal_textures.push_back(create_1x1_texture(128, 128, 255, 255,
-                                                   batleth::TextureType::Normal,
-                                                   "default_normal"));
+    add_texture(create_1x1_texture(128, 128, 255, 255,
+                                   batleth::TextureType::Normal,
+                                   "default_normal"), batleth::TextureType::Normal);
 
     // Create default PBR (metallic=1.0, roughness=0.5: 255, 128, 0, 255)
-    m_pbr_textures.push_back(create_1x1_texture(255, 128, 0, 255,
-                                                batleth::TextureType::MetallicRoughness,
-                                                "default_pbr"));
+    add_texture(create_1x1_texture(255, 128, 0, 255,
+                                   batleth::TextureType::MetallicRoughness,
+                                   "default_pbr"), batleth::TextureType::MetallicRoughness);
 
     // Create default opacity (fully opaque: 255, 255, 255, 255)
-    m_opacity_textures.push_back(create_1x1_texture(255, 255, 255, 255,
-                                                    batleth::TextureType::Opacity,
-                                                    "default_opacity"));
+    add_texture(create_1x1_texture(255, 255, 255, 255,
+                                   batleth::TextureType::Opacity,
+                                   "default_opacity"), batleth::TextureType::Opacity);
 
     FED_TRACE("Created 4 default textures");
 }
 
 auto TextureManager::create_material_buffer() -> void {
-    FED_TRACE("Creating material buffer ({} materials, {} bytes)",
-             m_max_materials, m_max_materials * sizeof(MaterialGPU));
-
-    m_material_buffer = std::make_unique<batleth::Buffer>(
-        m_device,
-        sizeof(MaterialGPU),
-        m_max_materials,
-        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
-    );
+    m_materials = std::make_unique<MaterialBuffer>(MaterialBuffer::Config{
+        .device = m_device,
+        .max_materials = m_max_materials,
+        .frames_in_flight = m_frames_in_flight
+    });
 
-    // Create and upload default material at index 0
+    // Default material at index 0 (uploaded with the first frame's flush)
     MaterialGPU default_material{};
     default_material.base_color_factor = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
     default_material.metallic_factor = 0.0f;
@@ -174,32 +195,7 @@ auto TextureManager::create_material_buffer() -> void {
     default_material.pbr_texture_index = 2;     // Default PBR
     default_material.material_flags = 0;        // No textures (use factors only)
 
-    m_material_data.push_back(default_material);
-    m_material_count = 1;
-
-    // Upload default material to GPU
-    batleth::Buffer staging_buffer(
-        m_device,
-        sizeof(MaterialGPU),
-        1,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
-    );
-
-    staging_buffer.map();
-    staging_buffer.write_to_buffer(&default_material);
-    staging_buffer.unmap();
-
-    VkCommandBuffer cmd = m_device.begin_single_time_commands();
-
-    VkBufferCopy copy_region{};
-    copy_region.srcOffset = 0;
-    copy_region.dstOffset = 0;
-    copy_region.size = sizeof(MaterialGPU);
-
-    ::vkCmdCopyBuffer(cmd, staging_buffer.get_buffer(), m_material_buffer->get_buffer(), 1, &copy_region);
-
-    m_device.end_single_time_commands(cmd);
+    m_materials->acquire(default_material);
 
     FED_TRACE("Material buffer created with default material at index 0");
 }
@@ -209,24 +205,16 @@ auto TextureManager::create_descriptor_set_layout() -> void {
 
     batleth::DescriptorSetLayout::Builder layout_builder(m_device.get_logical_device());
 
-    // Binding 0: Albedo textures (unbounded array)
+    // Binding 0: All textures (bindless array). Free slots are never written (partially bound),
+    // and slots no pending frame samples can be written while that frame is in flight
     layout_builder.add_binding(0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                               VK_SHADER_STAGE_FRAGMENT_BIT, m_max_textures);
-
-    // Binding 1: Normal textures (unbounded array)
-    layout_builder.add_binding(1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                               VK_SHADER_STAGE_FRAGMENT_BIT, m_max_textures);
-
-    // Binding 2: PBR textures (unbounded array)
-    layout_builder.add_binding(2, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                               VK_SHADER_STAGE_FRAGMENT_BIT, m_max_textures);
+                               VK_SHADER_STAGE_FRAGMENT_BIT, m_max_textures,
+                               VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT |
+                               VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+                               VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT);
 
-    // Binding 3: Opacity textures (unbounded array)
-    layout_builder.add_binding(3, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                               VK_SHADER_STAGE_FRAGMENT_BIT, m_max_textures);
-
-    // Binding 4: Material buffer (SSBO)
-    layout_builder.add_binding(4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+    // Binding 1: Material buffer (SSBO)
+    layout_builder.add_binding(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
                                VK_SHADER_STAGE_FRAGMENT_BIT, 1);
 
     m_descriptor_layout = layout_builder.build();
@@ -239,9 +227,11 @@ auto TextureManager::create_descriptor_pool() -> void {
 
     batleth::DescriptorPool::Builder pool_builder(m_device.get_logical_device());
 
-    pool_builder.set_max_sets(1);
-    pool_builder.add_pool_size(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, m_max_textures * 4);  // 4 texture arrays: albedo, normal, pbr, opacity
-    pool_builder.add_pool_size(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1);
+    // One bindless set per frame in flight, so streaming can patch a slot without touching in-flight sets
+    pool_builder.set_max_sets(m_frames_in_flight);
+    pool_builder.set_pool_flags(VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT);
+    pool_builder.add_pool_size(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, m_max_textures * m_frames_in_flight);
+    pool_builder.add_pool_size(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, m_frames_in_flight);
 
     m_descriptor_pool = pool_builder.build();
 
@@ -249,14 +239,41 @@ auto TextureManager::create_descriptor_pool() -> void {
 }
 
 auto TextureManager::create_descriptor_set() -> void {
-    FED_TRACE("Allocating descriptor set");
+    FED_TRACE("Allocating {} descriptor sets", m_frames_in_flight);
+
+    m_descriptor_sets.resize(m_frames_in_flight, VK_NULL_HANDLE);
+    for (auto& set : m_descriptor_sets) {
+        if (!m_descriptor_pool->allocate_descriptor_set(m_descriptor_layout->get_layout(), set)) {
+            FED_FATAL("Failed to allocate descriptor set");
+            throw std::runtime_error("Failed to allocate descriptor set");
+        }
+    }
+
+    // The material buffer never moves, so it's written once here; texture slots go through update_descriptors()
+    VkDescriptorBufferInfo buffer_info{};
+    buffer_info.buffer = m_materials->get_buffer();
+    buffer_info.offset = 0;
+    buffer_info.range = VK_WHOLE_SIZE;
 
-    if (!m_descriptor_pool->allocate_descriptor_set(m_descriptor_layout->get_layout(), m_descriptor_set)) {
-        FED_FATAL("Failed to allocate descriptor set");
-        throw std::runtime_error("Failed to allocate descriptor set");
+    std::vector<VkWriteDescriptorSet> writes;
+    for (VkDescriptorSet set : m_descriptor_sets) {
+        VkWriteDescriptorSet buffer_write{};
+        buffer_write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        buffer_write.dstSet = set;
+        buffer_write.dstBinding = 1;
+        buffer_write.dstArrayElement = 0;
+        buffer_write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        buffer_write.descriptorCount = 1;
+        buffer_write.pBufferInfo = &buffer_info;
+        writes.push_back(buffer_write);
     }
 
-    FED_TRACE("Descriptor set allocated");
+    ::vkUpdateDescriptorSets(m_device.get_logical_device(),
+                            static_cast<uint32_t>(writes.size()),
+                            writes.data(),
+                            0, nullptr);
+
+    FED_TRACE("Descriptor sets allocated");
 }
 
 auto TextureManager::get_descriptor_layout() const -> VkDescriptorSetLayout {
@@ -264,126 +281,69 @@ auto TextureManager::get_descriptor_layout() const -> VkDescriptorSetLayout {
 }
 
 auto TextureManager::update_descriptors() -> void {
-    if (!m_descriptors_dirty) {
+    if (m_new_slots.empty()) {
         return;
     }
 
-    FED_TRACE("Updating bindless descriptors");
+    FED_TRACE("Writing {} new bindless slots", m_new_slots.size());
 
-    std::vector<VkDescriptorImageInfo> albedo_infos;
-    std::vector<VkDescriptorImageInfo> normal_infos;
-    std::vector<VkDescriptorImageInfo> pbr_infos;
+    // Nothing in flight can reference a slot that was just allocated, so every frame's set takes it now
+    write_descriptors(m_descriptor_sets, m_new_slots);
+}
 
-    // Build image info arrays
-    for (const auto& tex : m_albedo_textures) {
-        VkDescriptorImageInfo info{};
-        info.sampler = m_default_sampler->get_handle();
-        info.imageView = tex->get_image().get_view();
-        info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        albedo_infos.push_back(info);
-    }
+auto TextureManager::load_texture(
+    const std::string& filepath,
+    batleth::TextureType type,
+    bool generate_mipmaps
+) -> uint32_t {
 
-    for (const auto& tex : m_normal_textures) {
-        VkDescriptorImageInfo info{};
-        info.sampler = m_default_sampler->get_handle();
-        info.imageView = tex->get_image().get_view();
-        info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        normal_infos.push_back(info);
-    }
+    std::filesystem::path path(m_textures_dir + "/" + filepath);
 
-    for (const auto& tex : m_pbr_textures) {
-        VkDescriptorImageInfo info{};
-        info.sampler = m_default_sampler->get_handle();
-        info.imageView = tex->get_image().get_view();
-        info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        pbr_infos.push_back(info);
+    // Check cache first
+    auto* cache = get_cache(type);
+    if (!cache) {
+        FED_ERROR("Unknown texture type");
+        return get_default_index(type);
     }
 
-    std::vector<VkDescriptorImageInfo> opacity_infos;
-    for (const auto& tex : m_opacity_textures) {
-        VkDescriptorImageInfo info{};
-        info.sampler = m_default_sampler->get_handle();
-        info.imageView = tex->get_image().get_view();
-        info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        opacity_infos.push_back(info);
+    auto it = cache->find(filepath);
+    if (it != cache->end()) {
+        FED_TRACE("Texture already loaded: {}", filepath);
+        if (it->second >= DEFAULT_TEXTURE_COUNT) {
+            ++m_slots[it->second].ref_count;
+        }
+        return it->second;
     }
 
-    // Material buffer info
-    VkDescriptorBufferInfo buffer_info{};
-    buffer_info.buffer = m_material_buffer->get_buffer();
-    buffer_info.offset = 0;
-    buffer_info.range = VK_WHOLE_SIZE;
+    // A fresh cook (block-compressed KTX2 with its mip chain) stands in for the source image
+    if (auto cooked = federation::VirtualFileSystem::get().get_cooked_path(path.generic_string())) {
+        path = *cooked;
+    }
 
-    // Write descriptor updates
-    std::vector<VkWriteDescriptorSet> writes;
+    // Detect format by extension
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
 
-    // Albedo textures
-    VkWriteDescriptorSet albedo_write{};
-    albedo_write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-    albedo_write.dstSet = m_descriptor_set;
-    albedo_write.dstBinding = 0;
-    albedo_write.dstArrayElement = 0;
-    albedo_write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    albedo_write.descriptorCount = static_cast<uint32_t>(albedo_infos.size());
-    albedo_write.pImageInfo = albedo_infos.data();
-    writes.push_back(albedo_write);
-
-    // Normal textures
-    VkWriteDescriptorSet normal_write{};
-    normal_write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-    normal_write.dstSet = m_descriptor_set;
-    normal_write.dstBinding = 1;
-    normal_write.dstArrayElement = 0;
-    normal_write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    normal_write.descriptorCount = static_cast<uint32_t>(normal_infos.size());
-    normal_write.pImageInfo = normal_infos.data();
-    writes.push_back(normal_write);
-
-    // PBR textures
-    VkWriteDescriptorSet pbr_write{};
-    pbr_write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-    pbr_write.dstSet = m_descriptor_set;
-    pbr_write.dstBinding = 2;
-    pbr_write.dstArrayElement = 0;
-    pbr_write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    pbr_write.descriptorCount = static_cast<uint32_t>(pbr_infos.size());
-    pbr_write.pImageInfo = pbr_infos.data();
-    writes.push_back(pbr_write);
-
-    // Opacity textures
-    VkWriteDescriptorSet opacity_write{};
-    opacity_write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-    opacity_write.dstSet = m_descriptor_set;
-    opacity_write.dstBinding = 3;
-    opacity_write.dstArrayElement = 0;
-    opacity_write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    opacity_write.descriptorCount = static_cast<uint32_t>(opacity_infos.size());
-    opacity_write.pImageInfo = opacity_infos.data();
-    writes.push_back(opacity_write);
-
-    // Material buffer
-    VkWriteDescriptorSet buffer_write{};
-    buffer_write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-    buffer_write.dstSet = m_descriptor_set;
-    buffer_write.dstBinding = 4;
-    buffer_write.dstArrayElement = 0;
-    buffer_write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-    buffer_write.descriptorCount = 1;
-    buffer_write.pBufferInfo = &buffer_info;
-    writes.push_back(buffer_write);
+    uint32_t index = 0;
 
-    ::vkUpdateDescriptorSets(m_device.get_logical_device(),
-                            static_cast<uint32_t>(writes.size()),
-                            writes.data(),
-                            0, nullptr);
+    if (ext == ".ktx2" || ext == ".ktx" || ext == ".dds") {
+        index = load_compressed_image(path.generic_string(), type);
+    } else if (m_streaming.enabled && generate_mipmaps) {
+        index = load_streamed_image(path.generic_string(), type);
+    } else {
+        index = load_stb_image(path.generic_string(), type, generate_mipmaps);
+    }
 
-    m_descriptors_dirty = false;
+    // Cache the result
+    (*cache)[filepath] = index;
+    if (index >= DEFAULT_TEXTURE_COUNT) {
+        m_slots[index].cache_key = filepath;
+    }
 
-    FED_TRACE("Descriptors updated ({} albedo, {} normal, {} pbr, {} opacity textures, {} materials)",
-             albedo_infos.size(), normal_infos.size(), pbr_infos.size(), opacity_infos.size(), m_material_count);
+    return index;
 }
 
-auto TextureManager::load_texture(
+auto TextureManager::load_texture_async(
     const std::string& filepath,
     batleth::TextureType type,
     bool generate_mipmaps
@@ -391,50 +351,63 @@ auto TextureManager::load_texture(
 
     std::filesystem::path path(m_textures_dir + "/" + filepath);
 
-    // Check cache first
-    std::unordered_map<std::string, uint32_t>* cache = nullptr;
-    switch (type) {
-        case batleth::TextureType::Albedo:
-            cache = &m_albedo_cache;
-            break;
-        case batleth::TextureType::Normal:
-            cache = &m_normal_cache;
-            break;
-        case batleth::TextureType::MetallicRoughness:
-            cache = &m_pbr_cache;
-            break;
-        case batleth::TextureType::Opacity:
-            cache = &m_opacity_cache;
-            break;
-        default:
-            FED_ERROR("Unknown texture type");
-            return 0;  // Return default
+    auto* cache = get_cache(type);
+    if (!cache) {
+        FED_ERROR("Unknown texture type");
+        return get_default_index(type);
     }
 
     auto it = cache->find(filepath);
     if (it != cache->end()) {
         FED_TRACE("Texture already loaded: {}", filepath);
+        if (it->second >= DEFAULT_TEXTURE_COUNT) {
+            ++m_slots[it->second].ref_count;
+        }
         return it->second;
     }
 
-    // Detect format by extension
-    std::string ext = path.extension().string();
-    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
-
-    uint32_t index = 0;
+    // A fresh cook (block-compressed KTX2 with its mip chain) stands in for the source image
+    if (auto cooked = federation::VirtualFileSystem::get().get_cooked_path(path.generic_string())) {
+        path = *cooked;
+    }
 
-    if (ext == ".ktx2" || ext == ".ktx") {
-        index = load_ktx2(path.generic_string(), type);
-    } else if (ext == ".dds") {
-        index = load_dds(path.generic_string(), type);
-    } else {
-        index = load_stb_image(path.generic_string(), type, generate_mipmaps);
+    // Reserve the slot now; an empty entry is bound to the type's default texture
+    auto slot = add_texture(nullptr, type);
+    if (!slot) {
+        return get_default_index(type);
     }
+    const uint32_t index = *slot;
+    (*cache)[filepath] = index;
+    m_slots[index].cache_key = filepath;
+
+    queue_decode({
+        .type = type,
+        .index = index,
+        .generation = m_slots[index].generation,
+        .filepath = path.generic_string(),
+        .first_mip = 0,
+        .initial = true,
+        .generate_mipmaps = generate_mipmaps,
+        .file = std::nullopt
+    });
+    ++m_pending_loads;
+
+    FED_TRACE("Queued async texture load: {} (index {})", filepath, index);
+    return index;
+}
 
-    // Cache the result
-    (*cache)[path.generic_string()] = index;
+auto TextureManager::decode_rgba8(const std::string& filepath, int& width, int& height) -> uint8_t* {
+    auto file = federation::VirtualFileSystem::get().read(filepath);
+    if (!file) {
+        return nullptr;
+    }
+    return decode_rgba8(file->get_data(), width, height);
+}
 
-    return index;
+auto TextureManager::decode_rgba8(std::span<const std::byte> data, int& width, int& height) -> uint8_t* {
+    int channels = 0;
+    return stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(data.data()), static_cast<int>(data.size()),
+                                 &width, &height, &channels, STBI_rgb_alpha);
 }
 
 auto TextureManager::load_stb_image(const std::string& filepath,
@@ -443,18 +416,17 @@ auto TextureManager::load_stb_image(const std::string& filepath,
     FED_INFO("Loading texture via stb_image: {}", filepath);
 
     // Load image data
-    int width, height, channels;
-    stbi_uc* pixels = stbi_load(filepath.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+    int width, height;
+    stbi_uc* pixels = decode_rgba8(filepath, width, height);
 
     if (!pixels) {
         FED_ERROR("Failed to load texture: {}", filepath);
-        return 0;  // Return default texture index
+        return get_default_index(type);
     }
 
     uint32_t mip_levels = gen_mips ? batleth::calculate_mip_levels(width, height) : 1;
 
-    FED_TRACE("Loaded {}x{} texture with {} channels, generating {} mip levels",
-             width, height, channels, mip_levels);
+    FED_TRACE("Loaded {}x{} texture, generating {} mip levels", width, height, mip_levels);
 
     // Create image
     batleth::Image::Config img_config{};
@@ -512,8 +484,7 @@ auto TextureManager::load_stb_image(const std::string& filepath,
 
     // Generate mipmaps if requested
     if (gen_mips && mip_levels > 1) {
-        batleth::generate_mipmaps(m_device, cmd, image->get_image(), img_config.format,
-                                 width, height, mip_levels);
+        batleth::generate_mipmaps(m_device, cmd, *image);
     } else {
         // Just transition to SHADER_READ_ONLY
         image->transition_layout(cmd, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
@@ -522,161 +493,279 @@ auto TextureManager::load_stb_image(const std::string& filepath,
 
     m_device.end_single_time_commands(cmd);
 
-    // Create texture and add to appropriate array
-    auto texture = std::make_unique<batleth::Texture>(std::move(image), type, filepath);
+    // Create texture and give it a bindless slot
+    auto index = add_texture(std::make_unique<batleth::Texture>(std::move(image), type, filepath), type);
+    if (!index) {
+        return get_default_index(type);
+    }
 
-    uint32_t index = 0;
+    FED_INFO("Loaded texture: {} (index {})", filepath, *index);
+    return *index;
+}
+
+auto TextureManager::get_cache(batleth::TextureType type) -> std::unordered_map<std::string, uint32_t>* {
     switch (type) {
         case batleth::TextureType::Albedo:
-            index = static_cast<uint32_t>(m_albedo_textures.size());
-            m_albedo_textures.push_back(std::move(texture));
-            break;
+            return &m_albedo_cache;
         case batleth::TextureType::Normal:
-            index = static_cast<uint32_t>(m_normal_textures.size());
-            m_normal_textures.push_back(std::move(texture));
-            break;
+            return &m_normal_cache;
         case batleth::TextureType::MetallicRoughness:
-            index = static_cast<uint32_t>(m_pbr_textures.size());
-            m_pbr_textures.push_back(std::move(texture));
-            break;
+            return &m_pbr_cache;
         case batleth::TextureType::Opacity:
-            index = static_cast<uint32_t>(m_opacity_textures.size());
-            m_opacity_textures.push_back(std::move(texture));
-            break;
+            return &m_opacity_cache;
         default:
-            FED_ERROR("Unknown texture type");
-            return 0;
+            return nullptr;
+    }
+}
+
+auto TextureManager::add_texture(std::unique_ptr<batleth::Texture> texture, batleth::TextureType type)
+    -> std::optional<uint32_t> {
+    auto index = allocate_slot();
+    if (!index) {
+        FED_ERROR("Bindless texture array full (max: {})", m_max_textures);
+        return std::nullopt;
     }
 
-    m_descriptors_dirty = true;
+    auto& slot = m_slots[*index];
+    slot.texture = std::move(texture);
+    slot.type = type;
+    slot.cache_key.clear();
+    slot.ref_count = 1;
+    ++m_texture_count;
 
-    FED_INFO("Loaded texture: {} (index {})", filepath, index);
+    m_new_slots.push_back(*index);
     return index;
 }
 
-auto TextureManager::load_ktx2(const std::string& filepath, batleth::TextureType type) -> uint32_t {
-    FED_WARN("KTX2 loading not yet implemented: {}", filepath);
-    return 0;  // Return default texture for now
+auto TextureManager::allocate_slot() -> std::optional<uint32_t> {
+    if (!m_free_slots.empty()) {
+        const uint32_t index = m_free_slots.back();
+        m_free_slots.pop_back();
+        return index;
+    }
+    if (m_slots.size() >= m_max_textures) {
+        return std::nullopt;
+    }
+    m_slots.emplace_back();
+    return static_cast<uint32_t>(m_slots.size() - 1);
 }
 
-auto TextureManager::load_dds(const std::string& filepath, batleth::TextureType type) -> uint32_t {
-    FED_WARN("DDS loading not yet implemented: {}", filepath);
-    return 0;  // Return default texture for now
+auto TextureManager::release_texture(uint32_t index) -> void {
+    if (index < DEFAULT_TEXTURE_COUNT) {
+        return;
+    }
+    if (index >= m_slots.size() || m_slots[index].ref_count == 0) {
+        FED_WARN("Releasing texture {} that isn't loaded", index);
+        return;
+    }
+
+    auto& slot = m_slots[index];
+    if (--slot.ref_count > 0) {
+        return;
+    }
+
+    if (auto* cache = get_cache(slot.type)) {
+        auto it = cache->find(slot.cache_key);
+        if (it != cache->end() && it->second == index) {
+            cache->erase(it);
+        }
+    }
+
+    // Decodes still queued for this slot are dropped when they come back
+    ++slot.generation;
+    unregister_streamed(index);
+    --m_texture_count;
+
+    // The texture stays alive until every frame that may have sampled it has retired
+    m_retired_slots.push_back({.frame = m_stream_frame, .index = index});
+
+    FED_TRACE("Released texture {}", index);
 }
 
-auto TextureManager::upload_material(MaterialGPU& material) -> uint32_t {
-    if (m_material_count >= m_max_materials) {
-        FED_ERROR("Material buffer full (max: {})", m_max_materials);
-        return 0;
+auto TextureManager::recycle_retired_slots() -> void {
+    while (!m_retired_slots.empty() && m_retired_slots.front().frame + m_frames_in_flight <= m_stream_frame) {
+        auto& slot = m_slots[m_retired_slots.front().index];
+        slot.texture.reset();
+        slot.type = batleth::TextureType::Unknown;
+        slot.cache_key.clear();
+
+        m_free_slots.push_back(m_retired_slots.front().index);
+        m_retired_slots.pop_front();
     }
+}
 
-    uint32_t index = m_material_count++;
-    m_material_data.push_back(material);
+auto TextureManager::is_current(uint32_t index, uint32_t generation) const -> bool {
+    return index < m_slots.size() && m_slots[index].generation == generation;
+}
 
-    // Upload to GPU via staging buffer
-    batleth::Buffer staging_buffer(
-        m_device,
-        sizeof(MaterialGPU),
-        1,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
-    );
+auto TextureManager::get_default_index(batleth::TextureType type) const -> uint32_t {
+    switch (type) {
+        case batleth::TextureType::Normal:
+            return get_default_normal_index();
+        case batleth::TextureType::MetallicRoughness:
+            return get_default_pbr_index();
+        case batleth::TextureType::Opacity:
+            return get_default_opacity_index();
+        default:
+            return get_default_albedo_index();
+    }
+}
 
-    staging_buffer.map();
-    staging_buffer.write_to_buffer(&material);
-    staging_buffer.unmap();
+auto TextureManager::get_texture_count() const -> uint32_t {
+    return m_texture_count;
+}
 
-    VkCommandBuffer cmd = m_device.begin_single_time_commands();
+auto TextureManager::load_compressed_image(const std::string& filepath, batleth::TextureType type) -> uint32_t {
+    FED_INFO("Loading pre-compressed texture: {}", filepath);
 
-    VkBufferCopy copy_region{};
-    copy_region.srcOffset = 0;
-    copy_region.dstOffset = index * sizeof(MaterialGPU);
-    copy_region.size = sizeof(MaterialGPU);
+    auto texture_data = read_compressed_image(filepath, type);
+    if (!texture_data) {
+        FED_ERROR("Failed to load texture {}: {}", filepath, texture_data.error());
+        return get_default_index(type);
+    }
 
-    ::vkCmdCopyBuffer(cmd, staging_buffer.get_buffer(), m_material_buffer->get_buffer(), 1, &copy_region);
+    const auto mip_levels = static_cast<uint32_t>(texture_data->levels.size());
+    auto image = create_texture_image(texture_data->width, texture_data->height, mip_levels, 0, texture_data->format);
 
+    VkCommandBuffer cmd = m_device.begin_single_time_commands();
+    auto staging = record_uploads(cmd, {{.image = image.get(), .mips = &texture_data->levels}});
     m_device.end_single_time_commands(cmd);
 
-    FED_TRACE("Uploaded material to index {}", index);
-    return index;
+    auto index = add_texture(std::make_unique<batleth::Texture>(std::move(image), type, filepath), type);
+    if (!index) {
+        return get_default_index(type);
+    }
+
+    FED_INFO("Loaded texture: {} (index {}, {}x{}, {} mips, format {})", filepath, *index,
+             texture_data->width, texture_data->height, mip_levels, static_cast<uint32_t>(texture_data->format));
+    return *index;
 }
 
-auto TextureManager::update_material(uint32_t index, MaterialGPU& material) -> void {
-    if (index >= m_material_count) {
-        FED_ERROR("Invalid material index: {}", index);
-        return;
+auto TextureManager::read_compressed_image(const std::string& filepath, batleth::TextureType type) const
+    -> std::expected<TextureData, std::string> {
+    auto file = federation::VirtualFileSystem::get().read(filepath);
+    if (!file) {
+        return std::unexpected(file.error());
     }
 
-    m_material_data[index] = material;
+    // Parsed in place: straight out of the page cache for loose files and uncompressed pack entries
+    return parse_compressed_image(filepath, file->get_data(), type);
+}
 
-    // Upload to GPU
-    batleth::Buffer staging_buffer(
-        m_device,
-        sizeof(MaterialGPU),
-        1,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
-    );
+auto TextureManager::parse_compressed_image(const std::string& filepath, std::span<const std::byte> data,
+                                            batleth::TextureType type) const
+    -> std::expected<TextureData, std::string> {
+    const std::span<const uint8_t> bytes(reinterpret_cast<const uint8_t*>(data.data()), data.size());
 
-    staging_buffer.map();
-    staging_buffer.write_to_buffer(&material);
-    staging_buffer.unmap();
+    std::string ext = std::filesystem::path(filepath).extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
 
-    VkCommandBuffer cmd = m_device.begin_single_time_commands();
+    auto texture_data = ext == ".dds"
+                            ? parse_dds(bytes, type == batleth::TextureType::Albedo)
+                            : parse_ktx2(bytes, type, m_block_support);
+    if (!texture_data) {
+        return texture_data;
+    }
 
-    VkBufferCopy copy_region{};
-    copy_region.srcOffset = 0;
-    copy_region.dstOffset = index * sizeof(MaterialGPU);
-    copy_region.size = sizeof(MaterialGPU);
+    const VkFormatFeatureFlags required = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT |
+                                          VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+    if (!m_device.supports_format(texture_data->format, required)) {
+        return std::unexpected(std::format("format {} can't be sampled on this device",
+                                           static_cast<uint32_t>(texture_data->format)));
+    }
+    return texture_data;
+}
 
-    ::vkCmdCopyBuffer(cmd, staging_buffer.get_buffer(), m_material_buffer->get_buffer(), 1, &copy_region);
+auto TextureManager::query_block_format_support() const -> BlockFormatSupport {
+    const VkFormatFeatureFlags required = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT |
+                                          VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
 
-    m_device.end_single_time_commands(cmd);
+    // Transcode targets are only used when both colour spaces are available
+    auto supports = [&](VkFormat unorm, VkFormat srgb) {
+        return m_device.supports_format(unorm, required) && m_device.supports_format(srgb, required);
+    };
 
-    FED_TRACE("Updated material at index {}", index);
+    BlockFormatSupport support{};
+    support.bc1 = supports(VK_FORMAT_BC1_RGB_UNORM_BLOCK, VK_FORMAT_BC1_RGB_SRGB_BLOCK);
+    support.bc3 = supports(VK_FORMAT_BC3_UNORM_BLOCK, VK_FORMAT_BC3_SRGB_BLOCK);
+    support.bc5 = m_device.supports_format(VK_FORMAT_BC5_UNORM_BLOCK, required);
+    support.bc7 = supports(VK_FORMAT_BC7_UNORM_BLOCK, VK_FORMAT_BC7_SRGB_BLOCK);
+    return support;
 }
 
-auto TextureManager::upload_materials(std::vector<MaterialGPU>& materials) -> uint32_t {
-    if (m_material_count + materials.size() > m_max_materials) {
-        FED_ERROR("Not enough space in material buffer ({} + {} > {})",
-                 m_material_count, materials.size(), m_max_materials);
+auto TextureManager::upload_material(const MaterialGPU& material) -> uint32_t {
+    auto index = m_materials->acquire(material);
+    if (!index) {
         return 0;
     }
 
-    uint32_t starting_index = m_material_count;
-    m_material_count += static_cast<uint32_t>(materials.size());
+    FED_TRACE("Uploaded material to index {}", *index);
+    return *index;
+}
+
+auto TextureManager::update_material(uint32_t index, const MaterialGPU& material) -> uint32_t {
+    if (index == 0) {
+        // The default material is shared by everything without one; edits get their own slot
+        return upload_material(material);
+    }
 
-    // Add to CPU-side copy
-    m_material_data.insert(m_material_data.end(), materials.begin(), materials.end());
+    const uint32_t new_index = m_materials->update(index, material);
+    FED_TRACE("Updated material at index {} (now {})", index, new_index);
+    return new_index;
+}
 
-    // Upload to GPU via staging buffer (batch upload)
-    VkDeviceSize upload_size = materials.size() * sizeof(MaterialGPU);
+auto TextureManager::upload_materials(const std::vector<MaterialGPU>& materials) -> std::vector<uint32_t> {
+    std::vector<uint32_t> indices;
+    indices.reserve(materials.size());
+    for (const auto& material : materials) {
+        indices.push_back(upload_material(material));
+    }
 
-    batleth::Buffer staging_buffer(
-        m_device,
-        upload_size,
-        1,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
-    );
+    const auto stats = m_materials->get_stats();
+    FED_INFO("Uploaded {} materials ({} distinct in buffer, {} references)",
+             materials.size(), stats.live_materials, stats.references);
+    return indices;
+}
 
-    staging_buffer.map();
-    staging_buffer.write_to_buffer(materials.data());
-    staging_buffer.unmap();
+auto TextureManager::release_material(uint32_t index) -> void {
+    if (index == 0) {
+        return;  // Default material, also handed out when the buffer was full
+    }
+    m_materials->release(index);
+}
 
-    VkCommandBuffer cmd = m_device.begin_single_time_commands();
+auto TextureManager::queue_release_material(uint32_t index) -> void {
+    std::lock_guard lock(m_release_mutex);
+    m_queued_material_releases.push_back(index);
+}
 
-    VkBufferCopy copy_region{};
-    copy_region.srcOffset = 0;
-    copy_region.dstOffset = starting_index * sizeof(MaterialGPU);
-    copy_region.size = upload_size;
+auto TextureManager::queue_release_texture(uint32_t index) -> void {
+    std::lock_guard lock(m_release_mutex);
+    m_queued_texture_releases.push_back(index);
+}
 
-    ::vkCmdCopyBuffer(cmd, staging_buffer.get_buffer(), m_material_buffer->get_buffer(), 1, &copy_region);
+auto TextureManager::apply_queued_releases() -> void {
+    {
+        std::lock_guard lock(m_release_mutex);
+        std::swap(m_applying_releases, m_queued_material_releases);
+    }
+    for (uint32_t index : m_applying_releases) {
+        release_material(index);
+    }
+    m_applying_releases.clear();
 
-    m_device.end_single_time_commands(cmd);
+    {
+        std::lock_guard lock(m_release_mutex);
+        std::swap(m_applying_releases, m_queued_texture_releases);
+    }
+    for (uint32_t index : m_applying_releases) {
+        release_texture(index);
+    }
+    m_applying_releases.clear();
+}
 
-    FED_INFO("Batch uploaded {} materials starting at index {}", materials.size(), starting_index);
-    return starting_index;
+auto TextureManager::flush_materials(VkCommandBuffer cmd, uint32_t frame_index) -> void {
+    m_materials->flush(cmd, frame_index);
 }
 
 } // namespace klingon
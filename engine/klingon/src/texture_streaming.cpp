@@ -0,0 +1,862 @@
+#include "klingon/texture_manager.hpp"
+#include "batleth/image_utils.hpp"
+#include "federation/log.hpp"
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+
+namespace klingon {
+
+namespace {
+    constexpr uint32_t MAX_PENDING_LOADS = 8;
+    constexpr uint32_t LINEAR_TO_SRGB_STEPS = 4096;
+
+    auto mip_extent(uint32_t size, uint32_t mip) -> uint32_t {
+        return std::max(size >> mip, 1u);
+    }
+
+    /**
+     * Buffer-to-image copies must start on a texel block boundary; 16 covers RGBA8 and every BC format
+     */
+    auto align_copy_offset(VkDeviceSize size) -> VkDeviceSize {
+        constexpr VkDeviceSize alignment = 16;
+        return (size + alignment - 1) & ~(alignment - 1);
+    }
+
+    auto is_compressed_path(const std::string& filepath) -> bool {
+        std::string ext = std::filesystem::path(filepath).extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+        return ext == ".ktx2" || ext == ".ktx" || ext == ".dds";
+    }
+
+    /**
+     * Tightly packed RGBA8 size of mips [first_mip, mip_levels)
+     */
+    auto estimate_bytes(uint32_t width, uint32_t height, uint32_t mip_levels, uint32_t first_mip) -> uint64_t {
+        uint64_t bytes = 0;
+        for (uint32_t mip = first_mip; mip < mip_levels; ++mip) {
+            bytes += static_cast<uint64_t>(mip_extent(width, mip)) * mip_extent(height, mip) * 4;
+        }
+        return bytes;
+    }
+
+    auto srgb_to_linear(uint8_t value) -> float {
+        static const std::array<float, 256> table = [] {
+            std::array<float, 256> result{};
+            for (size_t i = 0; i < result.size(); ++i) {
+                const float c = static_cast<float>(i) / 255.0f;
+                result[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+            }
+            return result;
+        }();
+        return table[value];
+    }
+
+    auto linear_to_srgb(float value) -> uint8_t {
+        static const std::array<uint8_t, LINEAR_TO_SRGB_STEPS> table = [] {
+            std::array<uint8_t, LINEAR_TO_SRGB_STEPS> result{};
+            for (size_t i = 0; i < result.size(); ++i) {
+                const float l = static_cast<float>(i) / static_cast<float>(LINEAR_TO_SRGB_STEPS - 1);
+                const float c = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+                result[i] = static_cast<uint8_t>(std::lround(std::clamp(c, 0.0f, 1.0f) * 255.0f));
+            }
+            return result;
+        }();
+        const float clamped = std::clamp(value, 0.0f, 1.0f);
+        return table[static_cast<size_t>(clamped * static_cast<float>(LINEAR_TO_SRGB_STEPS - 1) + 0.5f)];
+    }
+
+    /**
+     * 2x2 box filter in linear space (alpha is filtered as-is)
+     * Streamed images are sRGB, so this matches what a linear blit would produce on the GPU
+     */
+    auto downsample_rgba8(
+        const std::vector<uint8_t>& src,
+        uint32_t src_width,
+        uint32_t src_height,
+        uint32_t dst_width,
+        uint32_t dst_height
+    ) -> std::vector<uint8_t> {
+        std::vector<uint8_t> dst(static_cast<size_t>(dst_width) * dst_height * 4);
+
+        for (uint32_t y = 0; y < dst_height; ++y) {
+            const uint32_t y0 = std::min(y * 2, src_height - 1);
+            const uint32_t y1 = std::min(y * 2 + 1, src_height - 1);
+
+            for (uint32_t x = 0; x < dst_width; ++x) {
+                const uint32_t x0 = std::min(x * 2, src_width - 1);
+                const uint32_t x1 = std::min(x * 2 + 1, src_width - 1);
+
+                const std::array<const uint8_t*, 4> taps = {
+                    &src[(static_cast<size_t>(y0) * src_width + x0) * 4],
+                    &src[(static_cast<size_t>(y0) * src_width + x1) * 4],
+                    &src[(static_cast<size_t>(y1) * src_width + x0) * 4],
+                    &src[(static_cast<size_t>(y1) * src_width + x1) * 4],
+                };
+
+                uint8_t* out = &dst[(static_cast<size_t>(y) * dst_width + x) * 4];
+                for (uint32_t c = 0; c < 3; ++c) {
+                    float sum = 0.0f;
+                    for (const uint8_t* tap : taps) {
+                        sum += srgb_to_linear(tap[c]);
+                    }
+                    out[c] = linear_to_srgb(sum * 0.25f);
+                }
+
+                uint32_t alpha = 0;
+                for (const uint8_t* tap : taps) {
+                    alpha += tap[3];
+                }
+                out[3] = static_cast<uint8_t>((alpha + 2) / 4);
+            }
+        }
+
+        return dst;
+    }
+} // namespace
+
+auto TextureManager::build_mip_chain(
+    const uint8_t* pixels,
+    uint32_t width,
+    uint32_t height,
+    uint32_t first_mip
+) -> std::vector<TextureLevel> {
+    const uint32_t mip_levels = batleth::calculate_mip_levels(width, height);
+
+    std::vector<TextureLevel> chain;
+    chain.reserve(mip_levels - std::min(first_mip, mip_levels));
+
+    TextureLevel level{
+        .width = width,
+        .height = height,
+        .data = std::vector<uint8_t>(pixels, pixels + static_cast<size_t>(width) * height * 4)
+    };
+
+    for (uint32_t mip = 0; mip < mip_levels; ++mip) {
+        TextureLevel next{};
+        if (mip + 1 < mip_levels) {
+            next.width = mip_extent(width, mip + 1);
+            next.height = mip_extent(height, mip + 1);
+            next.data = downsample_rgba8(level.data, level.width, level.height, next.width, next.height);
+        }
+
+        if (mip >= first_mip) {
+            chain.push_back(std::move(level));
+        }
+        level = std::move(next);
+    }
+
+    return chain;
+}
+
+auto TextureManager::get_tail_mip(uint32_t width, uint32_t height, uint32_t mip_levels) const -> uint32_t {
+    if (!m_streaming.enabled) {
+        return 0;
+    }
+
+    // Tail = first mip that fits within tail_size; everything from there down stays resident
+    uint32_t tail_mip = 0;
+    while (tail_mip + 1 < mip_levels &&
+           std::max(mip_extent(width, tail_mip), mip_extent(height, tail_mip)) > m_streaming.tail_size) {
+        ++tail_mip;
+    }
+    return tail_mip;
+}
+
+auto TextureManager::load_streamed_image(const std::string& filepath, batleth::TextureType type) -> uint32_t {
+    FED_INFO("Loading streamed texture: {}", filepath);
+
+    int width, height;
+    stbi_uc* pixels = decode_rgba8(filepath, width, height);
+
+    if (!pixels) {
+        FED_ERROR("Failed to load texture: {}", filepath);
+        return get_default_index(type);
+    }
+
+    const auto full_width = static_cast<uint32_t>(width);
+    const auto full_height = static_cast<uint32_t>(height);
+    const uint32_t mip_levels = batleth::calculate_mip_levels(full_width, full_height);
+    const uint32_t tail_mip = get_tail_mip(full_width, full_height, mip_levels);
+
+    auto mips = build_mip_chain(pixels, full_width, full_height, tail_mip);
+    stbi_image_free(pixels);
+
+    auto image = create_texture_image(full_width, full_height, mip_levels, tail_mip);
+
+    VkCommandBuffer cmd = m_device.begin_single_time_commands();
+    auto staging = record_uploads(cmd, {{.image = image.get(), .mips = &mips}});
+    m_device.end_single_time_commands(cmd);
+
+    const uint64_t resident_bytes = get_allocation_size(*image);
+
+    auto index = add_texture(std::make_unique<batleth::Texture>(std::move(image), type, filepath), type);
+    if (!index) {
+        return get_default_index(type);
+    }
+
+    register_streamed(type, *index, filepath, full_width, full_height, mip_levels, tail_mip, resident_bytes);
+
+    FED_INFO("Loaded texture: {} (index {}, {}x{}, mips {}+ of {} resident)",
+             filepath, *index, width, height, tail_mip, mip_levels);
+    return *index;
+}
+
+auto TextureManager::register_streamed(
+    batleth::TextureType type,
+    uint32_t index,
+    const std::string& filepath,
+    uint32_t width,
+    uint32_t height,
+    uint32_t mip_levels,
+    uint32_t first_mip,
+    uint64_t resident_bytes
+) -> void {
+    // Small enough to be fully resident already; nothing to stream
+    if (first_mip == 0) {
+        return;
+    }
+
+    StreamedTexture streamed{};
+    streamed.filepath = filepath;
+    streamed.type = type;
+    streamed.index = index;
+    streamed.width = width;
+    streamed.height = height;
+    streamed.mip_levels = mip_levels;
+    streamed.tail_mip = first_mip;
+    streamed.resident_mip = first_mip;
+    streamed.requested_mip = first_mip;
+    streamed.last_requested_frame = m_stream_frame;
+    streamed.resident_bytes = resident_bytes;
+
+    m_resident_bytes += resident_bytes;
+    m_streamed_lookup[index] = static_cast<uint32_t>(m_streamed.size());
+    m_streamed.push_back(std::move(streamed));
+}
+
+auto TextureManager::unregister_streamed(uint32_t index) -> void {
+    auto it = m_streamed_lookup.find(index);
+    if (it == m_streamed_lookup.end()) {
+        return;
+    }
+
+    const uint32_t position = it->second;
+    m_streamed_lookup.erase(it);
+    m_resident_bytes -= m_streamed[position].resident_bytes;
+
+    // Swap-remove; the moved entry's lookup has to follow it
+    if (position + 1 != m_streamed.size()) {
+        m_streamed[position] = std::move(m_streamed.back());
+        m_streamed_lookup[m_streamed[position].index] = position;
+    }
+    m_streamed.pop_back();
+}
+
+auto TextureManager::request_texture_resolution(uint32_t index, uint32_t pixels) -> void {
+    auto it = m_streamed_lookup.find(index);
+    if (it == m_streamed_lookup.end()) {
+        return;  // Not streamed (default or fully resident texture)
+    }
+
+    auto& streamed = m_streamed[it->second];
+    const uint32_t largest = std::max(streamed.width, streamed.height);
+    pixels = std::max(pixels, 1u);
+
+    // Coarsest mip that still covers the requested footprint
+    uint32_t mip = 0;
+    while (mip < streamed.tail_mip && (largest >> (mip + 1)) >= pixels) {
+        ++mip;
+    }
+
+    streamed.requested_mip = std::min(streamed.requested_mip, mip);
+    streamed.last_requested_frame = m_stream_frame;
+}
+
+auto TextureManager::request_material_resolution(uint32_t material_index, uint32_t pixels) -> void {
+    if (!m_materials->is_live(material_index) || m_streamed.empty()) {
+        return;
+    }
+
+    const auto& material = m_materials->get(material_index);
+    request_texture_resolution(material.albedo_texture_index, pixels);
+    request_texture_resolution(material.normal_texture_index, pixels);
+    request_texture_resolution(material.pbr_texture_index, pixels);
+    request_texture_resolution(material.opacity_texture_index, pixels);
+}
+
+auto TextureManager::update_streaming(VkCommandBuffer cmd, uint32_t frame_index) -> void {
+    ++m_stream_frame;
+    m_stream_frame_index = frame_index % m_frames_in_flight;
+
+    // The fence for this frame slot has signalled, so anything retired a full ring ago is idle
+    while (!m_retired.empty() && m_retired.front().frame + m_frames_in_flight <= m_stream_frame) {
+        m_retired.pop_front();
+    }
+    recycle_retired_slots();
+
+    // Slots loaded since the last frame go into every set
+    update_descriptors();
+
+    // Take finished decodes up to the upload cap (always at least one so big textures progress)
+    std::vector<DecodeResult> results;
+    uint64_t upload_bytes = 0;
+    {
+        std::scoped_lock lock(m_decode_mutex);
+        while (!m_decode_results.empty() &&
+               (results.empty() || upload_bytes < m_streaming.upload_bytes_per_frame)) {
+            for (const auto& mip : m_decode_results.front().mips) {
+                upload_bytes += mip.data.size();
+            }
+            results.push_back(std::move(m_decode_results.front()));
+            m_decode_results.pop_front();
+        }
+    }
+    m_pending_loads -= static_cast<uint32_t>(results.size());
+
+    // Upload everything through one staging buffer and one pair of barrier batches
+    std::vector<std::unique_ptr<batleth::Image>> images(results.size());
+    std::vector<UploadItem> uploads;
+    for (size_t i = 0; i < results.size(); ++i) {
+        images[i] = prepare_upload(results[i]);
+        if (images[i]) {
+            uploads.push_back({.image = images[i].get(), .mips = &results[i].mips});
+        }
+    }
+
+    if (!uploads.empty()) {
+        auto staging = record_uploads(cmd, uploads);
+        m_uploaded_bytes += staging->get_buffer_size();
+        m_retired.push_back({.frame = m_stream_frame, .image = nullptr, .staging = std::move(staging)});
+
+        for (size_t i = 0; i < results.size(); ++i) {
+            if (images[i]) {
+                finish_upload(results[i], std::move(images[i]));
+            }
+        }
+    }
+
+    if (m_streaming.enabled && !m_streamed.empty()) {
+        evict_over_budget(cmd);
+        queue_refinements();
+    }
+
+    // This frame's set is idle (its fence has signalled): write everything patched since it was last used
+    write_descriptors({&m_descriptor_sets[m_stream_frame_index], 1}, m_dirty_slots[m_stream_frame_index]);
+}
+
+auto TextureManager::queue_refinements() -> void {
+    // Queue refinements that fit in the budget, stepping back a mip at a time when they don't
+    const uint64_t budget = get_effective_budget();
+    uint64_t projected = m_resident_bytes;
+    std::vector<DecodeJob> jobs;
+
+    for (uint32_t i = 0; i < m_streamed.size() && m_pending_loads + jobs.size() < MAX_PENDING_LOADS; ++i) {
+        auto& streamed = m_streamed[i];
+        if (streamed.loading || streamed.requested_mip >= streamed.resident_mip) {
+            continue;
+        }
+
+        uint32_t target = streamed.requested_mip;
+        auto projected_with = [&](uint32_t mip) {
+            return projected - streamed.resident_bytes +
+                   estimate_bytes(streamed.width, streamed.height, streamed.mip_levels, mip);
+        };
+        while (target < streamed.resident_mip && projected_with(target) > budget) {
+            ++target;
+        }
+        if (target >= streamed.resident_mip) {
+            continue;
+        }
+
+        projected = projected_with(target);
+        streamed.loading = true;
+        jobs.push_back({
+            .type = streamed.type,
+            .index = streamed.index,
+            .generation = m_slots[streamed.index].generation,
+            .filepath = streamed.filepath,
+            .first_mip = target,
+            .initial = false,
+            .generate_mipmaps = true
+        });
+    }
+
+    m_pending_loads += static_cast<uint32_t>(jobs.size());
+    for (auto& job : jobs) {
+        queue_decode(std::move(job));
+    }
+}
+
+auto TextureManager::get_streaming_stats() const -> StreamingStats {
+    StreamingStats stats{};
+    stats.resident_bytes = m_resident_bytes;
+    stats.budget_bytes = get_effective_budget();
+    stats.streamed_textures = static_cast<uint32_t>(m_streamed.size());
+    stats.pending_loads = m_pending_loads;
+    stats.uploaded_bytes = m_uploaded_bytes;
+    stats.evictions = m_eviction_count;
+
+    for (const auto& streamed : m_streamed) {
+        if (streamed.resident_mip == 0) {
+            ++stats.fully_resident_textures;
+        }
+    }
+    return stats;
+}
+
+auto TextureManager::queue_decode(DecodeJob job) -> void {
+    m_pending_reads.fetch_add(1);
+    const std::string filepath = job.filepath;
+    federation::VirtualFileSystem::get().read_async(filepath,
+        [this, job = std::move(job)](std::expected<federation::FileData, std::string> file) mutable {
+            // A failed read is left to decode(), which retries synchronously and reports the error
+            if (file) {
+                job.file = std::move(*file);
+            }
+            // Everything happens under the lock so the destructor can't finish while this still runs
+            std::scoped_lock lock(m_decode_mutex);
+            m_decode_jobs.push_back(std::move(job));
+            m_decode_cv.notify_one();
+            if (m_pending_reads.fetch_sub(1) == 1) {
+                m_pending_reads.notify_all();
+            }
+        });
+}
+
+auto TextureManager::decode_worker(std::stop_token stop) -> void {
+    while (true) {
+        DecodeJob job;
+        {
+            std::unique_lock lock(m_decode_mutex);
+            if (!m_decode_cv.wait(lock, stop, [this] { return !m_decode_jobs.empty(); })) {
+                break;
+            }
+            job = std::move(m_decode_jobs.front());
+            m_decode_jobs.pop_front();
+        }
+
+        DecodeResult result = decode(job);
+
+        std::scoped_lock lock(m_decode_mutex);
+        m_decode_results.push_back(std::move(result));
+    }
+}
+
+auto TextureManager::decode(const DecodeJob& job) const -> DecodeResult {
+    DecodeResult result{};
+    result.type = job.type;
+    result.index = job.index;
+    result.generation = job.generation;
+    result.filepath = job.filepath;
+    result.first_mip = job.first_mip;
+    result.initial = job.initial;
+
+    std::optional<federation::FileData> file = job.file;
+    if (!file) {
+        auto read = federation::VirtualFileSystem::get().read(job.filepath);
+        if (!read) {
+            FED_ERROR("Failed to load texture {}: {}", job.filepath, read.error());
+            return result;
+        }
+        file = std::move(*read);
+    }
+
+    // Pre-compressed files carry their whole chain and are never streamed
+    if (is_compressed_path(job.filepath)) {
+        auto texture_data = parse_compressed_image(job.filepath, file->get_data(), job.type);
+        if (!texture_data) {
+            FED_ERROR("Failed to load texture {}: {}", job.filepath, texture_data.error());
+            return result;
+        }
+
+        result.width = texture_data->width;
+        result.height = texture_data->height;
+        result.mip_levels = static_cast<uint32_t>(texture_data->levels.size());
+        result.first_mip = 0;
+        result.format = texture_data->format;
+        result.mips = std::move(texture_data->levels);
+        return result;
+    }
+
+    int width, height;
+    stbi_uc* pixels = decode_rgba8(file->get_data(), width, height);
+    if (!pixels) {
+        FED_ERROR("Failed to decode texture: {}", job.filepath);
+        return result;
+    }
+
+    result.width = static_cast<uint32_t>(width);
+    result.height = static_cast<uint32_t>(height);
+
+    if (job.initial) {
+        result.mip_levels = job.generate_mipmaps ? batleth::calculate_mip_levels(result.width, result.height) : 1;
+        result.first_mip = get_tail_mip(result.width, result.height, result.mip_levels);
+    } else {
+        result.mip_levels = batleth::calculate_mip_levels(result.width, result.height);
+    }
+
+    if (result.mip_levels > 1) {
+        result.mips = build_mip_chain(pixels, result.width, result.height, result.first_mip);
+    } else {
+        result.mips.push_back({
+            .width = result.width,
+            .height = result.height,
+            .data = std::vector<uint8_t>(pixels, pixels + static_cast<size_t>(width) * height * 4)
+        });
+    }
+
+    stbi_image_free(pixels);
+    return result;
+}
+
+auto TextureManager::prepare_upload(DecodeResult& result) -> std::unique_ptr<batleth::Image> {
+    if (!is_current(result.index, result.generation)) {
+        return nullptr;  // Texture was released (and the slot possibly reused) while decoding
+    }
+
+    if (result.initial) {
+        if (result.mips.empty()) {
+            return nullptr;  // Slot keeps sampling the default texture
+        }
+        return create_texture_image(result.width, result.height, result.mip_levels, result.first_mip, result.format);
+    }
+
+    auto it = m_streamed_lookup.find(result.index);
+    if (it == m_streamed_lookup.end()) {
+        return nullptr;
+    }
+
+    auto& streamed = m_streamed[it->second];
+    streamed.loading = false;
+
+    if (result.mips.empty() || result.first_mip >= streamed.resident_mip) {
+        // Decode failed or residency already moved past this request; don't retry it every frame
+        streamed.requested_mip = std::max(streamed.requested_mip, streamed.resident_mip);
+        return nullptr;
+    }
+
+    if (result.width != streamed.width || result.height != streamed.height) {
+        FED_ERROR("Streamed texture changed on disk, keeping current residency: {}", streamed.filepath);
+        streamed.requested_mip = streamed.resident_mip;
+        return nullptr;
+    }
+
+    return create_texture_image(streamed.width, streamed.height, streamed.mip_levels, result.first_mip);
+}
+
+auto TextureManager::finish_upload(DecodeResult& result, std::unique_ptr<batleth::Image> image) -> void {
+    auto& slot = m_slots[result.index].texture;
+    const uint64_t new_bytes = get_allocation_size(*image);
+
+    if (result.initial) {
+        slot = std::make_unique<batleth::Texture>(std::move(image), result.type, result.filepath);
+        register_streamed(result.type, result.index, result.filepath, result.width, result.height,
+                          result.mip_levels, result.first_mip, new_bytes);
+
+        FED_INFO("Loaded texture: {} (index {}, {}x{}, {} of {} mips resident)", result.filepath, result.index,
+                 result.width, result.height, result.mip_levels - result.first_mip, result.mip_levels);
+    } else {
+        auto& streamed = m_streamed[m_streamed_lookup.at(result.index)];
+
+        auto old_image = slot->replace_image(std::move(image));
+        m_retired.push_back({.frame = m_stream_frame, .image = std::move(old_image), .staging = nullptr});
+
+        m_resident_bytes = m_resident_bytes - streamed.resident_bytes + new_bytes;
+        streamed.resident_bytes = new_bytes;
+        streamed.resident_mip = result.first_mip;
+
+        FED_TRACE("Streamed {} in to mip {}", streamed.filepath, streamed.resident_mip);
+    }
+
+    patch_descriptor(result.index);
+}
+
+auto TextureManager::evict_over_budget(VkCommandBuffer cmd) -> void {
+    const uint64_t budget = get_effective_budget();
+    if (m_resident_bytes <= budget) {
+        return;
+    }
+
+    std::vector<uint32_t> candidates;
+    for (uint32_t i = 0; i < m_streamed.size(); ++i) {
+        const auto& streamed = m_streamed[i];
+        if (!streamed.loading && streamed.resident_mip < streamed.tail_mip &&
+            streamed.last_requested_frame + m_streaming.eviction_delay_frames < m_stream_frame) {
+            candidates.push_back(i);
+        }
+    }
+
+    // Least recently requested first
+    std::sort(candidates.begin(), candidates.end(), [this](uint32_t a, uint32_t b) {
+        return m_streamed[a].last_requested_frame < m_streamed[b].last_requested_frame;
+    });
+
+    uint64_t projected = m_resident_bytes;
+    for (uint32_t i : candidates) {
+        if (projected <= budget) {
+            break;
+        }
+
+        auto& streamed = m_streamed[i];
+        uint32_t target = streamed.resident_mip;
+        uint64_t target_bytes = streamed.resident_bytes;
+        while (target < streamed.tail_mip && projected - streamed.resident_bytes + target_bytes > budget) {
+            ++target;
+            target_bytes = estimate_bytes(streamed.width, streamed.height, streamed.mip_levels, target);
+        }
+
+        projected = projected - streamed.resident_bytes + target_bytes;
+        evict_mips(cmd, streamed, target);
+    }
+
+    if (m_resident_bytes > budget) {
+        FED_TRACE("Texture streaming over budget after eviction ({} / {} MiB)",
+                  m_resident_bytes >> 20, budget >> 20);
+    }
+}
+
+auto TextureManager::evict_mips(VkCommandBuffer cmd, StreamedTexture& streamed, uint32_t new_resident_mip) -> void {
+    auto& texture = m_slots[streamed.index].texture;
+    auto& old_image = texture->get_image();
+    const uint32_t skipped = new_resident_mip - streamed.resident_mip;
+
+    auto image = create_texture_image(streamed.width, streamed.height, streamed.mip_levels, new_resident_mip);
+
+    // The surviving coarse mips are already on the GPU; copy them rather than re-decode
+    old_image.transition_layout(cmd, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                skipped, VK_REMAINING_MIP_LEVELS);
+    image->transition_layout(cmd, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+    std::vector<VkImageCopy> regions;
+    regions.reserve(image->get_mip_levels());
+    for (uint32_t mip = 0; mip < image->get_mip_levels(); ++mip) {
+        VkImageCopy region{};
+        region.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, mip + skipped, 0, 1};
+        region.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, mip, 0, 1};
+        region.extent = {
+            mip_extent(streamed.width, new_resident_mip + mip),
+            mip_extent(streamed.height, new_resident_mip + mip),
+            1
+        };
+        regions.push_back(region);
+    }
+
+    ::vkCmdCopyImage(cmd, old_image.get_image(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                     image->get_image(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                     static_cast<uint32_t>(regions.size()), regions.data());
+
+    image->transition_layout(cmd, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+    const uint64_t new_bytes = get_allocation_size(*image);
+    auto retired = texture->replace_image(std::move(image));
+    m_retired.push_back({.frame = m_stream_frame, .image = std::move(retired), .staging = nullptr});
+
+    FED_TRACE("Evicted {} to mip {} (freed {} KiB)", streamed.filepath, new_resident_mip,
+              (streamed.resident_bytes - std::min(new_bytes, streamed.resident_bytes)) / 1024);
+
+    m_resident_bytes = m_resident_bytes - streamed.resident_bytes + new_bytes;
+    streamed.resident_bytes = new_bytes;
+    streamed.resident_mip = new_resident_mip;
+    streamed.requested_mip = new_resident_mip;
+    ++m_eviction_count;
+
+    patch_descriptor(streamed.index);
+}
+
+auto TextureManager::create_texture_image(
+    uint32_t width,
+    uint32_t height,
+    uint32_t mip_levels,
+    uint32_t first_mip,
+    VkFormat format
+) const -> std::unique_ptr<batleth::Image> {
+    batleth::Image::Config img_config{};
+    img_config.device = m_device.get_logical_device();
+    img_config.allocator = m_allocator;
+    img_config.width = mip_extent(width, first_mip);
+    img_config.height = mip_extent(height, first_mip);
+    img_config.mip_levels = mip_levels - first_mip;
+    img_config.format = format;
+    img_config.tiling = VK_IMAGE_TILING_OPTIMAL;
+    img_config.usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    img_config.aspect_flags = VK_IMAGE_ASPECT_COLOR_BIT;
+    img_config.create_view = true;
+
+    return std::make_unique<batleth::Image>(img_config);
+}
+
+auto TextureManager::record_uploads(
+    VkCommandBuffer cmd,
+    const std::vector<UploadItem>& uploads
+) -> std::unique_ptr<batleth::Buffer> {
+    VkDeviceSize total_size = 0;
+    for (const auto& upload : uploads) {
+        for (const auto& mip : *upload.mips) {
+            total_size += align_copy_offset(mip.data.size());
+        }
+    }
+
+    auto staging = std::make_unique<batleth::Buffer>(
+        m_device,
+        total_size,
+        1,
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+    );
+
+    staging->map();
+    auto* mapped = static_cast<uint8_t*>(staging->get_mapped_memory());
+
+    const batleth::ResourceState transfer_dst{
+        .stage_mask = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+        .access_mask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+        .layout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+    };
+    const batleth::ResourceState shader_read{
+        .stage_mask = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+        .access_mask = VK_ACCESS_2_SHADER_READ_BIT,
+        .layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+    };
+
+    batleth::BarrierBatcher to_transfer;
+    for (const auto& upload : uploads) {
+        upload.image->transition(to_transfer, transfer_dst);
+    }
+    to_transfer.flush(cmd);
+
+    VkDeviceSize offset = 0;
+    std::vector<VkBufferImageCopy> regions;
+    for (const auto& upload : uploads) {
+        const auto& mips = *upload.mips;
+
+        regions.clear();
+        for (uint32_t mip = 0; mip < mips.size(); ++mip) {
+            std::memcpy(mapped + offset, mips[mip].data.data(), mips[mip].data.size());
+
+            VkBufferImageCopy region{};
+            region.bufferOffset = offset;
+            region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            region.imageSubresource.mipLevel = mip;
+            region.imageSubresource.baseArrayLayer = 0;
+            region.imageSubresource.layerCount = 1;
+            region.imageExtent = {mips[mip].width, mips[mip].height, 1};
+            regions.push_back(region);
+
+            offset += align_copy_offset(mips[mip].data.size());
+        }
+
+        ::vkCmdCopyBufferToImage(cmd, staging->get_buffer(), upload.image->get_image(),
+                                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                static_cast<uint32_t>(regions.size()), regions.data());
+    }
+
+    staging->unmap();
+
+    batleth::BarrierBatcher to_shader;
+    for (const auto& upload : uploads) {
+        upload.image->transition(to_shader, shader_read);
+    }
+    to_shader.flush(cmd);
+
+    return staging;
+}
+
+auto TextureManager::patch_descriptor(uint32_t index) -> void {
+    // Sets can't be rewritten under a frame that samples the slot; each frame's set takes
+    // the patch at its next update_streaming(), once its fence has come back
+    for (auto& dirty : m_dirty_slots) {
+        dirty.push_back(index);
+    }
+}
+
+auto TextureManager::write_descriptors(std::span<const VkDescriptorSet> sets, std::vector<uint32_t>& slots) -> void {
+    if (slots.empty()) {
+        return;
+    }
+
+    std::sort(slots.begin(), slots.end());
+    slots.erase(std::unique(slots.begin(), slots.end()), slots.end());
+
+    std::vector<VkDescriptorImageInfo> infos;
+    infos.reserve(slots.size());
+    for (uint32_t index : slots) {
+        const auto& slot = m_slots[index];
+        const auto& texture = slot.texture ? slot.texture : m_slots[get_default_index(slot.type)].texture;
+
+        VkDescriptorImageInfo info{};
+        info.sampler = m_default_sampler->get_handle();
+        info.imageView = texture->get_image().get_view();
+        info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        infos.push_back(info);
+    }
+
+    // One write per contiguous run of dirty slots, per set
+    std::vector<VkWriteDescriptorSet> writes;
+    for (VkDescriptorSet set : sets) {
+        for (size_t run_start = 0; run_start < slots.size();) {
+            size_t run_end = run_start + 1;
+            while (run_end < slots.size() && slots[run_end] == slots[run_end - 1] + 1) {
+                ++run_end;
+            }
+
+            VkWriteDescriptorSet write{};
+            write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.dstSet = set;
+            write.dstBinding = 0;
+            write.dstArrayElement = slots[run_start];
+            write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            write.descriptorCount = static_cast<uint32_t>(run_end - run_start);
+            write.pImageInfo = &infos[run_start];
+            writes.push_back(write);
+
+            run_start = run_end;
+        }
+    }
+
+    ::vkUpdateDescriptorSets(m_device.get_logical_device(), static_cast<uint32_t>(writes.size()), writes.data(),
+                             0, nullptr);
+    slots.clear();
+}
+
+auto TextureManager::get_effective_budget() const -> uint64_t {
+    uint64_t budget = m_streaming.budget_bytes;
+
+    // Never plan past what the largest device-local heap can actually take right now
+    // (VMA reports VK_EXT_memory_budget numbers when available, otherwise its own estimate)
+    const VkPhysicalDeviceMemoryProperties* memory_properties = nullptr;
+    ::vmaGetMemoryProperties(m_allocator, &memory_properties);
+
+    std::array<VmaBudget, VK_MAX_MEMORY_HEAPS> heap_budgets{};
+    ::vmaGetHeapBudgets(m_allocator, heap_budgets.data());
+
+    uint32_t device_heap = UINT32_MAX;
+    for (uint32_t heap = 0; heap < memory_properties->memoryHeapCount; ++heap) {
+        if ((memory_properties->memoryHeaps[heap].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) == 0) continue;
+        if (device_heap == UINT32_MAX ||
+            memory_properties->memoryHeaps[heap].size > memory_properties->memoryHeaps[device_heap].size) {
+            device_heap = heap;
+        }
+    }
+
+    if (device_heap != UINT32_MAX) {
+        const auto& heap = heap_budgets[device_heap];
+        const uint64_t headroom = heap.budget > heap.usage ? heap.budget - heap.usage : 0;
+        budget = std::min(budget, m_resident_bytes + headroom);
+    }
+
+    return budget;
+}
+
+auto TextureManager::get_allocation_size(const batleth::Image& image) const -> uint64_t {
+    VmaAllocationInfo info{};
+    ::vmaGetAllocationInfo(m_allocator, image.get_allocation(), &info);
+    return info.size;
+}
+
+} // namespace klingon
@@ -59,4 +59,27 @@ namespace klingon {
             }
         };
     }
+
+    auto Transform::from_mat4(const glm::mat4& matrix) -> Transform {
+        Transform result;
+        result.translation = glm::vec3(matrix[3]);
+        result.scale = {glm::length(glm::vec3(matrix[0])), glm::length(glm::vec3(matrix[1])),
+                        glm::length(glm::vec3(matrix[2]))};
+
+        // Columns of the pure rotation, see mat4() for the terms
+        const glm::vec3 x_axis = glm::vec3(matrix[0]) / result.scale.x;
+        const glm::vec3 y_axis = glm::vec3(matrix[1]) / result.scale.y;
+        const glm::vec3 z_axis = glm::vec3(matrix[2]) / result.scale.z;
+
+        result.rotation.x = glm::asin(glm::clamp(-z_axis.y, -1.f, 1.f));
+        if (glm::abs(z_axis.y) < 0.9999f) {
+            result.rotation.y = glm::atan(z_axis.x, z_axis.z);
+            result.rotation.z = glm::atan(x_axis.y, y_axis.y);
+        } else {
+            // Gimbal lock: yaw and roll share an axis, so put it all in yaw
+            result.rotation.y = glm::atan(-x_axis.z, x_axis.x);
+            result.rotation.z = 0.f;
+        }
+        return result;
+    }
 } // namespace klingon
@@ -94,6 +94,18 @@ namespace batleth {
      */
         auto flush(VkCommandBuffer cmd) -> void;
 
+        /**
+     * Record the batched barriers as the first half of a split barrier.
+     * Uses vkCmdSetEvent2; the matching wait_event() must batch identical barriers.
+     */
+        auto signal_event(VkCommandBuffer cmd, VkEvent event) -> void;
+
+        /**
+     * Record the batched barriers as the second half of a split barrier.
+     * Uses vkCmdWaitEvents2.
+     */
+        auto wait_event(VkCommandBuffer cmd, VkEvent event) -> void;
+
         /**
      * Clear all batched barriers without submitting.
      */
@@ -110,6 +122,8 @@ namespace batleth {
         [[nodiscard]] auto barrier_count() const -> std::size_t;
 
     private:
+        [[nodiscard]] auto build_dependency_info() const -> VkDependencyInfo;
+
         std::vector<VkImageMemoryBarrier2> m_image_barriers;
         std::vector<VkBufferMemoryBarrier2> m_buffer_barriers;
         std::vector<VkMemoryBarrier2> m_memory_barriers;
@@ -144,7 +158,7 @@ namespace batleth {
 
     /**
  * Check if a barrier is needed between two resource states.
- * Returns false if states are identical or no synchronization is needed.
+ * Returns false only for read-after-read with no layout or queue family change.
  */
     BATLETH_API auto needs_barrier(
         const ResourceState &before,
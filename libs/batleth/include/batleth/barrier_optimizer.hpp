@@ -0,0 +1,113 @@
+#pragma once
+
+#include "render_graph_resource.hpp"
+#include "render_graph_pass.hpp"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#ifdef _WIN32
+#ifdef BATLETH_EXPORTS
+#define BATLETH_API __declspec(dllexport)
+#else
+#define BATLETH_API __declspec(dllimport)
+#endif
+#else
+#define BATLETH_API
+#endif
+
+namespace batleth {
+    // State a pass needs a resource to be in before it executes
+    struct BATLETH_API StateRequirement {
+        ResourceHandle resource = INVALID_RESOURCE;
+        ResourceState state{};
+        SubresourceRange range{};
+    };
+
+    struct BATLETH_API BarrierOptimizerConfig {
+        // Producer/consumer pass distance at which a split barrier (vkCmdSetEvent2 after the
+        // producer, vkCmdWaitEvents2 before the consumer) replaces a pipeline barrier.
+        std::uint32_t split_distance = 2;
+        bool enable_split_barriers = true;
+    };
+
+    struct BATLETH_API BarrierOptimizerInput {
+        // Starting state of every resource, indexed by handle
+        std::span<const ResourceState> initial_states;
+
+        // Mip/layer counts of every resource (mip_count, layer_count), indexed by handle.
+        // Empty, or a missing entry, means a single subresource (buffers, plain 2D images).
+        std::span<const SubresourceRange> subresource_extents;
+
+        // Per-pass requirements, flattened. Pass i owns
+        // [requirement_offsets[i], requirement_offsets[i + 1]).
+        std::span<const StateRequirement> requirements;
+        std::span<const std::uint32_t> requirement_offsets;
+
+        // States resources must be left in after the last pass (e.g. PRESENT for the swapchain)
+        std::span<const StateRequirement> final_requirements;
+    };
+
+    // Split barriers between one producer/consumer pass pair, recorded through a single event
+    struct BATLETH_API SplitBarrierGroup {
+        std::uint32_t signal_pass = 0; // Event is set after this pass
+        std::uint32_t wait_pass = 0; // Event is waited on before this pass
+        std::uint32_t first_barrier = 0; // Range into OptimizedBarriers::split_barriers
+        std::uint32_t barrier_count = 0;
+    };
+
+    struct BATLETH_API BarrierStats {
+        std::uint32_t requested = 0; // Requirements after merging duplicates within a pass
+        std::uint32_t eliminated = 0; // Requirements that needed no barrier (read-after-read)
+        std::uint32_t merged = 0; // Barriers folded into an adjacent subresource range
+        std::uint32_t emitted = 0; // Barriers recorded per execution, including split and final
+        std::uint32_t split = 0; // Barriers recorded through events
+        std::uint32_t batches = 0; // vkCmdPipelineBarrier2 calls per execution
+    };
+
+    struct BATLETH_API OptimizedBarriers {
+        // Immediate barriers, pass i owns [pass_offsets[i], pass_offsets[i + 1])
+        std::vector<PassBarrier> barriers;
+        std::vector<std::uint32_t> pass_offsets;
+
+        // Split barriers. Groups are sorted by wait pass; pass i waits on groups
+        // [split_wait_offsets[i], split_wait_offsets[i + 1]) and signals the groups listed in
+        // split_signal_order[split_signal_offsets[i] .. split_signal_offsets[i + 1]).
+        std::vector<PassBarrier> split_barriers;
+        std::vector<SplitBarrierGroup> split_groups;
+        std::vector<std::uint32_t> split_wait_offsets;
+        std::vector<std::uint32_t> split_signal_order;
+        std::vector<std::uint32_t> split_signal_offsets;
+
+        // Barriers after the last pass
+        std::vector<PassBarrier> final_barriers;
+
+        BarrierStats stats;
+    };
+
+    /**
+ * Turn per-pass state requirements into the minimal set of barriers.
+ *
+ * - Requirements on the same resource within a pass are combined into one.
+ * - Read-after-read with no layout change is dropped; the tracked read scope is
+ *   widened instead so the next writer still waits on every reader.
+ * - Barriers with identical states on adjacent subresource ranges are merged.
+ * - Producer/consumer pairs at least split_distance passes apart become split barriers.
+ *
+ * Pure function: no Vulkan calls, output depends only on the arguments.
+ */
+    BATLETH_API auto optimize_barriers(
+        const BarrierOptimizerInput &input,
+        const BarrierOptimizerConfig &config = {}
+    ) -> OptimizedBarriers;
+
+    /**
+ * Merge barriers in [first, end) that share a resource and before/after states and whose
+ * subresource ranges are adjacent along mips or layers. Order is otherwise preserved.
+ * @return Number of barriers removed
+ */
+    BATLETH_API auto merge_subresource_ranges(
+        std::vector<PassBarrier> &barriers,
+        std::size_t first = 0
+    ) -> std::uint32_t;
+} // namespace batleth
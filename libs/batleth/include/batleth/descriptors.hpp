@@ -23,20 +23,27 @@ namespace batleth {
             explicit Builder(VkDevice device) : m_device(device) {
             }
 
+            /**
+             * @param binding_flags VK_DESCRIPTOR_BINDING_*_BIT flags (descriptor indexing); any
+             *        UPDATE_AFTER_BIND binding makes the layout require an update-after-bind pool
+             */
             Builder &add_binding(
                 uint32_t binding,
                 VkDescriptorType descriptor_type,
                 VkShaderStageFlags stage_flags,
-                uint32_t count = 1);
+                uint32_t count = 1,
+                VkDescriptorBindingFlags binding_flags = 0);
 
             std::unique_ptr<DescriptorSetLayout> build() const;
 
         private:
             VkDevice m_device;
             std::unordered_map<uint32_t, VkDescriptorSetLayoutBinding> m_bindings{};
+            std::unordered_map<uint32_t, VkDescriptorBindingFlags> m_binding_flags{};
         };
 
-        DescriptorSetLayout(VkDevice device, std::unordered_map<uint32_t, VkDescriptorSetLayoutBinding> bindings);
+        DescriptorSetLayout(VkDevice device, std::unordered_map<uint32_t, VkDescriptorSetLayoutBinding> bindings,
+                            const std::unordered_map<uint32_t, VkDescriptorBindingFlags> &binding_flags = {});
 
         ~DescriptorSetLayout();
 
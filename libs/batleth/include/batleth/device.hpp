@@ -61,6 +61,22 @@ namespace batleth {
         auto get_command_pool() const -> VkCommandPool { return m_command_pool; }
         auto set_command_pool(VkCommandPool pool) -> void { m_command_pool = pool; }
 
+        /**
+     * True if VK_EXT_memory_budget was enabled at device creation
+     */
+        auto has_memory_budget() const -> bool { return m_memory_budget_enabled; }
+
+        /**
+     * True if the textureCompressionBC feature was enabled at device creation
+     */
+        auto has_texture_compression_bc() const -> bool { return m_texture_compression_bc; }
+
+        /**
+     * Check whether optimally tiled images of a format support all of the given features
+     * BC formats always report false when textureCompressionBC isn't enabled.
+     */
+        auto supports_format(VkFormat format, VkFormatFeatureFlags features) const -> bool;
+
         auto wait_idle() const -> void;
 
         /**
@@ -116,6 +132,10 @@ namespace batleth {
         VkCommandPool m_command_pool = VK_NULL_HANDLE;
         QueueFamilyIndices m_indices;
         bool m_owns_command_pool = false;
+        bool m_memory_budget_enabled = false;
+        bool m_texture_compression_bc = false;
+
+        static auto supports_extension(VkPhysicalDevice device, const char *extension) -> bool;
 
         auto pick_physical_device(VkInstance instance, VkSurfaceKHR surface) -> void;
 
@@ -2,6 +2,8 @@
 
 #include <vulkan/vulkan.h>
 #include <vk_mem_alloc.h>
+#include "subresource_tracker.hpp"
+#include "barrier_batcher.hpp"
 #include <cstdint>
 
 #ifdef _WIN32
@@ -55,12 +57,44 @@ namespace batleth {
         [[nodiscard]] auto get_allocation() const -> VmaAllocation { return m_allocation; }
         [[nodiscard]] auto get_format() const -> VkFormat { return m_format; }
         [[nodiscard]] auto get_mip_levels() const -> uint32_t { return m_mip_levels; }
+        [[nodiscard]] auto get_array_layers() const -> uint32_t { return m_array_layers; }
         [[nodiscard]] auto get_extent() const -> VkExtent2D { return {m_width, m_height}; }
+        [[nodiscard]] auto get_state_tracker() const -> const SubresourceStateTracker& { return m_state_tracker; }
+
+        /**
+         * Transition a sub-range of the image to a new state
+         * Only the mips/layers whose tracked state differs get a barrier; all barriers
+         * are recorded with a single vkCmdPipelineBarrier2
+         * @param cmd Command buffer to record transition
+         * @param state Target state (stage, access, layout)
+         * @param range Mips/layers to transition (default: whole image)
+         * @return Number of image barriers recorded
+         */
+        auto transition(
+            VkCommandBuffer cmd,
+            const ResourceState& state,
+            const SubresourceRange& range = {}
+        ) -> uint32_t;
+
+        /**
+         * Same as above, but the barriers are added to a caller-owned batch so transitions of
+         * many images can share one vkCmdPipelineBarrier2 (the tracker is updated immediately)
+         * @param batcher Batch that receives the image barriers
+         * @param state Target state (stage, access, layout)
+         * @param range Mips/layers to transition (default: whole image)
+         * @return Number of image barriers added
+         */
+        auto transition(
+            BarrierBatcher& batcher,
+            const ResourceState& state,
+            const SubresourceRange& range = {}
+        ) -> uint32_t;
 
         /**
          * Transition image layout with pipeline barrier
+         * The source state comes from the subresource tracker; old_layout is only checked
          * @param cmd Command buffer to record transition
-         * @param old_layout Current image layout
+         * @param old_layout Expected current image layout
          * @param new_layout Target image layout
          * @param base_mip Starting mip level (default 0)
          * @param mip_count Number of mip levels to transition (default VK_REMAINING_MIP_LEVELS)
@@ -85,5 +119,6 @@ namespace batleth {
         uint32_t m_height = 0;
         uint32_t m_mip_levels = 1;
         uint32_t m_array_layers = 1;
+        SubresourceStateTracker m_state_tracker;
     };
 } // namespace batleth
@@ -15,25 +15,22 @@
 
 namespace batleth {
     class Device;
+    class Image;
 
     /**
      * Generate mipmaps using vkCmdBlitImage
+     * All mips must be in TRANSFER_DST_OPTIMAL with mip 0 holding the uploaded data;
+     * they are left in SHADER_READ_ONLY_OPTIMAL.
+     * Each step only barriers the source mip, and the final transition is merged
+     * by the image's subresource tracker
      * @param device Vulkan device
      * @param cmd Command buffer to record blit commands
-     * @param image Image to generate mipmaps for
-     * @param format Image format (must support blit operations)
-     * @param width Image width
-     * @param height Image height
-     * @param mip_levels Number of mip levels
+     * @param image Image to generate mipmaps for (format must support linear blits)
      */
     BATLETH_API auto generate_mipmaps(
         Device& device,
         VkCommandBuffer cmd,
-        VkImage image,
-        VkFormat format,
-        uint32_t width,
-        uint32_t height,
-        uint32_t mip_levels
+        Image& image
     ) -> void;
 
     /**
@@ -1,10 +1,11 @@
 #pragma once
 
 #include "render_graph_resource.hpp"
+#include "federation/inplace_function.hpp"
+#include "federation/name_registry.hpp"
+#include "federation/small_vector.hpp"
 #include <vulkan/vulkan.h>
-#include <functional>
 #include <vector>
-#include <string>
 #include <cstdint>
 
 #ifdef _WIN32
@@ -52,17 +53,22 @@ namespace batleth {
         ResourceHandle handle = INVALID_RESOURCE;
         ResourceUsage usage = ResourceUsage::SampledImage;
         VkPipelineStageFlags2 stage_override = 0; // 0 = use default from usage
+        SubresourceRange range{}; // Mips/layers touched, whole resource by default
     };
 
+    // Inline capacity for per-pass access lists; typical passes touch far fewer
+    constexpr std::size_t PASS_ACCESS_INLINE_CAPACITY = 8;
+    using ResourceAccessList = federation::SmallVector<ResourceAccess, PASS_ACCESS_INLINE_CAPACITY>;
+
     // Pass configuration
     struct BATLETH_API PassConfig {
-        std::string name;
+        federation::NameId name = federation::INVALID_NAME_ID;
         PassType type = PassType::Graphics;
         QueueType queue = QueueType::Graphics;
 
         // Resource access declarations
-        std::vector<ResourceAccess> reads;
-        std::vector<ResourceAccess> writes;
+        ResourceAccessList reads;
+        ResourceAccessList writes;
 
         // Graphics pass attachments
         std::vector<ColorAttachmentConfig> color_attachments;
@@ -102,8 +108,8 @@ namespace batleth {
         [[nodiscard]] auto get_image_extent(ResourceHandle handle) const -> VkExtent3D;
     };
 
-    // Pass execution callback type
-    using PassExecuteCallback = std::function<void(const PassExecutionContext &)>;
+    // Pass execution callback type. Stored inline - captures must fit in 64 bytes.
+    using PassExecuteCallback = federation::InplaceFunction<void(const PassExecutionContext &)>;
 
     // Complete pass definition
     struct BATLETH_API PassDefinition {
@@ -113,15 +119,16 @@ namespace batleth {
         // Computed during compilation
         std::uint32_t index = ~0u; // Original index in declaration order
         std::uint32_t topological_order = ~0u;
-        std::vector<std::uint32_t> dependencies; // Indices of passes this depends on
-        std::vector<std::uint32_t> dependents; // Indices of passes that depend on this
+        federation::SmallVector<std::uint32_t, 4> dependencies; // Indices of passes this depends on
+        federation::SmallVector<std::uint32_t, 4> dependents; // Indices of passes that depend on this
     };
 
     // Barrier information for pass transitions
     struct BATLETH_API PassBarrier {
         ResourceHandle resource = INVALID_RESOURCE;
-        ResourceState before;
-        ResourceState after;
+        ResourceState before{};
+        ResourceState after{};
+        SubresourceRange range{}; // Whole resource unless narrowed by subresource tracking
         bool is_release = false; // True for queue family release barrier
         bool is_acquire = false; // True for queue family acquire barrier
     };
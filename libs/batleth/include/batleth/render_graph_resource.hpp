@@ -1,7 +1,7 @@
 #pragma once
 
+#include "federation/name_registry.hpp"
 #include <vulkan/vulkan.h>
-#include <string>
 #include <cstdint>
 #include <variant>
 
@@ -75,10 +75,13 @@ namespace batleth {
 
     // Unified resource description
     struct BATLETH_API ResourceDesc {
-        std::string name;
+        federation::NameId name = federation::INVALID_NAME_ID;
         ResourceType type = ResourceType::Image;
         std::variant<ImageResourceDesc, BufferResourceDesc> desc;
 
+        // Unnamed slots pad the handle space when externals are imported out of order
+        auto is_placeholder() const -> bool { return name == federation::INVALID_NAME_ID; }
+
         auto is_image() const -> bool { return type == ResourceType::Image; }
         auto is_buffer() const -> bool { return type == ResourceType::Buffer; }
 
@@ -91,6 +94,16 @@ namespace batleth {
         }
     };
 
+    // Mip/layer range of an image. Counts may be VK_REMAINING_* to cover the rest of the image.
+    struct BATLETH_API SubresourceRange {
+        std::uint32_t base_mip = 0;
+        std::uint32_t mip_count = VK_REMAINING_MIP_LEVELS;
+        std::uint32_t base_layer = 0;
+        std::uint32_t layer_count = VK_REMAINING_ARRAY_LAYERS;
+
+        auto operator==(const SubresourceRange &other) const -> bool = default;
+    };
+
     // Resource state tracking for barrier generation
     struct BATLETH_API ResourceState {
         VkPipelineStageFlags2 stage_mask = VK_PIPELINE_STAGE_2_NONE;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vulkan/vulkan.h>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <filesystem>
@@ -90,7 +91,7 @@ namespace batleth {
         std::filesystem::path m_filepath;
         Stage m_stage;
         bool m_hot_reload_enabled;
-        std::filesystem::file_time_type m_last_write_time;
+        std::int64_t m_last_write_time = 0;     // VFS mtime ticks; stays 0 for packed shaders
         ReloadCallback m_reload_callback;
     };
 } // namespace batleth
\ No newline at end of file
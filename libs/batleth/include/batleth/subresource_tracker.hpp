@@ -0,0 +1,113 @@
+#pragma once
+
+#include "render_graph_resource.hpp"
+#include "render_graph_pass.hpp"
+#include "federation/small_vector.hpp"
+#include <cstdint>
+#include <vector>
+
+#ifdef _WIN32
+#ifdef BATLETH_EXPORTS
+#define BATLETH_API __declspec(dllexport)
+#else
+#define BATLETH_API __declspec(dllimport)
+#endif
+#else
+#define BATLETH_API
+#endif
+
+namespace batleth {
+    /**
+ * Tracks the synchronization state of every mip level and array layer of an image.
+ *
+ * State is run-length compressed in both dimensions: runs of layers that share the same
+ * per-mip layout are stored once, and within them consecutive mips in the same state form
+ * a single run. A fully uniform image costs one entry regardless of its mip/layer count.
+ *
+ * transition() emits only the barriers the touched sub-range actually needs, so mip-chain
+ * work (downsampling, depth pyramids, bloom) doesn't have to barrier the whole image.
+ */
+    class BATLETH_API SubresourceStateTracker {
+    public:
+        SubresourceStateTracker() : SubresourceStateTracker(1, 1) {
+        }
+
+        SubresourceStateTracker(
+            std::uint32_t mip_levels,
+            std::uint32_t array_layers,
+            const ResourceState &initial_state = {}
+        );
+
+        /**
+     * Move a sub-range into a new state, appending the minimal set of barriers to `out`.
+     * Read-after-read sub-ranges with no layout change emit nothing; their tracked read
+     * scope is widened instead so a later writer waits on every reader.
+     * @param range Mips/layers to transition (VK_REMAINING_* counts are resolved)
+     * @param state Required state
+     * @param out Barriers are appended here, already merged across adjacent ranges
+     * @param resource Handle stamped on the emitted barriers
+     * @return Number of barriers appended
+     */
+        auto transition(
+            const SubresourceRange &range,
+            const ResourceState &state,
+            std::vector<PassBarrier> &out,
+            ResourceHandle resource = INVALID_RESOURCE
+        ) -> std::uint32_t;
+
+        /**
+     * Get the tracked state of a single subresource.
+     */
+        [[nodiscard]] auto get_state(std::uint32_t mip, std::uint32_t layer = 0) const -> const ResourceState &;
+
+        /**
+     * Clamp a range to this image, resolving VK_REMAINING_* counts.
+     */
+        [[nodiscard]] auto resolve(const SubresourceRange &range) const -> SubresourceRange;
+
+        /**
+     * True if every subresource is in the same state.
+     */
+        [[nodiscard]] auto is_uniform() const -> bool;
+
+        /**
+     * Number of stored runs (for diagnostics).
+     */
+        [[nodiscard]] auto get_run_count() const -> std::size_t;
+
+        [[nodiscard]] auto get_mip_levels() const -> std::uint32_t { return m_mip_levels; }
+        [[nodiscard]] auto get_array_layers() const -> std::uint32_t { return m_array_layers; }
+
+    private:
+        struct MipRun {
+            std::uint32_t base_mip = 0;
+            std::uint32_t mip_count = 0;
+            ResourceState state{};
+
+            auto operator==(const MipRun &other) const -> bool = default;
+        };
+
+        using MipRuns = federation::SmallVector<MipRun, 2>;
+
+        struct LayerRun {
+            std::uint32_t base_layer = 0;
+            std::uint32_t layer_count = 0;
+            MipRuns mips;
+        };
+
+        auto split_layers_at(std::uint32_t layer) -> void;
+
+        auto coalesce_layers() -> void;
+
+        static auto split_mips_at(MipRuns &mips, std::uint32_t mip) -> void;
+
+        static auto coalesce_mips(MipRuns &mips) -> void;
+
+        std::uint32_t m_mip_levels = 1;
+        std::uint32_t m_array_layers = 1;
+
+        // Sorted by base_layer, covering [0, m_array_layers) without gaps. Each entry's mip
+        // runs are sorted by base_mip and cover [0, m_mip_levels) without gaps.
+        std::vector<LayerRun> m_layers;
+    };
+} // namespace batleth
@@ -29,6 +29,9 @@ namespace batleth {
             std::uint32_t height = 720;
             std::uint32_t min_image_count = 2;
             VkPresentModeKHR preferred_present_mode = VK_PRESENT_MODE_MAILBOX_KHR;
+            // Swapchain being replaced, passed as oldSwapchain so presentation hands over without a gap.
+            // It stays owned by the caller, who destroys it once no frame in flight uses its images.
+            VkSwapchainKHR old_swapchain = VK_NULL_HANDLE;
         };
 
         struct SupportDetails {
@@ -58,7 +61,8 @@ namespace batleth {
 
         /**
      * Recreates the swapchain with new dimensions.
-     * Used when the window is resized.
+     * Waits for the device to go idle; to resize without stalling, create a new Swapchain with
+     * Config::old_swapchain set and destroy this one once its frames have retired.
      */
         auto resize(std::uint32_t width, std::uint32_t height) -> void;
 
@@ -3,6 +3,7 @@
 #include "image.hpp"
 #include <memory>
 #include <string>
+#include <utility>
 
 #ifdef _WIN32
 #ifdef BATLETH_EXPORTS
@@ -34,9 +35,19 @@ namespace batleth {
             , m_filepath(std::move(filepath)) {}
 
         [[nodiscard]] auto get_image() const -> const Image& { return *m_image; }
+        [[nodiscard]] auto get_image() -> Image& { return *m_image; }
         [[nodiscard]] auto get_type() const -> TextureType { return m_type; }
         [[nodiscard]] auto get_filepath() const -> const std::string& { return m_filepath; }
 
+        /**
+         * Swap in a new backing image (e.g. after a streaming residency change)
+         * @return The previous image, which must outlive any in-flight use
+         */
+        auto replace_image(std::unique_ptr<Image> image) -> std::unique_ptr<Image> {
+            std::swap(m_image, image);
+            return image;
+        }
+
     private:
         std::unique_ptr<Image> m_image;
         TextureType m_type;
@@ -47,6 +47,7 @@ namespace batleth {
             VkPhysicalDevice physical_device = VK_NULL_HANDLE;
             VkDevice device = VK_NULL_HANDLE;
             std::uint32_t api_version = VK_API_VERSION_1_3;
+            bool memory_budget = false;  // VK_EXT_memory_budget is enabled on the device
         };
 
         explicit TransientAllocator(const Config &config);
@@ -84,13 +85,13 @@ namespace batleth {
         ) -> PhysicalBuffer;
 
         /**
-     * Free an image resource.
+     * Free an image resource and stop tracking it, so release_all() won't free it again.
      * Typically called at end of frame or when graph is recompiled.
      */
         auto free_image(PhysicalImage &image) -> void;
 
         /**
-     * Free a buffer resource.
+     * Free a buffer resource and stop tracking it, so release_all() won't free it again.
      * Typically called at end of frame or when graph is recompiled.
      */
         auto free_buffer(PhysicalBuffer &buffer) -> void;
@@ -49,6 +49,25 @@ namespace batleth {
             return;
         }
 
+        auto dependency_info = build_dependency_info();
+        ::vkCmdPipelineBarrier2(cmd, &dependency_info);
+
+        clear();
+    }
+
+    auto BarrierBatcher::signal_event(VkCommandBuffer cmd, VkEvent event) -> void {
+        auto dependency_info = build_dependency_info();
+        ::vkCmdSetEvent2(cmd, event, &dependency_info);
+        clear();
+    }
+
+    auto BarrierBatcher::wait_event(VkCommandBuffer cmd, VkEvent event) -> void {
+        auto dependency_info = build_dependency_info();
+        ::vkCmdWaitEvents2(cmd, 1, &event, &dependency_info);
+        clear();
+    }
+
+    auto BarrierBatcher::build_dependency_info() const -> VkDependencyInfo {
         VkDependencyInfo dependency_info{};
         dependency_info.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
         dependency_info.pNext = nullptr;
@@ -63,9 +82,7 @@ namespace batleth {
         dependency_info.imageMemoryBarrierCount = static_cast<std::uint32_t>(m_image_barriers.size());
         dependency_info.pImageMemoryBarriers = m_image_barriers.empty() ? nullptr : m_image_barriers.data();
 
-        ::vkCmdPipelineBarrier2(cmd, &dependency_info);
-
-        clear();
+        return dependency_info;
     }
 
     auto BarrierBatcher::clear() -> void {
@@ -156,10 +173,8 @@ namespace batleth {
         const ResourceState &before,
         const ResourceState &after
     ) -> bool {
-        // No barrier needed if states are identical
-        if (before == after) {
-            return false;
-        }
+        // Identical states still need a barrier when they write (WAW between passes),
+        // so equality alone isn't enough to skip one.
 
         // Barrier needed for layout transitions
         if (before.layout != after.layout) {
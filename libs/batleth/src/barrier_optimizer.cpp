@@ -0,0 +1,239 @@
+#include "batleth/barrier_optimizer.hpp"
+#include "batleth/barrier_batcher.hpp"
+#include "batleth/subresource_tracker.hpp"
+#include "federation/small_vector.hpp"
+
+#include <algorithm>
+
+namespace batleth {
+    namespace {
+        constexpr std::uint32_t NO_PASS = ~0u;
+
+        // Grow [base, base + count) by [other_base, other_base + other_count) if the two are adjacent
+        auto try_extend(std::uint32_t &base, std::uint32_t &count,
+                        std::uint32_t other_base, std::uint32_t other_count, std::uint32_t remaining) -> bool {
+            auto joined_count = [remaining](std::uint32_t first, std::uint32_t second) {
+                return second == remaining ? remaining : first + second;
+            };
+
+            if (count != remaining && base + count == other_base) {
+                count = joined_count(count, other_count);
+                return true;
+            }
+            if (other_count != remaining && other_base + other_count == base) {
+                count = joined_count(other_count, count);
+                base = other_base;
+                return true;
+            }
+            return false;
+        }
+
+        auto try_merge(PassBarrier &into, const PassBarrier &other) -> bool {
+            if (into.resource != other.resource || into.before != other.before || into.after != other.after ||
+                into.is_release != other.is_release || into.is_acquire != other.is_acquire) {
+                return false;
+            }
+
+            auto &a = into.range;
+            const auto &b = other.range;
+            if (a.base_mip == b.base_mip && a.mip_count == b.mip_count) {
+                return try_extend(a.base_layer, a.layer_count, b.base_layer, b.layer_count,
+                                  VK_REMAINING_ARRAY_LAYERS);
+            }
+            if (a.base_layer == b.base_layer && a.layer_count == b.layer_count) {
+                return try_extend(a.base_mip, a.mip_count, b.base_mip, b.mip_count, VK_REMAINING_MIP_LEVELS);
+            }
+            return false;
+        }
+
+        // Combine two requirements of the same pass on the same resource. Access scopes are
+        // unioned; a later requirement's layout wins since attachments and writes are listed last.
+        auto combine(ResourceState &into, const ResourceState &other) -> void {
+            into.stage_mask |= other.stage_mask;
+            into.access_mask |= other.access_mask;
+            if (other.layout != VK_IMAGE_LAYOUT_UNDEFINED) {
+                into.layout = other.layout;
+            }
+            if (other.queue_family != VK_QUEUE_FAMILY_IGNORED) {
+                into.queue_family = other.queue_family;
+            }
+        }
+
+        struct PendingSplit {
+            std::uint32_t signal_pass;
+            std::uint32_t wait_pass;
+            PassBarrier barrier;
+        };
+    }
+
+    auto merge_subresource_ranges(
+        std::vector<PassBarrier> &barriers,
+        std::size_t first
+    ) -> std::uint32_t {
+        std::uint32_t merged = 0;
+
+        for (std::size_t i = first; i < barriers.size(); ++i) {
+            for (std::size_t j = i + 1; j < barriers.size();) {
+                if (try_merge(barriers[i], barriers[j])) {
+                    barriers.erase(barriers.begin() + static_cast<std::ptrdiff_t>(j));
+                    ++merged;
+                    // The grown range may now touch a barrier that was skipped earlier
+                    j = i + 1;
+                } else {
+                    ++j;
+                }
+            }
+        }
+
+        return merged;
+    }
+
+    auto optimize_barriers(
+        const BarrierOptimizerInput &input,
+        const BarrierOptimizerConfig &config
+    ) -> OptimizedBarriers {
+        OptimizedBarriers result{};
+
+        const std::size_t resource_count = input.initial_states.size();
+        const std::uint32_t pass_count = input.requirement_offsets.empty()
+                                             ? 0
+                                             : static_cast<std::uint32_t>(input.requirement_offsets.size() - 1);
+
+        // Every resource is tracked per subresource so mip/layer-ranged accesses only barrier what they touch
+        std::vector<SubresourceStateTracker> states;
+        states.reserve(resource_count);
+        for (std::size_t handle = 0; handle < resource_count; ++handle) {
+            const SubresourceRange extent = handle < input.subresource_extents.size()
+                                                ? input.subresource_extents[handle]
+                                                : SubresourceRange{.mip_count = 1, .layer_count = 1};
+            states.emplace_back(extent.mip_count, extent.layer_count, input.initial_states[handle]);
+        }
+
+        std::vector<std::uint32_t> last_access(resource_count, NO_PASS);
+        std::vector<PendingSplit> pending_splits;
+        std::vector<PassBarrier> emitted;
+
+        result.pass_offsets.assign(pass_count + 1, 0);
+
+        federation::SmallVector<StateRequirement, 16> pass_requirements;
+
+        for (std::uint32_t pass = 0; pass < pass_count; ++pass) {
+            const std::size_t pass_first = result.barriers.size();
+            result.pass_offsets[pass] = static_cast<std::uint32_t>(pass_first);
+
+            // Combine requirements on the same subresources (e.g. a depth attachment that is also read)
+            pass_requirements.clear();
+            for (std::uint32_t r = input.requirement_offsets[pass]; r < input.requirement_offsets[pass + 1]; ++r) {
+                const auto &requirement = input.requirements[r];
+                if (requirement.resource >= resource_count) continue;
+
+                auto it = std::find_if(pass_requirements.begin(), pass_requirements.end(),
+                                       [&requirement](const StateRequirement &existing) {
+                                           return existing.resource == requirement.resource &&
+                                                  existing.range == requirement.range;
+                                       });
+                if (it != pass_requirements.end()) {
+                    combine(it->state, requirement.state);
+                } else {
+                    pass_requirements.push_back(requirement);
+                }
+            }
+            result.stats.requested += static_cast<std::uint32_t>(pass_requirements.size());
+
+            for (const auto &requirement: pass_requirements) {
+                const ResourceHandle handle = requirement.resource;
+                const std::uint32_t producer = last_access[handle];
+                last_access[handle] = pass;
+
+                // Read-after-read subresources emit nothing; the tracker widens their scope so
+                // the next writer waits on all readers
+                emitted.clear();
+                if (states[handle].transition(requirement.range, requirement.state, emitted, handle) == 0) {
+                    ++result.stats.eliminated;
+                    continue;
+                }
+
+                for (const auto &barrier: emitted) {
+                    if (config.enable_split_barriers && producer != NO_PASS &&
+                        pass - producer >= config.split_distance && !needs_queue_transfer(barrier.before, barrier.after)) {
+                        pending_splits.push_back({producer, pass, barrier});
+                    } else {
+                        result.barriers.push_back(barrier);
+                    }
+                }
+            }
+
+            result.stats.merged += merge_subresource_ranges(result.barriers, pass_first);
+            if (result.barriers.size() > pass_first) {
+                ++result.stats.batches;
+            }
+        }
+        result.pass_offsets[pass_count] = static_cast<std::uint32_t>(result.barriers.size());
+
+        // Group split barriers by (wait, signal) pass pair, one event per group
+        std::stable_sort(pending_splits.begin(), pending_splits.end(),
+                         [](const PendingSplit &a, const PendingSplit &b) {
+                             return a.wait_pass != b.wait_pass
+                                        ? a.wait_pass < b.wait_pass
+                                        : a.signal_pass < b.signal_pass;
+                         });
+
+        result.split_wait_offsets.assign(pass_count + 1, 0);
+        for (std::size_t i = 0; i < pending_splits.size();) {
+            const auto &head = pending_splits[i];
+            const std::size_t group_first = result.split_barriers.size();
+
+            std::size_t j = i;
+            for (; j < pending_splits.size() && pending_splits[j].wait_pass == head.wait_pass &&
+                   pending_splits[j].signal_pass == head.signal_pass; ++j) {
+                result.split_barriers.push_back(pending_splits[j].barrier);
+            }
+            result.stats.merged += merge_subresource_ranges(result.split_barriers, group_first);
+
+            result.split_groups.push_back({
+                .signal_pass = head.signal_pass,
+                .wait_pass = head.wait_pass,
+                .first_barrier = static_cast<std::uint32_t>(group_first),
+                .barrier_count = static_cast<std::uint32_t>(result.split_barriers.size() - group_first)
+            });
+            ++result.split_wait_offsets[head.wait_pass + 1];
+            i = j;
+        }
+        for (std::uint32_t pass = 0; pass < pass_count; ++pass) {
+            result.split_wait_offsets[pass + 1] += result.split_wait_offsets[pass];
+        }
+
+        result.split_signal_order.resize(result.split_groups.size());
+        for (std::uint32_t g = 0; g < result.split_groups.size(); ++g) {
+            result.split_signal_order[g] = g;
+        }
+        std::stable_sort(result.split_signal_order.begin(), result.split_signal_order.end(),
+                         [&result](std::uint32_t a, std::uint32_t b) {
+                             return result.split_groups[a].signal_pass < result.split_groups[b].signal_pass;
+                         });
+        result.split_signal_offsets.assign(pass_count + 1, 0);
+        for (const auto &group: result.split_groups) {
+            ++result.split_signal_offsets[group.signal_pass + 1];
+        }
+        for (std::uint32_t pass = 0; pass < pass_count; ++pass) {
+            result.split_signal_offsets[pass + 1] += result.split_signal_offsets[pass];
+        }
+
+        // Transition resources to their final states
+        for (const auto &requirement: input.final_requirements) {
+            if (requirement.resource >= resource_count) continue;
+            states[requirement.resource].transition(requirement.range, requirement.state, result.final_barriers,
+                                                    requirement.resource);
+        }
+        result.stats.merged += merge_subresource_ranges(result.final_barriers);
+        if (!result.final_barriers.empty()) {
+            ++result.stats.batches;
+        }
+
+        result.stats.split = static_cast<std::uint32_t>(result.split_barriers.size());
+        result.stats.emitted = static_cast<std::uint32_t>(
+            result.barriers.size() + result.split_barriers.size() + result.final_barriers.size());
+
+        return result;
+    }
+} // namespace batleth
@@ -10,7 +10,8 @@ namespace batleth {
         uint32_t binding,
         VkDescriptorType descriptor_type,
         VkShaderStageFlags stage_flags,
-        uint32_t count) -> DescriptorSetLayout::Builder & {
+        uint32_t count,
+        VkDescriptorBindingFlags binding_flags) -> DescriptorSetLayout::Builder & {
         assert(m_bindings.count(binding) == 0 && "Binding already in use");
         VkDescriptorSetLayoutBinding layout_binding{};
         layout_binding.binding = binding;
@@ -18,27 +19,49 @@ namespace batleth {
         layout_binding.descriptorCount = count;
         layout_binding.stageFlags = stage_flags;
         m_bindings[binding] = layout_binding;
+        if (binding_flags != 0) {
+            m_binding_flags[binding] = binding_flags;
+        }
         return *this;
     }
 
     auto DescriptorSetLayout::Builder::build() const -> std::unique_ptr<DescriptorSetLayout> {
-        return std::make_unique<DescriptorSetLayout>(m_device, m_bindings);
+        return std::make_unique<DescriptorSetLayout>(m_device, m_bindings, m_binding_flags);
     }
 
     // *************** Descriptor Set Layout *********************
 
     DescriptorSetLayout::DescriptorSetLayout(
-        VkDevice device, std::unordered_map<uint32_t, VkDescriptorSetLayoutBinding> bindings)
+        VkDevice device, std::unordered_map<uint32_t, VkDescriptorSetLayoutBinding> bindings,
+        const std::unordered_map<uint32_t, VkDescriptorBindingFlags> &binding_flags)
         : m_device{device}, m_bindings{bindings} {
         std::vector<VkDescriptorSetLayoutBinding> set_layout_bindings{};
+        std::vector<VkDescriptorBindingFlags> set_binding_flags{};  // Parallel to set_layout_bindings
+        bool update_after_bind = false;
         for (auto kv: bindings) {
             set_layout_bindings.push_back(kv.second);
+
+            auto it = binding_flags.find(kv.first);
+            const VkDescriptorBindingFlags flags = it != binding_flags.end() ? it->second : 0;
+            set_binding_flags.push_back(flags);
+            update_after_bind |= (flags & VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT) != 0;
         }
 
+        VkDescriptorSetLayoutBindingFlagsCreateInfo binding_flags_info{};
+        binding_flags_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+        binding_flags_info.bindingCount = static_cast<uint32_t>(set_binding_flags.size());
+        binding_flags_info.pBindingFlags = set_binding_flags.data();
+
         VkDescriptorSetLayoutCreateInfo descriptor_set_layout_info{};
         descriptor_set_layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
         descriptor_set_layout_info.bindingCount = static_cast<uint32_t>(set_layout_bindings.size());
         descriptor_set_layout_info.pBindings = set_layout_bindings.data();
+        if (!binding_flags.empty()) {
+            descriptor_set_layout_info.pNext = &binding_flags_info;
+        }
+        if (update_after_bind) {
+            descriptor_set_layout_info.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+        }
 
         if (::vkCreateDescriptorSetLayout(m_device, &descriptor_set_layout_info, nullptr, &m_layout) != VK_SUCCESS) {
             FED_ERROR("Failed to create descriptor set layout");
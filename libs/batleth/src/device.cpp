@@ -1,4 +1,5 @@
 #include "batleth/device.hpp"
+#include <algorithm>
 #include <stdexcept>
 #include <set>
 #include <cstring>
@@ -30,9 +31,14 @@ namespace batleth {
             queue_create_infos.push_back(queue_create_info);
         }
 
-        // enable sampler anisotropy
+        VkPhysicalDeviceFeatures supported_features{};
+        ::vkGetPhysicalDeviceFeatures(m_physical_device, &supported_features);
+
+        // enable sampler anisotropy, and BC texture compression where available
         VkPhysicalDeviceFeatures vulkan10_features{};
         vulkan10_features.samplerAnisotropy = VK_TRUE;
+        vulkan10_features.textureCompressionBC = supported_features.textureCompressionBC;
+        m_texture_compression_bc = supported_features.textureCompressionBC == VK_TRUE;
 
         // Enable Vulkan 1.2 descriptor indexing features (for bindless textures)
         VkPhysicalDeviceDescriptorIndexingFeatures descriptor_indexing_features{};
@@ -42,6 +48,14 @@ namespace batleth {
         descriptor_indexing_features.descriptorBindingVariableDescriptorCount = VK_TRUE;
         descriptor_indexing_features.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
         descriptor_indexing_features.shaderStorageBufferArrayNonUniformIndexing = VK_TRUE;
+        descriptor_indexing_features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+        descriptor_indexing_features.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+
+        // Vulkan 1.2 timeline semaphores (frame pacing)
+        VkPhysicalDeviceTimelineSemaphoreFeatures timeline_semaphore_features{};
+        timeline_semaphore_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+        timeline_semaphore_features.timelineSemaphore = VK_TRUE;
+        descriptor_indexing_features.pNext = &timeline_semaphore_features;
 
         // Enable Vulkan 1.3 features (includes dynamic rendering)
         VkPhysicalDeviceVulkan13Features vulkan13_features{};
@@ -55,14 +69,27 @@ namespace batleth {
         device_features.features = vulkan10_features;
         device_features.pNext = &vulkan13_features;
 
+        // Opt into VK_EXT_memory_budget when present so VMA reports real per-heap budgets
+        std::vector<const char *> device_extensions = config.device_extensions;
+        if (supports_extension(m_physical_device, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME)) {
+            const bool requested = std::any_of(device_extensions.begin(), device_extensions.end(),
+                                               [](const char *name) {
+                                                   return std::strcmp(name, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME) == 0;
+                                               });
+            if (!requested) {
+                device_extensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+            }
+            m_memory_budget_enabled = true;
+        }
+
         VkDeviceCreateInfo create_info{};
         create_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
         create_info.pNext = &device_features;
         create_info.queueCreateInfoCount = static_cast<std::uint32_t>(queue_create_infos.size());
         create_info.pQueueCreateInfos = queue_create_infos.data();
         create_info.pEnabledFeatures = nullptr; // Use pNext chain instead
-        create_info.enabledExtensionCount = static_cast<std::uint32_t>(config.device_extensions.size());
-        create_info.ppEnabledExtensionNames = config.device_extensions.data();
+        create_info.enabledExtensionCount = static_cast<std::uint32_t>(device_extensions.size());
+        create_info.ppEnabledExtensionNames = device_extensions.data();
 
         if (::vkCreateDevice(m_physical_device, &create_info, nullptr, &m_device) != VK_SUCCESS) {
             throw std::runtime_error("Failed to create logical device");
@@ -100,7 +127,9 @@ namespace batleth {
           , m_present_queue(other.m_present_queue)
           , m_command_pool(other.m_command_pool)
           , m_indices(other.m_indices)
-          , m_owns_command_pool(other.m_owns_command_pool) {
+          , m_owns_command_pool(other.m_owns_command_pool)
+          , m_memory_budget_enabled(other.m_memory_budget_enabled)
+          , m_texture_compression_bc(other.m_texture_compression_bc) {
         other.m_instance = VK_NULL_HANDLE;
         other.m_surface = VK_NULL_HANDLE;
         other.m_physical_device = VK_NULL_HANDLE;
@@ -126,6 +155,8 @@ namespace batleth {
             m_command_pool = other.m_command_pool;
             m_indices = other.m_indices;
             m_owns_command_pool = other.m_owns_command_pool;
+            m_memory_budget_enabled = other.m_memory_budget_enabled;
+            m_texture_compression_bc = other.m_texture_compression_bc;
 
             other.m_instance = VK_NULL_HANDLE;
             other.m_surface = VK_NULL_HANDLE;
@@ -145,6 +176,28 @@ namespace batleth {
         }
     }
 
+    auto Device::supports_format(VkFormat format, VkFormatFeatureFlags features) const -> bool {
+        const bool bc_format = format >= VK_FORMAT_BC1_RGB_UNORM_BLOCK && format <= VK_FORMAT_BC7_SRGB_BLOCK;
+        if (bc_format && !m_texture_compression_bc) {
+            return false;
+        }
+
+        VkFormatProperties properties{};
+        ::vkGetPhysicalDeviceFormatProperties(m_physical_device, format, &properties);
+        return (properties.optimalTilingFeatures & features) == features;
+    }
+
+    auto Device::supports_extension(VkPhysicalDevice device, const char *extension) -> bool {
+        std::uint32_t extension_count = 0;
+        ::vkEnumerateDeviceExtensionProperties(device, nullptr, &extension_count, nullptr);
+        std::vector<VkExtensionProperties> extensions(extension_count);
+        ::vkEnumerateDeviceExtensionProperties(device, nullptr, &extension_count, extensions.data());
+
+        return std::any_of(extensions.begin(), extensions.end(), [extension](const VkExtensionProperties &properties) {
+            return std::strcmp(properties.extensionName, extension) == 0;
+        });
+    }
+
     auto Device::pick_physical_device(VkInstance instance, VkSurfaceKHR surface) -> void {
         std::uint32_t device_count = 0;
         ::vkEnumeratePhysicalDevices(instance, &device_count, nullptr);
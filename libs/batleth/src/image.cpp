@@ -1,4 +1,5 @@
 #include "batleth/image.hpp"
+#include "batleth/barrier_batcher.hpp"
 #include "federation/log.hpp"
 
 namespace batleth {
@@ -11,7 +12,8 @@ Image::Image(const Config& config)
     , m_width(config.width)
     , m_height(config.height)
     , m_mip_levels(config.mip_levels)
-    , m_array_layers(config.array_layers) {
+    , m_array_layers(config.array_layers)
+    , m_state_tracker(config.mip_levels, config.array_layers, {.layout = config.initial_layout}) {
 
     // Create VkImage
     VkImageCreateInfo image_info{};
@@ -88,7 +90,8 @@ Image::Image(Image&& other) noexcept
     , m_width(other.m_width)
     , m_height(other.m_height)
     , m_mip_levels(other.m_mip_levels)
-    , m_array_layers(other.m_array_layers) {
+    , m_array_layers(other.m_array_layers)
+    , m_state_tracker(std::move(other.m_state_tracker)) {
 
     // Clear moved-from object
     other.m_device = VK_NULL_HANDLE;
@@ -120,6 +123,7 @@ auto Image::operator=(Image&& other) noexcept -> Image& {
         m_height = other.m_height;
         m_mip_levels = other.m_mip_levels;
         m_array_layers = other.m_array_layers;
+        m_state_tracker = std::move(other.m_state_tracker);
 
         // Clear moved-from object
         other.m_device = VK_NULL_HANDLE;
@@ -131,6 +135,44 @@ auto Image::operator=(Image&& other) noexcept -> Image& {
     return *this;
 }
 
+auto Image::transition(
+    VkCommandBuffer cmd,
+    const ResourceState& state,
+    const SubresourceRange& range
+) -> uint32_t {
+    BarrierBatcher batcher;
+    const uint32_t count = transition(batcher, state, range);
+    if (count > 0) {
+        batcher.flush(cmd);
+    }
+
+    return count;
+}
+
+auto Image::transition(
+    BarrierBatcher& batcher,
+    const ResourceState& state,
+    const SubresourceRange& range
+) -> uint32_t {
+    std::vector<PassBarrier> barriers;
+    const uint32_t count = m_state_tracker.transition(range, state, barriers);
+
+    for (const auto& barrier : barriers) {
+        batcher.add_image_barrier(
+            m_image,
+            barrier.before,
+            barrier.after,
+            m_aspect_flags,
+            barrier.range.base_mip,
+            barrier.range.mip_count,
+            barrier.range.base_layer,
+            barrier.range.layer_count
+        );
+    }
+
+    return count;
+}
+
 auto Image::transition_layout(
     VkCommandBuffer cmd,
     VkImageLayout old_layout,
@@ -138,56 +180,36 @@ auto Image::transition_layout(
     uint32_t base_mip,
     uint32_t mip_count
 ) -> void {
-    VkImageMemoryBarrier barrier{};
-    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    barrier.oldLayout = old_layout;
-    barrier.newLayout = new_layout;
-    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.image = m_image;
-    barrier.subresourceRange.aspectMask = m_aspect_flags;
-    barrier.subresourceRange.baseMipLevel = base_mip;
-    barrier.subresourceRange.levelCount = mip_count;
-    barrier.subresourceRange.baseArrayLayer = 0;
-    barrier.subresourceRange.layerCount = m_array_layers;
-
-    // Determine pipeline stages and access masks based on layouts
-    VkPipelineStageFlags source_stage;
-    VkPipelineStageFlags dest_stage;
-
-    if (old_layout == VK_IMAGE_LAYOUT_UNDEFINED && new_layout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) {
-        barrier.srcAccessMask = 0;
-        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        source_stage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-        dest_stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-    } else if (old_layout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL && new_layout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) {
-        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-        source_stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-        dest_stage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-    } else if (old_layout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL && new_layout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) {
-        barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-        source_stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-        dest_stage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-    } else if (old_layout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL && new_layout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL) {
-        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-        source_stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-        dest_stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    ResourceState state{.layout = new_layout};
+
+    if (new_layout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) {
+        state.stage_mask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+        state.access_mask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    } else if (new_layout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL) {
+        state.stage_mask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+        state.access_mask = VK_ACCESS_2_TRANSFER_READ_BIT;
+    } else if (new_layout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) {
+        state.stage_mask = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
+        state.access_mask = VK_ACCESS_2_SHADER_READ_BIT;
     } else {
         FED_ERROR("Unsupported layout transition: {} -> {}", static_cast<int>(old_layout), static_cast<int>(new_layout));
         throw std::runtime_error("Unsupported layout transition");
     }
 
-    ::vkCmdPipelineBarrier(
-        cmd,
-        source_stage, dest_stage,
-        0,
-        0, nullptr,
-        0, nullptr,
-        1, &barrier
-    );
+    const SubresourceRange range{
+        .base_mip = base_mip,
+        .mip_count = mip_count,
+        .base_layer = 0,
+        .layer_count = m_array_layers
+    };
+
+    const auto& current = m_state_tracker.get_state(base_mip);
+    if (old_layout != VK_IMAGE_LAYOUT_UNDEFINED && current.layout != old_layout) {
+        FED_WARN("Layout transition expected {} but mip {} is tracked as {}",
+                 static_cast<int>(old_layout), base_mip, static_cast<int>(current.layout));
+    }
+
+    transition(cmd, state, range);
 }
 
 } // namespace batleth
@@ -1,5 +1,6 @@
 #include "batleth/image_utils.hpp"
 #include "batleth/device.hpp"
+#include "batleth/image.hpp"
 #include "federation/log.hpp"
 #include <cmath>
 #include <stdexcept>
@@ -14,12 +15,13 @@ auto calculate_mip_levels(uint32_t width, uint32_t height) -> uint32_t {
 auto generate_mipmaps(
     Device& device,
     VkCommandBuffer cmd,
-    VkImage image,
-    VkFormat format,
-    uint32_t width,
-    uint32_t height,
-    uint32_t mip_levels
+    Image& image
 ) -> void {
+    const VkFormat format = image.get_format();
+    const uint32_t mip_levels = image.get_mip_levels();
+    const uint32_t layer_count = image.get_array_layers();
+    const VkExtent2D extent = image.get_extent();
+
     // Check if format supports linear blitting
     VkFormatProperties format_properties;
     ::vkGetPhysicalDeviceFormatProperties(device.get_physical_device(), format, &format_properties);
@@ -29,35 +31,25 @@ auto generate_mipmaps(
         throw std::runtime_error("Format does not support linear blitting");
     }
 
-    FED_TRACE("Generating {} mip levels for {}x{} texture", mip_levels, width, height);
+    FED_TRACE("Generating {} mip levels for {}x{} texture", mip_levels, extent.width, extent.height);
 
-    VkImageMemoryBarrier barrier{};
-    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    barrier.image = image;
-    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    barrier.subresourceRange.baseArrayLayer = 0;
-    barrier.subresourceRange.layerCount = 1;
-    barrier.subresourceRange.levelCount = 1;
+    const ResourceState transfer_src{
+        .stage_mask = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+        .access_mask = VK_ACCESS_2_TRANSFER_READ_BIT,
+        .layout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+    };
+    const ResourceState shader_read{
+        .stage_mask = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+        .access_mask = VK_ACCESS_2_SHADER_READ_BIT,
+        .layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+    };
 
-    int32_t mip_width = static_cast<int32_t>(width);
-    int32_t mip_height = static_cast<int32_t>(height);
+    int32_t mip_width = static_cast<int32_t>(extent.width);
+    int32_t mip_height = static_cast<int32_t>(extent.height);
 
     for (uint32_t i = 1; i < mip_levels; i++) {
-        // Transition previous mip level to TRANSFER_SRC for blitting
-        barrier.subresourceRange.baseMipLevel = i - 1;
-        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-
-        ::vkCmdPipelineBarrier(cmd,
-            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
-            0, nullptr,
-            0, nullptr,
-            1, &barrier
-        );
+        // Only the previous mip moves to TRANSFER_SRC; the rest of the chain is left alone
+        image.transition(cmd, transfer_src, {.base_mip = i - 1, .mip_count = 1});
 
         // Blit from previous mip level to current mip level
         VkImageBlit blit{};
@@ -66,7 +58,7 @@ auto generate_mipmaps(
         blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
         blit.srcSubresource.mipLevel = i - 1;
         blit.srcSubresource.baseArrayLayer = 0;
-        blit.srcSubresource.layerCount = 1;
+        blit.srcSubresource.layerCount = layer_count;
 
         blit.dstOffsets[0] = {0, 0, 0};
         blit.dstOffsets[1] = {mip_width > 1 ? mip_width / 2 : 1,
@@ -75,46 +67,22 @@ auto generate_mipmaps(
         blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
         blit.dstSubresource.mipLevel = i;
         blit.dstSubresource.baseArrayLayer = 0;
-        blit.dstSubresource.layerCount = 1;
+        blit.dstSubresource.layerCount = layer_count;
 
         ::vkCmdBlitImage(cmd,
-            image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-            image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            image.get_image(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            image.get_image(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
             1, &blit,
             VK_FILTER_LINEAR
         );
 
-        // Transition previous mip level to SHADER_READ_ONLY
-        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-        barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-        ::vkCmdPipelineBarrier(cmd,
-            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
-            0, nullptr,
-            0, nullptr,
-            1, &barrier
-        );
-
         // Calculate next mip dimensions
         if (mip_width > 1) mip_width /= 2;
         if (mip_height > 1) mip_height /= 2;
     }
 
-    // Transition last mip level to SHADER_READ_ONLY
-    barrier.subresourceRange.baseMipLevel = mip_levels - 1;
-    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-    barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-    ::vkCmdPipelineBarrier(cmd,
-        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
-        0, nullptr,
-        0, nullptr,
-        1, &barrier
-    );
+    // Mips 0..n-2 are TRANSFER_SRC and the last is TRANSFER_DST: two barriers in one batch
+    image.transition(cmd, shader_read);
 
     FED_TRACE("Finished generating mipmaps");
 }
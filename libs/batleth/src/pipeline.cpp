@@ -1,9 +1,10 @@
 #include "batleth/pipeline.hpp"
 #include "batleth/shader.hpp"
 #include "federation/log.hpp"
+#include "federation/storage/virtual_file_system.hpp"
 #include <stdexcept>
-#include <fstream>
 #include <array>
+#include <cstring>
 
 namespace batleth {
     Pipeline::Pipeline(const Config &config) : m_device(config.device), m_config(config) {
@@ -88,19 +89,15 @@ namespace batleth {
     auto Pipeline::load_shader_from_file(const std::string &filepath) -> std::vector<std::uint32_t> {
         FED_DEBUG("Loading shader from file: {}", filepath);
 
-        std::ifstream file(filepath, std::ios::ate | std::ios::binary);
-
-        if (!file.is_open()) {
+        auto file = federation::VirtualFileSystem::get().read(filepath);
+        if (!file) {
             FED_ERROR("Failed to open shader file: {}", filepath);
             throw std::runtime_error("Failed to open shader file: " + filepath);
         }
 
-        auto file_size = static_cast<std::size_t>(file.tellg());
-        std::vector<std::uint32_t> buffer(file_size / sizeof(std::uint32_t));
-
-        file.seekg(0);
-        file.read(reinterpret_cast<char *>(buffer.data()), file_size);
-        file.close();
+        const auto bytes = file->get_data();
+        std::vector<std::uint32_t> buffer(bytes.size() / sizeof(std::uint32_t));
+        std::memcpy(buffer.data(), bytes.data(), buffer.size() * sizeof(std::uint32_t));
 
         return buffer;
     }
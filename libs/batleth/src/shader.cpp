@@ -1,7 +1,7 @@
 #include "batleth/shader.hpp"
 #include "batleth/shader_compiler.hpp"
 #include "federation/log.hpp"
-#include <fstream>
+#include "federation/storage/virtual_file_system.hpp"
 #include <stdexcept>
 #include <cstring>
 
@@ -11,7 +11,8 @@ namespace batleth {
           , m_filepath(config.filepath)
           , m_stage(config.stage)
           , m_hot_reload_enabled(config.enable_hot_reload) {
-        if (!std::filesystem::exists(m_filepath)) {
+        auto info = federation::VirtualFileSystem::get().stat(m_filepath.generic_string());
+        if (!info) {
             throw std::runtime_error("Shader file does not exist: " + m_filepath.string());
         }
 
@@ -20,7 +21,7 @@ namespace batleth {
         create_shader_module(code);
 
         // Store the last write time for hot-reload detection
-        m_last_write_time = std::filesystem::last_write_time(m_filepath);
+        m_last_write_time = info->mtime;
 
         FED_INFO("Loaded shader: {}", m_filepath.string());
     }
@@ -83,7 +84,9 @@ namespace batleth {
 
             // Replace with new module
             m_shader_module = new_module;
-            m_last_write_time = std::filesystem::last_write_time(m_filepath);
+            if (auto info = federation::VirtualFileSystem::get().stat(m_filepath.generic_string())) {
+                m_last_write_time = info->mtime;
+            }
 
             FED_INFO("Successfully reloaded shader: {}", m_filepath.string());
 
@@ -104,12 +107,13 @@ namespace batleth {
             return false;
         }
 
-        if (!std::filesystem::exists(m_filepath)) {
+        // Packed shaders report no mtime and never reload; loose overrides mounted later still do
+        auto info = federation::VirtualFileSystem::get().stat(m_filepath.generic_string());
+        if (!info) {
             return false;
         }
 
-        auto current_write_time = std::filesystem::last_write_time(m_filepath);
-        if (current_write_time > m_last_write_time) {
+        if (info->mtime > m_last_write_time) {
             return reload();
         }
 
@@ -125,6 +129,17 @@ namespace batleth {
                         extension == ".tesc" || extension == ".tese" ||
                         extension == ".glsl");
 
+        auto& vfs = federation::VirtualFileSystem::get();
+        auto spirv_path = m_filepath.generic_string();
+        if (is_glsl) {
+            // Prefer SPIR-V from the offline cooker while it's current; edits compile from source
+            if (auto cooked = vfs.get_cooked_path(spirv_path)) {
+                FED_DEBUG("Using cooked shader {} for {}", *cooked, spirv_path);
+                spirv_path = *cooked;
+                is_glsl = false;
+            }
+        }
+
         if (is_glsl) {
             // Compile GLSL to SPIR-V
             ShaderCompiler compiler;
@@ -148,20 +163,14 @@ namespace batleth {
         }
 
         // Load pre-compiled SPIR-V
-        std::ifstream file(m_filepath, std::ios::ate | std::ios::binary);
-
-        if (!file.is_open()) {
-            throw std::runtime_error("Failed to open shader file: " + m_filepath.string());
+        auto file = vfs.read(spirv_path);
+        if (!file) {
+            throw std::runtime_error("Failed to open shader file: " + spirv_path);
         }
 
-        auto file_size = static_cast<std::size_t>(file.tellg());
-        std::vector<char> buffer(file_size);
-
-        file.seekg(0);
-        file.read(buffer.data(), static_cast<std::streamsize>(file_size));
-        file.close();
-
-        return buffer;
+        const auto bytes = file->get_data();
+        const auto* first = reinterpret_cast<const char *>(bytes.data());
+        return std::vector<char>(first, first + bytes.size());
     }
 
     auto Shader::create_shader_module(const std::vector<char> &code) -> void {
@@ -1,5 +1,6 @@
 #include "batleth/shader_cache.hpp"
 #include "federation/log.hpp"
+#include "federation/storage/virtual_file_system.hpp"
 #include <fstream>
 #include <sstream>
 #include <iomanip>
@@ -7,7 +8,7 @@
 namespace batleth {
     namespace {
         // Simple hash function for file contents
-        auto hash_bytes(const std::string &data) -> std::uint64_t {
+        auto hash_bytes(std::string_view data) -> std::uint64_t {
             std::uint64_t hash = 0xcbf29ce484222325ULL; // FNV-1a offset basis
             const std::uint64_t prime = 0x100000001b3ULL; // FNV-1a prime
 
@@ -19,6 +20,15 @@ namespace batleth {
             return hash;
         }
 
+        // Source modification time as seen through the VFS (epoch for packed sources)
+        auto source_write_time(const std::filesystem::path &source_path) -> std::optional<std::filesystem::file_time_type> {
+            auto info = federation::VirtualFileSystem::get().stat(source_path.generic_string());
+            if (!info) {
+                return std::nullopt;
+            }
+            return std::filesystem::file_time_type(std::filesystem::file_time_type::duration(info->mtime));
+        }
+
         // Cache file format version
         constexpr std::uint32_t CACHE_VERSION = 1;
         constexpr std::uint32_t CACHE_MAGIC = 0x53505652; // "SPVR" (SPIR-V Cache)
@@ -43,7 +53,7 @@ namespace batleth {
     }
 
     auto ShaderCache::lookup(const std::filesystem::path &source_path) -> std::optional<std::vector<std::uint32_t> > {
-        if (!std::filesystem::exists(source_path)) {
+        if (!federation::VirtualFileSystem::get().exists(source_path.generic_string())) {
             return std::nullopt;
         }
 
@@ -70,7 +80,8 @@ namespace batleth {
 
     auto ShaderCache::store(const std::filesystem::path &source_path,
                             const std::vector<std::uint32_t> &spirv) -> void {
-        if (!std::filesystem::exists(source_path)) {
+        auto timestamp = source_write_time(source_path);
+        if (!timestamp) {
             FED_WARN("Cannot cache shader: source file does not exist: {}", source_path.string());
             return;
         }
@@ -78,7 +89,7 @@ namespace batleth {
         CacheEntry entry;
         entry.spirv = spirv;
         entry.source_hash = compute_source_hash(source_path);
-        entry.timestamp = std::filesystem::last_write_time(source_path);
+        entry.timestamp = *timestamp;
 
         auto cache_path = get_cache_path(source_path);
         save_cache_entry(cache_path, entry);
@@ -145,21 +156,19 @@ namespace batleth {
     }
 
     auto ShaderCache::compute_source_hash(const std::filesystem::path &source_path) -> std::uint64_t {
-        std::ifstream file(source_path, std::ios::binary);
-        if (!file.is_open()) {
+        auto file = federation::VirtualFileSystem::get().read(source_path.generic_string());
+        if (!file) {
             return 0;
         }
 
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        return hash_bytes(buffer.str());
+        return hash_bytes(file->as_string_view());
     }
 
     auto ShaderCache::is_cache_valid(const std::filesystem::path &source_path,
                                      const CacheEntry &entry) -> bool {
         // Check if source file has been modified
-        auto current_timestamp = std::filesystem::last_write_time(source_path);
-        if (current_timestamp > entry.timestamp) {
+        auto current_timestamp = source_write_time(source_path);
+        if (!current_timestamp || *current_timestamp > entry.timestamp) {
             FED_DEBUG("Cache invalid: source file modified");
             return false;
         }
@@ -1,11 +1,10 @@
 #include "batleth/shader_compiler.hpp"
 #include "batleth/shader_cache.hpp"
 #include "federation/log.hpp"
+#include "federation/storage/virtual_file_system.hpp"
 
 #include <glslang/Public/ShaderLang.h>
 #include <glslang/SPIRV/GlslangToSpv.h>
-#include <fstream>
-#include <sstream>
 
 namespace batleth {
     namespace {
@@ -243,17 +242,15 @@ namespace batleth {
         }
 
         // Read source file
-        std::ifstream file(filepath);
-        if (!file.is_open()) {
+        auto file = federation::VirtualFileSystem::get().read(filepath.generic_string());
+        if (!file) {
             result.success = false;
             result.error_message = "Failed to open file: " + filepath.string();
             FED_ERROR("{}", result.error_message);
             return result;
         }
 
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        std::string source = buffer.str();
+        std::string source(file->as_string_view());
 
         // Compile with filename for better error messages
         result = compile(source, filepath.string(), options);
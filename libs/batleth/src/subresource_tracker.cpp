@@ -0,0 +1,175 @@
+#include "batleth/subresource_tracker.hpp"
+#include "batleth/barrier_batcher.hpp"
+#include "batleth/barrier_optimizer.hpp"
+
+#include <algorithm>
+
+namespace batleth {
+    SubresourceStateTracker::SubresourceStateTracker(
+        std::uint32_t mip_levels,
+        std::uint32_t array_layers,
+        const ResourceState &initial_state
+    )
+        : m_mip_levels(std::max(mip_levels, 1u)),
+          m_array_layers(std::max(array_layers, 1u)) {
+        LayerRun layers{};
+        layers.base_layer = 0;
+        layers.layer_count = m_array_layers;
+        layers.mips.push_back({.base_mip = 0, .mip_count = m_mip_levels, .state = initial_state});
+        m_layers.push_back(std::move(layers));
+    }
+
+    auto SubresourceStateTracker::transition(
+        const SubresourceRange &range,
+        const ResourceState &state,
+        std::vector<PassBarrier> &out,
+        ResourceHandle resource
+    ) -> std::uint32_t {
+        const SubresourceRange resolved = resolve(range);
+        if (resolved.mip_count == 0 || resolved.layer_count == 0) {
+            return 0;
+        }
+
+        const std::uint32_t mip_end = resolved.base_mip + resolved.mip_count;
+        const std::uint32_t layer_end = resolved.base_layer + resolved.layer_count;
+        const std::size_t first = out.size();
+
+        split_layers_at(resolved.base_layer);
+        split_layers_at(layer_end);
+
+        for (auto &layers: m_layers) {
+            if (layers.base_layer < resolved.base_layer || layers.base_layer >= layer_end) continue;
+
+            split_mips_at(layers.mips, resolved.base_mip);
+            split_mips_at(layers.mips, mip_end);
+
+            for (auto &run: layers.mips) {
+                if (run.base_mip < resolved.base_mip || run.base_mip >= mip_end) continue;
+
+                if (needs_barrier(run.state, state)) {
+                    out.push_back({
+                        .resource = resource,
+                        .before = run.state,
+                        .after = state,
+                        .range = {
+                            .base_mip = run.base_mip,
+                            .mip_count = run.mip_count,
+                            .base_layer = layers.base_layer,
+                            .layer_count = layers.layer_count
+                        }
+                    });
+                    run.state = state;
+                } else {
+                    run.state.stage_mask |= state.stage_mask;
+                    run.state.access_mask |= state.access_mask;
+                }
+            }
+
+            coalesce_mips(layers.mips);
+        }
+
+        coalesce_layers();
+        merge_subresource_ranges(out, first);
+
+        return static_cast<std::uint32_t>(out.size() - first);
+    }
+
+    auto SubresourceStateTracker::get_state(std::uint32_t mip, std::uint32_t layer) const -> const ResourceState & {
+        mip = std::min(mip, m_mip_levels - 1);
+        layer = std::min(layer, m_array_layers - 1);
+
+        auto layers = std::find_if(m_layers.begin(), m_layers.end(), [layer](const LayerRun &run) {
+            return layer < run.base_layer + run.layer_count;
+        });
+        auto mips = std::find_if(layers->mips.begin(), layers->mips.end(), [mip](const MipRun &run) {
+            return mip < run.base_mip + run.mip_count;
+        });
+        return mips->state;
+    }
+
+    auto SubresourceStateTracker::resolve(const SubresourceRange &range) const -> SubresourceRange {
+        SubresourceRange resolved{};
+        resolved.base_mip = std::min(range.base_mip, m_mip_levels);
+        resolved.base_layer = std::min(range.base_layer, m_array_layers);
+        resolved.mip_count = std::min(range.mip_count, m_mip_levels - resolved.base_mip);
+        resolved.layer_count = std::min(range.layer_count, m_array_layers - resolved.base_layer);
+        return resolved;
+    }
+
+    auto SubresourceStateTracker::is_uniform() const -> bool {
+        return m_layers.size() == 1 && m_layers.front().mips.size() == 1;
+    }
+
+    auto SubresourceStateTracker::get_run_count() const -> std::size_t {
+        std::size_t count = 0;
+        for (const auto &layers: m_layers) {
+            count += layers.mips.size();
+        }
+        return count;
+    }
+
+    auto SubresourceStateTracker::split_layers_at(std::uint32_t layer) -> void {
+        for (std::size_t i = 0; i < m_layers.size(); ++i) {
+            auto &run = m_layers[i];
+            if (layer > run.base_layer && layer < run.base_layer + run.layer_count) {
+                LayerRun tail{};
+                tail.base_layer = layer;
+                tail.layer_count = run.base_layer + run.layer_count - layer;
+                tail.mips = run.mips;
+                run.layer_count = layer - run.base_layer;
+                m_layers.insert(m_layers.begin() + static_cast<std::ptrdiff_t>(i + 1), std::move(tail));
+                return;
+            }
+        }
+    }
+
+    auto SubresourceStateTracker::coalesce_layers() -> void {
+        auto same_mips = [](const MipRuns &a, const MipRuns &b) {
+            return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+        };
+
+        std::size_t write = 0;
+        for (std::size_t read = 1; read < m_layers.size(); ++read) {
+            if (same_mips(m_layers[write].mips, m_layers[read].mips)) {
+                m_layers[write].layer_count += m_layers[read].layer_count;
+            } else {
+                m_layers[++write] = std::move(m_layers[read]);
+            }
+        }
+        m_layers.resize(write + 1);
+    }
+
+    auto SubresourceStateTracker::split_mips_at(MipRuns &mips, std::uint32_t mip) -> void {
+        for (std::size_t i = 0; i < mips.size(); ++i) {
+            auto &run = mips[i];
+            if (mip > run.base_mip && mip < run.base_mip + run.mip_count) {
+                MipRun tail{
+                    .base_mip = mip,
+                    .mip_count = run.base_mip + run.mip_count - mip,
+                    .state = run.state
+                };
+                run.mip_count = mip - run.base_mip;
+
+                // SmallVector has no insert; shift the tail up by hand
+                mips.push_back(tail);
+                for (std::size_t j = mips.size() - 1; j > i + 1; --j) {
+                    mips[j] = mips[j - 1];
+                }
+                mips[i + 1] = tail;
+                return;
+            }
+        }
+    }
+
+    auto SubresourceStateTracker::coalesce_mips(MipRuns &mips) -> void {
+        std::size_t write = 0;
+        for (std::size_t read = 1; read < mips.size(); ++read) {
+            if (mips[write].state == mips[read].state) {
+                mips[write].mip_count += mips[read].mip_count;
+            } else {
+                mips[++write] = mips[read];
+            }
+        }
+        mips.resize(write + 1);
+    }
+} // namespace batleth
@@ -56,10 +56,19 @@ namespace batleth {
         // Wait for device to be idle before recreating swapchain
         ::vkDeviceWaitIdle(m_device);
 
-        cleanup();
+        // Hand the old swapchain over while creating the new one, then release it
+        auto old_swapchain = m_swapchain;
+        auto old_image_views = std::move(m_image_views);
+        m_config.old_swapchain = old_swapchain;
+
         create_swapchain();
         create_image_views();
 
+        for (auto image_view: old_image_views) {
+            ::vkDestroyImageView(m_device, image_view, nullptr);
+        }
+        ::vkDestroySwapchainKHR(m_device, old_swapchain, nullptr);
+
         FED_DEBUG("Swapchain resized successfully");
     }
 
@@ -115,12 +124,15 @@ namespace batleth {
         create_info.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
         create_info.presentMode = present_mode;
         create_info.clipped = VK_TRUE;
-        create_info.oldSwapchain = VK_NULL_HANDLE;
+        create_info.oldSwapchain = m_config.old_swapchain;
 
         if (::vkCreateSwapchainKHR(m_device, &create_info, nullptr, &m_swapchain) != VK_SUCCESS) {
             throw std::runtime_error("Failed to create swapchain");
         }
 
+        // The old swapchain is retired by this call; don't hand it over again
+        m_config.old_swapchain = VK_NULL_HANDLE;
+
         // Store format and extent
         m_format = surface_format.format;
         m_extent = extent;
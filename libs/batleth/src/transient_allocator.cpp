@@ -9,6 +9,9 @@ namespace batleth {
         : m_device(config.device) {
         VmaAllocatorCreateInfo allocator_info{};
         allocator_info.flags = VMA_ALLOCATOR_CREATE_BUFFER_DEVICE_ADDRESS_BIT;
+        if (config.memory_budget) {
+            allocator_info.flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
+        }
         allocator_info.physicalDevice = config.physical_device;
         allocator_info.device = config.device;
         allocator_info.instance = config.instance;
@@ -84,12 +87,9 @@ namespace batleth {
         alloc_info.usage = VMA_MEMORY_USAGE_AUTO;
         alloc_info.flags = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
 
-        // For transient attachments, use lazy allocation if available
-        if (desc.is_transient &&
-            (desc.usage & (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
-                           VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT |
-                           VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT))) {
-            image_info.usage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+        // For transient attachments, use lazy allocation if available.
+        // The render graph only sets TRANSIENT_ATTACHMENT when contents never leave tile memory.
+        if (desc.usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT) {
             alloc_info.preferredFlags = VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
         }
 
@@ -176,6 +176,10 @@ namespace batleth {
     }
 
     auto TransientAllocator::free_image(PhysicalImage &image) -> void {
+        std::erase_if(m_images, [&](const ImageAllocation &alloc) {
+            return image.image != VK_NULL_HANDLE && alloc.image.image == image.image;
+        });
+
         if (image.view != VK_NULL_HANDLE) {
             ::vkDestroyImageView(m_device, image.view, nullptr);
             image.view = VK_NULL_HANDLE;
@@ -189,6 +193,10 @@ namespace batleth {
     }
 
     auto TransientAllocator::free_buffer(PhysicalBuffer &buffer) -> void {
+        std::erase_if(m_buffers, [&](const BufferAllocation &alloc) {
+            return buffer.buffer != VK_NULL_HANDLE && alloc.buffer.buffer == buffer.buffer;
+        });
+
         if (buffer.buffer != VK_NULL_HANDLE && buffer.allocation != nullptr) {
             ::vmaDestroyBuffer(m_allocator, buffer.buffer, buffer.allocation);
             buffer.buffer = VK_NULL_HANDLE;
@@ -203,15 +211,17 @@ namespace batleth {
     }
 
     auto TransientAllocator::release_all() -> void {
-        for (auto &alloc: m_images) {
+        auto images = std::move(m_images);
+        m_images.clear();
+        for (auto &alloc: images) {
             free_image(alloc.image);
         }
-        m_images.clear();
 
-        for (auto &alloc: m_buffers) {
+        auto buffers = std::move(m_buffers);
+        m_buffers.clear();
+        for (auto &alloc: buffers) {
             free_buffer(alloc.buffer);
         }
-        m_buffers.clear();
     }
 
     auto TransientAllocator::get_stats() const -> Stats {
@@ -1,10 +1,17 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
 #include <utility>
 #include <vector>
 #include <functional>
 #include <GLFW/glfw3.h>
 
+#include "borg/input_event.hpp"
+
 #ifdef _WIN32
 #ifdef BORG_EXPORTS
 #define BORG_API __declspec(dllexport)
@@ -16,8 +23,10 @@
 #endif
 
 namespace borg {
-    // Forward declaration
+    // Forward declarations
     class Window;
+    class InputRecorder;
+    class InputPlayback;
 
     /**
  * Interface for objects that want to receive input events.
@@ -48,6 +57,12 @@ namespace borg {
  * The input system uses a subscriber pattern where multiple objects
  * can register to receive input callbacks. This makes it extensible
  * for both game and editor applications.
+ *
+ * GLFW callbacks only capture timestamped events into a fixed-size ring. The frame loop consumes
+ * them once per frame with begin_frame(), which updates the key/button/cursor state the polling
+ * queries read and then dispatches the events to pre-callbacks and subscribers in capture order.
+ * The dispatched stream can be recorded, and a recording can stand in for GLFW entirely, so a
+ * run driven by playback sees the same events and delta times on the same frames every time.
  */
     class BORG_API Input {
     public:
@@ -63,7 +78,36 @@ namespace borg {
 
         Input &operator=(Input &&) = delete;
 
-        // Polling-based input queries
+        /**
+     * Start a new input frame and dispatch the events captured since the last one
+     * @param delta_time Measured frame time
+     * @return Frame time to simulate with: the recorded one during playback, otherwise delta_time
+     */
+        auto begin_frame(float delta_time) -> float;
+
+        /**
+     * Dispatch events captured since the last dispatch without starting a new frame
+     * (for re-sampling input late in a frame)
+     */
+        auto dispatch_events() -> void;
+
+        auto get_frame() const -> std::uint32_t { return m_frame; }
+
+        // Recording and playback
+        auto start_recording(const std::filesystem::path &path) -> bool;
+
+        auto stop_recording() -> void;
+
+        /**
+     * Replace GLFW input with a recording; live events are discarded until it finishes
+     */
+        auto start_playback(const std::filesystem::path &path) -> bool;
+
+        auto is_playing_back() const -> bool { return m_playback != nullptr; }
+
+        auto is_playback_finished() const -> bool;
+
+        // Polling-based input queries (state as of the last dispatch)
         auto is_key_pressed(int key) const -> bool;
 
         auto is_mouse_button_pressed(int button) const -> bool;
@@ -100,6 +144,14 @@ namespace borg {
 
         static void scroll_callback(GLFWwindow *window, double xoffset, double yoffset);
 
+        auto capture(InputEvent event) -> void;
+
+        auto drain_ring() -> void;
+
+        auto dispatch(std::span<const InputEvent> events) -> void;
+
+        auto apply(const InputEvent &event) -> void;
+
         // Context structure to be stored in GLFW user pointer
         struct WindowContext {
             Window &window;
@@ -110,6 +162,22 @@ namespace borg {
         WindowContext m_context;
         std::vector<IInputSubscriber *> m_subscribers;
 
+        // Captured events waiting for the next dispatch
+        InputEventRing m_ring;
+        std::vector<InputEvent> m_dispatching;
+        std::uint32_t m_sequence = 0;
+        std::uint32_t m_frame = 0;
+        float m_delta_time = 0.0f;
+
+        // State after the last dispatch
+        std::array<bool, GLFW_KEY_LAST + 1> m_keys{};
+        std::array<bool, GLFW_MOUSE_BUTTON_LAST + 1> m_mouse_buttons{};
+        double m_cursor_x = 0.0;
+        double m_cursor_y = 0.0;
+
+        std::unique_ptr<InputRecorder> m_recorder;
+        std::unique_ptr<InputPlayback> m_playback;
+
         // Pre-callbacks (e.g., for ImGui)
         KeyCallback m_pre_key_callback;
         CursorPosCallback m_pre_cursor_callback;
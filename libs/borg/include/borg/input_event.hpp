@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace borg {
+    /**
+ * One input event as delivered by GLFW, stamped when it was captured.
+ * Trivially copyable with no padding, so recordings store it as raw bytes.
+ */
+    struct InputEvent {
+        enum class Type : std::uint32_t {
+            Key,
+            CursorPos,
+            MouseButton,
+            Scroll
+        };
+
+        double time = 0.0;              // glfwGetTime() at capture
+        double x = 0.0;                 // Cursor position or scroll offset
+        double y = 0.0;
+        Type type = Type::Key;
+        std::uint32_t sequence = 0;     // Capture order; gaps mean events were dropped
+        std::int32_t code = 0;          // Key or mouse button
+        std::int32_t scancode = 0;
+        std::int32_t action = 0;
+        std::int32_t mods = 0;
+    };
+
+    static_assert(std::is_trivially_copyable_v<InputEvent>);
+    static_assert(sizeof(InputEvent) == 48, "InputEvent is written to recordings as raw bytes");
+
+    /**
+ * Fixed-size ring of captured events, filled from GLFW callbacks and drained once per frame.
+ * When a frame produces more events than fit, the oldest ones are overwritten and counted.
+ */
+    class InputEventRing {
+    public:
+        static constexpr std::size_t CAPACITY = 256;
+
+        auto push(const InputEvent &event) -> void {
+            if (m_count == CAPACITY) {
+                m_head = (m_head + 1) % CAPACITY;
+                --m_count;
+                ++m_dropped;
+            }
+            m_events[(m_head + m_count) % CAPACITY] = event;
+            ++m_count;
+        }
+
+        /**
+     * Append every queued event to `out` in capture order and empty the ring
+     * @return Number of events dropped since the last drain
+     */
+        auto drain(std::vector<InputEvent> &out) -> std::uint32_t {
+            for (std::size_t i = 0; i < m_count; ++i) {
+                out.push_back(m_events[(m_head + i) % CAPACITY]);
+            }
+            m_head = 0;
+            m_count = 0;
+
+            const std::uint32_t dropped = m_dropped;
+            m_dropped = 0;
+            return dropped;
+        }
+
+        auto size() const -> std::size_t { return m_count; }
+        auto empty() const -> bool { return m_count == 0; }
+
+    private:
+        std::array<InputEvent, CAPACITY> m_events{};
+        std::size_t m_head = 0;
+        std::size_t m_count = 0;
+        std::uint32_t m_dropped = 0;
+    };
+} // namespace borg
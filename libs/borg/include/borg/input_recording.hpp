@@ -0,0 +1,109 @@
+#pragma once
+
+#include "borg/input_event.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#ifdef BORG_EXPORTS
+#define BORG_API __declspec(dllexport)
+#else
+#define BORG_API __declspec(dllimport)
+#endif
+#else
+#define BORG_API
+#endif
+
+namespace borg {
+    /**
+ * Input recording format (.kinput)
+ *
+ * A header (uint32 magic, uint32 version, double cursor x, double cursor y) followed by one
+ * batch per event dispatch, in order:
+ *   uint32 frame, float delta_time, uint32 event count, InputEvent[count]
+ * The cursor position is where the recording started, so playback reports the same position
+ * before the first recorded cursor event.
+ * Every frame has at least one batch (possibly empty) carrying its delta time; a frame that
+ * dispatches again later (late latching) adds further batches with the same frame index.
+ */
+    constexpr std::uint32_t INPUT_RECORDING_MAGIC = 0x504E494B; // "KINP"
+    constexpr std::uint32_t INPUT_RECORDING_VERSION = 2;
+
+    struct InputBatch {
+        std::uint32_t frame = 0;
+        float delta_time = 0.0f;
+        std::vector<InputEvent> events;
+    };
+
+    /**
+ * Streams dispatched input batches to a recording file
+ */
+    class BORG_API InputRecorder {
+    public:
+        /**
+     * Open `path` for writing, replacing any existing recording
+     * @param cursor_x, cursor_y Cursor position as of the last dispatch before recording starts
+     * @return nullptr if the file can't be created
+     */
+        static auto create(const std::filesystem::path &path, double cursor_x, double cursor_y)
+            -> std::unique_ptr<InputRecorder>;
+
+        ~InputRecorder();
+
+        InputRecorder(const InputRecorder &) = delete;
+
+        InputRecorder &operator=(const InputRecorder &) = delete;
+
+        auto write_batch(std::uint32_t frame, float delta_time, std::span<const InputEvent> events) -> void;
+
+        auto get_batch_count() const -> std::uint64_t { return m_batches; }
+
+    private:
+        explicit InputRecorder(std::ofstream file);
+
+        std::ofstream m_file;
+        std::uint64_t m_batches = 0;
+    };
+
+    /**
+ * Replays a recording in place of GLFW, batch by batch
+ * The whole file is read up front so playback never touches the disk mid-frame.
+ */
+    class BORG_API InputPlayback {
+    public:
+        /**
+     * Load the recording at `path`
+     * @return nullptr if the file is missing, not a recording, truncated or corrupt
+     */
+        static auto load(const std::filesystem::path &path) -> std::unique_ptr<InputPlayback>;
+
+        /**
+     * Next recorded batch, if it belongs to `frame`
+     * @return nullptr once the frame's batches are used up
+     */
+        auto next_batch(std::uint32_t frame) -> const InputBatch *;
+
+        auto is_finished() const -> bool { return m_next >= m_batches.size(); }
+
+        auto get_batch_count() const -> std::size_t { return m_batches.size(); }
+
+        /**
+     * Cursor position when the recording started
+     */
+        auto get_start_cursor() const -> std::pair<double, double> { return {m_cursor_x, m_cursor_y}; }
+
+    private:
+        InputPlayback() = default;
+
+        std::vector<InputBatch> m_batches;
+        double m_cursor_x = 0.0;
+        double m_cursor_y = 0.0;
+        std::size_t m_next = 0;
+    };
+} // namespace borg
@@ -1,5 +1,7 @@
 #include "borg/input.hpp"
+#include "borg/input_recording.hpp"
 #include "borg/window.hpp"
+#include "federation/log.hpp"
 #include <algorithm>
 
 namespace borg {
@@ -14,6 +16,9 @@ namespace borg {
         ::glfwSetCursorPosCallback(m_window, cursor_callback);
         ::glfwSetMouseButtonCallback(m_window, mouse_button_callback);
         ::glfwSetScrollCallback(m_window, scroll_callback);
+
+        ::glfwGetCursorPos(m_window, &m_cursor_x, &m_cursor_y);
+        m_dispatching.reserve(InputEventRing::CAPACITY);
     }
 
     Input::~Input() {
@@ -24,18 +29,84 @@ namespace borg {
         ::glfwSetScrollCallback(m_window, nullptr);
     }
 
+    auto Input::begin_frame(float delta_time) -> float {
+        if (!m_playback) {
+            ++m_frame;
+            m_delta_time = delta_time;
+            dispatch_events();
+            return m_delta_time;
+        }
+
+        // Live events are ignored while the recording drives input
+        drain_ring();
+
+        // Batches the recorded frame dispatched later than this run did (e.g. it late-latched)
+        while (const auto *batch = m_playback->next_batch(m_frame)) {
+            dispatch(batch->events);
+        }
+
+        ++m_frame;
+        m_delta_time = delta_time;
+        if (const auto *batch = m_playback->next_batch(m_frame)) {
+            m_delta_time = batch->delta_time;
+            dispatch(batch->events);
+        }
+        return m_delta_time;
+    }
+
+    auto Input::dispatch_events() -> void {
+        drain_ring();
+
+        if (m_playback) {
+            if (const auto *batch = m_playback->next_batch(m_frame)) {
+                dispatch(batch->events);
+            }
+            return;
+        }
+
+        if (m_recorder && m_frame > 0) {
+            m_recorder->write_batch(m_frame, m_delta_time, m_dispatching);
+        }
+        dispatch(m_dispatching);
+    }
+
+    auto Input::start_recording(const std::filesystem::path &path) -> bool {
+        m_recorder = InputRecorder::create(path, m_cursor_x, m_cursor_y);
+        return m_recorder != nullptr;
+    }
+
+    auto Input::stop_recording() -> void {
+        m_recorder.reset();
+    }
+
+    auto Input::start_playback(const std::filesystem::path &path) -> bool {
+        m_playback = InputPlayback::load(path);
+        if (m_playback) {
+            // Recorded frame indices are relative to the start of the recording
+            m_frame = 0;
+            m_keys.fill(false);
+            m_mouse_buttons.fill(false);
+            const auto [cursor_x, cursor_y] = m_playback->get_start_cursor();
+            m_cursor_x = cursor_x;
+            m_cursor_y = cursor_y;
+        }
+        return m_playback != nullptr;
+    }
+
+    auto Input::is_playback_finished() const -> bool {
+        return m_playback && m_playback->is_finished();
+    }
+
     auto Input::is_key_pressed(int key) const -> bool {
-        return ::glfwGetKey(m_window, key) == GLFW_PRESS;
+        return key >= 0 && key <= GLFW_KEY_LAST && m_keys[static_cast<std::size_t>(key)];
     }
 
     auto Input::is_mouse_button_pressed(int button) const -> bool {
-        return ::glfwGetMouseButton(m_window, button) == GLFW_PRESS;
+        return button >= 0 && button <= GLFW_MOUSE_BUTTON_LAST && m_mouse_buttons[static_cast<std::size_t>(button)];
     }
 
     auto Input::get_cursor_position() const -> std::pair<double, double> {
-        double x, y;
-        ::glfwGetCursorPos(m_window, &x, &y);
-        return {x, y};
+        return {m_cursor_x, m_cursor_y};
     }
 
     auto Input::add_subscriber(IInputSubscriber *subscriber) -> void {
@@ -49,63 +120,112 @@ namespace borg {
         }
     }
 
-    void Input::key_callback(GLFWwindow *window, int key, int scancode, int action, int mods) {
-        auto *ctx = reinterpret_cast<WindowContext *>(::glfwGetWindowUserPointer(window));
-        if (!ctx) return;
+    auto Input::capture(InputEvent event) -> void {
+        event.time = ::glfwGetTime();
+        event.sequence = m_sequence++;
+        m_ring.push(event);
+    }
 
-        // Call pre-callback first (e.g., for ImGui)
-        if (ctx->input_manager.m_pre_key_callback) {
-            ctx->input_manager.m_pre_key_callback(window, key, scancode, action, mods);
+    auto Input::drain_ring() -> void {
+        m_dispatching.clear();
+        const std::uint32_t dropped = m_ring.drain(m_dispatching);
+        if (dropped > 0) {
+            FED_WARN("Input event ring overflowed: {} events dropped", dropped);
         }
+    }
 
-        // Notify all subscribers
-        for (auto *subscriber: ctx->input_manager.m_subscribers) {
-            subscriber->on_key(window, key, scancode, action, mods);
+    auto Input::apply(const InputEvent &event) -> void {
+        switch (event.type) {
+            case InputEvent::Type::Key:
+                if (event.code >= 0 && event.code <= GLFW_KEY_LAST) {
+                    m_keys[static_cast<std::size_t>(event.code)] = event.action != GLFW_RELEASE;
+                }
+                break;
+            case InputEvent::Type::MouseButton:
+                if (event.code >= 0 && event.code <= GLFW_MOUSE_BUTTON_LAST) {
+                    m_mouse_buttons[static_cast<std::size_t>(event.code)] = event.action != GLFW_RELEASE;
+                }
+                break;
+            case InputEvent::Type::CursorPos:
+                m_cursor_x = event.x;
+                m_cursor_y = event.y;
+                break;
+            case InputEvent::Type::Scroll:
+                break;
         }
     }
 
-    void Input::cursor_callback(GLFWwindow *window, double xpos, double ypos) {
+    auto Input::dispatch(std::span<const InputEvent> events) -> void {
+        for (const auto &event: events) {
+            apply(event);
+
+            // Pre-callback first (e.g., for ImGui), then all subscribers
+            switch (event.type) {
+                case InputEvent::Type::Key:
+                    if (m_pre_key_callback) {
+                        m_pre_key_callback(m_window, event.code, event.scancode, event.action, event.mods);
+                    }
+                    for (auto *subscriber: m_subscribers) {
+                        subscriber->on_key(m_window, event.code, event.scancode, event.action, event.mods);
+                    }
+                    break;
+                case InputEvent::Type::CursorPos:
+                    if (m_pre_cursor_callback) {
+                        m_pre_cursor_callback(m_window, event.x, event.y);
+                    }
+                    for (auto *subscriber: m_subscribers) {
+                        subscriber->on_mouse_move(m_window, event.x, event.y);
+                    }
+                    break;
+                case InputEvent::Type::MouseButton:
+                    if (m_pre_mouse_button_callback) {
+                        m_pre_mouse_button_callback(m_window, event.code, event.action, event.mods);
+                    }
+                    for (auto *subscriber: m_subscribers) {
+                        subscriber->on_mouse_button(m_window, event.code, event.action, event.mods);
+                    }
+                    break;
+                case InputEvent::Type::Scroll:
+                    if (m_pre_scroll_callback) {
+                        m_pre_scroll_callback(m_window, event.x, event.y);
+                    }
+                    for (auto *subscriber: m_subscribers) {
+                        subscriber->on_scroll(m_window, event.x, event.y);
+                    }
+                    break;
+            }
+        }
+    }
+
+    void Input::key_callback(GLFWwindow *window, int key, int scancode, int action, int mods) {
         auto *ctx = reinterpret_cast<WindowContext *>(::glfwGetWindowUserPointer(window));
         if (!ctx) return;
 
-        // Call pre-callback first (e.g., for ImGui)
-        if (ctx->input_manager.m_pre_cursor_callback) {
-            ctx->input_manager.m_pre_cursor_callback(window, xpos, ypos);
-        }
+        ctx->input_manager.capture({
+            .type = InputEvent::Type::Key, .code = key, .scancode = scancode, .action = action, .mods = mods
+        });
+    }
 
-        // Notify all subscribers
-        for (auto *subscriber: ctx->input_manager.m_subscribers) {
-            subscriber->on_mouse_move(window, xpos, ypos);
-        }
+    void Input::cursor_callback(GLFWwindow *window, double xpos, double ypos) {
+        auto *ctx = reinterpret_cast<WindowContext *>(::glfwGetWindowUserPointer(window));
+        if (!ctx) return;
+
+        ctx->input_manager.capture({.x = xpos, .y = ypos, .type = InputEvent::Type::CursorPos});
     }
 
     void Input::mouse_button_callback(GLFWwindow *window, int button, int action, int mods) {
         auto *ctx = reinterpret_cast<WindowContext *>(::glfwGetWindowUserPointer(window));
         if (!ctx) return;
 
-        // Call pre-callback first (e.g., for ImGui)
-        if (ctx->input_manager.m_pre_mouse_button_callback) {
-            ctx->input_manager.m_pre_mouse_button_callback(window, button, action, mods);
-        }
-
-        // Notify all subscribers
-        for (auto *subscriber: ctx->input_manager.m_subscribers) {
-            subscriber->on_mouse_button(window, button, action, mods);
-        }
+        ctx->input_manager.capture({
+            .type = InputEvent::Type::MouseButton, .code = button, .action = action, .mods = mods
+        });
     }
 
     void Input::scroll_callback(GLFWwindow *window, double xoffset, double yoffset) {
         auto *ctx = reinterpret_cast<WindowContext *>(::glfwGetWindowUserPointer(window));
         if (!ctx) return;
 
-        // Call pre-callback first (e.g., for ImGui)
-        if (ctx->input_manager.m_pre_scroll_callback) {
-            ctx->input_manager.m_pre_scroll_callback(window, xoffset, yoffset);
-        }
-
-        // Notify all subscribers
-        for (auto *subscriber: ctx->input_manager.m_subscribers) {
-            subscriber->on_scroll(window, xoffset, yoffset);
-        }
+        ctx->input_manager.capture({.x = xoffset, .y = yoffset, .type = InputEvent::Type::Scroll});
     }
-} // namespace borg
\ No newline at end of file
+} // namespace borg
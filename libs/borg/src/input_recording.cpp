@@ -0,0 +1,109 @@
+#include "borg/input_recording.hpp"
+#include "federation/log.hpp"
+
+namespace borg {
+    auto InputRecorder::create(const std::filesystem::path &path, double cursor_x, double cursor_y)
+        -> std::unique_ptr<InputRecorder> {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            FED_ERROR("Failed to create input recording: {}", path.string());
+            return nullptr;
+        }
+
+        const std::uint32_t magic = INPUT_RECORDING_MAGIC;
+        const std::uint32_t version = INPUT_RECORDING_VERSION;
+        file.write(reinterpret_cast<const char *>(&magic), sizeof(magic));
+        file.write(reinterpret_cast<const char *>(&version), sizeof(version));
+        file.write(reinterpret_cast<const char *>(&cursor_x), sizeof(cursor_x));
+        file.write(reinterpret_cast<const char *>(&cursor_y), sizeof(cursor_y));
+
+        FED_INFO("Recording input to {}", path.string());
+        return std::unique_ptr<InputRecorder>(new InputRecorder(std::move(file)));
+    }
+
+    InputRecorder::InputRecorder(std::ofstream file)
+        : m_file(std::move(file)) {
+    }
+
+    InputRecorder::~InputRecorder() {
+        m_file.flush();
+        if (!m_file) {
+            FED_ERROR("Input recording is incomplete: write failed");
+            return;
+        }
+        FED_INFO("Input recording finished ({} batches)", m_batches);
+    }
+
+    auto InputRecorder::write_batch(std::uint32_t frame, float delta_time,
+                                    std::span<const InputEvent> events) -> void {
+        const auto count = static_cast<std::uint32_t>(events.size());
+        m_file.write(reinterpret_cast<const char *>(&frame), sizeof(frame));
+        m_file.write(reinterpret_cast<const char *>(&delta_time), sizeof(delta_time));
+        m_file.write(reinterpret_cast<const char *>(&count), sizeof(count));
+        m_file.write(reinterpret_cast<const char *>(events.data()),
+                     static_cast<std::streamsize>(events.size_bytes()));
+        ++m_batches;
+    }
+
+    auto InputPlayback::load(const std::filesystem::path &path) -> std::unique_ptr<InputPlayback> {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            FED_ERROR("Failed to open input recording: {}", path.string());
+            return nullptr;
+        }
+
+        file.seekg(0, std::ios::end);
+        const auto file_size = static_cast<std::uint64_t>(file.tellg());
+        file.seekg(0, std::ios::beg);
+
+        auto playback = std::unique_ptr<InputPlayback>(new InputPlayback());
+        std::uint32_t magic = 0, version = 0;
+        file.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+        file.read(reinterpret_cast<char *>(&version), sizeof(version));
+        file.read(reinterpret_cast<char *>(&playback->m_cursor_x), sizeof(playback->m_cursor_x));
+        file.read(reinterpret_cast<char *>(&playback->m_cursor_y), sizeof(playback->m_cursor_y));
+        if (!file || magic != INPUT_RECORDING_MAGIC || version != INPUT_RECORDING_VERSION) {
+            FED_ERROR("Invalid input recording: {}", path.string());
+            return nullptr;
+        }
+
+        while (file.peek() != std::ifstream::traits_type::eof()) {
+            InputBatch batch;
+            std::uint32_t count = 0;
+            file.read(reinterpret_cast<char *>(&batch.frame), sizeof(batch.frame));
+            file.read(reinterpret_cast<char *>(&batch.delta_time), sizeof(batch.delta_time));
+            file.read(reinterpret_cast<char *>(&count), sizeof(count));
+            if (!file) {
+                FED_ERROR("Input recording is truncated: {}", path.string());
+                return nullptr;
+            }
+
+            // A corrupt count must not size the allocation: the events have to fit in what's left
+            const std::uint64_t remaining = file_size - static_cast<std::uint64_t>(file.tellg());
+            if (count > remaining / sizeof(InputEvent)) {
+                FED_ERROR("Input recording is truncated or corrupt ({} events in {} bytes): {}",
+                          count, remaining, path.string());
+                return nullptr;
+            }
+            batch.events.resize(count);
+            file.read(reinterpret_cast<char *>(batch.events.data()),
+                      static_cast<std::streamsize>(count * sizeof(InputEvent)));
+
+            if (!file) {
+                FED_ERROR("Input recording is truncated: {}", path.string());
+                return nullptr;
+            }
+            playback->m_batches.push_back(std::move(batch));
+        }
+
+        FED_INFO("Playing back input from {} ({} batches)", path.string(), playback->m_batches.size());
+        return playback;
+    }
+
+    auto InputPlayback::next_batch(std::uint32_t frame) -> const InputBatch * {
+        if (is_finished() || m_batches[m_next].frame != frame) {
+            return nullptr;
+        }
+        return &m_batches[m_next++];
+    }
+} // namespace borg
@@ -4,6 +4,7 @@
 #include <optional>
 #include <string>
 #include <fstream>
+#include <spanstream>
 #include <ser20/archives/json.hpp>
 #include <ser20/types/vector.hpp>
 #include <ser20/types/string.hpp>
@@ -11,6 +12,7 @@
 #include <ser20/types/optional.hpp>
 
 #include "log.hpp"
+#include "storage/virtual_file_system.hpp"
 
 #ifdef _WIN32
     #ifdef FEDERATION_EXPORTS
@@ -35,6 +37,7 @@ class FEDERATION_API ConfigManager {
 public:
     /**
      * Load configuration from JSON file.
+     * Read through the VirtualFileSystem, so configs can ship inside packs.
      * If file doesn't exist or is invalid, returns default-constructed T.
      * Automatically creates config file with defaults if missing.
      */
@@ -42,19 +45,21 @@ public:
     static auto load(const std::filesystem::path& filepath) -> T {
         T config{};  // Default construct
 
-        if (!std::filesystem::exists(filepath)) {
+        auto& vfs = VirtualFileSystem::get();
+        if (!vfs.exists(filepath.generic_string())) {
             FED_INFO("Config file not found: {}, creating with defaults", filepath.string());
             save(config, filepath);
             return config;
         }
 
         try {
-            std::ifstream file(filepath);
-            if (!file.is_open()) {
+            auto contents = vfs.read(filepath.generic_string());
+            if (!contents) {
                 FED_ERROR("Failed to open config file: {}", filepath.string());
                 return config;
             }
 
+            std::ispanstream file(contents->as_string_view());
             ser20::JSONInputArchive archive(file);
             archive(config);
             FED_INFO("Loaded config from: {}", filepath.string());
@@ -102,13 +107,14 @@ public:
      */
     template<typename T>
     static auto validate(const std::filesystem::path& filepath) -> bool {
-        if (!std::filesystem::exists(filepath)) {
+        auto contents = VirtualFileSystem::get().read(filepath.generic_string());
+        if (!contents) {
             return false;
         }
 
         try {
             T config{};
-            std::ifstream file(filepath);
+            std::ispanstream file(contents->as_string_view());
             ser20::JSONInputArchive archive(file);
             archive(config);
             return true;
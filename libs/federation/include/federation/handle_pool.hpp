@@ -0,0 +1,188 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace federation {
+    /**
+ * Generational handle to an object in a HandlePool<T>.
+ * Packs the slot index and the slot's generation at the time of creation into 32 bits, so
+ * handles cost no more than raw indices to store and copy, yet a handle to a released object
+ * stops resolving even after its slot is reused. The default-constructed handle is null.
+ */
+    template<typename T>
+    class Handle {
+    public:
+        static constexpr std::uint32_t INDEX_BITS = 20;
+        static constexpr std::uint32_t MAX_INDEX = (1u << INDEX_BITS) - 1;
+        static constexpr std::uint32_t MAX_GENERATION = (1u << (32 - INDEX_BITS)) - 1;
+
+        Handle() = default;
+
+        Handle(std::uint32_t index, std::uint32_t generation)
+            : m_value((generation << INDEX_BITS) | index) {
+            assert(index <= MAX_INDEX && generation != 0 && generation <= MAX_GENERATION);
+        }
+
+        [[nodiscard]] auto index() const -> std::uint32_t { return m_value & MAX_INDEX; }
+        [[nodiscard]] auto generation() const -> std::uint32_t { return m_value >> INDEX_BITS; }
+        [[nodiscard]] auto value() const -> std::uint32_t { return m_value; }
+        [[nodiscard]] auto is_null() const -> bool { return m_value == 0; }
+
+        explicit operator bool() const { return m_value != 0; }
+
+        auto operator==(const Handle &) const -> bool = default;
+
+    private:
+        std::uint32_t m_value = 0;  // Generation 0 is never issued, so 0 is the null handle
+    };
+
+    /**
+ * Slot array of T addressed by generational handles.
+ *
+ * Objects live contiguously in a vector of slots; freed slots are reused through a free list.
+ * release() invalidates every handle to the object at once but keeps the object itself until
+ * collect() is called `retire_frames` frames later, so GPU resources it owns are not destroyed
+ * while frames in flight may still use them.
+ *
+ * get() only validates handles in debug builds (assert); try_get() always does. References are
+ * invalidated by create(). Not thread-safe.
+ */
+    template<typename T>
+    class HandlePool {
+    public:
+        explicit HandlePool(std::uint32_t retire_frames = 0) : m_retire_frames(retire_frames) {
+        }
+
+        HandlePool(const HandlePool &) = delete;
+
+        HandlePool &operator=(const HandlePool &) = delete;
+
+        template<typename... Args>
+        auto create(Args &&... args) -> Handle<T> {
+            std::uint32_t index;
+            if (!m_free.empty()) {
+                index = m_free.back();
+                m_free.pop_back();
+            } else {
+                index = static_cast<std::uint32_t>(m_slots.size());
+                assert(index <= Handle<T>::MAX_INDEX && "HandlePool is full");
+                m_slots.emplace_back();
+            }
+
+            auto &slot = m_slots[index];
+            slot.value.emplace(std::forward<Args>(args)...);
+            slot.alive = true;
+            ++m_live;
+            return Handle<T>{index, slot.generation};
+        }
+
+        [[nodiscard]] auto is_alive(Handle<T> handle) const -> bool {
+            return handle.index() < m_slots.size() && m_slots[handle.index()].alive &&
+                   m_slots[handle.index()].generation == handle.generation();
+        }
+
+        [[nodiscard]] auto get(Handle<T> handle) -> T & {
+            assert(is_alive(handle) && "Stale or null handle");
+            return *m_slots[handle.index()].value;
+        }
+
+        [[nodiscard]] auto get(Handle<T> handle) const -> const T & {
+            assert(is_alive(handle) && "Stale or null handle");
+            return *m_slots[handle.index()].value;
+        }
+
+        [[nodiscard]] auto try_get(Handle<T> handle) -> T * {
+            return is_alive(handle) ? &*m_slots[handle.index()].value : nullptr;
+        }
+
+        [[nodiscard]] auto try_get(Handle<T> handle) const -> const T * {
+            return is_alive(handle) ? &*m_slots[handle.index()].value : nullptr;
+        }
+
+        /**
+     * Invalidate the handle now and destroy the object once collect() reaches frame + retire_frames.
+     * Releasing a stale or null handle does nothing.
+     */
+        auto release(Handle<T> handle, std::uint64_t frame) -> void {
+            if (!is_alive(handle)) {
+                return;
+            }
+            auto &slot = m_slots[handle.index()];
+            slot.alive = false;
+            --m_live;
+            m_retired.push_back({.frame = frame, .index = handle.index()});
+        }
+
+        /**
+     * Destroy released objects whose frames have retired and recycle their slots
+     * @param frame Current frame; objects released at or before frame - retire_frames go
+     */
+        auto collect(std::uint64_t frame) -> void {
+            while (!m_retired.empty() && m_retired.front().frame + m_retire_frames <= frame) {
+                retire_slot(m_retired.front().index);
+                m_retired.pop_front();
+            }
+        }
+
+        /**
+     * Destroy every released object regardless of frame (the GPU must be idle)
+     */
+        auto collect_all() -> void {
+            for (const auto &retired : m_retired) {
+                retire_slot(retired.index);
+            }
+            m_retired.clear();
+        }
+
+        /**
+     * Call fn(handle, object) for every live object
+     */
+        template<typename Fn>
+        auto for_each(Fn &&fn) -> void {
+            for (std::uint32_t index = 0; index < m_slots.size(); ++index) {
+                auto &slot = m_slots[index];
+                if (slot.alive) {
+                    std::invoke(fn, Handle<T>{index, slot.generation}, *slot.value);
+                }
+            }
+        }
+
+        [[nodiscard]] auto size() const -> std::uint32_t { return m_live; }
+        [[nodiscard]] auto retired_count() const -> std::size_t { return m_retired.size(); }
+
+    private:
+        struct Slot {
+            std::optional<T> value;
+            std::uint32_t generation = 1;
+            bool alive = false;
+        };
+
+        struct Retired {
+            std::uint64_t frame = 0;
+            std::uint32_t index = 0;
+        };
+
+        auto retire_slot(std::uint32_t index) -> void {
+            auto &slot = m_slots[index];
+            slot.value.reset();
+            // A slot whose generation would wrap is never reused, so no old handle can match it again
+            if (slot.generation < Handle<T>::MAX_GENERATION) {
+                ++slot.generation;
+                m_free.push_back(index);
+            }
+        }
+
+        std::vector<Slot> m_slots;
+        std::vector<std::uint32_t> m_free;
+        std::deque<Retired> m_retired;
+        std::uint32_t m_retire_frames;
+        std::uint32_t m_live = 0;
+    };
+} // namespace federation
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace federation {
+    template<typename Signature, std::size_t Capacity = 64>
+    class InplaceFunction;
+
+    /**
+ * Type-erased callable stored entirely inline (no heap allocation).
+ * Drop-in for std::function where the captured state is small and known,
+ * e.g. render graph pass callbacks that are rebuilt every time the graph is.
+ *
+ * Callables larger than Capacity are rejected at compile time.
+ */
+    template<typename R, typename... Args, std::size_t Capacity>
+    class InplaceFunction<R(Args...), Capacity> {
+    public:
+        InplaceFunction() = default;
+
+        InplaceFunction(std::nullptr_t) {
+        }
+
+        template<typename F>
+            requires (!std::is_same_v<std::remove_cvref_t<F>, InplaceFunction> &&
+                      std::is_invocable_r_v<R, std::decay_t<F> &, Args...>)
+        InplaceFunction(F &&callable) {
+            using Fn = std::decay_t<F>;
+            static_assert(sizeof(Fn) <= Capacity,
+                          "Callable is too large for InplaceFunction - capture less or raise Capacity");
+            static_assert(alignof(Fn) <= alignof(std::max_align_t),
+                          "Callable is over-aligned for InplaceFunction");
+            static_assert(std::is_copy_constructible_v<Fn>, "InplaceFunction requires a copyable callable");
+
+            ::new(static_cast<void *>(m_storage)) Fn(std::forward<F>(callable));
+            m_vtable = &s_vtable<Fn>;
+        }
+
+        ~InplaceFunction() {
+            reset();
+        }
+
+        InplaceFunction(const InplaceFunction &other) {
+            if (other.m_vtable) {
+                other.m_vtable->copy(m_storage, other.m_storage);
+                m_vtable = other.m_vtable;
+            }
+        }
+
+        InplaceFunction &operator=(const InplaceFunction &other) {
+            if (this != &other) {
+                reset();
+                if (other.m_vtable) {
+                    other.m_vtable->copy(m_storage, other.m_storage);
+                    m_vtable = other.m_vtable;
+                }
+            }
+            return *this;
+        }
+
+        InplaceFunction(InplaceFunction &&other) noexcept {
+            if (other.m_vtable) {
+                other.m_vtable->move(m_storage, other.m_storage);
+                m_vtable = other.m_vtable;
+                other.reset();
+            }
+        }
+
+        InplaceFunction &operator=(InplaceFunction &&other) noexcept {
+            if (this != &other) {
+                reset();
+                if (other.m_vtable) {
+                    other.m_vtable->move(m_storage, other.m_storage);
+                    m_vtable = other.m_vtable;
+                    other.reset();
+                }
+            }
+            return *this;
+        }
+
+        auto operator()(Args... args) const -> R {
+            return m_vtable->invoke(m_storage, std::forward<Args>(args)...);
+        }
+
+        explicit operator bool() const { return m_vtable != nullptr; }
+
+        auto reset() -> void {
+            if (m_vtable) {
+                m_vtable->destroy(m_storage);
+                m_vtable = nullptr;
+            }
+        }
+
+    private:
+        struct VTable {
+            R (*invoke)(void *storage, Args &&... args);
+            void (*copy)(void *dst, const void *src);
+            void (*move)(void *dst, void *src);
+            void (*destroy)(void *storage);
+        };
+
+        template<typename Fn>
+        static constexpr VTable s_vtable{
+            [](void *storage, Args &&... args) -> R {
+                return std::invoke(*static_cast<Fn *>(storage), std::forward<Args>(args)...);
+            },
+            [](void *dst, const void *src) {
+                ::new(dst) Fn(*static_cast<const Fn *>(src));
+            },
+            [](void *dst, void *src) {
+                ::new(dst) Fn(std::move(*static_cast<Fn *>(src)));
+            },
+            [](void *storage) {
+                std::destroy_at(static_cast<Fn *>(storage));
+            }
+        };
+
+        alignas(std::max_align_t) mutable std::byte m_storage[Capacity];
+        const VTable *m_vtable = nullptr;
+    };
+} // namespace federation
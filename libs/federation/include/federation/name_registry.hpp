@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#ifdef _WIN32
+#ifdef FEDERATION_EXPORTS
+#define FEDERATION_API __declspec(dllexport)
+#else
+#define FEDERATION_API __declspec(dllimport)
+#endif
+#else
+#define FEDERATION_API
+#endif
+
+namespace federation {
+    // Interned string identifier. Equal names always map to the same id.
+    using NameId = std::uint32_t;
+    constexpr NameId INVALID_NAME_ID = 0;
+
+    /**
+ * Process-wide string interner.
+ * Names are stored once and referred to by a 32-bit id, so hot data structures
+ * can compare and copy names without touching string memory.
+ * Thread-safe; interned strings live until process exit.
+ */
+    class FEDERATION_API NameRegistry {
+    public:
+        /**
+     * Intern a name, returning its id. Empty names map to INVALID_NAME_ID.
+     */
+        static auto intern(std::string_view name) -> NameId;
+
+        /**
+     * Look up the string for an id. Unknown ids return an empty view.
+     */
+        static auto lookup(NameId id) -> std::string_view;
+    };
+} // namespace federation
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+
+namespace federation {
+    /**
+ * Vector with inline storage for the first N elements.
+ * Only spills to the heap once it grows past N, so small per-object lists
+ * (pass reads/writes, dependency lists) cost no allocation.
+ *
+ * Restricted to trivially copyable element types: relocation is a memcpy.
+ */
+    template<typename T, std::size_t N>
+    class SmallVector {
+        static_assert(std::is_trivially_copyable_v<T>, "SmallVector only supports trivially copyable types");
+        static_assert(N > 0, "SmallVector needs at least one inline element");
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using iterator = T *;
+        using const_iterator = const T *;
+
+        SmallVector() = default;
+
+        SmallVector(std::initializer_list<T> values) {
+            assign(values.begin(), values.end());
+        }
+
+        ~SmallVector() {
+            release_heap();
+        }
+
+        SmallVector(const SmallVector &other) {
+            assign(other.begin(), other.end());
+        }
+
+        SmallVector &operator=(const SmallVector &other) {
+            if (this != &other) {
+                m_size = 0;
+                assign(other.begin(), other.end());
+            }
+            return *this;
+        }
+
+        SmallVector(SmallVector &&other) noexcept {
+            steal(other);
+        }
+
+        SmallVector &operator=(SmallVector &&other) noexcept {
+            if (this != &other) {
+                release_heap();
+                steal(other);
+            }
+            return *this;
+        }
+
+        auto push_back(const T &value) -> void {
+            if (m_size == m_capacity) {
+                grow(m_capacity * 2);
+            }
+            std::construct_at(m_data + m_size, value);
+            ++m_size;
+        }
+
+        template<typename... Args>
+        auto emplace_back(Args &&... args) -> T & {
+            if (m_size == m_capacity) {
+                grow(m_capacity * 2);
+            }
+            T *element = std::construct_at(m_data + m_size, std::forward<Args>(args)...);
+            ++m_size;
+            return *element;
+        }
+
+        auto pop_back() -> void { --m_size; }
+
+        auto reserve(size_type capacity) -> void {
+            if (capacity > m_capacity) {
+                grow(capacity);
+            }
+        }
+
+        auto resize(size_type size) -> void {
+            reserve(size);
+            for (size_type i = m_size; i < size; ++i) {
+                std::construct_at(m_data + i);
+            }
+            m_size = size;
+        }
+
+        auto clear() -> void { m_size = 0; }
+
+        [[nodiscard]] auto size() const -> size_type { return m_size; }
+        [[nodiscard]] auto capacity() const -> size_type { return m_capacity; }
+        [[nodiscard]] auto empty() const -> bool { return m_size == 0; }
+        [[nodiscard]] auto is_inline() const -> bool { return m_data == inline_data(); }
+
+        auto data() -> T * { return m_data; }
+        auto data() const -> const T * { return m_data; }
+
+        auto operator[](size_type index) -> T & { return m_data[index]; }
+        auto operator[](size_type index) const -> const T & { return m_data[index]; }
+
+        auto front() -> T & { return m_data[0]; }
+        auto front() const -> const T & { return m_data[0]; }
+        auto back() -> T & { return m_data[m_size - 1]; }
+        auto back() const -> const T & { return m_data[m_size - 1]; }
+
+        auto begin() -> iterator { return m_data; }
+        auto end() -> iterator { return m_data + m_size; }
+        auto begin() const -> const_iterator { return m_data; }
+        auto end() const -> const_iterator { return m_data + m_size; }
+
+    private:
+        auto inline_data() -> T * { return reinterpret_cast<T *>(m_inline); }
+        auto inline_data() const -> const T * { return reinterpret_cast<const T *>(m_inline); }
+
+        auto assign(const T *first, const T *last) -> void {
+            auto count = static_cast<size_type>(last - first);
+            reserve(count);
+            if (count > 0) {
+                std::memcpy(static_cast<void *>(m_data), first, count * sizeof(T));
+            }
+            m_size = count;
+        }
+
+        auto grow(size_type capacity) -> void {
+            T *heap = std::allocator<T>().allocate(capacity);
+            if (m_size > 0) {
+                std::memcpy(static_cast<void *>(heap), m_data, m_size * sizeof(T));
+            }
+            release_heap();
+            m_data = heap;
+            m_capacity = capacity;
+        }
+
+        auto release_heap() -> void {
+            if (!is_inline()) {
+                std::allocator<T>().deallocate(m_data, m_capacity);
+                m_data = inline_data();
+                m_capacity = N;
+            }
+        }
+
+        auto steal(SmallVector &other) -> void {
+            if (other.is_inline()) {
+                m_data = inline_data();
+                m_capacity = N;
+                if (other.m_size > 0) {
+                    std::memcpy(static_cast<void *>(m_data), other.m_data, other.m_size * sizeof(T));
+                }
+            } else {
+                m_data = other.m_data;
+                m_capacity = other.m_capacity;
+                other.m_data = other.inline_data();
+                other.m_capacity = N;
+            }
+            m_size = other.m_size;
+            other.m_size = 0;
+        }
+
+        alignas(T) std::byte m_inline[N * sizeof(T)];
+        T *m_data = inline_data();
+        size_type m_size = 0;
+        size_type m_capacity = N;
+    };
+} // namespace federation
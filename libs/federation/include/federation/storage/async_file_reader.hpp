@@ -0,0 +1,137 @@
+#pragma once
+
+#include "virtual_file_system.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <expected>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+    #ifdef FEDERATION_EXPORTS
+        #define FEDERATION_API __declspec(dllexport)
+    #else
+        #define FEDERATION_API __declspec(dllimport)
+    #endif
+#else
+    #define FEDERATION_API
+#endif
+
+namespace federation {
+
+    /**
+     * Asynchronous reads of native files
+     *
+     * On Linux reads are queued on an io_uring, so many reads stay in flight without a thread
+     * each; a single completion thread reaps them. Elsewhere, or when the kernel refuses to set
+     * up a ring (old kernels, seccomp-restricted containers), reads fall back to positional
+     * reads on the worker pool.
+     *
+     * Callbacks always run on the worker pool, never on the submitting thread, and may run
+     * concurrently with each other. Opening the file happens on the submitting thread; only
+     * the data transfer is asynchronous.
+     */
+    class FEDERATION_API AsyncFileReader {
+    public:
+        struct Config {
+            uint32_t queue_depth = 64;      // Reads in flight at once; more are queued until a slot frees
+            uint32_t worker_threads = 0;    // Callback (and fallback read) threads; 0 picks from the core count
+            bool use_io_uring = true;       // Set false to force the thread pool backend
+        };
+
+        enum class Backend {
+            IoUring,
+            ThreadPool,
+        };
+
+        AsyncFileReader();
+        explicit AsyncFileReader(const Config& config);
+
+        /**
+         * Waits for every outstanding read and callback
+         */
+        ~AsyncFileReader();
+
+        AsyncFileReader(const AsyncFileReader&) = delete;
+        AsyncFileReader& operator=(const AsyncFileReader&) = delete;
+
+        /**
+         * Read a whole file into a new buffer
+         */
+        auto read(const std::filesystem::path& path, ReadCallback callback) -> void;
+
+        /**
+         * Read up to destination.size() bytes from `offset` straight into caller memory (e.g. a
+         * mapped staging buffer), skipping the intermediate copy
+         * The destination must stay valid until the callback runs; the callback receives the
+         * number of bytes read, which is short only at end of file.
+         */
+        auto read_into(const std::filesystem::path& path, uint64_t offset, std::span<std::byte> destination,
+                       ReadIntoCallback callback) -> void;
+
+        /**
+         * Run a task on the worker pool (used for work that isn't a native read, like pack decompression)
+         */
+        auto submit(std::function<void()> task) -> void;
+
+        /**
+         * Block until every read submitted so far has completed and its callback returned
+         */
+        auto wait_idle() -> void;
+
+        [[nodiscard]] auto get_backend() const -> Backend { return m_ring ? Backend::IoUring : Backend::ThreadPool; }
+        [[nodiscard]] auto get_backend_name() const -> std::string_view;
+        [[nodiscard]] auto get_outstanding() const -> uint32_t { return m_outstanding.load(std::memory_order_relaxed); }
+
+    private:
+        class Ring;
+        struct ReadOp;
+
+        auto start(std::unique_ptr<ReadOp> op) -> void;
+        auto read_blocking(std::unique_ptr<ReadOp> op) -> void;
+
+        /**
+         * Queue the op's callback on the worker pool
+         */
+        auto post_result(std::unique_ptr<ReadOp> op, std::optional<std::string> error = std::nullopt) -> void;
+
+        /**
+         * Run the op's callback on the current (worker) thread and retire it
+         */
+        auto deliver(std::unique_ptr<ReadOp> op, const std::optional<std::string>& error) -> void;
+        auto post_task(std::function<void()> task) -> void;
+
+        // io_uring backend
+        auto submit_to_ring(std::unique_ptr<ReadOp> op) -> void;
+        auto submit_backlog() -> void;
+        auto completion_loop() -> void;
+
+        auto worker_loop(std::stop_token stop) -> void;
+
+        Config m_config;
+        std::unique_ptr<Ring> m_ring;
+        std::atomic<uint32_t> m_outstanding{0};  // Reads and tasks not yet finished
+
+        std::mutex m_submit_mutex;               // Ring submission side and backlog
+        std::deque<std::unique_ptr<ReadOp>> m_backlog;
+        uint32_t m_in_flight = 0;                // Ops owned by the kernel
+        std::jthread m_completion_thread;
+
+        std::mutex m_task_mutex;
+        std::condition_variable_any m_task_cv;
+        std::deque<std::function<void()>> m_tasks;
+        std::vector<std::jthread> m_workers;     // Declared last so they stop before the queues go away
+    };
+} // namespace federation
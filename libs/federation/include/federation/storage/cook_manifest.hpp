@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <ser20/ser20.hpp>
+#include <ser20/types/string.hpp>
+#include <ser20/types/vector.hpp>
+
+#ifdef _WIN32
+    #ifdef FEDERATION_EXPORTS
+        #define FEDERATION_API __declspec(dllexport)
+    #else
+        #define FEDERATION_API __declspec(dllimport)
+    #endif
+#else
+    #define FEDERATION_API
+#endif
+
+namespace federation {
+
+    /**
+     * One file a cooked output was built from, with the content hash and the stamp it had then
+     */
+    struct CookInput {
+        std::string path;               // VFS path
+        uint64_t hash = 0;              // hash_content() of the bytes
+        uint64_t size = 0;
+        int64_t mtime = 0;              // FileInfo::mtime ticks
+
+        template<class Archive>
+        void serialize(Archive& ar) {
+            ar(SER20_NVP(path), SER20_NVP(hash), SER20_NVP(size), SER20_NVP(mtime));
+        }
+    };
+
+    /**
+     * Another asset an output refers to by path (a model's textures); cooked on its own
+     */
+    struct CookReference {
+        std::string path;
+        std::string usage;              // e.g. "albedo", "normal"
+
+        template<class Archive>
+        void serialize(Archive& ar) {
+            ar(SER20_NVP(path), SER20_NVP(usage));
+        }
+    };
+
+    struct CookRecord {
+        std::string output;             // VFS path of the cooked file
+        std::string kind;               // "mesh", "texture", "shader"
+        uint64_t settings_hash = 0;     // Cook settings and cooker version
+        std::vector<CookInput> inputs;  // The source first, then everything it pulled in (includes, .mtl, ...)
+        std::vector<CookReference> references;
+
+        [[nodiscard]] auto get_source() const -> std::string_view {
+            return inputs.empty() ? std::string_view{} : std::string_view(inputs.front().path);
+        }
+
+        template<class Archive>
+        void serialize(Archive& ar) {
+            ar(SER20_NVP(output), SER20_NVP(kind), SER20_NVP(settings_hash), SER20_NVP(inputs),
+               SER20_NVP(references));
+        }
+    };
+
+    /**
+     * 64-bit FNV-1a of file contents, as stored in CookInput::hash
+     */
+    FEDERATION_API auto hash_content(std::span<const std::byte> data) -> uint64_t;
+
+    /**
+     * Record of what the offline cooker produced and from which inputs
+     *
+     * The cooker hashes inputs to decide what to re-cook. The engine only compares each input's
+     * size and modification time against the record, which is a stat per file and never reads
+     * contents, so checking every asset at startup stays cheap. Packed inputs carry no
+     * modification time and are compared by size alone.
+     */
+    class FEDERATION_API CookManifest {
+    public:
+        static constexpr uint32_t VERSION = 1;
+
+        /**
+         * Read a manifest through the VFS
+         */
+        static auto load(const std::filesystem::path& path) -> std::expected<CookManifest, std::string>;
+
+        /**
+         * Write to a temporary file and rename it over `path`
+         */
+        auto save(const std::filesystem::path& path) const -> std::expected<void, std::string>;
+
+        [[nodiscard]] auto find(std::string_view output) const -> const CookRecord*;
+        [[nodiscard]] auto find_by_source(std::string_view source) const -> const CookRecord*;
+
+        /**
+         * Add or replace the record for record.output
+         */
+        auto set(CookRecord record) -> void;
+        auto erase(std::string_view output) -> bool;
+
+        [[nodiscard]] auto get_records() const -> const std::map<std::string, CookRecord, std::less<>>& { return m_records; }
+
+        /**
+         * Output exists and every input still has its recorded stamp; reads no file contents
+         */
+        [[nodiscard]] auto is_fresh(const CookRecord& record) const -> bool;
+
+    private:
+        auto forget_source(const CookRecord& record) -> void;
+
+        std::map<std::string, CookRecord, std::less<>> m_records;   // By output; sorted so saves diff cleanly
+        std::unordered_map<std::string, std::string> m_by_source;   // Source -> output
+    };
+} // namespace federation
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <span>
+#include <string>
+
+#ifdef _WIN32
+    #ifdef FEDERATION_EXPORTS
+        #define FEDERATION_API __declspec(dllexport)
+    #else
+        #define FEDERATION_API __declspec(dllimport)
+    #endif
+#else
+    #define FEDERATION_API
+#endif
+
+namespace federation {
+
+    /**
+     * Read-only memory mapping of a whole file
+     * Pages are faulted in by the OS on first touch, so opening is O(1) regardless of size and
+     * readers can copy straight out of the page cache without an intermediate buffer.
+     * The mapping starts page aligned. Empty files map to an empty span.
+     */
+    class FEDERATION_API MappedFile {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        /**
+         * Map a file for reading
+         * @return The mapping, or a description of why the file couldn't be mapped
+         */
+        static auto open(const std::filesystem::path& path) -> std::expected<MappedFile, std::string>;
+
+        [[nodiscard]] auto get_data() const -> std::span<const std::byte> {
+            return {static_cast<const std::byte*>(m_data), m_size};
+        }
+        [[nodiscard]] auto get_size() const -> size_t { return m_size; }
+        [[nodiscard]] auto is_open() const -> bool { return m_data != nullptr || m_open_empty; }
+
+    private:
+        auto close() -> void;
+
+        void* m_data = nullptr;
+        size_t m_size = 0;
+        bool m_open_empty = false;
+#ifdef _WIN32
+        void* m_file = nullptr;      // HANDLE
+        void* m_mapping = nullptr;   // HANDLE
+#endif
+    };
+} // namespace federation
@@ -0,0 +1,180 @@
+#pragma once
+
+#include "mapped_file.hpp"
+#include "virtual_file_system.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+    #ifdef FEDERATION_EXPORTS
+        #define FEDERATION_API __declspec(dllexport)
+    #else
+        #define FEDERATION_API __declspec(dllimport)
+    #endif
+#else
+    #define FEDERATION_API
+#endif
+
+namespace federation {
+
+    /**
+     * Pack file format (.kpak)
+     *
+     * [PackHeader][entry data ...][PackEntry index][block table][path strings]
+     *
+     * The index is sorted by the 64-bit FNV-1a hash of each file's path (then by path), so a
+     * lookup is a binary search over fixed-size records followed by one string compare. Entry
+     * data starts at a configurable alignment from the start of the file, which keeps an
+     * uncompressed entry viewed in place through the pack's mapping correctly aligned for typed
+     * access (kmesh sections, SPIR-V words).
+     *
+     * Compressed entries are split into PACK_BLOCK_SIZE blocks of LZ4, stored back to back. The
+     * block table lists each block's stored size; a block whose stored size equals its raw size
+     * was incompressible and is stored verbatim.
+     */
+    constexpr uint32_t PACK_MAGIC = 0x4B41504B;  // "KPAK"
+    constexpr uint32_t PACK_VERSION = 1;
+    constexpr uint32_t PACK_BLOCK_SIZE = 64 * 1024;
+
+    static_assert(std::endian::native == std::endian::little, "pack files are read in place as little-endian");
+
+    enum class PackCompression : uint32_t {
+        None = 0,
+        LZ4 = 1,
+    };
+
+    struct PackHeader {
+        uint32_t magic = PACK_MAGIC;
+        uint32_t version = PACK_VERSION;
+        uint32_t entry_count = 0;
+        uint32_t block_size = PACK_BLOCK_SIZE;
+        uint64_t index_offset = 0;      // PackEntry[entry_count]
+        uint64_t blocks_offset = 0;     // uint32_t[block_count]
+        uint64_t block_count = 0;
+        uint64_t names_offset = 0;      // Path bytes, referenced by PackEntry::name_offset
+        uint64_t names_size = 0;
+        uint64_t _reserved = 0;
+    };
+    static_assert(sizeof(PackHeader) == 64);
+
+    struct PackEntry {
+        uint64_t path_hash = 0;
+        uint64_t data_offset = 0;       // From the start of the pack
+        uint64_t stored_size = 0;       // Bytes at data_offset
+        uint64_t size = 0;              // Uncompressed
+        uint32_t name_offset = 0;
+        uint32_t name_length = 0;
+        PackCompression compression = PackCompression::None;
+        uint32_t first_block = 0;       // Into the block table; ceil(size / block_size) blocks (LZ4 only)
+    };
+    static_assert(sizeof(PackEntry) == 48);
+
+    /**
+     * 64-bit FNV-1a of a normalized path, as stored in PackEntry::path_hash
+     */
+    FEDERATION_API auto hash_pack_path(std::string_view path) -> uint64_t;
+
+    /**
+     * Mounted pack file
+     * The whole pack is mapped once; uncompressed entries are returned as views into that
+     * mapping, compressed entries are decompressed into a buffer per read.
+     */
+    class FEDERATION_API PackArchive final : public VfsBackend {
+    public:
+        /**
+         * Map a pack and validate its header and tables
+         */
+        static auto open(const std::filesystem::path& path) -> std::expected<std::unique_ptr<PackArchive>, std::string>;
+
+        auto read(std::string_view path) const -> std::optional<FileData> override;
+        auto stat(std::string_view path) const -> std::optional<FileInfo> override;
+        [[nodiscard]] auto get_description() const -> std::string override { return m_path.string(); }
+
+        [[nodiscard]] auto get_entries() const -> std::span<const PackEntry> { return m_entries; }
+        [[nodiscard]] auto get_entry_path(const PackEntry& entry) const -> std::string_view;
+
+    private:
+        PackArchive() = default;
+
+        auto find(std::string_view path) const -> const PackEntry*;
+        auto decompress(const PackEntry& entry) const -> std::optional<std::vector<std::byte>>;
+
+        std::filesystem::path m_path;
+        std::shared_ptr<const MappedFile> m_mapping;
+        const PackHeader* m_header = nullptr;
+        std::span<const PackEntry> m_entries;
+        std::span<const uint32_t> m_blocks;
+        std::span<const char> m_names;
+    };
+
+    struct PackWriterSettings {
+        uint32_t alignment = 64;            // Power of two; entry data starts on this boundary
+        int compression_level = 9;          // LZ4 HC level; 0 selects the fast LZ4 compressor
+        float min_savings = 0.125f;         // Entries that shrink less than this are stored raw
+    };
+
+    struct PackStats {
+        uint32_t file_count = 0;
+        uint32_t compressed_count = 0;
+        uint64_t raw_bytes = 0;
+        uint64_t stored_bytes = 0;
+    };
+
+    /**
+     * Builds a pack from loose files and in-memory buffers
+     * Loose files are only recorded when added and read while writing, so packing a large
+     * tree doesn't hold it in memory.
+     */
+    class FEDERATION_API PackWriter {
+    public:
+        explicit PackWriter(const PackWriterSettings& settings = {});
+
+        /**
+         * Add a file from memory (copied); replaces an earlier file with the same pack path
+         */
+        auto add_file(std::string_view pack_path, std::span<const std::byte> data) -> void;
+
+        /**
+         * Add a file from disk, read when the pack is written
+         */
+        auto add_native_file(std::string_view pack_path, const std::filesystem::path& source) -> void;
+
+        /**
+         * Add every regular file under `directory`, at `prefix` + its relative path
+         * @return Number of files added
+         */
+        auto add_directory(const std::filesystem::path& directory, std::string_view prefix = "")
+            -> std::expected<uint32_t, std::string>;
+
+        /**
+         * Write the pack; written to a temporary file and renamed so readers never see a partial file
+         */
+        auto write(const std::filesystem::path& output) const -> std::expected<PackStats, std::string>;
+
+        [[nodiscard]] auto get_file_count() const -> size_t { return m_files.size(); }
+
+    private:
+        struct PendingFile {
+            std::string path;                   // Normalized pack path
+            std::filesystem::path source;       // Empty for in-memory files
+            std::vector<std::byte> data;
+        };
+
+        auto add(PendingFile file) -> void;
+
+        PackWriterSettings m_settings;
+        std::vector<PendingFile> m_files;
+        std::unordered_map<std::string, size_t> m_index;   // Pack path -> m_files slot
+    };
+} // namespace federation
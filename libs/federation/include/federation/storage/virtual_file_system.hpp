@@ -1,5 +1,22 @@
 #pragma once
 
+#include "mapped_file.hpp"
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
 #ifdef _WIN32
     #ifdef FEDERATION_EXPORTS
         #define FEDERATION_API __declspec(dllexport)
@@ -12,18 +29,222 @@
 
 namespace federation {
 
-    class FEDERATION_API VirtualFileSystem {
+    /**
+     * Read-only contents of one file
+     * Either a view into a shared mapping (loose files, uncompressed pack entries) or a buffer the
+     * file was decompressed into. Either way the storage is reference counted: copies are cheap,
+     * and the bytes stay valid for the lifetime of this object even if its mount is removed.
+     */
+    class FEDERATION_API FileData {
+    public:
+        FileData() = default;
+
+        static auto from_mapping(std::shared_ptr<const MappedFile> mapping, std::span<const std::byte> view) -> FileData;
+        static auto from_buffer(std::vector<std::byte> buffer) -> FileData;
+
+        [[nodiscard]] auto get_data() const -> std::span<const std::byte> { return m_view; }
+        [[nodiscard]] auto get_size() const -> size_t { return m_view.size(); }
+        [[nodiscard]] auto as_string_view() const -> std::string_view {
+            return {reinterpret_cast<const char*>(m_view.data()), m_view.size()};
+        }
+
+    private:
+        std::shared_ptr<const void> m_owner;        // Mapping or buffer backing m_view
+        std::span<const std::byte> m_view;
+    };
+
+    struct FileInfo {
+        uint64_t size = 0;      // Uncompressed
+        int64_t mtime = 0;      // std::filesystem::file_time_type ticks; 0 for packed files
+        bool packed = false;
+    };
+
+    /**
+     * Source of files for one mount
+     * Paths handed to a backend are already normalized and relative to its mount point.
+     * Implementations must be safe to call from several threads at once.
+     */
+    class FEDERATION_API VfsBackend {
+    public:
+        virtual ~VfsBackend() = default;
+
+        /**
+         * @return The file's contents, or nullopt if this backend doesn't provide it
+         */
+        virtual auto read(std::string_view path) const -> std::optional<FileData> = 0;
+        virtual auto stat(std::string_view path) const -> std::optional<FileInfo> = 0;
+
+        /**
+         * Where the file lives on disk, for tools that need a real path (hot reload, cook caches)
+         * @return Empty if the file is not backed by a loose file
+         */
+        virtual auto get_native_path(std::string_view path) const -> std::filesystem::path { return {}; }
 
+        [[nodiscard]] virtual auto get_description() const -> std::string = 0;
+    };
+
+    /**
+     * Loose files under a directory, each read through its own mapping
+     */
+    class FEDERATION_API DirectoryBackend final : public VfsBackend {
     public:
-        VirtualFileSystem() = default;
-        ~VirtualFileSystem() = default;
+        explicit DirectoryBackend(std::filesystem::path root);
+
+        auto read(std::string_view path) const -> std::optional<FileData> override;
+        auto stat(std::string_view path) const -> std::optional<FileInfo> override;
+        auto get_native_path(std::string_view path) const -> std::filesystem::path override;
+        [[nodiscard]] auto get_description() const -> std::string override { return m_root.string(); }
+
+    private:
+        std::filesystem::path m_root;
+    };
+
+    class AsyncFileReader;
+    class CookManifest;
+    class VirtualFileSystem;
+
+    using ReadCallback = std::function<void(std::expected<FileData, std::string>)>;
+    using ReadIntoCallback = std::function<void(std::expected<size_t, std::string>)>;
+
+    /**
+     * Awaitable returned by VirtualFileSystem::read_async(path)
+     * The coroutine resumes on an I/O worker thread, not the thread that awaited.
+     */
+    class FEDERATION_API ReadAwaitable {
+    public:
+        ReadAwaitable(const VirtualFileSystem& vfs, std::string path)
+            : m_vfs(&vfs), m_path(std::move(path)) {
+        }
+
+        [[nodiscard]] auto await_ready() const noexcept -> bool { return false; }
+        auto await_suspend(std::coroutine_handle<> handle) -> void;
+        auto await_resume() -> std::expected<FileData, std::string> { return std::move(*m_result); }
+
+    private:
+        const VirtualFileSystem* m_vfs;
+        std::string m_path;
+        std::optional<std::expected<FileData, std::string>> m_result;
+    };
+
+    /**
+     * Virtual file system - one read path for every asset, wherever it is stored
+     *
+     * Backends are mounted at a virtual directory ("" for the root). A lookup tries mounts from
+     * the most recently mounted to the oldest, so a patch pack mounted after the base pack
+     * overrides individual files. Paths that no mount provides fall back to the native file
+     * system relative to the working directory, which keeps loose development trees working
+     * without any mounts at all.
+     *
+     * Paths use '/' separators and are case sensitive; "\\", "./", "//" and ".." are normalized
+     * away before lookup. Reads, stats and mounts may happen concurrently from any thread.
+     */
+    class FEDERATION_API VirtualFileSystem {
+    public:
+        VirtualFileSystem();
+        ~VirtualFileSystem();
 
         VirtualFileSystem(const VirtualFileSystem&) = delete;
         VirtualFileSystem& operator=(const VirtualFileSystem&) = delete;
 
+        /**
+         * Process-wide instance used by the asset loaders
+         */
+        static auto get() -> VirtualFileSystem&;
+
+        auto mount(std::unique_ptr<VfsBackend> backend, std::string_view mount_point = "") -> void;
+        auto mount_directory(const std::filesystem::path& directory, std::string_view mount_point = "")
+            -> std::expected<void, std::string>;
+        auto mount_pack(const std::filesystem::path& pack_path, std::string_view mount_point = "")
+            -> std::expected<void, std::string>;
+
+        /**
+         * Remove every mount at `mount_point`
+         * Data already read stays valid.
+         */
+        auto unmount(std::string_view mount_point) -> void;
+
+        /**
+         * Toggle the native file system fallback (on by default); shipping builds that should
+         * only see their packs can turn it off
+         */
+        auto set_native_fallback(bool enabled) -> void;
+
+        [[nodiscard]] auto read(std::string_view path) const -> std::expected<FileData, std::string>;
+        [[nodiscard]] auto stat(std::string_view path) const -> std::optional<FileInfo>;
+        [[nodiscard]] auto exists(std::string_view path) const -> bool { return stat(path).has_value(); }
 
+        /**
+         * Read a file without blocking the caller
+         * Loose files go through the async reader (io_uring where available); packed files are
+         * read and decompressed on its worker pool. The callback runs on a worker thread.
+         */
+        auto read_async(std::string_view path, ReadCallback callback) const -> void;
+
+        /**
+         * Awaitable form of read_async: `auto data = co_await vfs.read_async(path);`
+         */
+        [[nodiscard]] auto read_async(std::string_view path) const -> ReadAwaitable { return {*this, std::string(path)}; }
+
+        /**
+         * Read up to destination.size() bytes starting at `offset` into caller memory, typically a
+         * mapped staging buffer; the destination must stay valid until the callback runs
+         */
+        auto read_into_async(std::string_view path, uint64_t offset, std::span<std::byte> destination,
+                             ReadIntoCallback callback) const -> void;
+
+        /**
+         * Reader behind the async reads, created on first use with the default configuration
+         */
+        [[nodiscard]] auto get_async_reader() const -> AsyncFileReader&;
+
+        /**
+         * Replace the async reader (e.g. with a different queue depth); waits for the old one to drain
+         */
+        auto set_async_reader(std::unique_ptr<AsyncFileReader> reader) -> void;
+
+        /**
+         * Install the offline cooker's manifest (or nullptr to remove it)
+         */
+        auto set_cook_manifest(std::shared_ptr<const CookManifest> manifest) -> void;
+
+        /**
+         * Cooked replacement for a source asset (a .ktx2 for a .png, a .spv for a .frag)
+         * Only returned while the manifest's record is fresh, so editing a source falls back to
+         * loading it directly until it is cooked again.
+         * @return Empty if there is no manifest, no record, or the record is stale
+         */
+        [[nodiscard]] auto get_cooked_path(std::string_view source) const -> std::optional<std::string>;
+
+        /**
+         * Native location of the file that would be read for `path`
+         * @return Empty if the winning copy is packed or the file doesn't exist
+         */
+        [[nodiscard]] auto get_native_path(std::string_view path) const -> std::filesystem::path;
+
+        /**
+         * Collapse separators, "." and ".." segments; the result never starts or ends with '/'
+         * unless the input is absolute
+         */
+        static auto normalize_path(std::string_view path) -> std::string;
 
     private:
+        struct Mount {
+            std::string mount_point;                // Normalized, empty for the root
+            std::unique_ptr<VfsBackend> backend;
+        };
+
+        /**
+         * @return The path relative to `mount_point`, or nullopt if it lies outside it
+         */
+        static auto strip_mount_point(std::string_view path, std::string_view mount_point) -> std::optional<std::string_view>;
+
+        mutable std::shared_mutex m_mutex;
+        std::vector<Mount> m_mounts;                // Oldest first; searched back to front
+        bool m_native_fallback = true;
+
+        std::shared_ptr<const CookManifest> m_cook_manifest;
 
+        mutable std::mutex m_async_mutex;
+        mutable std::unique_ptr<AsyncFileReader> m_async_reader;
     };
-} // namespace federation
\ No newline at end of file
+} // namespace federation
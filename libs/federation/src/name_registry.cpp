@@ -0,0 +1,50 @@
+#include "federation/name_registry.hpp"
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace federation {
+    namespace {
+        struct Registry {
+            std::mutex mutex;
+            // deque keeps element addresses stable, so the map can key on views into it
+            std::deque<std::string> names{std::string{}};
+            std::unordered_map<std::string_view, NameId> ids;
+        };
+
+        auto registry() -> Registry & {
+            static Registry instance;
+            return instance;
+        }
+    }
+
+    auto NameRegistry::intern(std::string_view name) -> NameId {
+        if (name.empty()) {
+            return INVALID_NAME_ID;
+        }
+
+        auto &reg = registry();
+        std::lock_guard lock(reg.mutex);
+
+        if (auto it = reg.ids.find(name); it != reg.ids.end()) {
+            return it->second;
+        }
+
+        auto id = static_cast<NameId>(reg.names.size());
+        const auto &stored = reg.names.emplace_back(name);
+        reg.ids.emplace(stored, id);
+        return id;
+    }
+
+    auto NameRegistry::lookup(NameId id) -> std::string_view {
+        auto &reg = registry();
+        std::lock_guard lock(reg.mutex);
+
+        if (id >= reg.names.size()) {
+            return {};
+        }
+        return reg.names[id];
+    }
+} // namespace federation
@@ -0,0 +1,572 @@
+#include "federation/storage/async_file_reader.hpp"
+#include "federation/log.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <format>
+#include <utility>
+
+#ifdef _WIN32
+    #include <fstream>
+#else
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <sys/uio.h>
+    #include <unistd.h>
+#endif
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+    #define FEDERATION_HAS_IO_URING 1
+    #include <linux/io_uring.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+#endif
+
+namespace federation {
+
+    struct AsyncFileReader::ReadOp {
+        std::filesystem::path path;
+        uint64_t offset = 0;                // Next file offset to read from
+        std::span<std::byte> destination;   // Remaining destination
+        size_t transferred = 0;
+        std::vector<std::byte> buffer;      // Whole-file reads own their destination
+        ReadCallback on_file;
+        ReadIntoCallback on_into;
+#ifdef _WIN32
+        std::ifstream file;
+#else
+        int fd = -1;
+        iovec iov{};                        // Must outlive the kernel's use of the SQE
+
+        ~ReadOp() {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+#endif
+    };
+
+#ifdef FEDERATION_HAS_IO_URING
+    /**
+     * Minimal io_uring wrapper over the raw syscalls
+     * The submission side must be serialized by the caller; the completion side has one reader.
+     */
+    class AsyncFileReader::Ring {
+    public:
+        static auto create(uint32_t entries) -> std::expected<std::unique_ptr<Ring>, std::string> {
+            io_uring_params params{};
+            const int fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+            if (fd < 0) {
+                return std::unexpected(std::format("io_uring_setup failed: {}", std::strerror(errno)));
+            }
+
+            std::unique_ptr<Ring> ring(new Ring());
+            ring->m_fd = fd;
+
+            ring->m_sq_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+            ring->m_cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+            if (single_mmap) {
+                ring->m_sq_size = ring->m_cq_size = std::max(ring->m_sq_size, ring->m_cq_size);
+            }
+
+            ring->m_sq_ptr = ::mmap(nullptr, ring->m_sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                    fd, IORING_OFF_SQ_RING);
+            if (ring->m_sq_ptr == MAP_FAILED) {
+                ring->m_sq_ptr = nullptr;
+                return std::unexpected("could not map the submission ring");
+            }
+            if (single_mmap) {
+                ring->m_cq_ptr = ring->m_sq_ptr;
+            } else {
+                ring->m_cq_ptr = ::mmap(nullptr, ring->m_cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                        fd, IORING_OFF_CQ_RING);
+                if (ring->m_cq_ptr == MAP_FAILED) {
+                    ring->m_cq_ptr = nullptr;
+                    return std::unexpected("could not map the completion ring");
+                }
+            }
+
+            ring->m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+            void* sqes = ::mmap(nullptr, ring->m_sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                fd, IORING_OFF_SQES);
+            if (sqes == MAP_FAILED) {
+                return std::unexpected("could not map the submission entries");
+            }
+            ring->m_sqes = static_cast<io_uring_sqe*>(sqes);
+
+            auto* sq = static_cast<std::byte*>(ring->m_sq_ptr);
+            auto* cq = static_cast<std::byte*>(ring->m_cq_ptr);
+            ring->m_sq_head = reinterpret_cast<uint32_t*>(sq + params.sq_off.head);
+            ring->m_sq_tail = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+            ring->m_sq_mask = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+            ring->m_sq_array = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+            ring->m_sq_entries = params.sq_entries;
+            ring->m_cq_head = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+            ring->m_cq_tail = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+            ring->m_cq_mask = *reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+            ring->m_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+            return ring;
+        }
+
+        ~Ring() {
+            if (m_sqes) {
+                ::munmap(m_sqes, m_sqes_size);
+            }
+            if (m_cq_ptr && m_cq_ptr != m_sq_ptr) {
+                ::munmap(m_cq_ptr, m_cq_size);
+            }
+            if (m_sq_ptr) {
+                ::munmap(m_sq_ptr, m_sq_size);
+            }
+            if (m_fd >= 0) {
+                ::close(m_fd);
+            }
+        }
+
+        [[nodiscard]] auto get_capacity() const -> uint32_t { return m_sq_entries; }
+
+        /**
+         * Queue one entry; it reaches the kernel on the next enter()
+         * @return False if the submission queue is full
+         */
+        auto push(const io_uring_sqe& entry) -> bool {
+            const uint32_t tail = *m_sq_tail;
+            const uint32_t head = std::atomic_ref(*m_sq_head).load(std::memory_order_acquire);
+            if (tail - head >= m_sq_entries) {
+                return false;
+            }
+            const uint32_t index = tail & m_sq_mask;
+            m_sqes[index] = entry;
+            m_sq_array[index] = index;
+            std::atomic_ref(*m_sq_tail).store(tail + 1, std::memory_order_release);
+            ++m_unsubmitted;
+            return true;
+        }
+
+        /**
+         * Hand queued entries to the kernel
+         * Entries it doesn't consume (short count or error) stay queued for the next flush.
+         * @return Entries consumed, or -errno
+         */
+        auto flush() -> int {
+            if (m_unsubmitted == 0) {
+                return 0;
+            }
+            const int result = enter(m_unsubmitted, 0, 0);
+            if (result > 0) {
+                m_unsubmitted -= std::min(static_cast<uint32_t>(result), m_unsubmitted);
+            }
+            return result;
+        }
+
+        [[nodiscard]] auto get_unsubmitted() const -> uint32_t { return m_unsubmitted; }
+
+        /**
+         * Take back entries the kernel hasn't consumed
+         * Safe without SQPOLL: the kernel only reads the submission queue inside io_uring_enter.
+         * @return Their user_data, oldest first
+         */
+        auto withdraw_unsubmitted() -> std::vector<uint64_t> {
+            const uint32_t head = std::atomic_ref(*m_sq_head).load(std::memory_order_acquire);
+            const uint32_t tail = *m_sq_tail;
+
+            std::vector<uint64_t> user_data;
+            user_data.reserve(tail - head);
+            for (uint32_t i = head; i != tail; ++i) {
+                user_data.push_back(m_sqes[m_sq_array[i & m_sq_mask]].user_data);
+            }
+            std::atomic_ref(*m_sq_tail).store(head, std::memory_order_release);
+            m_unsubmitted = 0;
+            return user_data;
+        }
+
+        auto wait(uint32_t min_complete) -> int {
+            return enter(0, min_complete, IORING_ENTER_GETEVENTS);
+        }
+
+        /**
+         * Hand every available completion to fn(user_data, result)
+         */
+        template<typename Fn>
+        auto reap(Fn&& fn) -> uint32_t {
+            uint32_t head = *m_cq_head;
+            const uint32_t tail = std::atomic_ref(*m_cq_tail).load(std::memory_order_acquire);
+            uint32_t count = 0;
+            for (; head != tail; ++head, ++count) {
+                const io_uring_cqe& cqe = m_cqes[head & m_cq_mask];
+                fn(cqe.user_data, cqe.res);
+            }
+            std::atomic_ref(*m_cq_head).store(head, std::memory_order_release);
+            return count;
+        }
+
+    private:
+        Ring() = default;
+
+        auto enter(uint32_t to_submit, uint32_t min_complete, uint32_t flags) -> int {
+            const auto result = ::syscall(__NR_io_uring_enter, m_fd, to_submit, min_complete, flags, nullptr, 0);
+            return result < 0 ? -errno : static_cast<int>(result);
+        }
+
+        int m_fd = -1;
+        void* m_sq_ptr = nullptr;
+        void* m_cq_ptr = nullptr;
+        size_t m_sq_size = 0;
+        size_t m_cq_size = 0;
+        io_uring_sqe* m_sqes = nullptr;
+        size_t m_sqes_size = 0;
+
+        uint32_t* m_sq_head = nullptr;
+        uint32_t* m_sq_tail = nullptr;
+        uint32_t* m_sq_array = nullptr;
+        uint32_t m_sq_mask = 0;
+        uint32_t m_sq_entries = 0;
+        uint32_t m_unsubmitted = 0;
+
+        uint32_t* m_cq_head = nullptr;
+        uint32_t* m_cq_tail = nullptr;
+        io_uring_cqe* m_cqes = nullptr;
+        uint32_t m_cq_mask = 0;
+    };
+#else
+    class AsyncFileReader::Ring {};
+#endif
+
+    namespace {
+        // user_data of the no-op that wakes the completion thread for shutdown
+        constexpr uint64_t WAKE_USER_DATA = 0;
+    }
+
+    AsyncFileReader::AsyncFileReader()
+        : AsyncFileReader(Config{}) {
+    }
+
+    AsyncFileReader::AsyncFileReader(const Config& config)
+        : m_config(config) {
+        m_config.queue_depth = std::max(m_config.queue_depth, 1u);
+
+#ifdef FEDERATION_HAS_IO_URING
+        if (m_config.use_io_uring) {
+            auto ring = Ring::create(std::bit_ceil(m_config.queue_depth + 1));
+            if (ring) {
+                m_ring = std::move(*ring);
+                // One slot stays free for the shutdown wake-up
+                m_config.queue_depth = std::min(m_config.queue_depth, m_ring->get_capacity() - 1);
+                m_completion_thread = std::jthread([this] { completion_loop(); });
+            } else {
+                FED_WARN("io_uring unavailable ({}), using thread pool reads", ring.error());
+            }
+        }
+#endif
+
+        uint32_t workers = m_config.worker_threads;
+        if (workers == 0) {
+            workers = std::clamp(std::thread::hardware_concurrency(), 2u, 8u);
+        }
+        // Without a ring the pool does the reading too, so it is the in-flight limit
+        if (!m_ring) {
+            workers = std::max(workers, std::min(m_config.queue_depth, 16u));
+        }
+        for (uint32_t i = 0; i < workers; ++i) {
+            m_workers.emplace_back([this](std::stop_token stop) { worker_loop(stop); });
+        }
+
+        FED_DEBUG("AsyncFileReader: {} backend, queue depth {}, {} workers",
+                  get_backend_name(), m_config.queue_depth, workers);
+    }
+
+    AsyncFileReader::~AsyncFileReader() {
+        wait_idle();
+
+#ifdef FEDERATION_HAS_IO_URING
+        if (m_ring) {
+            {
+                std::scoped_lock lock(m_submit_mutex);
+                io_uring_sqe wake{};
+                wake.opcode = IORING_OP_NOP;
+                wake.user_data = WAKE_USER_DATA;
+                m_ring->push(wake);
+                m_ring->flush();
+            }
+            m_completion_thread.join();
+        }
+#endif
+    }
+
+    auto AsyncFileReader::get_backend_name() const -> std::string_view {
+        return m_ring ? "io_uring" : "thread pool";
+    }
+
+    auto AsyncFileReader::read(const std::filesystem::path& path, ReadCallback callback) -> void {
+        auto op = std::make_unique<ReadOp>();
+        op->path = path;
+        op->on_file = std::move(callback);
+        start(std::move(op));
+    }
+
+    auto AsyncFileReader::read_into(const std::filesystem::path& path, uint64_t offset,
+                                    std::span<std::byte> destination, ReadIntoCallback callback) -> void {
+        auto op = std::make_unique<ReadOp>();
+        op->path = path;
+        op->offset = offset;
+        op->destination = destination;
+        op->on_into = std::move(callback);
+        start(std::move(op));
+    }
+
+    auto AsyncFileReader::submit(std::function<void()> task) -> void {
+        m_outstanding.fetch_add(1, std::memory_order_relaxed);
+        post_task([this, task = std::move(task)] {
+            task();
+            if (m_outstanding.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                m_outstanding.notify_all();
+            }
+        });
+    }
+
+    auto AsyncFileReader::wait_idle() -> void {
+        for (uint32_t outstanding = m_outstanding.load(std::memory_order_acquire); outstanding != 0;
+             outstanding = m_outstanding.load(std::memory_order_acquire)) {
+            m_outstanding.wait(outstanding, std::memory_order_acquire);
+        }
+    }
+
+    auto AsyncFileReader::start(std::unique_ptr<ReadOp> op) -> void {
+        m_outstanding.fetch_add(1, std::memory_order_relaxed);
+
+#ifdef _WIN32
+        op->file.open(op->path, std::ios::binary | std::ios::ate);
+        if (!op->file.is_open()) {
+            auto error = "could not open " + op->path.string();
+            post_result(std::move(op), std::move(error));
+            return;
+        }
+        const auto size = static_cast<uint64_t>(op->file.tellg());
+#else
+        op->fd = ::open(op->path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (op->fd < 0) {
+            auto error = std::format("could not open {}: {}", op->path.string(), std::strerror(errno));
+            post_result(std::move(op), std::move(error));
+            return;
+        }
+        struct stat info{};
+        if (::fstat(op->fd, &info) != 0) {
+            auto error = std::format("could not stat {}: {}", op->path.string(), std::strerror(errno));
+            post_result(std::move(op), std::move(error));
+            return;
+        }
+        const auto size = static_cast<uint64_t>(info.st_size);
+#endif
+
+        if (op->on_file) {
+            op->buffer.resize(size);
+            op->destination = op->buffer;
+        }
+        if (op->destination.empty()) {
+            post_result(std::move(op));
+            return;
+        }
+
+        if (m_ring) {
+            submit_to_ring(std::move(op));
+        } else {
+            // Fallback: the whole read runs on a worker
+            auto shared = std::make_shared<std::unique_ptr<ReadOp>>(std::move(op));
+            post_task([this, shared] { read_blocking(std::move(*shared)); });
+        }
+    }
+
+    auto AsyncFileReader::read_blocking(std::unique_ptr<ReadOp> op) -> void {
+#ifdef _WIN32
+        op->file.seekg(static_cast<std::streamoff>(op->offset));
+        op->file.read(reinterpret_cast<char*>(op->destination.data()),
+                      static_cast<std::streamsize>(op->destination.size()));
+        op->transferred = static_cast<size_t>(op->file.gcount());
+        if (op->file.bad()) {
+            auto error = "failed reading " + op->path.string();
+            deliver(std::move(op), error);
+            return;
+        }
+#else
+        while (!op->destination.empty()) {
+            const ssize_t count = ::pread(op->fd, op->destination.data(), op->destination.size(),
+                                          static_cast<off_t>(op->offset));
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                auto error = std::format("failed reading {}: {}", op->path.string(), std::strerror(errno));
+                deliver(std::move(op), error);
+                return;
+            }
+            if (count == 0) {
+                break;
+            }
+            op->offset += static_cast<uint64_t>(count);
+            op->transferred += static_cast<size_t>(count);
+            op->destination = op->destination.subspan(static_cast<size_t>(count));
+        }
+#endif
+        // Already on a worker, so the callback runs here
+        deliver(std::move(op), std::nullopt);
+    }
+
+    auto AsyncFileReader::post_result(std::unique_ptr<ReadOp> op, std::optional<std::string> error) -> void {
+        auto shared = std::make_shared<std::unique_ptr<ReadOp>>(std::move(op));
+        post_task([this, shared, error = std::move(error)] { deliver(std::move(*shared), error); });
+    }
+
+    auto AsyncFileReader::deliver(std::unique_ptr<ReadOp> op, const std::optional<std::string>& error) -> void {
+        if (op->on_file) {
+            if (error) {
+                op->on_file(std::unexpected(*error));
+            } else {
+                op->buffer.resize(op->transferred);
+                op->on_file(FileData::from_buffer(std::move(op->buffer)));
+            }
+        } else if (error) {
+            op->on_into(std::unexpected(*error));
+        } else {
+            op->on_into(op->transferred);
+        }
+
+        op.reset();
+        if (m_outstanding.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            m_outstanding.notify_all();
+        }
+    }
+
+    auto AsyncFileReader::post_task(std::function<void()> task) -> void {
+        {
+            std::scoped_lock lock(m_task_mutex);
+            m_tasks.push_back(std::move(task));
+        }
+        m_task_cv.notify_one();
+    }
+
+    auto AsyncFileReader::submit_to_ring(std::unique_ptr<ReadOp> op) -> void {
+#ifdef FEDERATION_HAS_IO_URING
+        std::scoped_lock lock(m_submit_mutex);
+        m_backlog.push_back(std::move(op));
+        submit_backlog();
+#else
+        (void)op;
+#endif
+    }
+
+    auto AsyncFileReader::submit_backlog() -> void {
+#ifdef FEDERATION_HAS_IO_URING
+        // Caller holds m_submit_mutex
+        while (!m_backlog.empty() && m_in_flight < m_config.queue_depth) {
+            ReadOp& op = *m_backlog.front();
+            op.iov.iov_base = op.destination.data();
+            op.iov.iov_len = op.destination.size();
+
+            io_uring_sqe entry{};
+            entry.opcode = IORING_OP_READV;
+            entry.fd = op.fd;
+            entry.addr = reinterpret_cast<uint64_t>(&op.iov);
+            entry.len = 1;
+            entry.off = op.offset;
+            entry.user_data = reinterpret_cast<uint64_t>(&op);
+            if (!m_ring->push(entry)) {
+                break;
+            }
+            m_backlog.front().release();
+            m_backlog.pop_front();
+            ++m_in_flight;
+        }
+
+        const int result = m_ring->flush();
+        const uint32_t pending = m_ring->get_unsubmitted();
+        if (pending == 0) {
+            return;
+        }
+
+        // Entries the kernel didn't take stay in the ring and go out with the flush that follows
+        // the next completion. With nothing in the kernel no completion is coming, and a hard
+        // error won't clear by retrying, so those reads fail instead.
+        const bool transient = result >= 0 || result == -EAGAIN || result == -EBUSY || result == -EINTR;
+        if (transient && m_in_flight > pending) {
+            return;
+        }
+
+        const std::string reason = result < 0 ? std::strerror(-result) : "no entries consumed";
+        FED_ERROR("io_uring submit failed: {} ({} reads dropped)", reason, pending);
+        for (const uint64_t user_data : m_ring->withdraw_unsubmitted()) {
+            std::unique_ptr<ReadOp> op(reinterpret_cast<ReadOp*>(user_data));
+            --m_in_flight;
+            auto error = std::format("could not submit read of {}: {}", op->path.string(), reason);
+            post_result(std::move(op), std::move(error));
+        }
+#endif
+    }
+
+    auto AsyncFileReader::completion_loop() -> void {
+#ifdef FEDERATION_HAS_IO_URING
+        bool running = true;
+        while (running) {
+            const int waited = m_ring->wait(1);
+            if (waited < 0 && waited != -EINTR) {
+                FED_ERROR("io_uring wait failed: {}", std::strerror(-waited));
+            }
+
+            std::vector<std::pair<ReadOp*, int32_t>> finished;
+            m_ring->reap([&](uint64_t user_data, int32_t result) {
+                if (user_data == WAKE_USER_DATA) {
+                    running = false;
+                } else {
+                    finished.emplace_back(reinterpret_cast<ReadOp*>(user_data), result);
+                }
+            });
+
+            std::vector<std::unique_ptr<ReadOp>> resubmit;
+            for (auto [raw, result] : finished) {
+                std::unique_ptr<ReadOp> op(raw);
+                if (result == -EINTR || result == -EAGAIN) {
+                    resubmit.push_back(std::move(op));
+                } else if (result < 0) {
+                    auto error = std::format("failed reading {}: {}", op->path.string(), std::strerror(-result));
+                    post_result(std::move(op), std::move(error));
+                } else {
+                    const auto count = static_cast<size_t>(result);
+                    op->offset += count;
+                    op->transferred += count;
+                    op->destination = op->destination.subspan(count);
+                    // Short reads continue where they stopped; zero means end of file
+                    if (count > 0 && !op->destination.empty()) {
+                        resubmit.push_back(std::move(op));
+                    } else {
+                        post_result(std::move(op));
+                    }
+                }
+            }
+
+            std::scoped_lock lock(m_submit_mutex);
+            m_in_flight -= static_cast<uint32_t>(finished.size());
+            for (auto& op : resubmit) {
+                m_backlog.push_front(std::move(op));
+            }
+            submit_backlog();
+        }
+#endif
+    }
+
+    auto AsyncFileReader::worker_loop(std::stop_token stop) -> void {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(m_task_mutex);
+                if (!m_task_cv.wait(lock, stop, [this] { return !m_tasks.empty(); })) {
+                    break;
+                }
+                task = std::move(m_tasks.front());
+                m_tasks.pop_front();
+            }
+            task();
+        }
+    }
+} // namespace federation
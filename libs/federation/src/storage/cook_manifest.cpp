@@ -0,0 +1,155 @@
+#include "federation/storage/cook_manifest.hpp"
+#include "federation/storage/virtual_file_system.hpp"
+
+#include <ser20/archives/json.hpp>
+
+#include <format>
+#include <fstream>
+#include <ranges>
+#include <spanstream>
+#include <system_error>
+#include <utility>
+
+namespace federation {
+    namespace {
+        /**
+         * On-disk layout; records are stored as a sorted array rather than a JSON object keyed by
+         * path so tools can read them without knowing the key scheme
+         */
+        struct ManifestFile {
+            uint32_t version = CookManifest::VERSION;
+            std::vector<CookRecord> records;
+
+            template<class Archive>
+            void serialize(Archive& ar) {
+                ar(SER20_NVP(version), SER20_NVP(records));
+            }
+        };
+    }
+
+    auto hash_content(std::span<const std::byte> data) -> uint64_t {
+        uint64_t hash = 14695981039346656037ull;
+        for (std::byte b : data) {
+            hash ^= static_cast<uint8_t>(b);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    auto CookManifest::load(const std::filesystem::path& path) -> std::expected<CookManifest, std::string> {
+        auto contents = VirtualFileSystem::get().read(path.generic_string());
+        if (!contents) {
+            return std::unexpected(contents.error());
+        }
+
+        ManifestFile file;
+        try {
+            std::ispanstream stream(contents->as_string_view());
+            ser20::JSONInputArchive archive(stream);
+            archive(ser20::make_nvp("manifest", file));
+        } catch (const std::exception& e) {
+            return std::unexpected(std::format("could not parse {}: {}", path.string(), e.what()));
+        }
+
+        if (file.version != VERSION) {
+            return std::unexpected(std::format("{} is version {}, expected {}", path.string(), file.version, VERSION));
+        }
+
+        CookManifest manifest;
+        for (auto& record : file.records) {
+            manifest.set(std::move(record));
+        }
+        return manifest;
+    }
+
+    auto CookManifest::save(const std::filesystem::path& path) const -> std::expected<void, std::string> {
+        ManifestFile file;
+        file.records.reserve(m_records.size());
+        for (const auto& record : m_records | std::views::values) {
+            file.records.push_back(record);
+        }
+
+        auto temp = path;
+        temp += ".tmp";
+        try {
+            if (auto parent = path.parent_path(); !parent.empty()) {
+                std::filesystem::create_directories(parent);
+            }
+
+            std::ofstream stream(temp);
+            if (!stream.is_open()) {
+                return std::unexpected(std::format("could not create {}", temp.string()));
+            }
+            {
+                ser20::JSONOutputArchive archive(stream, ser20::JSONOutputArchive::Options::Default());
+                archive(ser20::make_nvp("manifest", file));
+            }
+            stream.close();
+            if (!stream) {
+                return std::unexpected(std::format("failed writing {}", temp.string()));
+            }
+        } catch (const std::exception& e) {
+            return std::unexpected(std::format("failed writing {}: {}", temp.string(), e.what()));
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(temp, path, ec);
+        if (ec) {
+            return std::unexpected(std::format("could not replace {}: {}", path.string(), ec.message()));
+        }
+        return {};
+    }
+
+    auto CookManifest::find(std::string_view output) const -> const CookRecord* {
+        auto it = m_records.find(output);
+        return it != m_records.end() ? &it->second : nullptr;
+    }
+
+    auto CookManifest::find_by_source(std::string_view source) const -> const CookRecord* {
+        auto it = m_by_source.find(std::string(source));
+        return it != m_by_source.end() ? find(it->second) : nullptr;
+    }
+
+    auto CookManifest::set(CookRecord record) -> void {
+        if (auto* previous = find(record.output)) {
+            forget_source(*previous);
+        }
+        if (!record.inputs.empty()) {
+            m_by_source[std::string(record.get_source())] = record.output;
+        }
+        auto output = record.output;
+        m_records.insert_or_assign(std::move(output), std::move(record));
+    }
+
+    auto CookManifest::erase(std::string_view output) -> bool {
+        auto it = m_records.find(output);
+        if (it == m_records.end()) {
+            return false;
+        }
+        forget_source(it->second);
+        m_records.erase(it);
+        return true;
+    }
+
+    auto CookManifest::forget_source(const CookRecord& record) -> void {
+        // Only if it still maps to this record; another output may have claimed the source since
+        auto it = m_by_source.find(std::string(record.get_source()));
+        if (it != m_by_source.end() && it->second == record.output) {
+            m_by_source.erase(it);
+        }
+    }
+
+    auto CookManifest::is_fresh(const CookRecord& record) const -> bool {
+        auto& vfs = VirtualFileSystem::get();
+        if (!vfs.exists(record.output)) {
+            return false;
+        }
+        for (const auto& input : record.inputs) {
+            auto info = vfs.stat(input.path);
+            if (!info || info->size != input.size || (!info->packed && info->mtime != input.mtime)) {
+                return false;
+            }
+        }
+        return true;
+    }
+} // namespace federation
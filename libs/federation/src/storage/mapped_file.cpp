@@ -0,0 +1,146 @@
+#include "federation/storage/mapped_file.hpp"
+
+#include <utility>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <cerrno>
+    #include <cstring>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace federation {
+
+    MappedFile::~MappedFile() {
+        close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : m_data(std::exchange(other.m_data, nullptr))
+        , m_size(std::exchange(other.m_size, 0))
+        , m_open_empty(std::exchange(other.m_open_empty, false))
+#ifdef _WIN32
+        , m_file(std::exchange(other.m_file, nullptr))
+        , m_mapping(std::exchange(other.m_mapping, nullptr))
+#endif
+    {
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+            m_open_empty = std::exchange(other.m_open_empty, false);
+#ifdef _WIN32
+            m_file = std::exchange(other.m_file, nullptr);
+            m_mapping = std::exchange(other.m_mapping, nullptr);
+#endif
+        }
+        return *this;
+    }
+
+#ifdef _WIN32
+    auto MappedFile::open(const std::filesystem::path& path) -> std::expected<MappedFile, std::string> {
+        MappedFile mapped;
+
+        HANDLE file = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                    FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return std::unexpected("could not open " + path.string());
+        }
+        mapped.m_file = file;
+
+        LARGE_INTEGER size{};
+        if (!::GetFileSizeEx(file, &size)) {
+            return std::unexpected("could not stat " + path.string());
+        }
+        if (size.QuadPart == 0) {
+            mapped.m_open_empty = true;
+            return mapped;
+        }
+
+        HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            return std::unexpected("could not create a mapping for " + path.string());
+        }
+        mapped.m_mapping = mapping;
+
+        mapped.m_data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!mapped.m_data) {
+            return std::unexpected("could not map " + path.string());
+        }
+        mapped.m_size = static_cast<size_t>(size.QuadPart);
+        return mapped;
+    }
+
+    auto MappedFile::close() -> void {
+        if (m_data) {
+            ::UnmapViewOfFile(m_data);
+        }
+        if (m_mapping) {
+            ::CloseHandle(m_mapping);
+        }
+        if (m_file) {
+            ::CloseHandle(m_file);
+        }
+        m_data = nullptr;
+        m_mapping = nullptr;
+        m_file = nullptr;
+        m_size = 0;
+        m_open_empty = false;
+    }
+#else
+    auto MappedFile::open(const std::filesystem::path& path) -> std::expected<MappedFile, std::string> {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return std::unexpected("could not open " + path.string() + ": " + std::strerror(errno));
+        }
+
+        struct stat info{};
+        if (::fstat(fd, &info) != 0) {
+            const int error = errno;
+            ::close(fd);
+            return std::unexpected("could not stat " + path.string() + ": " + std::strerror(error));
+        }
+
+        MappedFile mapped;
+        if (info.st_size == 0) {
+            ::close(fd);
+            mapped.m_open_empty = true;
+            return mapped;
+        }
+
+        const auto size = static_cast<size_t>(info.st_size);
+        void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        const int error = errno;
+        // The mapping keeps its own reference to the file
+        ::close(fd);
+        if (data == MAP_FAILED) {
+            return std::unexpected("could not map " + path.string() + ": " + std::strerror(error));
+        }
+
+        // Callers are about to read most of the file; start paging it in now
+        ::madvise(data, size, MADV_WILLNEED);
+
+        mapped.m_data = data;
+        mapped.m_size = size;
+        return mapped;
+    }
+
+    auto MappedFile::close() -> void {
+        if (m_data) {
+            ::munmap(m_data, m_size);
+        }
+        m_data = nullptr;
+        m_size = 0;
+        m_open_empty = false;
+    }
+#endif
+} // namespace federation
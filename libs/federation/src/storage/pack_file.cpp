@@ -0,0 +1,381 @@
+#include "federation/storage/pack_file.hpp"
+#include "federation/log.hpp"
+
+#include <lz4.h>
+#include <lz4hc.h>
+
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <system_error>
+#include <utility>
+
+namespace federation {
+    namespace {
+        template<typename T>
+        auto view_table(std::span<const std::byte> bytes, uint64_t offset, uint64_t count)
+            -> std::optional<std::span<const T>> {
+            if (offset % alignof(T) != 0 || offset > bytes.size() || count > (bytes.size() - offset) / sizeof(T)) {
+                return std::nullopt;
+            }
+            return std::span<const T>(reinterpret_cast<const T*>(bytes.data() + offset), static_cast<size_t>(count));
+        }
+
+        auto block_count_for(uint64_t size, uint32_t block_size) -> uint64_t {
+            return (size + block_size - 1) / block_size;
+        }
+
+        auto write_padding(std::ofstream& out, uint64_t& position, uint64_t alignment) -> void {
+            static constexpr char zeros[256] = {};
+            uint64_t padding = (alignment - position % alignment) % alignment;
+            position += padding;
+            while (padding > 0) {
+                const auto chunk = std::min<uint64_t>(padding, sizeof(zeros));
+                out.write(zeros, static_cast<std::streamsize>(chunk));
+                padding -= chunk;
+            }
+        }
+
+        auto write_bytes(std::ofstream& out, uint64_t& position, std::span<const std::byte> bytes) -> void {
+            out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+            position += bytes.size();
+        }
+
+        /**
+         * An entry's stored form: either the raw bytes or LZ4 blocks plus their sizes
+         */
+        struct EncodedEntry {
+            std::vector<std::byte> compressed;
+            std::vector<uint32_t> block_sizes;
+        };
+
+        auto compress_blocks(std::span<const std::byte> data, int level) -> EncodedEntry {
+            EncodedEntry encoded;
+            std::vector<char> scratch(static_cast<size_t>(LZ4_compressBound(static_cast<int>(PACK_BLOCK_SIZE))));
+
+            for (size_t offset = 0; offset < data.size(); offset += PACK_BLOCK_SIZE) {
+                const auto block = data.subspan(offset, std::min<size_t>(PACK_BLOCK_SIZE, data.size() - offset));
+                const auto* source = reinterpret_cast<const char*>(block.data());
+                const int source_size = static_cast<int>(block.size());
+                const int capacity = static_cast<int>(scratch.size());
+
+                const int written = level > 0
+                    ? LZ4_compress_HC(source, scratch.data(), source_size, capacity, level)
+                    : LZ4_compress_default(source, scratch.data(), source_size, capacity);
+
+                // A block that doesn't shrink is stored verbatim; the reader tells by its size
+                if (written <= 0 || written >= source_size) {
+                    encoded.compressed.insert(encoded.compressed.end(), block.begin(), block.end());
+                    encoded.block_sizes.push_back(static_cast<uint32_t>(block.size()));
+                } else {
+                    const auto* bytes = reinterpret_cast<const std::byte*>(scratch.data());
+                    encoded.compressed.insert(encoded.compressed.end(), bytes, bytes + written);
+                    encoded.block_sizes.push_back(static_cast<uint32_t>(written));
+                }
+            }
+            return encoded;
+        }
+    }
+
+    auto hash_pack_path(std::string_view path) -> uint64_t {
+        uint64_t hash = 14695981039346656037ull;
+        for (char c : path) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    auto PackArchive::open(const std::filesystem::path& path) -> std::expected<std::unique_ptr<PackArchive>, std::string> {
+        auto mapped = MappedFile::open(path);
+        if (!mapped) {
+            return std::unexpected(mapped.error());
+        }
+
+        std::unique_ptr<PackArchive> archive(new PackArchive());
+        archive->m_path = path;
+        archive->m_mapping = std::make_shared<const MappedFile>(std::move(*mapped));
+
+        const auto bytes = archive->m_mapping->get_data();
+        if (bytes.size() < sizeof(PackHeader)) {
+            return std::unexpected(std::format("{}: too small for a pack header", path.string()));
+        }
+        const auto* header = reinterpret_cast<const PackHeader*>(bytes.data());
+        if (header->magic != PACK_MAGIC) {
+            return std::unexpected(std::format("{}: not a pack file", path.string()));
+        }
+        if (header->version != PACK_VERSION) {
+            return std::unexpected(std::format("{}: unsupported pack version {} (expected {})",
+                                               path.string(), header->version, PACK_VERSION));
+        }
+        if (header->block_size == 0 || header->block_size > static_cast<uint32_t>(LZ4_MAX_INPUT_SIZE)) {
+            return std::unexpected(std::format("{}: invalid block size", path.string()));
+        }
+
+        auto entries = view_table<PackEntry>(bytes, header->index_offset, header->entry_count);
+        auto blocks = view_table<uint32_t>(bytes, header->blocks_offset, header->block_count);
+        auto names = view_table<char>(bytes, header->names_offset, header->names_size);
+        if (!entries || !blocks || !names) {
+            return std::unexpected(std::format("{}: table out of bounds", path.string()));
+        }
+
+        for (const auto& entry : *entries) {
+            if (entry.data_offset > bytes.size() || entry.stored_size > bytes.size() - entry.data_offset ||
+                static_cast<uint64_t>(entry.name_offset) + entry.name_length > names->size()) {
+                return std::unexpected(std::format("{}: entry out of bounds", path.string()));
+            }
+            if (entry.compression == PackCompression::None) {
+                if (entry.stored_size != entry.size) {
+                    return std::unexpected(std::format("{}: raw entry size mismatch", path.string()));
+                }
+            } else if (entry.compression == PackCompression::LZ4) {
+                if (entry.first_block + block_count_for(entry.size, header->block_size) > blocks->size()) {
+                    return std::unexpected(std::format("{}: block range out of bounds", path.string()));
+                }
+            } else {
+                return std::unexpected(std::format("{}: unknown compression {}",
+                                                   path.string(), static_cast<uint32_t>(entry.compression)));
+            }
+        }
+
+        archive->m_header = header;
+        archive->m_entries = *entries;
+        archive->m_blocks = *blocks;
+        archive->m_names = *names;
+
+        FED_DEBUG("Opened pack {} ({} files)", path.string(), header->entry_count);
+        return archive;
+    }
+
+    auto PackArchive::get_entry_path(const PackEntry& entry) const -> std::string_view {
+        return {m_names.data() + entry.name_offset, entry.name_length};
+    }
+
+    auto PackArchive::find(std::string_view path) const -> const PackEntry* {
+        const uint64_t hash = hash_pack_path(path);
+        auto it = std::lower_bound(m_entries.begin(), m_entries.end(), hash,
+                                   [](const PackEntry& entry, uint64_t value) { return entry.path_hash < value; });
+        for (; it != m_entries.end() && it->path_hash == hash; ++it) {
+            if (get_entry_path(*it) == path) {
+                return &*it;
+            }
+        }
+        return nullptr;
+    }
+
+    auto PackArchive::stat(std::string_view path) const -> std::optional<FileInfo> {
+        const auto* entry = find(path);
+        if (!entry) {
+            return std::nullopt;
+        }
+        return FileInfo{entry->size, 0, true};
+    }
+
+    auto PackArchive::read(std::string_view path) const -> std::optional<FileData> {
+        const auto* entry = find(path);
+        if (!entry) {
+            return std::nullopt;
+        }
+
+        const auto stored = m_mapping->get_data().subspan(entry->data_offset, entry->stored_size);
+        if (entry->compression == PackCompression::None) {
+            return FileData::from_mapping(m_mapping, stored);
+        }
+
+        auto decompressed = decompress(*entry);
+        if (!decompressed) {
+            FED_ERROR("Pack {}: corrupt entry {}", m_path.string(), path);
+            return std::nullopt;
+        }
+        return FileData::from_buffer(std::move(*decompressed));
+    }
+
+    auto PackArchive::decompress(const PackEntry& entry) const -> std::optional<std::vector<std::byte>> {
+        const uint32_t block_size = m_header->block_size;
+        const auto stored = m_mapping->get_data().subspan(entry.data_offset, entry.stored_size);
+        const auto sizes = m_blocks.subspan(entry.first_block, block_count_for(entry.size, block_size));
+
+        std::vector<std::byte> out(entry.size);
+        uint64_t read_offset = 0;
+        uint64_t write_offset = 0;
+        for (uint32_t stored_block : sizes) {
+            const auto raw_block = static_cast<uint32_t>(std::min<uint64_t>(block_size, entry.size - write_offset));
+            if (stored_block > stored.size() - read_offset) {
+                return std::nullopt;
+            }
+
+            const auto* source = stored.data() + read_offset;
+            auto* destination = out.data() + write_offset;
+            if (stored_block == raw_block) {
+                std::memcpy(destination, source, raw_block);
+            } else {
+                const int decoded = LZ4_decompress_safe(reinterpret_cast<const char*>(source),
+                                                        reinterpret_cast<char*>(destination),
+                                                        static_cast<int>(stored_block), static_cast<int>(raw_block));
+                if (decoded != static_cast<int>(raw_block)) {
+                    return std::nullopt;
+                }
+            }
+            read_offset += stored_block;
+            write_offset += raw_block;
+        }
+        return out;
+    }
+
+    PackWriter::PackWriter(const PackWriterSettings& settings)
+        : m_settings(settings) {
+        if (!std::has_single_bit(m_settings.alignment) || m_settings.alignment < alignof(PackEntry)) {
+            FED_WARN("Pack alignment {} is not a power of two >= {}, using 64", m_settings.alignment, alignof(PackEntry));
+            m_settings.alignment = 64;
+        }
+    }
+
+    auto PackWriter::add(PendingFile file) -> void {
+        auto [it, inserted] = m_index.try_emplace(file.path, m_files.size());
+        if (inserted) {
+            m_files.push_back(std::move(file));
+        } else {
+            m_files[it->second] = std::move(file);
+        }
+    }
+
+    auto PackWriter::add_file(std::string_view pack_path, std::span<const std::byte> data) -> void {
+        add(PendingFile{VirtualFileSystem::normalize_path(pack_path), {}, {data.begin(), data.end()}});
+    }
+
+    auto PackWriter::add_native_file(std::string_view pack_path, const std::filesystem::path& source) -> void {
+        add(PendingFile{VirtualFileSystem::normalize_path(pack_path), source, {}});
+    }
+
+    auto PackWriter::add_directory(const std::filesystem::path& directory, std::string_view prefix)
+        -> std::expected<uint32_t, std::string> {
+        std::error_code ec;
+        std::filesystem::recursive_directory_iterator it(directory, ec);
+        if (ec) {
+            return std::unexpected(std::format("could not list {}: {}", directory.string(), ec.message()));
+        }
+
+        uint32_t added = 0;
+        for (const auto& item : it) {
+            if (!item.is_regular_file()) {
+                continue;
+            }
+            const auto relative = std::filesystem::relative(item.path(), directory).generic_string();
+            add_native_file(prefix.empty() ? relative : std::format("{}/{}", prefix, relative), item.path());
+            ++added;
+        }
+        return added;
+    }
+
+    auto PackWriter::write(const std::filesystem::path& output) const -> std::expected<PackStats, std::string> {
+        // Sorted up front so the index is written in lookup order and the data in the same order
+        std::vector<const PendingFile*> order;
+        order.reserve(m_files.size());
+        for (const auto& file : m_files) {
+            order.push_back(&file);
+        }
+        std::sort(order.begin(), order.end(), [](const PendingFile* a, const PendingFile* b) {
+            const uint64_t hash_a = hash_pack_path(a->path);
+            const uint64_t hash_b = hash_pack_path(b->path);
+            return hash_a != hash_b ? hash_a < hash_b : a->path < b->path;
+        });
+
+        if (output.has_parent_path()) {
+            std::error_code ec;
+            std::filesystem::create_directories(output.parent_path(), ec);
+        }
+
+        auto temp_path = output;
+        temp_path += ".tmp";
+        std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            return std::unexpected("could not open " + temp_path.string() + " for writing");
+        }
+
+        PackHeader header{};
+        uint64_t position = 0;
+        write_bytes(out, position, std::as_bytes(std::span(&header, 1)));
+
+        PackStats stats;
+        std::vector<PackEntry> entries;
+        std::vector<uint32_t> blocks;
+        std::string names;
+        entries.reserve(order.size());
+
+        for (const PendingFile* file : order) {
+            // Loose sources are mapped only while their entry is being written
+            MappedFile mapped;
+            std::span<const std::byte> data = file->data;
+            if (!file->source.empty()) {
+                auto opened = MappedFile::open(file->source);
+                if (!opened) {
+                    out.close();
+                    std::error_code ec;
+                    std::filesystem::remove(temp_path, ec);
+                    return std::unexpected(opened.error());
+                }
+                mapped = std::move(*opened);
+                data = mapped.get_data();
+            }
+
+            PackEntry& entry = entries.emplace_back();
+            entry.path_hash = hash_pack_path(file->path);
+            entry.size = data.size();
+            entry.name_offset = static_cast<uint32_t>(names.size());
+            entry.name_length = static_cast<uint32_t>(file->path.size());
+            names += file->path;
+
+            write_padding(out, position, m_settings.alignment);
+            entry.data_offset = position;
+
+            auto encoded = compress_blocks(data, m_settings.compression_level);
+            const auto threshold = static_cast<double>(data.size()) * (1.0 - m_settings.min_savings);
+            if (!data.empty() && static_cast<double>(encoded.compressed.size()) <= threshold) {
+                entry.compression = PackCompression::LZ4;
+                entry.first_block = static_cast<uint32_t>(blocks.size());
+                blocks.insert(blocks.end(), encoded.block_sizes.begin(), encoded.block_sizes.end());
+                write_bytes(out, position, encoded.compressed);
+                ++stats.compressed_count;
+            } else {
+                entry.compression = PackCompression::None;
+                write_bytes(out, position, data);
+            }
+            entry.stored_size = position - entry.data_offset;
+
+            ++stats.file_count;
+            stats.raw_bytes += entry.size;
+            stats.stored_bytes += entry.stored_size;
+        }
+
+        write_padding(out, position, alignof(PackEntry));
+        header.index_offset = position;
+        header.entry_count = static_cast<uint32_t>(entries.size());
+        write_bytes(out, position, std::as_bytes(std::span(entries)));
+
+        header.blocks_offset = position;
+        header.block_count = blocks.size();
+        write_bytes(out, position, std::as_bytes(std::span(blocks)));
+
+        header.names_offset = position;
+        header.names_size = names.size();
+        write_bytes(out, position, std::as_bytes(std::span(names.data(), names.size())));
+
+        out.seekp(0);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.close();
+        if (!out) {
+            std::error_code ec;
+            std::filesystem::remove(temp_path, ec);
+            return std::unexpected("failed writing " + temp_path.string());
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(temp_path, output, ec);
+        if (ec) {
+            std::filesystem::remove(temp_path, ec);
+            return std::unexpected("could not replace " + output.string());
+        }
+        return stats;
+    }
+} // namespace federation
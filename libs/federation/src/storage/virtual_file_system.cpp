@@ -0,0 +1,334 @@
+#include "federation/storage/virtual_file_system.hpp"
+#include "federation/storage/async_file_reader.hpp"
+#include "federation/storage/cook_manifest.hpp"
+#include "federation/storage/pack_file.hpp"
+#include "federation/log.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <mutex>
+#include <ranges>
+#include <system_error>
+#include <utility>
+
+namespace federation {
+    namespace {
+        auto stat_native(const std::filesystem::path& path) -> std::optional<FileInfo> {
+            std::error_code ec;
+            if (!std::filesystem::is_regular_file(path, ec)) {
+                return std::nullopt;
+            }
+            const auto size = std::filesystem::file_size(path, ec);
+            if (ec) {
+                return std::nullopt;
+            }
+            const auto mtime = std::filesystem::last_write_time(path, ec);
+            if (ec) {
+                return std::nullopt;
+            }
+            return FileInfo{size, static_cast<int64_t>(mtime.time_since_epoch().count()), false};
+        }
+
+        auto read_native(const std::filesystem::path& path) -> std::optional<FileData> {
+            auto mapped = MappedFile::open(path);
+            if (!mapped) {
+                return std::nullopt;
+            }
+            auto shared = std::make_shared<const MappedFile>(std::move(*mapped));
+            const auto view = shared->get_data();
+            return FileData::from_mapping(std::move(shared), view);
+        }
+
+        /**
+         * Absolute paths and paths escaping the working directory only resolve natively
+         */
+        auto is_mountable(std::string_view normalized) -> bool {
+            const bool absolute = normalized.starts_with('/') || (normalized.size() >= 2 && normalized[1] == ':');
+            return !absolute && normalized != ".." && !normalized.starts_with("../");
+        }
+    }
+
+    auto FileData::from_mapping(std::shared_ptr<const MappedFile> mapping, std::span<const std::byte> view) -> FileData {
+        FileData data;
+        data.m_view = view;
+        data.m_owner = std::move(mapping);
+        return data;
+    }
+
+    auto FileData::from_buffer(std::vector<std::byte> buffer) -> FileData {
+        auto owned = std::make_shared<const std::vector<std::byte>>(std::move(buffer));
+        FileData data;
+        data.m_view = std::span<const std::byte>(*owned);
+        data.m_owner = std::move(owned);
+        return data;
+    }
+
+    DirectoryBackend::DirectoryBackend(std::filesystem::path root)
+        : m_root(std::move(root)) {
+    }
+
+    auto DirectoryBackend::read(std::string_view path) const -> std::optional<FileData> {
+        return read_native(m_root / path);
+    }
+
+    auto DirectoryBackend::stat(std::string_view path) const -> std::optional<FileInfo> {
+        return stat_native(m_root / path);
+    }
+
+    auto DirectoryBackend::get_native_path(std::string_view path) const -> std::filesystem::path {
+        auto native = m_root / path;
+        std::error_code ec;
+        return std::filesystem::is_regular_file(native, ec) ? native : std::filesystem::path{};
+    }
+
+    auto ReadAwaitable::await_suspend(std::coroutine_handle<> handle) -> void {
+        m_vfs->read_async(m_path, [this, handle](std::expected<FileData, std::string> result) {
+            m_result.emplace(std::move(result));
+            handle.resume();
+        });
+    }
+
+    VirtualFileSystem::VirtualFileSystem() = default;
+
+    VirtualFileSystem::~VirtualFileSystem() = default;
+
+    auto VirtualFileSystem::get() -> VirtualFileSystem& {
+        static VirtualFileSystem instance;
+        return instance;
+    }
+
+    auto VirtualFileSystem::mount(std::unique_ptr<VfsBackend> backend, std::string_view mount_point) -> void {
+        auto normalized = normalize_path(mount_point);
+        FED_INFO("VFS: mounted {} at '/{}'", backend->get_description(), normalized);
+
+        std::unique_lock lock(m_mutex);
+        m_mounts.push_back(Mount{std::move(normalized), std::move(backend)});
+    }
+
+    auto VirtualFileSystem::mount_directory(const std::filesystem::path& directory, std::string_view mount_point)
+        -> std::expected<void, std::string> {
+        std::error_code ec;
+        if (!std::filesystem::is_directory(directory, ec)) {
+            return std::unexpected(std::format("{} is not a directory", directory.string()));
+        }
+        mount(std::make_unique<DirectoryBackend>(directory), mount_point);
+        return {};
+    }
+
+    auto VirtualFileSystem::mount_pack(const std::filesystem::path& pack_path, std::string_view mount_point)
+        -> std::expected<void, std::string> {
+        auto archive = PackArchive::open(pack_path);
+        if (!archive) {
+            return std::unexpected(archive.error());
+        }
+        mount(std::move(*archive), mount_point);
+        return {};
+    }
+
+    auto VirtualFileSystem::unmount(std::string_view mount_point) -> void {
+        const auto normalized = normalize_path(mount_point);
+
+        std::unique_lock lock(m_mutex);
+        std::erase_if(m_mounts, [&](const Mount& mount) { return mount.mount_point == normalized; });
+    }
+
+    auto VirtualFileSystem::set_native_fallback(bool enabled) -> void {
+        std::unique_lock lock(m_mutex);
+        m_native_fallback = enabled;
+    }
+
+    auto VirtualFileSystem::set_cook_manifest(std::shared_ptr<const CookManifest> manifest) -> void {
+        std::unique_lock lock(m_mutex);
+        m_cook_manifest = std::move(manifest);
+    }
+
+    auto VirtualFileSystem::get_cooked_path(std::string_view source) const -> std::optional<std::string> {
+        std::shared_ptr<const CookManifest> manifest;
+        {
+            std::shared_lock lock(m_mutex);
+            manifest = m_cook_manifest;
+        }
+        if (!manifest) {
+            return std::nullopt;
+        }
+
+        // Checked outside the lock: freshness stats go back through this VFS
+        const auto* record = manifest->find_by_source(normalize_path(source));
+        if (!record || !manifest->is_fresh(*record)) {
+            return std::nullopt;
+        }
+        return record->output;
+    }
+
+    auto VirtualFileSystem::read(std::string_view path) const -> std::expected<FileData, std::string> {
+        const auto normalized = normalize_path(path);
+
+        std::shared_lock lock(m_mutex);
+        if (is_mountable(normalized)) {
+            for (const auto& mount : m_mounts | std::views::reverse) {
+                if (auto relative = strip_mount_point(normalized, mount.mount_point)) {
+                    if (auto data = mount.backend->read(*relative)) {
+                        return std::move(*data);
+                    }
+                }
+            }
+        }
+
+        if (m_native_fallback) {
+            if (auto data = read_native(normalized)) {
+                return std::move(*data);
+            }
+        }
+        return std::unexpected(std::format("file not found: {}", normalized));
+    }
+
+    auto VirtualFileSystem::stat(std::string_view path) const -> std::optional<FileInfo> {
+        const auto normalized = normalize_path(path);
+
+        std::shared_lock lock(m_mutex);
+        if (is_mountable(normalized)) {
+            for (const auto& mount : m_mounts | std::views::reverse) {
+                if (auto relative = strip_mount_point(normalized, mount.mount_point)) {
+                    if (auto info = mount.backend->stat(*relative)) {
+                        return info;
+                    }
+                }
+            }
+        }
+        return m_native_fallback ? stat_native(normalized) : std::nullopt;
+    }
+
+    auto VirtualFileSystem::get_native_path(std::string_view path) const -> std::filesystem::path {
+        const auto normalized = normalize_path(path);
+
+        std::shared_lock lock(m_mutex);
+        if (is_mountable(normalized)) {
+            for (const auto& mount : m_mounts | std::views::reverse) {
+                if (auto relative = strip_mount_point(normalized, mount.mount_point)) {
+                    if (mount.backend->stat(*relative)) {
+                        // The winning copy decides; a packed file shadows loose ones further down
+                        return mount.backend->get_native_path(*relative);
+                    }
+                }
+            }
+        }
+
+        std::error_code ec;
+        if (m_native_fallback && std::filesystem::is_regular_file(normalized, ec)) {
+            return normalized;
+        }
+        return {};
+    }
+
+    auto VirtualFileSystem::read_async(std::string_view path, ReadCallback callback) const -> void {
+        auto& reader = get_async_reader();
+        if (auto native = get_native_path(path); !native.empty()) {
+            reader.read(native, std::move(callback));
+            return;
+        }
+
+        // Packed (or missing): the lookup and decompression run on a worker
+        reader.submit([this, path = std::string(path), callback = std::move(callback)] {
+            callback(read(path));
+        });
+    }
+
+    auto VirtualFileSystem::read_into_async(std::string_view path, uint64_t offset, std::span<std::byte> destination,
+                                            ReadIntoCallback callback) const -> void {
+        auto& reader = get_async_reader();
+        if (auto native = get_native_path(path); !native.empty()) {
+            reader.read_into(native, offset, destination, std::move(callback));
+            return;
+        }
+
+        reader.submit([this, path = std::string(path), offset, destination, callback = std::move(callback)] {
+            auto data = read(path);
+            if (!data) {
+                callback(std::unexpected(std::move(data.error())));
+                return;
+            }
+            const auto bytes = data->get_data();
+            const size_t count = offset < bytes.size()
+                ? std::min<size_t>(destination.size(), bytes.size() - offset)
+                : 0;
+            std::memcpy(destination.data(), bytes.data() + offset, count);
+            callback(count);
+        });
+    }
+
+    auto VirtualFileSystem::get_async_reader() const -> AsyncFileReader& {
+        std::scoped_lock lock(m_async_mutex);
+        if (!m_async_reader) {
+            m_async_reader = std::make_unique<AsyncFileReader>();
+        }
+        return *m_async_reader;
+    }
+
+    auto VirtualFileSystem::set_async_reader(std::unique_ptr<AsyncFileReader> reader) -> void {
+        std::unique_ptr<AsyncFileReader> previous;
+        {
+            std::scoped_lock lock(m_async_mutex);
+            previous = std::exchange(m_async_reader, std::move(reader));
+        }
+        // Destroyed outside the lock; its destructor waits for reads still in flight
+        previous.reset();
+    }
+
+    auto VirtualFileSystem::normalize_path(std::string_view path) -> std::string {
+        std::string prefix;
+        if (path.size() >= 2 && path[1] == ':') {
+            prefix = path.substr(0, 2);
+            path.remove_prefix(2);
+        }
+        const bool absolute = !path.empty() && (path.front() == '/' || path.front() == '\\');
+        if (absolute) {
+            prefix += '/';
+        }
+
+        std::vector<std::string_view> segments;
+        size_t start = 0;
+        while (start <= path.size()) {
+            size_t end = path.find_first_of("/\\", start);
+            if (end == std::string_view::npos) {
+                end = path.size();
+            }
+            const auto segment = path.substr(start, end - start);
+            if (segment == "..") {
+                if (!segments.empty() && segments.back() != "..") {
+                    segments.pop_back();
+                } else if (!absolute) {
+                    // Keep leading ".." on relative paths; they can only resolve natively
+                    segments.push_back(segment);
+                }
+            } else if (!segment.empty() && segment != ".") {
+                segments.push_back(segment);
+            }
+            start = end + 1;
+        }
+
+        std::string normalized = std::move(prefix);
+        for (size_t i = 0; i < segments.size(); ++i) {
+            if (i > 0) {
+                normalized += '/';
+            }
+            normalized += segments[i];
+        }
+        return normalized;
+    }
+
+    auto VirtualFileSystem::strip_mount_point(std::string_view path, std::string_view mount_point)
+        -> std::optional<std::string_view> {
+        if (mount_point.empty()) {
+            return path;
+        }
+        if (!path.starts_with(mount_point)) {
+            return std::nullopt;
+        }
+        path.remove_prefix(mount_point.size());
+        if (path.empty() || path.front() != '/') {
+            return std::nullopt;
+        }
+        return path.substr(1);
+    }
+} // namespace federation
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "cooked_texture.hpp"
+#include <string_view>
+
+namespace replicator {
+    /**
+     * Block format for a texture type, matching how the forward shaders sample it:
+     * albedo -> BC7 sRGB (BC1 if opaque and preferred), normal and metallic/roughness (.rg) -> BC5,
+     * opacity (.r) -> BC4
+     */
+    REPLICATOR_API auto select_block_format(batleth::TextureType type, bool has_alpha, bool prefer_bc1) -> VkFormat;
+
+    REPLICATOR_API auto get_block_format_name(VkFormat format) -> std::string_view;
+
+    /**
+     * Bytes per 4x4 block, or 0 for formats the cooker doesn't produce
+     */
+    REPLICATOR_API auto get_block_bytes(VkFormat format) -> uint32_t;
+
+    REPLICATOR_API auto has_alpha(const SourceImage& image) -> bool;
+
+    /**
+     * Compress one level; rows of blocks are spread over settings.threads workers
+     */
+    REPLICATOR_API auto compress_level(const SourceImage& level, VkFormat format, const TextureCookSettings& settings)
+        -> CookedLevel;
+
+    /**
+     * Decode a compressed level back to RGBA8 (channels the format doesn't store are 0, alpha 255)
+     */
+    REPLICATOR_API auto decompress_level(const CookedLevel& level, VkFormat format) -> SourceImage;
+
+    /**
+     * Peak signal-to-noise ratio in dB over the channels `format` stores
+     * @return +infinity for identical images
+     */
+    REPLICATOR_API auto compute_psnr(const SourceImage& reference, const SourceImage& image, VkFormat format) -> double;
+} // namespace replicator
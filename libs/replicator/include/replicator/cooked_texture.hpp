@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <vector>
+
+#include "batleth/texture.hpp"
+
+#ifdef _WIN32
+#ifdef REPLICATOR_EXPORTS
+#define REPLICATOR_API __declspec(dllexport)
+#else
+#define REPLICATOR_API __declspec(dllimport)
+#endif
+#else
+#define REPLICATOR_API
+#endif
+
+namespace replicator {
+    enum class MipFilter {
+        Box,
+        Kaiser,
+        Lanczos
+    };
+
+    struct TextureCookSettings {
+        batleth::TextureType type = batleth::TextureType::Albedo;  // Picks colour space and block format
+        MipFilter filter = MipFilter::Kaiser;
+        bool generate_mips = true;
+        bool wrap = true;               // Filter across edges as if tiled (matches the engine's REPEAT sampler)
+        bool prefer_bc1 = false;        // Opaque colour textures use BC1 instead of BC7 (half the size)
+        uint32_t bc7_uber_level = 1;    // bc7enc effort, 0 (fastest) .. 4 (best)
+        uint32_t bc1_level = 10;        // rgbcx effort, 0 .. 18
+        uint32_t threads = 0;           // Workers for filtering and block compression, 0 = all cores
+    };
+
+    /**
+     * Uncompressed RGBA8 image (source file or one generated mip)
+     */
+    struct SourceImage {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<uint8_t> pixels;
+    };
+
+    struct CookedLevel {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<uint8_t> data;      // Tightly packed 4x4 blocks
+    };
+
+    /**
+     * Block-compressed texture with its full mip chain, as written to KTX2
+     */
+    struct CookedTexture {
+        VkFormat format = VK_FORMAT_UNDEFINED;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<CookedLevel> levels;
+    };
+} // namespace replicator
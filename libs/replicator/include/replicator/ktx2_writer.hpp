@@ -0,0 +1,17 @@
+#pragma once
+
+#include "cooked_texture.hpp"
+#include <expected>
+#include <filesystem>
+#include <string>
+
+namespace replicator {
+    /**
+     * Serialize to a KTX2 container (no supercompression, basic data format descriptor,
+     * levels stored smallest first and 16-byte aligned)
+     */
+    REPLICATOR_API auto encode_ktx2(const CookedTexture& texture) -> std::vector<uint8_t>;
+
+    REPLICATOR_API auto write_ktx2(const std::filesystem::path& path, const CookedTexture& texture)
+        -> std::expected<void, std::string>;
+} // namespace replicator
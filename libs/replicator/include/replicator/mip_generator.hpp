@@ -0,0 +1,17 @@
+#pragma once
+
+#include "cooked_texture.hpp"
+
+namespace replicator {
+    /**
+     * Build a full mip chain on the CPU
+     * Each level is a separable 2:1 resample of the previous one, done in linear light (sRGB
+     * albedo is decoded first) with the configured windowed-sinc filter. Normal maps are
+     * renormalized after every level so shorter, filtered normals don't darken lighting.
+     * @param image Mip 0
+     * @param settings Filter, edge mode, texture type and worker count
+     * @return Every level including mip 0 (just mip 0 if generate_mips is off)
+     */
+    REPLICATOR_API auto generate_mip_chain(const SourceImage& image, const TextureCookSettings& settings)
+        -> std::vector<SourceImage>;
+} // namespace replicator
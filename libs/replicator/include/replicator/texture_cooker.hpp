@@ -0,0 +1,51 @@
+#pragma once
+
+#include "cooked_texture.hpp"
+#include <expected>
+#include <filesystem>
+#include <span>
+#include <string>
+
+namespace replicator {
+    struct CookJob {
+        std::filesystem::path input;    // Anything stb_image reads (PNG, JPG, TGA, BMP, ...)
+        std::filesystem::path output;   // .ktx2
+        TextureCookSettings settings{};
+    };
+
+    struct CookResult {
+        bool success = false;
+        std::string error;
+        VkFormat format = VK_FORMAT_UNDEFINED;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t mip_levels = 0;
+        uint64_t output_bytes = 0;
+        double load_ms = 0.0;
+        double mip_ms = 0.0;
+        double compress_ms = 0.0;
+        double write_ms = 0.0;
+        std::vector<double> psnr;       // Per mip, only when requested
+    };
+
+    struct BatchSettings {
+        uint32_t threads = 0;           // 0 = all cores, shared between images and blocks
+        bool measure_psnr = false;
+    };
+
+    REPLICATOR_API auto load_source_image(const std::filesystem::path& path) -> std::expected<SourceImage, std::string>;
+
+    /**
+     * Generate mips and block-compress every level
+     */
+    REPLICATOR_API auto cook_texture(const SourceImage& source, const TextureCookSettings& settings) -> CookedTexture;
+
+    /**
+     * Cook a batch of files to KTX2
+     * Images are cooked concurrently; when there are fewer images than workers, the spare
+     * workers go to filtering and block compression within each image.
+     * @return One result per job, in order
+     */
+    REPLICATOR_API auto cook_textures(std::span<const CookJob> jobs, const BatchSettings& batch)
+        -> std::vector<CookResult>;
+} // namespace replicator
@@ -0,0 +1,240 @@
+#include "replicator/block_compressor.hpp"
+#include "parallel.hpp"
+
+#include <bc7decomp.h>
+#include <bc7enc.h>
+#include <rgbcx.h>
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <mutex>
+
+namespace replicator {
+    namespace {
+        constexpr uint32_t BLOCK_DIM = 4;
+        constexpr uint32_t BLOCK_PIXELS = BLOCK_DIM * BLOCK_DIM;
+
+        using BlockPixels = std::array<uint8_t, BLOCK_PIXELS * 4>;
+
+        auto init_encoders() -> void {
+            static std::once_flag init_flag;
+            std::call_once(init_flag, [] {
+                rgbcx::init();
+                bc7enc_compress_block_init();
+            });
+        }
+
+        /**
+         * Gather a 4x4 block, repeating the last row/column for levels smaller than a block
+         */
+        auto extract_block(const SourceImage& image, uint32_t block_x, uint32_t block_y) -> BlockPixels {
+            BlockPixels block{};
+            for (uint32_t y = 0; y < BLOCK_DIM; ++y) {
+                const uint32_t src_y = std::min(block_y * BLOCK_DIM + y, image.height - 1);
+                for (uint32_t x = 0; x < BLOCK_DIM; ++x) {
+                    const uint32_t src_x = std::min(block_x * BLOCK_DIM + x, image.width - 1);
+                    std::memcpy(&block[(y * BLOCK_DIM + x) * 4],
+                                &image.pixels[(static_cast<size_t>(src_y) * image.width + src_x) * 4], 4);
+                }
+            }
+            return block;
+        }
+
+        /**
+         * Write a decoded 4x4 block back, dropping pixels past the level's edge
+         */
+        auto store_block(SourceImage& image, uint32_t block_x, uint32_t block_y, const BlockPixels& block) -> void {
+            for (uint32_t y = 0; y < BLOCK_DIM; ++y) {
+                const uint32_t dst_y = block_y * BLOCK_DIM + y;
+                for (uint32_t x = 0; x < BLOCK_DIM; ++x) {
+                    const uint32_t dst_x = block_x * BLOCK_DIM + x;
+                    if (dst_x < image.width && dst_y < image.height) {
+                        std::memcpy(&image.pixels[(static_cast<size_t>(dst_y) * image.width + dst_x) * 4],
+                                    &block[(y * BLOCK_DIM + x) * 4], 4);
+                    }
+                }
+            }
+        }
+
+        auto is_srgb(VkFormat format) -> bool {
+            return format == VK_FORMAT_BC7_SRGB_BLOCK || format == VK_FORMAT_BC1_RGB_SRGB_BLOCK;
+        }
+
+        /**
+         * Bitmask of RGBA channels the format keeps
+         */
+        auto stored_channels(VkFormat format) -> uint32_t {
+            switch (format) {
+                case VK_FORMAT_BC4_UNORM_BLOCK: return 0b0001;
+                case VK_FORMAT_BC5_UNORM_BLOCK: return 0b0011;
+                case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+                case VK_FORMAT_BC1_RGB_SRGB_BLOCK: return 0b0111;
+                default: return 0b1111;
+            }
+        }
+    } // anonymous namespace
+
+    auto select_block_format(batleth::TextureType type, bool has_alpha, bool prefer_bc1) -> VkFormat {
+        switch (type) {
+            case batleth::TextureType::Normal:
+            case batleth::TextureType::MetallicRoughness:
+                return VK_FORMAT_BC5_UNORM_BLOCK;
+            case batleth::TextureType::Opacity:
+                return VK_FORMAT_BC4_UNORM_BLOCK;
+            case batleth::TextureType::Albedo:
+                return prefer_bc1 && !has_alpha ? VK_FORMAT_BC1_RGB_SRGB_BLOCK : VK_FORMAT_BC7_SRGB_BLOCK;
+            default:
+                return prefer_bc1 && !has_alpha ? VK_FORMAT_BC1_RGB_UNORM_BLOCK : VK_FORMAT_BC7_UNORM_BLOCK;
+        }
+    }
+
+    auto get_block_format_name(VkFormat format) -> std::string_view {
+        switch (format) {
+            case VK_FORMAT_BC1_RGB_UNORM_BLOCK: return "BC1";
+            case VK_FORMAT_BC1_RGB_SRGB_BLOCK: return "BC1 sRGB";
+            case VK_FORMAT_BC4_UNORM_BLOCK: return "BC4";
+            case VK_FORMAT_BC5_UNORM_BLOCK: return "BC5";
+            case VK_FORMAT_BC7_UNORM_BLOCK: return "BC7";
+            case VK_FORMAT_BC7_SRGB_BLOCK: return "BC7 sRGB";
+            default: return "unknown";
+        }
+    }
+
+    auto get_block_bytes(VkFormat format) -> uint32_t {
+        switch (format) {
+            case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+            case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+            case VK_FORMAT_BC4_UNORM_BLOCK:
+                return 8;
+            case VK_FORMAT_BC5_UNORM_BLOCK:
+            case VK_FORMAT_BC7_UNORM_BLOCK:
+            case VK_FORMAT_BC7_SRGB_BLOCK:
+                return 16;
+            default:
+                return 0;
+        }
+    }
+
+    auto has_alpha(const SourceImage& image) -> bool {
+        for (size_t i = 3; i < image.pixels.size(); i += 4) {
+            if (image.pixels[i] != 255) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    auto compress_level(const SourceImage& level, VkFormat format, const TextureCookSettings& settings)
+        -> CookedLevel {
+        init_encoders();
+
+        const uint32_t blocks_x = (level.width + BLOCK_DIM - 1) / BLOCK_DIM;
+        const uint32_t blocks_y = (level.height + BLOCK_DIM - 1) / BLOCK_DIM;
+        const uint32_t block_bytes = get_block_bytes(format);
+
+        CookedLevel cooked{};
+        cooked.width = level.width;
+        cooked.height = level.height;
+        cooked.data.resize(static_cast<size_t>(blocks_x) * blocks_y * block_bytes);
+
+        bc7enc_compress_block_params bc7_params{};
+        bc7enc_compress_block_params_init(&bc7_params);
+        if (is_srgb(format)) {
+            bc7enc_compress_block_params_init_perceptual_weights(&bc7_params);
+        } else {
+            bc7enc_compress_block_params_init_linear_weights(&bc7_params);
+        }
+        bc7_params.m_uber_level = std::min(settings.bc7_uber_level, static_cast<uint32_t>(BC7ENC_MAX_UBER_LEVEL));
+
+        detail::parallel_for(blocks_y, detail::resolve_thread_count(settings.threads), [&](uint32_t block_y) {
+            for (uint32_t block_x = 0; block_x < blocks_x; ++block_x) {
+                const auto pixels = extract_block(level, block_x, block_y);
+                uint8_t* dst = &cooked.data[(static_cast<size_t>(block_y) * blocks_x + block_x) * block_bytes];
+
+                switch (format) {
+                    case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+                    case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+                        rgbcx::encode_bc1(settings.bc1_level, dst, pixels.data(), false, false);
+                        break;
+                    case VK_FORMAT_BC4_UNORM_BLOCK:
+                        rgbcx::encode_bc4(dst, pixels.data());
+                        break;
+                    case VK_FORMAT_BC5_UNORM_BLOCK:
+                        rgbcx::encode_bc5(dst, pixels.data());
+                        break;
+                    default:
+                        bc7enc_compress_block(dst, pixels.data(), &bc7_params);
+                        break;
+                }
+            }
+        });
+
+        return cooked;
+    }
+
+    auto decompress_level(const CookedLevel& level, VkFormat format) -> SourceImage {
+        const uint32_t blocks_x = (level.width + BLOCK_DIM - 1) / BLOCK_DIM;
+        const uint32_t blocks_y = (level.height + BLOCK_DIM - 1) / BLOCK_DIM;
+        const uint32_t block_bytes = get_block_bytes(format);
+
+        SourceImage image{};
+        image.width = level.width;
+        image.height = level.height;
+        image.pixels.resize(static_cast<size_t>(level.width) * level.height * 4);
+
+        for (uint32_t block_y = 0; block_y < blocks_y; ++block_y) {
+            for (uint32_t block_x = 0; block_x < blocks_x; ++block_x) {
+                const uint8_t* src = &level.data[(static_cast<size_t>(block_y) * blocks_x + block_x) * block_bytes];
+
+                BlockPixels pixels{};
+                for (uint32_t i = 0; i < BLOCK_PIXELS; ++i) {
+                    pixels[i * 4 + 3] = 255;
+                }
+
+                switch (format) {
+                    case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+                    case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+                        rgbcx::unpack_bc1(src, pixels.data());
+                        break;
+                    case VK_FORMAT_BC4_UNORM_BLOCK:
+                        rgbcx::unpack_bc4(src, pixels.data());
+                        break;
+                    case VK_FORMAT_BC5_UNORM_BLOCK:
+                        rgbcx::unpack_bc5(src, pixels.data());
+                        break;
+                    default:
+                        bc7decomp::unpack_bc7(src, reinterpret_cast<bc7decomp::color_rgba*>(pixels.data()));
+                        break;
+                }
+
+                store_block(image, block_x, block_y, pixels);
+            }
+        }
+
+        return image;
+    }
+
+    auto compute_psnr(const SourceImage& reference, const SourceImage& image, VkFormat format) -> double {
+        const uint32_t channels = stored_channels(format);
+
+        double squared_error = 0.0;
+        uint64_t samples = 0;
+        for (size_t i = 0; i < reference.pixels.size() && i < image.pixels.size(); ++i) {
+            if (!(channels & (1u << (i % 4)))) {
+                continue;
+            }
+            const double diff = static_cast<double>(reference.pixels[i]) - static_cast<double>(image.pixels[i]);
+            squared_error += diff * diff;
+            ++samples;
+        }
+
+        if (samples == 0 || squared_error == 0.0) {
+            return std::numeric_limits<double>::infinity();
+        }
+
+        const double mse = squared_error / static_cast<double>(samples);
+        return 10.0 * std::log10(255.0 * 255.0 / mse);
+    }
+} // namespace replicator
@@ -0,0 +1,172 @@
+#include "replicator/ktx2_writer.hpp"
+#include "replicator/block_compressor.hpp"
+
+#include <array>
+#include <fstream>
+#include <string_view>
+
+namespace replicator {
+    namespace {
+        constexpr std::array<uint8_t, 12> KTX2_IDENTIFIER = {
+            0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A
+        };
+        constexpr size_t KTX2_HEADER_SIZE = 80;
+        constexpr size_t KTX2_LEVEL_INDEX_ENTRY_SIZE = 24;
+        constexpr size_t LEVEL_ALIGNMENT = 16;  // Multiple of every BC block size and of 4
+        constexpr std::string_view WRITER = "klingon replicator";
+
+        // Khronos Data Format (basic descriptor block) values
+        constexpr uint32_t KHR_DF_VERSION = 2;
+        constexpr uint8_t KHR_DF_MODEL_BC1A = 128;
+        constexpr uint8_t KHR_DF_MODEL_BC4 = 131;
+        constexpr uint8_t KHR_DF_MODEL_BC5 = 132;
+        constexpr uint8_t KHR_DF_MODEL_BC7 = 134;
+        constexpr uint8_t KHR_DF_PRIMARIES_BT709 = 1;
+        constexpr uint8_t KHR_DF_TRANSFER_LINEAR = 1;
+        constexpr uint8_t KHR_DF_TRANSFER_SRGB = 2;
+
+        auto put_u32(std::vector<uint8_t>& out, size_t offset, uint32_t value) -> void {
+            for (size_t i = 0; i < 4; ++i) {
+                out[offset + i] = static_cast<uint8_t>(value >> (i * 8));
+            }
+        }
+
+        auto put_u64(std::vector<uint8_t>& out, size_t offset, uint64_t value) -> void {
+            put_u32(out, offset, static_cast<uint32_t>(value));
+            put_u32(out, offset + 4, static_cast<uint32_t>(value >> 32));
+        }
+
+        auto append_u32(std::vector<uint8_t>& out, uint32_t value) -> void {
+            out.resize(out.size() + 4);
+            put_u32(out, out.size() - 4, value);
+        }
+
+        auto align_to(std::vector<uint8_t>& out, size_t alignment) -> void {
+            out.resize((out.size() + alignment - 1) / alignment * alignment, 0);
+        }
+
+        struct DfdSample {
+            uint32_t bit_offset;
+            uint32_t bit_length;
+            uint32_t channel;
+        };
+
+        /**
+         * Basic data format descriptor for the block formats the cooker writes
+         */
+        auto build_dfd(VkFormat format) -> std::vector<uint8_t> {
+            uint8_t model = KHR_DF_MODEL_BC7;
+            std::vector<DfdSample> samples;
+            switch (format) {
+                case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+                case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+                    model = KHR_DF_MODEL_BC1A;
+                    samples = {{0, 64, 0}};   // KHR_DF_CHANNEL_BC1A_COLOR
+                    break;
+                case VK_FORMAT_BC4_UNORM_BLOCK:
+                    model = KHR_DF_MODEL_BC4;
+                    samples = {{0, 64, 0}};   // KHR_DF_CHANNEL_BC4_DATA
+                    break;
+                case VK_FORMAT_BC5_UNORM_BLOCK:
+                    model = KHR_DF_MODEL_BC5;
+                    samples = {{0, 64, 0}, {64, 64, 1}};  // KHR_DF_CHANNEL_BC5_RED, _GREEN
+                    break;
+                default:
+                    samples = {{0, 128, 0}};  // KHR_DF_CHANNEL_BC7_COLOR
+                    break;
+            }
+
+            const bool srgb = format == VK_FORMAT_BC1_RGB_SRGB_BLOCK || format == VK_FORMAT_BC7_SRGB_BLOCK;
+            const auto block_size = static_cast<uint32_t>(24 + 16 * samples.size());
+
+            std::vector<uint8_t> dfd;
+            append_u32(dfd, 4 + block_size);                       // dfdTotalSize
+            append_u32(dfd, 0);                                    // vendorId | descriptorType
+            append_u32(dfd, KHR_DF_VERSION | block_size << 16);
+            append_u32(dfd, model | KHR_DF_PRIMARIES_BT709 << 8 |
+                            (srgb ? KHR_DF_TRANSFER_SRGB : KHR_DF_TRANSFER_LINEAR) << 16);
+            append_u32(dfd, 3 | 3 << 8);                           // 4x4x1x1 texel block
+            append_u32(dfd, get_block_bytes(format));              // bytesPlane0
+            append_u32(dfd, 0);                                    // bytesPlane4..7
+
+            for (const auto& sample : samples) {
+                append_u32(dfd, sample.bit_offset | (sample.bit_length - 1) << 16 | sample.channel << 24);
+                append_u32(dfd, 0);                                // samplePosition
+                append_u32(dfd, 0);                                // sampleLower
+                append_u32(dfd, 0xFFFFFFFF);                       // sampleUpper
+            }
+            return dfd;
+        }
+    } // anonymous namespace
+
+    auto encode_ktx2(const CookedTexture& texture) -> std::vector<uint8_t> {
+        const auto level_count = static_cast<uint32_t>(texture.levels.size());
+        const auto dfd = build_dfd(texture.format);
+
+        std::vector<uint8_t> out(KTX2_HEADER_SIZE + level_count * KTX2_LEVEL_INDEX_ENTRY_SIZE, 0);
+        std::copy(KTX2_IDENTIFIER.begin(), KTX2_IDENTIFIER.end(), out.begin());
+        put_u32(out, 12, static_cast<uint32_t>(texture.format));
+        put_u32(out, 16, 1);                // typeSize (1 for block-compressed formats)
+        put_u32(out, 20, texture.width);
+        put_u32(out, 24, texture.height);
+        put_u32(out, 28, 0);                // pixelDepth
+        put_u32(out, 32, 0);                // layerCount
+        put_u32(out, 36, 1);                // faceCount
+        put_u32(out, 40, level_count);
+        put_u32(out, 44, 0);                // supercompressionScheme
+
+        // Data format descriptor
+        const size_t dfd_offset = out.size();
+        out.insert(out.end(), dfd.begin(), dfd.end());
+        put_u32(out, 48, static_cast<uint32_t>(dfd_offset));
+        put_u32(out, 52, static_cast<uint32_t>(dfd.size()));
+
+        // Key/value data: just KTXwriter
+        const size_t kvd_offset = out.size();
+        const auto kv_length = static_cast<uint32_t>(sizeof("KTXwriter") + WRITER.size() + 1);
+        append_u32(out, kv_length);
+        for (char c : std::string_view("KTXwriter")) {
+            out.push_back(static_cast<uint8_t>(c));
+        }
+        out.push_back(0);
+        out.insert(out.end(), WRITER.begin(), WRITER.end());
+        out.push_back(0);
+        align_to(out, 4);
+        put_u32(out, 56, static_cast<uint32_t>(kvd_offset));
+        put_u32(out, 60, static_cast<uint32_t>(out.size() - kvd_offset));
+        // sgdByteOffset/Length stay 0
+
+        // Mip data, smallest level first as the spec recommends
+        for (uint32_t mip = level_count; mip-- > 0;) {
+            align_to(out, LEVEL_ALIGNMENT);
+            const auto& level = texture.levels[mip];
+            const size_t entry = KTX2_HEADER_SIZE + mip * KTX2_LEVEL_INDEX_ENTRY_SIZE;
+            put_u64(out, entry, out.size());
+            put_u64(out, entry + 8, level.data.size());
+            put_u64(out, entry + 16, level.data.size());
+            out.insert(out.end(), level.data.begin(), level.data.end());
+        }
+
+        return out;
+    }
+
+    auto write_ktx2(const std::filesystem::path& path, const CookedTexture& texture)
+        -> std::expected<void, std::string> {
+        const auto bytes = encode_ktx2(texture);
+
+        if (path.has_parent_path()) {
+            std::error_code ec;
+            std::filesystem::create_directories(path.parent_path(), ec);
+        }
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return std::unexpected("could not open " + path.string() + " for writing");
+        }
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if (!file) {
+            return std::unexpected("failed writing " + path.string());
+        }
+        return {};
+    }
+} // namespace replicator
@@ -0,0 +1,324 @@
+#include "replicator/mip_generator.hpp"
+#include "parallel.hpp"
+
+#include <array>
+#include <cmath>
+#include <numbers>
+
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64)
+#include <xmmintrin.h>
+#define REPLICATOR_SIMD_SSE 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define REPLICATOR_SIMD_NEON 1
+#endif
+
+namespace replicator {
+    namespace {
+        constexpr float KAISER_RADIUS = 3.0f;
+        constexpr float KAISER_ALPHA = 4.0f;
+        constexpr float LANCZOS_RADIUS = 3.0f;
+        constexpr uint32_t LINEAR_TO_SRGB_STEPS = 4096;
+
+        /**
+         * One RGBA pixel in linear float; every filter tap is a single multiply-add on all four channels
+         */
+        struct Float4 {
+#if defined(REPLICATOR_SIMD_SSE)
+            __m128 v;
+
+            static auto zero() -> Float4 { return {_mm_setzero_ps()}; }
+            static auto load(const float* p) -> Float4 { return {_mm_loadu_ps(p)}; }
+            auto store(float* p) const -> void { _mm_storeu_ps(p, v); }
+            auto add_scaled(Float4 x, float w) -> void { v = _mm_add_ps(v, _mm_mul_ps(x.v, _mm_set1_ps(w))); }
+#elif defined(REPLICATOR_SIMD_NEON)
+            float32x4_t v;
+
+            static auto zero() -> Float4 { return {vdupq_n_f32(0.0f)}; }
+            static auto load(const float* p) -> Float4 { return {vld1q_f32(p)}; }
+            auto store(float* p) const -> void { vst1q_f32(p, v); }
+            auto add_scaled(Float4 x, float w) -> void { v = vmlaq_n_f32(v, x.v, w); }
+#else
+            std::array<float, 4> v;
+
+            static auto zero() -> Float4 { return {}; }
+            static auto load(const float* p) -> Float4 { return {{p[0], p[1], p[2], p[3]}}; }
+            auto store(float* p) const -> void { std::copy(v.begin(), v.end(), p); }
+            auto add_scaled(Float4 x, float w) -> void {
+                for (size_t i = 0; i < 4; ++i) {
+                    v[i] += x.v[i] * w;
+                }
+            }
+#endif
+        };
+
+        /**
+         * Linear float RGBA image
+         */
+        struct FloatImage {
+            uint32_t width = 0;
+            uint32_t height = 0;
+            std::vector<float> texels;
+        };
+
+        /**
+         * Per destination pixel: the source pixels it reads and their normalized weights
+         */
+        struct FilterKernel {
+            std::vector<uint32_t> offsets;  // Destination pixel i uses taps [offsets[i], offsets[i + 1])
+            std::vector<uint32_t> sources;
+            std::vector<float> weights;
+        };
+
+        auto sinc(float x) -> float {
+            if (std::abs(x) < 1e-6f) {
+                return 1.0f;
+            }
+            const float px = std::numbers::pi_v<float> * x;
+            return std::sin(px) / px;
+        }
+
+        // Zeroth-order modified Bessel function of the first kind
+        auto bessel_i0(float x) -> float {
+            float sum = 1.0f;
+            float term = 1.0f;
+            const float half_sq = x * x * 0.25f;
+            for (uint32_t k = 1; k < 32 && term > sum * 1e-8f; ++k) {
+                term *= half_sq / static_cast<float>(k * k);
+                sum += term;
+            }
+            return sum;
+        }
+
+        auto filter_radius(MipFilter filter) -> float {
+            switch (filter) {
+                case MipFilter::Box: return 0.5f;
+                case MipFilter::Kaiser: return KAISER_RADIUS;
+                case MipFilter::Lanczos: return LANCZOS_RADIUS;
+            }
+            return 0.5f;
+        }
+
+        auto filter_weight(MipFilter filter, float x) -> float {
+            const float radius = filter_radius(filter);
+            if (std::abs(x) > radius) {
+                return 0.0f;
+            }
+
+            switch (filter) {
+                case MipFilter::Box:
+                    return 1.0f;
+                case MipFilter::Kaiser: {
+                    const float t = x / radius;
+                    return sinc(x) * bessel_i0(KAISER_ALPHA * std::sqrt(1.0f - t * t)) / bessel_i0(KAISER_ALPHA);
+                }
+                case MipFilter::Lanczos:
+                    return sinc(x) * sinc(x / radius);
+            }
+            return 0.0f;
+        }
+
+        auto build_kernel(uint32_t src_size, uint32_t dst_size, MipFilter filter, bool wrap) -> FilterKernel {
+            FilterKernel kernel{};
+            kernel.offsets.reserve(dst_size + 1);
+
+            const float scale = static_cast<float>(src_size) / static_cast<float>(dst_size);
+            const float support = filter_radius(filter) * scale;
+
+            for (uint32_t dst = 0; dst < dst_size; ++dst) {
+                kernel.offsets.push_back(static_cast<uint32_t>(kernel.sources.size()));
+
+                const float center = (static_cast<float>(dst) + 0.5f) * scale;
+                const auto first = static_cast<int64_t>(std::floor(center - support));
+                const auto last = static_cast<int64_t>(std::ceil(center + support));
+
+                const size_t tap_begin = kernel.weights.size();
+                float total = 0.0f;
+                for (int64_t src = first; src <= last; ++src) {
+                    const float weight = filter_weight(filter, (static_cast<float>(src) + 0.5f - center) / scale);
+                    if (weight == 0.0f) {
+                        continue;
+                    }
+
+                    const auto size = static_cast<int64_t>(src_size);
+                    const int64_t index = wrap ? ((src % size) + size) % size : std::clamp<int64_t>(src, 0, size - 1);
+                    kernel.sources.push_back(static_cast<uint32_t>(index));
+                    kernel.weights.push_back(weight);
+                    total += weight;
+                }
+
+                for (size_t tap = tap_begin; tap < kernel.weights.size(); ++tap) {
+                    kernel.weights[tap] /= total;
+                }
+            }
+
+            kernel.offsets.push_back(static_cast<uint32_t>(kernel.sources.size()));
+            return kernel;
+        }
+
+        auto srgb_to_linear_table() -> const std::array<float, 256>& {
+            static const std::array<float, 256> table = [] {
+                std::array<float, 256> result{};
+                for (size_t i = 0; i < result.size(); ++i) {
+                    const float c = static_cast<float>(i) / 255.0f;
+                    result[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+                }
+                return result;
+            }();
+            return table;
+        }
+
+        auto linear_to_srgb(float value) -> uint8_t {
+            static const std::array<uint8_t, LINEAR_TO_SRGB_STEPS> table = [] {
+                std::array<uint8_t, LINEAR_TO_SRGB_STEPS> result{};
+                for (size_t i = 0; i < result.size(); ++i) {
+                    const float c = static_cast<float>(i) / static_cast<float>(LINEAR_TO_SRGB_STEPS - 1);
+                    const float s = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+                    result[i] = static_cast<uint8_t>(std::clamp(s * 255.0f + 0.5f, 0.0f, 255.0f));
+                }
+                return result;
+            }();
+            const float clamped = std::clamp(value, 0.0f, 1.0f);
+            return table[static_cast<size_t>(clamped * static_cast<float>(LINEAR_TO_SRGB_STEPS - 1) + 0.5f)];
+        }
+
+        auto to_unorm8(float value) -> uint8_t {
+            return static_cast<uint8_t>(std::clamp(value * 255.0f + 0.5f, 0.0f, 255.0f));
+        }
+
+        auto decode_image(const SourceImage& image, batleth::TextureType type) -> FloatImage {
+            FloatImage result{image.width, image.height, std::vector<float>(image.pixels.size())};
+            const auto& srgb = srgb_to_linear_table();
+
+            for (size_t i = 0; i < image.pixels.size(); i += 4) {
+                for (size_t c = 0; c < 3; ++c) {
+                    const uint8_t value = image.pixels[i + c];
+                    switch (type) {
+                        case batleth::TextureType::Albedo:
+                            result.texels[i + c] = srgb[value];
+                            break;
+                        case batleth::TextureType::Normal:
+                            result.texels[i + c] = static_cast<float>(value) / 127.5f - 1.0f;
+                            break;
+                        default:
+                            result.texels[i + c] = static_cast<float>(value) / 255.0f;
+                            break;
+                    }
+                }
+                result.texels[i + 3] = static_cast<float>(image.pixels[i + 3]) / 255.0f;
+            }
+            return result;
+        }
+
+        auto encode_image(const FloatImage& image, batleth::TextureType type) -> SourceImage {
+            SourceImage result{image.width, image.height, std::vector<uint8_t>(image.texels.size())};
+
+            for (size_t i = 0; i < image.texels.size(); i += 4) {
+                for (size_t c = 0; c < 3; ++c) {
+                    const float value = image.texels[i + c];
+                    switch (type) {
+                        case batleth::TextureType::Albedo:
+                            result.pixels[i + c] = linear_to_srgb(value);
+                            break;
+                        case batleth::TextureType::Normal:
+                            result.pixels[i + c] = to_unorm8(value * 0.5f + 0.5f);
+                            break;
+                        default:
+                            result.pixels[i + c] = to_unorm8(value);
+                            break;
+                    }
+                }
+                result.pixels[i + 3] = to_unorm8(image.texels[i + 3]);
+            }
+            return result;
+        }
+
+        auto renormalize(FloatImage& image) -> void {
+            for (size_t i = 0; i < image.texels.size(); i += 4) {
+                float* n = &image.texels[i];
+                const float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                if (length > 1e-6f) {
+                    n[0] /= length;
+                    n[1] /= length;
+                    n[2] /= length;
+                } else {
+                    n[0] = 0.0f;
+                    n[1] = 0.0f;
+                    n[2] = 1.0f;
+                }
+            }
+        }
+
+        auto downsample(const FloatImage& src, const TextureCookSettings& settings, uint32_t threads) -> FloatImage {
+            FloatImage dst{};
+            dst.width = std::max(src.width / 2, 1u);
+            dst.height = std::max(src.height / 2, 1u);
+            dst.texels.resize(static_cast<size_t>(dst.width) * dst.height * 4);
+
+            const auto horizontal = build_kernel(src.width, dst.width, settings.filter, settings.wrap);
+            const auto vertical = build_kernel(src.height, dst.height, settings.filter, settings.wrap);
+
+            // Horizontal pass: src.width x src.height -> dst.width x src.height
+            std::vector<float> columns(static_cast<size_t>(dst.width) * src.height * 4);
+            detail::parallel_for(src.height, threads, [&](uint32_t y) {
+                const float* src_row = &src.texels[static_cast<size_t>(y) * src.width * 4];
+                float* dst_row = &columns[static_cast<size_t>(y) * dst.width * 4];
+
+                for (uint32_t x = 0; x < dst.width; ++x) {
+                    Float4 sum = Float4::zero();
+                    for (uint32_t tap = horizontal.offsets[x]; tap < horizontal.offsets[x + 1]; ++tap) {
+                        sum.add_scaled(Float4::load(src_row + horizontal.sources[tap] * 4), horizontal.weights[tap]);
+                    }
+                    sum.store(dst_row + x * 4);
+                }
+            });
+
+            // Vertical pass, a whole row per tap so the inner loop streams through memory
+            detail::parallel_for(dst.height, threads, [&](uint32_t y) {
+                float* dst_row = &dst.texels[static_cast<size_t>(y) * dst.width * 4];
+
+                for (uint32_t tap = vertical.offsets[y]; tap < vertical.offsets[y + 1]; ++tap) {
+                    const float* src_row = &columns[static_cast<size_t>(vertical.sources[tap]) * dst.width * 4];
+                    const float weight = vertical.weights[tap];
+
+                    for (uint32_t x = 0; x < dst.width; ++x) {
+                        Float4 sum = Float4::load(dst_row + x * 4);
+                        sum.add_scaled(Float4::load(src_row + x * 4), weight);
+                        sum.store(dst_row + x * 4);
+                    }
+                }
+            });
+
+            return dst;
+        }
+    } // anonymous namespace
+
+    auto generate_mip_chain(const SourceImage& image, const TextureCookSettings& settings)
+        -> std::vector<SourceImage> {
+        std::vector<SourceImage> chain;
+        chain.push_back(image);
+
+        if (!settings.generate_mips || (image.width <= 1 && image.height <= 1)) {
+            return chain;
+        }
+
+        const bool normal_map = settings.type == batleth::TextureType::Normal;
+        const uint32_t threads = detail::resolve_thread_count(settings.threads);
+
+        FloatImage level = decode_image(image, settings.type);
+        if (normal_map) {
+            renormalize(level);
+            chain.front() = encode_image(level, settings.type);
+        }
+
+        while (level.width > 1 || level.height > 1) {
+            level = downsample(level, settings, threads);
+            if (normal_map) {
+                renormalize(level);
+            }
+            chain.push_back(encode_image(level, settings.type));
+        }
+
+        return chain;
+    }
+} // namespace replicator
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace replicator::detail {
+    inline auto resolve_thread_count(uint32_t requested) -> uint32_t {
+        return requested != 0 ? requested : std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    /**
+     * Run fn(i) for i in [0, count) on up to `threads` threads (the caller is one of them)
+     * Indices are handed out one at a time, so uneven work balances itself.
+     */
+    template<typename Fn>
+    auto parallel_for(uint32_t count, uint32_t threads, Fn&& fn) -> void {
+        threads = std::min(threads, count);
+        if (threads <= 1) {
+            for (uint32_t i = 0; i < count; ++i) {
+                fn(i);
+            }
+            return;
+        }
+
+        std::atomic<uint32_t> next{0};
+        auto worker = [&] {
+            for (uint32_t i = next++; i < count; i = next++) {
+                fn(i);
+            }
+        };
+
+        std::vector<std::jthread> pool;
+        pool.reserve(threads - 1);
+        for (uint32_t i = 0; i + 1 < threads; ++i) {
+            pool.emplace_back(worker);
+        }
+        worker();
+    }
+} // namespace replicator::detail
@@ -0,0 +1,135 @@
+#include "replicator/texture_cooker.hpp"
+#include "replicator/block_compressor.hpp"
+#include "replicator/ktx2_writer.hpp"
+#include "replicator/mip_generator.hpp"
+#include "parallel.hpp"
+
+#include "federation/log.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <format>
+
+// klingon carries its own copy of stb_image; keep ours internal to this library
+#define STB_IMAGE_STATIC
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+namespace replicator {
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        auto elapsed_ms(Clock::time_point start) -> double {
+            return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        }
+
+        auto cook_job(const CookJob& job, bool measure_psnr) -> CookResult {
+            CookResult result{};
+
+            auto start = Clock::now();
+            auto source = load_source_image(job.input);
+            if (!source) {
+                result.error = source.error();
+                return result;
+            }
+            result.load_ms = elapsed_ms(start);
+
+            start = Clock::now();
+            const auto mips = generate_mip_chain(*source, job.settings);
+            result.mip_ms = elapsed_ms(start);
+
+            CookedTexture texture{};
+            texture.format = select_block_format(job.settings.type, has_alpha(*source), job.settings.prefer_bc1);
+            texture.width = source->width;
+            texture.height = source->height;
+
+            start = Clock::now();
+            texture.levels.reserve(mips.size());
+            for (const auto& mip : mips) {
+                texture.levels.push_back(compress_level(mip, texture.format, job.settings));
+            }
+            result.compress_ms = elapsed_ms(start);
+
+            if (measure_psnr) {
+                result.psnr.reserve(mips.size());
+                for (size_t i = 0; i < mips.size(); ++i) {
+                    const auto decoded = decompress_level(texture.levels[i], texture.format);
+                    result.psnr.push_back(compute_psnr(mips[i], decoded, texture.format));
+                }
+            }
+
+            start = Clock::now();
+            if (auto written = write_ktx2(job.output, texture); !written) {
+                result.error = written.error();
+                return result;
+            }
+            result.write_ms = elapsed_ms(start);
+
+            std::error_code ec;
+            result.output_bytes = std::filesystem::file_size(job.output, ec);
+            result.format = texture.format;
+            result.width = texture.width;
+            result.height = texture.height;
+            result.mip_levels = static_cast<uint32_t>(texture.levels.size());
+            result.success = true;
+            return result;
+        }
+    } // anonymous namespace
+
+    auto load_source_image(const std::filesystem::path& path) -> std::expected<SourceImage, std::string> {
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        stbi_uc* pixels = stbi_load(path.string().c_str(), &width, &height, &channels, STBI_rgb_alpha);
+        if (!pixels) {
+            return std::unexpected(std::format("failed to load {}: {}", path.string(), stbi_failure_reason()));
+        }
+
+        SourceImage image{};
+        image.width = static_cast<uint32_t>(width);
+        image.height = static_cast<uint32_t>(height);
+        image.pixels.resize(static_cast<size_t>(width) * height * 4);
+        std::memcpy(image.pixels.data(), pixels, image.pixels.size());
+        stbi_image_free(pixels);
+        return image;
+    }
+
+    auto cook_texture(const SourceImage& source, const TextureCookSettings& settings) -> CookedTexture {
+        const auto mips = generate_mip_chain(source, settings);
+
+        CookedTexture texture{};
+        texture.format = select_block_format(settings.type, has_alpha(source), settings.prefer_bc1);
+        texture.width = source.width;
+        texture.height = source.height;
+        texture.levels.reserve(mips.size());
+        for (const auto& mip : mips) {
+            texture.levels.push_back(compress_level(mip, texture.format, settings));
+        }
+        return texture;
+    }
+
+    auto cook_textures(std::span<const CookJob> jobs, const BatchSettings& batch) -> std::vector<CookResult> {
+        std::vector<CookResult> results(jobs.size());
+        if (jobs.empty()) {
+            return results;
+        }
+
+        // Whole images are the cheapest unit to parallelize; only split an image's work when
+        // there aren't enough images to keep every worker busy
+        const uint32_t threads = detail::resolve_thread_count(batch.threads);
+        const auto job_count = static_cast<uint32_t>(jobs.size());
+        const uint32_t image_threads = std::min(threads, job_count);
+        const uint32_t inner_threads = std::max(1u, threads / image_threads);
+
+        detail::parallel_for(job_count, image_threads, [&](uint32_t i) {
+            CookJob job = jobs[i];
+            job.settings.threads = inner_threads;
+            results[i] = cook_job(job, batch.measure_psnr);
+            if (!results[i].success) {
+                FED_ERROR("Failed to cook {}: {}", job.input.string(), results[i].error);
+            }
+        });
+
+        return results;
+    }
+} // namespace replicator
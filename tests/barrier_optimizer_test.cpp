@@ -0,0 +1,292 @@
+#include "batleth/barrier_optimizer.hpp"
+#include "batleth/subresource_tracker.hpp"
+#include "test_harness.hpp"
+
+#include <vector>
+
+namespace {
+    using batleth::PassBarrier;
+    using batleth::ResourceState;
+    using batleth::StateRequirement;
+    using batleth::SubresourceRange;
+
+    const ResourceState COLOR_WRITE{
+        .stage_mask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+        .access_mask = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+        .layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
+    };
+
+    const ResourceState FRAGMENT_READ{
+        .stage_mask = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+        .access_mask = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+        .layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+    };
+
+    const ResourceState COMPUTE_READ{
+        .stage_mask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+        .access_mask = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+        .layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+    };
+
+    const ResourceState TRANSFER_WRITE{
+        .stage_mask = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+        .access_mask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+        .layout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+    };
+
+    // Per-pass requirement lists flattened into the optimizer's input layout
+    struct GraphInput {
+        std::vector<ResourceState> initial_states;
+        std::vector<SubresourceRange> extents;
+        std::vector<StateRequirement> requirements;
+        std::vector<std::uint32_t> offsets{0};
+        std::vector<StateRequirement> final_requirements;
+
+        explicit GraphInput(std::size_t resource_count) : initial_states(resource_count) {
+        }
+
+        auto pass(std::initializer_list<StateRequirement> pass_requirements) -> GraphInput & {
+            requirements.insert(requirements.end(), pass_requirements);
+            offsets.push_back(static_cast<std::uint32_t>(requirements.size()));
+            return *this;
+        }
+
+        auto optimize(const batleth::BarrierOptimizerConfig &config) const -> batleth::OptimizedBarriers {
+            return batleth::optimize_barriers({
+                .initial_states = initial_states,
+                .subresource_extents = extents,
+                .requirements = requirements,
+                .requirement_offsets = offsets,
+                .final_requirements = final_requirements
+            }, config);
+        }
+    };
+
+    constexpr batleth::BarrierOptimizerConfig NO_SPLITS{.enable_split_barriers = false};
+
+    auto pass_barrier_count(const batleth::OptimizedBarriers &result, std::uint32_t pass) -> std::uint32_t {
+        return result.pass_offsets[pass + 1] - result.pass_offsets[pass];
+    }
+
+    auto barrier(batleth::ResourceHandle resource, SubresourceRange range) -> PassBarrier {
+        return {.resource = resource, .before = COLOR_WRITE, .after = FRAGMENT_READ, .range = range};
+    }
+}
+
+TEST_CASE(read_after_read_is_eliminated) {
+    GraphInput input(1);
+    input.pass({{.resource = 0, .state = COLOR_WRITE}})
+         .pass({{.resource = 0, .state = FRAGMENT_READ}})
+         .pass({{.resource = 0, .state = COMPUTE_READ}})
+         .pass({{.resource = 0, .state = FRAGMENT_READ}});
+
+    const auto result = input.optimize(NO_SPLITS);
+    CHECK_EQ(pass_barrier_count(result, 0), 1u);
+    CHECK_EQ(pass_barrier_count(result, 1), 1u);
+    CHECK_EQ(pass_barrier_count(result, 2), 0u);
+    CHECK_EQ(pass_barrier_count(result, 3), 0u);
+    CHECK_EQ(result.stats.requested, 4u);
+    CHECK_EQ(result.stats.eliminated, 2u);
+    CHECK_EQ(result.stats.emitted, 2u);
+}
+
+TEST_CASE(writer_after_reads_waits_on_every_reader) {
+    GraphInput input(1);
+    input.pass({{.resource = 0, .state = COLOR_WRITE}})
+         .pass({{.resource = 0, .state = FRAGMENT_READ}})
+         .pass({{.resource = 0, .state = COMPUTE_READ}})
+         .pass({{.resource = 0, .state = COLOR_WRITE}});
+
+    const auto result = input.optimize(NO_SPLITS);
+    REQUIRE(pass_barrier_count(result, 3) == 1);
+
+    const auto &write = result.barriers[result.pass_offsets[3]];
+    CHECK_EQ(write.before.stage_mask,
+             VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
+    CHECK_EQ(write.after.layout, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+}
+
+TEST_CASE(requirements_within_a_pass_are_combined) {
+    GraphInput input(1);
+    input.pass({{.resource = 0, .state = FRAGMENT_READ}, {.resource = 0, .state = COMPUTE_READ}});
+
+    const auto result = input.optimize(NO_SPLITS);
+    CHECK_EQ(result.stats.requested, 1u);
+    REQUIRE(pass_barrier_count(result, 0) == 1);
+    CHECK_EQ(result.barriers[0].after.stage_mask,
+             VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
+}
+
+TEST_CASE(adjacent_mip_ranges_merge) {
+    std::vector<PassBarrier> barriers{
+        barrier(0, {.base_mip = 2, .mip_count = 1, .base_layer = 0, .layer_count = 1}),
+        barrier(0, {.base_mip = 0, .mip_count = 1, .base_layer = 0, .layer_count = 1}),
+        barrier(0, {.base_mip = 1, .mip_count = 1, .base_layer = 0, .layer_count = 1}),
+    };
+
+    // [2] and [0] don't touch until [1] joins them, so merging has to revisit earlier barriers
+    CHECK_EQ(batleth::merge_subresource_ranges(barriers), 2u);
+    REQUIRE(barriers.size() == 1);
+    CHECK_EQ(barriers[0].range.base_mip, 0u);
+    CHECK_EQ(barriers[0].range.mip_count, 3u);
+}
+
+TEST_CASE(adjacent_layer_ranges_merge_into_remaining) {
+    std::vector<PassBarrier> barriers{
+        barrier(0, {.base_mip = 0, .mip_count = 4, .base_layer = 0, .layer_count = 2}),
+        barrier(0, {.base_mip = 0, .mip_count = 4, .base_layer = 2, .layer_count = VK_REMAINING_ARRAY_LAYERS}),
+    };
+
+    CHECK_EQ(batleth::merge_subresource_ranges(barriers), 1u);
+    REQUIRE(barriers.size() == 1);
+    CHECK_EQ(barriers[0].range.base_layer, 0u);
+    CHECK_EQ(barriers[0].range.layer_count, static_cast<std::uint32_t>(VK_REMAINING_ARRAY_LAYERS));
+}
+
+TEST_CASE(ranges_that_differ_do_not_merge) {
+    auto other_state = barrier(0, {.base_mip = 1, .mip_count = 1, .base_layer = 0, .layer_count = 1});
+    other_state.after = COMPUTE_READ;
+
+    std::vector<PassBarrier> barriers{
+        barrier(0, {.base_mip = 0, .mip_count = 1, .base_layer = 0, .layer_count = 1}),
+        barrier(1, {.base_mip = 1, .mip_count = 1, .base_layer = 0, .layer_count = 1}),  // Other resource
+        other_state,
+        barrier(0, {.base_mip = 2, .mip_count = 1, .base_layer = 1, .layer_count = 1}),  // Diagonal
+        barrier(0, {.base_mip = 3, .mip_count = 1, .base_layer = 0, .layer_count = 1}),  // Gap at mip 2
+    };
+
+    CHECK_EQ(batleth::merge_subresource_ranges(barriers), 0u);
+    CHECK_EQ(barriers.size(), 5u);
+}
+
+TEST_CASE(tracker_coalesces_layers_back_into_one_barrier) {
+    batleth::SubresourceStateTracker tracker(1, 4, {});
+    std::vector<PassBarrier> out;
+
+    CHECK_EQ(tracker.transition({.base_layer = 0, .layer_count = 2}, TRANSFER_WRITE, out, 0), 1u);
+    CHECK_EQ(tracker.transition({.base_layer = 2, .layer_count = 2}, TRANSFER_WRITE, out, 0), 1u);
+    CHECK(tracker.is_uniform());
+
+    out.clear();
+    CHECK_EQ(tracker.transition({}, FRAGMENT_READ, out, 0), 1u);
+    REQUIRE(out.size() == 1);
+    CHECK_EQ(out[0].range.base_layer, 0u);
+    CHECK_EQ(out[0].range.layer_count, 4u);
+    CHECK_EQ(out[0].before.layout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+}
+
+TEST_CASE(tracker_splits_on_partial_writes) {
+    batleth::SubresourceStateTracker tracker(4, 1, {});
+    std::vector<PassBarrier> out;
+
+    tracker.transition({.base_mip = 1, .mip_count = 1}, TRANSFER_WRITE, out, 0);
+    CHECK_EQ(tracker.get_run_count(), 3u);
+    CHECK_EQ(tracker.get_state(1, 0).layout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    CHECK_EQ(tracker.get_state(2, 0).layout, VK_IMAGE_LAYOUT_UNDEFINED);
+
+    // Mips 0 and 2-3 share a before state but aren't adjacent, so they stay separate
+    out.clear();
+    CHECK_EQ(tracker.transition({}, FRAGMENT_READ, out, 0), 3u);
+    CHECK(tracker.is_uniform());
+}
+
+TEST_CASE(optimizer_merges_ranges_written_in_one_pass) {
+    GraphInput input(1);
+    input.extents = {{.mip_count = 4, .layer_count = 1}};
+    input.pass({
+        {.resource = 0, .state = TRANSFER_WRITE, .range = {.base_mip = 0, .mip_count = 2}},
+        {.resource = 0, .state = TRANSFER_WRITE, .range = {.base_mip = 2, .mip_count = 2}}
+    });
+
+    const auto result = input.optimize(NO_SPLITS);
+    REQUIRE(pass_barrier_count(result, 0) == 1);
+    CHECK_EQ(result.barriers[0].range.base_mip, 0u);
+    CHECK_EQ(result.barriers[0].range.mip_count, 4u);
+    CHECK_EQ(result.stats.merged, 1u);
+}
+
+TEST_CASE(mip_chain_only_barriers_touched_levels) {
+    GraphInput input(1);
+    input.extents = {{.mip_count = 4, .layer_count = 1}};
+    input.pass({{.resource = 0, .state = TRANSFER_WRITE}})
+         .pass({{.resource = 0, .state = FRAGMENT_READ, .range = {.base_mip = 0, .mip_count = 1}}})
+         .pass({{.resource = 0, .state = FRAGMENT_READ, .range = {.base_mip = 1, .mip_count = 1}}});
+
+    const auto result = input.optimize(NO_SPLITS);
+    REQUIRE(pass_barrier_count(result, 1) == 1);
+    REQUIRE(pass_barrier_count(result, 2) == 1);
+    CHECK_EQ(result.barriers[result.pass_offsets[1]].range.base_mip, 0u);
+    CHECK_EQ(result.barriers[result.pass_offsets[1]].range.mip_count, 1u);
+    CHECK_EQ(result.barriers[result.pass_offsets[2]].range.base_mip, 1u);
+    CHECK_EQ(result.barriers[result.pass_offsets[2]].range.mip_count, 1u);
+}
+
+TEST_CASE(distant_consumers_get_grouped_split_barriers) {
+    // A and B are written together and read three passes later: one event for both.
+    // D is produced by a different pass for the same consumer: a second event.
+    // C is read right after it's written: an ordinary barrier.
+    constexpr batleth::ResourceHandle A = 0, B = 1, C = 2, D = 3;
+    GraphInput input(4);
+    input.pass({{.resource = A, .state = COLOR_WRITE}, {.resource = B, .state = COLOR_WRITE}})
+         .pass({{.resource = C, .state = COLOR_WRITE}, {.resource = D, .state = COLOR_WRITE}})
+         .pass({{.resource = C, .state = FRAGMENT_READ}})
+         .pass({
+             {.resource = A, .state = FRAGMENT_READ},
+             {.resource = B, .state = FRAGMENT_READ},
+             {.resource = D, .state = FRAGMENT_READ}
+         });
+
+    const auto result = input.optimize({.split_distance = 2, .enable_split_barriers = true});
+
+    CHECK_EQ(pass_barrier_count(result, 2), 1u);
+    CHECK_EQ(pass_barrier_count(result, 3), 0u);
+    CHECK_EQ(result.stats.split, 3u);
+
+    REQUIRE(result.split_groups.size() == 2);
+    const auto &first = result.split_groups[0];
+    const auto &second = result.split_groups[1];
+    CHECK_EQ(first.signal_pass, 0u);
+    CHECK_EQ(first.wait_pass, 3u);
+    CHECK_EQ(first.barrier_count, 2u);
+    CHECK_EQ(second.signal_pass, 1u);
+    CHECK_EQ(second.wait_pass, 3u);
+    CHECK_EQ(second.barrier_count, 1u);
+    CHECK_EQ(result.split_barriers[second.first_barrier].resource, D);
+
+    // Both groups are waited on before pass 3; each producer signals its own
+    CHECK_EQ(result.split_wait_offsets[3], 0u);
+    CHECK_EQ(result.split_wait_offsets[4], 2u);
+    CHECK_EQ(result.split_signal_offsets[1] - result.split_signal_offsets[0], 1u);
+    CHECK_EQ(result.split_signal_offsets[2] - result.split_signal_offsets[1], 1u);
+    CHECK_EQ(result.split_groups[result.split_signal_order[result.split_signal_offsets[1]]].signal_pass, 1u);
+}
+
+TEST_CASE(nearby_consumers_use_pipeline_barriers) {
+    GraphInput input(1);
+    input.pass({{.resource = 0, .state = COLOR_WRITE}})
+         .pass({{.resource = 0, .state = FRAGMENT_READ}});
+
+    const auto result = input.optimize({.split_distance = 2, .enable_split_barriers = true});
+    CHECK(result.split_groups.empty());
+    CHECK_EQ(pass_barrier_count(result, 1), 1u);
+}
+
+TEST_CASE(final_requirements_transition_after_last_pass) {
+    GraphInput input(1);
+    input.pass({{.resource = 0, .state = COLOR_WRITE}});
+
+    const ResourceState present{
+        .stage_mask = VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT,
+        .access_mask = VK_ACCESS_2_NONE,
+        .layout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
+    };
+    input.final_requirements = {{.resource = 0, .state = present}};
+
+    const auto result = input.optimize(NO_SPLITS);
+
+    REQUIRE(result.final_barriers.size() == 1);
+    CHECK_EQ(result.final_barriers[0].after.layout, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+    CHECK_EQ(result.stats.batches, 2u);
+}
+
+TEST_MAIN()
@@ -0,0 +1,133 @@
+#include "borg/input_recording.hpp"
+#include "test_harness.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace {
+    using borg::InputEvent;
+    using borg::InputPlayback;
+    using borg::InputRecorder;
+
+    auto temp_path(std::string_view name) -> std::filesystem::path {
+        return std::filesystem::temp_directory_path() / std::filesystem::path(name);
+    }
+
+    auto make_event(InputEvent::Type type, double x, double y) -> InputEvent {
+        InputEvent event{};
+        event.type = type;
+        event.x = x;
+        event.y = y;
+        return event;
+    }
+
+    // Two frames: a cursor move on the first, nothing on the second
+    auto write_recording(const std::filesystem::path& path) -> void {
+        auto recorder = InputRecorder::create(path, 320.0, 240.0);
+        REQUIRE(recorder != nullptr);
+        const std::vector events{make_event(InputEvent::Type::CursorPos, 330.0, 250.0)};
+        recorder->write_batch(1, 1.0f / 60.0f, events);
+        recorder->write_batch(2, 1.0f / 60.0f, {});
+    }
+
+    auto read_bytes(const std::filesystem::path& path) -> std::vector<char> {
+        std::ifstream file(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
+    auto write_bytes(const std::filesystem::path& path, const std::vector<char>& bytes) -> void {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    // magic, version, cursor x, cursor y
+    constexpr size_t HEADER_SIZE = 4 + 4 + 8 + 8;
+    // frame, delta time
+    constexpr size_t COUNT_OFFSET = HEADER_SIZE + 4 + 4;
+}
+
+TEST_CASE(round_trip_keeps_batches_and_start_cursor) {
+    const auto path = temp_path("input_recording_round_trip.kinput");
+    write_recording(path);
+
+    auto playback = InputPlayback::load(path);
+    REQUIRE(playback != nullptr);
+    CHECK_EQ(playback->get_batch_count(), 2u);
+    CHECK(playback->get_start_cursor() == std::pair(320.0, 240.0));
+
+    const auto* first = playback->next_batch(1);
+    REQUIRE(first != nullptr);
+    REQUIRE(first->events.size() == 1);
+    CHECK_EQ(first->events[0].x, 330.0);
+    CHECK_EQ(first->events[0].y, 250.0);
+
+    const auto* second = playback->next_batch(2);
+    REQUIRE(second != nullptr);
+    CHECK(second->events.empty());
+    CHECK(playback->is_finished());
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE(rejects_count_larger_than_the_file) {
+    const auto path = temp_path("input_recording_bad_count.kinput");
+    write_recording(path);
+
+    auto bytes = read_bytes(path);
+    REQUIRE(bytes.size() > COUNT_OFFSET + 4);
+    const std::uint32_t count = 0xFFFFFFFF;
+    std::memcpy(bytes.data() + COUNT_OFFSET, &count, sizeof(count));
+    write_bytes(path, bytes);
+
+    CHECK(InputPlayback::load(path) == nullptr);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE(rejects_count_one_past_the_remaining_events) {
+    const auto path = temp_path("input_recording_off_by_one.kinput");
+    write_recording(path);
+
+    // The first batch claims its own event plus everything after it, and one event more
+    auto bytes = read_bytes(path);
+    REQUIRE(bytes.size() > COUNT_OFFSET + 4);
+    const auto remaining = bytes.size() - (COUNT_OFFSET + 4);
+    const auto count = static_cast<std::uint32_t>(remaining / sizeof(InputEvent) + 1);
+    std::memcpy(bytes.data() + COUNT_OFFSET, &count, sizeof(count));
+    write_bytes(path, bytes);
+
+    CHECK(InputPlayback::load(path) == nullptr);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE(rejects_truncated_batch) {
+    const auto path = temp_path("input_recording_truncated.kinput");
+    write_recording(path);
+
+    auto bytes = read_bytes(path);
+    REQUIRE(bytes.size() > HEADER_SIZE);
+    bytes.erase(bytes.end() - 2, bytes.end());
+    write_bytes(path, bytes);
+
+    CHECK(InputPlayback::load(path) == nullptr);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE(rejects_other_versions) {
+    const auto path = temp_path("input_recording_version.kinput");
+    write_recording(path);
+
+    auto bytes = read_bytes(path);
+    const std::uint32_t version = borg::INPUT_RECORDING_VERSION - 1;
+    std::memcpy(bytes.data() + 4, &version, sizeof(version));
+    write_bytes(path, bytes);
+
+    CHECK(InputPlayback::load(path) == nullptr);
+    std::filesystem::remove(path);
+}
+
+TEST_MAIN()
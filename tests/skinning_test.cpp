@@ -0,0 +1,210 @@
+#include "klingon/animation/skinning.hpp"
+#include "test_harness.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <format>
+#include <vector>
+
+namespace {
+    using klingon::SkinMatrix;
+    using klingon::Vertex;
+    using klingon::VertexSkin;
+
+    constexpr float TOLERANCE = 1e-4f;
+    constexpr uint16_t FULL_WEIGHT = 65535;
+
+    /**
+     * Three-joint rig: a root lifted two units, a forearm rotated 90 degrees about Z and moved
+     * one unit along X, and a joint scaling uniformly by two so normals need renormalising
+     */
+    auto make_palette() -> std::array<SkinMatrix, 3> {
+        std::array<SkinMatrix, 3> palette{};
+        palette[0].rows[0] = {1.0f, 0.0f, 0.0f, 0.0f};
+        palette[0].rows[1] = {0.0f, 1.0f, 0.0f, 2.0f};
+        palette[0].rows[2] = {0.0f, 0.0f, 1.0f, 0.0f};
+
+        palette[1].rows[0] = {0.0f, -1.0f, 0.0f, 1.0f};
+        palette[1].rows[1] = {1.0f, 0.0f, 0.0f, 0.0f};
+        palette[1].rows[2] = {0.0f, 0.0f, 1.0f, 0.0f};
+
+        palette[2].rows[0] = {2.0f, 0.0f, 0.0f, 0.0f};
+        palette[2].rows[1] = {0.0f, 2.0f, 0.0f, 0.0f};
+        palette[2].rows[2] = {0.0f, 0.0f, 2.0f, 0.0f};
+        return palette;
+    }
+
+    auto make_vertex(glm::vec3 position, glm::vec3 normal) -> Vertex {
+        Vertex vertex{};
+        vertex.position = position;
+        vertex.normal = normal;
+        vertex.color = {0.25f, 0.5f, 0.75f};
+        vertex.uv = {0.125f, 0.875f};
+        return vertex;
+    }
+
+    auto make_skin(std::array<uint16_t, 4> joints, std::array<uint16_t, 4> weights) -> VertexSkin {
+        VertexSkin skin{};
+        for (size_t i = 0; i < 4; ++i) {
+            skin.joints[i] = joints[i];
+            skin.weights[i] = weights[i];
+        }
+        return skin;
+    }
+
+    /**
+     * Scalar linear blend skinning in double precision, written from the definition rather than
+     * the SIMD implementation: sum the weighted matrices, transform, renormalise the normal
+     */
+    auto reference_skin(const Vertex& vertex, const VertexSkin& skin, std::span<const SkinMatrix> palette) -> Vertex {
+        if (skin.weights[0] == 0) {
+            return vertex;
+        }
+
+        double matrix[3][4] = {};
+        for (size_t influence = 0; influence < 4; ++influence) {
+            if (skin.weights[influence] == 0 || skin.joints[influence] >= palette.size()) {
+                continue;
+            }
+            const double weight = static_cast<double>(skin.weights[influence]) / FULL_WEIGHT;
+            for (int row = 0; row < 3; ++row) {
+                for (int column = 0; column < 4; ++column) {
+                    matrix[row][column] += weight * palette[skin.joints[influence]].rows[row][column];
+                }
+            }
+        }
+
+        Vertex skinned = vertex;
+        double normal[3];
+        for (int row = 0; row < 3; ++row) {
+            const double* m = matrix[row];
+            skinned.position[row] = static_cast<float>(
+                m[0] * vertex.position.x + m[1] * vertex.position.y + m[2] * vertex.position.z + m[3]);
+            normal[row] = m[0] * vertex.normal.x + m[1] * vertex.normal.y + m[2] * vertex.normal.z;
+        }
+        const double length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        for (int row = 0; row < 3; ++row) {
+            skinned.normal[row] = static_cast<float>(length > 0.0 ? normal[row] / length : normal[row]);
+        }
+        return skinned;
+    }
+
+    auto near(const glm::vec3& actual, const glm::vec3& expected) -> bool {
+        for (int i = 0; i < 3; ++i) {
+            if (std::abs(actual[i] - expected[i]) > TOLERANCE) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    auto check_near(const glm::vec3& actual, const glm::vec3& expected, std::string_view what, size_t index) -> void {
+        if (!CHECK(near(actual, expected))) {
+            std::cerr << std::format("  vertex {} {}: ({}, {}, {}), expected ({}, {}, {})\n", index, what,
+                                     actual.x, actual.y, actual.z, expected.x, expected.y, expected.z);
+        }
+    }
+
+    auto skin(const std::vector<Vertex>& vertices, const std::vector<VertexSkin>& skins,
+              std::span<const SkinMatrix> palette) -> std::vector<Vertex> {
+        std::vector<Vertex> output(vertices.size());
+        klingon::skin_vertices(vertices, skins, palette, output);
+        return output;
+    }
+}
+
+TEST_CASE(single_joint_applies_its_transform) {
+    const auto palette = make_palette();
+    const std::vector vertices{make_vertex({1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f})};
+    const std::vector skins{make_skin({1, 0, 0, 0}, {FULL_WEIGHT, 0, 0, 0})};
+
+    const auto output = skin(vertices, skins, palette);
+    check_near(output[0].position, {1.0f, 1.0f, 0.0f}, "position", 0);
+    check_near(output[0].normal, {0.0f, 1.0f, 0.0f}, "normal", 0);
+}
+
+TEST_CASE(even_blend_is_halfway_between_joints) {
+    const auto palette = make_palette();
+    const std::vector vertices{make_vertex({1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f})};
+    const std::vector skins{make_skin({0, 1, 0, 0}, {32768, 32767, 0, 0})};
+
+    // Joint 0 puts it at (1, 2, 0), joint 1 at (1, 1, 0)
+    const auto output = skin(vertices, skins, palette);
+    check_near(output[0].position, {1.0f, 1.5f, 0.0f}, "position", 0);
+    check_near(output[0].normal, {0.0f, 0.0f, 1.0f}, "normal", 0);
+}
+
+TEST_CASE(matches_reference_across_weight_mixes) {
+    const auto palette = make_palette();
+    const std::array<std::array<uint16_t, 4>, 5> weight_mixes{{
+        {FULL_WEIGHT, 0, 0, 0},
+        {40000, 25535, 0, 0},
+        {30000, 20000, 15535, 0},
+        {20000, 20000, 15000, 10535},
+        {50000, 10000, 5000, 535}
+    }};
+    const std::array<std::array<uint16_t, 4>, 3> joint_sets{{{0, 1, 2, 0}, {1, 2, 0, 1}, {2, 0, 1, 2}}};
+
+    std::vector<Vertex> vertices;
+    std::vector<VertexSkin> skins;
+    for (const auto& weights : weight_mixes) {
+        for (const auto& joints : joint_sets) {
+            const float t = static_cast<float>(vertices.size());
+            vertices.push_back(make_vertex({0.5f * t - 3.0f, 1.0f - 0.25f * t, 0.1f * t},
+                                           {0.6f, 0.0f, 0.8f}));
+            skins.push_back(make_skin(joints, weights));
+        }
+    }
+
+    const auto output = skin(vertices, skins, palette);
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const Vertex expected = reference_skin(vertices[i], skins[i], palette);
+        check_near(output[i].position, expected.position, "position", i);
+        check_near(output[i].normal, expected.normal, "normal", i);
+    }
+}
+
+TEST_CASE(unweighted_vertex_keeps_bind_pose) {
+    const auto palette = make_palette();
+    const std::vector vertices{make_vertex({3.0f, -1.0f, 2.0f}, {0.0f, 1.0f, 0.0f})};
+    const std::vector skins{make_skin({1, 2, 0, 0}, {0, 0, 0, 0})};
+
+    const auto output = skin(vertices, skins, palette);
+    CHECK(output[0] == vertices[0]);
+}
+
+TEST_CASE(out_of_range_joint_is_ignored) {
+    const auto palette = make_palette();
+    const std::vector vertices{make_vertex({1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f})};
+    const std::vector skins{make_skin({7, 1, 0, 0}, {32768, 32767, 0, 0})};
+
+    // Only joint 1's half survives; the weights are not renormalised
+    const auto output = skin(vertices, skins, palette);
+    const Vertex expected = reference_skin(vertices[0], skins[0], palette);
+    check_near(output[0].position, expected.position, "position", 0);
+    check_near(output[0].position, {0.5f, 0.5f, 0.0f}, "position", 0);
+    check_near(output[0].normal, {0.0f, 1.0f, 0.0f}, "normal", 0);
+}
+
+TEST_CASE(scaled_normals_are_renormalised) {
+    const auto palette = make_palette();
+    const std::vector vertices{make_vertex({1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 1.0f})};
+    const std::vector skins{make_skin({2, 0, 0, 0}, {FULL_WEIGHT, 0, 0, 0})};
+
+    const auto output = skin(vertices, skins, palette);
+    check_near(output[0].position, {2.0f, 2.0f, 2.0f}, "position", 0);
+    check_near(output[0].normal, {0.0f, 0.0f, 1.0f}, "normal", 0);
+}
+
+TEST_CASE(other_attributes_are_copied) {
+    const auto palette = make_palette();
+    const std::vector vertices{make_vertex({1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f})};
+    const std::vector skins{make_skin({1, 0, 0, 0}, {FULL_WEIGHT, 0, 0, 0})};
+
+    const auto output = skin(vertices, skins, palette);
+    CHECK(output[0].color == vertices[0].color);
+    CHECK(output[0].uv == vertices[0].uv);
+}
+
+TEST_MAIN()
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <format>
+#include <iostream>
+#include <source_location>
+#include <string_view>
+#include <vector>
+
+/**
+ * Minimal self-registering test harness.
+ * Each test executable defines cases with TEST_CASE and ends with TEST_MAIN(); ctest runs the
+ * executable and a non-zero exit code marks it failed.
+ */
+namespace test {
+    struct Case {
+        std::string_view name;
+        void (*run)();
+    };
+
+    inline auto get_cases() -> std::vector<Case> & {
+        static std::vector<Case> cases;
+        return cases;
+    }
+
+    inline int g_failures = 0;
+
+    struct Registration {
+        Registration(std::string_view name, void (*run)()) {
+            get_cases().push_back({name, run});
+        }
+    };
+
+    inline auto check(bool passed, std::string_view expression,
+                      std::source_location location = std::source_location::current()) -> bool {
+        if (!passed) {
+            ++g_failures;
+            std::cerr << std::format("{}:{}: check failed: {}\n", location.file_name(), location.line(), expression);
+        }
+        return passed;
+    }
+
+    template<typename A, typename B>
+    auto check_equal(const A &actual, const B &expected, std::string_view expression,
+                     std::source_location location = std::source_location::current()) -> bool {
+        if (actual == expected) {
+            return true;
+        }
+        ++g_failures;
+        if constexpr (requires { std::format("{} {}", actual, expected); }) {
+            std::cerr << std::format("{}:{}: check failed: {} ({} != {})\n", location.file_name(), location.line(),
+                                     expression, actual, expected);
+        } else {
+            std::cerr << std::format("{}:{}: check failed: {}\n", location.file_name(), location.line(), expression);
+        }
+        return false;
+    }
+
+    inline auto run_all() -> int {
+        for (const auto &test_case: get_cases()) {
+            const int failures_before = g_failures;
+            test_case.run();
+            std::cout << std::format("[{}] {}\n", g_failures == failures_before ? "pass" : "FAIL", test_case.name);
+        }
+        std::cout << std::format("{} cases, {} failed checks\n", get_cases().size(), g_failures);
+        return g_failures == 0 ? 0 : 1;
+    }
+} // namespace test
+
+#define TEST_CASE(name)                                                  \
+    static void name();                                                  \
+    static const ::test::Registration name##_registration(#name, name); \
+    static void name()
+
+#define CHECK(expression) ::test::check(static_cast<bool>(expression), #expression)
+#define CHECK_EQ(actual, expected) ::test::check_equal((actual), (expected), #actual " == " #expected)
+
+// Stop the current case when a precondition for the remaining checks doesn't hold
+#define REQUIRE(expression) \
+    if (!CHECK(expression)) return
+
+#define TEST_MAIN() \
+    auto main() -> int { return ::test::run_all(); }
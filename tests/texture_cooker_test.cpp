@@ -0,0 +1,157 @@
+#include "replicator/block_compressor.hpp"
+#include "replicator/mip_generator.hpp"
+#include "replicator/texture_cooker.hpp"
+#include "test_harness.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <format>
+#include <numbers>
+#include <vector>
+
+namespace {
+    using replicator::SourceImage;
+    using replicator::TextureCookSettings;
+
+    constexpr uint32_t IMAGE_SIZE = 64;
+
+    auto to_unorm8(double value) -> uint8_t {
+        return static_cast<uint8_t>(std::lround(std::clamp(value, 0.0, 1.0) * 255.0));
+    }
+
+    /**
+     * Smooth, low-frequency content: what real albedo and mask textures mostly look like, and
+     * where every block format should comfortably clear its threshold
+     */
+    auto make_colour_image(bool alpha) -> SourceImage {
+        SourceImage image{
+            .width = IMAGE_SIZE,
+            .height = IMAGE_SIZE,
+            .pixels = std::vector<uint8_t>(static_cast<size_t>(IMAGE_SIZE) * IMAGE_SIZE * 4)
+        };
+
+        constexpr double frequency = 2.0 * std::numbers::pi / IMAGE_SIZE;
+        for (uint32_t y = 0; y < IMAGE_SIZE; ++y) {
+            for (uint32_t x = 0; x < IMAGE_SIZE; ++x) {
+                uint8_t *pixel = &image.pixels[(static_cast<size_t>(y) * IMAGE_SIZE + x) * 4];
+                pixel[0] = to_unorm8(0.5 + 0.4 * std::sin(frequency * x));
+                pixel[1] = to_unorm8(0.5 + 0.4 * std::cos(frequency * y));
+                pixel[2] = to_unorm8(static_cast<double>(x + y) / (2.0 * IMAGE_SIZE));
+                pixel[3] = alpha ? to_unorm8(0.5 + 0.3 * std::sin(frequency * (x + y))) : 255;
+            }
+        }
+        return image;
+    }
+
+    // Tangent-space normals of a gently rolling height field
+    auto make_normal_image() -> SourceImage {
+        SourceImage image{
+            .width = IMAGE_SIZE,
+            .height = IMAGE_SIZE,
+            .pixels = std::vector<uint8_t>(static_cast<size_t>(IMAGE_SIZE) * IMAGE_SIZE * 4)
+        };
+
+        constexpr double frequency = 2.0 * std::numbers::pi / IMAGE_SIZE;
+        for (uint32_t y = 0; y < IMAGE_SIZE; ++y) {
+            for (uint32_t x = 0; x < IMAGE_SIZE; ++x) {
+                const double nx = 0.4 * std::cos(frequency * x);
+                const double ny = 0.4 * std::sin(frequency * y);
+                const double nz = std::sqrt(1.0 - nx * nx - ny * ny);
+
+                uint8_t *pixel = &image.pixels[(static_cast<size_t>(y) * IMAGE_SIZE + x) * 4];
+                pixel[0] = to_unorm8(nx * 0.5 + 0.5);
+                pixel[1] = to_unorm8(ny * 0.5 + 0.5);
+                pixel[2] = to_unorm8(nz * 0.5 + 0.5);
+                pixel[3] = 255;
+            }
+        }
+        return image;
+    }
+
+    /**
+     * Cook `source` and check the format, the mip chain and that every level decodes to within
+     * `min_psnr` dB of the uncompressed mip it was made from
+     */
+    auto check_cook(const SourceImage &source, const TextureCookSettings &settings,
+                    VkFormat expected_format, double min_psnr) -> void {
+        const auto texture = replicator::cook_texture(source, settings);
+        const auto mips = replicator::generate_mip_chain(source, settings);
+
+        CHECK_EQ(texture.format, expected_format);
+        CHECK_EQ(texture.levels.size(), 7u);  // 64x64 down to 1x1
+        REQUIRE(texture.levels.size() == mips.size());
+
+        for (size_t mip = 0; mip < mips.size(); ++mip) {
+            const auto &level = texture.levels[mip];
+            const uint64_t blocks = ((level.width + 3) / 4) * ((level.height + 3) / 4);
+            CHECK_EQ(level.data.size(), blocks * replicator::get_block_bytes(expected_format));
+
+            const auto decoded = replicator::decompress_level(level, texture.format);
+            const double psnr = replicator::compute_psnr(mips[mip], decoded, texture.format);
+            if (!CHECK(psnr >= min_psnr)) {
+                std::cerr << std::format("  {} mip {}: {:.2f} dB, expected at least {:.2f}\n",
+                                         replicator::get_block_format_name(texture.format), mip, psnr, min_psnr);
+            }
+        }
+    }
+
+    auto settings_for(batleth::TextureType type) -> TextureCookSettings {
+        return {.type = type, .threads = 2};
+    }
+}
+
+TEST_CASE(psnr_of_identical_images_is_infinite) {
+    const auto image = make_colour_image(true);
+    CHECK(std::isinf(replicator::compute_psnr(image, image, VK_FORMAT_BC7_UNORM_BLOCK)));
+}
+
+TEST_CASE(psnr_only_counts_stored_channels) {
+    const auto reference = make_colour_image(true);
+    auto green_shifted = reference;
+    for (size_t i = 1; i < green_shifted.pixels.size(); i += 4) {
+        green_shifted.pixels[i] ^= 0x10;
+    }
+
+    // BC4 keeps red only, so a green-only error is invisible to it
+    CHECK(std::isinf(replicator::compute_psnr(reference, green_shifted, VK_FORMAT_BC4_UNORM_BLOCK)));
+
+    // 16 levels off in one of four channels: 10 * log10(255^2 / (16^2 / 4))
+    const double psnr = replicator::compute_psnr(reference, green_shifted, VK_FORMAT_BC7_UNORM_BLOCK);
+    CHECK(std::abs(psnr - 30.07) < 0.01);
+}
+
+TEST_CASE(albedo_bc7_srgb) {
+    check_cook(make_colour_image(true), settings_for(batleth::TextureType::Albedo), VK_FORMAT_BC7_SRGB_BLOCK, 40.0);
+}
+
+TEST_CASE(opaque_albedo_bc1_srgb) {
+    auto settings = settings_for(batleth::TextureType::Albedo);
+    settings.prefer_bc1 = true;
+    check_cook(make_colour_image(false), settings, VK_FORMAT_BC1_RGB_SRGB_BLOCK, 32.0);
+}
+
+TEST_CASE(prefer_bc1_keeps_bc7_for_alpha) {
+    auto settings = settings_for(batleth::TextureType::Albedo);
+    settings.prefer_bc1 = true;
+    check_cook(make_colour_image(true), settings, VK_FORMAT_BC7_SRGB_BLOCK, 40.0);
+}
+
+TEST_CASE(normal_bc5) {
+    check_cook(make_normal_image(), settings_for(batleth::TextureType::Normal), VK_FORMAT_BC5_UNORM_BLOCK, 40.0);
+}
+
+TEST_CASE(metallic_roughness_bc5) {
+    check_cook(make_colour_image(false), settings_for(batleth::TextureType::MetallicRoughness),
+               VK_FORMAT_BC5_UNORM_BLOCK, 40.0);
+}
+
+TEST_CASE(opacity_bc4) {
+    check_cook(make_colour_image(false), settings_for(batleth::TextureType::Opacity), VK_FORMAT_BC4_UNORM_BLOCK, 40.0);
+}
+
+TEST_CASE(linear_colour_bc7) {
+    check_cook(make_colour_image(true), settings_for(batleth::TextureType::Unknown), VK_FORMAT_BC7_UNORM_BLOCK, 40.0);
+}
+
+TEST_MAIN()
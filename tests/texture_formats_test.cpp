@@ -0,0 +1,261 @@
+#include "klingon/texture_formats.hpp"
+#include "test_harness.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace {
+    using klingon::parse_dds;
+    using klingon::parse_ktx2;
+
+    constexpr uint32_t DDS_DATA_OFFSET = 4 + 124;
+    constexpr uint32_t DDS_DX10_DATA_OFFSET = DDS_DATA_OFFSET + 20;
+    constexpr uint32_t KTX2_LEVEL_INDEX = 80;
+    constexpr uint32_t KTX2_ZSTD = 2;
+
+    auto put_u32(std::vector<uint8_t> &data, size_t offset, uint32_t value) -> void {
+        for (size_t i = 0; i < 4; ++i) {
+            data[offset + i] = static_cast<uint8_t>(value >> (i * 8));
+        }
+    }
+
+    auto put_u64(std::vector<uint8_t> &data, size_t offset, uint64_t value) -> void {
+        put_u32(data, offset, static_cast<uint32_t>(value));
+        put_u32(data, offset + 4, static_cast<uint32_t>(value >> 32));
+    }
+
+    // Recognisable payload so tests can check which bytes ended up in which level
+    auto append_level(std::vector<uint8_t> &data, uint64_t size, uint8_t seed) -> void {
+        for (uint64_t i = 0; i < size; ++i) {
+            data.push_back(static_cast<uint8_t>(seed + i));
+        }
+    }
+
+    auto dds_header(uint32_t width, uint32_t height, uint32_t mips) -> std::vector<uint8_t> {
+        std::vector<uint8_t> data(DDS_DATA_OFFSET, 0);
+        put_u32(data, 0, 0x20534444);  // "DDS "
+        put_u32(data, 4, 124);
+        put_u32(data, 8, 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000);  // CAPS | HEIGHT | WIDTH | PIXELFORMAT | MIPMAPCOUNT
+        put_u32(data, 12, height);
+        put_u32(data, 16, width);
+        put_u32(data, 28, mips);
+        put_u32(data, 76, 32);
+        return data;
+    }
+
+    // Legacy header, 32-bit RGBA with R in the low byte
+    auto make_dds_rgba8(uint32_t width, uint32_t height, uint32_t mips) -> std::vector<uint8_t> {
+        auto data = dds_header(width, height, mips);
+        put_u32(data, 80, 0x40 | 0x1);  // DDPF_RGB | DDPF_ALPHAPIXELS
+        put_u32(data, 88, 32);
+        put_u32(data, 92, 0x000000FF);
+        put_u32(data, 96, 0x0000FF00);
+        put_u32(data, 100, 0x00FF0000);
+        put_u32(data, 104, 0xFF000000);
+        for (uint32_t mip = 0; mip < mips; ++mip) {
+            append_level(data, klingon::get_level_size(VK_FORMAT_R8G8B8A8_UNORM, std::max(width >> mip, 1u),
+                                                       std::max(height >> mip, 1u)), static_cast<uint8_t>(mip));
+        }
+        return data;
+    }
+
+    // DX10 header, BC7 sRGB
+    auto make_dds_bc7(uint32_t width, uint32_t height) -> std::vector<uint8_t> {
+        auto data = dds_header(width, height, 1);
+        put_u32(data, 80, 0x4);  // DDPF_FOURCC
+        put_u32(data, 84, 0x30315844);  // "DX10"
+        data.resize(DDS_DX10_DATA_OFFSET, 0);
+        put_u32(data, DDS_DATA_OFFSET, 99);  // DXGI_FORMAT_BC7_UNORM_SRGB
+        put_u32(data, DDS_DATA_OFFSET + 4, 3);  // D3D10_RESOURCE_DIMENSION_TEXTURE2D
+        put_u32(data, DDS_DATA_OFFSET + 12, 1);  // Array size
+        append_level(data, klingon::get_level_size(VK_FORMAT_BC7_SRGB_BLOCK, width, height), 0);
+        return data;
+    }
+
+    // Levels stored back to back after the index, mip 0 first
+    auto make_ktx2(VkFormat format, uint32_t width, uint32_t height, uint32_t levels) -> std::vector<uint8_t> {
+        std::vector<uint8_t> data{0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+        data.resize(KTX2_LEVEL_INDEX + static_cast<size_t>(levels) * 24, 0);
+        put_u32(data, 12, static_cast<uint32_t>(format));
+        put_u32(data, 16, 1);
+        put_u32(data, 20, width);
+        put_u32(data, 24, height);
+        put_u32(data, 36, 1);  // Faces
+        put_u32(data, 40, levels);
+
+        for (uint32_t mip = 0; mip < levels; ++mip) {
+            const uint64_t size = klingon::get_level_size(format, std::max(width >> mip, 1u),
+                                                          std::max(height >> mip, 1u));
+            const size_t entry = KTX2_LEVEL_INDEX + static_cast<size_t>(mip) * 24;
+            put_u64(data, entry, data.size());
+            put_u64(data, entry + 8, size);
+            put_u64(data, entry + 16, size);
+            append_level(data, size, static_cast<uint8_t>(mip));
+        }
+        return data;
+    }
+
+    auto parse_ktx2_default(const std::vector<uint8_t> &data) {
+        return parse_ktx2(data, batleth::TextureType::Albedo, {});
+    }
+}
+
+TEST_CASE(dds_rgba8_with_mips) {
+    const auto data = make_dds_rgba8(4, 2, 3);
+    const auto texture = parse_dds(data, false);
+    REQUIRE(texture.has_value());
+    CHECK_EQ(texture->format, VK_FORMAT_R8G8B8A8_UNORM);
+    REQUIRE(texture->levels.size() == 3);
+    CHECK_EQ(texture->levels[0].data.size(), 32u);
+    CHECK_EQ(texture->levels[1].width, 2u);
+    CHECK_EQ(texture->levels[1].height, 1u);
+    CHECK_EQ(texture->levels[1].data[0], 1u);
+    CHECK_EQ(texture->levels[2].data.size(), 4u);
+}
+
+TEST_CASE(dds_srgb_flag_applies_to_legacy_headers) {
+    const auto texture = parse_dds(make_dds_rgba8(4, 4, 1), true);
+    REQUIRE(texture.has_value());
+    CHECK_EQ(texture->format, VK_FORMAT_R8G8B8A8_SRGB);
+}
+
+TEST_CASE(dds_bc7_dx10) {
+    const auto texture = parse_dds(make_dds_bc7(8, 6), false);
+    REQUIRE(texture.has_value());
+    CHECK_EQ(texture->format, VK_FORMAT_BC7_SRGB_BLOCK);
+    REQUIRE(texture->levels.size() == 1);
+    CHECK_EQ(texture->levels[0].data.size(), 4u * 16u);  // 2x2 blocks
+}
+
+TEST_CASE(dds_truncated_header) {
+    auto data = make_dds_rgba8(4, 4, 1);
+    data.resize(100);
+    CHECK(!parse_dds(data, false).has_value());
+
+    CHECK(!parse_dds({}, false).has_value());
+}
+
+TEST_CASE(dds_truncated_dx10_header) {
+    auto data = make_dds_bc7(4, 4);
+    data.resize(DDS_DATA_OFFSET + 8);
+    CHECK(!parse_dds(data, false).has_value());
+}
+
+TEST_CASE(dds_truncated_level) {
+    auto data = make_dds_rgba8(4, 4, 3);
+    data.pop_back();
+    CHECK(!parse_dds(data, false).has_value());
+}
+
+TEST_CASE(dds_malformed_header) {
+    auto bad_magic = make_dds_rgba8(4, 4, 1);
+    bad_magic[0] = 'X';
+    CHECK(!parse_dds(bad_magic, false).has_value());
+
+    auto bad_size = make_dds_rgba8(4, 4, 1);
+    put_u32(bad_size, 4, 120);
+    CHECK(!parse_dds(bad_size, false).has_value());
+
+    auto zero_width = make_dds_rgba8(4, 4, 1);
+    put_u32(zero_width, 16, 0);
+    CHECK(!parse_dds(zero_width, false).has_value());
+
+    // Sizes would wrap in 32 bits and shifts past 31 are undefined; both must be rejected up front
+    auto huge = make_dds_rgba8(4, 4, 1);
+    put_u32(huge, 12, 0xFFFFFFFF);
+    put_u32(huge, 16, 0xFFFFFFFF);
+    CHECK(!parse_dds(huge, false).has_value());
+
+    auto too_many_mips = make_dds_rgba8(4, 4, 3);
+    put_u32(too_many_mips, 28, 40);
+    CHECK(!parse_dds(too_many_mips, false).has_value());
+
+    auto cube = make_dds_rgba8(4, 4, 1);
+    put_u32(cube, 4 + 108, 0x200);
+    CHECK(!parse_dds(cube, false).has_value());
+}
+
+TEST_CASE(ktx2_rgba8_with_mips) {
+    const auto texture = parse_ktx2_default(make_ktx2(VK_FORMAT_R8G8B8A8_UNORM, 4, 4, 3));
+    REQUIRE(texture.has_value());
+    CHECK_EQ(texture->format, VK_FORMAT_R8G8B8A8_UNORM);
+    REQUIRE(texture->levels.size() == 3);
+    CHECK_EQ(texture->levels[0].data.size(), 64u);
+    CHECK_EQ(texture->levels[2].width, 1u);
+    CHECK_EQ(texture->levels[2].data[0], 2u);
+}
+
+TEST_CASE(ktx2_bc7) {
+    const auto texture = parse_ktx2_default(make_ktx2(VK_FORMAT_BC7_UNORM_BLOCK, 8, 8, 2));
+    REQUIRE(texture.has_value());
+    CHECK_EQ(texture->format, VK_FORMAT_BC7_UNORM_BLOCK);
+    REQUIRE(texture->levels.size() == 2);
+    CHECK_EQ(texture->levels[0].data.size(), 64u);
+    CHECK_EQ(texture->levels[1].data.size(), 16u);
+}
+
+TEST_CASE(ktx2_truncated) {
+    auto header_only = make_ktx2(VK_FORMAT_R8G8B8A8_UNORM, 4, 4, 1);
+    header_only.resize(60);
+    CHECK(!parse_ktx2_default(header_only).has_value());
+
+    // Level index claims three levels but the file ends after the first entry
+    auto index = make_ktx2(VK_FORMAT_R8G8B8A8_UNORM, 4, 4, 3);
+    index.resize(KTX2_LEVEL_INDEX + 24);
+    CHECK(!parse_ktx2_default(index).has_value());
+
+    auto level = make_ktx2(VK_FORMAT_R8G8B8A8_UNORM, 4, 4, 1);
+    level.pop_back();
+    CHECK(!parse_ktx2_default(level).has_value());
+}
+
+TEST_CASE(ktx2_level_range_does_not_wrap) {
+    // offset + length wraps to a small value; a naive sum would pass the bounds check
+    auto wrapping = make_ktx2(VK_FORMAT_R8G8B8A8_UNORM, 4, 4, 1);
+    put_u64(wrapping, KTX2_LEVEL_INDEX, std::numeric_limits<uint64_t>::max() - 8);
+    put_u64(wrapping, KTX2_LEVEL_INDEX + 8, 64);
+    CHECK(!parse_ktx2_default(wrapping).has_value());
+
+    auto long_level = make_ktx2(VK_FORMAT_R8G8B8A8_UNORM, 4, 4, 1);
+    put_u64(long_level, KTX2_LEVEL_INDEX + 8, std::numeric_limits<uint64_t>::max());
+    CHECK(!parse_ktx2_default(long_level).has_value());
+}
+
+TEST_CASE(ktx2_uncompressed_length_is_bounded) {
+    // Rejected before the decompression buffer is sized, so no zstd payload is needed
+    auto data = make_ktx2(VK_FORMAT_R8G8B8A8_UNORM, 4, 4, 1);
+    put_u32(data, 44, KTX2_ZSTD);
+    put_u64(data, KTX2_LEVEL_INDEX + 16, uint64_t{1} << 40);
+    const auto texture = parse_ktx2_default(data);
+    CHECK(!texture.has_value());
+}
+
+TEST_CASE(ktx2_malformed_header) {
+    auto bad_identifier = make_ktx2(VK_FORMAT_R8G8B8A8_UNORM, 4, 4, 1);
+    bad_identifier[1] = 'X';
+    CHECK(!parse_ktx2_default(bad_identifier).has_value());
+
+    auto unknown_format = make_ktx2(VK_FORMAT_R8G8B8A8_UNORM, 4, 4, 1);
+    put_u32(unknown_format, 12, 1000);
+    CHECK(!parse_ktx2_default(unknown_format).has_value());
+
+    auto too_many_levels = make_ktx2(VK_FORMAT_R8G8B8A8_UNORM, 4, 4, 3);
+    put_u32(too_many_levels, 40, 64);
+    CHECK(!parse_ktx2_default(too_many_levels).has_value());
+
+    auto huge = make_ktx2(VK_FORMAT_R8G8B8A8_UNORM, 4, 4, 1);
+    put_u32(huge, 20, 0x40000000);
+    put_u32(huge, 24, 0x40000000);
+    CHECK(!parse_ktx2_default(huge).has_value());
+
+    auto unknown_supercompression = make_ktx2(VK_FORMAT_R8G8B8A8_UNORM, 4, 4, 1);
+    put_u32(unknown_supercompression, 44, 7);
+    CHECK(!parse_ktx2_default(unknown_supercompression).has_value());
+
+    auto cube = make_ktx2(VK_FORMAT_R8G8B8A8_UNORM, 4, 4, 1);
+    put_u32(cube, 36, 6);
+    CHECK(!parse_ktx2_default(cube).has_value());
+}
+
+TEST_MAIN()